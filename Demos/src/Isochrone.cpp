@@ -0,0 +1,359 @@
+/*
+  Isochrone - a demo program for libosmscout
+  Copyright (C) 2026  agent
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/routing/IsochroneService.h>
+
+#include <osmscout/cli/CmdLineParsing.h>
+#include <osmscout/util/StopClock.h>
+#include <osmscout/util/Time.h>
+
+/*
+  Calculates the isochrones around the start coordinate and writes them as GeoJSON
+  feature collection (one MultiPolygon feature per budget), for example:
+
+    Isochrone --car --minutes 5 --minutes 10 --minutes 15 --output isochrones.geojson \
+      ../maps/nordrhein-westfalen 51.5717798 7.4587852
+*/
+
+struct Arguments
+{
+  bool                                   help=false;
+  std::string                            router=osmscout::RoutingService::DEFAULT_FILENAME_BASE;
+  osmscout::Vehicle                      vehicle=osmscout::Vehicle::vehicleCar;
+  std::string                            databaseDirectory;
+  osmscout::GeoCoord                     start;
+  std::vector<osmscout::IsochroneBudget> budgets;
+  osmscout::Distance                     cellSize=osmscout::Meters(100);
+  std::string                            output;
+  bool                                   nodes=false;
+  bool                                   debug=false;
+};
+
+static void GetCarSpeedTable(std::map<std::string,double>& map)
+{
+  map["highway_motorway"]=110.0;
+  map["highway_motorway_trunk"]=100.0;
+  map["highway_motorway_primary"]=70.0;
+  map["highway_motorway_link"]=60.0;
+  map["highway_motorway_junction"]=60.0;
+  map["highway_trunk"]=100.0;
+  map["highway_trunk_link"]=60.0;
+  map["highway_primary"]=70.0;
+  map["highway_primary_link"]=60.0;
+  map["highway_secondary"]=60.0;
+  map["highway_secondary_link"]=50.0;
+  map["highway_tertiary_link"]=55.0;
+  map["highway_tertiary"]=55.0;
+  map["highway_unclassified"]=50.0;
+  map["highway_road"]=50.0;
+  map["highway_residential"]=20.0;
+  map["highway_roundabout"]=40.0;
+  map["highway_living_street"]=10.0;
+  map["highway_service"]=30.0;
+}
+
+static void WriteRing(std::ostream& stream,
+                      const std::vector<osmscout::GeoCoord>& ring)
+{
+  stream << "[";
+
+  for (const auto& coord : ring) {
+    stream << "[" << coord.GetLon() << "," << coord.GetLat() << "],";
+  }
+
+  // GeoJSON rings are closed
+  stream << "[" << ring.front().GetLon() << "," << ring.front().GetLat() << "]]";
+}
+
+static void WriteGeoJson(std::ostream& stream,
+                         const osmscout::IsochroneResult& result,
+                         bool writeNodes)
+{
+  bool firstFeature=true;
+
+  stream << std::fixed << std::setprecision(7);
+  stream << R"({"type":"FeatureCollection","features":[)" << std::endl;
+
+  for (const auto& isochrone : result.GetIsochrones()) {
+    if (!firstFeature) {
+      stream << "," << std::endl;
+    }
+
+    firstFeature=false;
+
+    stream << R"({"type":"Feature","properties":{)";
+
+    if (isochrone.budget.duration) {
+      stream << R"("minutes":)" << osmscout::DurationAsHours(*isochrone.budget.duration)*60.0;
+    }
+
+    if (isochrone.budget.distance) {
+      stream << (isochrone.budget.duration ? "," : "") << R"("km":)" << isochrone.budget.distance->As<osmscout::Kilometer>();
+    }
+
+    stream << R"(},"geometry":{"type":"MultiPolygon","coordinates":[)";
+
+    for (size_t i=0; i<isochrone.polygons.size(); i++) {
+      const auto& polygon=isochrone.polygons[i];
+
+      stream << (i>0 ? "," : "") << "[";
+      WriteRing(stream,polygon.outer);
+
+      for (const auto& hole : polygon.holes) {
+        stream << ",";
+        WriteRing(stream,hole);
+      }
+
+      stream << "]";
+    }
+
+    stream << "]}}";
+  }
+
+  if (writeNodes) {
+    for (const auto& node : result.GetNodes()) {
+      if (!firstFeature) {
+        stream << "," << std::endl;
+      }
+
+      firstFeature=false;
+
+      stream << R"({"type":"Feature","properties":{"id":)" << node.id
+             << R"(,"minutes":)" << osmscout::DurationAsHours(node.duration)*60.0
+             << R"(,"km":)" << node.distance.As<osmscout::Kilometer>()
+             << R"(},"geometry":{"type":"Point","coordinates":[)"
+             << node.coord.GetLon() << "," << node.coord.GetLat() << "]}}";
+    }
+  }
+
+  stream << std::endl << "]}" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace std::string_literals;
+
+  osmscout::CmdLineParser   argParser("Isochrone",
+                                      argc,argv);
+  std::vector<std::string>  helpArgs{"h","help"};
+  Arguments                 args;
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      helpArgs,
+                      "Return argument help",
+                      true);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.debug=value;
+                      }),
+                      "debug",
+                      "Enable debug output",
+                      false);
+
+  argParser.AddOption(osmscout::CmdLineAlternativeFlag([&args](const std::string& value) {
+                        if (value=="foot") {
+                          args.vehicle=osmscout::Vehicle::vehicleFoot;
+                        }
+                        else if (value=="bicycle") {
+                          args.vehicle=osmscout::Vehicle::vehicleBicycle;
+                        }
+                        else if (value=="car") {
+                          args.vehicle=osmscout::Vehicle::vehicleCar;
+                        }
+                      }),
+                      {"foot","bicycle","car"},
+                      "Vehicle type to use for routing");
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.router=value;
+                      }),
+                      "router",
+                      "Router filename base");
+
+  argParser.AddOption(osmscout::CmdLineDoubleOption([&args](double value) {
+                        osmscout::IsochroneBudget budget;
+
+                        budget.duration=osmscout::DurationOfHours(value/60.0);
+                        args.budgets.push_back(budget);
+                      }),
+                      "minutes",
+                      "Add an isochrone for the given travel time [min], may be given multiple times");
+
+  argParser.AddOption(osmscout::CmdLineDoubleOption([&args](double value) {
+                        osmscout::IsochroneBudget budget;
+
+                        budget.distance=osmscout::Kilometers(value);
+                        args.budgets.push_back(budget);
+                      }),
+                      "km",
+                      "Add an isochrone for the given travel distance [km], may be given multiple times");
+
+  argParser.AddOption(osmscout::CmdLineUIntOption([&args](unsigned int value) {
+                        args.cellSize=osmscout::Meters(value);
+                      }),
+                      "cell-size",
+                      "Size of the grid cells of the isochrone polygons [m]. Default "s + std::to_string((int)args.cellSize.AsMeter()));
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.output=value;
+                      }),
+                      "output",
+                      "Write the GeoJSON to the given file instead of std::cout");
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.nodes=value;
+                      }),
+                      "nodes",
+                      "Add the reachable route nodes as point features",
+                      false);
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.databaseDirectory=value;
+                          }),
+                          "DATABASE",
+                          "Directory of the db to use");
+
+  argParser.AddPositional(osmscout::CmdLineGeoCoordOption([&args](const osmscout::GeoCoord& value) {
+                            args.start=value;
+                          }),
+                          "START",
+                          "start coordinate");
+
+  osmscout::CmdLineParseResult cmdLineParseResult=argParser.Parse();
+
+  if (cmdLineParseResult.HasError()) {
+    std::cerr << "ERROR: " << cmdLineParseResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  if (args.budgets.empty()) {
+    std::cerr << "ERROR: At least one --minutes or --km budget is required" << std::endl;
+    return 1;
+  }
+
+  osmscout::log.Debug(args.debug);
+  osmscout::log.Info(args.debug);
+  osmscout::log.Warn(true);
+  osmscout::log.Error(true);
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open db" << std::endl;
+
+    return 1;
+  }
+
+  osmscout::FastestPathRoutingProfileRef routingProfile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+  osmscout::TypeConfigRef                typeConfig=database->GetTypeConfig();
+  std::map<std::string,double>           carSpeedTable;
+  osmscout::RouterParameter              routerParameter;
+
+  switch (args.vehicle) {
+  case osmscout::vehicleFoot:
+    routingProfile->ParametrizeForFoot(*typeConfig,
+                                      5.0);
+    break;
+  case osmscout::vehicleBicycle:
+    routingProfile->ParametrizeForBicycle(*typeConfig,
+                                         20.0);
+    break;
+  case osmscout::vehicleCar:
+    GetCarSpeedTable(carSpeedTable);
+    routingProfile->ParametrizeForCar(*typeConfig,
+                                     carSpeedTable,
+                                     160.0);
+    break;
+  }
+
+  osmscout::IsochroneServiceRef router=std::make_shared<osmscout::IsochroneService>(database,
+                                                                                    routerParameter,
+                                                                                    args.router);
+
+  if (!router->Open()) {
+    std::cerr << "Cannot open routing db" << std::endl;
+
+    return 1;
+  }
+
+  auto startResult=router->GetClosestRoutableNode(args.start,
+                                                  *routingProfile,
+                                                  osmscout::Kilometers(1));
+
+  if (!startResult.IsValid()) {
+    std::cerr << "Error while searching for routing node near start location!" << std::endl;
+    return 1;
+  }
+
+  osmscout::RoutingParameter parameter;
+  osmscout::StopClock        clock;
+  osmscout::IsochroneResult  result=router->CalculateIsochrones(*routingProfile,
+                                                               startResult.GetRoutePosition(),
+                                                               args.budgets,
+                                                               args.cellSize,
+                                                               parameter);
+
+  clock.Stop();
+
+  if (!result.Success()) {
+    std::cerr << "Error while calculating isochrones!" << std::endl;
+    return 1;
+  }
+
+  // Statistics go to std::cerr, std::cout may hold the GeoJSON
+  std::cerr << "Isochrones: " << result.GetIsochrones().size() << ", route nodes: " << result.GetNodes().size() << ", time: " << clock << std::endl;
+
+  if (args.output.empty()) {
+    WriteGeoJson(std::cout,
+                 result,
+                 args.nodes);
+  }
+  else {
+    std::ofstream stream(args.output);
+
+    if (!stream) {
+      std::cerr << "Cannot open '" << args.output << "' for writing" << std::endl;
+      return 1;
+    }
+
+    WriteGeoJson(stream,
+                 result,
+                 args.nodes);
+  }
+
+  router->Close();
+
+  return 0;
+}
@@ -75,6 +75,7 @@ struct Arguments
   bool                              debug=false;
   bool                              dataDebug=false;
   bool                              routeDebug=false;
+  bool                              bidirectional=false;
   std::string                       routeJson;
 
   osmscout::Distance                penaltySameType=osmscout::Meters(40);
@@ -710,6 +711,13 @@ int main(int argc, char* argv[])
                       "Dump route description data to std::cout",
                       false);
 
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.bidirectional=value;
+                      }),
+                      "bidirectional",
+                      "Search the route from start and target simultaneously",
+                      false);
+
   argParser.AddOption(osmscout::CmdLineAlternativeFlag([&args](const std::string& value) {
                         if (value=="foot") {
                           args.vehicle=osmscout::Vehicle::vehicleFoot;
@@ -829,6 +837,7 @@ int main(int argc, char* argv[])
   osmscout::RoutingParameter          parameter;
 
   parameter.SetProgress(std::make_shared<ConsoleRoutingProgress>());
+  parameter.SetBidirectional(args.bidirectional);
 
   switch (args.vehicle) {
   case osmscout::vehicleFoot:
@@ -76,6 +76,18 @@ std::string TextIndexVariantStr(osmscout::ImportParameter::TextIndexVariant vari
   return "unknown";
 }
 
+std::string CoordEncodingStr(osmscout::CoordEncoding encoding)
+{
+  switch (encoding) {
+    case osmscout::CoordEncoding::fixedWidth:
+      return "fixedWidth";
+    case osmscout::CoordEncoding::streamVByte:
+      return "streamVByte";
+  }
+  assert(false);
+  return "unknown";
+}
+
 void DumpHelp(osmscout::ImportParameter& parameter)
 {
   std::cout << "Import -h -d -s <start step> -e <end step> [*.osm|*.pbf]..." << std::endl;
@@ -91,6 +103,8 @@ void DumpHelp(osmscout::ImportParameter& parameter)
   std::cout << std::endl;
 
   std::cout << " --router <router description>        definition of a router (default: car,bicycle,foot:router)" << std::endl;
+  std::cout << " --routerCH true|false                generate contraction hierarchies for the router(s) (default: " << osmscout::BoolToString(parameter.GetRouterCH()) << ")" << std::endl;
+  std::cout << " --routerGraph true|false             generate compact routing graphs for the router(s) (default: " << osmscout::BoolToString(parameter.GetRouterGraph()) << ")" << std::endl;
   std::cout << std::endl;
 
   std::cout << " --strictAreas true|false             assure that areas are simple (default: " << osmscout::BoolToString(parameter.GetStrictAreas()) << ")" << std::endl;
@@ -125,6 +139,9 @@ void DumpHelp(osmscout::ImportParameter& parameter)
   std::cout << " --wayDataMemoryMaped true|false      memory maped way data file access (default: " << osmscout::BoolToString(parameter.GetWayDataMemoryMaped()) << ")" << std::endl;
   std::cout << " --wayDataCacheSize <number>          way data cache size (default: " << parameter.GetWayDataCacheSize() << ")" << std::endl;
 
+  std::cout << " --coordEncoding fixedWidth|streamVByte" << std::endl;
+  std::cout << "                                      encoding of way and area coordinates (default: " + CoordEncodingStr(parameter.GetCoordEncoding()) + ")" << std::endl;
+
   std::cout << " --areaWayIndexMinMag <number>        minimum index level for area way index analysis (default: " << parameter.GetAreaWayIndexMinMag() << ")" << std::endl;
   std::cout << " --areaWayIndexMaxMag <number>        maximum index level for area way index analysis (default: " << parameter.GetAreaWayIndexMaxMag() << ")" << std::endl;
 
@@ -279,6 +296,32 @@ std::optional<osmscout::ImportParameter::TextIndexVariant> ParseTextIndexVariant
   return std::nullopt;
 }
 
+std::optional<osmscout::CoordEncoding> ParseCoordEncoding(int argc,
+                                                          char* argv[],
+                                                          int& currentIndex)
+{
+  int parameterIndex=currentIndex;
+  int argumentIndex=currentIndex+1;
+
+  currentIndex+=2;
+
+  if (argumentIndex>=argc) {
+    std::cerr << "Missing parameter after option '" << argv[parameterIndex] << "'" << std::endl;
+    return std::nullopt;
+  }
+
+  std::string argument(argv[argumentIndex]);
+  if (argument == "fixedWidth") {
+    return std::make_optional(osmscout::CoordEncoding::fixedWidth);
+  }
+  if (argument == "streamVByte") {
+    return std::make_optional(osmscout::CoordEncoding::streamVByte);
+  }
+
+  std::cerr << "Uknown '" << argv[parameterIndex] << "' parameter '" << argument << "'" << std::endl;
+  return std::nullopt;
+}
+
 static void InitializeLocale(osmscout::Progress& progress)
 {
   try {
@@ -310,6 +353,8 @@ static void DumpParameter(const osmscout::ImportParameter& parameter,
     progress.Info("Router: {} - '{}'",VehicleMaskToString(router.GetVehicleMask()),router.GetFilenamebase());
   }
 
+  progress.Info("RouterCH: {}",parameter.GetRouterCH());
+  progress.Info("RouterGraph: {}",parameter.GetRouterGraph());
   progress.Info("StrictAreas: {}",parameter.GetStrictAreas());
   progress.Info("ProcessingQueueSize: {}",parameter.GetProcessingQueueSize());
   progress.Info("NumericIndexPageSize: {}",parameter.GetNumericIndexPageSize());
@@ -336,6 +381,8 @@ static void DumpParameter(const osmscout::ImportParameter& parameter,
   progress.Info("WayDataMemoryMaped: {}",parameter.GetWayDataMemoryMaped());
   progress.Info("WayDataCacheSize: {}",parameter.GetWayDataCacheSize());
 
+  progress.Info("CoordEncoding: {}",CoordEncodingStr(parameter.GetCoordEncoding()));
+
   progress.Info("AreaNodeGridMag: {}",parameter.GetAreaNodeGridMag().Get());
   progress.Info("AreaNodeSimpleListLimit: {}",parameter.GetAreaNodeSimpleListLimit());
   progress.Info("AreaNodeTileListLimit: {}",parameter.GetAreaNodeTileListLimit());
@@ -555,6 +602,32 @@ int main(int argc, char* argv[])
       }
 
     }
+    else if (strcmp(argv[i],"--routerCH")==0) {
+      bool routerCH;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      routerCH)) {
+        parameter.SetRouterCH(routerCH);
+      }
+      else {
+        parameterError=true;
+      }
+    }
+    else if (strcmp(argv[i],"--routerGraph")==0) {
+      bool routerGraph;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      routerGraph)) {
+        parameter.SetRouterGraph(routerGraph);
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--strictAreas")==0) {
       bool strictAreas;
 
@@ -833,6 +906,19 @@ int main(int argc, char* argv[])
         parameterError=true;
       }
     }
+    else if (strcmp(argv[i],"--coordEncoding")==0) {
+      std::optional<osmscout::CoordEncoding> coordEncoding;
+
+      coordEncoding = ParseCoordEncoding(argc,
+                                         argv,
+                                         i);
+      if (coordEncoding) {
+        parameter.SetCoordEncoding(*coordEncoding);
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--routeNodeBlockSize")==0) {
       size_t routeNodeBlockSize;
 
@@ -0,0 +1,174 @@
+#include <cmath>
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+static std::vector<osmscout::Point> GetRoutePoints(osmscout::SimpleRoutingService& router,
+                                                   const osmscout::RouteData& route)
+{
+  osmscout::RoutePointsResult points=router.TransformRouteDataToPoints(route);
+
+  REQUIRE(points.Success());
+
+  return points.GetPoints()->points;
+}
+
+TEST_CASE("Alternative routes")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(router.Open());
+
+  std::vector<std::pair<osmscout::GeoCoord,osmscout::GeoCoord>> queries={
+    {osmscout::GeoCoord(50.412,14.534),osmscout::GeoCoord(50.424,14.6013)},
+    {osmscout::GeoCoord(50.424,14.6013),osmscout::GeoCoord(50.412,14.534)},
+    {osmscout::GeoCoord(50.4180,14.5600),osmscout::GeoCoord(50.4300,14.5800)},
+    {osmscout::GeoCoord(50.4050,14.5900),osmscout::GeoCoord(50.4250,14.5450)}
+  };
+
+  size_t alternativeCount=0;
+
+  for (osmscout::Vehicle vehicle : {osmscout::vehicleFoot,osmscout::vehicleBicycle,osmscout::vehicleCar}) {
+    osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                                 vehicle);
+
+    for (const auto& [startCoord,targetCoord] : queries) {
+      osmscout::RoutePositionResult start=router.GetClosestRoutableNode(startCoord,
+                                                                        *profile,
+                                                                        osmscout::Kilometers(1));
+      osmscout::RoutePositionResult target=router.GetClosestRoutableNode(targetCoord,
+                                                                         *profile,
+                                                                         osmscout::Kilometers(1));
+
+      REQUIRE(start.IsValid());
+      REQUIRE(target.IsValid());
+
+      osmscout::RoutingParameter parameter;
+
+      parameter.SetBidirectional(true);
+      parameter.SetAlternativeCount(3);
+      parameter.SetThreadCount(1);
+
+      osmscout::RoutingResult           bestResult=router.CalculateRoute(*profile,
+                                                                         start.GetRoutePosition(),
+                                                                         target.GetRoutePosition(),
+                                                                         std::nullopt,
+                                                                         parameter);
+      osmscout::AlternativeRoutesResult result=router.CalculateAlternativeRoutes(*profile,
+                                                                                 start.GetRoutePosition(),
+                                                                                 target.GetRoutePosition(),
+                                                                                 parameter);
+
+      REQUIRE(bestResult.Success());
+      REQUIRE(result.Success());
+      REQUIRE(result.GetRouteCount()<=1+parameter.GetAlternativeCount());
+
+      // The first route is the best route
+      CHECK(GetRoutePoints(router,result.GetRoute(0).GetRoute()).size()==
+            GetRoutePoints(router,bestResult.GetRoute()).size());
+
+      std::vector<std::vector<osmscout::Point>> routePoints;
+
+      for (size_t i=0; i<result.GetRouteCount(); i++) {
+        const osmscout::RoutingResult& route=result.GetRoute(i);
+
+        REQUIRE(route.Success());
+        CHECK(result.GetCost(i)>=result.GetCost(0));
+        CHECK(result.GetCost(i)<=result.GetCost(0)*(1.0+parameter.GetMaxStretch()));
+
+        // Each route can be described
+        osmscout::RouteDescriptionResult description=router.TransformRouteDataToRouteDescription(route.GetRoute());
+
+        REQUIRE(description.Success());
+        CHECK(!description.GetDescription()->Nodes().empty());
+
+        std::vector<osmscout::Point> points=GetRoutePoints(router,route.GetRoute());
+
+        CHECK(points.front().GetCoord()==GetRoutePoints(router,bestResult.GetRoute()).front().GetCoord());
+        CHECK(points.back().GetCoord()==GetRoutePoints(router,bestResult.GetRoute()).back().GetCoord());
+
+        // All routes differ
+        for (const auto& otherPoints : routePoints) {
+          CHECK(!std::equal(points.begin(),
+                            points.end(),
+                            otherPoints.begin(),
+                            otherPoints.end(),
+                            [](const osmscout::Point& a, const osmscout::Point& b) {
+                              return a.GetId()==b.GetId();
+                            }));
+        }
+
+        routePoints.push_back(points);
+      }
+
+      alternativeCount+=result.GetRouteCount()-1;
+
+      // The result does not depend on the number of threads
+      parameter.SetThreadCount(4);
+
+      osmscout::AlternativeRoutesResult parallelResult=router.CalculateAlternativeRoutes(*profile,
+                                                                                         start.GetRoutePosition(),
+                                                                                         target.GetRoutePosition(),
+                                                                                         parameter);
+
+      REQUIRE(parallelResult.GetRouteCount()==result.GetRouteCount());
+
+      for (size_t i=0; i<result.GetRouteCount(); i++) {
+        CHECK(parallelResult.GetCost(i)==result.GetCost(i));
+      }
+
+      // Without alternatives only the best route is returned
+      parameter.SetAlternativeCount(0);
+
+      osmscout::AlternativeRoutesResult bestOnlyResult=router.CalculateAlternativeRoutes(*profile,
+                                                                                         start.GetRoutePosition(),
+                                                                                         target.GetRoutePosition(),
+                                                                                         parameter);
+
+      REQUIRE(bestOnlyResult.GetRouteCount()==1);
+      CHECK(std::abs(bestOnlyResult.GetCost(0)-result.GetCost(0))<=result.GetCost(0)*1e-9);
+    }
+  }
+
+  // The test region has enough parallel roads for some alternatives
+  CHECK(alternativeCount>0);
+
+  router.Close();
+  database->Close();
+}
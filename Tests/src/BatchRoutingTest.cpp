@@ -0,0 +1,222 @@
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/BatchRoutingService.h>
+#include <osmscout/routing/ContractionHierarchy.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+static bool IsSameRoute(const osmscout::RouteData& a,
+                        const osmscout::RouteData& b)
+{
+  return std::equal(a.Entries().begin(),
+                    a.Entries().end(),
+                    b.Entries().begin(),
+                    b.Entries().end(),
+                    [](const osmscout::RouteData::RouteEntry& entryA,
+                       const osmscout::RouteData::RouteEntry& entryB) {
+                      return entryA.GetCurrentNodeId()==entryB.GetCurrentNodeId() &&
+                             entryA.GetPathObject()==entryB.GetPathObject();
+                    });
+}
+
+class FailingProfile : public osmscout::FastestPathRoutingProfile
+{
+public:
+  explicit FailingProfile(const osmscout::TypeConfigRef& typeConfig)
+  : osmscout::FastestPathRoutingProfile(typeConfig)
+  {
+    // no code
+  }
+
+  using osmscout::FastestPathRoutingProfile::GetCosts;
+
+  double GetCosts(const osmscout::RouteNode& /*currentNode*/,
+                  const std::vector<osmscout::ObjectVariantData>& /*objectVariantData*/,
+                  size_t /*inPathIndex*/,
+                  size_t /*outPathIndex*/) const override
+  {
+    throw std::runtime_error("Profile failure");
+  }
+};
+
+TEST_CASE("Batch routes match routes calculated one by one")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::BatchRoutingService  batchRouter(database,
+                                             routerParameter,
+                                             osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE,
+                                             4);
+
+  REQUIRE(router.Open());
+  REQUIRE(batchRouter.Open());
+  REQUIRE(batchRouter.GetThreadCount()==4);
+
+  std::vector<osmscout::GeoCoord> coords={
+    osmscout::GeoCoord(50.412,14.534),
+    osmscout::GeoCoord(50.424,14.6013),
+    osmscout::GeoCoord(50.4180,14.5600),
+    osmscout::GeoCoord(50.4300,14.5800),
+    osmscout::GeoCoord(50.4050,14.5900),
+    osmscout::GeoCoord(50.4250,14.5450)
+  };
+
+  std::vector<osmscout::BatchRoutingJob> jobs;
+
+  for (osmscout::Vehicle vehicle : {osmscout::vehicleFoot,osmscout::vehicleBicycle,osmscout::vehicleCar}) {
+    osmscout::RoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                      vehicle);
+
+    for (const auto& startCoord : coords) {
+      for (const auto& targetCoord : coords) {
+        osmscout::RoutePositionResult start=router.GetClosestRoutableNode(startCoord,
+                                                                          *profile,
+                                                                          osmscout::Kilometers(1));
+        osmscout::RoutePositionResult target=router.GetClosestRoutableNode(targetCoord,
+                                                                           *profile,
+                                                                           osmscout::Kilometers(1));
+
+        REQUIRE(start.IsValid());
+        REQUIRE(target.IsValid());
+
+        if (startCoord==targetCoord) {
+          continue;
+        }
+
+        jobs.push_back(osmscout::BatchRoutingJob{start.GetRoutePosition(),
+                                                 target.GetRoutePosition(),
+                                                 profile});
+      }
+    }
+  }
+
+  osmscout::RoutingParameter                   parameter;
+  std::vector<osmscout::BatchRoutingJobResult> results=batchRouter.CalculateRoutes(jobs,
+                                                                                   parameter);
+
+  REQUIRE(results.size()==jobs.size());
+
+  for (size_t j=0; j<jobs.size(); j++) {
+    osmscout::RoutingResult expected=router.CalculateRoute(*jobs[j].profile,
+                                                           jobs[j].start,
+                                                           jobs[j].target,
+                                                           std::nullopt,
+                                                           parameter);
+
+    REQUIRE(expected.Success());
+    REQUIRE(results[j].result.Success());
+    CHECK(IsSameRoute(results[j].result.GetRoute(),expected.GetRoute()));
+    CHECK(results[j].worker<batchRouter.GetThreadCount());
+    CHECK(results[j].duration>std::chrono::steady_clock::duration::zero());
+  }
+
+  SECTION("Concurrent batches")
+  {
+    std::vector<osmscout::BatchRoutingJobResult> otherResults;
+    std::thread                                  other([&]() {
+      otherResults=batchRouter.CalculateRoutes(jobs,
+                                               parameter);
+    });
+
+    std::vector<osmscout::BatchRoutingJobResult> ownResults=batchRouter.CalculateRoutes(jobs,
+                                                                                        parameter);
+
+    other.join();
+
+    REQUIRE(ownResults.size()==jobs.size());
+    REQUIRE(otherResults.size()==jobs.size());
+
+    for (size_t j=0; j<jobs.size(); j++) {
+      CHECK(IsSameRoute(ownResults[j].result.GetRoute(),results[j].result.GetRoute()));
+      CHECK(IsSameRoute(otherResults[j].result.GetRoute(),results[j].result.GetRoute()));
+    }
+  }
+
+  SECTION("Jobs without profile fail")
+  {
+    std::vector<osmscout::BatchRoutingJob> invalidJobs={jobs.front()};
+
+    invalidJobs.front().profile=nullptr;
+
+    std::vector<osmscout::BatchRoutingJobResult> invalidResults=batchRouter.CalculateRoutes(invalidJobs,
+                                                                                            parameter);
+
+    REQUIRE(invalidResults.size()==1);
+    CHECK(!invalidResults.front().result.Success());
+  }
+
+  SECTION("Exceptions fail only their own job")
+  {
+    auto failingProfile=std::make_shared<FailingProfile>(database->GetTypeConfig());
+
+    failingProfile->ParametrizeForFoot(*database->GetTypeConfig(),
+                                       5.0);
+
+    std::vector<osmscout::BatchRoutingJob> mixedJobs;
+
+    for (size_t j=0; j<8; j++) {
+      mixedJobs.push_back(jobs[j]);
+
+      if (j%2==0) {
+        mixedJobs.back().profile=failingProfile;
+      }
+    }
+
+    std::vector<osmscout::BatchRoutingJobResult> mixedResults=batchRouter.CalculateRoutes(mixedJobs,
+                                                                                          parameter);
+
+    REQUIRE(mixedResults.size()==mixedJobs.size());
+
+    for (size_t j=0; j<mixedJobs.size(); j++) {
+      if (j%2==0) {
+        CHECK(!mixedResults[j].result.Success());
+        REQUIRE(mixedResults[j].exception);
+        CHECK_THROWS_AS(std::rethrow_exception(mixedResults[j].exception),std::runtime_error);
+      }
+      else {
+        CHECK(!mixedResults[j].exception);
+        CHECK(IsSameRoute(mixedResults[j].result.GetRoute(),results[j].result.GetRoute()));
+      }
+    }
+  }
+
+  batchRouter.Close();
+  CHECK(!batchRouter.IsOpen());
+
+  router.Close();
+  database->Close();
+}
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/RoutingDB.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/MemoryBudget.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+static double GetRouteLength(osmscout::SimpleRoutingService& router,
+                             const osmscout::RouteData& route)
+{
+  osmscout::RoutePointsResult points=router.TransformRouteDataToPoints(route);
+
+  REQUIRE(points.Success());
+
+  double                 length=0.0;
+  const osmscout::Point* previous=nullptr;
+
+  for (const auto& point : points.GetPoints()->points) {
+    if (previous!=nullptr) {
+      length+=osmscout::GetEllipsoidalDistance(previous->GetCoord(),point.GetCoord()).AsMeter();
+    }
+
+    previous=&point;
+  }
+
+  return length;
+}
+
+TEST_CASE("Bidirectional routes match unidirectional routes")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(router.Open());
+
+  std::vector<std::pair<osmscout::GeoCoord,osmscout::GeoCoord>> queries={
+    {osmscout::GeoCoord(50.412,14.534),osmscout::GeoCoord(50.424,14.6013)},
+    {osmscout::GeoCoord(50.424,14.6013),osmscout::GeoCoord(50.412,14.534)},
+    {osmscout::GeoCoord(50.4180,14.5600),osmscout::GeoCoord(50.4300,14.5800)},
+    {osmscout::GeoCoord(50.4050,14.5900),osmscout::GeoCoord(50.4250,14.5450)}
+  };
+
+  for (osmscout::Vehicle vehicle : {osmscout::vehicleFoot,osmscout::vehicleBicycle,osmscout::vehicleCar}) {
+    osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                                 vehicle);
+
+    for (const auto& [startCoord,targetCoord] : queries) {
+      osmscout::RoutePositionResult start=router.GetClosestRoutableNode(startCoord,
+                                                                        *profile,
+                                                                        osmscout::Kilometers(1));
+      osmscout::RoutePositionResult target=router.GetClosestRoutableNode(targetCoord,
+                                                                         *profile,
+                                                                         osmscout::Kilometers(1));
+
+      REQUIRE(start.IsValid());
+      REQUIRE(target.IsValid());
+
+      osmscout::RoutingParameter parameter;
+      osmscout::RoutingResult    unidirectionalResult=router.CalculateRoute(*profile,
+                                                                            start.GetRoutePosition(),
+                                                                            target.GetRoutePosition(),
+                                                                            std::nullopt,
+                                                                            parameter);
+
+      parameter.SetBidirectional(true);
+
+      osmscout::RoutingResult    bidirectionalResult=router.CalculateRoute(*profile,
+                                                                           start.GetRoutePosition(),
+                                                                           target.GetRoutePosition(),
+                                                                           std::nullopt,
+                                                                           parameter);
+
+      REQUIRE(unidirectionalResult.Success());
+      REQUIRE(bidirectionalResult.Success());
+
+      double unidirectionalLength=GetRouteLength(router,unidirectionalResult.GetRoute());
+      double bidirectionalLength=GetRouteLength(router,bidirectionalResult.GetRoute());
+
+      CHECK(std::abs(unidirectionalLength-bidirectionalLength)<=unidirectionalLength*0.01);
+    }
+  }
+
+  router.Close();
+  database->Close();
+}
+
+static osmscout::MemoryBudget::Statistics GetIncomingPathStatistics(const osmscout::MemoryBudget& budget)
+{
+  auto statistics=budget.GetStatistics();
+  auto entry=std::find_if(statistics.begin(),statistics.end(),[](const osmscout::MemoryBudget::Statistics& statistics) {
+    return statistics.name=="incoming paths";
+  });
+
+  REQUIRE(entry!=statistics.end());
+
+  return *entry;
+}
+
+TEST_CASE("Incoming paths are cached per routing database")
+{
+  auto                        budget=std::make_shared<osmscout::MemoryBudget>(64*1024*1024);
+  osmscout::DatabaseParameter databaseParameter;
+
+  databaseParameter.SetMemoryBudget(budget);
+
+  osmscout::DatabaseRef database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  auto routingDatabase=std::make_shared<osmscout::RoutingDatabase>();
+
+  REQUIRE(routingDatabase->Open(database));
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService firstRouter(database,
+                                             routerParameter,
+                                             osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE,
+                                             routingDatabase);
+  osmscout::SimpleRoutingService secondRouter(database,
+                                              routerParameter,
+                                              osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE,
+                                              routingDatabase);
+
+  REQUIRE(firstRouter.Open());
+  REQUIRE(secondRouter.Open());
+
+  osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                               osmscout::vehicleCar);
+  osmscout::RoutePositionResult          start=firstRouter.GetClosestRoutableNode(osmscout::GeoCoord(50.412,14.534),
+                                                                                  *profile,
+                                                                                  osmscout::Kilometers(1));
+  osmscout::RoutePositionResult          target=firstRouter.GetClosestRoutableNode(osmscout::GeoCoord(50.424,14.6013),
+                                                                                   *profile,
+                                                                                   osmscout::Kilometers(1));
+
+  REQUIRE(start.IsValid());
+  REQUIRE(target.IsValid());
+
+  osmscout::RoutingParameter parameter;
+
+  parameter.SetBidirectional(true);
+
+  REQUIRE(firstRouter.CalculateRoute(*profile,
+                                     start.GetRoutePosition(),
+                                     target.GetRoutePosition(),
+                                     std::nullopt,
+                                     parameter).Success());
+
+  osmscout::MemoryBudget::Statistics statistics=GetIncomingPathStatistics(*budget);
+
+  REQUIRE(statistics.entries>0);
+  REQUIRE(statistics.memory>0);
+
+  // The second router finds all incoming paths in the cache of the shared database
+  REQUIRE(secondRouter.CalculateRoute(*profile,
+                                      start.GetRoutePosition(),
+                                      target.GetRoutePosition(),
+                                      std::nullopt,
+                                      parameter).Success());
+
+  REQUIRE(GetIncomingPathStatistics(*budget).entries==statistics.entries);
+
+  firstRouter.Close();
+  secondRouter.Close();
+
+  // Closing the routing database flushes the cache
+  routingDatabase->Close();
+
+  statistics=GetIncomingPathStatistics(*budget);
+
+  REQUIRE(statistics.entries==0);
+  REQUIRE(statistics.memory==0);
+
+  database->Close();
+}
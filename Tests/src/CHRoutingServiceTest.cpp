@@ -0,0 +1,328 @@
+#include <cmath>
+#include <filesystem>
+#include <map>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/CHRoutingService.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/Progress.h>
+
+#include <osmscoutimport/GenRouteCHDat.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+/**
+ * Copy the test region to a temporary directory and generate the
+ * contraction hierarchies there
+ */
+static std::string GenerateHierarchies()
+{
+  std::filesystem::path directory=std::filesystem::temp_directory_path().append("CHRoutingServiceTest");
+
+  std::filesystem::remove_all(directory);
+  std::filesystem::copy(GetTestDatabaseDirectory(),
+                        directory,
+                        std::filesystem::copy_options::recursive);
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::Database          database(databaseParameter);
+
+  REQUIRE(database.Open(directory.string()));
+
+  osmscout::ImportParameter      parameter;
+  osmscout::ConsoleProgress      progress;
+  osmscout::RouteCHDataGenerator generator;
+
+  parameter.SetDestinationDirectory(directory.string());
+  parameter.AddRouter(osmscout::ImportParameter::Router(osmscout::vehicleFoot|osmscout::vehicleBicycle|osmscout::vehicleCar,
+                                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE));
+  parameter.SetRouterCH(true);
+
+  REQUIRE(generator.Import(database.GetTypeConfig(),
+                           parameter,
+                           progress));
+
+  database.Close();
+
+  return directory.string();
+}
+
+static double GetRouteLength(osmscout::SimpleRoutingService& router,
+                             const osmscout::RouteData& route)
+{
+  osmscout::RoutePointsResult points=router.TransformRouteDataToPoints(route);
+
+  REQUIRE(points.Success());
+
+  double                 length=0.0;
+  const osmscout::Point* previous=nullptr;
+
+  for (const auto& point : points.GetPoints()->points) {
+    if (previous!=nullptr) {
+      length+=osmscout::GetEllipsoidalDistance(previous->GetCoord(),point.GetCoord()).AsMeter();
+    }
+
+    previous=&point;
+  }
+
+  return length;
+}
+
+TEST_CASE("Contraction hierarchy routes match A* routes")
+{
+  std::string directory=GenerateHierarchies();
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(directory));
+
+  osmscout::RouterParameter routerParameter;
+  osmscout::SimpleRoutingService aStarRouter(database,
+                                             routerParameter,
+                                             osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::CHRoutingService     chRouter(database,
+                                          routerParameter,
+                                          osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(aStarRouter.Open());
+  REQUIRE(chRouter.Open());
+
+  for (osmscout::Vehicle vehicle : {osmscout::vehicleFoot,osmscout::vehicleBicycle,osmscout::vehicleCar}) {
+    osmscout::ContractionHierarchyRef hierarchy=chRouter.GetContractionHierarchy(vehicle);
+
+    REQUIRE(hierarchy);
+    REQUIRE(hierarchy->GetVehicle()==vehicle);
+    REQUIRE(hierarchy->GetNodeCount()>0);
+  }
+
+  osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                               osmscout::vehicleCar);
+
+  std::vector<std::pair<osmscout::GeoCoord,osmscout::GeoCoord>> queries={
+    {osmscout::GeoCoord(50.412,14.534),osmscout::GeoCoord(50.424,14.6013)},
+    {osmscout::GeoCoord(50.424,14.6013),osmscout::GeoCoord(50.412,14.534)},
+    {osmscout::GeoCoord(50.4180,14.5600),osmscout::GeoCoord(50.4300,14.5800)},
+    {osmscout::GeoCoord(50.4050,14.5900),osmscout::GeoCoord(50.4250,14.5450)}
+  };
+
+  for (const auto& [startCoord,targetCoord] : queries) {
+    osmscout::RoutePositionResult start=aStarRouter.GetClosestRoutableNode(startCoord,
+                                                                           *profile,
+                                                                           osmscout::Kilometers(1));
+    osmscout::RoutePositionResult target=aStarRouter.GetClosestRoutableNode(targetCoord,
+                                                                            *profile,
+                                                                            osmscout::Kilometers(1));
+
+    REQUIRE(start.IsValid());
+    REQUIRE(target.IsValid());
+
+    osmscout::RoutingParameter parameter;
+    osmscout::RoutingResult    aStarResult=aStarRouter.CalculateRoute(*profile,
+                                                                      start.GetRoutePosition(),
+                                                                      target.GetRoutePosition(),
+                                                                      std::nullopt,
+                                                                      parameter);
+    osmscout::RoutingResult    chResult=chRouter.CalculateRoute(*profile,
+                                                                start.GetRoutePosition(),
+                                                                target.GetRoutePosition(),
+                                                                std::nullopt,
+                                                                parameter);
+
+    REQUIRE(aStarResult.Success());
+    REQUIRE(chResult.Success());
+
+    double aStarLength=GetRouteLength(aStarRouter,aStarResult.GetRoute());
+    double chLength=GetRouteLength(chRouter,chResult.GetRoute());
+
+    CHECK(std::abs(aStarLength-chLength)<=aStarLength*0.01);
+  }
+
+  chRouter.Close();
+  aStarRouter.Close();
+  database->Close();
+
+  std::filesystem::remove_all(directory);
+}
+
+/**
+ * Fastest path profile of a subclass, that cannot be compiled
+ */
+class SubclassedProfile : public osmscout::FastestPathRoutingProfile
+{
+public:
+  explicit SubclassedProfile(const osmscout::TypeConfigRef& typeConfig)
+  : osmscout::FastestPathRoutingProfile(typeConfig)
+  {
+    // no code
+  }
+};
+
+TEST_CASE("Profiles differing from the hierarchy profile are routed by A*")
+{
+  std::string directory=GenerateHierarchies();
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(directory));
+
+  osmscout::TypeConfigRef        typeConfig=database->GetTypeConfig();
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService aStarRouter(database,
+                                             routerParameter,
+                                             osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+  osmscout::CHRoutingService     chRouter(database,
+                                          routerParameter,
+                                          osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(aStarRouter.Open());
+  REQUIRE(chRouter.Open());
+
+  osmscout::FastestPathRoutingProfileRef hierarchyProfile=osmscout::ContractionHierarchy::CreateProfile(typeConfig,
+                                                                                                        osmscout::vehicleCar);
+  osmscout::FastestPathRoutingProfileRef penaltyProfile=osmscout::ContractionHierarchy::CreateProfile(typeConfig,
+                                                                                                      osmscout::vehicleCar);
+  osmscout::ShortestPathRoutingProfile   shortestProfile(typeConfig);
+  SubclassedProfile                      subclassedProfile(typeConfig);
+  std::map<std::string,double>           speedMap;
+
+  penaltyProfile->SetJunctionPenalty(true);
+
+  for (const auto& type : typeConfig->GetTypes()) {
+    speedMap[type->GetName()]=50.0;
+  }
+
+  REQUIRE(shortestProfile.ParametrizeForCar(*typeConfig,
+                                            speedMap,
+                                            160.0));
+
+  // Same parameters as the foot hierarchy profile
+  subclassedProfile.ParametrizeForFoot(*typeConfig,
+                                       5.0);
+  subclassedProfile.SetJunctionPenalty(false);
+
+  REQUIRE(chRouter.UsesContractionHierarchy(*hierarchyProfile));
+  REQUIRE(chRouter.UsesContractionHierarchy(*osmscout::ContractionHierarchy::CreateProfile(typeConfig,
+                                                                                           osmscout::vehicleFoot)));
+  REQUIRE(!chRouter.UsesContractionHierarchy(*penaltyProfile));
+  REQUIRE(!chRouter.UsesContractionHierarchy(shortestProfile));
+  REQUIRE(!chRouter.UsesContractionHierarchy(subclassedProfile));
+
+  osmscout::RoutePositionResult start=aStarRouter.GetClosestRoutableNode(osmscout::GeoCoord(50.412,14.534),
+                                                                         *hierarchyProfile,
+                                                                         osmscout::Kilometers(1));
+  osmscout::RoutePositionResult target=aStarRouter.GetClosestRoutableNode(osmscout::GeoCoord(50.424,14.6013),
+                                                                          *hierarchyProfile,
+                                                                          osmscout::Kilometers(1));
+
+  REQUIRE(start.IsValid());
+  REQUIRE(target.IsValid());
+
+  for (osmscout::RoutingProfile* profile : std::initializer_list<osmscout::RoutingProfile*>{penaltyProfile.get(),&shortestProfile}) {
+    osmscout::RoutingParameter parameter;
+    osmscout::RoutingResult    aStarResult=aStarRouter.CalculateRoute(*profile,
+                                                                      start.GetRoutePosition(),
+                                                                      target.GetRoutePosition(),
+                                                                      std::nullopt,
+                                                                      parameter);
+    osmscout::RoutingResult    chResult=chRouter.CalculateRoute(*profile,
+                                                                start.GetRoutePosition(),
+                                                                target.GetRoutePosition(),
+                                                                std::nullopt,
+                                                                parameter);
+
+    REQUIRE(aStarResult.Success());
+    REQUIRE(chResult.Success());
+
+    // The A* fallback returns the very same route
+    CHECK(GetRouteLength(aStarRouter,aStarResult.GetRoute())==GetRouteLength(chRouter,chResult.GetRoute()));
+  }
+
+  chRouter.Close();
+  aStarRouter.Close();
+  database->Close();
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Contraction hierarchy survives store and load")
+{
+  std::vector<osmscout::Id>                                      nodeIds={10,20,30};
+  std::vector<std::vector<osmscout::ContractionHierarchy::Edge>> forward(3);
+  std::vector<std::vector<osmscout::ContractionHierarchy::Edge>> backward(3);
+
+  osmscout::ContractionHierarchy::Edge edge;
+
+  // 0 -> 1 -> 2 with 1 contracted first, shortcut 0 -> 2 via 1 stored at 0
+  edge.target=2;
+  edge.cost=3.0;
+  edge.object=osmscout::ObjectFileRef(100,osmscout::refWay);
+  forward[1].push_back(edge);
+
+  edge.target=0;
+  edge.cost=1.0;
+  edge.object=osmscout::ObjectFileRef(200,osmscout::refWay);
+  backward[1].push_back(edge);
+
+  edge.target=2;
+  edge.middle=1;
+  edge.cost=4.0;
+  edge.object=osmscout::ObjectFileRef();
+  forward[0].push_back(edge);
+
+  osmscout::ContractionHierarchy hierarchy(osmscout::vehicleBicycle,
+                                           nodeIds,
+                                           forward,
+                                           backward);
+  std::string                    filename=std::filesystem::temp_directory_path().append("router-ch-bicycle.dat").string();
+
+  REQUIRE(hierarchy.Store(filename));
+
+  osmscout::ContractionHierarchy loaded;
+
+  REQUIRE(loaded.Load(filename));
+  REQUIRE(loaded.GetVehicle()==osmscout::vehicleBicycle);
+  REQUIRE(loaded.GetNodeCount()==3);
+  REQUIRE(loaded.GetEdgeCount()==3);
+  REQUIRE(loaded.GetNodeIndex(20)==1);
+  REQUIRE(loaded.GetNodeIndex(25)==osmscout::ContractionHierarchy::noNode);
+  REQUIRE(loaded.GetForwardEdges(0).size()==1);
+
+  std::vector<osmscout::ContractionHierarchy::Step> steps;
+
+  REQUIRE(loaded.Unpack(0,loaded.GetForwardEdges(0).front(),2,steps));
+  REQUIRE(steps.size()==2);
+  CHECK(steps[0].node==1);
+  CHECK(steps[0].object==osmscout::ObjectFileRef(200,osmscout::refWay));
+  CHECK(steps[1].node==2);
+  CHECK(steps[1].object==osmscout::ObjectFileRef(100,osmscout::refWay));
+
+  std::filesystem::remove(filename);
+}
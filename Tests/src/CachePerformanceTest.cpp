@@ -19,9 +19,13 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <osmscout/util/Cache.h>
+#include <osmscout/util/ShardedCache.h>
 #include <osmscout/util/StopClock.h>
 #include <osmscout/cli/CmdLineParsing.h>
 
@@ -30,6 +34,7 @@
   * cache insertion
   * cache hit
   * cache miss
+  * concurrent access to Cache guarded by a mutex and to ShardedCache
 */
 
 /**
@@ -48,6 +53,10 @@ struct Data
 
 typedef osmscout::Cache<osmscout::Id,Data>     DataCache;
 
+using DataRef            = std::shared_ptr<Data>;
+using SharedDataCache    = osmscout::Cache<osmscout::FileOffset,DataRef>;
+using ShardedDataCache   = osmscout::ShardedCache<osmscout::FileOffset,DataRef>;
+
 bool TestData(size_t cacheSize)
 {
   std::cout << "*** Caching of struct ***" << std::endl;
@@ -158,10 +167,155 @@ bool TestData(size_t cacheSize)
   return true;
 }
 
+/**
+ * Cache interface used by the concurrent test, the original Cache
+ * is guarded by one mutex, as it is done in the data files.
+ */
+class LockedCache
+{
+private:
+  SharedDataCache cache;
+  std::mutex      mutex;
+
+public:
+  explicit LockedCache(size_t cacheSize)
+  : cache(cacheSize)
+  {
+  }
+
+  bool GetEntry(osmscout::FileOffset key, DataRef& value)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+    SharedDataCache::CacheRef ref;
+
+    if (!cache.GetEntry(key,ref)) {
+      return false;
+    }
+
+    value=ref->value;
+
+    return true;
+  }
+
+  void SetEntry(osmscout::FileOffset key, const DataRef& value)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    cache.SetEntry(SharedDataCache::CacheEntry(key,value));
+  }
+};
+
+/**
+ * Every thread performs lookups for keys in range [0, 2*cacheSize), values
+ * missing in the cache are inserted. So in steady state, there is ~50% hit rate.
+ */
+template<class C>
+bool TestConcurrent(const std::string& name,
+                    C& cache,
+                    size_t cacheSize,
+                    size_t threadCount)
+{
+  std::vector<std::thread> threads;
+  std::vector<size_t>      hits(threadCount,0);
+  std::vector<size_t>      misses(threadCount,0);
+  size_t                   iterations=10*cacheSize;
+
+  osmscout::StopClock timer;
+
+  for (size_t t=0; t<threadCount; t++) {
+    threads.emplace_back([&cache,&hits,&misses,t,cacheSize,iterations]() {
+      // simple LCG, to get the same sequence for all cache implementations
+      uint64_t state=t+1;
+
+      for (size_t i=0; i<iterations; i++) {
+        state=state*6364136223846793005ULL+1442695040888963407ULL;
+
+        osmscout::FileOffset key=(state >> 33) % (2*cacheSize);
+        DataRef              value;
+
+        if (cache.GetEntry(key,value)) {
+          hits[t]++;
+        }
+        else {
+          misses[t]++;
+          value=std::make_shared<Data>();
+          value->value=key;
+          cache.SetEntry(key,value);
+        }
+
+        if (value->value!=key) {
+          std::cerr << "Wrong value for key " << key << std::endl;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  timer.Stop();
+
+  size_t hitCount=0;
+  size_t missCount=0;
+
+  for (size_t t=0; t<threadCount; t++) {
+    hitCount+=hits[t];
+    missCount+=misses[t];
+  }
+
+  double seconds=std::max(timer.GetMilliseconds(),1.0)/1000.0;
+
+  std::cout << name << ": " << threadCount << " threads, "
+            << hitCount << " hits, " << missCount << " misses, "
+            << "time " << timer << ", "
+            << (size_t)((hitCount+missCount)/seconds) << " ops/s" << std::endl;
+
+  return hitCount+missCount==threadCount*iterations;
+}
+
+bool TestConcurrent(size_t cacheSize,
+                    size_t threadCount)
+{
+  std::cout << "*** Concurrent access ***" << std::endl;
+
+  bool result=true;
+
+  {
+    LockedCache cache(cacheSize);
+
+    result&=TestConcurrent("Cache + mutex",cache,cacheSize,threadCount);
+  }
+
+  {
+    ShardedDataCache cache(cacheSize,
+                           ShardedDataCache::DefaultShardCount,
+                           ShardedDataCache::EvictionPolicy::LRU);
+
+    result&=TestConcurrent("ShardedCache (LRU)",cache,cacheSize,threadCount);
+  }
+
+  {
+    ShardedDataCache cache(cacheSize,
+                           ShardedDataCache::DefaultShardCount,
+                           ShardedDataCache::EvictionPolicy::Clock);
+
+    result&=TestConcurrent("ShardedCache (Clock)",cache,cacheSize,threadCount);
+
+    if (cache.GetSize()>cacheSize) {
+      std::cerr << "ShardedCache size " << cache.GetSize() << " exceeds " << cacheSize << std::endl;
+      result=false;
+    }
+  }
+
+  return result;
+}
+
 int main(int argc, char* argv[])
 {
   using namespace std::string_literals;
   size_t cacheSize=2000000;
+  size_t threadCount=std::max(2u,std::thread::hardware_concurrency());
   bool help=false;
   osmscout::CmdLineParser argParser("CachePerformance", argc, argv);
 
@@ -178,6 +332,12 @@ int main(int argc, char* argv[])
                 "size",
                 "Cache size used for the test, default: "s + std::to_string(cacheSize));
 
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  threadCount=value;
+                }),
+                "threads",
+                "Number of threads used for the concurrent test, default: "s + std::to_string(threadCount));
+
   osmscout::CmdLineParseResult argResult=argParser.Parse();
   if (argResult.HasError()) {
     std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
@@ -189,5 +349,9 @@ int main(int argc, char* argv[])
     return 0;
   }
 
-  return TestData(cacheSize) ? 0:1;
+  if (!TestData(cacheSize)) {
+    return 1;
+  }
+
+  return TestConcurrent(cacheSize,threadCount) ? 0:1;
 }
@@ -0,0 +1,223 @@
+#include <filesystem>
+#include <map>
+#include <random>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/RoutingProfile.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+/**
+ * Object variants for all way types, with and without speed limit and for all grades
+ */
+static std::vector<osmscout::ObjectVariantData> GetObjectVariantData(const osmscout::TypeConfig& typeConfig)
+{
+  std::vector<osmscout::ObjectVariantData> objectVariantData;
+
+  for (const auto& type : typeConfig.GetWayTypes()) {
+    for (uint8_t maxSpeed : {0,30,200}) {
+      for (uint8_t grade=1; grade<=5; grade++) {
+        osmscout::ObjectVariantData data;
+
+        data.type=type;
+        data.maxSpeed=maxSpeed;
+        data.grade=grade;
+
+        objectVariantData.push_back(data);
+      }
+    }
+  }
+
+  return objectVariantData;
+}
+
+/**
+ * Random route node with a path per object to a random other node
+ */
+static osmscout::RouteNode GetRouteNode(std::mt19937& random,
+                                        const std::vector<osmscout::ObjectVariantData>& objectVariantData)
+{
+  std::uniform_int_distribution<size_t>  variantDistribution(0,objectVariantData.size()-1);
+  std::uniform_int_distribution<uint8_t> flagsDistribution(0,63);
+  std::uniform_real_distribution<>       distanceDistribution(0.0,2000.0);
+  osmscout::RouteNode                    routeNode;
+
+  routeNode.Initialize(0,
+                       osmscout::Point(0,osmscout::GeoCoord(50.4,14.5)));
+
+  for (size_t i=0; i<6; i++) {
+    osmscout::RouteNode::Path path;
+
+    path.objectIndex=routeNode.AddObject(osmscout::ObjectFileRef(1000+i/2,osmscout::refWay),
+                                         static_cast<uint16_t>(variantDistribution(random)));
+    path.id=i+1;
+    path.distance=osmscout::Meters(distanceDistribution(random));
+    path.flags=flagsDistribution(random);
+
+    routeNode.paths.push_back(path);
+  }
+
+  return routeNode;
+}
+
+static void CheckCompiledProfile(const osmscout::RoutingProfile& profile,
+                                 const std::vector<osmscout::ObjectVariantData>& objectVariantData)
+{
+  osmscout::CompiledRoutingProfile compiled;
+
+  REQUIRE(profile.Compile(objectVariantData,compiled));
+  REQUIRE(compiled.GetVariants().size()==objectVariantData.size());
+
+  std::mt19937 random(42);
+
+  for (size_t n=0; n<1000; n++) {
+    osmscout::RouteNode routeNode=GetRouteNode(random,
+                                               objectVariantData);
+
+    for (size_t out=0; out<routeNode.paths.size(); out++) {
+      REQUIRE(compiled.CanUse(routeNode,out)==profile.CanUse(routeNode,objectVariantData,out));
+
+      if (!profile.CanUse(routeNode,objectVariantData,out)) {
+        continue;
+      }
+
+      // The router only calculates the costs of usable paths
+      for (size_t in=0; in<routeNode.paths.size(); in++) {
+        if (!profile.CanUse(routeNode,objectVariantData,in)) {
+          continue;
+        }
+
+        // Results must be identical, otherwise routes could differ
+        REQUIRE(compiled.GetCosts(routeNode,in,out)==profile.GetCosts(routeNode,objectVariantData,in,out));
+      }
+    }
+  }
+}
+
+TEST_CASE("Compiled routing profiles match the profiles")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::TypeConfigRef                  typeConfig=database->GetTypeConfig();
+  std::vector<osmscout::ObjectVariantData> objectVariantData=GetObjectVariantData(*typeConfig);
+
+  REQUIRE(!objectVariantData.empty());
+
+  for (osmscout::Vehicle vehicle : {osmscout::vehicleFoot,osmscout::vehicleBicycle,osmscout::vehicleCar}) {
+    osmscout::FastestPathRoutingProfileRef fastest=osmscout::ContractionHierarchy::CreateProfile(typeConfig,
+                                                                                                 vehicle);
+
+    SECTION("Fastest path without junction penalty")
+    {
+      CheckCompiledProfile(*fastest,
+                           objectVariantData);
+    }
+
+    SECTION("Fastest path with junction penalty")
+    {
+      fastest->SetJunctionPenalty(true);
+
+      CheckCompiledProfile(*fastest,
+                           objectVariantData);
+    }
+
+    SECTION("Shortest path")
+    {
+      osmscout::ShortestPathRoutingProfile shortest(typeConfig);
+      std::map<std::string,double>         speedMap;
+
+      for (const auto& type : typeConfig->GetTypes()) {
+        speedMap[type->GetName()]=50.0;
+      }
+
+      switch (vehicle) {
+      case osmscout::vehicleFoot:
+        shortest.ParametrizeForFoot(*typeConfig,
+                                    5.0);
+        break;
+      case osmscout::vehicleBicycle:
+        shortest.ParametrizeForBicycle(*typeConfig,
+                                       20.0);
+        break;
+      case osmscout::vehicleCar:
+        REQUIRE(shortest.ParametrizeForCar(*typeConfig,
+                                           speedMap,
+                                           160.0));
+        break;
+      }
+
+      CheckCompiledProfile(shortest,
+                           objectVariantData);
+    }
+  }
+
+  database->Close();
+}
+
+/**
+ * Profile not allowing to leave route nodes, the compiled profile would not know about it
+ */
+class NoRouteNodeProfile : public osmscout::FastestPathRoutingProfile
+{
+public:
+  explicit NoRouteNodeProfile(const osmscout::TypeConfigRef& typeConfig)
+  : osmscout::FastestPathRoutingProfile(typeConfig)
+  {
+    // no code
+  }
+
+  bool CanUse(const osmscout::RouteNode& /*currentNode*/,
+              const std::vector<osmscout::ObjectVariantData>& /*objectVariantData*/,
+              size_t /*pathIndex*/) const override
+  {
+    return false;
+  }
+};
+
+TEST_CASE("Subclassed routing profiles are not compiled")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::TypeConfigRef                  typeConfig=database->GetTypeConfig();
+  std::vector<osmscout::ObjectVariantData> objectVariantData=GetObjectVariantData(*typeConfig);
+  NoRouteNodeProfile                       profile(typeConfig);
+  osmscout::CompiledRoutingProfile         compiled;
+
+  profile.ParametrizeForFoot(*typeConfig,
+                             5.0);
+
+  REQUIRE(!profile.Compile(objectVariantData,compiled));
+
+  database->Close();
+}
@@ -0,0 +1,119 @@
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+/**
+ * Offsets of all ways of the test region, in reverse file order
+ */
+static std::vector<osmscout::FileOffset> GetWayOffsets(const osmscout::Database& database)
+{
+  osmscout::FileScanner scanner;
+
+  scanner.Open(osmscout::AppendFileToDir(GetTestDatabaseDirectory(),osmscout::WayDataFile::WAYS_DAT),
+               osmscout::FileScanner::Sequential,
+               false);
+
+  uint32_t count=scanner.ReadUInt32();
+
+  std::vector<osmscout::DataBlockSpan> spans{{scanner.GetPos(),count}};
+  std::vector<osmscout::WayRef>        ways;
+
+  scanner.Close();
+
+  REQUIRE(database.GetWayDataFile()->GetByBlockSpans(spans.begin(),
+                                                     spans.end(),
+                                                     ways));
+
+  std::vector<osmscout::FileOffset> offsets;
+
+  for (auto way=ways.rbegin(); way!=ways.rend(); ++way) {
+    offsets.push_back((*way)->GetFileOffset());
+  }
+
+  return offsets;
+}
+
+TEST_CASE("Reading by offset returns the same ways with and without memory mapping")
+{
+  osmscout::DatabaseParameter mappedParameter;
+  osmscout::DatabaseParameter unmappedParameter;
+
+  mappedParameter.SetWayDataCacheSize(0);
+  unmappedParameter.SetWayDataCacheSize(0);
+  unmappedParameter.SetWaysDataMMap(false);
+
+  osmscout::Database mappedDatabase(mappedParameter);
+  osmscout::Database unmappedDatabase(unmappedParameter);
+
+  REQUIRE(mappedDatabase.Open(GetTestDatabaseDirectory()));
+  REQUIRE(unmappedDatabase.Open(GetTestDatabaseDirectory()));
+
+  std::vector<osmscout::FileOffset> offsets=GetWayOffsets(mappedDatabase);
+  std::vector<osmscout::WayRef>     mappedWays;
+  std::vector<osmscout::WayRef>     unmappedWays;
+
+  REQUIRE(!offsets.empty());
+  REQUIRE(mappedDatabase.GetWaysByOffset(offsets,mappedWays));
+  REQUIRE(unmappedDatabase.GetWaysByOffset(offsets,unmappedWays));
+
+  REQUIRE(mappedWays.size()==offsets.size());
+  REQUIRE(unmappedWays.size()==offsets.size());
+
+  for (size_t i=0; i<offsets.size(); i++) {
+    REQUIRE(mappedWays[i]->GetFileOffset()==offsets[i]);
+    REQUIRE(unmappedWays[i]->GetFileOffset()==offsets[i]);
+    REQUIRE(unmappedWays[i]->nodes.size()==mappedWays[i]->nodes.size());
+  }
+}
+
+TEST_CASE("Failed read by offset does not change the result vector")
+{
+  for (bool mmap : {true,false}) {
+    osmscout::DatabaseParameter parameter;
+
+    parameter.SetWaysDataMMap(mmap);
+
+    osmscout::Database database(parameter);
+
+    REQUIRE(database.Open(GetTestDatabaseDirectory()));
+
+    std::vector<osmscout::FileOffset> offsets=GetWayOffsets(database);
+    osmscout::FileOffset              fileSize=osmscout::GetFileSize(osmscout::AppendFileToDir(GetTestDatabaseDirectory(),
+                                                                                              osmscout::WayDataFile::WAYS_DAT));
+
+    // Valid offsets mixed with an offset beyond the end of the file
+    offsets.insert(offsets.begin()+offsets.size()/2,fileSize+1000);
+
+    osmscout::WayRef              existing=std::make_shared<osmscout::Way>();
+    std::vector<osmscout::WayRef> ways{existing};
+
+    REQUIRE(!database.GetWaysByOffset(offsets,ways));
+    REQUIRE(ways.size()==1);
+    REQUIRE(ways.front()==existing);
+  }
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+TEST_CASE("Resident size of a file just read is not larger than the file")
+{
+  std::string       filename=osmscout::AppendFileToDir(GetTestDatabaseDirectory(),
+                                                       osmscout::WayDataFile::WAYS_DAT);
+  std::vector<char> content;
+
+  REQUIRE(osmscout::ReadFile(filename,content));
+
+  osmscout::FileOffset residentSize=osmscout::GetFileResidentSize(filename);
+
+  REQUIRE(residentSize>0);
+  REQUIRE(residentSize<=osmscout::GetFileSize(filename));
+}
+
+TEST_CASE("Resident size of missing file throws exception")
+{
+  CHECK_THROWS_AS(osmscout::GetFileResidentSize("does_not_exist"),osmscout::IOException);
+}
+
+TEST_CASE("Preload complete test region")
+{
+  osmscout::DatabaseParameter parameter;
+  osmscout::Database          database(parameter);
+  osmscout::GeoBox            boundingBox;
+
+  REQUIRE(database.Open(GetTestDatabaseDirectory()));
+  REQUIRE(database.GetBoundingBox(boundingBox));
+
+  SECTION("Sequential") {
+    REQUIRE(database.Preload(boundingBox));
+  }
+
+  SECTION("Parallel") {
+    osmscout::PreloadOptions options;
+
+    options.SetParallel(true);
+
+    REQUIRE(database.Preload(boundingBox,options));
+  }
+
+  osmscout::DatabaseResidencyReport report=database.GetResidencyReport();
+
+  auto ways=std::find_if(report.begin(),report.end(),[](const osmscout::FileResidency& residency) {
+    return residency.filename==osmscout::WayDataFile::WAYS_DAT;
+  });
+
+  REQUIRE(ways!=report.end());
+  REQUIRE(ways->size>0);
+  REQUIRE(ways->residentSize>0);
+  REQUIRE(ways->residentSize<=ways->size);
+
+  for (const auto& residency : report) {
+    REQUIRE(residency.residentSize<=residency.size);
+  }
+
+  database.Close();
+}
+
+TEST_CASE("Preload of closed database fails")
+{
+  osmscout::DatabaseParameter parameter;
+  osmscout::Database          database(parameter);
+
+  REQUIRE(!database.Preload(osmscout::GeoBox(osmscout::GeoCoord(0.0,0.0),
+                                             osmscout::GeoCoord(1.0,1.0))));
+  REQUIRE(database.GetResidencyReport().empty());
+}
@@ -0,0 +1,261 @@
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+#include <osmscout/db/DatabaseRegistry.h>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileBatchReader.h>
+#include <osmscout/io/FileDescriptorPool.h>
+#include <osmscout/io/FileScannerPool.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+TEST_CASE("Databases with the same type configuration share the type config")
+{
+  auto                        registry=std::make_shared<osmscout::DatabaseRegistry>();
+  osmscout::DatabaseParameter parameter;
+
+  parameter.SetRegistry(registry);
+
+  {
+    osmscout::Database first(parameter);
+    osmscout::Database second(parameter);
+
+    REQUIRE(first.Open(GetTestDatabaseDirectory()));
+    REQUIRE(second.Open(GetTestDatabaseDirectory()));
+
+    REQUIRE(first.GetTypeConfig());
+    REQUIRE(first.GetTypeConfig()==second.GetTypeConfig());
+    REQUIRE(registry->GetTypeConfigCount()==1);
+
+    first.Close();
+    second.Close();
+  }
+
+  REQUIRE(registry->GetTypeConfigCount()==0);
+}
+
+TEST_CASE("Databases without registry have their own type config")
+{
+  osmscout::DatabaseParameter parameter;
+  osmscout::Database          first(parameter);
+  osmscout::Database          second(parameter);
+
+  REQUIRE(first.Open(GetTestDatabaseDirectory()));
+  REQUIRE(second.Open(GetTestDatabaseDirectory()));
+
+  REQUIRE(first.GetTypeConfig()!=second.GetTypeConfig());
+
+  first.Close();
+  second.Close();
+}
+
+TEST_CASE("Missing type config cannot be loaded")
+{
+  osmscout::DatabaseRegistry registry;
+
+  REQUIRE(!registry.LoadTypeConfig("does_not_exist"));
+}
+
+TEST_CASE("Idle scanners of other pools are closed, if there is no free descriptor")
+{
+  auto                     descriptorPool=std::make_shared<osmscout::FileDescriptorPool>(4,std::chrono::milliseconds(100));
+  std::string              filename=osmscout::AppendFileToDir(GetTestDatabaseDirectory(),
+                                                              osmscout::WayDataFile::WAYS_DAT);
+  osmscout::FileScannerPool first(10);
+  osmscout::FileScannerPool second(10);
+
+  first.SetDescriptorPool(descriptorPool);
+  second.SetDescriptorPool(descriptorPool);
+
+  first.Open(filename,osmscout::FileScanner::FastRandom,true);
+  second.Open(filename,osmscout::FileScanner::FastRandom,true);
+
+  REQUIRE(descriptorPool->GetOpen()==2);
+
+  {
+    auto scanner1=first.Borrow();
+    auto scanner2=first.Borrow();
+
+    REQUIRE(scanner1);
+    REQUIRE(scanner2);
+    REQUIRE(descriptorPool->GetOpen()==4);
+  }
+
+  // Both scanners are idle in the first pool now
+  REQUIRE(first.Size()==2);
+
+  {
+    auto scanner=second.Borrow();
+
+    REQUIRE(scanner);
+    REQUIRE(first.Size()==0);
+    REQUIRE(descriptorPool->GetOpen()==3);
+
+    auto another=second.Borrow();
+
+    REQUIRE(another);
+    REQUIRE(descriptorPool->GetOpen()==4);
+
+    // No descriptor left, the request times out
+    auto failed=second.Borrow();
+
+    REQUIRE(!failed);
+  }
+
+  first.Close();
+  second.Close();
+
+  REQUIRE(descriptorPool->GetOpen()==0);
+}
+
+TEST_CASE("Waiting request gets the descriptor of a returned scanner")
+{
+  auto                      descriptorPool=std::make_shared<osmscout::FileDescriptorPool>(3,std::chrono::seconds(10));
+  std::string               filename=osmscout::AppendFileToDir(GetTestDatabaseDirectory(),
+                                                               osmscout::WayDataFile::WAYS_DAT);
+  osmscout::FileScannerPool first(10);
+  osmscout::FileScannerPool second(10);
+
+  first.SetDescriptorPool(descriptorPool);
+  second.SetDescriptorPool(descriptorPool);
+
+  first.Open(filename,osmscout::FileScanner::FastRandom,true);
+  second.Open(filename,osmscout::FileScanner::FastRandom,true);
+
+  auto scanner=first.Borrow();
+
+  REQUIRE(scanner);
+
+  std::thread returner([&scanner]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    scanner.reset();
+  });
+
+  auto other=second.Borrow();
+
+  returner.join();
+
+  REQUIRE(other);
+  REQUIRE(first.Size()==0);
+  REQUIRE(descriptorPool->GetOpen()==3);
+
+  other.reset();
+
+  first.Close();
+  second.Close();
+
+  REQUIRE(descriptorPool->GetOpen()==0);
+}
+
+TEST_CASE("Data files of databases respect the descriptor limit")
+{
+  auto registry=std::make_shared<osmscout::DatabaseRegistry>();
+  auto descriptorPool=std::make_shared<osmscout::FileDescriptorPool>(16);
+
+  registry->SetFileDescriptorPool(descriptorPool);
+
+  osmscout::DatabaseParameter parameter;
+
+  parameter.SetRegistry(registry);
+
+  std::vector<osmscout::DatabaseRef> databases;
+
+  for (size_t i=0; i<3; i++) {
+    databases.push_back(std::make_shared<osmscout::Database>(parameter));
+
+    REQUIRE(databases.back()->Open(GetTestDatabaseDirectory()));
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<size_t>      failures(databases.size()*2,0);
+
+  for (size_t t=0; t<failures.size(); t++) {
+    threads.emplace_back([&databases,&failures,t]() {
+      osmscout::DatabaseRef database=databases[t%databases.size()];
+      osmscout::GeoBox      boundingBox;
+
+      if (!database->GetBoundingBox(boundingBox)) {
+        failures[t]++;
+        return;
+      }
+
+      osmscout::PreloadOptions options;
+
+      options.SetParallel(true);
+
+      for (size_t round=0; round<5; round++) {
+        if (!database->Preload(boundingBox,options)) {
+          failures[t]++;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t failureCount : failures) {
+    REQUIRE(failureCount==0);
+  }
+
+  REQUIRE(descriptorPool->GetOpen()<=descriptorPool->GetMaxOpen());
+
+  for (auto& database : databases) {
+    database->Close();
+  }
+
+  REQUIRE(descriptorPool->GetOpen()==0);
+}
+
+TEST_CASE("Batch readers of data files take a descriptor")
+{
+  auto registry=std::make_shared<osmscout::DatabaseRegistry>();
+  auto descriptorPool=std::make_shared<osmscout::FileDescriptorPool>(16);
+
+  registry->SetFileDescriptorPool(descriptorPool);
+
+  osmscout::DatabaseParameter parameter;
+
+  parameter.SetRegistry(registry);
+  parameter.SetWaysDataMMap(false);
+
+  osmscout::Database database(parameter);
+
+  REQUIRE(database.Open(GetTestDatabaseDirectory()));
+
+  size_t openBefore=descriptorPool->GetOpen();
+
+  REQUIRE(database.GetWayDataFile());
+
+  // The scanner of the data file and, if supported, the batch reader
+  REQUIRE(descriptorPool->GetOpen()==openBefore+(osmscout::FileBatchReader::IsSupported() ? 2 : 1));
+
+  database.Close();
+
+  REQUIRE(descriptorPool->GetOpen()==0);
+}
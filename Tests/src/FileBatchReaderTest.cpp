@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+  #include <filesystem>
+  #include <future>
+
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <osmscout/io/FileBatchReader.h>
+#include <osmscout/io/FileScanner.h>
+#include <osmscout/io/FileWriter.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static const char* const testFile="batch.dat";
+
+/**
+ * Write records (number, string) to the test file and return their offsets
+ */
+static std::vector<osmscout::FileOffset> WriteTestFile(size_t count)
+{
+  osmscout::FileWriter                 writer;
+  std::vector<osmscout::FileOffset>    offsets;
+
+  writer.Open(testFile);
+
+  for (size_t i=0; i<count; i++) {
+    offsets.push_back(writer.GetPos());
+
+    writer.WriteNumber((uint32_t)i);
+    // Some records are bigger than the default read ahead
+    writer.Write(std::string(i%100==0 ? 10000 : i%50,'x'));
+  }
+
+  writer.Close();
+
+  return offsets;
+}
+
+TEST_CASE("Plan ranges coalesces near offsets")
+{
+  std::vector<osmscout::FileOffset> offsets{0,100,5000,20000,20001};
+
+  auto ranges=osmscout::FileBatchReader::PlanRanges(offsets,20010,1000);
+
+  REQUIRE(ranges.size()==3);
+
+  REQUIRE(ranges[0].offset==0);
+  REQUIRE(ranges[0].length==1100);
+  REQUIRE(ranges[0].firstIndex==0);
+  REQUIRE(ranges[0].count==2);
+
+  REQUIRE(ranges[1].offset==5000);
+  REQUIRE(ranges[1].count==1);
+
+  // Limited by the file size
+  REQUIRE(ranges[2].offset==20000);
+  REQUIRE(ranges[2].length==10);
+  REQUIRE(ranges[2].firstIndex==3);
+  REQUIRE(ranges[2].count==2);
+}
+
+TEST_CASE("Batched read returns the same data as the scanner")
+{
+  std::vector<osmscout::FileOffset> offsets=WriteTestFile(1000);
+
+  // Every third record, requested in random order
+  std::vector<osmscout::FileOffset> requested;
+
+  for (size_t i=0; i<offsets.size(); i+=3) {
+    requested.push_back(offsets[i]);
+  }
+
+  std::sort(requested.begin(),requested.end());
+
+  for (bool useIoUring : {true,false}) {
+    osmscout::FileBatchReader reader(2);
+    osmscout::FileScanner     scanner;
+
+    reader.Open(testFile,useIoUring);
+    scanner.Open(testFile,osmscout::FileScanner::LowMemRandom,false);
+
+    auto                  ranges=osmscout::FileBatchReader::PlanRanges(requested,reader.GetSize());
+    std::vector<uint32_t> numbers(requested.size(),0);
+    std::vector<size_t>   tooBig;
+    size_t                rangesRead=0;
+
+    reader.Read(ranges,[&](osmscout::FileBatchReader::Range& range) {
+      rangesRead++;
+
+      for (size_t i=range.firstIndex; i<range.firstIndex+range.count; i++) {
+        scanner.AttachWindow(range.offset,range.data.data(),range.data.size());
+
+        try {
+          scanner.SetPos(requested[i]);
+          numbers[i]=scanner.ReadUInt32Number();
+          scanner.ReadString();
+        }
+        catch (const osmscout::IOException&) {
+          tooBig.push_back(i);
+        }
+
+        scanner.DetachWindow();
+      }
+    });
+
+    REQUIRE(rangesRead==ranges.size());
+    REQUIRE(!tooBig.empty());
+
+    // Records not fitting into the window can be read from the file directly
+    for (size_t i : tooBig) {
+      scanner.SetPos(requested[i]);
+      numbers[i]=scanner.ReadUInt32Number();
+      REQUIRE(scanner.ReadString().size()==10000);
+    }
+
+    for (size_t i=0; i<requested.size(); i++) {
+      REQUIRE(numbers[i]==i*3);
+    }
+
+    scanner.Close();
+    reader.Close();
+  }
+}
+
+#if defined(__linux__)
+/**
+ * Replace all io_uring file descriptors of the process by /dev/null, so that
+ * all following io_uring system calls fail
+ */
+static void BreakIoUrings()
+{
+  int nullFd=open("/dev/null",O_RDONLY);
+
+  REQUIRE(nullFd>=0);
+
+  for (const auto& entry : std::filesystem::directory_iterator("/proc/self/fd")) {
+    std::error_code error;
+
+    if (std::filesystem::read_symlink(entry.path(),error).string()=="anon_inode:[io_uring]") {
+      dup2(nullFd,std::stoi(entry.path().filename().string()));
+    }
+  }
+
+  close(nullFd);
+}
+
+TEST_CASE("Failing io_uring submission does not release buffers of reads in flight")
+{
+  static const char* const fifoFile="batch.fifo";
+
+  unlink(fifoFile);
+  REQUIRE(mkfifo(fifoFile,0600)==0);
+
+  std::promise<void> readFailed;
+
+  // Reads from a pipe stay in flight until there is data to read
+  std::thread writer([&readFailed]() {
+    int fd=open(fifoFile,O_WRONLY);
+
+    REQUIRE(fd>=0);
+    REQUIRE(write(fd,"0123456789",10)==10);
+
+    // Data for the reads, that were in flight when the ring failed
+    readFailed.get_future().wait();
+    REQUIRE(write(fd,"012345678901234567890123456789",30)==30);
+
+    close(fd);
+  });
+
+  osmscout::FileBatchReader reader(2);
+
+  reader.Open(fifoFile,true);
+
+  if (reader.GetBackend()==osmscout::FileBatchReader::Backend::IoUring) {
+    std::vector<osmscout::FileBatchReader::Range> ranges(4);
+    size_t                                        rangesRead=0;
+
+    for (auto& range : ranges) {
+      range.length=10;
+      range.count=1;
+    }
+
+    REQUIRE_THROWS_AS(reader.Read(ranges,[&rangesRead](osmscout::FileBatchReader::Range& range) {
+                        REQUIRE(range.data.size()==10);
+                        rangesRead++;
+                        // The other reads are still in flight
+                        BreakIoUrings();
+                      }),
+                      osmscout::IOException);
+
+    REQUIRE(rangesRead==1);
+  }
+
+  readFailed.set_value();
+  writer.join();
+  reader.Close();
+  unlink(fifoFile);
+}
+#endif
@@ -35,12 +35,30 @@ TEST_CASE("Database::GetFileFormatVersion(dir) throws exception on missing db")
   CHECK_THROWS_AS(osmscout::Database::GetDatabaseFileFormatVersion("does_not_exist"),osmscout::IOException);
 }
 
-TEST_CASE("TypeConfig::GetFileFormatVersion(dir) returns current version for test database") {
-  REQUIRE(osmscout::TypeConfig::GetDatabaseFileFormatVersion(GetTestDatabaseDirectory()) == osmscout::FILE_FORMAT_VERSION);
+TEST_CASE("TypeConfig::GetFileFormatVersion(dir) returns supported version for test database") {
+  uint32_t version=osmscout::TypeConfig::GetDatabaseFileFormatVersion(GetTestDatabaseDirectory());
+  uint32_t minVersion=osmscout::TypeConfig::MIN_FORMAT_VERSION;
+  uint32_t maxVersion=osmscout::TypeConfig::MAX_FORMAT_VERSION;
+
+  REQUIRE(version >= minVersion);
+  REQUIRE(version <= maxVersion);
 }
 
-TEST_CASE("Database::GetFileFormatVersion(dir) returns current version for test database") {
-  REQUIRE(osmscout::Database::GetDatabaseFileFormatVersion(GetTestDatabaseDirectory()) == osmscout::FILE_FORMAT_VERSION);
+TEST_CASE("Database::GetFileFormatVersion(dir) returns supported version for test database") {
+  uint32_t version=osmscout::Database::GetDatabaseFileFormatVersion(GetTestDatabaseDirectory());
+  uint32_t minVersion=osmscout::TypeConfig::MIN_FORMAT_VERSION;
+  uint32_t maxVersion=osmscout::TypeConfig::MAX_FORMAT_VERSION;
+
+  REQUIRE(version >= minVersion);
+  REQUIRE(version <= maxVersion);
+}
+
+TEST_CASE("Current version is the newest supported version") {
+  uint32_t minVersion=osmscout::TypeConfig::MIN_FORMAT_VERSION;
+  uint32_t maxVersion=osmscout::TypeConfig::MAX_FORMAT_VERSION;
+
+  REQUIRE(maxVersion == osmscout::FILE_FORMAT_VERSION);
+  REQUIRE(minVersion < osmscout::FILE_FORMAT_VERSION);
 }
 
 TEST_CASE("Database::GetLibraryFileFormatVersion() returns current version") {
@@ -380,3 +380,171 @@ TEST_CASE("FileScannerWriter")
     scanner.Close();
   }
 }
+
+TEST_CASE("CoordArrayView matches materialized coordinates")
+{
+  osmscout::FileWriter  writer;
+  osmscout::FileScanner scanner;
+
+  std::vector<std::vector<osmscout::Point>> outCoords(4);
+
+  outCoords[0].emplace_back(0, osmscout::GeoCoord(51.57231, 7.46418));
+  outCoords[0].emplace_back(1, osmscout::GeoCoord(51.57233, 7.46430));
+  outCoords[0].emplace_back(0, osmscout::GeoCoord(51.57261, 7.46563));
+
+  outCoords[1].emplace_back(0, osmscout::GeoCoord(51.58549, 7.55493));
+  outCoords[1].emplace_back(2, osmscout::GeoCoord(51.59549, 7.45493));
+  outCoords[1].emplace_back(0, osmscout::GeoCoord(51.58550, 7.55496));
+
+  outCoords[2].emplace_back(0, osmscout::GeoCoord(5.0, -5.0));
+  outCoords[2].emplace_back(0, osmscout::GeoCoord(5.0, 5.0));
+  outCoords[2].emplace_back(0, osmscout::GeoCoord(-5.0, 5.0));
+
+  outCoords[3].emplace_back(0, osmscout::GeoCoord(51.58549, 7.55493));
+
+  writer.Open("view.dat");
+
+  for (const auto& coords : outCoords) {
+    writer.Write(coords, true);
+  }
+
+  osmscout::FileOffset finalWriteFileOffset = writer.GetPos();
+
+  writer.Close();
+
+  scanner.Open("view.dat", osmscout::FileScanner::Normal, true);
+  REQUIRE(scanner.IsMemoryMapped());
+
+  for (const auto& coords : outCoords) {
+    osmscout::CoordArrayView view = scanner.ReadCoordArrayView(true);
+    std::vector<osmscout::Point> inCoords;
+
+    view.CopyTo(inCoords);
+
+    REQUIRE(view.size() == coords.size());
+    REQUIRE(Equals(inCoords, coords));
+  }
+
+  REQUIRE(finalWriteFileOffset == scanner.GetPos());
+
+  scanner.Close();
+}
+
+TEST_CASE("Stream-vbyte encoded coordinates match fixed width encoded coordinates")
+{
+  osmscout::FileWriter  writer;
+  osmscout::FileScanner scanner;
+
+  std::vector<std::vector<osmscout::Point>> outCoords(4);
+
+  // Long way with deltas of all sizes (1 to 4 bytes after zigzag encoding)
+  for (size_t i = 0; i < 1500; i++) {
+    double step = (i % 7 == 0) ? 0.5 : ((i % 3 == 0) ? 0.01 : 0.00001);
+
+    outCoords[0].emplace_back(i % 5 == 0 ? 1 : 0,
+                              osmscout::GeoCoord(40.0 + ((i % 2 == 0) ? step : -step) + i * 0.00002,
+                                                 7.0 + ((i % 4 == 0) ? -step : step)));
+  }
+
+  outCoords[1].emplace_back(0, osmscout::GeoCoord(51.57231, 7.46418));
+  outCoords[1].emplace_back(1, osmscout::GeoCoord(51.57233, 7.46430));
+  outCoords[1].emplace_back(0, osmscout::GeoCoord(51.57261, 7.46563));
+
+  outCoords[2].emplace_back(0, osmscout::GeoCoord(5.0, -5.0));
+  outCoords[2].emplace_back(0, osmscout::GeoCoord(5.0, 5.0));
+
+  outCoords[3].emplace_back(0, osmscout::GeoCoord(51.58549, 7.55493));
+
+  writer.Open("streamvbyte.dat");
+  writer.SetCoordEncoding(osmscout::CoordEncoding::streamVByte);
+
+  for (const auto& coords : outCoords) {
+    writer.Write(coords, true);
+  }
+
+  writer.SetCoordEncoding(osmscout::CoordEncoding::fixedWidth);
+
+  for (const auto& coords : outCoords) {
+    writer.Write(coords, true);
+  }
+
+  osmscout::FileOffset finalWriteFileOffset = writer.GetPos();
+
+  writer.Close();
+
+  for (bool memoryMapped : {true, false}) {
+    scanner.Open("streamvbyte.dat", osmscout::FileScanner::Normal, memoryMapped);
+
+    for (size_t pass = 0; pass < 2; pass++) {
+      for (const auto& coords : outCoords) {
+        std::vector<osmscout::Point>         inCoords;
+        std::vector<osmscout::SegmentGeoBox> segments;
+        osmscout::GeoBox                     bbox;
+
+        scanner.Read(inCoords, segments, bbox, true);
+
+        REQUIRE(Equals(inCoords, coords));
+
+        for (size_t i = 0; i < coords.size(); i++) {
+          REQUIRE(inCoords[i].GetSerial() == coords[i].GetSerial());
+        }
+      }
+    }
+
+    REQUIRE(finalWriteFileOffset == scanner.GetPos());
+
+    if (memoryMapped) {
+      scanner.SetPos(0);
+
+      for (const auto& coords : outCoords) {
+        osmscout::CoordArrayView     view = scanner.ReadCoordArrayView(true);
+        std::vector<osmscout::Point> inCoords;
+
+        view.CopyTo(inCoords);
+
+        REQUIRE(Equals(inCoords, coords));
+      }
+    }
+
+    scanner.Close();
+  }
+}
+
+TEST_CASE("Stream-vbyte SIMD and scalar decoding are equal")
+{
+  std::vector<int32_t> deltas;
+
+  for (int32_t i = 0; i < 1001; i++) {
+    deltas.push_back((i % 2 == 0 ? 1 : -1) * ((i * 7919) % (1 << (i % 25))));
+    deltas.push_back(i % 3 == 0 ? 8388608 : -(i % 200));
+  }
+
+  std::vector<uint8_t> buffer;
+
+  osmscout::StreamVByteEncode(deltas, buffer);
+
+  size_t         controlLength = osmscout::StreamVByteControlLength(deltas.size());
+  const uint8_t* control = buffer.data();
+  const uint8_t* data = buffer.data() + controlLength;
+
+  REQUIRE(controlLength + osmscout::StreamVByteDataLength(control, deltas.size()) == buffer.size());
+
+  std::vector<uint32_t> simd(deltas.size());
+  std::vector<uint32_t> scalar(deltas.size());
+
+  osmscout::StreamVByteDecodeCoords(control, data, buffer.data() + buffer.size(), deltas.size(), 1u << 26, 1u << 26, simd.data());
+  osmscout::StreamVByteDecodeCoords(control, data, buffer.data() + buffer.size(), deltas.size(), 1u << 26, 1u << 26, scalar.data(), false);
+
+  REQUIRE(simd == scalar);
+
+  uint32_t lat = 1u << 26;
+  uint32_t lon = 1u << 26;
+
+  for (size_t i = 0; i < deltas.size(); i += 2) {
+    lat += deltas[i];
+    lon += deltas[i + 1];
+
+    REQUIRE(scalar[i] == lat);
+    REQUIRE(scalar[i + 1] == lon);
+  }
+}
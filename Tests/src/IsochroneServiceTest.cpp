@@ -0,0 +1,243 @@
+#include <cmath>
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/IsochroneService.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+static bool IsInRing(const osmscout::GeoCoord& coord,
+                     const std::vector<osmscout::GeoCoord>& ring)
+{
+  bool inside=false;
+
+  for (size_t i=0, j=ring.size()-1; i<ring.size(); j=i++) {
+    if ((ring[i].GetLat()>coord.GetLat())!=(ring[j].GetLat()>coord.GetLat()) &&
+        coord.GetLon()<(ring[j].GetLon()-ring[i].GetLon())*(coord.GetLat()-ring[i].GetLat())/(ring[j].GetLat()-ring[i].GetLat())+ring[i].GetLon()) {
+      inside=!inside;
+    }
+  }
+
+  return inside;
+}
+
+static bool IsInIsochrone(const osmscout::GeoCoord& coord,
+                          const osmscout::Isochrone& isochrone)
+{
+  for (const auto& polygon : isochrone.polygons) {
+    if (!IsInRing(coord,polygon.outer)) {
+      continue;
+    }
+
+    bool inHole=false;
+
+    for (const auto& hole : polygon.holes) {
+      inHole=inHole || IsInRing(coord,hole);
+    }
+
+    if (!inHole) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Area in square degrees, good enough for comparing isochrones
+ */
+static double GetArea(const osmscout::Isochrone& isochrone)
+{
+  auto GetRingArea=[](const std::vector<osmscout::GeoCoord>& ring) {
+    double area=0.0;
+
+    for (size_t i=0, j=ring.size()-1; i<ring.size(); j=i++) {
+      area+=ring[j].GetLon()*ring[i].GetLat()-ring[i].GetLon()*ring[j].GetLat();
+    }
+
+    return area/2.0;
+  };
+
+  double area=0.0;
+
+  for (const auto& polygon : isochrone.polygons) {
+    area+=GetRingArea(polygon.outer);
+
+    for (const auto& hole : polygon.holes) {
+      area+=GetRingArea(hole); // clockwise, negative
+    }
+  }
+
+  return area;
+}
+
+TEST_CASE("Isochrones contain the route nodes within their budget")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter  routerParameter;
+  osmscout::IsochroneService router(database,
+                                    routerParameter,
+                                    osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(router.Open());
+
+  osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                               osmscout::vehicleFoot);
+  osmscout::RoutePositionResult          start=router.GetClosestRoutableNode(osmscout::GeoCoord(50.4180,14.5600),
+                                                                             *profile,
+                                                                             osmscout::Kilometers(1));
+
+  REQUIRE(start.IsValid());
+
+  std::vector<osmscout::IsochroneBudget> budgets(3);
+
+  budgets[0].duration=osmscout::DurationOfHours(5.0/60.0);
+  budgets[1].duration=osmscout::DurationOfHours(10.0/60.0);
+  budgets[2].duration=osmscout::DurationOfHours(20.0/60.0);
+
+  osmscout::RoutingParameter parameter;
+  osmscout::IsochroneResult  result=router.CalculateIsochrones(*profile,
+                                                              start.GetRoutePosition(),
+                                                              budgets,
+                                                              osmscout::Meters(50),
+                                                              parameter);
+
+  REQUIRE(result.Success());
+  REQUIRE(result.GetIsochrones().size()==budgets.size());
+  REQUIRE(!result.GetNodes().empty());
+
+  for (const auto& isochrone : result.GetIsochrones()) {
+    REQUIRE(!isochrone.polygons.empty());
+  }
+
+  CHECK(GetArea(result.GetIsochrones()[0])>0.0);
+  CHECK(GetArea(result.GetIsochrones()[0])<GetArea(result.GetIsochrones()[1]));
+  CHECK(GetArea(result.GetIsochrones()[1])<GetArea(result.GetIsochrones()[2]));
+
+  for (size_t i=0; i<result.GetNodes().size(); i++) {
+    const osmscout::IsochroneNode& node=result.GetNodes()[i];
+
+    CHECK(node.duration<=*budgets[2].duration);
+
+    if (i>0) {
+      CHECK(result.GetNodes()[i-1].duration<=node.duration);
+    }
+
+    for (size_t b=0; b<budgets.size(); b++) {
+      if (node.duration<=*budgets[b].duration) {
+        CHECK(IsInIsochrone(node.coord,result.GetIsochrones()[b]));
+      }
+    }
+  }
+
+  router.Close();
+  database->Close();
+}
+
+TEST_CASE("Isochrone distance budgets limit the search")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter  routerParameter;
+  osmscout::IsochroneService router(database,
+                                    routerParameter,
+                                    osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(router.Open());
+
+  osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                               osmscout::vehicleCar);
+  osmscout::RoutePositionResult          start=router.GetClosestRoutableNode(osmscout::GeoCoord(50.412,14.534),
+                                                                             *profile,
+                                                                             osmscout::Kilometers(1));
+
+  REQUIRE(start.IsValid());
+
+  osmscout::RoutingParameter parameter;
+
+  SECTION("All nodes are within the distance")
+  {
+    std::vector<osmscout::IsochroneBudget> budgets(1);
+
+    budgets[0].distance=osmscout::Kilometers(2);
+
+    osmscout::IsochroneResult result=router.CalculateIsochrones(*profile,
+                                                                start.GetRoutePosition(),
+                                                                budgets,
+                                                                osmscout::Meters(100),
+                                                                parameter);
+
+    REQUIRE(result.Success());
+    REQUIRE(!result.GetNodes().empty());
+
+    for (const auto& node : result.GetNodes()) {
+      CHECK(node.distance<=*budgets[0].distance);
+    }
+  }
+
+  SECTION("Budgets must limit the search")
+  {
+    std::vector<osmscout::IsochroneBudget> budgets(2);
+
+    budgets[0].distance=osmscout::Kilometers(2);
+    budgets[1].duration=osmscout::DurationOfHours(0.1);
+
+    osmscout::IsochroneResult result=router.CalculateIsochrones(*profile,
+                                                                start.GetRoutePosition(),
+                                                                budgets,
+                                                                osmscout::Meters(100),
+                                                                parameter);
+
+    CHECK(!result.Success());
+  }
+
+  SECTION("Cell sizes resulting in too many cells are rejected")
+  {
+    std::vector<osmscout::IsochroneBudget> budgets(1);
+
+    budgets[0].distance=osmscout::Kilometers(2);
+
+    osmscout::IsochroneResult result=router.CalculateIsochrones(*profile,
+                                                                start.GetRoutePosition(),
+                                                                budgets,
+                                                                osmscout::Meters(0.01),
+                                                                parameter);
+
+    CHECK(!result.Success());
+  }
+
+  router.Close();
+  database->Close();
+}
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <filesystem>
+#include <list>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscoutmap/MapPainterNoOp.h>
+#include <osmscoutmap/MapService.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestsTopDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return testsTopDir;
+}
+
+/**
+ * Painter recording the coordinates of all drawn paths and areas
+ */
+class RecordingPainter : public osmscout::MapPainterNoOp
+{
+public:
+  std::vector<std::vector<osmscout::Vertex2D>> paths;
+  std::vector<std::vector<osmscout::Vertex2D>> areas;
+
+private:
+  static std::vector<osmscout::Vertex2D> GetCoords(const osmscout::CoordBufferRange& coordRange)
+  {
+    std::vector<osmscout::Vertex2D> coords;
+
+    for (size_t i=coordRange.GetStart(); i<=coordRange.GetEnd(); i++) {
+      coords.push_back(coordRange.Get(i));
+    }
+
+    return coords;
+  }
+
+protected:
+  void DrawPath(const osmscout::Projection& /*projection*/,
+                const osmscout::MapParameter& /*parameter*/,
+                const osmscout::Color& /*color*/,
+                double /*width*/,
+                const std::vector<double>& /*dash*/,
+                osmscout::LineStyle::CapStyle /*startCap*/,
+                osmscout::LineStyle::CapStyle /*endCap*/,
+                const osmscout::CoordBufferRange& coordRange) override
+  {
+    REQUIRE(coordRange.GetEnd()<coordBuffer.GetSize());
+
+    paths.push_back(GetCoords(coordRange));
+  }
+
+  void DrawArea(const osmscout::Projection& /*projection*/,
+                const osmscout::MapParameter& /*parameter*/,
+                const AreaData& area) override
+  {
+    REQUIRE(area.coordRange.GetEnd()<coordBuffer.GetSize());
+
+    areas.push_back(GetCoords(area.coordRange));
+
+    for (const auto& clipping : area.clippings) {
+      REQUIRE(clipping.GetEnd()<coordBuffer.GetSize());
+
+      areas.push_back(GetCoords(clipping));
+    }
+  }
+
+public:
+  explicit RecordingPainter(const osmscout::StyleConfigRef& styleConfig)
+  : MapPainterNoOp(styleConfig)
+  {
+    // no code
+  }
+};
+
+static bool operator==(const osmscout::Vertex2D& a,
+                       const osmscout::Vertex2D& b)
+{
+  return a.GetX()==b.GetX() &&
+         a.GetY()==b.GetY();
+}
+
+TEST_CASE("Preprocessing result does not depend on the number of threads")
+{
+  std::string                 testsTopDir=GetTestsTopDirectory();
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(std::filesystem::path(testsTopDir).append("data").append("testregion").string()));
+
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  REQUIRE(styleConfig->Load(std::filesystem::path(testsTopDir).append("..").append("stylesheets").append("standard.oss").string()));
+
+  osmscout::MapServiceRef    mapService=std::make_shared<osmscout::MapService>(database);
+  osmscout::MercatorProjection projection;
+  osmscout::Magnification    magnification{osmscout::MagnificationLevel(14)};
+
+  // 4K screen covering the test region
+  REQUIRE(projection.Set(osmscout::GeoCoord(50.42,14.57),
+                         magnification,
+                         200.0,
+                         3840,
+                         2160));
+
+  osmscout::GeoBox                   boundingBox=projection.GetDimensions();
+  std::list<osmscout::TileRef>       tiles;
+  osmscout::AreaSearchParameter      searchParameter;
+  osmscout::MapData                  data;
+
+  mapService->LookupTiles(magnification,boundingBox,tiles);
+  REQUIRE(mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles));
+  mapService->AddTileDataToMapData(tiles,data);
+
+  REQUIRE(!data.ways.empty());
+  REQUIRE(!data.areas.empty());
+
+  // The test region is small, repeat its objects so that preprocessing
+  // is actually distributed over multiple threads
+  for (size_t i=0; i<8; i++) {
+    data.poiWays.insert(data.poiWays.end(),data.ways.begin(),data.ways.end());
+    data.poiAreas.insert(data.poiAreas.end(),data.areas.begin(),data.areas.end());
+  }
+
+  REQUIRE(data.ways.size()+data.poiWays.size()>=1024);
+  REQUIRE(data.areas.size()+data.poiAreas.size()>=1024);
+
+  RecordingPainter            sequentialPainter(styleConfig);
+  osmscout::MapParameter      sequentialParameter;
+
+  REQUIRE(sequentialPainter.DrawMap(projection,
+                                    sequentialParameter,
+                                    data));
+
+  CHECK(!sequentialPainter.paths.empty());
+  CHECK(!sequentialPainter.areas.empty());
+
+  for (size_t threadCount : {2,4,0}) {
+    RecordingPainter       parallelPainter(styleConfig);
+    osmscout::MapParameter parallelParameter;
+
+    parallelParameter.SetPreprocessingThreadCount(threadCount);
+
+    // Painters are reused, buffers of a previous render action must not leak
+    for (size_t i=0; i<2; i++) {
+      parallelPainter.paths.clear();
+      parallelPainter.areas.clear();
+
+      REQUIRE(parallelPainter.DrawMap(projection,
+                                      parallelParameter,
+                                      data));
+
+      CHECK(parallelPainter.paths==sequentialPainter.paths);
+      CHECK(parallelPainter.areas==sequentialPainter.areas);
+    }
+  }
+
+  database->Close();
+}
+
+TEST_CASE("Way views are drawn like the ways")
+{
+  std::string                 testsTopDir=GetTestsTopDirectory();
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(std::filesystem::path(testsTopDir).append("data").append("testregion").string()));
+
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  REQUIRE(styleConfig->Load(std::filesystem::path(testsTopDir).append("..").append("stylesheets").append("standard.oss").string()));
+
+  osmscout::MapServiceRef      mapService=std::make_shared<osmscout::MapService>(database);
+  osmscout::MercatorProjection projection;
+  osmscout::Magnification      magnification{osmscout::MagnificationLevel(14)};
+
+  REQUIRE(projection.Set(osmscout::GeoCoord(50.42,14.57),
+                         magnification,
+                         200.0,
+                         3840,
+                         2160));
+
+  osmscout::GeoBox              boundingBox=projection.GetDimensions();
+  std::list<osmscout::TileRef>  tiles;
+  osmscout::AreaSearchParameter searchParameter;
+  osmscout::MapData             wayData;
+  osmscout::MapData             viewData;
+  osmscout::TypeInfoSet         wayTypes;
+
+  mapService->LookupTiles(magnification,boundingBox,tiles);
+  REQUIRE(mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles));
+  mapService->AddTileDataToMapData(tiles,wayData);
+
+  // Tiles may hold ways outside of the projection, views are only loaded for the projection
+  wayData.areas.clear();
+  wayData.ways.erase(std::remove_if(wayData.ways.begin(),
+                                    wayData.ways.end(),
+                                    [&boundingBox](const osmscout::WayRef& way) {
+                                      return !way->GetBoundingBox().Intersects(boundingBox);
+                                    }),
+                     wayData.ways.end());
+
+  REQUIRE(!wayData.ways.empty());
+
+  for (const auto& way : wayData.ways) {
+    wayTypes.Set(way->GetType());
+  }
+
+  REQUIRE(mapService->LoadWayViews(searchParameter,
+                                   wayTypes,
+                                   boundingBox,
+                                   viewData));
+
+  REQUIRE(viewData.wayViews.size()==wayData.ways.size());
+
+  RecordingPainter       wayPainter(styleConfig);
+  RecordingPainter       viewPainter(styleConfig);
+  osmscout::MapParameter parameter;
+
+  REQUIRE(wayPainter.DrawMap(projection,
+                             parameter,
+                             wayData));
+  REQUIRE(viewPainter.DrawMap(projection,
+                              parameter,
+                              viewData));
+
+  REQUIRE(!wayPainter.paths.empty());
+
+  // The order of ways with the same style depends on the order they are loaded in
+  std::sort(wayPainter.paths.begin(),wayPainter.paths.end());
+  std::sort(viewPainter.paths.begin(),viewPainter.paths.end());
+
+  CHECK(viewPainter.paths==wayPainter.paths);
+
+  database->Close();
+}
@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/util/MemoryBudget.h>
+#include <osmscout/util/ShardedCache.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using IntCache = osmscout::ShardedCache<int,std::string>;
+
+static constexpr size_t ValueMemory=1000;
+
+/**
+ * Charges a fixed amount of memory per value, so that the entry overhead does not matter much
+ */
+struct FixedMemorySizer : public IntCache::ValueSizer
+{
+  size_t GetSize(const std::string& /*value*/) const override
+  {
+    return ValueMemory;
+  }
+};
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+static size_t CountEntries(IntCache& cache,
+                           int from,
+                           int to)
+{
+  size_t count=0;
+
+  for (int key=from; key<to; key++) {
+    std::string value;
+
+    if (cache.GetEntry(key,value)) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+TEST_CASE("Budget is charged and released by the cache")
+{
+  auto     budget=std::make_shared<osmscout::MemoryBudget>(1'000'000);
+  IntCache cache(100,1);
+
+  cache.SetMemoryBudget(budget,"cache",std::make_shared<FixedMemorySizer>());
+
+  for (int key=0; key<10; key++) {
+    cache.SetEntry(key,std::to_string(key));
+  }
+
+  REQUIRE(budget->GetSize()>=10*ValueMemory);
+  REQUIRE(!budget->IsExceeded());
+
+  auto statistics=budget->GetStatistics();
+
+  REQUIRE(statistics.size()==1);
+  REQUIRE(statistics[0].name=="cache");
+  REQUIRE(statistics[0].entries==10);
+  REQUIRE(statistics[0].memory==budget->GetSize());
+
+  cache.Flush();
+
+  REQUIRE(budget->GetSize()==0);
+}
+
+TEST_CASE("Least recently accessed entries of all caches are evicted first")
+{
+  auto     budget=std::make_shared<osmscout::MemoryBudget>(1'000'000);
+  IntCache oldCache(1000,1);
+  IntCache newCache(1000,1);
+
+  oldCache.SetMemoryBudget(budget,"old",std::make_shared<FixedMemorySizer>());
+  newCache.SetMemoryBudget(budget,"new",std::make_shared<FixedMemorySizer>());
+
+  for (int key=0; key<100; key++) {
+    oldCache.SetEntry(key,std::to_string(key));
+  }
+
+  for (int key=0; key<100; key++) {
+    newCache.SetEntry(key,std::to_string(key));
+  }
+
+  size_t entryMemory=budget->GetSize()/200;
+
+  // Leave room for 150 entries
+  budget->SetMaxSize(150*entryMemory);
+
+  REQUIRE(!budget->IsExceeded());
+  REQUIRE(oldCache.GetSize()==50);
+  REQUIRE(newCache.GetSize()==100);
+
+  // The most recently used entries of the old cache survive
+  REQUIRE(CountEntries(oldCache,50,100)==50);
+
+  // Now the old cache holds the most recently accessed entries
+  for (int key=100; key<150; key++) {
+    oldCache.SetEntry(key,std::to_string(key));
+  }
+
+  REQUIRE(!budget->IsExceeded());
+  REQUIRE(oldCache.GetSize()==100);
+  REQUIRE(newCache.GetSize()==50);
+  REQUIRE(CountEntries(newCache,50,100)==50);
+
+  size_t evictions=0;
+
+  for (const auto& statistics : budget->GetStatistics()) {
+    evictions+=statistics.evictions;
+  }
+
+  REQUIRE(evictions==100);
+}
+
+TEST_CASE("Entry count limit still applies")
+{
+  auto     budget=std::make_shared<osmscout::MemoryBudget>(1'000'000);
+  IntCache cache(10,1);
+
+  cache.SetMemoryBudget(budget,"cache",std::make_shared<FixedMemorySizer>());
+
+  for (int key=0; key<100; key++) {
+    cache.SetEntry(key,std::to_string(key));
+  }
+
+  REQUIRE(cache.GetSize()==10);
+  REQUIRE(budget->GetSize()==budget->GetStatistics()[0].memory);
+}
+
+TEST_CASE("Detached caches release their memory")
+{
+  auto budget=std::make_shared<osmscout::MemoryBudget>(1'000'000);
+
+  {
+    IntCache cache(100,1);
+
+    cache.SetMemoryBudget(budget,"cache",std::make_shared<FixedMemorySizer>());
+    cache.SetEntry(1,"1");
+
+    REQUIRE(budget->GetSize()>0);
+  }
+
+  REQUIRE(budget->GetSize()==0);
+  REQUIRE(budget->GetStatistics().empty());
+}
+
+/**
+ * Consumer with a fixed oldest access, that cannot evict anything
+ */
+struct FixedAccessConsumer : public osmscout::MemoryBudget::Consumer
+{
+  uint64_t oldestAccess;
+
+  explicit FixedAccessConsumer(uint64_t oldestAccess)
+  : oldestAccess(oldestAccess)
+  {
+    // no code
+  }
+
+  uint64_t GetOldestAccess() const override
+  {
+    return oldestAccess;
+  }
+
+  size_t Evict(size_t /*bytes*/,
+               uint64_t /*newerThan*/) override
+  {
+    return 0;
+  }
+
+  osmscout::MemoryBudget::Statistics GetStatistics() const override
+  {
+    return {};
+  }
+};
+
+TEST_CASE("Oldest access of the other consumers")
+{
+  osmscout::MemoryBudget budget(1'000'000);
+  FixedAccessConsumer    a(10);
+  FixedAccessConsumer    b(5);
+  FixedAccessConsumer    c(osmscout::MemoryBudget::NoAccess);
+
+  REQUIRE(budget.GetOldestAccessOfOthers(a)==osmscout::MemoryBudget::NoAccess);
+
+  budget.Register(a);
+  budget.Register(b);
+  budget.Register(c);
+
+  REQUIRE(budget.GetOldestAccessOfOthers(a)==5);
+  REQUIRE(budget.GetOldestAccessOfOthers(b)==10);
+  REQUIRE(budget.GetOldestAccessOfOthers(c)==5);
+
+  budget.Unregister(b);
+
+  REQUIRE(budget.GetOldestAccessOfOthers(a)==osmscout::MemoryBudget::NoAccess);
+  REQUIRE(budget.GetOldestAccessOfOthers(c)==10);
+
+  budget.Unregister(a);
+  budget.Unregister(c);
+}
+
+TEST_CASE("Concurrent access respects the budget")
+{
+  auto     budget=std::make_shared<osmscout::MemoryBudget>(100*ValueMemory);
+  IntCache first(10000);
+  IntCache second(10000);
+
+  first.SetMemoryBudget(budget,"first",std::make_shared<FixedMemorySizer>());
+  second.SetMemoryBudget(budget,"second",std::make_shared<FixedMemorySizer>());
+
+  std::vector<std::thread> threads;
+
+  for (int t=0; t<4; t++) {
+    threads.emplace_back([&first,&second,t]() {
+      IntCache& cache=t%2==0 ? first : second;
+
+      for (int key=0; key<10000; key++) {
+        std::string value;
+
+        if (!cache.GetEntry(key%500,value)) {
+          cache.SetEntry(key%500,std::to_string(key));
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(!budget->IsExceeded());
+
+  first.Flush();
+  second.Flush();
+
+  REQUIRE(budget->GetSize()==0);
+}
+
+TEST_CASE("Concurrent inserts and evictions never release uncharged memory")
+{
+  // Small limits, so that nearly every insert evicts entries just inserted by the
+  // other threads, either because of the budget or because of the entry count
+  auto     budget=std::make_shared<osmscout::MemoryBudget>(4*ValueMemory);
+  IntCache cache(1);
+
+  cache.SetMemoryBudget(budget,"cache",std::make_shared<FixedMemorySizer>());
+
+  std::atomic<bool>        done=false;
+  std::atomic<bool>        inconsistent=false;
+  std::vector<std::thread> threads;
+
+  // Releasing memory before it was charged wraps the size around
+  std::thread observer([&budget,&done,&inconsistent]() {
+    while (!done) {
+      if (budget->GetSize()>100*ValueMemory) {
+        inconsistent=true;
+      }
+    }
+  });
+
+  for (int t=0; t<8; t++) {
+    threads.emplace_back([&cache,t]() {
+      for (int i=0; i<100000; i++) {
+        cache.SetEntry(t*100000+i,"value");
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  done=true;
+  observer.join();
+
+  REQUIRE(!inconsistent);
+  REQUIRE(!budget->IsExceeded());
+
+  cache.Flush();
+
+  REQUIRE(budget->GetSize()==0);
+}
+
+TEST_CASE("Database caches draw from the budget")
+{
+  auto                        budget=std::make_shared<osmscout::MemoryBudget>(200'000);
+  osmscout::DatabaseParameter parameter;
+
+  parameter.SetMemoryBudget(budget);
+
+  osmscout::Database database(parameter);
+  osmscout::GeoBox   boundingBox;
+
+  REQUIRE(database.Open(GetTestDatabaseDirectory()));
+  REQUIRE(database.GetBoundingBox(boundingBox));
+
+  osmscout::WayDataFileRef wayDataFile=database.GetWayDataFile();
+
+  REQUIRE(wayDataFile);
+
+  // Read all ways, the data file cache is bound by the budget, not by the entry count
+  osmscout::FileScanner scanner;
+
+  scanner.Open(osmscout::AppendFileToDir(GetTestDatabaseDirectory(),osmscout::WayDataFile::WAYS_DAT),
+               osmscout::FileScanner::Sequential,
+               false);
+
+  std::vector<osmscout::FileOffset> offsets;
+  uint32_t                          count=scanner.ReadUInt32();
+
+  for (uint32_t i=0; i<count; i++) {
+    osmscout::Way way;
+
+    offsets.push_back(scanner.GetPos());
+    way.Read(*database.GetTypeConfig(),scanner);
+  }
+
+  scanner.Close();
+
+  REQUIRE(!offsets.empty());
+
+  std::vector<osmscout::WayRef> ways;
+
+  REQUIRE(wayDataFile->GetByOffset(offsets.begin(),offsets.end(),offsets.size(),ways));
+  REQUIRE(ways.size()==offsets.size());
+
+  REQUIRE(!budget->IsExceeded());
+
+  auto statistics=budget->GetStatistics();
+
+  REQUIRE(std::any_of(statistics.begin(),statistics.end(),[](const osmscout::MemoryBudget::Statistics& statistics) {
+    return statistics.name==osmscout::WayDataFile::WAYS_DAT &&
+           statistics.memory>0;
+  }));
+
+  database.Close();
+}
@@ -17,7 +17,13 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <random>
+#include <vector>
+
 #include <osmscout/projection/MercatorProjection.h>
+#include <osmscout/projection/TileProjection.h>
+
+#include <osmscout/system/VectorMath.h>
 
 #include <catch2/catch_test_macros.hpp>
 // Deprecated, see comments under https://github.com/catchorg/Catch2/blob/devel/docs/comparing-floating-point-numbers.md#approx
@@ -284,3 +290,137 @@ TEST_CASE("GetDimensions() with rotation")
 
   REQUIRE(projection.GetDimensions().GetDisplayText()==expectedBox.GetDisplayText());
 }
+
+/**
+ * Return coordinates in the given box around the center, including the
+ * Mercator border and some coordinates outside the valid range
+ */
+static std::vector<osmscout::GeoCoord> GetBatchTestCoords(const osmscout::GeoCoord& center,
+                                                          double delta)
+{
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(-delta,delta);
+  std::vector<osmscout::GeoCoord>        coords;
+
+  // Not a multiple of the vector sizes, to also test the remaining elements
+  for (size_t i=0; i<1001; i++) {
+    coords.emplace_back(center.GetLat()+distribution(generator),
+                        center.GetLon()+distribution(generator));
+  }
+
+  coords.emplace_back(osmscout::MercatorProjection::MaxLat,0.0);
+  coords.emplace_back(osmscout::MercatorProjection::MinLat,0.0);
+  coords.emplace_back(89.0,0.0);
+  coords.emplace_back(-89.0,0.0);
+
+  return coords;
+}
+
+/**
+ * Check that the batch variant of GeoToPixel() returns the same result as
+ * the single coordinate variant for all supported vector instruction sets
+ */
+static void CheckBatchGeoToPixel(const osmscout::Projection& projection,
+                                 const std::vector<osmscout::GeoCoord>& coords)
+{
+  std::vector<double> lat;
+  std::vector<double> lon;
+
+  for (const auto& coord : coords) {
+    lat.push_back(coord.GetLat());
+    lon.push_back(coord.GetLon());
+  }
+
+  for (auto instructionSet : {osmscout::VectorInstructionSet::none,
+                              osmscout::VectorInstructionSet::avx2,
+                              osmscout::VectorInstructionSet::avx512}) {
+    osmscout::SetVectorInstructionSet(instructionSet);
+
+    std::vector<double> x(coords.size());
+    std::vector<double> y(coords.size());
+
+    projection.GeoToPixel(lat.data(),
+                          lon.data(),
+                          x.data(),
+                          y.data(),
+                          coords.size());
+
+    for (size_t i=0; i<coords.size(); i++) {
+      osmscout::Vertex2D pixel;
+
+      projection.GeoToPixel(coords[i],
+                            pixel);
+
+      REQUIRE(x[i]==Catch::Approx(pixel.GetX()).margin(0.0001));
+      REQUIRE(y[i]==Catch::Approx(pixel.GetY()).margin(0.0001));
+    }
+  }
+
+  osmscout::SetVectorInstructionSet(osmscout::GetSupportedVectorInstructionSet());
+}
+
+TEST_CASE("Batch GeoToPixel() should return the same result as GeoToPixel()")
+{
+  for (auto level : {osmscout::Magnification::magWorld,
+                     osmscout::Magnification::magCity,
+                     osmscout::Magnification::magHouse}) {
+    osmscout::MercatorProjection projection;
+
+    projection.Set(defaultCenter,
+                   defaultAngle,
+                   osmscout::Magnification(level),
+                   defaultDpi,
+                   defaultWidth,
+                   defaultHeight);
+
+    CheckBatchGeoToPixel(projection,
+                         GetBatchTestCoords(defaultCenter,1.0));
+  }
+}
+
+TEST_CASE("Batch GeoToPixel() with rotation")
+{
+  osmscout::MercatorProjection projection;
+
+  projection.Set(defaultCenter,
+                 0.524, // 30°
+                 osmscout::Magnification(osmscout::Magnification::magClose),
+                 defaultDpi,
+                 defaultWidth,
+                 defaultHeight);
+
+  CheckBatchGeoToPixel(projection,
+                       GetBatchTestCoords(defaultCenter,0.1));
+}
+
+TEST_CASE("Batch GeoToPixel() with linear interpolation")
+{
+  osmscout::MercatorProjection projection;
+
+  projection.Set(defaultCenter,
+                 defaultAngle,
+                 osmscout::Magnification(osmscout::Magnification::magClose),
+                 defaultDpi,
+                 defaultWidth,
+                 defaultHeight);
+  projection.SetLinearInterpolationUsage(true);
+
+  CheckBatchGeoToPixel(projection,
+                       GetBatchTestCoords(defaultCenter,0.1));
+}
+
+TEST_CASE("Batch GeoToPixel() of TileProjection")
+{
+  osmscout::TileProjection projection;
+  osmscout::Magnification  magnification(osmscout::Magnification::magClose);
+
+  projection.Set(osmscout::OSMTileId::GetOSMTile(magnification,
+                                                 defaultCenter),
+                 magnification,
+                 defaultDpi,
+                 256,
+                 256);
+
+  CheckBatchGeoToPixel(projection,
+                       GetBatchTestCoords(defaultCenter,0.1));
+}
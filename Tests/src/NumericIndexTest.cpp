@@ -0,0 +1,135 @@
+#include <filesystem>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <osmscout/Intersection.h>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/NumericIndex.h>
+
+#include <osmscout/routing/RoutingService.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+/**
+ * Read the offsets of all intersections by scanning the data file
+ */
+static std::map<osmscout::Id,osmscout::FileOffset> ReadIntersectionOffsets(const std::string& directory)
+{
+  std::map<osmscout::Id,osmscout::FileOffset> offsets;
+  osmscout::FileScanner                       scanner;
+
+  scanner.Open(osmscout::AppendFileToDir(directory,osmscout::RoutingService::FILENAME_INTERSECTIONS_DAT),
+               osmscout::FileScanner::Sequential,
+               false);
+
+  uint32_t count=scanner.ReadUInt32();
+
+  for (uint32_t i=0; i<count; i++) {
+    osmscout::FileOffset   offset=scanner.GetPos();
+    osmscout::Intersection intersection;
+
+    intersection.Read(scanner);
+    offsets[intersection.GetId()]=offset;
+  }
+
+  scanner.Close();
+
+  return offsets;
+}
+
+TEST_CASE("Lookup of all ids with fully and partially loaded index")
+{
+  std::string directory=GetTestDatabaseDirectory();
+  auto        expected=ReadIntersectionOffsets(directory);
+
+  REQUIRE(!expected.empty());
+
+  // Cache size 0 loads just the root page, the rest is read on demand
+  for (size_t cacheSize : {0,1000}) {
+    for (bool memoryMapped : {true,false}) {
+      osmscout::NumericIndex<osmscout::Id> index(osmscout::RoutingService::FILENAME_INTERSECTIONS_IDX,
+                                                 cacheSize);
+
+      REQUIRE(index.Open(directory,memoryMapped));
+
+      for (const auto& [id,offset] : expected) {
+        osmscout::FileOffset indexOffset=0;
+
+        REQUIRE(index.GetOffset(id,indexOffset));
+        REQUIRE(indexOffset==offset);
+
+        if (expected.find(id+1)==expected.end()) {
+          REQUIRE(!index.GetOffset(id+1,indexOffset));
+        }
+      }
+
+      osmscout::FileOffset indexOffset;
+
+      REQUIRE(!index.GetOffset(expected.begin()->first-1,indexOffset));
+
+      REQUIRE(index.Close());
+    }
+  }
+}
+
+TEST_CASE("Concurrent lookups")
+{
+  std::string directory=GetTestDatabaseDirectory();
+  auto        expected=ReadIntersectionOffsets(directory);
+
+  osmscout::NumericIndex<osmscout::Id> index(osmscout::RoutingService::FILENAME_INTERSECTIONS_IDX,
+                                             0);
+
+  REQUIRE(index.Open(directory,true));
+
+  std::vector<size_t>      failures(4,0);
+  std::vector<std::thread> threads;
+
+  for (size_t t=0; t<failures.size(); t++) {
+    threads.emplace_back([&index,&expected,&failures,t]() {
+      for (size_t round=0; round<10; round++) {
+        for (const auto& [id,offset] : expected) {
+          osmscout::FileOffset indexOffset=0;
+
+          if (!index.GetOffset(id,indexOffset) ||
+              indexOffset!=offset) {
+            failures[t]++;
+          }
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t failureCount : failures) {
+    REQUIRE(failureCount==0);
+  }
+
+  REQUIRE(index.Close());
+}
@@ -0,0 +1,210 @@
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+/**
+ * Span covering all objects of the given data file, which starts with the object count
+ */
+static osmscout::DataBlockSpan GetFileSpan(const std::string& filename)
+{
+  osmscout::FileScanner scanner;
+
+  scanner.Open(osmscout::AppendFileToDir(GetTestDatabaseDirectory(),filename),
+               osmscout::FileScanner::Sequential,
+               false);
+
+  uint32_t count=scanner.ReadUInt32();
+
+  osmscout::DataBlockSpan span{scanner.GetPos(),count};
+
+  scanner.Close();
+
+  return span;
+}
+
+static void CheckNodes(const std::vector<osmscout::Point>& nodes,
+                       const osmscout::CoordArrayView& view)
+{
+  REQUIRE(view.size()==nodes.size());
+
+  size_t index=0;
+  for (const auto& coord : view) {
+    REQUIRE(coord==nodes[index].GetCoord());
+    index++;
+  }
+}
+
+static void CheckWay(const osmscout::Way& way,
+                     const osmscout::WayView& view)
+{
+  REQUIRE(view.GetFileOffset()==way.GetFileOffset());
+  REQUIRE(view.GetNextFileOffset()==way.GetNextFileOffset());
+  REQUIRE(view.GetType()==way.GetType());
+  REQUIRE(view.GetFeatureValueBuffer()==way.GetFeatureValueBuffer());
+  REQUIRE(view.GetBoundingBox().GetMinCoord()==way.GetBoundingBox().GetMinCoord());
+  REQUIRE(view.GetBoundingBox().GetMaxCoord()==way.GetBoundingBox().GetMaxCoord());
+  REQUIRE(view.IsFrontRelevant()==way.GetFront().IsRelevant());
+  REQUIRE(view.IsBackRelevant()==way.GetBack().IsRelevant());
+
+  CheckNodes(way.nodes,view.GetNodes());
+}
+
+static void CheckArea(const osmscout::Area& area,
+                      const osmscout::AreaView& view)
+{
+  REQUIRE(view.GetFileOffset()==area.GetFileOffset());
+  REQUIRE(view.GetNextFileOffset()==area.GetNextFileOffset());
+  REQUIRE(view.GetRings().size()==area.rings.size());
+
+  for (size_t r=0; r<area.rings.size(); r++) {
+    const osmscout::Area::Ring&     ring=area.rings[r];
+    const osmscout::AreaView::Ring& viewRing=view.GetRings()[r];
+
+    REQUIRE(viewRing.GetRing()==ring.GetRing());
+    REQUIRE(viewRing.GetType()==ring.GetType());
+    REQUIRE(viewRing.GetFeatureValueBuffer()==ring.GetFeatureValueBuffer());
+    REQUIRE(viewRing.GetCenter()==ring.center);
+
+    CheckNodes(ring.nodes,viewRing.GetNodes());
+  }
+}
+
+TEST_CASE("Way views match the ways read from the data file")
+{
+  osmscout::DatabaseParameter parameter;
+  osmscout::Database          database(parameter);
+  osmscout::GeoBox            boundingBox;
+
+  REQUIRE(database.Open(GetTestDatabaseDirectory()));
+  REQUIRE(database.GetBoundingBox(boundingBox));
+
+  std::vector<osmscout::DataBlockSpan> spans{GetFileSpan(osmscout::WayDataFile::WAYS_DAT)};
+  std::vector<osmscout::WayRef>        ways;
+
+  REQUIRE(spans.front().count>0);
+  REQUIRE(database.GetWayDataFile()->GetByBlockSpans(spans.begin(),
+                                                     spans.end(),
+                                                     ways));
+  REQUIRE(ways.size()==spans.front().count);
+
+  SECTION("By block spans") {
+    std::vector<osmscout::WayView> views;
+
+    REQUIRE(database.GetWayViewsByBlockSpans(spans,views));
+    REQUIRE(views.size()==ways.size());
+
+    for (size_t i=0; i<ways.size(); i++) {
+      CheckWay(*ways[i],views[i]);
+    }
+  }
+
+  SECTION("By offset") {
+    std::vector<osmscout::FileOffset> offsets;
+    std::vector<osmscout::WayView>    views;
+
+    for (const auto& way : ways) {
+      offsets.push_back(way->GetFileOffset());
+    }
+
+    REQUIRE(database.GetWayViewsByOffset(offsets,boundingBox,views));
+    REQUIRE(views.size()==ways.size());
+
+    for (size_t i=0; i<ways.size(); i++) {
+      CheckWay(*ways[i],views[i]);
+    }
+  }
+}
+
+TEST_CASE("Area views match the areas read from the data file")
+{
+  osmscout::DatabaseParameter parameter;
+  osmscout::Database          database(parameter);
+  osmscout::GeoBox            boundingBox;
+
+  REQUIRE(database.Open(GetTestDatabaseDirectory()));
+  REQUIRE(database.GetBoundingBox(boundingBox));
+
+  std::vector<osmscout::DataBlockSpan> spans{GetFileSpan(osmscout::AreaDataFile::AREAS_DAT)};
+  std::vector<osmscout::AreaRef>       areas;
+
+  REQUIRE(spans.front().count>0);
+  REQUIRE(database.GetAreasByBlockSpans(spans,areas));
+  REQUIRE(areas.size()==spans.front().count);
+
+  SECTION("By block spans") {
+    std::vector<osmscout::AreaView> views;
+
+    REQUIRE(database.GetAreaViewsByBlockSpans(spans,views));
+    REQUIRE(views.size()==areas.size());
+
+    for (size_t i=0; i<areas.size(); i++) {
+      CheckArea(*areas[i],views[i]);
+    }
+  }
+
+  SECTION("By offset") {
+    std::vector<osmscout::FileOffset> offsets;
+    std::vector<osmscout::AreaView>   views;
+
+    for (const auto& area : areas) {
+      offsets.push_back(area->GetFileOffset());
+    }
+
+    REQUIRE(database.GetAreaViewsByOffset(offsets,boundingBox,views));
+    REQUIRE(views.size()==areas.size());
+
+    for (size_t i=0; i<areas.size(); i++) {
+      CheckArea(*areas[i],views[i]);
+    }
+  }
+}
+
+TEST_CASE("Views outside of the bounding box are dropped")
+{
+  osmscout::DatabaseParameter parameter;
+  osmscout::Database          database(parameter);
+
+  REQUIRE(database.Open(GetTestDatabaseDirectory()));
+
+  std::vector<osmscout::DataBlockSpan> spans{GetFileSpan(osmscout::WayDataFile::WAYS_DAT)};
+  std::vector<osmscout::WayView>       allViews;
+  std::vector<osmscout::FileOffset>    offsets;
+  std::vector<osmscout::WayView>       views;
+
+  REQUIRE(database.GetWayViewsByBlockSpans(spans,allViews));
+
+  for (const auto& view : allViews) {
+    offsets.push_back(view.GetFileOffset());
+  }
+
+  osmscout::GeoBox outside(osmscout::GeoCoord(-10.0,-10.0),
+                           osmscout::GeoCoord(-9.0,-9.0));
+
+  REQUIRE(database.GetWayViewsByOffset(offsets,outside,views));
+  REQUIRE(views.empty());
+}
@@ -0,0 +1,201 @@
+/*
+  ProjectionPerformance - a test program for libosmscout
+  Copyright (C) 2026  agent
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscout/system/VectorMath.h>
+
+#include <osmscout/util/StopClock.h>
+#include <osmscout/util/Transformation.h>
+
+/**
+  Transform random ways in the visible area of a Mercator projection to
+  pixel coordinates. This is done once by calling GeoToPixel() for each
+  coordinate and once using TransBuffer for each supported vector instruction
+  set. Prints the number of transformed coordinates per second for each
+  variant.
+*/
+
+static const char* GetInstructionSetName(osmscout::VectorInstructionSet instructionSet)
+{
+  switch (instructionSet) {
+  case osmscout::VectorInstructionSet::avx2:
+    return "AVX2";
+  case osmscout::VectorInstructionSet::avx512:
+    return "AVX-512";
+  default:
+    return "Scalar";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace std::string_literals;
+
+  size_t wayCount=10000;
+  size_t wayLength=100;
+  size_t iterations=100;
+  bool   help=false;
+
+  osmscout::CmdLineParser argParser("ProjectionPerformance", argc, argv);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+              help=value;
+            }),
+            std::vector<std::string>{"h","help"},
+            "Display help",
+            true);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  wayCount=value;
+                }),
+                "ways",
+                "Number of transformed ways, default: "s + std::to_string(wayCount));
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  wayLength=value;
+                }),
+                "way-length",
+                "Number of coordinates of each way, default: "s + std::to_string(wayLength));
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  iterations=value;
+                }),
+                "iterations",
+                "Number of times all ways are transformed, default: "s + std::to_string(iterations));
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (help){
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  if (wayLength==0) {
+    std::cerr << "Way length must be greater than 0" << std::endl;
+    return 1;
+  }
+
+  osmscout::MercatorProjection projection;
+
+  projection.Set(osmscout::GeoCoord(50.418,14.56),
+                 osmscout::Magnification(osmscout::Magnification::magCity),
+                 96.0,
+                 1920,
+                 1080);
+
+  osmscout::GeoBox                       box=projection.GetDimensions();
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> latDistribution(box.GetMinLat(),box.GetMaxLat());
+  std::uniform_real_distribution<double> lonDistribution(box.GetMinLon(),box.GetMaxLon());
+  std::vector<std::vector<osmscout::GeoCoord>> ways(wayCount);
+
+  for (auto& way : ways) {
+    way.reserve(wayLength);
+
+    for (size_t i=0; i<wayLength; i++) {
+      way.emplace_back(latDistribution(generator),
+                       lonDistribution(generator));
+    }
+  }
+
+  size_t coordCount=wayCount*wayLength*iterations;
+
+  std::cout << "Transforming " << wayCount << " ways of " << wayLength << " coordinates " << iterations << " times..." << std::endl;
+  std::cout << std::fixed << std::setprecision(0);
+
+  // Reference result and time of transforming each coordinate separately
+  std::vector<osmscout::Vertex2D> reference(wayLength);
+  double                          referenceSum=0.0;
+  osmscout::StopClock             referenceTimer;
+
+  for (size_t i=0; i<iterations; i++) {
+    for (const auto& way : ways) {
+      for (size_t j=0; j<wayLength; j++) {
+        projection.GeoToPixel(way[j],
+                              reference[j]);
+      }
+
+      referenceSum+=reference.back().GetY();
+    }
+  }
+
+  referenceTimer.Stop();
+
+  double referenceMilliseconds=referenceTimer.GetMilliseconds();
+
+  std::cout << "Single coordinates: " << referenceMilliseconds << " ms => "
+            << double(coordCount)/referenceMilliseconds*1000.0 << " coords/s" << std::endl;
+
+  bool success=true;
+
+  for (auto instructionSet : {osmscout::VectorInstructionSet::none,
+                              osmscout::VectorInstructionSet::avx2,
+                              osmscout::VectorInstructionSet::avx512}) {
+    if (instructionSet>osmscout::GetSupportedVectorInstructionSet()) {
+      std::cout << "TransBuffer (" << GetInstructionSetName(instructionSet) << "): not supported" << std::endl;
+      continue;
+    }
+
+    osmscout::SetVectorInstructionSet(instructionSet);
+
+    osmscout::TransBuffer buffer;
+    double                sum=0.0;
+    osmscout::StopClock   timer;
+
+    for (size_t i=0; i<iterations; i++) {
+      for (const auto& way : ways) {
+        buffer.Reset();
+        buffer.TransformGeoToPixel(projection,
+                                   way);
+
+        sum+=buffer.points[wayLength-1].y;
+      }
+    }
+
+    timer.Stop();
+
+    double milliseconds=timer.GetMilliseconds();
+
+    std::cout << "TransBuffer (" << GetInstructionSetName(instructionSet) << "): " << milliseconds << " ms => "
+              << double(coordCount)/milliseconds*1000.0 << " coords/s, speedup "
+              << std::setprecision(1) << referenceMilliseconds/milliseconds << std::setprecision(0) << std::endl;
+
+    if (std::fabs(sum-referenceSum)>0.0001*double(wayCount*iterations)) {
+      std::cerr << "Result differs from single coordinate transformation" << std::endl;
+      success=false;
+    }
+  }
+
+  osmscout::SetVectorInstructionSet(osmscout::GetSupportedVectorInstructionSet());
+
+  return success ? 0 : 1;
+}
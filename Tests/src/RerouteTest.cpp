@@ -0,0 +1,185 @@
+#include <cmath>
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+static osmscout::Distance GetRouteLength(osmscout::SimpleRoutingService& router,
+                                         const osmscout::RouteData& route)
+{
+  osmscout::RoutePointsResult points=router.TransformRouteDataToPoints(route);
+
+  REQUIRE(points.Success());
+
+  osmscout::Distance length;
+
+  for (size_t i=1; i<points.GetPoints()->points.size(); i++) {
+    length+=osmscout::GetEllipsoidalDistance(points.GetPoints()->points[i-1].GetCoord(),
+                                             points.GetPoints()->points[i].GetCoord());
+  }
+
+  return length;
+}
+
+TEST_CASE("Rerouting using the reroute tree")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(router.Open());
+
+  std::vector<osmscout::GeoCoord> coords={
+    osmscout::GeoCoord(50.412,14.534),
+    osmscout::GeoCoord(50.424,14.6013),
+    osmscout::GeoCoord(50.4180,14.5600),
+    osmscout::GeoCoord(50.4300,14.5800),
+    osmscout::GeoCoord(50.4050,14.5900),
+    osmscout::GeoCoord(50.4250,14.5450)
+  };
+
+  size_t rerouteCount=0;
+
+  for (osmscout::Vehicle vehicle : {osmscout::vehicleFoot,osmscout::vehicleBicycle,osmscout::vehicleCar}) {
+    osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                                 vehicle);
+    std::vector<osmscout::RoutePosition>   positions;
+
+    for (const auto& coord : coords) {
+      osmscout::RoutePositionResult position=router.GetClosestRoutableNode(coord,
+                                                                           *profile,
+                                                                           osmscout::Kilometers(1));
+
+      REQUIRE(position.IsValid());
+
+      positions.push_back(position.GetRoutePosition());
+    }
+
+    osmscout::RoutingParameter                  parameter;
+    osmscout::SimpleRoutingService::RerouteTree tree;
+
+    // Without a tree there is no route
+    CHECK(!router.Reroute(*profile,
+                          positions[0],
+                          std::nullopt,
+                          parameter,
+                          tree).Success());
+
+    REQUIRE(router.CalculateRerouteTree(*profile,
+                                        positions[0],
+                                        positions[1],
+                                        parameter,
+                                        tree));
+    REQUIRE(tree.IsValid());
+    CHECK(tree.GetNodeCount()>0);
+
+    // Rerouting from any position results in a route as good as a full route calculation
+    for (const auto& position : positions) {
+      osmscout::RoutingResult route=router.CalculateRoute(*profile,
+                                                          position,
+                                                          positions[1],
+                                                          std::nullopt,
+                                                          parameter);
+
+      if (!route.Success()) {
+        CHECK(!router.Reroute(*profile,
+                              position,
+                              std::nullopt,
+                              parameter,
+                              tree).Success());
+        continue;
+      }
+
+      osmscout::RoutingResult reroute=router.Reroute(*profile,
+                                                     position,
+                                                     std::nullopt,
+                                                     parameter,
+                                                     tree);
+
+      REQUIRE(reroute.Success());
+
+      osmscout::RouteDescriptionResult description=router.TransformRouteDataToRouteDescription(reroute.GetRoute());
+
+      REQUIRE(description.Success());
+      CHECK(!description.GetDescription()->Nodes().empty());
+
+      osmscout::Distance length=GetRouteLength(router,route.GetRoute());
+      osmscout::Distance rerouteLength=GetRouteLength(router,reroute.GetRoute());
+
+      CHECK(std::abs(rerouteLength.AsMeter()-length.AsMeter())<=length.AsMeter()*0.01+1.0);
+
+      rerouteCount++;
+    }
+
+    // A tree without corridor still allows rerouting
+    parameter.SetRerouteCorridor(0.0);
+
+    osmscout::SimpleRoutingService::RerouteTree narrowTree;
+
+    REQUIRE(router.CalculateRerouteTree(*profile,
+                                        positions[0],
+                                        positions[1],
+                                        parameter,
+                                        narrowTree));
+    CHECK(narrowTree.GetNodeCount()<=tree.GetNodeCount());
+
+    osmscout::RoutingResult route=router.CalculateRoute(*profile,
+                                                        positions[2],
+                                                        positions[1],
+                                                        std::nullopt,
+                                                        parameter);
+    osmscout::RoutingResult reroute=router.Reroute(*profile,
+                                                   positions[2],
+                                                   std::nullopt,
+                                                   parameter,
+                                                   narrowTree);
+
+    REQUIRE(route.Success()==reroute.Success());
+
+    if (route.Success()) {
+      osmscout::Distance length=GetRouteLength(router,route.GetRoute());
+
+      CHECK(std::abs(GetRouteLength(router,reroute.GetRoute()).AsMeter()-length.AsMeter())<=length.AsMeter()*0.01+1.0);
+    }
+  }
+
+  CHECK(rerouteCount>0);
+
+  router.Close();
+  database->Close();
+}
@@ -0,0 +1,144 @@
+#include <filesystem>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/routing/RouteGraph.h>
+#include <osmscout/routing/RouteNode.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Progress.h>
+
+#include <osmscoutimport/GenRouteGraphDat.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+/**
+ * Generate the routing graph of the test region in a temporary directory
+ */
+static std::string GenerateGraph(const osmscout::TypeConfigRef& typeConfig)
+{
+  std::filesystem::path directory=std::filesystem::temp_directory_path().append("RouteGraphTest");
+  std::string           routerFilename=std::string(osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE)+".dat";
+
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  std::filesystem::copy(std::filesystem::path(GetTestDatabaseDirectory()).append(routerFilename),
+                        std::filesystem::path(directory).append(routerFilename));
+
+  osmscout::ImportParameter         parameter;
+  osmscout::ConsoleProgress         progress;
+  osmscout::RouteGraphDataGenerator generator;
+
+  parameter.SetDestinationDirectory(directory.string());
+  parameter.AddRouter(osmscout::ImportParameter::Router(osmscout::vehicleFoot|osmscout::vehicleBicycle|osmscout::vehicleCar,
+                                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE));
+  parameter.SetRouterGraph(true);
+
+  REQUIRE(generator.Import(typeConfig,
+                           parameter,
+                           progress));
+
+  return directory.string();
+}
+
+TEST_CASE("Route graph holds the route nodes and their paths")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::Database          database(databaseParameter);
+
+  REQUIRE(database.Open(GetTestDatabaseDirectory()));
+
+  std::string          directory=GenerateGraph(database.GetTypeConfig());
+  osmscout::RouteGraph graph;
+
+  REQUIRE(graph.Open(osmscout::AppendFileToDir(directory,
+                                               osmscout::RouteGraph::GetFilename(osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE))));
+  REQUIRE(graph.IsOpen());
+
+  osmscout::FileScanner scanner;
+
+  scanner.Open(osmscout::AppendFileToDir(GetTestDatabaseDirectory(),
+                                         std::string(osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE)+".dat"),
+               osmscout::FileScanner::Sequential,
+               true);
+
+  scanner.ReadFileOffset(); // index offset
+  uint32_t nodeCount=scanner.ReadUInt32();
+  scanner.ReadUInt32(); // tile magnification
+
+  REQUIRE(nodeCount>0);
+  REQUIRE(graph.GetNodeCount()==nodeCount);
+
+  size_t edgeCount=0;
+
+  for (uint32_t n=0; n<nodeCount; n++) {
+    osmscout::RouteNode routeNode;
+
+    routeNode.Read(*database.GetTypeConfig(),
+                   scanner);
+
+    uint32_t node=graph.GetNodeIndex(routeNode.GetId());
+
+    REQUIRE(node!=osmscout::RouteGraph::noNode);
+    REQUIRE(graph.GetNodeId(node)==routeNode.GetId());
+    CHECK(graph.GetNodeCoord(node)==routeNode.GetCoord());
+
+    uint32_t edge=graph.GetEdgesBegin(node);
+
+    for (const auto& path : routeNode.paths) {
+      if (graph.GetNodeIndex(path.id)==osmscout::RouteGraph::noNode) {
+        continue;
+      }
+
+      REQUIRE(edge<graph.GetEdgesEnd(node));
+      CHECK(graph.GetNodeId(graph.GetEdgeTarget(edge))==path.id);
+      CHECK(graph.GetEdgeDistance(edge)==path.distance);
+      CHECK(graph.GetEdgeFlags(edge)==path.flags);
+      CHECK(graph.GetEdgeObjectVariantIndex(edge)==routeNode.objects[path.objectIndex].objectVariantIndex);
+      CHECK(graph.GetEdgeObject(edge)==routeNode.objects[path.objectIndex].object);
+
+      edge++;
+      edgeCount++;
+    }
+
+    CHECK(edge==graph.GetEdgesEnd(node));
+  }
+
+  scanner.Close();
+
+  CHECK(graph.GetEdgeCount()==edgeCount);
+
+  // Nodes are numbered along the z-order curve
+  for (uint32_t node=1; node<graph.GetNodeCount(); node++) {
+    CHECK(graph.GetNodeCoord(node-1).GetHash()<=graph.GetNodeCoord(node).GetHash());
+  }
+
+  CHECK(graph.GetNodeIndex(0)==osmscout::RouteGraph::noNode);
+
+  graph.Close();
+  database.Close();
+}
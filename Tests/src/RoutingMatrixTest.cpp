@@ -0,0 +1,220 @@
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestDatabaseDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return std::filesystem::path(testsTopDir).append("data").append("testregion").string();
+}
+
+static double GetRouteLength(osmscout::SimpleRoutingService& router,
+                             const osmscout::RouteData& route)
+{
+  osmscout::RoutePointsResult points=router.TransformRouteDataToPoints(route);
+
+  REQUIRE(points.Success());
+
+  double                 length=0.0;
+  const osmscout::Point* previous=nullptr;
+
+  for (const auto& point : points.GetPoints()->points) {
+    if (previous!=nullptr) {
+      length+=osmscout::GetEllipsoidalDistance(previous->GetCoord(),point.GetCoord()).AsMeter();
+    }
+
+    previous=&point;
+  }
+
+  return length;
+}
+
+TEST_CASE("Matrix distances are not worse than calculated routes")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(router.Open());
+
+  std::vector<osmscout::GeoCoord> coords={
+    osmscout::GeoCoord(50.412,14.534),
+    osmscout::GeoCoord(50.424,14.6013),
+    osmscout::GeoCoord(50.4180,14.5600),
+    osmscout::GeoCoord(50.4300,14.5800),
+    osmscout::GeoCoord(50.4050,14.5900)
+  };
+
+  for (osmscout::Vehicle vehicle : {osmscout::vehicleFoot,osmscout::vehicleCar}) {
+    osmscout::FastestPathRoutingProfileRef profile=osmscout::ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                                                                 vehicle);
+    std::vector<osmscout::RoutePosition>   positions;
+
+    for (const auto& coord : coords) {
+      osmscout::RoutePositionResult position=router.GetClosestRoutableNode(coord,
+                                                                           *profile,
+                                                                           osmscout::Kilometers(1));
+
+      REQUIRE(position.IsValid());
+
+      positions.push_back(position.GetRoutePosition());
+    }
+
+    osmscout::RoutingParameter  parameter;
+
+    parameter.SetThreadCount(1);
+
+    osmscout::RoutingMatrixResult singleThreaded=router.CalculateMatrix(*profile,
+                                                                        positions,
+                                                                        positions,
+                                                                        parameter);
+
+    parameter.SetThreadCount(3);
+
+    osmscout::RoutingMatrixResult multiThreaded=router.CalculateMatrix(*profile,
+                                                                       positions,
+                                                                       positions,
+                                                                       parameter);
+
+    REQUIRE(singleThreaded.Success());
+    REQUIRE(multiThreaded.Success());
+    REQUIRE(singleThreaded.GetSourceCount()==positions.size());
+    REQUIRE(singleThreaded.GetTargetCount()==positions.size());
+
+    for (size_t s=0; s<positions.size(); s++) {
+      for (size_t t=0; t<positions.size(); t++) {
+        REQUIRE(singleThreaded.IsReachable(s,t));
+        CHECK(singleThreaded.GetCost(s,t)==multiThreaded.GetCost(s,t));
+
+        if (s==t) {
+          CHECK(singleThreaded.GetCost(s,t)==0.0);
+          CHECK(singleThreaded.GetDistance(s,t).AsMeter()==0.0);
+          continue;
+        }
+
+        CHECK(singleThreaded.GetDuration(s,t)>osmscout::Duration::zero());
+
+        osmscout::RoutingResult route=router.CalculateRoute(*profile,
+                                                            positions[s],
+                                                            positions[t],
+                                                            std::nullopt,
+                                                            parameter);
+
+        REQUIRE(route.Success());
+
+        double routeLength=GetRouteLength(router,route.GetRoute());
+        double matrixLength=singleThreaded.GetDistance(s,t).AsMeter();
+        double airLineLength=osmscout::GetEllipsoidalDistance(coords[s],coords[t]).AsMeter();
+
+        // The matrix holds the optimal routes, while the A* search of CalculateRoute()
+        // may return slightly worse ones
+        CHECK(matrixLength<=routeLength*1.01);
+        CHECK(matrixLength>=airLineLength*0.9);
+      }
+    }
+  }
+
+  router.Close();
+  database->Close();
+}
+
+class FailingProfile : public osmscout::FastestPathRoutingProfile
+{
+public:
+  explicit FailingProfile(const osmscout::TypeConfigRef& typeConfig)
+  : osmscout::FastestPathRoutingProfile(typeConfig)
+  {
+    // no code
+  }
+
+  using osmscout::FastestPathRoutingProfile::GetCosts;
+
+  double GetCosts(const osmscout::RouteNode& /*currentNode*/,
+                  const std::vector<osmscout::ObjectVariantData>& /*objectVariantData*/,
+                  size_t /*inPathIndex*/,
+                  size_t /*outPathIndex*/) const override
+  {
+    throw std::runtime_error("Profile failure");
+  }
+};
+
+TEST_CASE("Exceptions of the workers are passed to the caller")
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(GetTestDatabaseDirectory()));
+
+  osmscout::RouterParameter      routerParameter;
+  osmscout::SimpleRoutingService router(database,
+                                        routerParameter,
+                                        osmscout::SimpleRoutingService::DEFAULT_FILENAME_BASE);
+
+  REQUIRE(router.Open());
+
+  FailingProfile profile(database->GetTypeConfig());
+
+  profile.ParametrizeForFoot(*database->GetTypeConfig(),
+                             5.0);
+
+  std::vector<osmscout::RoutePosition> positions;
+
+  for (const auto& coord : {osmscout::GeoCoord(50.412,14.534),
+                            osmscout::GeoCoord(50.424,14.6013),
+                            osmscout::GeoCoord(50.4180,14.5600)}) {
+    osmscout::RoutePositionResult position=router.GetClosestRoutableNode(coord,
+                                                                         profile,
+                                                                         osmscout::Kilometers(1));
+
+    REQUIRE(position.IsValid());
+
+    positions.push_back(position.GetRoutePosition());
+  }
+
+  for (size_t threadCount : {1,3}) {
+    osmscout::RoutingParameter parameter;
+
+    parameter.SetThreadCount(threadCount);
+
+    REQUIRE_THROWS_AS(router.CalculateMatrix(profile,
+                                             positions,
+                                             positions,
+                                             parameter),
+                      std::runtime_error);
+  }
+
+  router.Close();
+  database->Close();
+}
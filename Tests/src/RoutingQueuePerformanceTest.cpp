@@ -0,0 +1,389 @@
+/*
+  RoutingQueuePerformance - a test program for libosmscout
+  Copyright (C) 2026  agent
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscout/util/FlatHashSet.h>
+#include <osmscout/util/IndexedHeap.h>
+#include <osmscout/util/ObjectArena.h>
+#include <osmscout/util/StopClock.h>
+
+/**
+  Run A* searches on a synthetic grid graph with random edge costs, once
+  with the open list and closed set data structures used by the routing service
+  before (std::set of std::shared_ptr, std::unordered_set) and once with
+  the current ones (IndexedHeap, ObjectArena, FlatHashSet), and compare
+  the number of settled nodes per second. Both must find the same costs.
+*/
+
+struct Graph
+{
+  size_t                           width;
+  size_t                           height;
+  std::vector<std::array<double,4>> costs; //!< Costs of the edges to the neighbours (right, left, down, up)
+
+  Graph(size_t width,
+        size_t height)
+  : width(width),
+    height(height),
+    costs(width*height)
+  {
+    std::mt19937                     generator(42);
+    std::uniform_real_distribution<> distribution(1.0,10.0);
+
+    for (auto& nodeCosts : costs) {
+      for (auto& cost : nodeCosts) {
+        cost=distribution(generator);
+      }
+    }
+  }
+
+  size_t GetNeighbour(size_t node,
+                      size_t direction) const
+  {
+    size_t x=node%width;
+    size_t y=node/width;
+
+    switch (direction) {
+    case 0:
+      return x+1<width ? node+1 : std::numeric_limits<size_t>::max();
+    case 1:
+      return x>0 ? node-1 : std::numeric_limits<size_t>::max();
+    case 2:
+      return y+1<height ? node+width : std::numeric_limits<size_t>::max();
+    default:
+      return y>0 ? node-width : std::numeric_limits<size_t>::max();
+    }
+  }
+
+  double GetEstimate(size_t node,
+                     size_t target) const
+  {
+    double dx=double(node%width)-double(target%width);
+    double dy=double(node/width)-double(target/width);
+
+    return std::abs(dx)+std::abs(dy); // minimum edge cost is 1
+  }
+};
+
+struct Label
+{
+  size_t id=0;
+  size_t prev=0;
+  double currentCost=0;
+  double estimateCost=0;
+  double overallCost=0;
+  size_t heapIndex=std::numeric_limits<size_t>::max();
+
+  Label() = default;
+
+  Label(size_t id,
+        size_t prev)
+  : id(id),
+    prev(prev)
+  {
+    // no code
+  }
+};
+
+template<typename Ref>
+struct LabelCostCompare
+{
+  bool operator()(const Ref& a,
+                  const Ref& b) const
+  {
+    if (a->overallCost==b->overallCost) {
+      return a->id<b->id;
+    }
+
+    return a->overallCost<b->overallCost;
+  }
+};
+
+struct Result
+{
+  double cost=-1.0;
+  size_t settled=0;
+};
+
+/**
+ * The data structures used by the routing service before
+ */
+static Result SearchLegacy(const Graph& graph,
+                           size_t start,
+                           size_t target)
+{
+  using LabelRef = std::shared_ptr<Label>;
+  using OpenList = std::set<LabelRef,LabelCostCompare<LabelRef>>;
+
+  OpenList                                        openList;
+  std::unordered_map<size_t,OpenList::iterator>   openMap;
+  std::unordered_set<size_t>                      closedSet;
+  Result                                          result;
+
+  openMap.reserve(10000);
+  closedSet.reserve(10000);
+
+  auto startLabel=std::make_shared<Label>(start,start);
+
+  startLabel->estimateCost=graph.GetEstimate(start,target);
+  startLabel->overallCost=startLabel->estimateCost;
+  openMap[start]=openList.insert(startLabel).first;
+
+  while (!openList.empty()) {
+    LabelRef current=*openList.begin();
+
+    openMap.erase(current->id);
+    openList.erase(openList.begin());
+    closedSet.insert(current->id);
+    result.settled++;
+
+    if (current->id==target) {
+      result.cost=current->currentCost;
+      break;
+    }
+
+    for (size_t direction=0; direction<4; direction++) {
+      size_t next=graph.GetNeighbour(current->id,direction);
+
+      if (next==std::numeric_limits<size_t>::max() ||
+          closedSet.contains(next)) {
+        continue;
+      }
+
+      double currentCost=current->currentCost+graph.costs[current->id][direction];
+      auto   openEntry=openMap.find(next);
+
+      if (openEntry!=openMap.end() &&
+          (*openEntry->second)->currentCost<=currentCost) {
+        continue;
+      }
+
+      if (openEntry!=openMap.end()) {
+        LabelRef label=*openEntry->second;
+
+        openList.erase(openEntry->second);
+        label->prev=current->id;
+        label->currentCost=currentCost;
+        label->overallCost=currentCost+label->estimateCost;
+        openEntry->second=openList.insert(label).first;
+      }
+      else {
+        auto label=std::make_shared<Label>(next,current->id);
+
+        label->currentCost=currentCost;
+        label->estimateCost=graph.GetEstimate(next,target);
+        label->overallCost=currentCost+label->estimateCost;
+        openMap[next]=openList.insert(label).first;
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * The data structures used by the routing service now
+ */
+static Result SearchCurrent(const Graph& graph,
+                            osmscout::ObjectArena<Label>& arena,
+                            size_t start,
+                            size_t target)
+{
+  osmscout::IndexedHeap<Label,LabelCostCompare<Label*>> openList;
+  std::unordered_map<size_t,Label*>                     openMap;
+  osmscout::FlatHashSet<size_t>                         closedSet;
+  Result                                                result;
+
+  openMap.reserve(10000);
+  closedSet.reserve(10000);
+  arena.Clear();
+
+  Label* startLabel=arena.Allocate(start,start);
+
+  startLabel->estimateCost=graph.GetEstimate(start,target);
+  startLabel->overallCost=startLabel->estimateCost;
+  openList.Push(startLabel);
+  openMap[start]=startLabel;
+
+  while (!openList.IsEmpty()) {
+    Label* current=openList.Pop();
+
+    openMap.erase(current->id);
+    closedSet.insert(current->id);
+    result.settled++;
+
+    if (current->id==target) {
+      result.cost=current->currentCost;
+      break;
+    }
+
+    for (size_t direction=0; direction<4; direction++) {
+      size_t next=graph.GetNeighbour(current->id,direction);
+
+      if (next==std::numeric_limits<size_t>::max() ||
+          closedSet.contains(next)) {
+        continue;
+      }
+
+      double currentCost=current->currentCost+graph.costs[current->id][direction];
+      auto   openEntry=openMap.find(next);
+
+      if (openEntry!=openMap.end() &&
+          openEntry->second->currentCost<=currentCost) {
+        continue;
+      }
+
+      if (openEntry!=openMap.end()) {
+        Label* label=openEntry->second;
+
+        label->prev=current->id;
+        label->currentCost=currentCost;
+        label->overallCost=currentCost+label->estimateCost;
+        openList.Update(label);
+      }
+      else {
+        Label* label=arena.Allocate(next,current->id);
+
+        label->currentCost=currentCost;
+        label->estimateCost=graph.GetEstimate(next,target);
+        label->overallCost=currentCost+label->estimateCost;
+        openList.Push(label);
+        openMap[next]=label;
+      }
+    }
+  }
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace std::string_literals;
+  size_t gridSize=400;
+  size_t queryCount=50;
+  bool   help=false;
+
+  osmscout::CmdLineParser argParser("RoutingQueuePerformance", argc, argv);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+              help=value;
+            }),
+            std::vector<std::string>{"h","help"},
+            "Display help",
+            true);
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  gridSize=value;
+                }),
+                "size",
+                "Width and height of the grid graph, default: "s + std::to_string(gridSize));
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  queryCount=value;
+                }),
+                "queries",
+                "Number of searches, default: "s + std::to_string(queryCount));
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+  if (help){
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  if (gridSize<2) {
+    std::cerr << "Grid size must be at least 2" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Generate grid graph of " << gridSize << "x" << gridSize << " nodes..." << std::endl;
+
+  Graph                                 graph(gridSize,gridSize);
+  std::mt19937                          generator(4711);
+  std::uniform_int_distribution<size_t> distribution(0,gridSize*gridSize-1);
+  std::vector<std::pair<size_t,size_t>> queries;
+
+  for (size_t i=0; i<queryCount; i++) {
+    queries.emplace_back(distribution(generator),distribution(generator));
+  }
+
+  std::vector<Result> legacyResults;
+  std::vector<Result> currentResults;
+
+  std::cout << "Search with std::set, std::shared_ptr and std::unordered_set..." << std::endl;
+
+  osmscout::StopClock legacyTimer;
+
+  for (const auto& [start,target] : queries) {
+    legacyResults.push_back(SearchLegacy(graph,start,target));
+  }
+
+  legacyTimer.Stop();
+
+  std::cout << "Search with IndexedHeap, ObjectArena and FlatHashSet..." << std::endl;
+
+  osmscout::ObjectArena<Label> arena;
+  osmscout::StopClock          currentTimer;
+
+  for (const auto& [start,target] : queries) {
+    currentResults.push_back(SearchCurrent(graph,arena,start,target));
+  }
+
+  currentTimer.Stop();
+
+  size_t legacySettled=0;
+  size_t currentSettled=0;
+  bool   result=true;
+
+  for (size_t i=0; i<queries.size(); i++) {
+    legacySettled+=legacyResults[i].settled;
+    currentSettled+=currentResults[i].settled;
+
+    if (std::abs(legacyResults[i].cost-currentResults[i].cost)>1e-6) {
+      std::cerr << "Query " << i << ": different costs " << legacyResults[i].cost << " <=> " << currentResults[i].cost << std::endl;
+      result=false;
+    }
+  }
+
+  std::cout << std::fixed << std::setprecision(0);
+  std::cout << "std::set:    " << legacySettled << " nodes settled in " << legacyTimer << " => "
+            << double(legacySettled)/legacyTimer.GetMilliseconds()*1000.0 << " nodes/s" << std::endl;
+  std::cout << "IndexedHeap: " << currentSettled << " nodes settled in " << currentTimer << " => "
+            << double(currentSettled)/currentTimer.GetMilliseconds()*1000.0 << " nodes/s" << std::endl;
+
+  return result ? 0 : 1;
+}
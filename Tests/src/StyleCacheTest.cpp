@@ -0,0 +1,191 @@
+#include <filesystem>
+#include <list>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscoutmap/MapService.h>
+#include <osmscoutmap/StyleConfig.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestsTopDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return testsTopDir;
+}
+
+template<class S>
+static bool IsEqual(const std::shared_ptr<S>& a,
+                    const std::shared_ptr<S>& b)
+{
+  if (!a || !b) {
+    return a==b;
+  }
+
+  return *a==*b;
+}
+
+template<class S>
+static bool IsEqual(const std::vector<std::shared_ptr<S>>& a,
+                    const std::vector<std::shared_ptr<S>>& b)
+{
+  if (a.size()!=b.size()) {
+    return false;
+  }
+
+  for (size_t i=0; i<a.size(); i++) {
+    if (!IsEqual(a[i],b[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Check that the styles returned by the style config match the styles of a
+ * reference style config, where all styles get composed again
+ */
+static void CheckStyles(const osmscout::StyleConfig& styleConfig,
+                        osmscout::StyleConfig& referenceStyleConfig,
+                        const osmscout::Projection& projection,
+                        const osmscout::MapData& data)
+{
+  std::vector<osmscout::LineStyleRef>   lineStyles;
+  std::vector<osmscout::LineStyleRef>   referenceLineStyles;
+  std::vector<osmscout::BorderStyleRef> borderStyles;
+  std::vector<osmscout::BorderStyleRef> referenceBorderStyles;
+
+  for (const auto& way : data.ways) {
+    styleConfig.GetWayLineStyles(way->GetFeatureValueBuffer(),
+                                 projection,
+                                 lineStyles);
+
+    referenceStyleConfig.ClearStyleCache();
+    referenceStyleConfig.GetWayLineStyles(way->GetFeatureValueBuffer(),
+                                          projection,
+                                          referenceLineStyles);
+
+    CHECK(IsEqual(lineStyles,referenceLineStyles));
+  }
+
+  for (const auto& area : data.areas) {
+    for (const auto& ring : area->rings) {
+      if (ring.GetType()->GetIgnore()) {
+        continue;
+      }
+
+      osmscout::FillStyleRef fillStyle=styleConfig.GetAreaFillStyle(ring.GetType(),
+                                                                    ring.GetFeatureValueBuffer(),
+                                                                    projection);
+
+      styleConfig.GetAreaBorderStyles(ring.GetType(),
+                                      ring.GetFeatureValueBuffer(),
+                                      projection,
+                                      borderStyles);
+
+      referenceStyleConfig.ClearStyleCache();
+
+      osmscout::FillStyleRef referenceFillStyle=referenceStyleConfig.GetAreaFillStyle(ring.GetType(),
+                                                                                      ring.GetFeatureValueBuffer(),
+                                                                                      projection);
+
+      referenceStyleConfig.GetAreaBorderStyles(ring.GetType(),
+                                               ring.GetFeatureValueBuffer(),
+                                               projection,
+                                               referenceBorderStyles);
+
+      CHECK(IsEqual(fillStyle,referenceFillStyle));
+      CHECK(IsEqual(borderStyles,referenceBorderStyles));
+    }
+  }
+}
+
+TEST_CASE("Cached styles match the composed styles")
+{
+  std::string                 testsTopDir=GetTestsTopDirectory();
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(std::filesystem::path(testsTopDir).append("data").append("testregion").string()));
+
+  std::string              styleFile=std::filesystem::path(testsTopDir).append("..").append("stylesheets").append("standard.oss").string();
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+  osmscout::StyleConfigRef referenceStyleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  REQUIRE(styleConfig->Load(styleFile));
+  REQUIRE(referenceStyleConfig->Load(styleFile));
+
+  osmscout::StyleCacheStatistics statistics=styleConfig->GetStyleCacheStatistics();
+
+  CHECK(statistics.hits==0);
+  CHECK(statistics.misses==0);
+  CHECK(statistics.size==0);
+
+  osmscout::MapServiceRef mapService=std::make_shared<osmscout::MapService>(database);
+
+  for (uint32_t level : {12,14,16,18}) {
+    osmscout::MercatorProjection projection;
+    osmscout::Magnification      magnification{osmscout::MagnificationLevel(level)};
+
+    REQUIRE(projection.Set(osmscout::GeoCoord(50.418,14.56),
+                           magnification,
+                           96.0,
+                           1920,
+                           1080));
+
+    std::list<osmscout::TileRef>  tiles;
+    osmscout::AreaSearchParameter searchParameter;
+    osmscout::MapData             data;
+
+    mapService->LookupTiles(magnification,projection.GetDimensions(),tiles);
+    REQUIRE(mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles));
+    mapService->AddTileDataToMapData(tiles,data);
+
+    // First pass fills the cache, second pass is served from the cache
+    CheckStyles(*styleConfig,
+                *referenceStyleConfig,
+                projection,
+                data);
+    CheckStyles(*styleConfig,
+                *referenceStyleConfig,
+                projection,
+                data);
+  }
+
+  statistics=styleConfig->GetStyleCacheStatistics();
+
+  CHECK(statistics.misses>0);
+  CHECK(statistics.hits>statistics.misses);
+  CHECK(statistics.size==statistics.misses);
+
+  styleConfig->ClearStyleCache();
+
+  statistics=styleConfig->GetStyleCacheStatistics();
+
+  CHECK(statistics.hits==0);
+  CHECK(statistics.misses==0);
+  CHECK(statistics.size==0);
+
+  database->Close();
+}
@@ -0,0 +1,236 @@
+#include <filesystem>
+#include <list>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscoutmap/MapService.h>
+#include <osmscoutmap/StyleConfig.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string GetTestsTopDirectory()
+{
+  char* testsTopDirEnv=::getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    throw osmscout::UninitializedException("Expected environment variable 'TESTS_TOP_DIR' not set");
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (testsTopDir.empty()) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' is empty");
+  }
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    throw osmscout::UninitializedException("Environment variable 'TESTS_TOP_DIR' does not point to directory");
+  }
+
+  return testsTopDir;
+}
+
+template<class S>
+static bool IsEqual(const std::shared_ptr<S>& a,
+                    const std::shared_ptr<S>& b)
+{
+  if (!a || !b) {
+    return a==b;
+  }
+
+  return *a==*b;
+}
+
+/**
+ * Icon, path text and path shield styles do not offer a comparison operator,
+ * compare the attributes relevant for rendering
+ */
+static bool IsEqual(const osmscout::IconStyleRef& a,
+                    const osmscout::IconStyleRef& b)
+{
+  if (!a || !b) {
+    return !a && !b;
+  }
+
+  return a->GetIconName()==b->GetIconName() &&
+         a->GetSymbol()==b->GetSymbol() &&
+         a->GetPriority()==b->GetPriority() &&
+         a->GetPosition()==b->GetPosition();
+}
+
+static bool IsEqual(const osmscout::PathTextStyleRef& a,
+                    const osmscout::PathTextStyleRef& b)
+{
+  if (!a || !b) {
+    return !a && !b;
+  }
+
+  return a->GetLabel()==b->GetLabel() &&
+         a->GetSize()==b->GetSize() &&
+         a->GetTextColor()==b->GetTextColor() &&
+         a->GetOffset()==b->GetOffset() &&
+         a->GetPriority()==b->GetPriority();
+}
+
+static bool IsEqual(const osmscout::PathShieldStyleRef& a,
+                    const osmscout::PathShieldStyleRef& b)
+{
+  if (!a || !b) {
+    return !a && !b;
+  }
+
+  return a->GetLabel()==b->GetLabel() &&
+         a->GetSize()==b->GetSize() &&
+         a->GetTextColor()==b->GetTextColor() &&
+         a->GetBgColor()==b->GetBgColor() &&
+         a->GetShieldSpace()==b->GetShieldSpace() &&
+         a->GetPriority()==b->GetPriority();
+}
+
+template<class S>
+static bool IsEqual(const std::vector<std::shared_ptr<S>>& a,
+                    const std::vector<std::shared_ptr<S>>& b)
+{
+  if (a.size()!=b.size()) {
+    return false;
+  }
+
+  for (size_t i=0; i<a.size(); i++) {
+    if (!IsEqual(a[i],b[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Check that the styles resolved using the decision tables match the styles
+ * resolved by evaluating the criteria of each style selector. The cache of
+ * composed styles is cleared before each lookup, so that each style is
+ * actually resolved.
+ */
+template<class F>
+static void CheckStyle(osmscout::StyleConfig& styleConfig,
+                       F&& lookup)
+{
+  styleConfig.SetUseDecisionTables(true);
+  styleConfig.ClearStyleCache();
+
+  auto style=lookup();
+
+  styleConfig.SetUseDecisionTables(false);
+  styleConfig.ClearStyleCache();
+
+  auto referenceStyle=lookup();
+
+  CHECK(IsEqual(style,referenceStyle));
+}
+
+static void CheckStyles(osmscout::StyleConfig& styleConfig,
+                        const osmscout::Projection& projection,
+                        const osmscout::MapData& data)
+{
+  for (const auto& node : data.nodes) {
+    const osmscout::FeatureValueBuffer& buffer=node->GetFeatureValueBuffer();
+
+    CheckStyle(styleConfig,[&]() {
+      std::vector<osmscout::TextStyleRef> styles;
+      styleConfig.GetNodeTextStyles(buffer,projection,styles);
+      return styles;
+    });
+    CheckStyle(styleConfig,[&]() {
+      return styleConfig.GetNodeIconStyle(buffer,projection);
+    });
+  }
+
+  for (const auto& way : data.ways) {
+    const osmscout::FeatureValueBuffer& buffer=way->GetFeatureValueBuffer();
+
+    CheckStyle(styleConfig,[&]() {
+      std::vector<osmscout::LineStyleRef> styles;
+      styleConfig.GetWayLineStyles(buffer,projection,styles);
+      return styles;
+    });
+    CheckStyle(styleConfig,[&]() {
+      return styleConfig.GetWayPathTextStyle(buffer,projection);
+    });
+    CheckStyle(styleConfig,[&]() {
+      return styleConfig.GetWayPathShieldStyle(buffer,projection);
+    });
+  }
+
+  for (const auto& area : data.areas) {
+    for (const auto& ring : area->rings) {
+      if (ring.GetType()->GetIgnore()) {
+        continue;
+      }
+
+      const osmscout::TypeInfoRef&        type=ring.GetType();
+      const osmscout::FeatureValueBuffer& buffer=ring.GetFeatureValueBuffer();
+
+      CheckStyle(styleConfig,[&]() {
+        return styleConfig.GetAreaFillStyle(type,buffer,projection);
+      });
+      CheckStyle(styleConfig,[&]() {
+        std::vector<osmscout::BorderStyleRef> styles;
+        styleConfig.GetAreaBorderStyles(type,buffer,projection,styles);
+        return styles;
+      });
+      CheckStyle(styleConfig,[&]() {
+        std::vector<osmscout::TextStyleRef> styles;
+        styleConfig.GetAreaTextStyles(type,buffer,projection,styles);
+        return styles;
+      });
+      CheckStyle(styleConfig,[&]() {
+        return styleConfig.GetAreaIconStyle(type,buffer,projection);
+      });
+    }
+  }
+}
+
+TEST_CASE("Styles resolved by decision tables match the selector criteria")
+{
+  std::string                 testsTopDir=GetTestsTopDirectory();
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(std::filesystem::path(testsTopDir).append("data").append("testregion").string()));
+
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  REQUIRE(styleConfig->Load(std::filesystem::path(testsTopDir).append("..").append("stylesheets").append("standard.oss").string()));
+
+  CHECK(styleConfig->GetUseDecisionTables());
+
+  osmscout::MapServiceRef mapService=std::make_shared<osmscout::MapService>(database);
+
+  for (uint32_t level : {10,12,14,16,18,20}) {
+    osmscout::MercatorProjection projection;
+    osmscout::Magnification      magnification{osmscout::MagnificationLevel(level)};
+
+    REQUIRE(projection.Set(osmscout::GeoCoord(50.418,14.56),
+                           magnification,
+                           96.0,
+                           1920,
+                           1080));
+
+    std::list<osmscout::TileRef>  tiles;
+    osmscout::AreaSearchParameter searchParameter;
+    osmscout::MapData             data;
+
+    mapService->LookupTiles(magnification,projection.GetDimensions(),tiles);
+    REQUIRE(mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles));
+    mapService->AddTileDataToMapData(tiles,data);
+
+    CheckStyles(*styleConfig,
+                projection,
+                data);
+  }
+
+  database->Close();
+}
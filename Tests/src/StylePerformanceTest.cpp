@@ -0,0 +1,270 @@
+/*
+  StylePerformance - a test program for libosmscout
+  Copyright (C) 2026  agent
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <osmscoutmap/MapService.h>
+#include <osmscoutmap/StyleConfig.h>
+
+/**
+  Resolve the styles of all nodes, ways and areas of a database region, as the
+  map painter does, at several magnification levels. This is done once with
+  the style selectors evaluated by their decision tables and once by
+  evaluating the criteria of each selector. Prints the number of resolved
+  objects per second for both.
+*/
+
+struct Level
+{
+  osmscout::MercatorProjection projection;
+  osmscout::MapData            data;
+};
+
+/**
+ * Resolve the styles of all objects, returns the number of found styles
+ */
+static size_t ResolveStyles(const osmscout::StyleConfig& styleConfig,
+                            const Level& level)
+{
+  std::vector<osmscout::TextStyleRef>       textStyles;
+  std::vector<osmscout::LineStyleRef>       lineStyles;
+  std::vector<osmscout::BorderStyleRef>     borderStyles;
+  std::vector<osmscout::PathSymbolStyleRef> symbolStyles;
+  size_t                                    count=0;
+
+  for (const auto& node : level.data.nodes) {
+    styleConfig.GetNodeTextStyles(node->GetFeatureValueBuffer(),
+                                  level.projection,
+                                  textStyles);
+    count+=textStyles.size();
+
+    if (styleConfig.GetNodeIconStyle(node->GetFeatureValueBuffer(),
+                                     level.projection)) {
+      count++;
+    }
+  }
+
+  for (const auto& way : level.data.ways) {
+    styleConfig.GetWayLineStyles(way->GetFeatureValueBuffer(),
+                                 level.projection,
+                                 lineStyles);
+    count+=lineStyles.size();
+
+    styleConfig.GetWayPathSymbolStyle(way->GetFeatureValueBuffer(),
+                                      level.projection,
+                                      symbolStyles);
+    count+=symbolStyles.size();
+
+    if (styleConfig.GetWayPathTextStyle(way->GetFeatureValueBuffer(),
+                                        level.projection)) {
+      count++;
+    }
+
+    if (styleConfig.GetWayPathShieldStyle(way->GetFeatureValueBuffer(),
+                                          level.projection)) {
+      count++;
+    }
+  }
+
+  for (const auto& area : level.data.areas) {
+    for (const auto& ring : area->rings) {
+      if (ring.GetType()->GetIgnore()) {
+        continue;
+      }
+
+      if (styleConfig.GetAreaFillStyle(ring.GetType(),
+                                       ring.GetFeatureValueBuffer(),
+                                       level.projection)) {
+        count++;
+      }
+
+      styleConfig.GetAreaBorderStyles(ring.GetType(),
+                                      ring.GetFeatureValueBuffer(),
+                                      level.projection,
+                                      borderStyles);
+      count+=borderStyles.size();
+
+      styleConfig.GetAreaTextStyles(ring.GetType(),
+                                    ring.GetFeatureValueBuffer(),
+                                    level.projection,
+                                    textStyles);
+      count+=textStyles.size();
+
+      if (styleConfig.GetAreaIconStyle(ring.GetType(),
+                                       ring.GetFeatureValueBuffer(),
+                                       level.projection)) {
+        count++;
+      }
+    }
+  }
+
+  return count;
+}
+
+static size_t GetObjectCount(const Level& level)
+{
+  size_t count=level.data.nodes.size()+level.data.ways.size();
+
+  for (const auto& area : level.data.areas) {
+    count+=area->rings.size();
+  }
+
+  return count;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace std::string_literals;
+  std::string databaseDirectory;
+  std::string styleFile;
+  size_t      iterations=1000;
+  bool        help=false;
+
+  osmscout::CmdLineParser argParser("StylePerformance", argc, argv);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+              help=value;
+            }),
+            std::vector<std::string>{"h","help"},
+            "Display help",
+            true);
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  iterations=value;
+                }),
+                "iterations",
+                "Number of times the styles of all objects are resolved, default: "s + std::to_string(iterations));
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&](const std::string& value) {
+                            databaseDirectory=value;
+                          }),
+                          "DATABASE",
+                          "Directory of the database");
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&](const std::string& value) {
+                            styleFile=value;
+                          }),
+                          "STYLESHEET",
+                          "Stylesheet file");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+  if (help){
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(databaseDirectory)) {
+    std::cerr << "Cannot open database" << std::endl;
+    return 1;
+  }
+
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  if (!styleConfig->Load(styleFile)) {
+    std::cerr << "Cannot open style" << std::endl;
+    return 1;
+  }
+
+  osmscout::MapServiceRef mapService=std::make_shared<osmscout::MapService>(database);
+  std::list<Level> levels;
+
+  for (uint32_t magnificationLevel=10; magnificationLevel<=18; magnificationLevel+=2) {
+    Level&                        level=levels.emplace_back();
+    osmscout::Magnification       magnification{osmscout::MagnificationLevel(magnificationLevel)};
+    std::list<osmscout::TileRef>  tiles;
+    osmscout::AreaSearchParameter searchParameter;
+
+    level.projection.Set(osmscout::GeoCoord(50.418,14.56),
+                         magnification,
+                         96.0,
+                         1920,
+                         1080);
+
+    mapService->LookupTiles(magnification,level.projection.GetDimensions(),tiles);
+    mapService->LoadMissingTileData(searchParameter,*styleConfig,tiles);
+    mapService->AddTileDataToMapData(tiles,level.data);
+  }
+
+  size_t objectCount=0;
+
+  for (const auto& level : levels) {
+    objectCount+=GetObjectCount(level);
+  }
+
+  std::cout << "Resolving styles of " << objectCount << " objects " << iterations << " times..." << std::endl;
+
+  size_t styleCounts[2]={0,0};
+  double milliseconds[2]={0.0,0.0};
+
+  for (bool useDecisionTables : {false,true}) {
+    styleConfig->SetUseDecisionTables(useDecisionTables);
+
+    // Warm up the cache of composed styles
+    for (const auto& level : levels) {
+      ResolveStyles(*styleConfig,level);
+    }
+
+    osmscout::StopClock timer;
+
+    for (size_t i=0; i<iterations; i++) {
+      for (const auto& level : levels) {
+        styleCounts[useDecisionTables]+=ResolveStyles(*styleConfig,level);
+      }
+    }
+
+    timer.Stop();
+
+    milliseconds[useDecisionTables]=timer.GetMilliseconds();
+  }
+
+  database->Close();
+
+  std::cout << std::fixed << std::setprecision(0);
+  std::cout << "Selector criteria: " << styleCounts[0] << " styles in " << milliseconds[0] << " ms => "
+            << double(objectCount*iterations)/milliseconds[0]*1000.0 << " objects/s" << std::endl;
+  std::cout << "Decision tables:   " << styleCounts[1] << " styles in " << milliseconds[1] << " ms => "
+            << double(objectCount*iterations)/milliseconds[1]*1000.0 << " objects/s" << std::endl;
+
+  if (styleCounts[0]!=styleCounts[1]) {
+    std::cerr << "Different number of styles" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
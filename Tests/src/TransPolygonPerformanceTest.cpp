@@ -0,0 +1,242 @@
+/*
+  TransPolygonPerformance - a test program for libosmscout
+  Copyright (C) 2026  agent
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscout/system/VectorMath.h>
+
+#include <osmscout/util/StopClock.h>
+#include <osmscout/util/Transformation.h>
+
+/**
+  Optimize a large random coastline, as it is done for coastlines and
+  administrative boundaries by the map painter, as area and as way at several
+  magnification levels. This is done with the fast and the quality
+  optimization method for each supported vector instruction set. Prints the
+  time required for the optimization and the number of remaining points.
+*/
+
+static const char* GetInstructionSetName(osmscout::VectorInstructionSet instructionSet)
+{
+  switch (instructionSet) {
+  case osmscout::VectorInstructionSet::avx2:
+    return "AVX2";
+  case osmscout::VectorInstructionSet::avx512:
+    return "AVX-512";
+  default:
+    return "Scalar";
+  }
+}
+
+/**
+ * A random coastline, changing its direction slowly
+ */
+static std::vector<osmscout::GeoCoord> GetCoastline(const osmscout::GeoCoord& start,
+                                                    size_t count)
+{
+  std::mt19937                           generator(42);
+  std::normal_distribution<double>       turn(0.0,0.3);
+  std::uniform_real_distribution<double> length(0.000001,0.0002);
+  std::vector<osmscout::GeoCoord>        coastline;
+  osmscout::GeoCoord                     coord=start;
+  double                                 direction=0.0;
+
+  coastline.reserve(count);
+
+  for (size_t i=0; i<count; i++) {
+    direction+=turn(generator);
+
+    double distance=length(generator);
+
+    coord=osmscout::GeoCoord(coord.GetLat()+distance*std::sin(direction),
+                             coord.GetLon()+distance*std::cos(direction));
+
+    coastline.push_back(coord);
+  }
+
+  return coastline;
+}
+
+/**
+ * Transform and optimize the coastline, returns the time required for the
+ * optimization in milliseconds
+ */
+static double Optimize(const std::vector<osmscout::GeoCoord>& coastline,
+                       const osmscout::Projection& projection,
+                       bool isArea,
+                       osmscout::TransPolygon::OptimizeMethod optimize,
+                       osmscout::VectorInstructionSet instructionSet,
+                       size_t iterations,
+                       size_t& pointCount)
+{
+  osmscout::TransBuffer buffer;
+  double                milliseconds=0.0;
+
+  for (size_t i=0; i<iterations; i++) {
+    // Use the same pixel coordinates for all instruction sets
+    osmscout::SetVectorInstructionSet(osmscout::VectorInstructionSet::none);
+
+    buffer.Reset();
+    buffer.TransformGeoToPixel(projection,
+                               coastline);
+
+    osmscout::SetVectorInstructionSet(instructionSet);
+
+    osmscout::StopClock timer;
+
+    if (isArea) {
+      osmscout::OptimizeArea(buffer,
+                             optimize,
+                             1.0,
+                             osmscout::TransPolygon::noConstraint);
+    }
+    else {
+      osmscout::OptimizeWay(buffer,
+                            optimize,
+                            1.0,
+                            osmscout::TransPolygon::noConstraint);
+    }
+
+    timer.Stop();
+
+    milliseconds+=timer.GetMilliseconds();
+  }
+
+  pointCount=buffer.GetLength();
+
+  return milliseconds;
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace std::string_literals;
+
+  size_t pointCount=1000000;
+  size_t iterations=10;
+  bool   help=false;
+
+  osmscout::CmdLineParser argParser("TransPolygonPerformance", argc, argv);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&](const bool& value) {
+              help=value;
+            }),
+            std::vector<std::string>{"h","help"},
+            "Display help",
+            true);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  pointCount=value;
+                }),
+                "points",
+                "Number of points of the coastline, default: "s + std::to_string(pointCount));
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&](const size_t& value) {
+                  iterations=value;
+                }),
+                "iterations",
+                "Number of times the coastline is optimized, default: "s + std::to_string(iterations));
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (help){
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  osmscout::GeoCoord              start(50.418,14.56);
+  std::vector<osmscout::GeoCoord> coastline=GetCoastline(start,pointCount);
+  osmscout::GeoBox                boundingBox=osmscout::GeoBox::BoxByCenterAndRadius(start,osmscout::Distance::Of<osmscout::Kilometer>(1.0));
+
+  for (const auto& coord : coastline) {
+    boundingBox.Include(coord);
+  }
+
+  std::cout << "Optimizing a coastline of " << pointCount << " points " << iterations << " times..." << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+
+  bool success=true;
+
+  for (auto level : {osmscout::Magnification::magRegion,
+                     osmscout::Magnification::magCity,
+                     osmscout::Magnification::magHouse}) {
+    osmscout::MercatorProjection projection;
+
+    projection.Set(boundingBox.GetCenter(),
+                   osmscout::Magnification(level),
+                   96.0,
+                   1920,
+                   1080);
+
+    for (bool isArea : {true,false}) {
+      for (auto optimize : {osmscout::TransPolygon::fast,
+                            osmscout::TransPolygon::quality}) {
+        size_t expectedPointCount=0;
+
+        for (auto instructionSet : {osmscout::VectorInstructionSet::none,
+                                    osmscout::VectorInstructionSet::avx2,
+                                    osmscout::VectorInstructionSet::avx512}) {
+          if (instructionSet>osmscout::GetSupportedVectorInstructionSet()) {
+            continue;
+          }
+
+          size_t resultPointCount;
+          double milliseconds=Optimize(coastline,
+                                       projection,
+                                       isArea,
+                                       optimize,
+                                       instructionSet,
+                                       iterations,
+                                       resultPointCount);
+
+          std::cout << "Level " << std::setw(2) << level << " "
+                    << (isArea ? "area" : "way ") << " "
+                    << (optimize==osmscout::TransPolygon::fast ? "fast   " : "quality") << " "
+                    << std::setw(7) << GetInstructionSetName(instructionSet) << ": "
+                    << std::setw(8) << milliseconds << " ms, "
+                    << resultPointCount << " points" << std::endl;
+
+          if (instructionSet==osmscout::VectorInstructionSet::none) {
+            expectedPointCount=resultPointCount;
+          }
+          else if (resultPointCount!=expectedPointCount) {
+            std::cerr << "Different number of points" << std::endl;
+            success=false;
+          }
+        }
+      }
+    }
+  }
+
+  osmscout::SetVectorInstructionSet(osmscout::GetSupportedVectorInstructionSet());
+
+  return success ? 0 : 1;
+}
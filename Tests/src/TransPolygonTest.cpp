@@ -19,11 +19,14 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <random>
 
 #include <TestWay.h>
 
 #include <osmscout/projection/MercatorProjection.h>
 
+#include <osmscout/system/VectorMath.h>
+
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Transformation.h>
 
@@ -145,3 +148,205 @@ TEST_CASE("Optimized area is still simple")
   REQUIRE(AreaIsSimple(optimised));
 }
 
+
+/**
+ * A long random coastline with some duplicated nodes
+ */
+static std::vector<osmscout::Point> GetTestCoastline()
+{
+  std::mt19937                           generator(42);
+  std::normal_distribution<double>       turn(0.0,0.3);
+  std::uniform_real_distribution<double> length(0.000001,0.0002);
+  std::uniform_int_distribution<int>     duplicate(0,19);
+  std::vector<osmscout::Point>           coastline;
+  osmscout::GeoCoord                     coord(43.914554,8.0902544);
+  double                                 direction=0.0;
+
+  for (size_t i=0; i<20000; i++) {
+    if (!coastline.empty() && duplicate(generator)==0) {
+      coastline.push_back(coastline.back());
+      continue;
+    }
+
+    direction+=turn(generator);
+
+    double distance=length(generator);
+
+    coord=osmscout::GeoCoord(coord.GetLat()+distance*std::sin(direction),
+                             coord.GetLon()+distance*std::cos(direction));
+
+    coastline.emplace_back(0,coord);
+  }
+
+  return coastline;
+}
+
+/**
+ * Return the draw flags of the optimized way or area
+ */
+static std::vector<bool> GetOptimizedDrawFlags(const std::vector<osmscout::Point>& way,
+                                               const osmscout::Projection& projection,
+                                               bool isArea,
+                                               osmscout::TransPolygon::OptimizeMethod optimize,
+                                               double optimizeErrorTolerance,
+                                               osmscout::VectorInstructionSet instructionSet)
+{
+  osmscout::TransBuffer transBuffer;
+
+  // The projection uses vector instructions, too, use the same pixel coordinates
+  // for all instruction sets
+  osmscout::SetVectorInstructionSet(osmscout::VectorInstructionSet::none);
+
+  if (isArea) {
+    osmscout::TransformArea(way,
+                            transBuffer,
+                            projection,
+                            osmscout::TransPolygon::none,
+                            optimizeErrorTolerance);
+  }
+  else {
+    osmscout::TransformWay(way,
+                           transBuffer,
+                           projection,
+                           osmscout::TransPolygon::none,
+                           optimizeErrorTolerance);
+  }
+
+  osmscout::SetVectorInstructionSet(instructionSet);
+
+  if (isArea) {
+    osmscout::OptimizeArea(transBuffer,
+                           optimize,
+                           optimizeErrorTolerance,
+                           osmscout::TransPolygon::noConstraint);
+  }
+  else {
+    osmscout::OptimizeWay(transBuffer,
+                          optimize,
+                          optimizeErrorTolerance,
+                          osmscout::TransPolygon::noConstraint);
+  }
+
+  osmscout::SetVectorInstructionSet(osmscout::GetSupportedVectorInstructionSet());
+
+  std::vector<bool> drawFlags;
+
+  for (size_t p=0; p<way.size(); p++) {
+    drawFlags.push_back(transBuffer.points[p].draw);
+  }
+
+  return drawFlags;
+}
+
+TEST_CASE("Optimization returns the same result for all vector instruction sets")
+{
+  std::vector<osmscout::Point> testWay=GetTestWay();
+  std::vector<osmscout::Point> coastline=GetTestCoastline();
+
+  for (auto level : {osmscout::Magnification::magRegion,
+                     osmscout::Magnification::magSuburb,
+                     osmscout::Magnification::magHouse}) {
+    osmscout::MercatorProjection projection;
+
+    projection.Set(osmscout::GeoCoord(43.914554, 8.0902544),
+                   /*angle*/ 0,
+                   osmscout::Magnification(level),
+                   /*dpi*/ 72,
+                   /*width*/ 1000,
+                   /*height*/ 1000);
+
+    for (const auto& way : {testWay,coastline}) {
+      for (bool isArea : {false,true}) {
+        for (auto optimize : {osmscout::TransPolygon::fast,
+                              osmscout::TransPolygon::quality}) {
+          std::vector<bool> expected=GetOptimizedDrawFlags(way,
+                                                           projection,
+                                                           isArea,
+                                                           optimize,
+                                                           1.0,
+                                                           osmscout::VectorInstructionSet::none);
+
+          for (auto instructionSet : {osmscout::VectorInstructionSet::avx2,
+                                      osmscout::VectorInstructionSet::avx512}) {
+            REQUIRE(GetOptimizedDrawFlags(way,
+                                          projection,
+                                          isArea,
+                                          optimize,
+                                          1.0,
+                                          instructionSet)==expected);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Runs of equal points give the result of the scalar implementation")
+{
+  osmscout::MercatorProjection projection;
+
+  projection.Set(osmscout::GeoCoord(43.914554, 8.0902544),
+                 /*angle*/ 0,
+                 osmscout::Magnification(osmscout::Magnification::magHouse),
+                 /*dpi*/ 72,
+                 /*width*/ 1000,
+                 /*height*/ 1000);
+
+  osmscout::GeoCoord a(43.9140,8.0900);
+  osmscout::GeoCoord b(43.9150,8.0900);
+  osmscout::GeoCoord c(43.9150,8.0910);
+  osmscout::GeoCoord d(43.9140,8.0910);
+
+  // Run of four equal points in the middle
+  std::vector<osmscout::Point> middleRun={osmscout::Point(0,a),
+                                          osmscout::Point(0,b),
+                                          osmscout::Point(0,b),
+                                          osmscout::Point(0,b),
+                                          osmscout::Point(0,b),
+                                          osmscout::Point(0,c),
+                                          osmscout::Point(0,d)};
+  // Runs of three equal points at the start and at the end
+  std::vector<osmscout::Point> outerRuns={osmscout::Point(0,a),
+                                          osmscout::Point(0,a),
+                                          osmscout::Point(0,a),
+                                          osmscout::Point(0,b),
+                                          osmscout::Point(0,c),
+                                          osmscout::Point(0,d),
+                                          osmscout::Point(0,d),
+                                          osmscout::Point(0,d)};
+
+  // Result of the scalar implementation before the vectorization
+  std::vector<bool> middleRunExpected={true,true,false,false,false,true,true};
+  std::vector<bool> outerRunsWayExpected={true,false,false,true,true,false,false,true};
+  std::vector<bool> outerRunsAreaExpected={true,false,false,true,true,true,false,false};
+
+  for (auto optimize : {osmscout::TransPolygon::fast,
+                        osmscout::TransPolygon::quality}) {
+    for (auto instructionSet : {osmscout::VectorInstructionSet::none,
+                                osmscout::VectorInstructionSet::avx2,
+                                osmscout::VectorInstructionSet::avx512}) {
+      for (bool isArea : {false,true}) {
+        REQUIRE(GetOptimizedDrawFlags(middleRun,
+                                      projection,
+                                      isArea,
+                                      optimize,
+                                      1.0,
+                                      instructionSet)==middleRunExpected);
+      }
+
+      for (bool isArea : {false,true}) {
+        // The last point of a fast optimized area is always kept
+        const std::vector<bool>& expected=isArea && optimize==osmscout::TransPolygon::quality ?
+                                          outerRunsAreaExpected :
+                                          outerRunsWayExpected;
+
+        REQUIRE(GetOptimizedDrawFlags(outerRuns,
+                                      projection,
+                                      isArea,
+                                      optimize,
+                                      1.0,
+                                      instructionSet)==expected);
+      }
+    }
+  }
+}
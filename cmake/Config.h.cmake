@@ -11,6 +11,16 @@
 #cmakedefine HAVE_AVX 1
 #endif
 
+/* Compiler supports runtime dispatch to AVX2 code */
+#ifndef HAVE_AVX2_DISPATCH
+#cmakedefine HAVE_AVX2_DISPATCH 1
+#endif
+
+/* Compiler supports runtime dispatch to AVX-512 code */
+#ifndef HAVE_AVX512_DISPATCH
+#cmakedefine HAVE_AVX512_DISPATCH 1
+#endif
+
 /* Define to 1 if you have the <dlfcn.h> header file. */
 #ifndef HAVE_DLFCN_H
 #cmakedefine HAVE_DLFCN_H 1
@@ -65,6 +75,11 @@
 #cmakedefine HAVE_INTTYPES_H 1
 #endif
 
+/* Define to 1 if you have the <linux/io_uring.h> header file. */
+#ifndef HAVE_LINUX_IO_URING_H
+#cmakedefine HAVE_LINUX_IO_URING_H 1
+#endif
+
 /* Define to 1 if the system has the type `long long'. */
 #ifndef HAVE_LONG_LONG
 #cmakedefine HAVE_LONG_LONG 1
@@ -80,11 +95,26 @@
 #cmakedefine HAVE_MMAP 1
 #endif
 
+/* Define to 1 if you have the `mincore' function. */
+#ifndef HAVE_MINCORE
+#cmakedefine HAVE_MINCORE 1
+#endif
+
+/* Define to 1 if you have the `mlock' function. */
+#ifndef HAVE_MLOCK
+#cmakedefine HAVE_MLOCK 1
+#endif
+
 /* Support mmx instructions */
 #ifndef HAVE_MMX
 #cmakedefine HAVE_MMX 1
 #endif
 
+/* Define to 1 if you have the `pread' function. */
+#ifndef HAVE_PREAD
+#cmakedefine HAVE_PREAD 1
+#endif
+
 /* Define to 1 if you have the `posix_fadvise' function. */
 #ifndef HAVE_POSIX_FADVISE
 #cmakedefine HAVE_POSIX_FADVISE 1
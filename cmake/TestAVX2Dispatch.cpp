@@ -0,0 +1,26 @@
+typedef double vdf __attribute__((vector_size(32)));
+
+__attribute__((target("avx2,fma")))
+static double Sum(const double* values)
+{
+  vdf value;
+
+  __builtin_memcpy(&value,values,sizeof(value));
+
+  value=value*value+1.0;
+
+  return value[0]+value[1];
+}
+
+int main()
+{
+  double values[32/sizeof(double)]={};
+
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return Sum(values)>0.0 ? 0 : 1;
+  }
+
+  return 0;
+}
@@ -95,6 +95,7 @@ include(CheckIncludeFileCXX)
 check_include_file(dlfcn.h HAVE_DLFCN_H)
 check_include_file(fcntl.h HAVE_FCNTL_H)
 check_include_file(inttypes.h HAVE_INTTYPES_H)
+check_include_file(linux/io_uring.h HAVE_LINUX_IO_URING_H)
 check_include_file(memory.h HAVE_MEMORY_H)
 check_include_file(stdint.h HAVE_STDINT_H)
 check_include_file(stdlib.h HAVE_STDLIB_H)
@@ -130,8 +131,11 @@ set(CMAKE_EXTRA_INCLUDE_FILES)
 # check functions exists
 check_function_exists(fseeko HAVE_FSEEKO)
 check_function_exists(mmap HAVE_MMAP)
+check_function_exists(mincore HAVE_MINCORE)
+check_function_exists(mlock HAVE_MLOCK)
 check_function_exists(posix_fadvise HAVE_POSIX_FADVISE)
 check_function_exists(posix_madvise HAVE_POSIX_MADVISE)
+check_function_exists(pread HAVE_PREAD)
 check_function_exists(mallinfo2 HAVE_MALLINFO2)
 
 # prefer static libraries if shared are disabled
@@ -367,6 +371,18 @@ if(PTHREAD_NAME_OK)
   set(OSMSCOUT_PTHREAD_NAME TRUE)
 endif()
 
+try_compile(AVX2_DISPATCH_OK "${PROJECT_BINARY_DIR}"
+  "${PROJECT_SOURCE_DIR}/cmake/TestAVX2Dispatch.cpp")
+if(AVX2_DISPATCH_OK)
+  set(HAVE_AVX2_DISPATCH TRUE)
+endif()
+
+try_compile(AVX512_DISPATCH_OK "${PROJECT_BINARY_DIR}"
+  "${PROJECT_SOURCE_DIR}/cmake/TestAVX512Dispatch.cpp")
+if(AVX512_DISPATCH_OK)
+  set(HAVE_AVX512_DISPATCH TRUE)
+endif()
+
 if(MSVC)
   set(HAVE_STD_EXECUTION 1)
 else()
@@ -54,6 +54,9 @@ DBThread::DBThread(const std::string &basemapLookupDirectory,
   stylesheetFlags=settings->GetStyleSheetFlags();
   osmscout::log.Debug() << "Using stylesheet: " << stylesheetFilename;
 
+  // databases imported with the same type configuration share one TypeConfig instance
+  databaseParameter.SetRegistry(osmscout::DatabaseRegistry::GetInstance());
+
   emptyTypeConfig=std::make_shared<TypeConfig>();
   registerCustomPoiTypes(emptyTypeConfig);
   emptyStyleConfig=makeStyleConfig(emptyTypeConfig, true);
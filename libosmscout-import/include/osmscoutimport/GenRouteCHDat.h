@@ -0,0 +1,139 @@
+#ifndef OSMSCOUT_IMPORT_GENROUTECHDAT_H
+#define OSMSCOUT_IMPORT_GENROUTECHDAT_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/ObjectRef.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+
+#include <osmscout/system/Compiler.h>
+
+#include <osmscoutimport/Import.h>
+
+namespace osmscout {
+
+  /**
+   * Optional import module (see ImportParameter::SetRouterCH()) generating a
+   * contraction hierarchy of the routing graph of each router and vehicle,
+   * as used by the CHRoutingService.
+   *
+   * Nodes are contracted in the order of their edge difference (number of
+   * shortcuts required minus number of edges removed) and the number of
+   * already contracted neighbours. Shortcuts are only added, if a local witness
+   * search does not find a path of at most the same cost.
+   */
+  class RouteCHDataGenerator CLASS_FINAL : public ImportModule
+  {
+  private:
+    /**
+     * Edge of the graph during contraction
+     */
+    struct Edge
+    {
+      uint32_t      node;   //!< Index of the other node
+      uint32_t      middle; //!< Index of the contracted middle node of a shortcut
+      double        cost;
+      ObjectFileRef object; //!< Object followed by an original path
+    };
+
+    /**
+     * The remaining graph of not yet contracted nodes
+     */
+    struct Graph
+    {
+      std::vector<std::vector<Edge>> outEdges;
+      std::vector<std::vector<Edge>> inEdges;
+
+      void AddEdge(uint32_t from,
+                   uint32_t to,
+                   uint32_t middle,
+                   double cost,
+                   const ObjectFileRef& object);
+      void RemoveNode(uint32_t node);
+    };
+
+    /**
+     * Reused state of the local witness searches
+     */
+    struct WitnessSearch
+    {
+      using QueueEntry = std::pair<double,uint32_t>;
+
+      std::vector<double>   costs;
+      std::vector<uint32_t> touched;
+      std::priority_queue<QueueEntry,std::vector<QueueEntry>,std::greater<>> queue;
+
+      explicit WitnessSearch(size_t nodeCount);
+
+      void Search(const Graph& graph,
+                  uint32_t source,
+                  uint32_t ignoredNode,
+                  double maxCost);
+
+      double GetCost(uint32_t node) const
+      {
+        return costs[node];
+      }
+    };
+
+    struct Shortcut
+    {
+      uint32_t from;
+      uint32_t to;
+      double   cost;
+    };
+
+  private:
+    bool LoadGraph(const TypeConfigRef& typeConfig,
+                   const ImportParameter& parameter,
+                   Progress& progress,
+                   const ImportParameter::Router& router,
+                   Vehicle vehicle,
+                   std::vector<Id>& nodeIds,
+                   Graph& graph) const;
+
+    void GetShortcuts(const Graph& graph,
+                      WitnessSearch& witnessSearch,
+                      uint32_t node,
+                      std::vector<Shortcut>& shortcuts) const;
+
+    ContractionHierarchy Contract(Progress& progress,
+                                  Vehicle vehicle,
+                                  const std::vector<Id>& nodeIds,
+                                  Graph& graph) const;
+
+  public:
+    void GetDescription(const ImportParameter& parameter,
+                        ImportModuleDescription& description) const override;
+
+    bool Import(const TypeConfigRef& typeConfig,
+                const ImportParameter& parameter,
+                Progress& progress) override;
+  };
+}
+
+#endif
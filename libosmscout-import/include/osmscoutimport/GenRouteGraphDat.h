@@ -0,0 +1,53 @@
+#ifndef OSMSCOUT_IMPORT_GENROUTEGRAPHDAT_H
+#define OSMSCOUT_IMPORT_GENROUTEGRAPHDAT_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/RouteGraph.h>
+
+#include <osmscout/system/Compiler.h>
+
+#include <osmscoutimport/Import.h>
+
+namespace osmscout {
+
+  /**
+   * Optional import module (see ImportParameter::SetRouterGraph()) converting
+   * the route node data file of each router into a RouteGraph.
+   */
+  class RouteGraphDataGenerator CLASS_FINAL : public ImportModule
+  {
+  private:
+    bool GenerateGraph(const TypeConfigRef& typeConfig,
+                       const ImportParameter& parameter,
+                       Progress& progress,
+                       const ImportParameter::Router& router) const;
+
+  public:
+    void GetDescription(const ImportParameter& parameter,
+                        ImportModuleDescription& description) const override;
+
+    bool Import(const TypeConfigRef& typeConfig,
+                const ImportParameter& parameter,
+                Progress& progress) override;
+  };
+}
+
+#endif
@@ -24,6 +24,8 @@
 #include <osmscoutimport/ImportImportExport.h>
 #include <osmscout/util/Transformation.h>
 
+#include <osmscout/io/CoordEncoding.h>
+
 #include <memory>
 
 namespace osmscout {
@@ -119,6 +121,8 @@ private:
   std::string                  boundingPolygonFile;      //<! Polygon file containing the bounding polygon of the current import
   bool                         eco;                      //<! Eco modus, deletes temporary files ASAP
   std::list<Router>            router;                   //<! Definition of router
+  bool                         routerCH;                 //<! Generate contraction hierarchies for the router
+  bool                         routerGraph;              //<! Generate compact routing graphs for the router
 
   bool                         strictAreas;              //<! Assure that areas conform to "simple" definition
 
@@ -152,6 +156,8 @@ private:
   bool                         wayDataMemoryMaped;       //<! Use memory mapping for way data file access
   size_t                       wayDataCacheSize;         //<! Size of the way data cache
 
+  CoordEncoding                coordEncoding;            //<! Encoding of the node arrays of ways and areas in the final data files
+
   size_t                       areaAreaIndexMaxMag;      //<! Maximum depth of the index generated
 
   MagnificationLevel           areaNodeGridMag;          //<! Magnification level for the index grid
@@ -211,6 +217,8 @@ public:
   bool   IsEco() const;
 
   const std::list<Router>& GetRouter() const;
+  bool GetRouterCH() const;
+  bool GetRouterGraph() const;
 
   bool GetStrictAreas() const;
 
@@ -245,6 +253,8 @@ public:
   bool GetWayDataMemoryMaped() const;
   size_t GetWayDataCacheSize() const;
 
+  CoordEncoding GetCoordEncoding() const;
+
   MagnificationLevel GetAreaNodeGridMag() const;
   uint16_t GetAreaNodeSimpleListLimit() const;
   uint16_t GetAreaNodeTileListLimit() const;
@@ -295,6 +305,8 @@ public:
 
   void ClearRouter();
   void AddRouter(const Router& router);
+  void SetRouterCH(bool routerCH);
+  void SetRouterGraph(bool routerGraph);
 
   void SetStrictAreas(bool strictAreas);
 
@@ -329,6 +341,8 @@ public:
   void SetWayDataMemoryMaped(bool memoryMaped);
   void SetWayDataCacheSize(size_t wayDataCacheSize);
 
+  void SetCoordEncoding(CoordEncoding coordEncoding);
+
   void SetAreaAreaIndexMaxMag(size_t areaAreaIndexMaxMag);
 
   void SetAreaNodeGridMag(MagnificationLevel areaNodeGridMag);
@@ -239,6 +239,7 @@ namespace osmscout {
 
       dataWriter.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                       dataFilename));
+      dataWriter.SetCoordEncoding(parameter.GetCoordEncoding());
 
       dataWriter.Write(overallDataCount);
 
@@ -432,6 +433,7 @@ namespace osmscout {
 
       dataWriter.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                       dataFilename));
+      dataWriter.SetCoordEncoding(parameter.GetCoordEncoding());
 
       dataWriter.Write(overallDataCount);
 
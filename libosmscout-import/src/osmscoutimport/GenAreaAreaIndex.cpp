@@ -933,6 +933,7 @@ namespace osmscout {
 
       dataWriter.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                       AreaDataFile::AREAS_DAT));
+      dataWriter.SetCoordEncoding(parameter.GetCoordEncoding());
 
       dataWriter.Write(overallDataCount);
 
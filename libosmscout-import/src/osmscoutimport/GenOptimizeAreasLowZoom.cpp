@@ -647,6 +647,7 @@ namespace osmscout
     try {
       writer.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                   OptimizeAreasLowZoom::FILE_AREASOPT_DAT));
+      writer.SetCoordEncoding(parameter.GetCoordEncoding());
 
       //
       // Write header
@@ -762,6 +762,7 @@ namespace osmscout
     try {
       writer.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
                                   OptimizeWaysLowZoom::FILE_WAYSOPT_DAT));
+      writer.SetCoordEncoding(parameter.GetCoordEncoding());
 
       //
       // Write header
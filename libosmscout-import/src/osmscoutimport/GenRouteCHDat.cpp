@@ -0,0 +1,524 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutimport/GenRouteCHDat.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#include <osmscout/db/ObjectVariantDataFile.h>
+
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/routing/RouteNode.h>
+
+namespace osmscout {
+
+  //! Maximum number of nodes settled by a single witness search
+  static const size_t maxWitnessSettledNodes=500;
+
+  static const std::array<Vehicle,3> vehicles={vehicleFoot,vehicleBicycle,vehicleCar};
+
+  /**
+   * Add an edge to the graph. If there already is an edge between the nodes,
+   * only the cheaper one is kept.
+   */
+  void RouteCHDataGenerator::Graph::AddEdge(uint32_t from,
+                                            uint32_t to,
+                                            uint32_t middle,
+                                            double cost,
+                                            const ObjectFileRef& object)
+  {
+    auto outEdge=std::find_if(outEdges[from].begin(),
+                              outEdges[from].end(),
+                              [to](const Edge& edge) {
+                                return edge.node==to;
+                              });
+
+    if (outEdge!=outEdges[from].end()) {
+      if (outEdge->cost<=cost) {
+        return;
+      }
+
+      auto inEdge=std::find_if(inEdges[to].begin(),
+                               inEdges[to].end(),
+                               [from](const Edge& edge) {
+                                 return edge.node==from;
+                               });
+
+      assert(inEdge!=inEdges[to].end());
+
+      *outEdge=Edge{to,middle,cost,object};
+      *inEdge=Edge{from,middle,cost,object};
+
+      return;
+    }
+
+    outEdges[from].push_back(Edge{to,middle,cost,object});
+    inEdges[to].push_back(Edge{from,middle,cost,object});
+  }
+
+  /**
+   * Remove all edges from and to the given node from the graph
+   */
+  void RouteCHDataGenerator::Graph::RemoveNode(uint32_t node)
+  {
+    for (const auto& edge : outEdges[node]) {
+      auto& edges=inEdges[edge.node];
+
+      edges.erase(std::remove_if(edges.begin(),
+                                 edges.end(),
+                                 [node](const Edge& e) {
+                                   return e.node==node;
+                                 }),
+                  edges.end());
+    }
+
+    for (const auto& edge : inEdges[node]) {
+      auto& edges=outEdges[edge.node];
+
+      edges.erase(std::remove_if(edges.begin(),
+                                 edges.end(),
+                                 [node](const Edge& e) {
+                                   return e.node==node;
+                                 }),
+                  edges.end());
+    }
+
+    outEdges[node].clear();
+    outEdges[node].shrink_to_fit();
+    inEdges[node].clear();
+    inEdges[node].shrink_to_fit();
+  }
+
+  RouteCHDataGenerator::WitnessSearch::WitnessSearch(size_t nodeCount)
+  : costs(nodeCount,std::numeric_limits<double>::infinity())
+  {
+    // no code
+  }
+
+  /**
+   * Bounded Dijkstra search from source not using ignoredNode. After the search
+   * GetCost() returns the cost of the cheapest path found to a node (or
+   * infinity). Costs above maxCost are not reliable.
+   */
+  void RouteCHDataGenerator::WitnessSearch::Search(const Graph& graph,
+                                                   uint32_t source,
+                                                   uint32_t ignoredNode,
+                                                   double maxCost)
+  {
+    for (uint32_t node : touched) {
+      costs[node]=std::numeric_limits<double>::infinity();
+    }
+
+    touched.clear();
+    queue=decltype(queue)();
+
+    costs[source]=0.0;
+    touched.push_back(source);
+    queue.emplace(0.0,source);
+
+    size_t settled=0;
+
+    while (!queue.empty()) {
+      auto [cost,node]=queue.top();
+      queue.pop();
+
+      if (cost>costs[node]) {
+        continue;
+      }
+
+      if (cost>maxCost ||
+          settled>=maxWitnessSettledNodes) {
+        break;
+      }
+
+      settled++;
+
+      for (const auto& edge : graph.outEdges[node]) {
+        if (edge.node==ignoredNode) {
+          continue;
+        }
+
+        double newCost=cost+edge.cost;
+
+        if (newCost<costs[edge.node]) {
+          if (costs[edge.node]==std::numeric_limits<double>::infinity()) {
+            touched.push_back(edge.node);
+          }
+
+          costs[edge.node]=newCost;
+          queue.emplace(newCost,edge.node);
+        }
+      }
+    }
+  }
+
+  void RouteCHDataGenerator::GetDescription(const ImportParameter& parameter,
+                                            ImportModuleDescription& description) const
+  {
+    description.SetName("RouteCHDataGenerator");
+    description.SetDescription("Generate contraction hierarchies of the routing graph(s)");
+
+    if (!parameter.GetRouterCH()) {
+      return;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      description.AddRequiredFile(router.GetDataFilename());
+      description.AddRequiredFile(router.GetVariantFilename());
+
+      for (Vehicle vehicle : vehicles) {
+        if ((router.GetVehicleMask() & vehicle)!=0) {
+          description.AddProvidedFile(ContractionHierarchy::GetFilename(router.GetFilenamebase(),
+                                                                        vehicle));
+        }
+      }
+    }
+  }
+
+  /**
+   * Load the routing graph of the router for the given vehicle. Only paths
+   * usable by the vehicle without access restriction are added.
+   */
+  bool RouteCHDataGenerator::LoadGraph(const TypeConfigRef& typeConfig,
+                                       const ImportParameter& parameter,
+                                       Progress& progress,
+                                       const ImportParameter::Router& router,
+                                       Vehicle vehicle,
+                                       std::vector<Id>& nodeIds,
+                                       Graph& graph) const
+  {
+    ObjectVariantDataFile objectVariantDataFile;
+
+    if (!objectVariantDataFile.Load(*typeConfig,
+                                    AppendFileToDir(parameter.GetDestinationDirectory(),
+                                                    router.GetVariantFilename()))) {
+      progress.Error("Cannot open '"+router.GetVariantFilename()+"'");
+      return false;
+    }
+
+    const std::vector<ObjectVariantData>& objectVariantData=objectVariantDataFile.GetData();
+    FastestPathRoutingProfileRef          profile=ContractionHierarchy::CreateProfile(typeConfig,
+                                                                                      vehicle);
+    FileScanner                           scanner;
+
+    try {
+      scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                   router.GetDataFilename()),
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.ReadFileOffset(); // index offset
+      uint32_t nodeCount=scanner.ReadUInt32();
+      scanner.ReadUInt32(); // tile magnification
+
+      FileOffset nodesOffset=scanner.GetPos();
+
+      nodeIds.clear();
+      nodeIds.reserve(nodeCount);
+
+      for (uint32_t n=1; n<=nodeCount; n++) {
+        progress.SetProgress(n,nodeCount*2);
+
+        RouteNode node;
+
+        node.Read(*typeConfig,
+                  scanner);
+
+        nodeIds.push_back(node.GetId());
+      }
+
+      std::sort(nodeIds.begin(),nodeIds.end());
+
+      graph.outEdges.assign(nodeIds.size(),{});
+      graph.inEdges.assign(nodeIds.size(),{});
+
+      scanner.SetPos(nodesOffset);
+
+      size_t edgeCount=0;
+
+      for (uint32_t n=1; n<=nodeCount; n++) {
+        progress.SetProgress(nodeCount+n,nodeCount*2);
+
+        RouteNode node;
+
+        node.Read(*typeConfig,
+                  scanner);
+
+        auto from=static_cast<uint32_t>(std::lower_bound(nodeIds.begin(),
+                                                         nodeIds.end(),
+                                                         node.GetId())-nodeIds.begin());
+
+        for (size_t i=0; i<node.paths.size(); i++) {
+          const RouteNode::Path& path=node.paths[i];
+
+          if (!path.IsUsable(vehicle) ||
+              path.IsRestricted(vehicle) ||
+              !profile->CanUse(node,objectVariantData,i)) {
+            continue;
+          }
+
+          auto target=std::lower_bound(nodeIds.begin(),
+                                       nodeIds.end(),
+                                       path.id);
+
+          if (target==nodeIds.end() ||
+              *target!=path.id) {
+            continue;
+          }
+
+          auto   to=static_cast<uint32_t>(target-nodeIds.begin());
+          double cost=profile->GetCosts(node,objectVariantData,i,i);
+
+          if (from==to ||
+              !std::isfinite(cost)) {
+            continue;
+          }
+
+          graph.AddEdge(from,
+                        to,
+                        ContractionHierarchy::noNode,
+                        cost,
+                        node.objects[path.objectIndex].object);
+          edgeCount++;
+        }
+      }
+
+      scanner.Close();
+
+      progress.Info("Loaded "+std::to_string(nodeIds.size())+" node(s) and "+
+                    std::to_string(edgeCount)+" usable path(s)");
+    }
+    catch (IOException& e) {
+      progress.Error(e.GetDescription());
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Return the shortcuts required when contracting the given node
+   */
+  void RouteCHDataGenerator::GetShortcuts(const Graph& graph,
+                                          WitnessSearch& witnessSearch,
+                                          uint32_t node,
+                                          std::vector<Shortcut>& shortcuts) const
+  {
+    shortcuts.clear();
+
+    if (graph.inEdges[node].empty() ||
+        graph.outEdges[node].empty()) {
+      return;
+    }
+
+    double maxOutCost=0.0;
+
+    for (const auto& outEdge : graph.outEdges[node]) {
+      maxOutCost=std::max(maxOutCost,outEdge.cost);
+    }
+
+    for (const auto& inEdge : graph.inEdges[node]) {
+      witnessSearch.Search(graph,
+                           inEdge.node,
+                           node,
+                           inEdge.cost+maxOutCost);
+
+      for (const auto& outEdge : graph.outEdges[node]) {
+        if (outEdge.node==inEdge.node) {
+          continue;
+        }
+
+        double cost=inEdge.cost+outEdge.cost;
+
+        if (witnessSearch.GetCost(outEdge.node)>cost) {
+          shortcuts.push_back(Shortcut{inEdge.node,outEdge.node,cost});
+        }
+      }
+    }
+  }
+
+  /**
+   * Contract all nodes of the graph (leaving the graph empty) and return
+   * the resulting hierarchy
+   */
+  ContractionHierarchy RouteCHDataGenerator::Contract(Progress& progress,
+                                                      Vehicle vehicle,
+                                                      const std::vector<Id>& nodeIds,
+                                                      Graph& graph) const
+  {
+    using QueueEntry = std::pair<int64_t,uint32_t>;
+
+    using CHEdges = std::vector<std::vector<ContractionHierarchy::Edge>>;
+
+    auto                  nodeCount=static_cast<uint32_t>(nodeIds.size());
+    WitnessSearch         witnessSearch(nodeCount);
+    std::vector<Shortcut> shortcuts;
+    std::vector<uint32_t> contractedNeighbours(nodeCount,0);
+    std::vector<bool>     contracted(nodeCount,false);
+    CHEdges               forwardEdges(nodeCount);
+    CHEdges               backwardEdges(nodeCount);
+    size_t                shortcutCount=0;
+    std::priority_queue<QueueEntry,std::vector<QueueEntry>,std::greater<>> queue;
+
+    auto priority=[&](uint32_t node) {
+      GetShortcuts(graph,
+                   witnessSearch,
+                   node,
+                   shortcuts);
+
+      return static_cast<int64_t>(shortcuts.size())-
+             static_cast<int64_t>(graph.inEdges[node].size()+graph.outEdges[node].size())+
+             static_cast<int64_t>(contractedNeighbours[node]);
+    };
+
+    progress.Info("Calculating initial node order");
+
+    for (uint32_t node=0; node<nodeCount; node++) {
+      progress.SetProgress(node,nodeCount);
+      queue.emplace(priority(node),node);
+    }
+
+    progress.Info("Contracting nodes");
+
+    uint32_t contractedCount=0;
+
+    while (!queue.empty()) {
+      uint32_t node=queue.top().second;
+      queue.pop();
+
+      if (contracted[node]) {
+        continue;
+      }
+
+      // Lazy update: the priority may have changed since the node was queued
+      int64_t currentPriority=priority(node);
+
+      if (!queue.empty() &&
+          currentPriority>queue.top().first) {
+        queue.emplace(currentPriority,node);
+        continue;
+      }
+
+      progress.SetProgress(contractedCount,nodeCount);
+
+      for (const auto& edge : graph.outEdges[node]) {
+        ContractionHierarchy::Edge chEdge;
+
+        chEdge.target=edge.node;
+        chEdge.middle=edge.middle;
+        chEdge.cost=edge.cost;
+        chEdge.object=edge.object;
+
+        forwardEdges[node].push_back(chEdge);
+        contractedNeighbours[edge.node]++;
+      }
+
+      for (const auto& edge : graph.inEdges[node]) {
+        ContractionHierarchy::Edge chEdge;
+
+        chEdge.target=edge.node;
+        chEdge.middle=edge.middle;
+        chEdge.cost=edge.cost;
+        chEdge.object=edge.object;
+
+        backwardEdges[node].push_back(chEdge);
+        contractedNeighbours[edge.node]++;
+      }
+
+      // priority() has left the shortcuts of the current node in 'shortcuts'
+      graph.RemoveNode(node);
+
+      for (const auto& shortcut : shortcuts) {
+        graph.AddEdge(shortcut.from,
+                      shortcut.to,
+                      node,
+                      shortcut.cost,
+                      ObjectFileRef());
+      }
+
+      shortcutCount+=shortcuts.size();
+      contracted[node]=true;
+      contractedCount++;
+    }
+
+    progress.Info("Contracted "+std::to_string(contractedCount)+" node(s), added "+
+                  std::to_string(shortcutCount)+" shortcut(s)");
+
+    return ContractionHierarchy(vehicle,
+                                nodeIds,
+                                forwardEdges,
+                                backwardEdges);
+  }
+
+  bool RouteCHDataGenerator::Import(const TypeConfigRef& typeConfig,
+                                    const ImportParameter& parameter,
+                                    Progress& progress)
+  {
+    if (!parameter.GetRouterCH()) {
+      progress.Info("Generation of contraction hierarchies is disabled");
+      return true;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      for (Vehicle vehicle : vehicles) {
+        if ((router.GetVehicleMask() & vehicle)==0) {
+          continue;
+        }
+
+        std::string filename=ContractionHierarchy::GetFilename(router.GetFilenamebase(),
+                                                               vehicle);
+
+        progress.SetAction("Generate "+filename);
+
+        std::vector<Id> nodeIds;
+        Graph           graph;
+
+        if (!LoadGraph(typeConfig,
+                       parameter,
+                       progress,
+                       router,
+                       vehicle,
+                       nodeIds,
+                       graph)) {
+          return false;
+        }
+
+        ContractionHierarchy hierarchy=Contract(progress,
+                                                vehicle,
+                                                nodeIds,
+                                                graph);
+
+        if (!hierarchy.Store(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                             filename))) {
+          progress.Error("Cannot write '"+filename+"'");
+          return false;
+        }
+
+        progress.Info("Written "+std::to_string(hierarchy.GetEdgeCount())+" edge(s)");
+      }
+    }
+
+    return true;
+  }
+}
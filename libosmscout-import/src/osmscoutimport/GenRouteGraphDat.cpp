@@ -0,0 +1,220 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutimport/GenRouteGraphDat.h>
+
+#include <algorithm>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/routing/RouteNode.h>
+
+namespace osmscout {
+
+  void RouteGraphDataGenerator::GetDescription(const ImportParameter& parameter,
+                                               ImportModuleDescription& description) const
+  {
+    description.SetName("RouteGraphDataGenerator");
+    description.SetDescription("Generate compact routing graph(s)");
+
+    if (!parameter.GetRouterGraph()) {
+      return;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      description.AddRequiredFile(router.GetDataFilename());
+      description.AddProvidedFile(RouteGraph::GetFilename(router.GetFilenamebase()));
+    }
+  }
+
+  /**
+   * Read the route nodes of the router and store them as RouteGraph. The nodes
+   * are numbered in the order of the hash of their coordinates (z-order), the
+   * paths of each node keep their order.
+   */
+  bool RouteGraphDataGenerator::GenerateGraph(const TypeConfigRef& typeConfig,
+                                              const ImportParameter& parameter,
+                                              Progress& progress,
+                                              const ImportParameter::Router& router) const
+  {
+    std::vector<RouteGraph::Node> nodes;
+    std::vector<uint32_t>         firstEdges;
+    std::vector<RouteGraph::Edge> edges;
+    FileScanner                   scanner;
+
+    try {
+      scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                   router.GetDataFilename()),
+                   FileScanner::Sequential,
+                   true);
+
+      scanner.ReadFileOffset(); // index offset
+      uint32_t nodeCount=scanner.ReadUInt32();
+      scanner.ReadUInt32(); // tile magnification
+
+      FileOffset nodesOffset=scanner.GetPos();
+
+      nodes.reserve(nodeCount);
+
+      for (uint32_t n=1; n<=nodeCount; n++) {
+        progress.SetProgress(n,nodeCount*2);
+
+        RouteNode node;
+
+        node.Read(*typeConfig,
+                  scanner);
+
+        nodes.push_back(RouteGraph::Node{node.GetId(),node.GetCoord()});
+      }
+
+      std::sort(nodes.begin(),
+                nodes.end(),
+                [](const RouteGraph::Node& a, const RouteGraph::Node& b) {
+                  Id aHash=a.coord.GetHash();
+                  Id bHash=b.coord.GetHash();
+
+                  return aHash<bHash || (aHash==bHash && a.id<b.id);
+                });
+
+      // Index of each node id in the z-order
+      std::vector<std::pair<Id,uint32_t>> nodeIndexes;
+
+      nodeIndexes.reserve(nodes.size());
+
+      for (uint32_t node=0; node<nodes.size(); node++) {
+        nodeIndexes.emplace_back(nodes[node].id,node);
+      }
+
+      std::sort(nodeIndexes.begin(),nodeIndexes.end());
+
+      auto GetNodeIndex=[&nodeIndexes](Id id) {
+        auto entry=std::lower_bound(nodeIndexes.begin(),
+                                    nodeIndexes.end(),
+                                    std::make_pair(id,static_cast<uint32_t>(0)));
+
+        if (entry==nodeIndexes.end() ||
+            entry->first!=id) {
+          return RouteGraph::noNode;
+        }
+
+        return entry->second;
+      };
+
+      // The nodes in the file are not in z-order, collect the edges and sort them by node afterwards
+      std::vector<uint32_t> edgeNodes;
+
+      scanner.SetPos(nodesOffset);
+
+      for (uint32_t n=1; n<=nodeCount; n++) {
+        progress.SetProgress(nodeCount+n,nodeCount*2);
+
+        RouteNode node;
+
+        node.Read(*typeConfig,
+                  scanner);
+
+        uint32_t from=GetNodeIndex(node.GetId());
+
+        for (const auto& path : node.paths) {
+          uint32_t to=GetNodeIndex(path.id);
+
+          if (to==RouteGraph::noNode) {
+            continue;
+          }
+
+          const RouteNode::ObjectData& object=node.objects[path.objectIndex];
+
+          edgeNodes.push_back(from);
+          edges.push_back(RouteGraph::Edge{to,
+                                           path.distance,
+                                           object.objectVariantIndex,
+                                           path.flags,
+                                           object.object});
+        }
+      }
+
+      scanner.Close();
+
+      // Stable counting sort of the edges by node
+      firstEdges.assign(nodes.size()+1,0);
+
+      for (uint32_t node : edgeNodes) {
+        firstEdges[node+1]++;
+      }
+
+      for (size_t node=1; node<firstEdges.size(); node++) {
+        firstEdges[node]+=firstEdges[node-1];
+      }
+
+      std::vector<uint32_t>         nextEdges(firstEdges.begin(),firstEdges.end()-1);
+      std::vector<RouteGraph::Edge> sortedEdges(edges.size());
+
+      for (size_t edge=0; edge<edges.size(); edge++) {
+        sortedEdges[nextEdges[edgeNodes[edge]]++]=edges[edge];
+      }
+
+      edges.swap(sortedEdges);
+    }
+    catch (IOException& e) {
+      progress.Error(e.GetDescription());
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    std::string filename=RouteGraph::GetFilename(router.GetFilenamebase());
+
+    if (!RouteGraph::Store(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                           filename),
+                           nodes,
+                           firstEdges,
+                           edges)) {
+      progress.Error("Cannot write '"+filename+"'");
+      return false;
+    }
+
+    progress.Info("Written "+std::to_string(nodes.size())+" node(s) and "+
+                  std::to_string(edges.size())+" path(s)");
+
+    return true;
+  }
+
+  bool RouteGraphDataGenerator::Import(const TypeConfigRef& typeConfig,
+                                       const ImportParameter& parameter,
+                                       Progress& progress)
+  {
+    if (!parameter.GetRouterGraph()) {
+      progress.Info("Generation of routing graphs is disabled");
+      return true;
+    }
+
+    for (const auto& router : parameter.GetRouter()) {
+      progress.SetAction("Generate "+RouteGraph::GetFilename(router.GetFilenamebase()));
+
+      if (!GenerateGraph(typeConfig,
+                         parameter,
+                         progress,
+                         router)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
@@ -66,6 +66,8 @@
 
 // Routing
 #include <osmscoutimport/GenRouteDat.h>
+#include <osmscoutimport/GenRouteCHDat.h>
+#include <osmscoutimport/GenRouteGraphDat.h>
 #include <osmscoutimport/GenIntersectionIndex.h>
 
 // Public Transport
@@ -217,19 +219,25 @@ namespace osmscout {
     modules.push_back(std::make_shared<RouteDataGenerator>());
 
     /* 24 */
-    modules.push_back(std::make_shared<IntersectionIndexGenerator>());
+    modules.push_back(std::make_shared<RouteCHDataGenerator>());
 
     /* 25 */
-    modules.push_back(std::make_shared<PTRouteDataGenerator>());
+    modules.push_back(std::make_shared<RouteGraphDataGenerator>());
 
     /* 26 */
-    modules.push_back(std::make_shared<RouteDataGenerator2>());
+    modules.push_back(std::make_shared<IntersectionIndexGenerator>());
 
     /* 27 */
+    modules.push_back(std::make_shared<PTRouteDataGenerator>());
+
+    /* 28 */
+    modules.push_back(std::make_shared<RouteDataGenerator2>());
+
+    /* 29 */
     modules.push_back(std::make_shared<AreaRouteIndexGenerator>());
 
 #if defined(OSMSCOUT_IMPORT_HAVE_LIB_MARISA)
-    /* 28 */
+    /* 30 */
     modules.push_back(std::make_shared<TextIndexGenerator>());
 #endif
 
@@ -28,9 +28,9 @@ namespace osmscout {
 
 static const size_t defaultStartStep=1;
 #if defined(OSMSCOUT_IMPORT_HAVE_LIB_MARISA)
-static const size_t defaultEndStep=28;
+static const size_t defaultEndStep=30;
 #else
-static const size_t defaultEndStep=27;
+static const size_t defaultEndStep=29;
 #endif
 
 size_t ImportParameter::GetDefaultStartStep()
@@ -57,6 +57,8 @@ ImportParameter::ImportParameter()
       startStep(defaultStartStep),
       endStep(defaultEndStep),
       eco(false),
+      routerCH(false),
+      routerGraph(false),
       strictAreas(false),
       sortObjects(true),
       sortBlockSize(40000000),
@@ -78,6 +80,7 @@ ImportParameter::ImportParameter()
       areaDataCacheSize(0),
       wayDataMemoryMaped(false),
       wayDataCacheSize(0),
+      coordEncoding(CoordEncoding::fixedWidth),
       areaAreaIndexMaxMag(17),
       areaNodeGridMag(14),
       areaNodeSimpleListLimit(500),
@@ -159,6 +162,16 @@ const std::list<ImportParameter::Router>& ImportParameter::GetRouter() const
   return router;
 }
 
+bool ImportParameter::GetRouterCH() const
+{
+  return routerCH;
+}
+
+bool ImportParameter::GetRouterGraph() const
+{
+  return routerGraph;
+}
+
 bool ImportParameter::GetStrictAreas() const
 {
   return strictAreas;
@@ -259,6 +272,11 @@ size_t ImportParameter::GetWayDataCacheSize() const
   return wayDataCacheSize;
 }
 
+CoordEncoding ImportParameter::GetCoordEncoding() const
+{
+  return coordEncoding;
+}
+
 bool ImportParameter::GetWayDataMemoryMaped() const
 {
   return wayDataMemoryMaped;
@@ -446,6 +464,16 @@ void ImportParameter::AddRouter(const Router& router)
   this->router.push_back(router);
 }
 
+void ImportParameter::SetRouterCH(bool routerCH)
+{
+  this->routerCH=routerCH;
+}
+
+void ImportParameter::SetRouterGraph(bool routerGraph)
+{
+  this->routerGraph=routerGraph;
+}
+
 void ImportParameter::SetStrictAreas(bool strictAreas)
 {
   this->strictAreas=strictAreas;
@@ -551,6 +579,11 @@ void ImportParameter::SetWayDataCacheSize(size_t wayDataCacheSize)
   this->wayDataCacheSize=wayDataCacheSize;
 }
 
+void ImportParameter::SetCoordEncoding(CoordEncoding coordEncoding)
+{
+  this->coordEncoding=coordEncoding;
+}
+
 void ImportParameter::SetAreaAreaIndexMaxMag(size_t areaAreaIndexMaxMag)
 {
   this->areaAreaIndexMaxMag=areaAreaIndexMaxMag;
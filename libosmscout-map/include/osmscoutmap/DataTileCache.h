@@ -20,7 +20,9 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <atomic>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -37,6 +39,7 @@
 
 #include <osmscout/util/GeoBox.h>
 #include <osmscout/util/Magnification.h>
+#include <osmscout/util/MemoryBudget.h>
 #include <osmscout/util/TileId.h>
 
 #include <osmscout/system/Assert.h>
@@ -221,6 +224,17 @@ namespace osmscout {
       return prefillData.size()+data.size();
     }
 
+    /**
+     * Return the heap memory of the references to the data in bytes. The memory of the
+     * referenced objects itself is not included, since it is shared with the data file caches.
+     */
+    size_t GetMemorySize() const
+    {
+      std::scoped_lock<std::mutex> guard(mutex);
+
+      return (prefillData.capacity()+data.capacity())*sizeof(O);
+    }
+
     void CopyData(std::function<void(const O&)> function) const
     {
       std::scoped_lock<std::mutex> guard(mutex);
@@ -421,6 +435,20 @@ namespace osmscout {
              optimizedAreaData.IsComplete();
     }
 
+    /**
+     * Return the (estimated) memory of the tile in bytes
+     */
+    size_t GetMemorySize() const
+    {
+      return sizeof(Tile)+
+             nodeData.GetMemorySize()+
+             wayData.GetMemorySize()+
+             areaData.GetMemorySize()+
+             routeData.GetMemorySize()+
+             optimizedWayData.GetMemorySize()+
+             optimizedAreaData.GetMemorySize();
+    }
+
     /**
      * Return 'true' if no data for any type has been assigned
      */
@@ -452,6 +480,11 @@ namespace osmscout {
    *
    * The cache will free least recently used tiles first,
    *
+   * Optionally the cache can draw from a MemoryBudget shared with the other caches
+   * (see SetMemoryBudget()). Since the cache is not thread-safe, the budget cannot
+   * evict tiles itself. The memory of the tiles is charged and - as long as the budget is exceeded
+   * and the cache holds the least recently accessed entries of all consumers - unused tiles
+   * are evicted during CleanupCache().
    */
   class OSMSCOUT_MAP_API DataTileCache
   {
@@ -461,9 +494,11 @@ namespace osmscout {
      */
     struct OSMSCOUT_MAP_API CacheEntry
     {
-      TileKey key;
+      TileKey  key;
       //TileWeakRef tile;
-      TileRef tile;
+      TileRef  tile;
+      size_t   memory=0;     //!< Memory charged to the budget
+      uint64_t lastAccess=0; //!< Access tick of the budget
 
       CacheEntry(const TileKey& key,
                  const TileRef /*TileWeakRef*/& tile)
@@ -483,11 +518,38 @@ namespace osmscout {
     //! An index from TileIds to cache entries
     using CacheIndex = std::map<TileKey, CacheRef>;
 
+    /**
+     * Budget consumer of the cache. Accessed by the budget from other threads,
+     * so it just holds a thread-safe copy of the state of the cache.
+     */
+    class BudgetConsumer : public MemoryBudget::Consumer
+    {
+    public:
+      std::atomic<uint64_t> oldestAccess{MemoryBudget::NoAccess};
+      std::atomic<size_t>   entries{0};
+      std::atomic<size_t>   memory{0};
+      std::atomic<size_t>   hits{0};
+      std::atomic<size_t>   misses{0};
+      std::atomic<size_t>   evictions{0};
+
+    public:
+      uint64_t GetOldestAccess() const override;
+      size_t Evict(size_t bytes,
+                   uint64_t newerThan) override;
+      MemoryBudget::Statistics GetStatistics() const override;
+    };
+
   private:
-    size_t             cacheSize;
+    size_t                 cacheSize;
 
-    mutable CacheIndex tileIndex;
-    mutable Cache      tileCache;
+    mutable CacheIndex     tileIndex;
+    mutable Cache          tileCache;
+
+    MemoryBudgetRef        budget;         //!< Optional memory budget
+    mutable BudgetConsumer budgetConsumer; //!< Consumer of the budget
+
+    void Touch(CacheEntry& entry) const;
+    void UpdateBudget();
 
     void ResolveNodesFromParent(Tile& tile,
                                 const Tile& parentTile,
@@ -509,8 +571,23 @@ namespace osmscout {
   public:
     explicit DataTileCache(size_t cacheSize);
 
+    // disable copy and move
+    DataTileCache(const DataTileCache&) = delete;
+    DataTileCache(DataTileCache&&) = delete;
+    DataTileCache& operator=(const DataTileCache&) = delete;
+    DataTileCache& operator=(DataTileCache&&) = delete;
+
+    ~DataTileCache();
+
     void SetSize(size_t cacheSize);
 
+    void SetMemoryBudget(const MemoryBudgetRef& budget);
+
+    MemoryBudgetRef GetMemoryBudget() const
+    {
+      return budget;
+    }
+
      size_t GetSize() const
     {
       return cacheSize;
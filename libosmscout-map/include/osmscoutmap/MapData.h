@@ -28,6 +28,7 @@
 #include <osmscout/Node.h>
 #include <osmscout/Area.h>
 #include <osmscout/Way.h>
+#include <osmscout/WayView.h>
 #include <osmscout/Route.h>
 
 #include <osmscout/GroundTile.h>
@@ -48,6 +49,7 @@ namespace osmscout {
     std::vector<NodeRef>  nodes;        //!< Nodes as retrieved from db
     std::vector<AreaRef>  areas;        //!< Areas as retrieved from db
     std::vector<WayRef>   ways;         //!< Ways as retrieved from db
+    std::vector<WayView>  wayViews;     //!< Ways as views into the db (see MapService::LoadWayViews())
     std::vector<RouteRef> routes;       //!< Routes as retrieved from db
     std::list<NodeRef>    poiNodes;     //!< List of manually added nodes (not managed or changed by the db)
     std::list<AreaRef>    poiAreas;     //!< List of manually added areas (not managed or changed by the db)
@@ -20,7 +20,9 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <functional>
 #include <list>
+#include <memory>
 #include <string>
 #include <optional>
 
@@ -40,6 +42,7 @@
 #include <osmscout/Node.h>
 #include <osmscout/Area.h>
 #include <osmscout/Way.h>
+#include <osmscout/WayView.h>
 
 #include <osmscoutmap/StyleConfig.h>
 
@@ -204,6 +207,31 @@ namespace osmscout {
       double            symbolScale;  //!< Potential magnification of the symbol
     };
 
+  private:
+    /**
+     * Buffers and results of the preprocessing of a part of the map data by
+     * one thread, see Preprocess()
+     */
+    struct PreprocessingBuffer
+    {
+      TransBuffer*              transBuffer=nullptr;
+      CoordBuffer*              coordBuffer=nullptr;
+      std::vector<LineStyleRef> lineStyles;  //!< Temporary storage for StyleConfig return value
+      std::list<WayData>        wayData;
+      std::list<WayPathData>    wayPathData;
+      std::list<AreaData>       areaData;
+    };
+
+    /**
+     * Coordinate buffers of a worker thread of the preprocessing, kept between
+     * render actions to reuse their memory
+     */
+    struct PreprocessingWorker
+    {
+      TransBuffer transBuffer;
+      CoordBuffer coordBuffer;
+    };
+
   protected:
     /**
      Internal coordinate transformation data structures
@@ -234,6 +262,8 @@ namespace osmscout {
     std::list<WayPathData>       wayPathData;
     std::list<RouteLabelData>    routeLabelData;
 
+    std::vector<std::unique_ptr<PreprocessingWorker>> preprocessingWorkers; //!< Buffers of the preprocessing worker threads
+
     std::vector<TextStyleRef>    textStyles;         //!< Temporary storage for StyleConfig return value
     std::vector<LineStyleRef>    lineStyles;         //!< Temporary storage for StyleConfig return value
     std::vector<PathSymbolStyleRef> symbolStyles;    //!< Temporary storage for StyleConfig return value
@@ -295,6 +325,13 @@ namespace osmscout {
     void TransformPathData(const Projection& projection,
                            const MapParameter& parameter,
                            const Way& way,
+                           PreprocessingBuffer& buffer,
+                           WayPathData &pathData);
+
+    void TransformPathData(const Projection& projection,
+                           const MapParameter& parameter,
+                           const WayView& way,
+                           PreprocessingBuffer& buffer,
                            WayPathData &pathData);
 
     double CalculateLineWith(const Projection& projection,
@@ -310,10 +347,12 @@ namespace osmscout {
 
     int8_t CalculateLineLayer(const FeatureValueBuffer& buffer) const;
 
+    template<typename W>
     void CalculateWayPaths(const StyleConfig& styleConfig,
                            const Projection& projection,
                            const MapParameter& parameter,
-                           const Way& way);
+                           const W& way,
+                           PreprocessingBuffer& buffer);
 
     bool PrepareAreaRing(const StyleConfig& styleConfig,
                          const Projection& projection,
@@ -322,12 +361,20 @@ namespace osmscout {
                          const Area& area,
                          const Area::Ring& ring,
                          size_t i,
-                         const TypeInfoRef& type);
+                         const TypeInfoRef& type,
+                         PreprocessingBuffer& buffer);
 
     void PrepareArea(const StyleConfig& styleConfig,
                      const Projection& projection,
                      const MapParameter& parameter,
-                     const AreaRef &area);
+                     const AreaRef &area,
+                     PreprocessingBuffer& buffer);
+
+    void Preprocess(const MapParameter& parameter,
+                    size_t objectCount,
+                    const std::function<void(size_t,PreprocessingBuffer&)>& process);
+
+    void MergePreprocessingBuffer(PreprocessingBuffer& buffer);
 
     void PrepareAreaLabel(const StyleConfig& styleConfig,
                           const Projection& projection,
@@ -340,6 +387,12 @@ namespace osmscout {
                                const std::string_view& text,
                                const std::vector<Point>& nodes);
 
+    void RegisterPointWayLabel(const Projection& projection,
+                               const MapParameter& parameter,
+                               const PathShieldStyleRef& style,
+                               const std::string_view& text,
+                               const CoordArrayView& nodes);
+
     void LayoutPointLabels(const Projection& projection,
                            const MapParameter& parameter,
                            const ObjectFileRef& ref,
@@ -354,10 +407,11 @@ namespace osmscout {
                            const MapParameter& parameter,
                            const WayPathData& data);
 
+    template<typename W>
     bool CalculateWayShieldLabels(const StyleConfig& styleConfig,
                                   const Projection& projection,
                                   const MapParameter& parameter,
-                                  const Way& way);
+                                  const W& way);
 
     bool DrawWayContourLabel(const StyleConfig& styleConfig,
                              const Projection& projection,
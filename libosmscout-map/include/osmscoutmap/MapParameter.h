@@ -109,6 +109,8 @@ namespace osmscout {
     bool                                renderContourLines;        //!< Render ContourLines
     bool                                renderHillShading;         //!< Render hill shades
 
+    size_t                              preprocessingThreadCount;  //!< Number of worker threads of the preprocessing render steps (default 1, 0 for one per core)
+
     bool                                debugData;                 //!< Print out some performance relevant information about the data
     bool                                debugPerformance;          //!< Print out some performance information
 
@@ -178,6 +180,8 @@ namespace osmscout {
     void SetRenderContourLines(bool render);
     void SetRenderHillShading(bool render);
 
+    void SetPreprocessingThreadCount(size_t threadCount);
+
     void SetDebugData(bool debug);
     void SetDebugPerformance(bool debug);
 
@@ -381,6 +385,11 @@ namespace osmscout {
       return renderHillShading;
     }
 
+    size_t GetPreprocessingThreadCount() const
+    {
+      return preprocessingThreadCount;
+    }
+
     bool IsDebugPerformance() const
     {
       return debugPerformance;
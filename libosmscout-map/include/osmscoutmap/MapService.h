@@ -380,6 +380,11 @@ namespace osmscout {
                               const TypeDefinition& typeDefinition,
                               MapData& data) const;
 
+    bool LoadWayViews(const AreaSearchParameter& parameter,
+                      const TypeInfoSet& wayTypes,
+                      const GeoBox& boundingBox,
+                      MapData& data) const;
+
     bool GetGroundTiles(const Projection& projection,
                         std::list<GroundTile>& tiles) const;
 
@@ -20,9 +20,13 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <atomic>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -87,6 +91,10 @@ namespace osmscout {
       return featureReaders[featureIndex].GetValue(buffer);
     }
 
+    bool GetFeatureIndex(size_t featureIndex,
+                         const TypeInfo& type,
+                         size_t& index) const;
+
     bool IsOneway(const FeatureValueBuffer& buffer) const;
   };
 
@@ -338,17 +346,101 @@ namespace osmscout {
              sizeCondition;
     }
 
+    const std::list<FeatureFilterData>& GetFeatures() const
+    {
+      return features;
+    }
+
      bool GetOneway() const
     {
       return oneway;
     }
 
+    const SizeConditionRef& GetSizeCondition() const
+    {
+      return sizeCondition;
+    }
+
     bool Matches(const StyleResolveContext& context,
                  const FeatureValueBuffer& buffer,
                  double meterInPixel,
                  double meterInMM) const;
   };
 
+  /**
+   * \ingroup Stylesheet
+   *
+   * The criteria of the style selectors of one type and magnification level,
+   * compiled into a flat decision table.
+   *
+   * Each distinct condition of the selectors (feature set, feature flag set,
+   * oneway, size condition) is evaluated only once per object. The results form a
+   * bit mask of fulfilled conditions. A selector matches, if all conditions of
+   * its condition mask are fulfilled. Selectors requiring a feature the type does not
+   * have are removed at compile time. Zoom level ranges are already resolved by the
+   * lookup table the selectors are stored in.
+   */
+  class OSMSCOUT_MAP_API StyleDecisionTable CLASS_FINAL
+  {
+  public:
+    //! Maximum number of selectors and of distinct conditions of a table
+    static constexpr size_t maxEntries=64;
+
+  private:
+    enum class ConditionType : uint8_t
+    {
+      feature,     //!< The feature is set
+      featureFlag, //!< The feature is set and has the given flag set
+      oneway,      //!< The object is oneway
+      size         //!< The size condition is fulfilled
+    };
+
+    struct Condition
+    {
+      ConditionType        type;
+      size_t               featureIndex=0;          //!< Index of the feature in the features of the type
+      size_t               flagIndex=0;             //!< Index of the flag for featureFlag
+      const SizeCondition* sizeCondition=nullptr;   //!< The condition for size
+
+      bool operator==(const Condition& other) const
+      {
+        return type==other.type &&
+               featureIndex==other.featureIndex &&
+               flagIndex==other.flagIndex &&
+               sizeCondition==other.sizeCondition;
+      }
+    };
+
+  private:
+    size_t                 typeIndex=std::numeric_limits<size_t>::max(); //!< Type the table has been compiled for
+    std::vector<Condition> conditions;
+    std::vector<uint64_t>  selectorMasks;       //!< The conditions required by each selector
+    uint64_t               possibleSelectors=0; //!< Selectors which can match objects of the type at all
+
+  public:
+    bool Compile(const StyleResolveContext& context,
+                 const TypeInfo& type,
+                 const std::vector<const StyleCriteria*>& criteria);
+
+    /**
+     * Returns true, if the table is compiled for the type of the given object
+     */
+    bool CanEvaluate(const FeatureValueBuffer& buffer) const
+    {
+      return buffer.GetTypeIndex()==typeIndex;
+    }
+
+    size_t GetConditionCount() const
+    {
+      return conditions.size();
+    }
+
+    uint64_t Evaluate(const StyleResolveContext& context,
+                      const FeatureValueBuffer& buffer,
+                      double meterInPixel,
+                      double meterInMM) const;
+  };
+
   struct PartialStyleBase
   {
     virtual ~PartialStyleBase() = default;
@@ -484,59 +576,183 @@ namespace osmscout {
     }
   };
 
+  /**
+   * \ingroup Stylesheet
+   *
+   * The style selectors of one type and magnification level together with their
+   * compiled criteria
+   */
+  template<class S, class A>
+  struct StyleSelectorTable
+  {
+    std::list<StyleSelector<S,A>> selectors;
+    StyleDecisionTable            decisionTable;
+  };
+
   using LinePartialStyle = PartialStyle<LineStyle,LineStyle::Attribute>;
   using LineConditionalStyle = ConditionalStyle<LineStyle,LineStyle::Attribute>;
   using LineStyleSelector = StyleSelector<LineStyle,LineStyle::Attribute>;
   using LineStyleSelectorList = std::list<LineStyleSelector>; //! List of selectors
-  using LineStyleLookupTable = std::vector<std::vector<LineStyleSelectorList> >;  //!Index selectors by type and level
+  using LineStyleLookupTable = std::vector<std::vector<StyleSelectorTable<LineStyle,LineStyle::Attribute> > >;  //!Index selectors by type and level
 
   using FillPartialStyle = PartialStyle<FillStyle, FillStyle::Attribute>;
   using FillConditionalStyle = ConditionalStyle<FillStyle, FillStyle::Attribute>;
   using FillStyleSelector = StyleSelector<FillStyle, FillStyle::Attribute>;
   using FillStyleSelectorList = std::list<FillStyleSelector>; //! List of selectors
-  using FillStyleLookupTable = std::vector<std::vector<FillStyleSelectorList> >;  //!Index selectors by type and level
+  using FillStyleLookupTable = std::vector<std::vector<StyleSelectorTable<FillStyle,FillStyle::Attribute> > >;  //!Index selectors by type and level
 
   using BorderPartialStyle = PartialStyle<BorderStyle, BorderStyle::Attribute>;
   using BorderConditionalStyle = ConditionalStyle<BorderStyle, BorderStyle::Attribute>;
   using BorderStyleSelector = StyleSelector<BorderStyle, BorderStyle::Attribute>;
   using BorderStyleSelectorList = std::list<BorderStyleSelector>; //! List of selectors
-  using BorderStyleLookupTable = std::vector<std::vector<BorderStyleSelectorList> >;  //!Index selectors by type and level
+  using BorderStyleLookupTable = std::vector<std::vector<StyleSelectorTable<BorderStyle,BorderStyle::Attribute> > >;  //!Index selectors by type and level
 
   using TextPartialStyle = PartialStyle<TextStyle, TextStyle::Attribute>;
   using TextConditionalStyle = ConditionalStyle<TextStyle, TextStyle::Attribute>;
   using TextStyleSelector = StyleSelector<TextStyle, TextStyle::Attribute>;
   using TextStyleSelectorList = std::list<TextStyleSelector>; //! List of selectors
-  using TextStyleLookupTable = std::vector<std::vector<TextStyleSelectorList> >;  //!Index selectors by type and level
+  using TextStyleLookupTable = std::vector<std::vector<StyleSelectorTable<TextStyle,TextStyle::Attribute> > >;  //!Index selectors by type and level
 
   using ShieldPartialStyle = PartialStyle<ShieldStyle, ShieldStyle::Attribute>;
   using ShieldConditionalStyle = ConditionalStyle<ShieldStyle, ShieldStyle::Attribute>;
   using ShieldStyleSelector = StyleSelector<ShieldStyle, ShieldStyle::Attribute>;
   using ShieldStyleSelectorList = std::list<ShieldStyleSelector>; //! List of selectors
-  using ShieldStyleLookupTable = std::vector<std::vector<ShieldStyleSelectorList> >;  //!Index selectors by type and level
+  using ShieldStyleLookupTable = std::vector<std::vector<StyleSelectorTable<ShieldStyle,ShieldStyle::Attribute> > >;  //!Index selectors by type and level
 
   using PathShieldPartialStyle = PartialStyle<PathShieldStyle, PathShieldStyle::Attribute>;
   using PathShieldConditionalStyle = ConditionalStyle<PathShieldStyle, PathShieldStyle::Attribute>;
   using PathShieldStyleSelector = StyleSelector<PathShieldStyle, PathShieldStyle::Attribute>;
   using PathShieldStyleSelectorList = std::list<PathShieldStyleSelector>; //! List of selectors
-  using PathShieldStyleLookupTable = std::vector<std::vector<PathShieldStyleSelectorList> >;  //!Index selectors by type and level
+  using PathShieldStyleLookupTable = std::vector<std::vector<StyleSelectorTable<PathShieldStyle,PathShieldStyle::Attribute> > >;  //!Index selectors by type and level
 
   using PathTextPartialStyle = PartialStyle<PathTextStyle, PathTextStyle::Attribute>;
   using PathTextConditionalStyle = ConditionalStyle<PathTextStyle, PathTextStyle::Attribute>;
   using PathTextStyleSelector = StyleSelector<PathTextStyle, PathTextStyle::Attribute>;
   using PathTextStyleSelectorList = std::list<PathTextStyleSelector>; //! List of selectors
-  using PathTextStyleLookupTable = std::vector<std::vector<PathTextStyleSelectorList> >;  //!Index selectors by type and level
+  using PathTextStyleLookupTable = std::vector<std::vector<StyleSelectorTable<PathTextStyle,PathTextStyle::Attribute> > >;  //!Index selectors by type and level
 
   using IconPartialStyle = PartialStyle<IconStyle, IconStyle::Attribute>;
   using IconConditionalStyle = ConditionalStyle<IconStyle, IconStyle::Attribute>;
   using IconStyleSelector = StyleSelector<IconStyle, IconStyle::Attribute>;
   using IconStyleSelectorList = std::list<IconStyleSelector>; //! List of selectors
-  using IconStyleLookupTable = std::vector<std::vector<IconStyleSelectorList> >;  //!Index selectors by type and level
+  using IconStyleLookupTable = std::vector<std::vector<StyleSelectorTable<IconStyle,IconStyle::Attribute> > >;  //!Index selectors by type and level
 
   using PathSymbolPartialStyle = PartialStyle<PathSymbolStyle, PathSymbolStyle::Attribute>;
   using PathSymbolConditionalStyle = ConditionalStyle<PathSymbolStyle, PathSymbolStyle::Attribute>;
   using PathSymbolStyleSelector = StyleSelector<PathSymbolStyle, PathSymbolStyle::Attribute>;
   using PathSymbolStyleSelectorList = std::list<PathSymbolStyleSelector>; //! List of selectors
-  using PathSymbolStyleLookupTable = std::vector<std::vector<PathSymbolStyleSelectorList> >;  //!Index selectors by type and level
+  using PathSymbolStyleLookupTable = std::vector<std::vector<StyleSelectorTable<PathSymbolStyle,PathSymbolStyle::Attribute> > >;  //!Index selectors by type and level
+
+  /**
+   * \ingroup Stylesheet
+   *
+   * Statistics of the style resolution cache of a StyleConfig
+   */
+  struct OSMSCOUT_MAP_API StyleCacheStatistics
+  {
+    size_t hits=0;   //!< Number of composed styles returned from the cache
+    size_t misses=0; //!< Number of composed styles that had to be calculated
+    size_t size=0;   //!< Number of composed styles currently held in the cache
+  };
+
+  /**
+   * \ingroup Stylesheet
+   *
+   * Cache of composed styles (S). A composed style depends only on the selector
+   * list (given by type, magnification level and style slot) and on the
+   * subset of its selectors matching the object. The subset is passed as
+   * signature, with bit n set if the nth selector of the list matches.
+   *
+   * The cache is deliberately not keyed by the inputs of the matching (relevant
+   * feature bits and flags, oneway, size bucket): these have to be read from the
+   * object anyway, and the decision table (see StyleDecisionTable) already reads
+   * each of them only once per object and derives the signature by a few bit
+   * operations. The cache thus only saves the composition, while objects with none
+   * or a single matching selector skip the cache lookup entirely.
+   *
+   * The cache is thread-safe.
+   */
+  template<class S>
+  class StyleCache CLASS_FINAL
+  {
+  private:
+    struct Key
+    {
+      const void* selectors;
+      uint64_t    signature;
+
+      bool operator==(const Key& other) const
+      {
+        return selectors==other.selectors &&
+               signature==other.signature;
+      }
+    };
+
+    struct KeyHasher
+    {
+      size_t operator()(const Key& key) const
+      {
+        return std::hash<const void*>()(key.selectors)^
+               std::hash<uint64_t>()(key.signature*0x9e3779b97f4a7c15ull);
+      }
+    };
+
+  private:
+    mutable std::shared_mutex                            mutex;
+    std::unordered_map<Key,std::shared_ptr<S>,KeyHasher> styles;
+    mutable std::atomic<size_t>                          hits=0;
+    mutable std::atomic<size_t>                          misses=0;
+
+  public:
+    /**
+     * Returns true and the cached style (which might be nullptr for invisible styles),
+     * if there is a composed style for the given selector list and signature
+     */
+    bool Get(const void* selectors,
+             uint64_t signature,
+             std::shared_ptr<S>& style) const
+    {
+      std::shared_lock lock(mutex);
+      auto             entry=styles.find(Key{selectors,signature});
+
+      if (entry==styles.end()) {
+        misses.fetch_add(1,std::memory_order_relaxed);
+        return false;
+      }
+
+      hits.fetch_add(1,std::memory_order_relaxed);
+      style=entry->second;
+
+      return true;
+    }
+
+    void Set(const void* selectors,
+             uint64_t signature,
+             const std::shared_ptr<S>& style)
+    {
+      std::unique_lock lock(mutex);
+
+      styles.emplace(Key{selectors,signature},style);
+    }
+
+    void Clear()
+    {
+      std::unique_lock lock(mutex);
+
+      styles.clear();
+      hits=0;
+      misses=0;
+    }
+
+    void AddStatistics(StyleCacheStatistics& statistics) const
+    {
+      std::shared_lock lock(mutex);
+
+      statistics.hits+=hits.load(std::memory_order_relaxed);
+      statistics.misses+=misses.load(std::memory_order_relaxed);
+      statistics.size+=styles.size();
+    }
+  };
 
   /**
    * \ingroup Stylesheet
@@ -638,6 +854,18 @@ namespace osmscout {
     std::list<StyleError>                      errors;
     std::list<StyleError>                      warnings;
 
+    // Composed styles by selector list and matching selectors
+    mutable StyleCache<LineStyle>              lineStyleCache;
+    mutable StyleCache<FillStyle>              fillStyleCache;
+    mutable StyleCache<BorderStyle>            borderStyleCache;
+    mutable StyleCache<TextStyle>              textStyleCache;
+    mutable StyleCache<PathShieldStyle>        pathShieldStyleCache;
+    mutable StyleCache<PathTextStyle>          pathTextStyleCache;
+    mutable StyleCache<IconStyle>              iconStyleCache;
+    mutable StyleCache<PathSymbolStyle>        pathSymbolStyleCache;
+
+    bool                                       useDecisionTables=true; //!< Evaluate selectors using their decision tables
+
   private:
     void Reset();
 
@@ -647,6 +875,7 @@ namespace osmscout {
     void PostprocessRoutes();
     void PostprocessIconId();
     void PostprocessPatternId();
+    void CompileDecisionTables();
 
   public:
     explicit StyleConfig(const TypeConfigRef& typeConfig);
@@ -821,8 +1050,18 @@ namespace osmscout {
     LineStyleRef GetCoastlineLineStyle(const Projection& projection) const;
     LineStyleRef GetOSMTileBorderLineStyle(const Projection& projection) const;
     LineStyleRef GetOSMSubTileBorderLineStyle(const Projection& projection) const;
+
+    StyleCacheStatistics GetStyleCacheStatistics() const;
+    void ClearStyleCache();
     //@}
 
+    void SetUseDecisionTables(bool useDecisionTables);
+
+    bool GetUseDecisionTables() const
+    {
+      return useDecisionTables;
+    }
+
     /**
      * Methods for low level debugging access to the style sheet internals
      */
@@ -35,6 +35,35 @@ namespace osmscout {
     // no code
   }
 
+  uint64_t DataTileCache::BudgetConsumer::GetOldestAccess() const
+  {
+    return oldestAccess.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * The cache is not thread-safe, so tiles cannot be evicted by the budget.
+   * They are evicted during the next DataTileCache::CleanupCache() instead.
+   */
+  size_t DataTileCache::BudgetConsumer::Evict(size_t /*bytes*/,
+                                              uint64_t /*newerThan*/)
+  {
+    return 0;
+  }
+
+  MemoryBudget::Statistics DataTileCache::BudgetConsumer::GetStatistics() const
+  {
+    MemoryBudget::Statistics statistics;
+
+    statistics.name="tiles";
+    statistics.entries=entries.load(std::memory_order_relaxed);
+    statistics.memory=memory.load(std::memory_order_relaxed);
+    statistics.hits=hits.load(std::memory_order_relaxed);
+    statistics.misses=misses.load(std::memory_order_relaxed);
+    statistics.evictions=evictions.load(std::memory_order_relaxed);
+
+    return statistics;
+  }
+
   /**
    * Create a new tile cache with the given cache size
    */
@@ -44,6 +73,75 @@ namespace osmscout {
     // no code
   }
 
+  DataTileCache::~DataTileCache()
+  {
+    SetMemoryBudget(nullptr);
+  }
+
+  /**
+   * Let the cache draw from the given memory budget (in addition to the tile
+   * count limit of the cache size). The memory of the tiles is charged during
+   * the next call to CleanupCache().
+   */
+  void DataTileCache::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    if (this->budget) {
+      this->budget->Unregister(budgetConsumer);
+      this->budget->Release(budgetConsumer.memory.exchange(0));
+    }
+
+    for (CacheEntry& entry : tileCache) {
+      entry.memory=0;
+      entry.lastAccess=0;
+    }
+
+    this->budget=budget;
+
+    budgetConsumer.oldestAccess=MemoryBudget::NoAccess;
+
+    if (this->budget) {
+      this->budget->Register(budgetConsumer);
+    }
+  }
+
+  /**
+   * Update the access tick of the entry, if the cache draws from a memory budget
+   */
+  void DataTileCache::Touch(CacheEntry& entry) const
+  {
+    if (budget) {
+      entry.lastAccess=budget->NextAccess();
+    }
+  }
+
+  /**
+   * Charge changes of the memory of the tiles to the budget
+   */
+  void DataTileCache::UpdateBudget()
+  {
+    size_t charge=0;
+    size_t release=0;
+
+    for (CacheEntry& entry : tileCache) {
+      size_t memory=entry.tile->GetMemorySize();
+
+      if (memory>entry.memory) {
+        charge+=memory-entry.memory;
+      }
+      else {
+        release+=entry.memory-memory;
+      }
+
+      entry.memory=memory;
+    }
+
+    budgetConsumer.memory+=charge;
+    budgetConsumer.memory-=release;
+
+    budget->Release(release);
+    budget->Charge(charge);
+  }
+
   /**
    * Change the size of the cache. Cache will be cleaned immediately.
    */
@@ -61,27 +159,52 @@ namespace osmscout {
   /**
    * Cleanup the cache. Free least recently used tiles until the given maximum cache
    * size is reached again.
+   *
+   * If the cache draws from a memory budget, the memory of the tiles is charged and
+   * least recently used tiles are freed, as long as the budget is exceeded and there is
+   * no consumer of the budget holding less recently accessed entries.
    */
   void DataTileCache::CleanupCache()
   {
-    if (tileCache.size()>cacheSize) {
-      auto currentEntry=tileCache.rbegin();
-
-      while (currentEntry!=tileCache.rend() &&
-              tileCache.size()>cacheSize) {
-        //if (currentEntry->tile.expired()) {
-        if (currentEntry->tile.use_count()==1) {
-          //std::cout << "Dropping tile " << (std::string)currentEntry->id << " from cache " << cache.size() << "/" << cacheSize << std::endl;
-          tileIndex.erase(currentEntry->key);
-
-          ++currentEntry;
-          currentEntry=std::reverse_iterator<Cache::iterator>(tileCache.erase(currentEntry.base()));
-        }
-        else {
-          ++currentEntry;
+    if (budget) {
+      UpdateBudget();
+    }
+
+    // Fetched once, so that the consumers are not locked for every tile
+    uint64_t othersOldestAccess=budget ? budget->GetOldestAccessOfOthers(budgetConsumer) : MemoryBudget::NoAccess;
+
+    auto isBudgetExceeded=[this,othersOldestAccess](const CacheEntry& entry) {
+      return budget &&
+             budget->IsExceeded() &&
+             entry.lastAccess<=othersOldestAccess;
+    };
+
+    auto currentEntry=tileCache.rbegin();
+
+    while (currentEntry!=tileCache.rend() &&
+           (tileCache.size()>cacheSize ||
+            isBudgetExceeded(*currentEntry))) {
+      //if (currentEntry->tile.expired()) {
+      if (currentEntry->tile.use_count()==1) {
+        //std::cout << "Dropping tile " << (std::string)currentEntry->id << " from cache " << cache.size() << "/" << cacheSize << std::endl;
+        if (budget) {
+          budgetConsumer.memory-=currentEntry->memory;
+          budget->Release(currentEntry->memory);
+          budgetConsumer.evictions++;
         }
+
+        tileIndex.erase(currentEntry->key);
+
+        ++currentEntry;
+        currentEntry=std::reverse_iterator<Cache::iterator>(tileCache.erase(currentEntry.base()));
+      }
+      else {
+        ++currentEntry;
       }
     }
+
+    budgetConsumer.entries=tileCache.size();
+    budgetConsumer.oldestAccess=tileCache.empty() ? MemoryBudget::NoAccess : tileCache.back().lastAccess;
   }
 
   /**
@@ -111,10 +234,14 @@ namespace osmscout {
                        tileCache,
                        existingEntry->second);
       existingEntry->second=tileCache.begin();
+      Touch(*existingEntry->second);
+      budgetConsumer.hits++;
 
       return existingEntry->second->tile;//.lock();
     }
 
+    budgetConsumer.misses++;
+
     return nullptr;
   }
 
@@ -135,12 +262,16 @@ namespace osmscout {
 
       tileCache.push_front(cacheEntry);
       tileIndex[key]=tileCache.begin();
+      Touch(tileCache.front());
+      budgetConsumer.misses++;
 
       return tile;
     }
     else {
       tileCache.splice(tileCache.begin(),tileCache,existingEntry->second);
       existingEntry->second=tileCache.begin();
+      Touch(*existingEntry->second);
+      budgetConsumer.hits++;
 
       return existingEntry->second->tile;
     }
@@ -29,5 +29,6 @@ namespace osmscout {
     nodes.clear();
     areas.clear();
     ways.clear();
+    wayViews.clear();
   }
 }
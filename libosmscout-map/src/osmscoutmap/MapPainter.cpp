@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <limits>
 #include <sstream>
+#include <thread>
 
 #include <osmscout/system/Math.h>
 
@@ -98,6 +99,36 @@ constexpr bool debugGroundTiles = false;
     return intersections;
   }
 
+  static const std::vector<Point>& GetWayNodes(const Way& way)
+  {
+    return way.nodes;
+  }
+
+  static const CoordArrayView& GetWayNodes(const WayView& way)
+  {
+    return way.GetNodes();
+  }
+
+  static bool IsFrontRelevant(const Way& way)
+  {
+    return way.GetFront().IsRelevant();
+  }
+
+  static bool IsFrontRelevant(const WayView& way)
+  {
+    return way.IsFrontRelevant();
+  }
+
+  static bool IsBackRelevant(const Way& way)
+  {
+    return way.GetBack().IsRelevant();
+  }
+
+  static bool IsBackRelevant(const WayView& way)
+  {
+    return way.IsBackRelevant();
+  }
+
   /**
    * Return if a > b, a should be drawn before b
    */
@@ -337,6 +368,27 @@ constexpr bool debugGroundTiles = false;
     }
   }
 
+  void MapPainter::RegisterPointWayLabel(const Projection& projection,
+                                         const MapParameter& parameter,
+                                         const PathShieldStyleRef& style,
+                                         const std::string_view& text,
+                                         const CoordArrayView& nodes)
+  {
+    std::vector<Point> points;
+
+    points.reserve(nodes.size());
+
+    for (const auto& coord : nodes) {
+      points.emplace_back(0,coord);
+    }
+
+    RegisterPointWayLabel(projection,
+                          parameter,
+                          style,
+                          text,
+                          points);
+  }
+
   /**
    * Request layout of a point label
    * @param projection
@@ -844,10 +896,11 @@ constexpr bool debugGroundTiles = false;
     return true;
   }
 
+  template<typename W>
   bool MapPainter::CalculateWayShieldLabels(const StyleConfig& styleConfig,
                                             const Projection& projection,
                                             const MapParameter& parameter,
-                                            const Way& way)
+                                            const W& way)
   {
     PathShieldStyleRef shieldStyle=styleConfig.GetWayPathShieldStyle(way.GetFeatureValueBuffer(),
                                                                      projection);
@@ -867,7 +920,7 @@ constexpr bool debugGroundTiles = false;
                           parameter,
                           shieldStyle,
                           shieldLabel,
-                          way.nodes);
+                          GetWayNodes(way));
 
     return true;
   }
@@ -1042,7 +1095,8 @@ constexpr bool debugGroundTiles = false;
                                    const Area& area,
                                    const Area::Ring& ring,
                                    size_t i,
-                                   const TypeInfoRef& type)
+                                   const TypeInfoRef& type,
+                                   PreprocessingBuffer& buffer)
   {
     if (type->GetIgnore()) {
       // clipping inner ring, we will not render it, but still go deeper,
@@ -1121,7 +1175,7 @@ constexpr bool debugGroundTiles = false;
     a.borderStyle=borderStyle;
     a.coordRange=coordRanges[i];
 
-    areaData.push_back(a);
+    buffer.areaData.push_back(a);
 
     for (size_t idx=borderStyleIndex;
          idx<borderStyles.size();
@@ -1142,8 +1196,8 @@ constexpr bool debugGroundTiles = false;
       }
 
       if (offset!=0.0) {
-        range=coordBuffer.GenerateParallelWay(range,
-                                              offset);
+        range=buffer.coordBuffer->GenerateParallelWay(range,
+                                                      offset);
       }
 
       // Add a copy of the AreaData definition without the buffer and the fill but only the border
@@ -1155,7 +1209,7 @@ constexpr bool debugGroundTiles = false;
       a.borderStyle=borderStyle;
       a.coordRange=range;
 
-      areaData.push_back(a);
+      buffer.areaData.push_back(a);
     }
 
     return true;
@@ -1164,7 +1218,8 @@ constexpr bool debugGroundTiles = false;
   void MapPainter::PrepareArea(const StyleConfig& styleConfig,
                                const Projection& projection,
                                const MapParameter& parameter,
-                               const AreaRef &area)
+                               const AreaRef &area,
+                               PreprocessingBuffer& buffer)
   {
     std::vector<CoordBufferRange> td(area->rings.size()); // Polygon information for each ring
 
@@ -1179,8 +1234,8 @@ constexpr bool debugGroundTiles = false;
 
       if (ring.segments.size() <= 1){
         td[i]=TransformArea(ring.nodes,
-                            transBuffer,
-                            coordBuffer,
+                            *buffer.transBuffer,
+                            *buffer.coordBuffer,
                             projection,
                             parameter.GetOptimizeAreaNodes(),
                             errorTolerancePixel);
@@ -1200,15 +1255,15 @@ constexpr bool debugGroundTiles = false;
         }
 
         td[i]=TransformArea(nodes,
-                            transBuffer,
-                            coordBuffer,
+                            *buffer.transBuffer,
+                            *buffer.coordBuffer,
                             projection,
                             parameter.GetOptimizeAreaNodes(),
                             errorTolerancePixel);
       }
     }
 
-    area->VisitRings([this,&styleConfig,&projection,&parameter,&td,&area](size_t i,
+    area->VisitRings([this,&styleConfig,&projection,&parameter,&td,&area,&buffer](size_t i,
                          const Area::Ring& ring,
                          const TypeInfoRef& type)->bool {
       return PrepareAreaRing(styleConfig,
@@ -1218,7 +1273,8 @@ constexpr bool debugGroundTiles = false;
                              *area,
                              ring,
                              i,
-                             type);
+                             type,
+                             buffer);
     });
   }
 
@@ -1226,23 +1282,31 @@ constexpr bool debugGroundTiles = false;
                                 const MapParameter& parameter,
                                 const MapData& data)
   {
+    std::vector<const AreaRef*> areas;
+
     areaData.clear();
 
+    areas.reserve(data.areas.size()+data.poiAreas.size());
+
     //Areas
     for (const auto& area : data.areas) {
-      PrepareArea(*styleConfig,
-                  projection,
-                  parameter,
-                  area);
+      areas.push_back(&area);
     }
 
     // POI Areas
     for (const auto& area : data.poiAreas) {
-      PrepareArea(*styleConfig,
-                  projection,
-                  parameter,
-                  area);
+      areas.push_back(&area);
     }
+
+    Preprocess(parameter,
+               areas.size(),
+               [this,&projection,&parameter,&areas](size_t i, PreprocessingBuffer& buffer) {
+                 PrepareArea(*styleConfig,
+                             projection,
+                             parameter,
+                             *areas[i],
+                             buffer);
+               });
   }
 
   std::vector<OffsetRel> MapPainter::ParseLaneTurns(const LanesFeatureValue &feature) const
@@ -1293,12 +1357,13 @@ constexpr bool debugGroundTiles = false;
   void MapPainter::TransformPathData(const Projection& projection,
                                      const MapParameter& parameter,
                                      const Way& way,
+                                     PreprocessingBuffer& buffer,
                                      WayPathData &pathData)
   {
     if (way.segments.size() <= 1) {
       pathData.coordRange=TransformWay(way.nodes,
-                                       transBuffer,
-                                       coordBuffer,
+                                       *buffer.transBuffer,
+                                       *buffer.coordBuffer,
                                        projection,
                                        parameter.GetOptimizeWayNodes(),
                                        errorTolerancePixel);
@@ -1317,14 +1382,31 @@ constexpr bool debugGroundTiles = false;
       }
 
       pathData.coordRange=TransformWay(nodes,
-                                       transBuffer,
-                                       coordBuffer,
+                                       *buffer.transBuffer,
+                                       *buffer.coordBuffer,
                                        projection,
                                        parameter.GetOptimizeWayNodes(),
                                        errorTolerancePixel);
     }
   }
 
+  /**
+   * Views have no precomputed segment bounding boxes, all coordinates are transformed.
+   */
+  void MapPainter::TransformPathData(const Projection& projection,
+                                     const MapParameter& parameter,
+                                     const WayView& way,
+                                     PreprocessingBuffer& buffer,
+                                     WayPathData &pathData)
+  {
+    pathData.coordRange=TransformWay(way.GetNodes(),
+                                     *buffer.transBuffer,
+                                     *buffer.coordBuffer,
+                                     projection,
+                                     parameter.GetOptimizeWayNodes(),
+                                     errorTolerancePixel);
+  }
+
   double MapPainter::CalculateLineWith(const Projection& projection,
                                        const FeatureValueBuffer& buffer,
                                        const LineStyle& lineStyle) const
@@ -1422,19 +1504,24 @@ constexpr bool debugGroundTiles = false;
     return 0;
   }
 
+  /**
+   * Calculate the paths of the given way (a Way or a WayView).
+   */
+  template<typename W>
   void MapPainter::CalculateWayPaths(const StyleConfig& styleConfig,
                                      const Projection& projection,
                                      const MapParameter& parameter,
-                                     const Way& way)
+                                     const W& way,
+                                     PreprocessingBuffer& preprocessingBuffer)
   {
     FileOffset ref=way.GetFileOffset();
     const FeatureValueBuffer& buffer=way.GetFeatureValueBuffer();
 
     styleConfig.GetWayLineStyles(buffer,
                                  projection,
-                                 lineStyles);
+                                 preprocessingBuffer.lineStyles);
 
-    if (lineStyles.empty()) {
+    if (preprocessingBuffer.lineStyles.empty()) {
       return;
     }
 
@@ -1450,7 +1537,7 @@ constexpr bool debugGroundTiles = false;
     pathData.mainSlotWidth=0.0;
 
     // Calculate mainSlotWidth
-    for (const auto& lineStyle : lineStyles) {
+    for (const auto& lineStyle : preprocessingBuffer.lineStyles) {
       if (lineStyle->GetSlot().empty()) {
         pathData.mainSlotWidth=CalculateLineWith(projection,
                                                  buffer,
@@ -1464,7 +1551,7 @@ constexpr bool debugGroundTiles = false;
                  << " results in empty mainSlotWidth";
     }
 
-    for (const auto& lineStyle : lineStyles) {
+    for (const auto& lineStyle : preprocessingBuffer.lineStyles) {
       double lineWidth;
 
       if (lineStyle->GetSlot().empty()) {
@@ -1508,9 +1595,9 @@ constexpr bool debugGroundTiles = false;
       data.lineWidth=lineWidth;
 
       if (!transformed) {
-        TransformPathData(projection, parameter, way, pathData);
+        TransformPathData(projection, parameter, way, preprocessingBuffer, pathData);
         transformed=true;
-        wayPathData.push_back(pathData);
+        preprocessingBuffer.wayPathData.push_back(pathData);
       }
 
       data.buffer=&buffer;
@@ -1520,12 +1607,12 @@ constexpr bool debugGroundTiles = false;
                                     *lineStyle);
       data.wayPriority=styleConfig.GetWayPrio(buffer.GetType());
       data.coordRange=pathData.coordRange;
-      data.startIsClosed=!way.GetFront().IsRelevant();
-      data.endIsClosed=!way.GetBack().IsRelevant();
+      data.startIsClosed=!IsFrontRelevant(way);
+      data.endIsClosed=!IsBackRelevant(way);
 
       if (lineOffset!=0.0) {
-        data.coordRange=coordBuffer.GenerateParallelWay(pathData.coordRange,
-                                                         lineOffset);
+        data.coordRange=preprocessingBuffer.coordBuffer->GenerateParallelWay(pathData.coordRange,
+                                                                              lineOffset);
       }
 
       if (lineStyle->GetOffsetRel()==OffsetRel::laneDivider) {
@@ -1549,9 +1636,9 @@ constexpr bool debugGroundTiles = false;
         double laneOffset=-pathData.mainSlotWidth/2.0+lanesSpace;
 
         for (size_t lane=1; lane<lanes; ++lane) {
-          data.coordRange=coordBuffer.GenerateParallelWay(pathData.coordRange,
-                                                           laneOffset);
-          wayData.push_back(data);
+          data.coordRange=preprocessingBuffer.coordBuffer->GenerateParallelWay(pathData.coordRange,
+                                                                                laneOffset);
+          preprocessingBuffer.wayData.push_back(data);
           laneOffset+=lanesSpace;
         }
       }
@@ -1571,44 +1658,187 @@ constexpr bool debugGroundTiles = false;
 
         for (const OffsetRel &laneTurn: laneTurns) {
           if (lineStyle->GetOffsetRel() == laneTurn) {
-            data.coordRange=coordBuffer.GenerateParallelWay(pathData.coordRange,
-                                                             laneOffset);
-            wayData.push_back(data);
+            data.coordRange=preprocessingBuffer.coordBuffer->GenerateParallelWay(pathData.coordRange,
+                                                                                  laneOffset);
+            preprocessingBuffer.wayData.push_back(data);
           }
           laneOffset+=lanesSpace;
         }
       }
       else {
-        wayData.push_back(data);
+        preprocessingBuffer.wayData.push_back(data);
       }
     }
   }
 
+  /**
+   * Call the given function for all objects of a preprocessing step.
+   *
+   * If MapParameter::GetPreprocessingThreadCount() allows, the objects are partitioned
+   * into contiguous ranges, each processed by its own thread into its own
+   * buffers. The results are merged in the order of the ranges afterwards, so the
+   * result does not depend on the number of threads.
+   *
+   * @param parameter
+   *    Parameter of the render action
+   * @param objectCount
+   *    Number of objects to process
+   * @param process
+   *    Function processing the object with the given index into the given buffer
+   */
+  void MapPainter::Preprocess(const MapParameter& parameter,
+                              size_t objectCount,
+                              const std::function<void(size_t,PreprocessingBuffer&)>& process)
+  {
+    // Starting a thread only pays off for a larger number of objects
+    static const size_t minObjectsPerThread=256;
+
+    size_t threadCount=parameter.GetPreprocessingThreadCount();
+
+    if (threadCount==0) {
+      threadCount=std::max(std::thread::hardware_concurrency(),1u);
+    }
+
+    threadCount=std::min(threadCount,
+                         std::max(objectCount/minObjectsPerThread,size_t(1)));
+
+    if (threadCount==1) {
+      PreprocessingBuffer buffer;
+
+      buffer.transBuffer=&transBuffer;
+      buffer.coordBuffer=&coordBuffer;
+
+      for (size_t i=0; i<objectCount; i++) {
+        process(i,buffer);
+      }
+
+      wayData.splice(wayData.end(),buffer.wayData);
+      wayPathData.splice(wayPathData.end(),buffer.wayPathData);
+      areaData.splice(areaData.end(),buffer.areaData);
+
+      return;
+    }
+
+    while (preprocessingWorkers.size()<threadCount) {
+      preprocessingWorkers.push_back(std::make_unique<PreprocessingWorker>());
+    }
+
+    std::vector<PreprocessingBuffer> buffers(threadCount);
+    std::vector<std::thread>         threads;
+
+    threads.reserve(threadCount);
+
+    for (size_t t=0; t<threadCount; t++) {
+      buffers[t].transBuffer=&preprocessingWorkers[t]->transBuffer;
+      buffers[t].coordBuffer=&preprocessingWorkers[t]->coordBuffer;
+      buffers[t].coordBuffer->Reset();
+
+      threads.emplace_back([&process,&buffers,t,threadCount,objectCount]() {
+        for (size_t i=t*objectCount/threadCount; i<(t+1)*objectCount/threadCount; i++) {
+          process(i,buffers[t]);
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (auto& buffer : buffers) {
+      MergePreprocessingBuffer(buffer);
+    }
+  }
+
+  /**
+   * Return the range of the same coordinates after they got moved by the given
+   * offset into the given coordinate buffer
+   */
+  static CoordBufferRange MoveCoordBufferRange(const CoordBufferRange& range,
+                                               CoordBuffer& coordBuffer,
+                                               size_t offset)
+  {
+    if (!range.IsValid()) {
+      return range;
+    }
+
+    return {coordBuffer,
+            range.GetStart()+offset,
+            range.GetEnd()+offset};
+  }
+
+  /**
+   * Append the coordinates of the given buffer of a preprocessing thread to the
+   * coordinate buffer of the painter and append its results, pointing to the
+   * moved coordinates, to the results of the painter
+   */
+  void MapPainter::MergePreprocessingBuffer(PreprocessingBuffer& buffer)
+  {
+    size_t offset=coordBuffer.Append(*buffer.coordBuffer);
+
+    for (auto& data : buffer.wayData) {
+      data.coordRange=MoveCoordBufferRange(data.coordRange,coordBuffer,offset);
+    }
+
+    for (auto& data : buffer.wayPathData) {
+      data.coordRange=MoveCoordBufferRange(data.coordRange,coordBuffer,offset);
+    }
+
+    for (auto& data : buffer.areaData) {
+      data.coordRange=MoveCoordBufferRange(data.coordRange,coordBuffer,offset);
+
+      for (auto& clipping : data.clippings) {
+        clipping=MoveCoordBufferRange(clipping,coordBuffer,offset);
+      }
+    }
+
+    wayData.splice(wayData.end(),buffer.wayData);
+    wayPathData.splice(wayPathData.end(),buffer.wayPathData);
+    areaData.splice(areaData.end(),buffer.areaData);
+  }
+
   void MapPainter::CalculatePaths(const Projection& projection,
                                   const MapParameter& parameter,
                                   const MapData& data)
   {
+    std::vector<const Way*> ways;
+
     wayData.clear();
     wayPathData.clear();
     routeLabelData.clear();
 
+    ways.reserve(data.ways.size()+data.poiWays.size());
+
     for (const auto& way : data.ways) {
       if (way->IsValid()) {
-        CalculateWayPaths(*styleConfig,
-                          projection,
-                          parameter,
-                          *way);
+        ways.push_back(way.get());
       }
     }
 
     for (const auto& way : data.poiWays) {
       if (way->IsValid()) {
-        CalculateWayPaths(*styleConfig,
-                          projection,
-                          parameter,
-                          *way);
-      }
-    }
+        ways.push_back(way.get());
+      }
+    }
+
+    // Way views follow the ways
+    Preprocess(parameter,
+               ways.size()+data.wayViews.size(),
+               [this,&projection,&parameter,&ways,&data](size_t i, PreprocessingBuffer& buffer) {
+                 if (i<ways.size()) {
+                   CalculateWayPaths(*styleConfig,
+                                     projection,
+                                     parameter,
+                                     *ways[i],
+                                     buffer);
+                 }
+                 else {
+                   CalculateWayPaths(*styleConfig,
+                                     projection,
+                                     parameter,
+                                     data.wayViews[i-ways.size()],
+                                     buffer);
+                 }
+               });
   }
 
   void MapPainter::CalculateWayShields(const Projection& projection,
@@ -1636,6 +1866,13 @@ constexpr bool debugGroundTiles = false;
                                  *way);
       }
     }
+
+    for (const auto& way : data.wayViews) {
+      CalculateWayShieldLabels(*styleConfig,
+                               projection,
+                               parameter,
+                               way);
+    }
   }
 
   void MapPainter::ProcessRoutes(const Projection& projection,
@@ -1678,6 +1915,11 @@ constexpr bool debugGroundTiles = false;
                                                     parameter.GetSidecarDistance(),
                                                     projection.ConvertWidthToPixel(parameter.GetSidecarMinDistanceMM())));
 
+    PreprocessingBuffer buffer;
+
+    buffer.transBuffer=&transBuffer;
+    buffer.coordBuffer=&coordBuffer;
+
     std::map<FileOffset,WayRoutes> wayDataMap;
     for (auto it=wayPathData.begin(); it != wayPathData.end(); ++it){
       auto &wayRoute=wayDataMap[it->ref];
@@ -1766,7 +2008,7 @@ constexpr bool debugGroundTiles = false;
 
               pathData.ref=member.way;
               pathData.buffer=&(it->second->GetFeatureValueBuffer());
-              TransformPathData(projection, parameter, *(it->second), pathData);
+              TransformPathData(projection, parameter, *(it->second), buffer, pathData);
               pathData.mainSlotWidth=0.0;
 
               wayPathData.push_back(pathData);
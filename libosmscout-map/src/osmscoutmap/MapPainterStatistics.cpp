@@ -51,7 +51,18 @@ namespace osmscout {
         << data.nodes.size()
         << "+" << data.poiNodes.size()
         << " " << data.ways.size()
+        << "+" << data.wayViews.size()
         << " " << data.areas.size();
+
+      StyleCacheStatistics styleCache=styleConfig.GetStyleCacheStatistics();
+      size_t               lookups=styleCache.hits+styleCache.misses;
+
+      log.Info()
+        << "Style cache: "
+        << styleCache.hits << " hits "
+        << styleCache.misses << " misses "
+        << (lookups>0 ? styleCache.hits*100/lookups : 0) << "% "
+        << styleCache.size << " styles";
     }
 
     if (parameter.GetWarningCoordCountLimit()==0 &&
@@ -57,6 +57,7 @@ namespace osmscout {
     renderUnknowns(false),
     renderContourLines(false),
     renderHillShading(false),
+    preprocessingThreadCount(1),
     debugData(false),
     debugPerformance(false),
     warnObjectCountLimit(0),
@@ -237,6 +238,18 @@ namespace osmscout {
     this->renderHillShading=render;
   }
 
+  /**
+   * Set the number of worker threads used by the painter to calculate the paths
+   * of ways and areas (the preprocessing render steps). 0 uses one thread per core.
+   *
+   * With more than one thread, registered FillStyleProcessors get called
+   * concurrently and must be thread-safe.
+   */
+  void MapParameter::SetPreprocessingThreadCount(size_t threadCount)
+  {
+    this->preprocessingThreadCount=threadCount;
+  }
+
   void MapParameter::SetDebugData(bool debug)
   {
     debugData=debug;
@@ -97,7 +97,7 @@ namespace osmscout {
      routeWorkerThread(&MapService::RouteWorkerLoop,this),
      nextCallbackId(0)
   {
-    // no code
+    cache.SetMemoryBudget(database->GetMemoryBudget());
   }
 
   MapService::~MapService()
@@ -1350,6 +1350,69 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Load read-only views (see WayView) of all ways of the given types intersecting
+   * the given bounding box and add them to MapData::wayViews.
+   *
+   * In contrast to the ways loaded by LoadMissingTileData(), views are
+   * not cached by tile and their coordinates are not decoded while loading.
+   * The ways data file has to be memory mapped. Types loaded as views
+   * should not be loaded via the tiles, too, else they are drawn twice.
+   *
+   * @param parameter
+   *    Parameter of the search (only used to check for abort)
+   * @param wayTypes
+   *    Types of the ways to load
+   * @param boundingBox
+   *    Boundary coordinates
+   * @param data
+   *    MapData instance the views are added to
+   * @return
+   *    False, if there was an error, else true.
+   */
+  bool MapService::LoadWayViews(const AreaSearchParameter& parameter,
+                                const TypeInfoSet& wayTypes,
+                                const GeoBox& boundingBox,
+                                MapData& data) const
+  {
+    AreaWayIndexRef areaWayIndex=database->GetAreaWayIndex();
+
+    if (!areaWayIndex) {
+      return false;
+    }
+
+    if (wayTypes.Empty()) {
+      return true;
+    }
+
+    std::vector<FileOffset> offsets;
+    TypeInfoSet             loadedTypes;
+
+    if (!areaWayIndex->GetOffsets(boundingBox,
+                                  wayTypes,
+                                  offsets,
+                                  loadedTypes)) {
+      log.Error() << "Error getting ways from area way index!";
+      return false;
+    }
+
+    if (parameter.IsAborted()) {
+      return false;
+    }
+
+    // Sort offsets before loading to optimize disk access
+    std::sort(offsets.begin(),offsets.end());
+
+    if (!database->GetWayViewsByOffset(offsets,
+                                       boundingBox,
+                                       data.wayViews)) {
+      log.Error() << "Error reading way views in area!";
+      return false;
+    }
+
+    return !parameter.IsAborted();
+  }
+
   /**
    * Return all ground tiles for the given projection data
    * (bounding box and magnification).
@@ -19,8 +19,9 @@
 
 #include <osmscoutmap/StyleConfig.h>
 
-#include <set>
 #include <algorithm>
+#include <bit>
+#include <set>
 
 #include <osmscout/system/Assert.h>
 
@@ -73,6 +74,20 @@ namespace osmscout {
     return index;
   }
 
+  /**
+   * Return the index of the given feature in the features of the given type
+   *
+   * @return
+   *    false, if the type does not have the feature
+   */
+  bool StyleResolveContext::GetFeatureIndex(size_t featureIndex,
+                                            const TypeInfo& type,
+                                            size_t& index) const
+  {
+    return type.GetFeature(featureReaders[featureIndex].GetFeatureName(),
+                           index);
+  }
+
   StyleConstantColor::StyleConstantColor(const Color& color)
   : color(color)
   {
@@ -299,6 +314,163 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Compile the criteria of the selectors for the given type.
+   *
+   * @param context
+   *    Context the feature indexes of the criteria refer to
+   * @param type
+   *    Type the selectors are used for
+   * @param criteria
+   *    Criteria of the selectors, in the order of the selectors
+   * @return
+   *    false, if the table cannot hold the selectors, the selectors then have to be
+   *    evaluated one by one
+   */
+  bool StyleDecisionTable::Compile(const StyleResolveContext& context,
+                                   const TypeInfo& type,
+                                   const std::vector<const StyleCriteria*>& criteria)
+  {
+    typeIndex=std::numeric_limits<size_t>::max();
+    conditions.clear();
+    selectorMasks.clear();
+    possibleSelectors=0;
+
+    if (criteria.size()>maxEntries) {
+      return false;
+    }
+
+    selectorMasks.reserve(criteria.size());
+
+    for (size_t s=0; s<criteria.size(); s++) {
+      std::vector<Condition> selectorConditions;
+      bool                   possible=true;
+
+      for (const auto& feature : criteria[s]->GetFeatures()) {
+        Condition condition;
+
+        if (!context.GetFeatureIndex(feature.featureFilterIndex,
+                                     type,
+                                     condition.featureIndex)) {
+          possible=false;
+          break;
+        }
+
+        if (feature.flagIndex!=std::numeric_limits<size_t>::max()) {
+          condition.type=ConditionType::featureFlag;
+          condition.flagIndex=feature.flagIndex;
+        }
+        else {
+          condition.type=ConditionType::feature;
+        }
+
+        selectorConditions.push_back(condition);
+      }
+
+      if (criteria[s]->GetOneway()) {
+        Condition condition;
+
+        condition.type=ConditionType::oneway;
+
+        selectorConditions.push_back(condition);
+      }
+
+      if (criteria[s]->GetSizeCondition()) {
+        Condition condition;
+
+        condition.type=ConditionType::size;
+        condition.sizeCondition=criteria[s]->GetSizeCondition().get();
+
+        selectorConditions.push_back(condition);
+      }
+
+      uint64_t mask=0;
+
+      if (possible) {
+        for (const auto& condition : selectorConditions) {
+          auto entry=std::find(conditions.begin(),
+                               conditions.end(),
+                               condition);
+
+          if (entry==conditions.end()) {
+            if (conditions.size()==maxEntries) {
+              conditions.clear();
+              selectorMasks.clear();
+
+              return false;
+            }
+
+            entry=conditions.insert(conditions.end(),
+                                    condition);
+          }
+
+          mask|=uint64_t(1) << (entry-conditions.begin());
+        }
+
+        possibleSelectors|=uint64_t(1) << s;
+      }
+
+      selectorMasks.push_back(mask);
+    }
+
+    typeIndex=type.GetIndex();
+
+    return true;
+  }
+
+  /**
+   * Evaluate the compiled criteria for the given object, which must be of the
+   * type the table has been compiled for.
+   *
+   * @return
+   *    Bit mask of the matching selectors, bit n is set if the nth selector matches
+   */
+  uint64_t StyleDecisionTable::Evaluate(const StyleResolveContext& context,
+                                        const FeatureValueBuffer& buffer,
+                                        double meterInPixel,
+                                        double meterInMM) const
+  {
+    assert(CanEvaluate(buffer));
+
+    uint64_t fulfilled=0;
+
+    for (size_t c=0; c<conditions.size(); c++) {
+      const Condition& condition=conditions[c];
+      bool             result=false;
+
+      switch (condition.type) {
+      case ConditionType::feature:
+        result=buffer.HasFeature(condition.featureIndex);
+        break;
+      case ConditionType::featureFlag:
+        if (buffer.HasFeature(condition.featureIndex)) {
+          const FeatureValue* value=buffer.GetValue(condition.featureIndex);
+
+          result=value!=nullptr &&
+                 value->IsFlagSet(condition.flagIndex);
+        }
+        break;
+      case ConditionType::oneway:
+        result=context.IsOneway(buffer);
+        break;
+      case ConditionType::size:
+        result=condition.sizeCondition->Evaluate(meterInPixel,
+                                                 meterInMM);
+        break;
+      }
+
+      fulfilled|=uint64_t(result) << c;
+    }
+
+    uint64_t matches=0;
+
+    for (size_t s=0; s<selectorMasks.size(); s++) {
+      matches|=uint64_t((fulfilled & selectorMasks[s])==selectorMasks[s]) << s;
+    }
+
+    return matches & possibleSelectors;
+  }
+
   StyleConfig::StyleConfig(const TypeConfigRef& typeConfig)
    : typeConfig(typeConfig),
      styleResolveContext(typeConfig)
@@ -325,6 +497,8 @@ namespace osmscout {
 
   void StyleConfig::Reset()
   {
+    ClearStyleCache();
+
     symbols.clear();
     emptySymbol=nullptr;
 
@@ -426,6 +600,23 @@ namespace osmscout {
                             bool value)
   {
     flags[name]=value;
+
+    ClearStyleCache();
+  }
+
+  /**
+   * Drop all cached composed styles, the statistics of the cache are reset, too
+   */
+  void StyleConfig::ClearStyleCache()
+  {
+    lineStyleCache.Clear();
+    fillStyleCache.Clear();
+    borderStyleCache.Clear();
+    textStyleCache.Clear();
+    pathShieldStyleCache.Clear();
+    pathTextStyleCache.Clear();
+    iconStyleCache.Clear();
+    pathSymbolStyleCache.Clear();
   }
 
   StyleConstantRef StyleConfig::GetConstantByName(const std::string& name) const
@@ -513,7 +704,7 @@ namespace osmscout {
   void SortInConditionals(const TypeConfig& typeConfig,
                           const std::list<ConditionalStyle<S,A> >& conditionals,
                           size_t maxLevel,
-                          std::vector<std::vector<std::list<StyleSelector<S,A> > > >& selectors)
+                          std::vector<std::vector<StyleSelectorTable<S,A> > >& selectors)
   {
     selectors.resize(typeConfig.GetTypeCount());
 
@@ -533,21 +724,21 @@ namespace osmscout {
         size_t maxLvl=conditional.filter.HasMaxLevel() ? conditional.filter.GetMaxLevel() : maxLevel;
 
         for (size_t level=minLvl; level<=maxLvl; level++) {
-          selectors[type->GetIndex()][level].push_back(selector);
+          selectors[type->GetIndex()][level].selectors.push_back(selector);
         }
       }
     }
 
     for (auto& selector : selectors) {
       for (size_t level=0; level<selector.size(); level++) {
-        if (selector[level].size()>=2) {
+        if (selector[level].selectors.size()>=2) {
           // If two consecutive conditions are equal, one can be removed and the style can get merged
-          auto prevSelector=selector[level].begin();
+          auto prevSelector=selector[level].selectors.begin();
           auto curSelector=prevSelector;
 
           ++curSelector;
 
-          while (curSelector!=selector[level].end()) {
+          while (curSelector!=selector[level].selectors.end()) {
             if (prevSelector->criteria==curSelector->criteria) {
               prevSelector->attributes.insert(curSelector->attributes.begin(),
                                               curSelector->attributes.end());
@@ -555,7 +746,7 @@ namespace osmscout {
               prevSelector->style->CopyAttributes(*curSelector->style,
                                                   curSelector->attributes);
 
-              curSelector=selector[level].erase(curSelector);
+              curSelector=selector[level].selectors.erase(curSelector);
             }
             else {
               prevSelector=curSelector;
@@ -565,9 +756,9 @@ namespace osmscout {
         }
 
         // If there is only one conditional and it is not visible, we can remove it
-        if (selector[level].size()==1 &&
-            !selector[level].front().style->IsVisible()) {
-          selector[level].clear();
+        if (selector[level].selectors.size()==1 &&
+            !selector[level].selectors.front().style->IsVisible()) {
+          selector[level].selectors.clear();
         }
       }
     }
@@ -577,7 +768,7 @@ namespace osmscout {
   void SortInConditionalsBySlot(const TypeConfig& typeConfig,
                                 const std::list<ConditionalStyle<S,A> >& conditionals,
                                 size_t maxLevel,
-                                std::vector<std::vector<std::vector<std::list<StyleSelector<S,A> > > > >& selectors)
+                                std::vector<std::vector<std::vector<StyleSelectorTable<S,A> > > >& selectors)
   {
     std::unordered_map<std::string,std::list<ConditionalStyle<S,A>> > styleBySlot;
 
@@ -637,12 +828,12 @@ namespace osmscout {
   }
 
   template <class S, class A>
-  bool HasStyle(const std::vector<std::vector<std::list<StyleSelector<S,A>>>>& styleSelectors,
+  bool HasStyle(const std::vector<std::vector<StyleSelectorTable<S,A>>>& styleSelectors,
                 const size_t level)
   {
     for (const auto &selectorsForType: styleSelectors){
       assert(!selectorsForType.empty());
-      if (!selectorsForType[std::min(level, selectorsForType.size() - 1)].empty()){
+      if (!selectorsForType[std::min(level, selectorsForType.size() - 1)].selectors.empty()){
         return true;
       }
     }
@@ -849,7 +1040,7 @@ namespace osmscout {
 
     for (auto& typeSelector : areaIconStyleSelectors) {
       for (auto& levelSelector : typeSelector) {
-        for (auto& selector : levelSelector) {
+        for (auto& selector : levelSelector.selectors) {
           if (!selector.style->GetIconName().empty()) {
             auto entry=symbolIdMap.find(selector.style->GetIconName());
 
@@ -870,7 +1061,7 @@ namespace osmscout {
 
     for (auto& typeSelector: nodeIconStyleSelectors) {
       for (auto& levelSelector : typeSelector) {
-        for (auto& selector : levelSelector) {
+        for (auto& selector : levelSelector.selectors) {
           if (!selector.style->GetIconName().empty()) {
             auto entry=symbolIdMap.find(selector.style->GetIconName());
 
@@ -897,7 +1088,7 @@ namespace osmscout {
 
     for (auto& typeSelector : areaFillStyleSelectors) {
       for (auto& levelSelector: typeSelector) {
-        for (auto& selector : levelSelector) {
+        for (auto& selector : levelSelector.selectors) {
           if (!selector.style->GetPatternName().empty()) {
             auto entry=symbolIdMap.find(selector.style->GetPatternName());
 
@@ -917,6 +1108,97 @@ namespace osmscout {
     }
   }
 
+  template <class S, class A>
+  void CompileDecisionTables(const StyleResolveContext& context,
+                             const TypeConfig& typeConfig,
+                             std::vector<std::vector<StyleSelectorTable<S,A> > >& selectors,
+                             size_t& tableCount,
+                             size_t& compiledCount)
+  {
+    std::vector<const StyleCriteria*> criteria;
+
+    for (const auto& type : typeConfig.GetTypes()) {
+      if (type->GetIndex()>=selectors.size()) {
+        continue;
+      }
+
+      for (auto& table : selectors[type->GetIndex()]) {
+        if (table.selectors.empty()) {
+          continue;
+        }
+
+        criteria.clear();
+
+        for (const auto& selector : table.selectors) {
+          criteria.push_back(&selector.criteria);
+        }
+
+        tableCount++;
+
+        if (table.decisionTable.Compile(context,
+                                        *type,
+                                        criteria)) {
+          compiledCount++;
+        }
+      }
+    }
+  }
+
+  template <class S, class A>
+  void CompileDecisionTables(const StyleResolveContext& context,
+                             const TypeConfig& typeConfig,
+                             std::vector<std::vector<std::vector<StyleSelectorTable<S,A> > > >& slotSelectors,
+                             size_t& tableCount,
+                             size_t& compiledCount)
+  {
+    for (auto& selectors : slotSelectors) {
+      CompileDecisionTables(context,
+                            typeConfig,
+                            selectors,
+                            tableCount,
+                            compiledCount);
+    }
+  }
+
+  /**
+   * Compile the criteria of all selector lists into decision tables
+   */
+  void StyleConfig::CompileDecisionTables()
+  {
+    size_t tableCount=0;
+    size_t compiledCount=0;
+
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,nodeTextStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,nodeIconStyleSelectors,tableCount,compiledCount);
+
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,wayLineStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,wayPathTextStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,wayPathSymbolStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,wayPathShieldStyleSelectors,tableCount,compiledCount);
+
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,areaFillStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,areaBorderStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,areaTextStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,areaIconStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,areaBorderTextStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,areaBorderSymbolStyleSelectors,tableCount,compiledCount);
+
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,routeLineStyleSelectors,tableCount,compiledCount);
+    osmscout::CompileDecisionTables(styleResolveContext,*typeConfig,routePathTextStyleSelectors,tableCount,compiledCount);
+
+    log.Debug() << "Compiled " << compiledCount << " of " << tableCount << " selector lists into decision tables";
+  }
+
+  /**
+   * Evaluate the style selectors using their decision tables (default) or
+   * by evaluating the criteria of each selector. The result is the same,
+   * this is meant for debugging and benchmarking.
+   */
+  void StyleConfig::SetUseDecisionTables(bool useDecisionTables)
+  {
+    this->useDecisionTables=useDecisionTables;
+  }
+
   void StyleConfig::Postprocess()
   {
     PostprocessNodes();
@@ -926,6 +1208,11 @@ namespace osmscout {
 
     PostprocessIconId();
     PostprocessPatternId();
+
+    CompileDecisionTables();
+
+    // Selectors have changed
+    ClearStyleCache();
   }
 
   TypeConfigRef StyleConfig::GetTypeConfig() const
@@ -1097,33 +1384,21 @@ namespace osmscout {
   }
 
   /**
-   * Get the style data based on the given features of an object,
-   * a given style (S) and its style attributes (A).
+   * Compose the style of the given selectors. Selectors are used, if the given
+   * predicate returns true for the selector and its index in the list.
    */
-  template <class S, class A>
-  std::shared_ptr<S> GetFeatureStyle(const StyleResolveContext& context,
-                                     const std::vector<std::list<StyleSelector<S,A> > >& styleSelectors,
-                                     const FeatureValueBuffer& buffer,
-                                     const Projection& projection)
+  template <class S, class A, class P>
+  std::shared_ptr<S> ComposeFeatureStyle(const std::list<StyleSelector<S,A> >& selectors,
+                                         P matches)
   {
-    assert(!styleSelectors.empty());
-
     bool               fastpath=false;
     bool               composed=false;
-    size_t             level=projection.GetMagnification().GetLevel();
-    double             meterInPixel=projection.GetMeterInPixel();
-    double             meterInMM=projection.GetMeterInMM();
+    size_t             index=0;
     std::shared_ptr<S> style;
 
-    if (level>=styleSelectors.size()) {
-      level=styleSelectors.size()-1;
-    }
-
-    for (const auto& selector : styleSelectors[level]) {
-      if (!selector.criteria.Matches(context,
-                                     buffer,
-                                     meterInPixel,
-                                     meterInMM)) {
+    for (const auto& selector : selectors) {
+      if (!matches(index++,
+                   selector)) {
         continue;
       }
 
@@ -1152,6 +1427,104 @@ namespace osmscout {
     return style;
   }
 
+  /**
+   * Get the style data based on the given features of an object,
+   * a given style (S) and its style attributes (A).
+   *
+   * The matching selectors are calculated using the decision table of the
+   * selectors, if possible and requested, else by evaluating the criteria of
+   * each selector. If more than one selector matches, the composed style is taken
+   * from the given cache, if it was already composed before for the same matching
+   * selectors.
+   */
+  template <class S, class A>
+  std::shared_ptr<S> GetFeatureStyle(const StyleResolveContext& context,
+                                     bool useDecisionTables,
+                                     StyleCache<S>& cache,
+                                     const std::vector<StyleSelectorTable<S,A> >& styleSelectors,
+                                     const FeatureValueBuffer& buffer,
+                                     const Projection& projection)
+  {
+    assert(!styleSelectors.empty());
+
+    size_t level=projection.GetMagnification().GetLevel();
+    double meterInPixel=projection.GetMeterInPixel();
+    double meterInMM=projection.GetMeterInMM();
+
+    if (level>=styleSelectors.size()) {
+      level=styleSelectors.size()-1;
+    }
+
+    const StyleSelectorTable<S,A>&        table=styleSelectors[level];
+    const std::list<StyleSelector<S,A> >& selectors=table.selectors;
+    uint64_t                              signature=0;
+
+    if (selectors.empty()) {
+      return nullptr;
+    }
+
+    if (useDecisionTables &&
+        table.decisionTable.CanEvaluate(buffer)) {
+      signature=table.decisionTable.Evaluate(context,
+                                             buffer,
+                                             meterInPixel,
+                                             meterInMM);
+    }
+    else if (selectors.size()<=StyleDecisionTable::maxEntries) {
+      size_t index=0;
+
+      for (const auto& selector : selectors) {
+        if (selector.criteria.Matches(context,
+                                      buffer,
+                                      meterInPixel,
+                                      meterInMM)) {
+          signature|=uint64_t(1) << index;
+        }
+
+        index++;
+      }
+    }
+    else {
+      // Signature does not fit, evaluate without cache
+      return ComposeFeatureStyle(selectors,
+                                 [&](size_t /*index*/, const StyleSelector<S,A>& selector) {
+                                   return selector.criteria.Matches(context,
+                                                                    buffer,
+                                                                    meterInPixel,
+                                                                    meterInMM);
+                                 });
+    }
+
+    if (signature==0) {
+      return nullptr;
+    }
+
+    // Fastpath, the style of the stylesheet can be used directly
+    if (std::has_single_bit(signature)) {
+      return std::next(selectors.begin(),
+                       std::countr_zero(signature))->style;
+    }
+
+    std::shared_ptr<S> style;
+
+    if (cache.Get(&selectors,
+                  signature,
+                  style)) {
+      return style;
+    }
+
+    style=ComposeFeatureStyle(selectors,
+                              [signature](size_t index, const StyleSelector<S,A>& /*selector*/) {
+                                return (signature & (uint64_t(1) << index))!=0;
+                              });
+
+    cache.Set(&selectors,
+              signature,
+              style);
+
+    return style;
+  }
+
   bool StyleConfig::HasNodeTextStyles(const TypeInfoRef& type,
                                       const Magnification& magnification) const
   {
@@ -1162,7 +1535,7 @@ namespace osmscout {
         level=static_cast<uint32_t>(nodeTextStyleSelector[type->GetIndex()].size()-1);
       }
 
-      if (!nodeTextStyleSelector[type->GetIndex()][level].empty()) {
+      if (!nodeTextStyleSelector[type->GetIndex()][level].selectors.empty()) {
         return true;
       }
     }
@@ -1180,7 +1553,9 @@ namespace osmscout {
 
     for (const auto& nodeTextStyleSelector : nodeTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
-                                         nodeTextStyleSelector[buffer.GetType()->GetIndex()],
+                                         useDecisionTables,
+                                         textStyleCache,
+                                         nodeTextStyleSelector[buffer.GetTypeIndex()],
                                          buffer,
                                          projection);
 
@@ -1197,7 +1572,9 @@ namespace osmscout {
 
     for (const auto& nodeTextStyleSelector : nodeTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
-                                         nodeTextStyleSelector[buffer.GetType()->GetIndex()],
+                                         useDecisionTables,
+                                         textStyleCache,
+                                         nodeTextStyleSelector[buffer.GetTypeIndex()],
                                          buffer,
                                          projection);
 
@@ -1213,7 +1590,9 @@ namespace osmscout {
                                              const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           nodeIconStyleSelectors[buffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           iconStyleCache,
+                           nodeIconStyleSelectors[buffer.GetTypeIndex()],
                            buffer,
                            projection);
   }
@@ -1229,7 +1608,9 @@ namespace osmscout {
 
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
-                                         wayLineStyleSelector[buffer.GetType()->GetIndex()],
+                                         useDecisionTables,
+                                         lineStyleCache,
+                                         wayLineStyleSelector[buffer.GetTypeIndex()],
                                          buffer,
                                          projection);
 
@@ -1263,7 +1644,9 @@ namespace osmscout {
 
     for (const auto& routeLineStyleSelector : routeLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
-                                         routeLineStyleSelector[buffer.GetType()->GetIndex()],
+                                         useDecisionTables,
+                                         lineStyleCache,
+                                         routeLineStyleSelector[buffer.GetTypeIndex()],
                                          buffer,
                                          projection);
 
@@ -1294,7 +1677,9 @@ namespace osmscout {
     symbolStyles.reserve(wayLineStyleSelectors.size());
     for (const auto& wayPathSymbolStyleSelector : wayPathSymbolStyleSelectors) {
       PathSymbolStyleRef style=GetFeatureStyle(styleResolveContext,
-                                               wayPathSymbolStyleSelector[buffer.GetType()->GetIndex()],
+                                               useDecisionTables,
+                                               pathSymbolStyleCache,
+                                               wayPathSymbolStyleSelector[buffer.GetTypeIndex()],
                                                buffer,
                                                projection);
       if (style) {
@@ -1308,7 +1693,9 @@ namespace osmscout {
                                                     const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           wayPathTextStyleSelectors[buffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           pathTextStyleCache,
+                           wayPathTextStyleSelectors[buffer.GetTypeIndex()],
                            buffer,
                            projection);
   }
@@ -1326,7 +1713,9 @@ namespace osmscout {
                                                       const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           routePathTextStyleSelectors[buffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           pathTextStyleCache,
+                           routePathTextStyleSelectors[buffer.GetTypeIndex()],
                            buffer,
                            projection);
   }
@@ -1335,7 +1724,9 @@ namespace osmscout {
                                                         const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           wayPathShieldStyleSelectors[buffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           pathShieldStyleCache,
+                           wayPathShieldStyleSelectors[buffer.GetTypeIndex()],
                            buffer,
                            projection);
   }
@@ -1354,6 +1745,8 @@ namespace osmscout {
                                              const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           useDecisionTables,
+                           fillStyleCache,
                            areaFillStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1369,6 +1762,8 @@ namespace osmscout {
 
     for (const auto& areaBorderStyleSelector : areaBorderStyleSelectors) {
       BorderStyleRef style=GetFeatureStyle(styleResolveContext,
+                                           useDecisionTables,
+                                           borderStyleCache,
                                            areaBorderStyleSelector[type->GetIndex()],
                                            buffer,
                                            projection);
@@ -1389,7 +1784,7 @@ namespace osmscout {
         level=static_cast<uint32_t>(areaTextStyleSelector[type->GetIndex()].size()-1);
       }
 
-      if (!areaTextStyleSelector[type->GetIndex()][level].empty()) {
+      if (!areaTextStyleSelector[type->GetIndex()][level].selectors.empty()) {
         return true;
       }
     }
@@ -1407,6 +1802,8 @@ namespace osmscout {
 
     for (const auto& areaTextStyleSelector : areaTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         useDecisionTables,
+                                         textStyleCache,
                                          areaTextStyleSelector[type->GetIndex()],
                                          buffer,
                                          projection);
@@ -1425,6 +1822,8 @@ namespace osmscout {
 
     for (const auto& areaTextStyleSelector : areaTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         useDecisionTables,
+                                         textStyleCache,
                                          areaTextStyleSelector[type->GetIndex()],
                                          buffer,
                                          projection);
@@ -1442,6 +1841,8 @@ namespace osmscout {
                                              const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           useDecisionTables,
+                           iconStyleCache,
                            areaIconStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1452,6 +1853,8 @@ namespace osmscout {
                                                        const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           useDecisionTables,
+                           pathTextStyleCache,
                            areaBorderTextStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1462,6 +1865,8 @@ namespace osmscout {
                                                            const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           useDecisionTables,
+                           pathSymbolStyleCache,
                            areaBorderSymbolStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1470,7 +1875,9 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetLandFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           areaFillStyleSelectors[tileLandBuffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           fillStyleCache,
+                           areaFillStyleSelectors[tileLandBuffer.GetTypeIndex()],
                            tileLandBuffer,
                            projection);
   }
@@ -1478,7 +1885,9 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetSeaFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           areaFillStyleSelectors[tileSeaBuffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           fillStyleCache,
+                           areaFillStyleSelectors[tileSeaBuffer.GetTypeIndex()],
                            tileSeaBuffer,
                            projection);
   }
@@ -1486,7 +1895,9 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetCoastFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           areaFillStyleSelectors[tileCoastBuffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           fillStyleCache,
+                           areaFillStyleSelectors[tileCoastBuffer.GetTypeIndex()],
                            tileCoastBuffer,
                            projection);
   }
@@ -1494,7 +1905,9 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetUnknownFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
-                           areaFillStyleSelectors[tileUnknownBuffer.GetType()->GetIndex()],
+                           useDecisionTables,
+                           fillStyleCache,
+                           areaFillStyleSelectors[tileUnknownBuffer.GetTypeIndex()],
                            tileUnknownBuffer,
                            projection);
   }
@@ -1503,7 +1916,9 @@ namespace osmscout {
   {
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
-                                         wayLineStyleSelector[coastlineBuffer.GetType()->GetIndex()],
+                                         useDecisionTables,
+                                         lineStyleCache,
+                                         wayLineStyleSelector[coastlineBuffer.GetTypeIndex()],
                                          coastlineBuffer,
                                          projection);
 
@@ -1519,7 +1934,9 @@ namespace osmscout {
   {
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
-                                         wayLineStyleSelector[osmTileBorderBuffer.GetType()->GetIndex()],
+                                         useDecisionTables,
+                                         lineStyleCache,
+                                         wayLineStyleSelector[osmTileBorderBuffer.GetTypeIndex()],
                                          osmTileBorderBuffer,
                                          projection);
 
@@ -1535,7 +1952,9 @@ namespace osmscout {
   {
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
-                                         wayLineStyleSelector[osmSubTileBorderBuffer.GetType()->GetIndex()],
+                                         useDecisionTables,
+                                         lineStyleCache,
+                                         wayLineStyleSelector[osmSubTileBorderBuffer.GetTypeIndex()],
                                          osmSubTileBorderBuffer,
                                          projection);
 
@@ -1547,6 +1966,26 @@ namespace osmscout {
     return nullptr;
   }
 
+  /**
+   * Return the statistics of the cache of composed styles since the style sheet
+   * has been loaded
+   */
+  StyleCacheStatistics StyleConfig::GetStyleCacheStatistics() const
+  {
+    StyleCacheStatistics statistics;
+
+    lineStyleCache.AddStatistics(statistics);
+    fillStyleCache.AddStatistics(statistics);
+    borderStyleCache.AddStatistics(statistics);
+    textStyleCache.AddStatistics(statistics);
+    pathShieldStyleCache.AddStatistics(statistics);
+    pathTextStyleCache.AddStatistics(statistics);
+    iconStyleCache.AddStatistics(statistics);
+    pathSymbolStyleCache.AddStatistics(statistics);
+
+    return statistics;
+  }
+
   void StyleConfig::GetNodeTextStyleSelectors(size_t level,
                                               const TypeInfoRef& type,
                                               std::list<TextStyleSelector>& selectors) const
@@ -1560,7 +1999,7 @@ namespace osmscout {
         l=slotEntry[type->GetIndex()].size()-1;
       }
 
-      for (const auto& selector : slotEntry[type->GetIndex()][l]) {
+      for (const auto& selector : slotEntry[type->GetIndex()][l].selectors) {
         selectors.push_back(selector);
       }
     }
@@ -1576,7 +2015,7 @@ namespace osmscout {
       level=areaFillStyleSelectors[type->GetIndex()].size()-1;
     }
 
-    for (const auto& selector : areaFillStyleSelectors[type->GetIndex()][level]) {
+    for (const auto& selector : areaFillStyleSelectors[type->GetIndex()][level].selectors) {
       selectors.push_back(selector);
     }
   }
@@ -1594,7 +2033,7 @@ namespace osmscout {
         l=slotEntry[type->GetIndex()].size()-1;
       }
 
-      for (const auto& selector : slotEntry[type->GetIndex()][l]) {
+      for (const auto& selector : slotEntry[type->GetIndex()][l].selectors) {
         selectors.push_back(selector);
       }
     }
@@ -302,6 +302,8 @@ namespace osmscout {
       return GetBoundingBox().Intersects(boundingBox);
     }
 
+    size_t GetMemorySize() const;
+
     /**
      * Read the area as written by Write().
      */
@@ -0,0 +1,164 @@
+#ifndef OSMSCOUT_AREAVIEW_H
+#define OSMSCOUT_AREAVIEW_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <osmscout/Area.h>
+#include <osmscout/ObjectRef.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/util/GeoBox.h>
+
+#include <osmscout/io/CoordArrayView.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * Read-only view of an Area stored in a memory mapped data file.
+   *
+   * Ring coordinates are referenced inside the file mapping and decoded
+   * while iterating (see CoordArrayView), instead of being decoded into
+   * std::vector<Point>. Ring hierarchy follows the same rules as for Area.
+   * The view keeps the file mapping alive.
+   */
+  class OSMSCOUT_API AreaView CLASS_FINAL
+  {
+  public:
+    class OSMSCOUT_API Ring
+    {
+    private:
+      FeatureValueBuffer      featureValueBuffer; //!< List of features
+      uint8_t                 ring=0;             //!< The ring hierarchy number (0...n)
+      CoordArrayView          nodes;              //!< Encoded coordinates
+      GeoBox                  bbox;               //!< Bounding box of the coordinates
+      std::optional<GeoCoord> center;             //!< "visual" polygon center, if stored
+
+    public:
+      Ring() = default;
+
+      TypeInfoRef GetType() const
+      {
+        return featureValueBuffer.GetType();
+      }
+
+      const FeatureValueBuffer& GetFeatureValueBuffer() const
+      {
+        return featureValueBuffer;
+      }
+
+      uint8_t GetRing() const
+      {
+        return ring;
+      }
+
+      bool IsMaster() const
+      {
+        return ring==Area::masterRingId;
+      }
+
+      bool IsTopOuter() const
+      {
+        return ring==Area::outerRingId;
+      }
+
+      bool IsOuter() const
+      {
+        return ring%2==Area::outerRingId;
+      }
+
+      const CoordArrayView& GetNodes() const
+      {
+        return nodes;
+      }
+
+      GeoBox GetBoundingBox() const
+      {
+        return bbox;
+      }
+
+      std::optional<GeoCoord> GetCenter() const
+      {
+        return center;
+      }
+
+      friend class AreaView;
+    };
+
+  private:
+    std::vector<Ring>           rings;
+    FileOffset                  fileOffset=0;     //!< Offset into the data file of this area
+    FileOffset                  nextFileOffset=0; //!< Offset after this area
+    std::shared_ptr<const char> mapping;          //!< Keeps the file mapping alive
+
+  public:
+    AreaView() = default;
+
+    FileOffset GetFileOffset() const
+    {
+      return fileOffset;
+    }
+
+    FileOffset GetNextFileOffset() const
+    {
+      return nextFileOffset;
+    }
+
+    ObjectFileRef GetObjectFileRef() const
+    {
+      return {fileOffset,refArea};
+    }
+
+    TypeInfoRef GetType() const
+    {
+      return rings.front().GetType();
+    }
+
+    const std::vector<Ring>& GetRings() const
+    {
+      return rings;
+    }
+
+    bool IsSimple() const
+    {
+      return rings.size()==1;
+    }
+
+    GeoBox GetBoundingBox() const;
+
+    bool Intersects(const GeoBox& boundingBox) const
+    {
+      return GetBoundingBox().Intersects(boundingBox);
+    }
+
+    void Read(const TypeConfig& typeConfig,
+              FileScanner& scanner);
+  };
+
+  using AreaViewRef = std::shared_ptr<AreaView>;
+}
+
+#endif
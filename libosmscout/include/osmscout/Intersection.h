@@ -57,6 +57,8 @@ namespace osmscout {
       return objects;
     }
 
+    size_t GetMemorySize() const;
+
     bool Read(FileScanner& scanner);
     bool Read(const TypeConfig& typeConfig,
               FileScanner& scanner);
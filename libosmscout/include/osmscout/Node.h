@@ -114,6 +114,8 @@ namespace osmscout {
     void SetCoords(const GeoCoord& coords);
     void SetFeatures(const FeatureValueBuffer& buffer);
 
+    size_t GetMemorySize() const;
+
     void Read(const TypeConfig& typeConfig,
               FileScanner& scanner);
     void Write(const TypeConfig& typeConfig,
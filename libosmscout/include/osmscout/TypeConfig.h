@@ -793,6 +793,14 @@ namespace osmscout {
       return type;
     }
 
+    /**
+     * Return the index of the type, without copying the type reference
+     */
+    size_t GetTypeIndex() const
+    {
+      return type->GetIndex();
+    }
+
     /**
      * Return the numbe rof features defined for this type
      */
@@ -922,6 +930,8 @@ namespace osmscout {
     bool operator==(const FeatureValueBuffer& other) const;
     bool operator!=(const FeatureValueBuffer& other) const;
 
+    size_t GetMemorySize() const;
+
     /**
      * Reads the FeatureValueBuffer to the given FileScanner.
      * It also reads the array of special flags (up to 8) as passed to the Write method.
@@ -1041,7 +1051,12 @@ namespace osmscout {
   // Forward declaration
   class TypeConfig;
 
-  static const uint32_t FILE_FORMAT_VERSION=26;
+  /**
+   * Format version written by the importer. Version 27 added stream-vbyte
+   * encoded coordinate arrays (see CoordEncoding), which older libraries would
+   * silently decode as fixed width deltas.
+   */
+  static const uint32_t FILE_FORMAT_VERSION=27;
 
   /**
    * \ingroup type
@@ -1053,8 +1068,8 @@ namespace osmscout {
   {
   public:
     static const char* FILE_TYPES_DAT;
-    static const uint32_t MIN_FORMAT_VERSION = FILE_FORMAT_VERSION;
-    static const uint32_t MAX_FORMAT_VERSION = FILE_FORMAT_VERSION;
+    static constexpr uint32_t MIN_FORMAT_VERSION = 26; //!< Version 26 is version 27 without stream-vbyte coordinates
+    static constexpr uint32_t MAX_FORMAT_VERSION = FILE_FORMAT_VERSION;
 
   private:
     // Tags
@@ -198,6 +198,8 @@ namespace osmscout {
       featureValueBuffer.Set(buffer);
     }
 
+    size_t GetMemorySize() const;
+
     void Read(const TypeConfig& typeConfig,
               FileScanner& scanner);
     void ReadOptimized(const TypeConfig& typeConfig,
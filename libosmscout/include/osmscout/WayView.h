@@ -0,0 +1,126 @@
+#ifndef OSMSCOUT_WAYVIEW_H
+#define OSMSCOUT_WAYVIEW_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+
+#include <osmscout/ObjectRef.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/util/GeoBox.h>
+
+#include <osmscout/io/CoordArrayView.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * Read-only view of a Way stored in a memory mapped data file.
+   *
+   * In contrast to Way, coordinates are not decoded into a std::vector<Point>,
+   * but are referenced inside the file mapping and decoded while iterating
+   * (see CoordArrayView). Node serials are not available, only the relevance
+   * of the first and the last node is recorded. The view keeps
+   * the file mapping alive, so it stays valid even after the data file is closed.
+   *
+   * The view may be passed to TransformWay(...) directly.
+   */
+  class OSMSCOUT_API WayView CLASS_FINAL
+  {
+  private:
+    FeatureValueBuffer          featureValueBuffer;    //!< List of features
+    CoordArrayView              nodes;                 //!< Encoded coordinates
+    GeoBox                      bbox;                  //!< Bounding box of the coordinates
+    FileOffset                  fileOffset=0;          //!< Offset into the data file of this way
+    FileOffset                  nextFileOffset=0;      //!< Offset after this way
+    bool                        isFrontRelevant=false; //!< The first node has a serial
+    bool                        isBackRelevant=false;  //!< The last node has a serial
+    std::shared_ptr<const char> mapping;               //!< Keeps the file mapping alive
+
+  public:
+    WayView() = default;
+
+    FileOffset GetFileOffset() const
+    {
+      return fileOffset;
+    }
+
+    FileOffset GetNextFileOffset() const
+    {
+      return nextFileOffset;
+    }
+
+    ObjectFileRef GetObjectFileRef() const
+    {
+      return {fileOffset,refWay};
+    }
+
+    TypeInfoRef GetType() const
+    {
+      return featureValueBuffer.GetType();
+    }
+
+    const FeatureValueBuffer& GetFeatureValueBuffer() const
+    {
+      return featureValueBuffer;
+    }
+
+    const CoordArrayView& GetNodes() const
+    {
+      return nodes;
+    }
+
+    /**
+     * Return true, if the first node of the way is relevant (see Point::IsRelevant())
+     */
+    bool IsFrontRelevant() const
+    {
+      return isFrontRelevant;
+    }
+
+    /**
+     * Return true, if the last node of the way is relevant (see Point::IsRelevant())
+     */
+    bool IsBackRelevant() const
+    {
+      return isBackRelevant;
+    }
+
+    GeoBox GetBoundingBox() const
+    {
+      return bbox;
+    }
+
+    bool Intersects(const GeoBox& boundingBox) const
+    {
+      return bbox.Intersects(boundingBox);
+    }
+
+    void Read(const TypeConfig& typeConfig,
+              FileScanner& scanner);
+  };
+
+  using WayViewRef = std::shared_ptr<WayView>;
+}
+
+#endif
@@ -30,7 +30,7 @@
 #include <osmscout/io/FileScanner.h>
 #include <osmscout/io/DataFile.h>
 
-#include <osmscout/util/Cache.h>
+#include <osmscout/util/ShardedCache.h>
 #include <osmscout/util/Geometry.h>
 
 namespace osmscout {
@@ -64,19 +64,7 @@ namespace osmscout {
       FileOffset data;                    //!< The file index at which the data payload starts
     };
 
-    using IndexCache = Cache<FileOffset, IndexCell>;
-
-    struct IndexCacheValueSizer : public IndexCache::ValueSizer
-    {
-      size_t GetSize(const IndexCell& value) const override
-      {
-        size_t memory=0;
-
-        memory+=sizeof(value);
-
-        return memory;
-      }
-    };
+    using IndexCache = ShardedCache<FileOffset, IndexCell>;
 
     struct CellRef
     {
@@ -102,7 +90,7 @@ namespace osmscout {
     uint32_t              maxLevel;       //!< Maximum level in index
     FileOffset            topLevelOffset; //!< File offset of the top level index entry
 
-    mutable IndexCache    indexCache;     //!< Cached map of all index entries by file offset, guarded by lookupMutex
+    mutable IndexCache    indexCache;     //!< Thread-safe cache of all index entries by file offset
 
     mutable std::mutex    lookupMutex;
 
@@ -151,6 +139,8 @@ namespace osmscout {
                         std::vector<DataBlockSpan>& spans,
                         TypeInfoSet& loadedTypes) const;
 
+    void SetMemoryBudget(const MemoryBudgetRef& budget);
+
     void DumpStatistics();
 
     void FlushCache();
@@ -29,8 +29,12 @@
 #include <string_view>
 
 // Type and style sheet configuration
+#include <osmscout/AreaView.h>
 #include <osmscout/OSMScoutTypes.h>
 #include <osmscout/TypeConfig.h>
+#include <osmscout/WayView.h>
+
+#include <osmscout/db/DatabaseRegistry.h>
 
 // Datafiles
 #include <osmscout/db/AreaDataFile.h>
@@ -60,6 +64,7 @@
 #include <osmscout/routing/RouteDescription.h>
 
 #include <osmscout/util/GeoBox.h>
+#include <osmscout/util/MemoryBudget.h>
 
 #include <osmscout/system/Compiler.h>
 
@@ -78,6 +83,8 @@ namespace osmscout {
 
     The following attributes are currently available:
     * cache sizes.
+    * an optional memory budget shared by all caches.
+    * an optional registry of resources shared with other databases.
     */
   class OSMSCOUT_API DatabaseParameter CLASS_FINAL
   {
@@ -89,6 +96,9 @@ namespace osmscout {
     unsigned long areaDataCacheSize=5'000;
     unsigned long routeDataCacheSize=1'500;
 
+    MemoryBudgetRef     memoryBudget;
+    DatabaseRegistryRef registry;
+
     bool routerDataMMap=true;
     bool nodesDataMMap=true;
     bool areasDataMMap=true;
@@ -109,6 +119,9 @@ namespace osmscout {
     void SetAreaDataCacheSize(unsigned long  size);
     void SetRouteDataCacheSize(unsigned long  size);
 
+    void SetMemoryBudget(const MemoryBudgetRef& budget);
+    void SetRegistry(const DatabaseRegistryRef& registry);
+
     void SetRouterDataMMap(bool mmap);
     void SetNodesDataMMap(bool mmap);
     void SetAreasDataMMap(bool mmap);
@@ -129,6 +142,9 @@ namespace osmscout {
     unsigned long GetRouteDataCacheSize() const;
     unsigned long GetAreaDataCacheSize() const;
 
+    MemoryBudgetRef GetMemoryBudget() const;
+    DatabaseRegistryRef GetRegistry() const;
+
     bool GetRouterDataMMap() const;
     bool GetNodesDataMMap() const;
     bool GetAreasDataMMap() const;
@@ -144,6 +160,54 @@ namespace osmscout {
     }
   };
 
+  /**
+    Parameter for Database::Preload(), defining which data of the region
+    gets preloaded and how.
+
+    By default nodes, ways, areas and routes in the region are preloaded.
+    */
+  class OSMSCOUT_API PreloadOptions CLASS_FINAL
+  {
+  private:
+    bool nodes=true;     //!< Preload nodes (and the area node index)
+    bool ways=true;      //!< Preload ways (and the area way index)
+    bool areas=true;     //!< Preload areas (and the area area index)
+    bool routes=true;    //!< Preload routes (and the area route index)
+
+    bool lock=false;     //!< Lock the preloaded data into memory
+    bool parallel=false; //!< Preload the individual data files in parallel threads
+
+  public:
+    PreloadOptions() = default;
+
+    void SetNodes(bool nodes);
+    void SetWays(bool ways);
+    void SetAreas(bool areas);
+    void SetRoutes(bool routes);
+    void SetLock(bool lock);
+    void SetParallel(bool parallel);
+
+    bool GetNodes() const;
+    bool GetWays() const;
+    bool GetAreas() const;
+    bool GetRoutes() const;
+    bool GetLock() const;
+    bool GetParallel() const;
+  };
+
+  /**
+    Page cache residency of an individual database file, as returned
+    by Database::GetResidencyReport().
+    */
+  struct OSMSCOUT_API FileResidency
+  {
+    std::string filename;       //!< Name of the file (without directory)
+    FileOffset  size=0;         //!< Size of the file in bytes
+    FileOffset  residentSize=0; //!< Number of bytes of the file currently resident in memory
+  };
+
+  using DatabaseResidencyReport = std::vector<FileResidency>;
+
   class Database;
 
   class OSMSCOUT_API NodeRegionSearchResultEntry
@@ -367,6 +431,15 @@ namespace osmscout {
       return result;
     }
 
+    bool PreloadNodes(const GeoBox& boundingBox,
+                      bool lock) const;
+    bool PreloadWays(const GeoBox& boundingBox,
+                     bool lock) const;
+    bool PreloadAreas(const GeoBox& boundingBox,
+                      bool lock) const;
+    bool PreloadRoutes(const GeoBox& boundingBox,
+                       bool lock) const;
+
   public:
     explicit Database(const DatabaseParameter& parameter);
     ~Database();
@@ -386,6 +459,9 @@ namespace osmscout {
       return parameter;
     }
 
+    MemoryBudgetRef GetMemoryBudget() const;
+    FileDescriptorPoolRef GetFileDescriptorPool() const;
+
     BoundingBoxDataFileRef GetBoundingBoxDataFile() const;
 
     NodeDataFileRef GetNodeDataFile() const;
@@ -439,6 +515,30 @@ namespace osmscout {
     bool GetAreasByBlockSpans(const std::vector<DataBlockSpan>& spans,
                               std::vector<AreaRef>& areas) const;
 
+    /**
+     * Load read-only views of the areas at the given offsets, that intersect
+     * the given bounding box. Areas data file has to be memory mapped.
+     */
+    template<typename OffsetsCol>
+    bool GetAreaViewsByOffset(const OffsetsCol& offsets,
+                              const GeoBox& boundingBox,
+                              std::vector<AreaView>& areas) const
+    {
+      AreaDataFileRef areaDataFile=GetAreaDataFile();
+
+      if (!areaDataFile) {
+        return false;
+      }
+
+      return areaDataFile->template GetViewsByOffset<AreaView>(offsets.begin(),
+                                                               offsets.end(),
+                                                               offsets.size(),
+                                                               boundingBox,
+                                                               areas);
+    }
+
+    bool GetAreaViewsByBlockSpans(const std::vector<DataBlockSpan>& spans,
+                                  std::vector<AreaView>& areas) const;
 
     bool GetWayByOffset(const FileOffset& offset,
                         WayRef& way) const;
@@ -451,6 +551,31 @@ namespace osmscout {
       return GetObjectsByOffset(GetWayDataFile(), offsets, ways, "ways"sv);
     }
 
+    /**
+     * Load read-only views of the ways at the given offsets, that intersect
+     * the given bounding box. Ways data file has to be memory mapped.
+     */
+    template<typename OffsetsCol>
+    bool GetWayViewsByOffset(const OffsetsCol& offsets,
+                             const GeoBox& boundingBox,
+                             std::vector<WayView>& ways) const
+    {
+      WayDataFileRef wayDataFile=GetWayDataFile();
+
+      if (!wayDataFile) {
+        return false;
+      }
+
+      return wayDataFile->template GetViewsByOffset<WayView>(offsets.begin(),
+                                                             offsets.end(),
+                                                             offsets.size(),
+                                                             boundingBox,
+                                                             ways);
+    }
+
+    bool GetWayViewsByBlockSpans(const std::vector<DataBlockSpan>& spans,
+                                 std::vector<WayView>& ways) const;
+
     template<typename OffsetsCol, typename DataCol>
     bool GetRoutesByOffset(const OffsetsCol& offsets,
                            DataCol& routes) const
@@ -549,6 +674,11 @@ namespace osmscout {
     AreaRegionSearchResult LoadAreasInArea(const TypeInfoSet& types,
                                            const GeoBox& boundingBox) const;
 
+    bool Preload(const GeoBox& boundingBox,
+                 const PreloadOptions& options=PreloadOptions()) const;
+
+    DatabaseResidencyReport GetResidencyReport() const;
+
     void DumpStatistics() const;
 
     void FlushCache();
@@ -0,0 +1,105 @@
+#ifndef OSMSCOUT_DATABASEREGISTRY_H
+#define OSMSCOUT_DATABASEREGISTRY_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/io/FileDescriptorPool.h>
+
+#include <osmscout/util/MemoryBudget.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Database
+   *
+   * Registry of resources shared by multiple databases of one process
+   * (see DatabaseParameter::SetRegistry()):
+   *
+   * * Databases imported with the same type configuration (identical 'types.dat')
+   *   share one parsed TypeConfig instance. The type config is shared as long as
+   *   at least one database holds it.
+   * * An optional MemoryBudget all caches of the databases draw from.
+   * * An optional FileDescriptorPool bounding the number of files opened by
+   *   the data files of the databases.
+   *
+   * GetInstance() returns a process-wide instance, but registries may also
+   * be created for a group of databases.
+   *
+   * The class is thread-safe.
+   */
+  class OSMSCOUT_API DatabaseRegistry CLASS_FINAL
+  {
+  private:
+    /**
+     * A type config loaded by the registry
+     */
+    struct TypeConfigEntry
+    {
+      std::vector<char>         content;    //!< Content of the 'types.dat' file
+      std::weak_ptr<TypeConfig> typeConfig; //!< The parsed type config
+    };
+
+  private:
+    mutable std::mutex         mutex;
+    std::list<TypeConfigEntry> typeConfigs;
+    MemoryBudgetRef            memoryBudget;
+    FileDescriptorPoolRef      descriptorPool;
+
+  public:
+    DatabaseRegistry() = default;
+
+    // disable copy and move
+    DatabaseRegistry(const DatabaseRegistry&) = delete;
+    DatabaseRegistry(DatabaseRegistry&&) = delete;
+    DatabaseRegistry& operator=(const DatabaseRegistry&) = delete;
+    DatabaseRegistry& operator=(DatabaseRegistry&&) = delete;
+
+    ~DatabaseRegistry() = default;
+
+    static std::shared_ptr<DatabaseRegistry> GetInstance();
+
+    TypeConfigRef LoadTypeConfig(const std::string& directory);
+
+    size_t GetTypeConfigCount() const;
+
+    void SetMemoryBudget(const MemoryBudgetRef& budget);
+    MemoryBudgetRef GetMemoryBudget() const;
+
+    void SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool);
+    FileDescriptorPoolRef GetFileDescriptorPool() const;
+  };
+
+  //! Reference counted reference to a DatabaseRegistry instance
+  using DatabaseRegistryRef = std::shared_ptr<DatabaseRegistry>;
+}
+
+#endif
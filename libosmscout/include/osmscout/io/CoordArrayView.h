@@ -0,0 +1,297 @@
+#ifndef OSMSCOUT_COORDARRAYVIEW_H
+#define OSMSCOUT_COORDARRAYVIEW_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/GeoCoord.h>
+#include <osmscout/Point.h>
+
+#include <osmscout/util/GeoBox.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup File
+   *
+   * Read-only view of a delta encoded coordinate array (as written by
+   * FileWriter::Write(const std::vector<Point>&,bool)) inside of a memory
+   * mapped file.
+   *
+   * Coordinates are not materialized, they are decoded one by one while
+   * iterating. The view does not own the memory, it is valid as long as
+   * the mapping it was read from (see FileScanner::GetMapping()) is alive.
+   *
+   * Node serials (if present in the file) are skipped.
+   *
+   * Both the fixed width and the stream-vbyte delta encoding (see CoordEncoding)
+   * are supported. For stream-vbyte encoded arrays deltaBytes is 0 and the
+   * control bytes precede the data bytes.
+   */
+  class OSMSCOUT_API CoordArrayView CLASS_FINAL
+  {
+  private:
+    const uint8_t *control=nullptr; //!< First control byte (stream-vbyte encoding only)
+    const uint8_t *data=nullptr; //!< First delta byte
+    uint32_t      firstLat=0;    //!< Raw latitude value of the first coordinate
+    uint32_t      firstLon=0;    //!< Raw longitude value of the first coordinate
+    uint32_t      count=0;       //!< Number of coordinates
+    uint8_t       deltaBytes=0;  //!< Bytes per delta pair (2, 4 or 6), 0 for stream-vbyte encoding
+
+  public:
+    /**
+     * Forward iterator over the coordinates of the view
+     */
+    class OSMSCOUT_API Iterator CLASS_FINAL
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = GeoCoord;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const GeoCoord*;
+      using reference         = GeoCoord;
+
+    private:
+      const uint8_t *control=nullptr;
+      const uint8_t *data=nullptr;
+      uint32_t      lat=0;
+      uint32_t      lon=0;
+      uint32_t      index=0;
+      uint32_t      count=0;
+      uint8_t       deltaBytes=0;
+
+    public:
+      Iterator() = default;
+
+      Iterator(const uint8_t *control,
+               const uint8_t *data,
+               uint32_t lat,
+               uint32_t lon,
+               uint32_t index,
+               uint32_t count,
+               uint8_t deltaBytes)
+      : control(control),
+        data(data),
+        lat(lat),
+        lon(lon),
+        index(index),
+        count(count),
+        deltaBytes(deltaBytes)
+      {
+        // no code
+      }
+
+      GeoCoord operator*() const
+      {
+        return {lat/latConversionFactor-90.0,
+                lon/lonConversionFactor-180.0};
+      }
+
+      Iterator& operator++()
+      {
+        index++;
+
+        // There is one delta less than coordinates, do not read beyond the last one
+        if (index<count) {
+          int32_t latDelta;
+          int32_t lonDelta;
+
+          if (deltaBytes==0) {
+            data+=DecodeStreamVByteDelta(control,
+                                         data,
+                                         index-1,
+                                         latDelta,
+                                         lonDelta);
+          }
+          else {
+            DecodeDelta(data,
+                        deltaBytes,
+                        latDelta,
+                        lonDelta);
+
+            data+=deltaBytes;
+          }
+
+          lat+=latDelta;
+          lon+=lonDelta;
+        }
+
+        return *this;
+      }
+
+      Iterator operator++(int)
+      {
+        Iterator tmp(*this);
+
+        ++(*this);
+
+        return tmp;
+      }
+
+      bool operator==(const Iterator& other) const
+      {
+        return index==other.index;
+      }
+
+      bool operator!=(const Iterator& other) const
+      {
+        return index!=other.index;
+      }
+    };
+
+  public:
+    CoordArrayView() = default;
+
+    CoordArrayView(const uint8_t *data,
+                   uint32_t firstLat,
+                   uint32_t firstLon,
+                   uint32_t count,
+                   uint8_t deltaBytes)
+    : data(data),
+      firstLat(firstLat),
+      firstLon(firstLon),
+      count(count),
+      deltaBytes(deltaBytes)
+    {
+      // no code
+    }
+
+    /**
+     * View of a stream-vbyte encoded array
+     */
+    CoordArrayView(const uint8_t *control,
+                   const uint8_t *data,
+                   uint32_t firstLat,
+                   uint32_t firstLon,
+                   uint32_t count)
+    : control(control),
+      data(data),
+      firstLat(firstLat),
+      firstLon(firstLon),
+      count(count)
+    {
+      // no code
+    }
+
+    /**
+     * Decode one pair of little endian, two-complement latitude and longitude deltas
+     * of the given size (2, 4 or 6 bytes for both values).
+     */
+    static void DecodeDelta(const uint8_t *data,
+                            uint8_t deltaBytes,
+                            int32_t& latDelta,
+                            int32_t& lonDelta)
+    {
+      if (deltaBytes==2) {
+        latDelta=(int8_t)data[0];
+        lonDelta=(int8_t)data[1];
+      }
+      else if (deltaBytes==4) {
+        latDelta=(int16_t)(uint16_t)(data[0] | (data[1] << 8));
+        lonDelta=(int16_t)(uint16_t)(data[2] | (data[3] << 8));
+      }
+      else {
+        uint32_t latUDelta=data[0] | (data[1] << 8) | (data[2] << 16);
+        uint32_t lonUDelta=data[3] | (data[4] << 8) | (data[5] << 16);
+
+        if (latUDelta & 0x800000u) {
+          latUDelta|=0xff000000u;
+        }
+
+        if (lonUDelta & 0x800000u) {
+          lonUDelta|=0xff000000u;
+        }
+
+        latDelta=(int32_t)latUDelta;
+        lonDelta=(int32_t)lonUDelta;
+      }
+    }
+
+    /**
+     * Decode the stream-vbyte encoded latitude and longitude delta of the given
+     * coordinate delta index. data must point to the first data byte of the delta.
+     *
+     * @return the number of data bytes of the delta
+     */
+    static size_t DecodeStreamVByteDelta(const uint8_t *control,
+                                         const uint8_t *data,
+                                         size_t index,
+                                         int32_t& latDelta,
+                                         int32_t& lonDelta)
+    {
+      // Both values of a delta are in the same control byte
+      uint8_t  codes=control[index/2] >> (4*(index%2));
+      size_t   latLength=(codes & 0x03u)+1;
+      size_t   lonLength=((codes >> 2) & 0x03u)+1;
+      uint32_t latValue=0;
+      uint32_t lonValue=0;
+
+      for (size_t i=0; i<latLength; i++) {
+        latValue|=uint32_t(data[i]) << (8*i);
+      }
+
+      for (size_t i=0; i<lonLength; i++) {
+        lonValue|=uint32_t(data[latLength+i]) << (8*i);
+      }
+
+      latDelta=int32_t((latValue >> 1) ^ (~(latValue & 1)+1));
+      lonDelta=int32_t((lonValue >> 1) ^ (~(lonValue & 1)+1));
+
+      return latLength+lonLength;
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    bool empty() const
+    {
+      return count==0;
+    }
+
+    Iterator begin() const
+    {
+      return {control,data,firstLat,firstLon,0,count,deltaBytes};
+    }
+
+    Iterator end() const
+    {
+      return {nullptr,nullptr,0,0,count,count,deltaBytes};
+    }
+
+    GeoCoord front() const
+    {
+      return *begin();
+    }
+
+    GeoBox GetBoundingBox() const;
+
+    void CopyTo(std::vector<Point>& nodes) const;
+  };
+}
+
+#endif
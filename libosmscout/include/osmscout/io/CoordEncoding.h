@@ -0,0 +1,82 @@
+#ifndef OSMSCOUT_COORDENCODING_H
+#define OSMSCOUT_COORDENCODING_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup File
+   *
+   * Encoding of the coordinate deltas of a node array, as written by
+   * FileWriter::Write(const std::vector<Point>&,bool).
+   *
+   * The encoding is signaled by the two lowest bits of the first size byte
+   * of each array (0-2 for fixedWidth, 3 for streamVByte), so FileScanner detects
+   * it automatically and both encodings may be mixed in one file.
+   *
+   * Flag value 3 was decoded as fixed width deltas before, so stream-vbyte
+   * encoded arrays require file format version 27 (see FILE_FORMAT_VERSION),
+   * which older libraries refuse to open.
+   */
+  enum class CoordEncoding : std::uint8_t
+  {
+    fixedWidth  = 0, //!< All deltas of an array use the same width of 1, 2 or 3 bytes
+    streamVByte = 1  //!< Zigzag deltas of individual width (1-4 bytes), lengths stored in separate control bytes
+  };
+
+  /**
+   * Value of the coordinate size flags of a stream-vbyte encoded array
+   */
+  static constexpr uint8_t streamVByteCoordSizeFlags=0x03;
+
+  /**
+   * Number of control bytes for the given number of values (2 bit per value)
+   */
+  inline size_t StreamVByteControlLength(size_t count)
+  {
+    return (count+3)/4;
+  }
+
+  extern OSMSCOUT_API size_t StreamVByteDataLength(const uint8_t* control,
+                                                   size_t count);
+
+  extern OSMSCOUT_API void StreamVByteEncode(const std::vector<int32_t>& values,
+                                             std::vector<uint8_t>& buffer);
+
+  extern OSMSCOUT_API void StreamVByteDecodeCoords(const uint8_t* control,
+                                                   const uint8_t* data,
+                                                   const uint8_t* dataEnd,
+                                                   size_t count,
+                                                   uint32_t lat,
+                                                   uint32_t lon,
+                                                   uint32_t* coords,
+                                                   bool useSimd=true);
+
+  extern OSMSCOUT_API bool HasStreamVByteSimdDecoder();
+}
+
+#endif
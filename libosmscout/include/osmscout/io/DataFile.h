@@ -20,18 +20,22 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
-#include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include <osmscout/TypeConfig.h>
 
+#include <osmscout/io/FileBatchReader.h>
 #include <osmscout/io/FileScanner.h>
+#include <osmscout/io/FileScannerPool.h>
 #include <osmscout/io/NumericIndex.h>
 
-#include <osmscout/util/Cache.h>
+#include <osmscout/util/ShardedCache.h>
 #include <osmscout/log/Logger.h>
 
 //#include <map>
@@ -69,34 +73,75 @@ namespace osmscout {
    * Access to standard format data files.
    *
    * Allows to load data objects by offset using various standard library data structures.
+   *
+   * Reading is done using scanners borrowed from a FileScannerPool and values are
+   * cached in a ShardedCache, so concurrent requests from multiple threads do not
+   * serialize on a single file cursor or a single cache lock.
+   *
+   * Offsets not found in the cache are read sorted by file offset (and merged into
+   * continuous ranges), the result is returned in the requested order. If the file is
+   * not memory mapped, the ranges are read by a FileBatchReader, submitting all
+   * reads at once.
    */
   template <class N>
   class DataFile
   {
   public:
     using ValueType = std::shared_ptr<N>;
-    using ValueCache = Cache<FileOffset, std::shared_ptr<N> >;
+    using ValueCache = ShardedCache<FileOffset, ValueType>;
 
-    using ValueCacheEntry = typename Cache<FileOffset, ValueType>::CacheEntry;
-    using ValueCacheRef = typename Cache<FileOffset, ValueType>::CacheRef;
+  private:
+    /**
+     * Estimates the memory of a value for the memory budget, using
+     * N::GetMemorySize() if available.
+     */
+    struct ValueMemorySizer : public ValueCache::ValueSizer
+    {
+      size_t GetSize(const ValueType& value) const override
+      {
+        if constexpr (requires(const N& object) { object.GetMemorySize(); }) {
+          return value->GetMemorySize();
+        }
+        else {
+          return sizeof(N);
+        }
+      }
+    };
 
   private:
     std::string         datafile;        //!< Basename part of the data file name
     std::string         datafilename;    //!< complete filename for data file
 
-    mutable ValueCache  cache;
-
-    mutable FileScanner scanner;         //!< File stream to the data file
+    mutable ValueCache  cache;           //!< Thread-safe cache of loaded values
 
-    mutable std::mutex  accessMutex;     //!< Mutex to secure multi-thread access
+    mutable FileScannerPool scannerPool; //!< Pool of scanners of the data file, one is borrowed per request
+    std::unique_ptr<FileBatchReader> batchReader; //!< Batched reading of multiple offsets, if the file is not memory mapped
 
   protected:
     TypeConfigRef       typeConfig;
 
   private:
-    bool ReadData(N& data) const;
-    bool ReadData(FileOffset offset,
+    bool ReadData(FileScanner& scanner,
                   N& data) const;
+    bool ReadData(FileScanner& scanner,
+                  FileOffset offset,
+                  N& data) const;
+
+    FileScannerPool::Ptr BorrowScanner() const;
+
+    bool ReadBatched(FileScanner& scanner,
+                     const std::vector<FileOffset>& offsets,
+                     std::vector<FileBatchReader::Range>& ranges,
+                     std::vector<ValueType>& values) const;
+    bool ReadSequential(FileScanner& scanner,
+                        const std::vector<FileOffset>& offsets,
+                        const std::vector<FileBatchReader::Range>& ranges,
+                        std::vector<ValueType>& values) const;
+
+    template<typename IteratorIn>
+    bool ReadPlanned(IteratorIn begin, IteratorIn end,
+                     size_t size,
+                     std::vector<ValueType>& data) const;
 
   public:
     DataFile(const std::string& datafile,
@@ -118,6 +163,12 @@ namespace osmscout {
 
     void FlushCache();
 
+    virtual void SetMemoryBudget(const MemoryBudgetRef& budget);
+    virtual void SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool);
+
+    bool Lock(FileOffset offset,
+              FileOffset length) const;
+
     std::string GetFilename() const
     {
       return datafilename;
@@ -145,11 +196,24 @@ namespace osmscout {
     template<typename IteratorIn>
     bool GetByBlockSpans(IteratorIn begin, IteratorIn end,
                          std::vector<ValueType>& data) const;
+
+    template<typename V, typename IteratorIn>
+    bool GetViewsByOffset(IteratorIn begin, IteratorIn end, size_t size,
+                          const GeoBox& boundingBox,
+                          std::vector<V>& views) const;
+
+    template<typename V, typename IteratorIn>
+    bool GetViewsByBlockSpans(IteratorIn begin, IteratorIn end,
+                              std::vector<V>& views) const;
   };
 
   template <class N>
   DataFile<N>::DataFile(const std::string& datafile, size_t cacheSize)
-  : datafile(datafile),cache(cacheSize)
+  : datafile(datafile),
+    cache(cacheSize,
+          ValueCache::DefaultShardCount,
+          ValueCache::EvictionPolicy::Clock),
+    scannerPool(std::max(4u,2*std::thread::hardware_concurrency()))
   {
     // no code
   }
@@ -165,10 +229,11 @@ namespace osmscout {
   /**
    * Read one data value from the given file offset.
    *
-   * Method is NOT thread-safe.
+   * Method is thread-safe as long as the scanner is used exclusively by the calling thread.
    */
   template <class N>
-  bool DataFile<N>::ReadData(FileOffset offset,
+  bool DataFile<N>::ReadData(FileScanner& scanner,
+                             FileOffset offset,
                              N& data) const
   {
     try {
@@ -188,10 +253,11 @@ namespace osmscout {
   /**
    * Read one data value from the current position of the stream
    *
-   * Method is NOT thread-safe.
+   * Method is thread-safe as long as the scanner is used exclusively by the calling thread.
    */
   template <class N>
-  bool DataFile<N>::ReadData(N& data) const
+  bool DataFile<N>::ReadData(FileScanner& scanner,
+                             N& data) const
   {
     try {
       data.Read(*typeConfig,
@@ -205,6 +271,23 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Borrow a scanner for exclusive use by the calling thread.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  FileScannerPool::Ptr DataFile<N>::BorrowScanner() const
+  {
+    FileScannerPool::Ptr scanner=scannerPool.Borrow();
+
+    if (!scanner) {
+      log.Error() << "Cannot get scanner for file " << datafilename << "!";
+    }
+
+    return scanner;
+  }
+
   /**
    * Open the index file.
    *
@@ -220,16 +303,31 @@ namespace osmscout {
     datafilename=AppendFileToDir(path,datafile);
 
     try {
-      scanner.Open(datafilename,
-                   FileScanner::LowMemRandom,
-                   memoryMappedData);
+      scannerPool.Open(datafilename,
+                       FileScanner::LowMemRandom,
+                       memoryMappedData);
     }
     catch (const IOException& e) {
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
+      scannerPool.Close();
       return false;
     }
 
+    if (!memoryMappedData &&
+        FileBatchReader::IsSupported()) {
+      batchReader=std::make_unique<FileBatchReader>();
+      batchReader->SetDescriptorPool(scannerPool.GetDescriptorPool());
+
+      try {
+        batchReader->Open(datafilename);
+      }
+      catch (const IOException& e) {
+        // Not fatal, we can still read object by object
+        log.Warn() << e.GetDescription();
+        batchReader.reset();
+      }
+    }
+
     return true;
   }
 
@@ -241,7 +339,7 @@ namespace osmscout {
   template <class N>
   bool DataFile<N>::IsOpen() const
   {
-    return scanner.IsOpen();
+    return scannerPool.IsOpen();
   }
 
   /**
@@ -253,27 +351,262 @@ namespace osmscout {
   bool DataFile<N>::Close()
   {
     typeConfig=nullptr;
-    cache.Flush();
+    FlushCache();
 
-    try  {
-      if (scanner.IsOpen()) {
-        scanner.Close();
+    if (batchReader) {
+      try {
+        batchReader->Close();
       }
+      catch (const IOException& e) {
+        log.Error() << e.GetDescription();
+      }
+
+      batchReader.reset();
+    }
+
+    scannerPool.Close();
+
+    return true;
+  }
+
+  template <class N>
+  void DataFile<N>::FlushCache()
+  {
+    cache.Flush();
+  }
+
+  /**
+   * Let the cache draw from the given memory budget (in addition to the
+   * entry count limit of the cache size). The cache is flushed.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  void DataFile<N>::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    cache.SetMemoryBudget(budget,
+                          datafile,
+                          std::make_shared<ValueMemorySizer>());
+  }
+
+  /**
+   * Bound the number of open files of the data file by the given (shared)
+   * descriptor pool. Has to be called before Open().
+   */
+  template <class N>
+  void DataFile<N>::SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool)
+  {
+    scannerPool.SetDescriptorPool(descriptorPool);
+  }
+
+  /**
+   * Lock the given byte range of the data file into memory, so that it
+   * stays resident until the file is closed. The data file has to be
+   * memory mapped.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  bool DataFile<N>::Lock(FileOffset offset,
+                         FileOffset length) const
+  {
+    FileScannerPool::Ptr scanner=BorrowScanner();
+
+    if (!scanner) {
+      return false;
+    }
+
+    if (!scanner->IsMemoryMapped()) {
+      log.Error() << "Cannot lock data of file " << datafilename << ", file is not memory mapped";
+      return false;
+    }
+
+    return scanner->Lock(offset,
+                         (size_t)length);
+  }
+
+  /**
+   * Read data values for the given (sorted) file offsets, using the batch reader.
+   * Objects not fitting into the planned ranges are read directly from the file.
+   *
+   * Method is thread-safe as long as the scanner is used exclusively by the calling thread.
+   */
+  template <class N>
+  bool DataFile<N>::ReadBatched(FileScanner& scanner,
+                                const std::vector<FileOffset>& offsets,
+                                std::vector<FileBatchReader::Range>& ranges,
+                                std::vector<ValueType>& values) const
+  {
+    std::vector<size_t> unread;
+
+    try {
+      batchReader->Read(ranges,[&](FileBatchReader::Range& range) {
+        for (size_t i=range.firstIndex; i<range.firstIndex+range.count; i++) {
+          scanner.AttachWindow(range.offset,
+                               range.data.data(),
+                               range.data.size());
+
+          try {
+            ValueType value=std::make_shared<N>();
+
+            scanner.SetPos(offsets[i]);
+            value->Read(*typeConfig,
+                        scanner);
+
+            values[i]=value;
+          }
+          catch (const IOException&) {
+            // Object does not fit into the window, read it directly from the file later
+            unread.push_back(i);
+          }
+
+          scanner.DetachWindow();
+        }
+      });
     }
     catch (const IOException& e) {
+      scanner.DetachWindow();
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
       return false;
     }
 
+    for (size_t i : unread) {
+      ValueType value=std::make_shared<N>();
+
+      if (!ReadData(scanner,
+                    offsets[i],
+                    *value)) {
+        log.Error() << "Error while reading data from offset " << offsets[i] << " of file " << datafilename << "!";
+        return false;
+      }
+
+      values[i]=value;
+    }
+
     return true;
   }
 
+  /**
+   * Read data values for the given (sorted) file offsets one after another.
+   * Before reading, the operating system is told about all planned ranges, so it
+   * can read them ahead while we are decoding.
+   *
+   * Method is thread-safe as long as the scanner is used exclusively by the calling thread.
+   */
   template <class N>
-  void DataFile<N>::FlushCache()
+  bool DataFile<N>::ReadSequential(FileScanner& scanner,
+                                   const std::vector<FileOffset>& offsets,
+                                   const std::vector<FileBatchReader::Range>& ranges,
+                                   std::vector<ValueType>& values) const
   {
-    std::scoped_lock<std::mutex> lock(accessMutex);
-    cache.Flush();
+    if (ranges.size()>1) {
+      for (const auto& range : ranges) {
+        scanner.WillNeed(range.offset,
+                         range.length);
+      }
+    }
+
+    for (size_t i=0; i<offsets.size(); i++) {
+      ValueType value=std::make_shared<N>();
+
+      if (!ReadData(scanner,
+                    offsets[i],
+                    *value)) {
+        log.Error() << "Error while reading data from offset " << offsets[i] << " of file " << datafilename << "!";
+        return false;
+      }
+
+      values[i]=value;
+    }
+
+    return true;
+  }
+
+  /**
+   * Read data values for the given file offsets. Values not found in the cache
+   * are read in the order of their file offsets (each offset once), with near offsets
+   * merged into continuous ranges, instead of jumping around in the file in the order
+   * of the request. Result is appended to data in the order of the given offsets.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  template<typename IteratorIn>
+  bool DataFile<N>::ReadPlanned(IteratorIn begin, IteratorIn end,
+                                size_t size,
+                                std::vector<ValueType>& data) const
+  {
+    std::vector<ValueType>  result;
+    std::vector<FileOffset> missing;
+
+    // Results are collected locally, so data is not touched if reading fails
+    result.reserve(size);
+
+    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
+      ValueType value;
+
+      if (!cache.GetEntry(*offsetIter,value)) {
+        missing.push_back(*offsetIter);
+      }
+
+      result.push_back(value);
+    }
+
+    if (missing.empty()) {
+      data.insert(data.end(),
+                  std::make_move_iterator(result.begin()),
+                  std::make_move_iterator(result.end()));
+
+      return true;
+    }
+
+    std::sort(missing.begin(),missing.end());
+    missing.erase(std::unique(missing.begin(),missing.end()),missing.end());
+
+    FileScannerPool::Ptr scanner=BorrowScanner();
+
+    if (!scanner) {
+      return false;
+    }
+
+    std::vector<FileBatchReader::Range> ranges=FileBatchReader::PlanRanges(missing,
+                                                                           scanner->GetSize());
+    std::vector<ValueType>              values(missing.size());
+
+    if (batchReader && missing.size()>1) {
+      if (!ReadBatched(*scanner,
+                       missing,
+                       ranges,
+                       values)) {
+        return false;
+      }
+    }
+    else if (!ReadSequential(*scanner,
+                             missing,
+                             ranges,
+                             values)) {
+      return false;
+    }
+
+    for (size_t i=0; i<missing.size(); i++) {
+      cache.SetEntry(missing[i],values[i]);
+    }
+
+    size_t index=0;
+
+    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter, ++index) {
+      if (!result[index]) {
+        auto missingIter=std::lower_bound(missing.begin(),missing.end(),*offsetIter);
+
+        result[index]=values[missingIter-missing.begin()];
+      }
+    }
+
+    data.insert(data.end(),
+                std::make_move_iterator(result.begin()),
+                std::make_move_iterator(result.end()));
+
+    return true;
   }
 
   /**
@@ -309,35 +642,15 @@ namespace osmscout {
       return true;
     }
 
-    data.reserve(data.size()+size);
-    std::scoped_lock<std::mutex> lock(accessMutex);
-
     if (cache.GetMaxSize()>0 &&
         size>cache.GetMaxSize()){
       log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
     }
 
-    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
-      ValueCacheRef entryRef;
-
-      if (cache.GetEntry(*offsetIter,entryRef)) {
-        data.push_back(entryRef->value);
-      }
-      else {
-        ValueType value=std::make_shared<N>();
-
-        if (!ReadData(*offsetIter,
-                      *value)) {
-          log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
-          return false;
-        }
-
-        cache.SetEntry(ValueCacheEntry(*offsetIter,value));
-        data.push_back(value);
-      }
-    }
-
-    return true;
+    return ReadPlanned(begin,
+                       end,
+                       size,
+                       data);
   }
 
   /**
@@ -357,32 +670,25 @@ namespace osmscout {
     }
 
     data.reserve(data.size()+size);
-    std::scoped_lock<std::mutex> lock(accessMutex);
 
     if (cache.GetMaxSize()>0 &&
         size>cache.GetMaxSize()){
       log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
     }
 
+    std::vector<ValueType> values;
+
+    if (!ReadPlanned(begin,
+                     end,
+                     size,
+                     values)) {
+      return false;
+    }
+
     //std::map<std::string,size_t> hitRateTypes;
     //std::map<std::string,size_t> missRateTypes;
     size_t inBoxCount=0;
-    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
-      ValueType value=std::make_shared<N>();
-
-      ValueCacheRef entryRef;
-      if (cache.GetEntry(*offsetIter,entryRef)){
-        value=entryRef->value;
-      }else{
-        if (!ReadData(*offsetIter,
-                      *value)) {
-          log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
-          return false;
-        }
-
-        cache.SetEntry(ValueCacheEntry(*offsetIter,value));
-      }
-
+    for (const auto& value : values) {
       if (!value->Intersects(boundingBox)) {
         //missRateTypes[value->GetType()->GetName()]++;
         continue;
@@ -451,25 +757,28 @@ namespace osmscout {
   bool DataFile<N>::GetByOffset(FileOffset offset,
                                 ValueType& entry) const
   {
-    std::scoped_lock<std::mutex> lock(accessMutex);
+    if (cache.GetEntry(offset,entry)) {
+      return true;
+    }
 
-    ValueCacheRef entryRef;
-    if (cache.GetEntry(offset,entryRef)){
-      entry=entryRef->value;
-    }else{
-      ValueType value=std::make_shared<N>();
+    FileScannerPool::Ptr scanner=BorrowScanner();
 
-      if (!ReadData(offset,
-                    *value)) {
-        log.Error() << "Error while reading data from offset " << offset << " of file " << datafilename << "!";
-        // TODO: Remove broken entry from cache
-        return false;
-      }
+    if (!scanner) {
+      return false;
+    }
 
-      cache.SetEntry(ValueCacheEntry(offset,value));
-      entry=value;
+    ValueType value=std::make_shared<N>();
+
+    if (!ReadData(*scanner,
+                  offset,
+                  *value)) {
+      log.Error() << "Error while reading data from offset " << offset << " of file " << datafilename << "!";
+      return false;
     }
 
+    cache.SetEntry(offset,value);
+    entry=value;
+
     return true;
   }
 
@@ -486,45 +795,9 @@ namespace osmscout {
       return true;
     }
 
-    std::scoped_lock<std::mutex> lock(accessMutex);
-
-    try {
-      bool offsetSetup=false;
-      FileOffset offset=span.startOffset;
-
-      data.reserve(data.size()+span.count);
-
-      for (uint32_t i=1; i<=span.count; i++) {
-        ValueCacheRef entryRef;
-        if (cache.GetEntry(offset,entryRef)){
-          data.push_back(entryRef->value);
-          offset=entryRef->value->GetNextFileOffset();
-          offsetSetup=false;
-        }else{
-          if (!offsetSetup){
-            scanner.SetPos(offset);
-          }
-
-          ValueType value=std::make_shared<N>();
-
-          if (!ReadData(*value)) {
-            log.Error() << "Error while reading data #" << i << " starting from offset " << span.startOffset << " of file " << datafilename << "!";
-            return false;
-          }
-
-          cache.SetEntry(ValueCacheEntry(offset,value));
-          offset=value->GetNextFileOffset();
-          offsetSetup=true;
-          data.push_back(value);
-        }
-      }
-
-      return true;
-    }
-    catch (const IOException& e) {
-      log.Error() << e.GetDescription();
-      return false;
-    }
+    return GetByBlockSpans(&span,
+                           &span+1,
+                           data);
   }
 
   /**
@@ -545,8 +818,9 @@ namespace osmscout {
 
     data.reserve(data.size()+overallCount);
 
+    FileScannerPool::Ptr scanner;
+
     try {
-      std::scoped_lock<std::mutex> lock(accessMutex);
       for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
         if (spanIter->count==0) {
           continue;
@@ -556,25 +830,31 @@ namespace osmscout {
         FileOffset offset=spanIter->startOffset;
 
         for (uint32_t i=1; i<=spanIter->count; i++) {
-          ValueCacheRef entryRef;
-          if (cache.GetEntry(offset,entryRef)){
-            data.push_back(entryRef->value);
-            offset=entryRef->value->GetNextFileOffset();
+          ValueType value;
+
+          if (cache.GetEntry(offset,value)){
+            data.push_back(value);
+            offset=value->GetNextFileOffset();
             offsetSetup=false;
           }else{
+            if (!scanner && !(scanner=BorrowScanner())) {
+              return false;
+            }
+
             if (!offsetSetup){
-              scanner.SetPos(offset);
+              scanner->SetPos(offset);
             }
 
-            ValueType value=std::make_shared<N>();
+            value=std::make_shared<N>();
 
-            if (!ReadData(*value)) {
+            if (!ReadData(*scanner,
+                          *value)) {
               log.Error() << "Error while reading data #" << i << " starting from offset " << spanIter->startOffset <<
               " of file " << datafilename << "!";
               return false;
             }
 
-            cache.SetEntry(ValueCacheEntry(offset,value));
+            cache.SetEntry(offset,value);
             offset=value->GetNextFileOffset();
             offsetSetup=true;
             data.push_back(value);
@@ -590,6 +870,123 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Read read-only views (like WayView or AreaView) of the objects at the given
+   * file offsets, dropping the ones not intersecting the given bounding box.
+   *
+   * Views reference the encoded data inside the file mapping, so the data file
+   * has to be opened memory mapped. Views are not cached.
+   *
+   * @tparam V
+   *    View type, it has to provide Read(const TypeConfig&, FileScanner&) and Intersects(const GeoBox&)
+   * @return
+   *    false if there was an error (or the file is not memory mapped), else true
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  template<typename V, typename IteratorIn>
+  bool DataFile<N>::GetViewsByOffset(IteratorIn begin, IteratorIn end,
+                                     size_t size,
+                                     const GeoBox& boundingBox,
+                                     std::vector<V>& views) const
+  {
+    if (size==0) {
+      return true;
+    }
+
+    FileScannerPool::Ptr scanner=BorrowScanner();
+
+    if (!scanner) {
+      return false;
+    }
+
+    if (!scanner->IsMemoryMapped()) {
+      log.Error() << "Cannot read views from file " << datafilename << ", it is not memory mapped";
+      return false;
+    }
+
+    views.reserve(views.size()+size);
+
+    try {
+      for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
+        V view;
+
+        scanner->SetPos(*offsetIter);
+        view.Read(*typeConfig,
+                  *scanner);
+
+        if (view.Intersects(boundingBox)) {
+          views.push_back(std::move(view));
+        }
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Read read-only views (like WayView or AreaView) of the objects in the given
+   * DataBlockSpans. See GetViewsByOffset() for requirements.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  template<typename V, typename IteratorIn>
+  bool DataFile<N>::GetViewsByBlockSpans(IteratorIn begin, IteratorIn end,
+                                         std::vector<V>& views) const
+  {
+    uint32_t overallCount=0;
+
+    for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
+      overallCount+=spanIter->count;
+    }
+
+    if (overallCount==0) {
+      return true;
+    }
+
+    FileScannerPool::Ptr scanner=BorrowScanner();
+
+    if (!scanner) {
+      return false;
+    }
+
+    if (!scanner->IsMemoryMapped()) {
+      log.Error() << "Cannot read views from file " << datafilename << ", it is not memory mapped";
+      return false;
+    }
+
+    views.reserve(views.size()+overallCount);
+
+    try {
+      for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
+        if (spanIter->count==0) {
+          continue;
+        }
+
+        scanner->SetPos(spanIter->startOffset);
+
+        for (uint32_t i=1; i<=spanIter->count; i++) {
+          V& view=views.emplace_back();
+
+          view.Read(*typeConfig,
+                    *scanner);
+        }
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
   /**
    * \ingroup Database
    *
@@ -623,6 +1020,9 @@ namespace osmscout {
 
     bool IsOpen() const override;
 
+    void SetMemoryBudget(const MemoryBudgetRef& budget) override;
+    void SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool) override;
+
     bool GetOffset(I id,
                    FileOffset& offset) const;
 
@@ -695,6 +1095,28 @@ namespace osmscout {
            index.IsOpen();
   }
 
+  /**
+   * Let the data cache and the index page caches draw from the given memory budget.
+   * Has to be called before Open().
+   */
+  template <class I, class N>
+  void IndexedDataFile<I,N>::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    DataFile<N>::SetMemoryBudget(budget);
+    index.SetMemoryBudget(budget);
+  }
+
+  /**
+   * Bound the number of open files of the data file and of the index by the
+   * given (shared) descriptor pool. Has to be called before Open().
+   */
+  template <class I, class N>
+  void IndexedDataFile<I,N>::SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool)
+  {
+    DataFile<N>::SetFileDescriptorPool(descriptorPool);
+    index.SetFileDescriptorPool(descriptorPool);
+  }
+
   template <class I, class N>
   template<typename IteratorIn>
   bool IndexedDataFile<I,N>::GetOffsets(IteratorIn begin, IteratorIn end, size_t size,
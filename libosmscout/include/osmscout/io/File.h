@@ -113,6 +113,17 @@ namespace osmscout {
   extern OSMSCOUT_API bool IsDirectory(const std::string& filename);
 
   extern OSMSCOUT_API bool ReadFile(const std::string& filename, std::vector<char>& content);
+
+  /**
+   * \ingroup File
+   *
+   * Return the number of bytes of the given file, that are currently resident
+   * in the page cache of the operating system. The result has page granularity,
+   * but never exceeds the file size.
+   *
+   * @throws IOException if the file cannot be accessed or if the function is not implemented.
+   */
+  extern OSMSCOUT_API FileOffset GetFileResidentSize(const std::string& filename);
 }
 
 #endif
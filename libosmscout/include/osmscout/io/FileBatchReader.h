@@ -0,0 +1,150 @@
+#ifndef OSMSCOUT_FILEBATCHREADER_H
+#define OSMSCOUT_FILEBATCHREADER_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+#include <osmscout/system/Compiler.h>
+
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/io/FileDescriptorPool.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup File
+   *
+   * Batched random read access to a file, for data files that are not memory mapped.
+   *
+   * All ranges of one batch are submitted at once, so the storage can process
+   * them in parallel, instead of one seek and read per object. On Linux io_uring
+   * is used (if supported by the kernel), elsewhere (or as fallback) the ranges
+   * are read by a pool of threads using pread.
+   *
+   * The completion callback is always called from the thread calling Read(),
+   * in the order the ranges complete.
+   *
+   * The io_uring rings and the threads of the fallback pool are shared by all
+   * readers of the process. The file descriptor of the reader can be bounded
+   * by a FileDescriptorPool (see SetDescriptorPool()).
+   */
+  class OSMSCOUT_API FileBatchReader CLASS_FINAL
+  {
+  public:
+    enum class Backend
+    {
+      None,
+      IoUring,
+      ThreadPool
+    };
+
+    /**
+     * One continuous range of the file to read
+     */
+    struct Range
+    {
+      FileOffset        offset=0;     //!< File offset of the first byte of the range
+      size_t            length=0;     //!< Number of bytes to read
+      size_t            firstIndex=0; //!< Index of the first planned offset covered by the range
+      size_t            count=0;      //!< Number of planned offsets covered by the range
+      std::vector<char> data;         //!< Data of the range, shorter than length only at the end of file
+    };
+
+    using CompletionCallback = std::function<void(Range& range)>;
+
+    static constexpr size_t DefaultReadAhead=4096;
+    static constexpr size_t DefaultMaxRangeSize=256*1024;
+    static constexpr size_t DefaultThreadCount=4;
+
+  private:
+    class IoUring;
+    class IoUringPool;
+    class Context;
+
+    using ContextRef = std::shared_ptr<Context>;
+
+  private:
+    std::string                  filename;        //!< Filename
+    int                          fd=-1;           //!< File descriptor used for all reads
+    FileOffset                   size=0;          //!< Size of the file
+    Backend                      backend=Backend::None;
+    FileDescriptorPoolRef        descriptorPool;  //!< Optional bound for the number of open files
+
+    size_t                       threadCount;     //!< Minimum number of threads of the fallback pool
+    ContextRef                   context;         //!< Rings and threads shared by all readers
+
+  private:
+    static ContextRef GetContext();
+
+    void ReadUsingIoUring(std::vector<Range>& ranges,
+                          const CompletionCallback& callback);
+    void ReadUsingThreads(std::vector<Range>& ranges,
+                          const CompletionCallback& callback);
+
+  public:
+    explicit FileBatchReader(size_t threadCount=DefaultThreadCount);
+
+    FileBatchReader(const FileBatchReader&) = delete;
+    FileBatchReader(FileBatchReader&&) = delete;
+    FileBatchReader& operator=(const FileBatchReader&) = delete;
+    FileBatchReader& operator=(FileBatchReader&&) = delete;
+
+    ~FileBatchReader();
+
+    static bool IsSupported();
+
+    void SetDescriptorPool(const FileDescriptorPoolRef& descriptorPool);
+
+    void Open(const std::string& filename,
+              bool useIoUring=true);
+    void Close();
+
+    bool IsOpen() const
+    {
+      return fd>=0;
+    }
+
+    Backend GetBackend() const
+    {
+      return backend;
+    }
+
+    FileOffset GetSize() const
+    {
+      return size;
+    }
+
+    static std::vector<Range> PlanRanges(const std::vector<FileOffset>& sortedOffsets,
+                                         FileOffset fileSize,
+                                         size_t readAhead=DefaultReadAhead,
+                                         size_t maxRangeSize=DefaultMaxRangeSize);
+
+    void Read(std::vector<Range>& ranges,
+              const CompletionCallback& callback);
+  };
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef OSMSCOUT_FILEDESCRIPTORPOOL_H
+#define OSMSCOUT_FILEDESCRIPTORPOOL_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup File
+   *
+   * Upper bound for the number of file descriptors held by multiple FileScannerPool
+   * instances (clients), usually shared by all databases of a process.
+   *
+   * Every open file of a client takes a slot of the pool. If there is no free slot,
+   * the pool asks the other clients to close their idle (pooled, but not borrowed)
+   * files. If still no slot is free, the request waits until a slot is released,
+   * but at most for the given timeout. While requests are waiting, clients should
+   * close files instead of pooling them (see HasWaiters()).
+   *
+   * The class is thread-safe.
+   */
+  class OSMSCOUT_API FileDescriptorPool CLASS_FINAL
+  {
+  public:
+    /**
+     * Interface to be implemented by clients of the pool
+     */
+    class OSMSCOUT_API Client
+    {
+    public:
+      virtual ~Client() = default;
+
+      /**
+       * Close idle files without blocking and release their slots.
+       *
+       * @return number of closed files
+       */
+      virtual size_t CloseIdle() noexcept = 0;
+    };
+
+  private:
+    size_t                    maxOpen;      //!< Maximum number of open files
+    std::chrono::milliseconds timeout;      //!< Maximum time to wait for a free slot
+    size_t                    open=0;       //!< Number of slots in use
+    size_t                    waiting=0;    //!< Number of requests waiting for a slot
+
+    mutable std::mutex        mutex;        //!< Guards the counters
+    std::condition_variable   released;     //!< Signaled, if a slot is released
+
+    std::mutex                clientMutex;  //!< Guards clients and serializes closing of idle files
+    std::vector<Client*>      clients;      //!< Registered clients
+
+  private:
+    bool TryAcquire();
+
+  public:
+    explicit FileDescriptorPool(size_t maxOpen,
+                                std::chrono::milliseconds timeout=std::chrono::seconds(10));
+
+    // disable copy and move
+    FileDescriptorPool(const FileDescriptorPool&) = delete;
+    FileDescriptorPool(FileDescriptorPool&&) = delete;
+    FileDescriptorPool& operator=(const FileDescriptorPool&) = delete;
+    FileDescriptorPool& operator=(FileDescriptorPool&&) = delete;
+
+    ~FileDescriptorPool() = default;
+
+    void Register(Client& client);
+    void Unregister(Client& client);
+
+    bool Acquire(const Client* requester);
+    void Release();
+
+    bool HasWaiters() const;
+
+    size_t GetMaxOpen() const
+    {
+      return maxOpen;
+    }
+
+    size_t GetOpen() const;
+  };
+
+  //! Reference counted reference to a FileDescriptorPool instance
+  using FileDescriptorPoolRef = std::shared_ptr<FileDescriptorPool>;
+}
+
+#endif
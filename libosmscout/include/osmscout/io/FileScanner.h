@@ -21,6 +21,7 @@
 */
 
 #include <cstdio>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -38,6 +39,9 @@
 #include <osmscout/util/GeoBox.h>
 #include <osmscout/util/Geometry.h>
 
+#include <osmscout/io/CoordArrayView.h>
+#include <osmscout/io/CoordEncoding.h>
+
 #if defined(_WIN32)
   #include <windows.h>
   #undef max
@@ -76,13 +80,23 @@ namespace osmscout {
 
     // For mmap usage
     char         *mmap=nullptr;       //!< Pointer to the file memory
+    std::shared_ptr<char> mapping;    //!< Owner of the file memory, may be shared with other scanners
     FileOffset   size=0;              //!< Size of the memory/file
     FileOffset   offset=0;            //!< Current offset into the file memory
 
+    // For window usage (see AttachWindow())
+    bool         windowAttached=false; //!< Flag, if a window is attached (mmap then points to the window data)
+    FileOffset   windowStart=0;       //!< File offset of the first byte of the window
+    FileOffset   fileSize=0;          //!< Size of the file, while the window is attached
+
     // For std::vector<GeoCoord> loading
     uint8_t      *byteBuffer=nullptr; //!< Temporary buffer for loading of std::vector<GeoCoord>
     size_t       byteBufferSize=0;    //!< Size of the temporary byte buffer
 
+    // For stream-vbyte encoded std::vector<Point> loading
+    std::vector<uint8_t>  controlBuffer; //!< Copy of the control bytes, if the file is not memory mapped
+    std::vector<uint32_t> coordBuffer;   //!< Decoded raw coordinate values
+
     // For Windows mmap usage
 #if defined(__WIN32__) || defined(WIN32)
     HANDLE       mmfHandle=0;
@@ -106,6 +120,15 @@ namespace osmscout {
      */
     char* ReadInternal(size_t bytes);
 
+    bool ReadCoordArrayHeader(bool readIds,
+                              size_t& nodeCount,
+                              size_t& coordBitSize,
+                              bool& hasNodes);
+
+    void ReadStreamVByteCoords(std::vector<Point>& nodes,
+                               uint32_t lat,
+                               uint32_t lon);
+
     /**
      * Set coordinates using raw data from file.
      *
@@ -187,6 +210,7 @@ namespace osmscout {
     void Open(const std::string& filename,
               Mode mode,
               bool useMmap);
+    void OpenShared(const FileScanner& scanner);
     void Close();
     void CloseFailsafe();
 
@@ -204,10 +228,53 @@ namespace osmscout {
 
     std::string GetFilename() const;
 
+    /**
+     * Returns true, if the file is memory mapped
+     */
+    bool IsMemoryMapped() const
+    {
+      return mapping!=nullptr;
+    }
+
+    /**
+     * Returns true, if a window is attached
+     */
+    bool IsWindowAttached() const
+    {
+      return windowAttached;
+    }
+
+    /**
+     * Returns the memory mapping of the file (or nullptr, if file is not mapped).
+     * Holding the returned pointer keeps the mapping alive, even after the scanner is closed.
+     */
+    std::shared_ptr<const char> GetMapping() const
+    {
+      return mapping;
+    }
+
+    void AttachWindow(FileOffset start,
+                      const char* data,
+                      size_t length);
+    void DetachWindow();
+
     void GotoBegin();
     void SetPos(FileOffset pos);
     FileOffset GetPos() const;
 
+    /**
+     * Returns the size of the file
+     */
+    FileOffset GetSize() const
+    {
+      return windowAttached ? fileSize : size;
+    }
+
+    void WillNeed(FileOffset pos,
+                  size_t length);
+    bool Lock(FileOffset pos,
+              size_t length);
+
     void Read(char* buffer, size_t bytes);
 
     std::string ReadString();
@@ -261,6 +328,25 @@ namespace osmscout {
               GeoBox &bbox,
               bool readIds);
 
+    /**
+     * Reads vector of Point as a view into the memory mapped file, without decoding it.
+     * Node serials are skipped.
+     *
+     * Works just for memory mapped files, throws IOException otherwise.
+     *
+     * @param readIds
+     *    true, if the array was written with node serials
+     */
+    CoordArrayView ReadCoordArrayView(bool readIds);
+
+    /**
+     * Like ReadCoordArrayView(bool), but additionally returns, if the first
+     * and the last node have a serial (see Point::IsRelevant()).
+     */
+    CoordArrayView ReadCoordArrayView(bool readIds,
+                                      bool& isFrontRelevant,
+                                      bool& isBackRelevant);
+
     GeoBox ReadBox();
 
     TypeId ReadTypeId(uint8_t maxBytes);
@@ -0,0 +1,100 @@
+#ifndef OSMSCOUT_FILESCANNERPOOL_H
+#define OSMSCOUT_FILESCANNERPOOL_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <string>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/util/ObjectPool.h>
+
+#include <osmscout/io/FileDescriptorPool.h>
+#include <osmscout/io/FileScanner.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup File
+   *
+   * Pool of FileScanner instances, all opened for the same file.
+   *
+   * Each borrowed scanner has its own file position, so multiple threads
+   * may read from the same file concurrently without sharing one cursor.
+   * When memory mapping is enabled, the file is mapped just once (by the pool)
+   * and all scanners share this mapping.
+   *
+   * Scanners not in use are kept in the pool (up to the given max size)
+   * to avoid reopening the file for every request.
+   *
+   * Optionally the number of open files can be bounded by a FileDescriptorPool
+   * shared with other pools (see SetDescriptorPool()).
+   */
+  class OSMSCOUT_API FileScannerPool: public ObjectPool<FileScanner>,
+                                      public FileDescriptorPool::Client
+  {
+  private:
+    std::unique_ptr<FileScanner> mappedScanner;  //!< Scanner owning the (shared) mapping, never borrowed
+    FileDescriptorPoolRef        descriptorPool; //!< Optional bound for the number of open files
+
+  private:
+    FileScanner* OpenScanner() noexcept;
+
+  public:
+    explicit FileScannerPool(size_t maxSize);
+
+    FileScannerPool(const FileScannerPool&) = delete;
+    FileScannerPool(FileScannerPool&&) = delete;
+    FileScannerPool& operator=(const FileScannerPool&) = delete;
+    FileScannerPool& operator=(FileScannerPool&&) = delete;
+
+    ~FileScannerPool() override;
+
+    void SetDescriptorPool(const FileDescriptorPoolRef& descriptorPool);
+
+    FileDescriptorPoolRef GetDescriptorPool() const
+    {
+      return descriptorPool;
+    }
+
+    void Open(const std::string& filename,
+              FileScanner::Mode mode,
+              bool memoryMapped);
+    void Close();
+
+    bool IsOpen() const
+    {
+      return mappedScanner!=nullptr;
+    }
+
+    Ptr Borrow() override;
+
+    FileScanner* MakeNew() noexcept override;
+
+    void Destroy(FileScanner* scanner) noexcept override;
+
+    bool IsValid(FileScanner* scanner) noexcept override;
+
+    size_t CloseIdle() noexcept override;
+  };
+}
+
+#endif
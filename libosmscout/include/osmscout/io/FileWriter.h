@@ -36,6 +36,8 @@
 #include <osmscout/util/Exception.h>
 #include <osmscout/util/GeoBox.h>
 
+#include <osmscout/io/CoordEncoding.h>
+
 namespace osmscout {
 
   /**
@@ -53,6 +55,7 @@ namespace osmscout {
     bool                 hasError=true; //!< Flag for signaling that the stream has errors
     std::vector<int32_t> deltaBuffer;   //!< Temporary storage for deltas for storing of std::vector<GeoCoord>
     std::vector<uint8_t> byteBuffer;    //!< Temporary data buffer for storing of std::vector<GeoCoord>
+    CoordEncoding        coordEncoding=CoordEncoding::fixedWidth; //!< Encoding of node arrays
 
   public:
     static const uint64_t MAX_NODES;
@@ -76,6 +79,20 @@ namespace osmscout {
 
     std::string GetFilename() const;
 
+    /**
+     * Sets the encoding of the coordinate deltas for following calls
+     * of Write(const std::vector<Point>&,bool).
+     */
+    void SetCoordEncoding(CoordEncoding encoding)
+    {
+      coordEncoding=encoding;
+    }
+
+    CoordEncoding GetCoordEncoding() const
+    {
+      return coordEncoding;
+    }
+
     FileOffset GetPos();
     void SetPos(FileOffset pos);
     void GotoBegin();
@@ -20,16 +20,20 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
-#include <mutex>
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <thread>
 #include <vector>
 
-#include <osmscout/util/Cache.h>
+#include <osmscout/util/ShardedCache.h>
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/Number.h>
 #include <osmscout/util/String.h>
 
 #include <osmscout/io/File.h>
 #include <osmscout/io/FileScanner.h>
+#include <osmscout/io/FileScannerPool.h>
 
 namespace osmscout {
 
@@ -37,6 +41,12 @@ namespace osmscout {
     \ingroup Database
     Numeric index handles an index over instance of class <T> where the index criteria
     is of type <N>, where <N> has a numeric nature (usually Id).
+
+    On Open() the top levels of the index (as many as fit into the cache size) are
+    loaded and the entries of the deepest of these levels are stored in one array in
+    Eytzinger (BFS) order. A lookup searches this array branchless, so the loaded
+    levels are skipped completely. Pages of the remaining levels are read on demand
+    and cached in thread-safe caches (one per level). Lookups do not need a global lock.
     */
   template <class N>
   class NumericIndex
@@ -61,44 +71,47 @@ namespace osmscout {
       }
     };
 
-    using PageRef         = std::shared_ptr<Page>;
-    using PageCache       = Cache<N, PageRef>;
-    using PageSimpleCache = std::unordered_map<N, PageRef>;
+    using PageRef   = std::shared_ptr<Page>;
+    using PageCache = ShardedCache<FileOffset, PageRef>;
 
-    /**
-      Returns the size of a individual cache entry
-      */
-    struct NumericIndexCacheValueSizer : public PageCache::ValueSizer
+    struct PageMemorySizer : public PageCache::ValueSizer
     {
-      size_t GetSize(const PageRef& value) const
+      size_t GetSize(const PageRef& value) const override
       {
-        return sizeof(value)+sizeof(Page)+sizeof(Entry)*value->entries.size();
+        return sizeof(Page)+value->entries.capacity()*sizeof(Entry);
       }
     };
 
   private:
-    std::string                         filepart;             //!< Name of the index file
-    std::string                         filename;             //!< Complete file name including directory
+    std::string                          filepart;            //!< Name of the index file
+    std::string                          filename;            //!< Complete file name including directory
 
-    mutable FileScanner                  scanner;             //!< FileScanner instance for file access
+    mutable FileScannerPool              scannerPool;         //!< Pool of scanners of the index file
 
     size_t                               cacheSize;           //!< Maximum umber of index pages cached
     uint32_t                             pageSize=0;          //!< Size of one page as stated by the actual index file
     uint32_t                             levels=0;            //!< Number of index levels as stated by the actual index file
-    std::vector<uint32_t>                pageCounts;          //!< Number of pages per level as stated by the actual index file
-    char                                 *buffer=nullptr;     //!< Temporary buffer for reading page data
-
-    PageRef                              root;                //!< Reference to the root page
-    size_t                               simpleCacheMaxLevel; //!< Maximum level for simple caching
-    mutable std::vector<PageSimpleCache> simplePageCache;     //!< Simple map to cache all entries
-    mutable std::vector<PageCache>       pageCaches;          //!< Complex cache with LRU characteristics
+    std::vector<uint32_t>                pageCounts;          //!< Number of pages per level (root level first) as stated by the actual index file
 
-    mutable std::mutex                   accessMutex;         //!< Mutex to secure multi-thread access
+    size_t                               flatLevels=0;        //!< Number of top levels covered by the flat entries
+    std::vector<N>                       flatIds;             //!< Start ids of the deepest loaded level in Eytzinger order, index 0 is unused
+    std::vector<FileOffset>              flatOffsets;         //!< File offsets matching flatIds
+    std::vector<std::unique_ptr<PageCache>> pageCaches;       //!< Caches of pages per level below the loaded levels, by page file offset
+    MemoryBudgetRef                      memoryBudget;        //!< Optional memory budget of the page caches
 
   private:
     size_t GetPageIndex(const Page& page, N id) const;
-    void ReadPage(FileOffset offset, PageRef& page) const;
-    void InitializeCache();
+    void ReadPage(FileScanner& scanner,
+                  FileOffset offset,
+                  PageRef& page) const;
+    size_t BuildEytzinger(const std::vector<Entry>& entries,
+                          size_t index,
+                          size_t node);
+    void LoadTopLevels(FileScanner& scanner,
+                       FileOffset rootPageOffset);
+    bool SearchTopLevels(N id,
+                         N& startId,
+                         FileOffset& offset) const;
 
   public:
     NumericIndex(const std::string& filename,
@@ -111,6 +124,9 @@ namespace osmscout {
 
     bool IsOpen() const;
 
+    void SetMemoryBudget(const MemoryBudgetRef& budget);
+    void SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool);
+
     bool GetOffset(const N& id, FileOffset& offset) const;
 
     template<typename IteratorIn>
@@ -126,6 +142,7 @@ namespace osmscout {
   NumericIndex<N>::NumericIndex(const std::string& filename,
                                 size_t cacheSize)
    : filepart(filename),
+     scannerPool(std::max(4u,2*std::thread::hardware_concurrency())),
      cacheSize(cacheSize)
   {
     // no code
@@ -135,8 +152,6 @@ namespace osmscout {
   NumericIndex<N>::~NumericIndex()
   {
     Close();
-
-    delete [] buffer;
   }
 
   /**
@@ -178,7 +193,9 @@ namespace osmscout {
   }
 
   template <class N>
-  inline void NumericIndex<N>::ReadPage(FileOffset offset, PageRef& page) const
+  inline void NumericIndex<N>::ReadPage(FileScanner& scanner,
+                                        FileOffset offset,
+                                        PageRef& page) const
   {
     if (!page) {
       page=std::make_shared<Page>();
@@ -189,9 +206,11 @@ namespace osmscout {
 
     page->entries.reserve(pageSize/4);
 
+    std::vector<char> buffer(pageSize);
+
     scanner.SetPos(offset);
 
-    scanner.Read(buffer,
+    scanner.Read(buffer.data(),
                  pageSize);
 
     size_t     currentPos=0;
@@ -230,43 +249,134 @@ namespace osmscout {
     }
   }
 
+  /**
+    Store the sorted entries in Eytzinger order, recursively following the in-order
+    traversal of the implicit binary tree (children of node k are 2k and 2k+1).
+
+    @return the index of the next sorted entry to store
+    */
   template <class N>
-  void NumericIndex<N>::InitializeCache()
+  size_t NumericIndex<N>::BuildEytzinger(const std::vector<Entry>& entries,
+                                         size_t index,
+                                         size_t node)
   {
-    size_t currentCacheSize=cacheSize; // Available free space in cache
-    size_t requiredCacheSize=0;        // Space needed for caching everything
+    if (node<flatIds.size()) {
+      index=BuildEytzinger(entries,index,2*node);
 
-    for (const auto count : pageCounts) {
-      requiredCacheSize+=count;
+      flatIds[node]=entries[index].startId;
+      flatOffsets[node]=entries[index].fileOffset;
+      index++;
+
+      index=BuildEytzinger(entries,index,2*node+1);
     }
 
-    if (requiredCacheSize>cacheSize) {
-      log.Warn() << "Warning: Index " << filepart << " has cache size " << cacheSize<< ", but requires cache size " << requiredCacheSize << " to load index completely into cache!";
+    return index;
+  }
+
+  /**
+    Load the root page and as many of the following levels as fit into the
+    cache size (counted in pages). The entries of a level are globally sorted,
+    so only the entries of the deepest loaded level are kept. The remaining
+    cache size is distributed top down to the page caches of the levels below.
+    */
+  template <class N>
+  void NumericIndex<N>::LoadTopLevels(FileScanner& scanner,
+                                      FileOffset rootPageOffset)
+  {
+    std::vector<Entry> levelEntries;
+    size_t             remainingCacheSize=cacheSize;
+    PageRef            page;
+
+    flatLevels=0;
+
+    if (levels>0) {
+      ReadPage(scanner,rootPageOffset,page);
+
+      levelEntries=page->entries;
+      flatLevels=1;
     }
 
-    simpleCacheMaxLevel=0;
-    for (size_t level=1; level<pageCounts.size(); level++) {
-      size_t resultingCacheSize; // Cache size we actually use for this level
+    while (flatLevels<levels &&
+           pageCounts[flatLevels]<=remainingCacheSize) {
+      std::vector<Entry> nextLevelEntries;
 
-      simplePageCache.push_back(PageSimpleCache());
+      remainingCacheSize-=pageCounts[flatLevels];
 
-      if (pageCounts[level]>currentCacheSize) {
-        resultingCacheSize=currentCacheSize;
-        currentCacheSize=0;
+      for (const auto& entry : levelEntries) {
+        ReadPage(scanner,entry.fileOffset,page);
 
-        pageCaches.push_back(PageCache(resultingCacheSize));
+        nextLevelEntries.insert(nextLevelEntries.end(),
+                                page->entries.begin(),
+                                page->entries.end());
       }
-      else {
-        resultingCacheSize=pageCounts[level];
-        currentCacheSize-=pageCounts[level];
 
-        simpleCacheMaxLevel=level;
+      levelEntries.swap(nextLevelEntries);
+      flatLevels++;
+    }
+
+    if (flatLevels<levels) {
+      size_t requiredCacheSize=0; // Space needed for caching everything
 
-        pageCaches.push_back(PageCache(0));
+      for (size_t level=1; level<levels; level++) {
+        requiredCacheSize+=pageCounts[level];
+      }
+
+      log.Warn() << "Warning: Index " << filepart << " has cache size " << cacheSize<< ", but requires cache size " << requiredCacheSize << " to load index completely into cache!";
+    }
+
+    flatIds.assign(levelEntries.size()+1,0);
+    flatOffsets.assign(levelEntries.size()+1,0);
+
+    BuildEytzinger(levelEntries,0,1);
+
+    pageCaches.clear();
+
+    for (size_t level=flatLevels; level<levels; level++) {
+      size_t levelCacheSize=std::min((size_t)pageCounts[level],remainingCacheSize);
+
+      remainingCacheSize-=levelCacheSize;
+
+      pageCaches.push_back(std::make_unique<PageCache>(levelCacheSize));
+
+      if (memoryBudget) {
+        pageCaches.back()->SetMemoryBudget(memoryBudget,
+                                           filepart+" level "+std::to_string(level),
+                                           std::make_shared<PageMemorySizer>());
       }
     }
   }
 
+  /**
+    Branchless search of the last entry with a start id <= id in the loaded levels.
+
+    While descending the Eytzinger tree the path is recorded in the bits of k
+    (a 1 for going right, that is the entry is <= id). The result is the node
+    where the path went right for the last time.
+    */
+  template <class N>
+  inline bool NumericIndex<N>::SearchTopLevels(N id,
+                                               N& startId,
+                                               FileOffset& offset) const
+  {
+    size_t count=flatIds.size();
+    size_t k=1;
+
+    while (k<count) {
+      k=2*k+(flatIds[k]<=id ? 1 : 0);
+    }
+
+    k>>=std::countr_zero(k)+1;
+
+    if (k==0) {
+      return false;
+    }
+
+    startId=flatIds[k];
+    offset=flatOffsets[k];
+
+    return true;
+  }
+
   template <class N>
   bool NumericIndex<N>::Open(const std::string& path,
                              bool memoryMapped)
@@ -274,55 +384,55 @@ namespace osmscout {
     filename=AppendFileToDir(path,filepart);
 
     try {
-      scanner.Open(filename,
-                   FileScanner::FastRandom,
-                   memoryMapped);
+      scannerPool.Open(filename,
+                       FileScanner::FastRandom,
+                       memoryMapped);
+
+      FileScannerPool::Ptr scanner=scannerPool.Borrow();
 
-      pageSize=scanner.ReadUInt32Number();                  // Size of one index page
-      /*uint32_t entries=*/scanner.ReadUInt32Number();                   // Number of entries in data file
+      if (!scanner) {
+        log.Error() << "Cannot get scanner for file " << filename << "!";
+        scannerPool.Close();
+        return false;
+      }
 
-      levels=scanner.ReadUInt32();                    // Number of levels
+      pageSize=scanner->ReadUInt32Number();                  // Size of one index page
+      /*uint32_t entries=*/scanner->ReadUInt32Number();       // Number of entries in data file
+
+      levels=scanner->ReadUInt32();                          // Number of levels
       pageCounts.resize(levels);
 
-      FileOffset lastLevelPageStart=scanner.ReadFileOffset();    // Start of top level index page
-      FileOffset indexPageCountsOffset=scanner.ReadFileOffset(); // Start of list of sizes of index levels
+      FileOffset lastLevelPageStart=scanner->ReadFileOffset();    // Start of top level index page
+      FileOffset indexPageCountsOffset=scanner->ReadFileOffset(); // Start of list of sizes of index levels
 
-      scanner.SetPos(indexPageCountsOffset);
+      scanner->SetPos(indexPageCountsOffset);
       for (size_t level=0; level<levels; level++) {
-        pageCounts[level]=scanner.ReadUInt32Number();
+        pageCounts[level]=scanner->ReadUInt32Number();
       }
 
-      delete [] buffer;
-      buffer=new char[pageSize];
-
       //std::cout << "Index " << filename << ": " << entries << " entries to index, " << levels << " levels, pageSize " << pageSize << ", cache size " << cacheSize << std::endl;
 
-      ReadPage(lastLevelPageStart,root);
-
-      InitializeCache();
+      LoadTopLevels(*scanner,
+                    lastLevelPageStart);
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
+      scannerPool.Close();
       return false;
     }
 
-    return !scanner.HasError();
+    return true;
   }
 
   template <class N>
   bool NumericIndex<N>::Close()
   {
-    try {
-      if (scanner.IsOpen()) {
-        scanner.Close();
-      }
-    }
-    catch (IOException& e) {
-      log.Error() << e.GetDescription();
-      scanner.CloseFailsafe();
-      return false;
-    }
+    scannerPool.Close();
+
+    flatLevels=0;
+    flatIds.clear();
+    flatOffsets.clear();
+    pageCaches.clear();
 
     return true;
   }
@@ -330,7 +440,28 @@ namespace osmscout {
   template <class N>
   bool NumericIndex<N>::IsOpen() const
   {
-    return scanner.IsOpen();
+    return scannerPool.IsOpen();
+  }
+
+  /**
+   * Let the page caches of the levels not loaded at Open() draw from the given
+   * memory budget (in addition to the page count limit of the cache size).
+   * Has to be called before Open().
+   */
+  template <class N>
+  void NumericIndex<N>::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    memoryBudget=budget;
+  }
+
+  /**
+   * Bound the number of open files of the index by the given (shared)
+   * descriptor pool. Has to be called before Open().
+   */
+  template <class N>
+  void NumericIndex<N>::SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool)
+  {
+    scannerPool.SetDescriptorPool(descriptorPool);
   }
 
   /**
@@ -342,78 +473,50 @@ namespace osmscout {
   bool NumericIndex<N>::GetOffset(const N& id,
                                   FileOffset& offset) const
   {
-    try
-    {
-      std::lock_guard<std::mutex> lock(accessMutex);
-
-      //std::cout << "Looking up " << id << " in index...." << std::endl;
-
-      size_t                      r=GetPageIndex(*root,id);
-      PageRef                     pageRef;
-
-      if (!root->IndexIsValid(r)) {
-        //std::cerr << "Id " << id << " not found in root index, " << root->entries.front().startId << "-" << root->entries.back().startId << std::endl;
-        return false;
-      }
-
-      const Entry& rootEntry=root->entries[r];
+    N startId;
 
-      //std::cout << "Root entry index: " << r << " " << rootEntry.startId << " " << rootEntry.fileOffset << std::endl;
-
-      offset=rootEntry.fileOffset;
+    if (!SearchTopLevels(id,
+                         startId,
+                         offset)) {
+      return false;
+    }
 
-      N startId=rootEntry.startId;
-      for (size_t level=0; level+2<=levels; level++) {
-        //std::cout << "Level " << level << "/" << levels << std::endl;
-        if (level<=simpleCacheMaxLevel) {
-          auto cacheRef=simplePageCache[level].find(startId);
+    if (flatLevels==levels) {
+      return startId==id;
+    }
 
-          if (cacheRef==simplePageCache[level].end()) {
-            pageRef=nullptr; // Make sure, that we allocate a new page and not reuse an old one
+    try {
+      FileScannerPool::Ptr scanner;
 
-            ReadPage(offset,pageRef);
+      for (size_t level=flatLevels; level<levels; level++) {
+        PageCache& pageCache=*pageCaches[level-flatLevels];
+        PageRef    page;
 
-            simplePageCache[level].emplace(startId,pageRef);
+        if (!pageCache.GetEntry(offset,page)) {
+          if (!scanner &&
+              !(scanner=scannerPool.Borrow())) {
+            log.Error() << "Cannot get scanner for file " << filename << "!";
+            return false;
           }
-          else {
-            pageRef=cacheRef->second;
-          }
-        }
-        else {
-          typename PageCache::CacheRef cacheRef;
 
-          if (!pageCaches[level].GetEntry(startId,cacheRef)) {
-            typename PageCache::CacheEntry cacheEntry(startId);
-
-            cacheRef=pageCaches[level].SetEntry(cacheEntry);
-
-            ReadPage(offset,cacheRef->value);
-          }
+          ReadPage(*scanner,offset,page);
 
-          pageRef=cacheRef->value;
+          pageCache.SetEntry(offset,page);
         }
 
-        Page& page=*pageRef;
+        size_t i=GetPageIndex(*page,id);
 
-        size_t i=GetPageIndex(page,id);
-
-        if (!page.IndexIsValid(i)) {
-          //std::cerr << "Id " << id << " not found in index level " << level+2 << "!" << std::endl;
+        if (!page->IndexIsValid(i)) {
+          //std::cerr << "Id " << id << " not found in index level " << level+1 << "!" << std::endl;
           return false;
         }
 
-        const Entry& entry=page.entries[i];
-
-        //std::cout << "Sub entry index: " << i << " " << entry.startId << " " << entry.fileOffset << std::endl;
+        const Entry& entry=page->entries[i];
 
         startId=entry.startId;
         offset=entry.fileOffset;
       }
 
-      if (startId!=id) {
-        //std::cerr << "Id " << id << " not found in leaf index level (" << levels << " levels)" << std::endl;
-      }
-
       return startId==id;
     }
     catch (IOException& e) {
@@ -452,19 +555,16 @@ namespace osmscout {
   template <class N>
   void NumericIndex<N>::DumpStatistics() const
   {
-    size_t memory=0;
+    size_t entries=flatIds.empty() ? 0 : flatIds.size()-1;
     size_t pages=0;
 
-    pages+=1;
-    memory+=root->entries.size()*sizeof(Entry);
-
-
-    for (size_t i=0; i<pageCaches.size(); i++) {
-      pages+=pageCaches[i].GetSize();
-      memory+=sizeof(pageCaches[i])+pageCaches[i].GetMemory(NumericIndexCacheValueSizer());
+    for (const auto& pageCache : pageCaches) {
+      pages+=pageCache->GetSize();
     }
+    size_t memory=flatIds.size()*(sizeof(N)+sizeof(FileOffset));
 
-    log.Info() << "Index " << filepart << ": " << pages << " pages, memory " << memory;
+    log.Info() << "Index " << filepart << ": " << flatLevels << " of " << levels << " levels loaded (" << entries << " entries), "
+               << pages << " cached pages, memory " << memory;
   }
 }
 
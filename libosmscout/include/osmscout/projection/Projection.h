@@ -326,6 +326,21 @@ namespace osmscout {
     virtual bool GeoToPixel(const GeoCoord& coord,
                             Vertex2D& pixel) const = 0;
 
+    /**
+     * Converts count geo coordinates, given as separate arrays of latitudes
+     * and longitudes, to pixel coordinates.
+     *
+     * In contrast to the single coordinate variant the validity of the
+     * coordinates is not checked. The default implementation calls the single
+     * coordinate variant for each coordinate, projections may override it
+     * with a vectorized implementation.
+     */
+    virtual void GeoToPixel(const double* lat,
+                            const double* lon,
+                            double* x,
+                            double* y,
+                            size_t count) const;
+
     /**
      * Converts a valid GeoBox to its on screen pixel coordinates
      *
@@ -114,6 +114,12 @@ namespace osmscout {
     bool GeoToPixel(const GeoCoord& coord,
                     Vertex2D& pixel) const override;
 
+    void GeoToPixel(const double* lat,
+                    const double* lon,
+                    double* x,
+                    double* y,
+                    size_t count) const override;
+
     [[nodiscard]] bool IsLinearInterpolationEnabled() const
     {
       return useLinearInterpolation;
@@ -22,11 +22,13 @@
 */
 
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <osmscout/lib/CoreFeatures.h>
 
@@ -37,8 +39,10 @@
 #include <osmscout/routing/RouteDescription.h>
 #include <osmscout/routing/RouteData.h>
 #include <osmscout/routing/RouteNode.h>
+#include <osmscout/routing/RoutingProfile.h>
 #include <osmscout/routing/RoutingService.h>
 #include <osmscout/routing/MultiDBRoutingState.h>
+#include <osmscout/routing/RoutingDB.h>
 
 namespace osmscout {
 
@@ -183,6 +187,112 @@ namespace osmscout {
     }
   };
 
+  /**
+   * Result of a many-to-many routing calculation. Holds the costs, the distances
+   * and the durations of the cheapest routes from each source to each target.
+   * Targets not reachable from a source have infinite costs.
+   */
+  class OSMSCOUT_API RoutingMatrixResult CLASS_FINAL
+  {
+  private:
+    bool                  success=false;
+    size_t                sourceCount=0;
+    size_t                targetCount=0;
+    std::vector<double>   costs;     //!< Costs, row by row (one row per source)
+    std::vector<Distance> distances; //!< Distances, row by row (one row per source)
+    std::vector<Duration> durations; //!< Durations, row by row (one row per source)
+
+  public:
+    RoutingMatrixResult() = default;
+    RoutingMatrixResult(size_t sourceCount,
+                        size_t targetCount);
+
+    void Set(size_t source,
+             size_t target,
+             double cost,
+             const Distance& distance,
+             const Duration& duration);
+
+    void SetSuccess(bool success)
+    {
+      this->success=success;
+    }
+
+    bool Success() const
+    {
+      return success;
+    }
+
+    size_t GetSourceCount() const
+    {
+      return sourceCount;
+    }
+
+    size_t GetTargetCount() const
+    {
+      return targetCount;
+    }
+
+    bool IsReachable(size_t source,
+                     size_t target) const
+    {
+      return costs[source*targetCount+target]<std::numeric_limits<double>::infinity();
+    }
+
+    double GetCost(size_t source,
+                   size_t target) const
+    {
+      return costs[source*targetCount+target];
+    }
+
+    Distance GetDistance(size_t source,
+                         size_t target) const
+    {
+      return distances[source*targetCount+target];
+    }
+
+    Duration GetDuration(size_t source,
+                         size_t target) const
+    {
+      return durations[source*targetCount+target];
+    }
+  };
+
+  /**
+   * Result of an alternative routes calculation. Holds the best route followed
+   * by the alternative routes found, ordered by increasing costs.
+   */
+  class OSMSCOUT_API AlternativeRoutesResult CLASS_FINAL
+  {
+  private:
+    std::vector<RoutingResult> routes;
+    std::vector<double>        costs;
+
+  public:
+    void AddRoute(RoutingResult&& route,
+                  double cost);
+
+    bool Success() const
+    {
+      return !routes.empty();
+    }
+
+    size_t GetRouteCount() const
+    {
+      return routes.size();
+    }
+
+    const RoutingResult& GetRoute(size_t index) const
+    {
+      return routes[index];
+    }
+
+    double GetCost(size_t index) const
+    {
+      return costs[index];
+    }
+  };
+
   /**
    * \ingroup Routing
    *
@@ -192,7 +302,207 @@ namespace osmscout {
   class OSMSCOUT_API AbstractRoutingService: public RoutingService
   {
   protected:
-    bool debugPerformance;
+    /**
+     * A path of another route node leading to a given route node
+     */
+    struct IncomingPath
+    {
+      RouteNodeRef node;      //!< The route node the path starts at
+      size_t       pathIndex; //!< Index of the path in the paths of the node
+    };
+
+    /**
+     * A node, where the forward and the backward search of the bidirectional
+     * search meet
+     */
+    struct Meeting
+    {
+      double cost=std::numeric_limits<double>::max(); //!< Costs of the route via the meeting node
+      RNode  forward;                                 //!< Forward label at the meeting node
+      RNode  backward;                                //!< Backward label at the meeting node
+
+      bool IsValid() const
+      {
+        return cost<std::numeric_limits<double>::max();
+      }
+    };
+
+    /**
+     * State of the bidirectional search
+     */
+    struct BidirectionalSearch
+    {
+      Vehicle                           vehicle;
+      GeoCoord                          startCoord;
+      GeoCoord                          targetCoord;
+      Distance                          overallDistance;
+      Distance                          currentMaxDistance;
+      double                            costLimit=0;
+
+      // Search from the start
+      OpenList                          forwardOpenList;
+      OpenMap                           forwardOpenMap;
+      ClosedSet                         forwardClosedSet;
+      std::unordered_map<DBId,RNodeRef> forwardSettled;
+
+      // Search from the target
+      OpenList                          backwardOpenList;
+      OpenMap                           backwardOpenMap;
+      std::unordered_map<DBId,RNodeRef> backwardSettled;
+
+      Meeting                           meeting;         //!< Cheapest route found so far
+
+      size_t                            forwardNodesLoadedCount=0;
+      size_t                            backwardNodesLoadedCount=0;
+      size_t                            nodesIgnoredCount=0;
+    };
+
+    /**
+     * A route via a node settled by both directions of the bidirectional search,
+     * candidate for an alternative route
+     */
+    struct ViaCandidate
+    {
+      RNodeRef               forward;      //!< Forward label at the via node
+      RNodeRef               backward;     //!< Backward label at the via node
+      double                 cost=0;           //!< Costs of the route via the node
+      bool                   admissible=false; //!< The route is a valid alternative route on its own
+      Distance               distance;         //!< Length of the route
+      Distance               sharing;          //!< Length of the route shared with the best route
+      std::vector<DBId>      nodes;            //!< Route nodes of the route, if admissible
+      std::vector<Distance>  distances;        //!< Length of the paths between the route nodes, if admissible
+    };
+
+    /**
+     * Usability and costs of the paths of route nodes as defined by the virtual
+     * CanUse() and GetCosts() methods for the routing state
+     */
+    class ServiceEdgeCosts
+    {
+    private:
+      AbstractRoutingService& service;
+      const RoutingState&     state;
+
+    public:
+      ServiceEdgeCosts(AbstractRoutingService& service,
+                       const RoutingState& state)
+      : service(service),
+        state(state)
+      {
+        // no code
+      }
+
+      bool CanUse(DatabaseId database,
+                  const RouteNode& routeNode,
+                  size_t pathIndex) const
+      {
+        return service.CanUse(state,database,routeNode,pathIndex);
+      }
+
+      double GetCosts(DatabaseId database,
+                      const RouteNode& routeNode,
+                      size_t inPathIndex,
+                      size_t outPathIndex) const
+      {
+        return service.GetCosts(state,database,routeNode,inPathIndex,outPathIndex);
+      }
+    };
+
+    /**
+     * Usability and costs of the paths of route nodes by lookup in a compiled profile
+     */
+    class CompiledEdgeCosts
+    {
+    private:
+      const CompiledRoutingProfile& profile;
+
+    public:
+      explicit CompiledEdgeCosts(const CompiledRoutingProfile& profile)
+      : profile(profile)
+      {
+        // no code
+      }
+
+      bool CanUse(DatabaseId /*database*/,
+                  const RouteNode& routeNode,
+                  size_t pathIndex) const
+      {
+        return profile.CanUse(routeNode,pathIndex);
+      }
+
+      double GetCosts(DatabaseId /*database*/,
+                      const RouteNode& routeNode,
+                      size_t inPathIndex,
+                      size_t outPathIndex) const
+      {
+        return profile.GetCosts(routeNode,inPathIndex,outPathIndex);
+      }
+    };
+
+  public:
+    /**
+     * The cheapest routes from the route nodes around a route to its target, as
+     * calculated by CalculateRerouteTree(). Reroute() uses the tree to calculate
+     * the route from a new position to the same target by searching only until
+     * the position is connected to the tree again.
+     *
+     * The tree is only valid for the routing state (routing profile) it was
+     * calculated for.
+     */
+    class RerouteTree CLASS_FINAL
+    {
+      friend class AbstractRoutingService;
+
+    private:
+      RoutePosition                     target;
+      GeoCoord                          startCoord;   //!< Start of the route the tree was calculated for
+      GeoCoord                          targetCoord;
+      double                            boundaryCost=0; //!< Minimal balanced costs of all route nodes not in the tree
+      RNodeArena                        rnodeArena;
+      std::unordered_map<DBId,RNodeRef> settled;      //!< Labels of the backward search, holding the costs to the target
+
+    public:
+      RerouteTree() = default;
+
+      void Clear()
+      {
+        settled.clear();
+        rnodeArena.Clear();
+      }
+
+      bool IsValid() const
+      {
+        return !settled.empty();
+      }
+
+      const RoutePosition& GetTarget() const
+      {
+        return target;
+      }
+
+      /**
+       * Number of route nodes in the tree
+       */
+      size_t GetNodeCount() const
+      {
+        return settled.size();
+      }
+
+      /**
+       * Returns true, if the tree knows the cheapest route from the given route node
+       * to the target
+       */
+      bool Contains(const DBId& id) const
+      {
+        return settled.contains(id);
+      }
+    };
+
+  protected:
+    bool                   debugPerformance;
+    RNodeArena             rnodeArena;               //!< Storage of the RNodes of the current route calculation, reused by the next one
+    CompiledRoutingProfile compiledProfile;          //!< Compiled profile of the current route calculation, see CompileProfile()
+    bool                   hasCompiledProfile=false; //!< The current route calculation uses compiledProfile
 
   protected:
     virtual Vehicle GetVehicle(const RoutingState& state) = 0;
@@ -218,6 +528,10 @@ namespace osmscout {
 
     virtual double GetUTurnCost(const RoutingState& state, const DatabaseId databaseId) = 0;
 
+    virtual bool CompileProfile(const RoutingState& state,
+                                DatabaseId database,
+                                CompiledRoutingProfile& compiled);
+
     virtual double GetCosts(const RoutingState& state,
                             DatabaseId database,
                             const WayRef &way,
@@ -272,6 +586,34 @@ namespace osmscout {
                                            DatabaseId database,
                                            Id id) = 0;
 
+    /**
+     * Return all objects passing the given route node, including the objects
+     * that can only be used towards the route node.
+     *
+     * @param id
+     *    Database and id of the route node
+     * @param objects
+     *    The objects passing the node
+     * @return
+     *    False on error, else true
+     */
+    virtual bool GetJunctionObjects(const DBId& id,
+                                    std::vector<ObjectFileRef>& objects) = 0;
+
+    /**
+     * Return the cached incoming paths of the given route node, see
+     * RoutingDatabase::GetIncomingPaths()
+     */
+    virtual bool GetCachedIncomingPaths(const DBId& id,
+                                        std::vector<RoutingDatabase::IncomingPath>& paths) = 0;
+
+    /**
+     * Cache the incoming paths of the given route node, see
+     * RoutingDatabase::SetIncomingPaths()
+     */
+    virtual void CacheIncomingPaths(const DBId& id,
+                                    const std::vector<RoutingDatabase::IncomingPath>& paths) = 0;
+
     void GetStartForwardRouteNode(const RoutingState& state,
                                   const DatabaseId& database,
                                   const WayRef& way,
@@ -371,21 +713,142 @@ namespace osmscout {
                            const Distance &overallDistance,
                            const double &costLimit);
 
+    template <class EdgeCosts>
+    bool WalkPathsWithCosts(const RoutingState& state,
+                            const EdgeCosts& costs,
+                            RNodeRef &current,
+                            RouteNodeRef &currentRouteNode,
+                            OpenList &openList,
+                            OpenMap &openMap,
+                            ClosedSet &closedSet,
+                            RoutingResult &result,
+                            const RoutingParameter& parameter,
+                            const GeoCoord &targetCoord,
+                            const Vehicle &vehicle,
+                            size_t &nodesIgnoredCount,
+                            Distance &currentMaxDistance,
+                            const Distance &overallDistance,
+                            const double &costLimit);
+
     bool RestrictInitialUTurn(const RoutingState& state,
                               const Bearing& vehicleBearing,
                               const RoutePosition& start,
                               RNodeRef startForwardNode,
                               RNodeRef startBackwardNode);
 
+    bool GetIncomingPaths(const DBId& id,
+                          const RouteNode& routeNode,
+                          std::vector<IncomingPath>& incomingPaths);
+
+    bool IsTurnAllowed(const RouteNode& routeNode,
+                       const ObjectFileRef& inObject,
+                       const ObjectFileRef& outObject) const;
+
+    template <class EdgeCosts>
+    double GetTurnCosts(const EdgeCosts& costs,
+                        DatabaseId database,
+                        const RouteNode& routeNode,
+                        const DBId& prev,
+                        const ObjectFileRef& inObject,
+                        const DBId& next,
+                        const ObjectFileRef& outObject);
+
+    double GetBalancedEstimateCosts(const RoutingState& state,
+                                    DatabaseId database,
+                                    const GeoCoord& coord,
+                                    const GeoCoord& originCoord,
+                                    const GeoCoord& goalCoord);
+
+    bool WalkPathsBackward(const RoutingState& state,
+                           const RNodeRef& current,
+                           OpenList& openList,
+                           OpenMap& openMap,
+                           const std::unordered_map<DBId,RNodeRef>& settled,
+                           const GeoCoord& startCoord,
+                           const GeoCoord& targetCoord,
+                           const Vehicle& vehicle,
+                           size_t& nodesIgnoredCount,
+                           double costLimit);
+
+    template <class EdgeCosts>
+    bool WalkPathsBackwardWithCosts(const RoutingState& state,
+                                    const EdgeCosts& costs,
+                                    const RNodeRef& current,
+                                    OpenList& openList,
+                                    OpenMap& openMap,
+                                    const std::unordered_map<DBId,RNodeRef>& settled,
+                                    const GeoCoord& startCoord,
+                                    const GeoCoord& targetCoord,
+                                    const Vehicle& vehicle,
+                                    size_t& nodesIgnoredCount,
+                                    double costLimit);
+
+    double GetMeetingCosts(const RoutingState& state,
+                           const RNode& forward,
+                           const RNode& backward);
+
+    void UpdateMeeting(const RoutingState& state,
+                       const RNode& forward,
+                       const RNode& backward,
+                       Meeting& meeting);
+
+    bool InitializeBidirectionalSearch(RoutingState& state,
+                                       const RoutePosition& start,
+                                       const RoutePosition& target,
+                                       BidirectionalSearch& search);
+
+    bool ContinueBidirectionalSearch(const RoutingState& state,
+                                     const RoutingParameter& parameter,
+                                     double costFactor,
+                                     BidirectionalSearch& search,
+                                     RoutingResult& result);
+
+    void ResolveMeetingToList(const ClosedSet& forwardClosedSet,
+                              const std::unordered_map<DBId,RNodeRef>& backwardSettled,
+                              const RNode& forward,
+                              const RNode& backward,
+                              std::list<VNode>& nodes);
+
+    RoutingResult CalculateRouteBidirectional(RoutingState& state,
+                                              const RoutePosition& start,
+                                              const RoutePosition& target,
+                                              const RoutingParameter& parameter);
+
+    void EvaluateViaCandidate(const BidirectionalSearch& search,
+                              const std::unordered_map<Id,Id>& bestRoute,
+                              const RoutingParameter& parameter,
+                              ViaCandidate& candidate) const;
+
+    double GetRerouteEstimateCosts(const RoutingState& state,
+                                   const RerouteTree& tree,
+                                   const RNode& node);
+
   public:
     explicit AbstractRoutingService(const RouterParameter& parameter);
     ~AbstractRoutingService() override;
 
-    RoutingResult CalculateRoute(RoutingState& state,
-                                 const RoutePosition& start,
-                                 const RoutePosition& target,
-                                 const std::optional<osmscout::Bearing> &bearing,
-                                 const RoutingParameter& parameter);
+    virtual RoutingResult CalculateRoute(RoutingState& state,
+                                         const RoutePosition& start,
+                                         const RoutePosition& target,
+                                         const std::optional<osmscout::Bearing> &bearing,
+                                         const RoutingParameter& parameter);
+
+    AlternativeRoutesResult CalculateAlternativeRoutes(RoutingState& state,
+                                                       const RoutePosition& start,
+                                                       const RoutePosition& target,
+                                                       const RoutingParameter& parameter);
+
+    bool CalculateRerouteTree(RoutingState& state,
+                              const RoutePosition& start,
+                              const RoutePosition& target,
+                              const RoutingParameter& parameter,
+                              RerouteTree& tree);
+
+    RoutingResult Reroute(RoutingState& state,
+                          const RoutePosition& position,
+                          const std::optional<osmscout::Bearing> &bearing,
+                          const RoutingParameter& parameter,
+                          const RerouteTree& tree);
 
     RouteDescriptionResult TransformRouteDataToRouteDescription(const RouteData& data);
     RoutePointsResult TransformRouteDataToPoints(const RouteData& data);
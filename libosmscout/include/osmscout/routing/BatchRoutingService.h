@@ -0,0 +1,115 @@
+#ifndef OSMSCOUT_BATCHROUTINGSERVICE_H
+#define OSMSCOUT_BATCHROUTINGSERVICE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreFeatures.h>
+
+#include <osmscout/routing/RoutingDB.h>
+#include <osmscout/routing/RoutingProfile.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * A route to calculate by the BatchRoutingService
+   */
+  struct OSMSCOUT_API BatchRoutingJob
+  {
+    RoutePosition     start;
+    RoutePosition     target;
+    RoutingProfileRef profile;
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of a BatchRoutingJob
+   */
+  struct OSMSCOUT_API BatchRoutingJobResult
+  {
+    RoutingResult                       result;
+    std::chrono::steady_clock::duration duration=std::chrono::steady_clock::duration::zero(); //!< Time spent calculating the route
+    size_t                              worker=0;                                             //!< Index of the worker that calculated the route
+    std::exception_ptr                  exception;                                            //!< Exception thrown while calculating the route, if any
+  };
+
+  /**
+   * \ingroup Service
+   * \ingroup Routing
+   *
+   * Routing service calculating many independent routes in parallel.
+   *
+   * The service holds one SimpleRoutingService per worker thread, so each worker
+   * has its own search state. All workers share a single RoutingDatabase and with
+   * it the cache of loaded route node pages, so route nodes loaded by one worker
+   * are available to all others and are held in memory only once.
+   *
+   * The service is thread-safe, concurrent calls of CalculateRoutes() are
+   * processed one after the other.
+   */
+  class OSMSCOUT_API BatchRoutingService CLASS_FINAL
+  {
+  private:
+    DatabaseRef                          database;        //!< Database object, holding all index and data files
+    RouterParameter                      parameter;
+    std::string                          filenamebase;    //!< Common base name for all router files
+    size_t                               threadCount;     //!< Number of worker threads
+    RoutingDatabaseRef                   routingDatabase; //!< Routing database shared by all workers
+    std::vector<SimpleRoutingServiceRef> workers;         //!< Routing service per worker thread
+    std::mutex                           mutex;           //!< Serializes the calls of the public methods
+
+  public:
+    BatchRoutingService(const DatabaseRef& database,
+                        const RouterParameter& parameter,
+                        const std::string& filenamebase,
+                        size_t threadCount=0);
+    ~BatchRoutingService();
+
+    bool Open();
+    bool IsOpen();
+    void Close();
+
+    size_t GetThreadCount() const
+    {
+      return threadCount;
+    }
+
+    std::vector<BatchRoutingJobResult> CalculateRoutes(const std::vector<BatchRoutingJob>& jobs,
+                                                       const RoutingParameter& parameter);
+  };
+
+  //! \ingroup Service
+  //! Reference counted reference to a BatchRoutingService instance
+  using BatchRoutingServiceRef = std::shared_ptr<BatchRoutingService>;
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef OSMSCOUT_CHROUTINGSERVICE_H
+#define OSMSCOUT_CHROUTINGSERVICE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreFeatures.h>
+
+#include <osmscout/routing/ContractionHierarchy.h>
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Service
+   * \ingroup Routing
+   *
+   * Routing service answering queries using the contraction hierarchies generated
+   * by the import (see ContractionHierarchy), if available for the vehicle of the
+   * profile. The route is searched by a bidirectional upward search in the
+   * hierarchy and the shortcuts of the result are unpacked to the paths of
+   * the routing graph, so the resulting RouteData is the same as of the
+   * SimpleRoutingService.
+   *
+   * The costs of the hierarchy are defined by ContractionHierarchy::CreateProfile(),
+   * so the hierarchy is only used for profiles with the same costs (see
+   * UsesContractionHierarchy()).
+   *
+   * The service falls back to the A* search of the SimpleRoutingService, if
+   * there is no hierarchy for the vehicle, the profile differs from the one of
+   * the hierarchy, an initial bearing is given, the route found violates a turn
+   * restriction or no route is found in the hierarchy (the hierarchy does not
+   * contain paths with restricted access).
+   */
+  class OSMSCOUT_API CHRoutingService: public SimpleRoutingService
+  {
+  private:
+    DatabaseRef                               database;     //!< Database object, holding all index and data files
+    std::string                               filenamebase; //!< Common base name for all router files
+    std::map<Vehicle,ContractionHierarchyRef> hierarchies;  //!< Hierarchies by vehicle
+    std::map<Vehicle,CompiledRoutingProfile>  profiles;     //!< Compiled profiles the hierarchies were built with, by vehicle
+
+  private:
+    bool GetTargetCost(RoutingProfile& profile,
+                       const RoutePosition& target,
+                       const GeoCoord& targetCoord,
+                       const RouteNodeRef& routeNode,
+                       double& cost);
+
+    bool ViolatesTurnRestriction(const std::vector<ContractionHierarchy::Step>& steps,
+                                 const ContractionHierarchy& hierarchy,
+                                 DatabaseId database);
+
+  public:
+    CHRoutingService(const DatabaseRef& database,
+                     const RouterParameter& parameter,
+                     const std::string& filenamebase);
+    ~CHRoutingService() override;
+
+    bool Open();
+    void Close();
+
+    ContractionHierarchyRef GetContractionHierarchy(Vehicle vehicle) const;
+
+    bool UsesContractionHierarchy(const RoutingProfile& profile);
+
+    RoutingResult CalculateRoute(RoutingProfile& profile,
+                                 const RoutePosition& start,
+                                 const RoutePosition& target,
+                                 const std::optional<osmscout::Bearing> &bearing,
+                                 const RoutingParameter& parameter) override;
+  };
+
+  //! \ingroup Service
+  //! Reference counted reference to an CHRoutingService instance
+  using CHRoutingServiceRef = std::shared_ptr<CHRoutingService>;
+}
+
+#endif
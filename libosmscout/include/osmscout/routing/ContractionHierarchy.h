@@ -0,0 +1,171 @@
+#ifndef OSMSCOUT_CONTRACTIONHIERARCHY_H
+#define OSMSCOUT_CONTRACTIONHIERARCHY_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/OSMScoutTypes.h>
+#include <osmscout/ObjectRef.h>
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/routing/RoutingProfile.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Contraction hierarchy of the routing graph for one vehicle, as generated by
+   * the import and used by the CHRoutingService.
+   *
+   * Nodes are the route nodes of the routing graph, addressed by their index
+   * in the ordered list of route node ids. Every node only stores the edges to
+   * nodes contracted after it (the "upward" edges):
+   *
+   * * forward edges lead from the node to the higher ranked node
+   * * backward edges lead from the higher ranked node to the node
+   *
+   * An edge either is an original path of the routing graph (referencing the
+   * way or area it follows) or a shortcut bypassing a lower ranked middle node.
+   * A shortcut from a to b via m is the concatenation of the backward edge
+   * (a to m) and the forward edge (m to b) stored at m.
+   *
+   * The edge costs are computed by the profile returned by CreateProfile() for
+   * the vehicle. The hierarchy does not know about turn restrictions and
+   * does not contain paths with restricted access.
+   */
+  class OSMSCOUT_API ContractionHierarchy CLASS_FINAL
+  {
+  public:
+    static constexpr uint32_t FILE_FORMAT_VERSION=1;
+
+    //! Index of a non-existing node
+    static constexpr uint32_t noNode=std::numeric_limits<uint32_t>::max();
+
+    /**
+     * An upward edge of a node
+     */
+    struct OSMSCOUT_API Edge
+    {
+      uint32_t      target=noNode; //!< Index of the higher ranked node
+      uint32_t      middle=noNode; //!< Index of the node bypassed by a shortcut, noNode for original paths
+      double        cost=0.0;      //!< Cost of using the edge
+      ObjectFileRef object;        //!< Object followed by an original path
+
+      bool IsShortcut() const
+      {
+        return middle!=noNode;
+      }
+    };
+
+    /**
+     * Step of an unpacked path, the node reached and the object used to reach it
+     */
+    struct OSMSCOUT_API Step
+    {
+      uint32_t      node;
+      ObjectFileRef object;
+    };
+
+  private:
+    Vehicle               vehicle=vehicleCar;
+    std::vector<Id>       nodeIds;       //!< Sorted ids of the route nodes
+    std::vector<uint32_t> forwardIndex;  //!< Start of the forward edges of each node in forwardEdges
+    std::vector<Edge>     forwardEdges;
+    std::vector<uint32_t> backwardIndex; //!< Start of the backward edges of each node in backwardEdges
+    std::vector<Edge>     backwardEdges;
+
+  private:
+    const Edge* FindEdge(const std::vector<uint32_t>& index,
+                         const std::vector<Edge>& edges,
+                         uint32_t node,
+                         uint32_t target) const;
+
+  public:
+    ContractionHierarchy() = default;
+    ContractionHierarchy(Vehicle vehicle,
+                         const std::vector<Id>& nodeIds,
+                         const std::vector<std::vector<Edge>>& forwardEdges,
+                         const std::vector<std::vector<Edge>>& backwardEdges);
+
+    bool Load(const std::string& filename);
+    bool Store(const std::string& filename) const;
+
+    Vehicle GetVehicle() const
+    {
+      return vehicle;
+    }
+
+    size_t GetNodeCount() const
+    {
+      return nodeIds.size();
+    }
+
+    size_t GetEdgeCount() const
+    {
+      return forwardEdges.size()+backwardEdges.size();
+    }
+
+    Id GetNodeId(uint32_t node) const
+    {
+      return nodeIds[node];
+    }
+
+    uint32_t GetNodeIndex(Id id) const;
+
+    std::span<const Edge> GetForwardEdges(uint32_t node) const
+    {
+      return std::span<const Edge>(forwardEdges.data()+forwardIndex[node],
+                                   forwardEdges.data()+forwardIndex[node+1]);
+    }
+
+    std::span<const Edge> GetBackwardEdges(uint32_t node) const
+    {
+      return std::span<const Edge>(backwardEdges.data()+backwardIndex[node],
+                                   backwardEdges.data()+backwardIndex[node+1]);
+    }
+
+    bool Unpack(uint32_t from,
+                const Edge& edge,
+                uint32_t to,
+                std::vector<Step>& steps) const;
+
+    static std::string GetFilename(const std::string& filenamebase,
+                                   Vehicle vehicle);
+
+    static FastestPathRoutingProfileRef CreateProfile(const TypeConfigRef& typeConfig,
+                                                      Vehicle vehicle);
+  };
+
+  //! \ingroup Routing
+  //! Reference counted reference to a ContractionHierarchy instance
+  using ContractionHierarchyRef = std::shared_ptr<ContractionHierarchy>;
+}
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef OSMSCOUT_ISOCHRONESERVICE_H
+#define OSMSCOUT_ISOCHRONESERVICE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreFeatures.h>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/routing/SimpleRoutingService.h>
+
+#include <osmscout/util/Distance.h>
+#include <osmscout/util/Time.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Limit of an isochrone. A position is within the budget, if it is reachable within
+   * all of the given limits.
+   */
+  struct OSMSCOUT_API IsochroneBudget
+  {
+    std::optional<Duration> duration; //!< Maximum travel time
+    std::optional<Distance> distance; //!< Maximum travel distance
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * A route node reachable within the largest budget
+   */
+  struct OSMSCOUT_API IsochroneNode
+  {
+    Id       id;       //!< Id of the route node
+    GeoCoord coord;    //!< Coordinate of the route node
+    Distance distance; //!< Travel distance from the start
+    Duration duration; //!< Travel time from the start
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * A polygon of an isochrone. The outer ring is oriented counterclockwise, the holes
+   * clockwise. The rings are not closed, the first coordinate is not repeated
+   * at the end.
+   */
+  struct OSMSCOUT_API IsochronePolygon
+  {
+    std::vector<GeoCoord>              outer;
+    std::vector<std::vector<GeoCoord>> holes;
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * The area reachable within the given budget
+   */
+  struct OSMSCOUT_API Isochrone
+  {
+    IsochroneBudget               budget;
+    std::vector<IsochronePolygon> polygons;
+  };
+
+  /**
+   * \ingroup Routing
+   *
+   * Result of an isochrone calculation
+   */
+  class OSMSCOUT_API IsochroneResult CLASS_FINAL
+  {
+  private:
+    bool                       success=false;
+    std::vector<IsochroneNode> nodes;      //!< Route nodes reachable within the largest budget
+    std::vector<Isochrone>     isochrones; //!< One isochrone per budget, in the order of the budgets
+
+  public:
+    IsochroneResult() = default;
+
+    void SetSuccess(bool success)
+    {
+      this->success=success;
+    }
+
+    bool Success() const
+    {
+      return success;
+    }
+
+    std::vector<IsochroneNode>& GetNodes()
+    {
+      return nodes;
+    }
+
+    const std::vector<IsochroneNode>& GetNodes() const
+    {
+      return nodes;
+    }
+
+    std::vector<Isochrone>& GetIsochrones()
+    {
+      return isochrones;
+    }
+
+    const std::vector<Isochrone>& GetIsochrones() const
+    {
+      return isochrones;
+    }
+  };
+
+  /**
+   * \ingroup Service
+   * \ingroup Routing
+   *
+   * Routing service calculating the area reachable from a start position.
+   *
+   * A single Dijkstra search (the one-to-many search of CalculateMatrix()) is run
+   * up to the largest of the given budgets. Route nodes beyond it are not loaded,
+   * so only the route node tiles around the start are read. The paths of the search
+   * are rasterized into a grid of the given cell size once per budget, paths
+   * crossing a budget are cut at the position the budget is used up. The filled
+   * cells of each grid are traced to polygons.
+   */
+  class OSMSCOUT_API IsochroneService: public SimpleRoutingService
+  {
+  public:
+    IsochroneService(const DatabaseRef& database,
+                     const RouterParameter& parameter,
+                     const std::string& filenamebase);
+    ~IsochroneService() override;
+
+    IsochroneResult CalculateIsochrones(const RoutingProfile& profile,
+                                        const RoutePosition& start,
+                                        const std::vector<IsochroneBudget>& budgets,
+                                        const Distance& cellSize,
+                                        const RoutingParameter& parameter);
+  };
+
+  //! \ingroup Service
+  //! Reference counted reference to an IsochroneService instance
+  using IsochroneServiceRef = std::shared_ptr<IsochroneService>;
+}
+
+#endif
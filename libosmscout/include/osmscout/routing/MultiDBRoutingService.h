@@ -115,6 +115,15 @@ namespace osmscout {
                                    DatabaseId database,
                                    Id id) override;
 
+    bool GetJunctionObjects(const DBId& id,
+                            std::vector<ObjectFileRef>& objects) override;
+
+    bool GetCachedIncomingPaths(const DBId& id,
+                                std::vector<RoutingDatabase::IncomingPath>& paths) override;
+
+    void CacheIncomingPaths(const DBId& id,
+                            const std::vector<RoutingDatabase::IncomingPath>& paths) override;
+
     bool CanUse(const MultiDBRoutingState& state,
                 DatabaseId databaseId,
                 const RouteNode& routeNode,
@@ -0,0 +1,217 @@
+#ifndef OSMSCOUT_ROUTEGRAPH_H
+#define OSMSCOUT_ROUTEGRAPH_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/OSMScoutTypes.h>
+#include <osmscout/GeoCoord.h>
+#include <osmscout/ObjectRef.h>
+
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/util/Distance.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Compact, read-only representation of the routing graph of a router, as
+   * generated by the import (see ImportParameter::SetRouterGraph()).
+   *
+   * The graph holds the same route nodes and paths as the route node data file,
+   * but stores them in compressed sparse row layout: one array per node attribute
+   * and one array per path attribute, the paths of a node are the range
+   * [GetEdgesBegin(node), GetEdgesEnd(node)[ of the path arrays. Nodes are numbered
+   * along the z-order curve of their coordinates (see GeoCoord::GetHash()), so nodes
+   * close to each other are stored close to each other.
+   *
+   * If the file can be memory mapped, the arrays are used in place and opening
+   * the graph does not allocate any per node or per path memory. Paths to route
+   * nodes not contained in the graph and the excludes (turn restrictions) of the
+   * route nodes are not part of the graph.
+   */
+  class OSMSCOUT_API RouteGraph CLASS_FINAL
+  {
+  public:
+    static constexpr uint32_t FILE_FORMAT_VERSION=1;
+
+    //! Index of a non-existing node
+    static constexpr uint32_t noNode=std::numeric_limits<uint32_t>::max();
+
+    /**
+     * A route node as passed to Store()
+     */
+    struct OSMSCOUT_API Node
+    {
+      Id       id;
+      GeoCoord coord;
+    };
+
+    /**
+     * A path of a route node as passed to Store()
+     */
+    struct OSMSCOUT_API Edge
+    {
+      uint32_t      target;             //!< Index of the target node
+      Distance      distance;           //!< Distance to the target node
+      uint16_t      objectVariantIndex; //!< Index into the object variant data of the router
+      uint8_t       flags;              //!< Flags as defined by RouteNode
+      ObjectFileRef object;             //!< Way or area the path follows
+    };
+
+  private:
+    /**
+     * Array of the graph, either pointing into the memory mapped file or
+     * into storage
+     */
+    template<typename T>
+    struct Array
+    {
+      const T*       data=nullptr;
+      std::vector<T> storage;
+
+      void Read(FileScanner& scanner,
+                FileOffset& offset,
+                size_t count);
+
+      const T& operator[](size_t index) const
+      {
+        return data[index];
+      }
+    };
+
+  private:
+    std::shared_ptr<const char> mapping;   //!< Memory mapping of the file, if the arrays point into it
+    uint32_t                    nodeCount=0;
+    uint32_t                    edgeCount=0;
+
+    Array<uint64_t>             nodeIds;
+    Array<uint32_t>             nodeLats;  //!< Raw latitude values as encoded in the data files
+    Array<uint32_t>             nodeLons;  //!< Raw longitude values as encoded in the data files
+    Array<uint32_t>             nodesById; //!< Node indexes ordered by node id
+    Array<uint32_t>             firstEdges;
+
+    Array<uint32_t>             edgeTargets;
+    Array<uint32_t>             edgeDistances; //!< Distances in cm, as in the route node data file
+    Array<uint16_t>             edgeVariants;
+    Array<uint8_t>              edgeFlags;
+    Array<uint64_t>             edgeObjectOffsets;
+    Array<uint8_t>              edgeObjectTypes;
+
+  public:
+    RouteGraph() = default;
+    RouteGraph(const RouteGraph&) = delete;
+    RouteGraph& operator=(const RouteGraph&) = delete;
+
+    bool Open(const std::string& filename);
+    void Close();
+
+    bool IsOpen() const
+    {
+      return firstEdges.data!=nullptr;
+    }
+
+    /**
+     * Returns true, if the arrays of the graph point into the memory mapped file
+     */
+    bool IsMemoryMapped() const
+    {
+      return mapping!=nullptr;
+    }
+
+    uint32_t GetNodeCount() const
+    {
+      return nodeCount;
+    }
+
+    uint32_t GetEdgeCount() const
+    {
+      return edgeCount;
+    }
+
+    Id GetNodeId(uint32_t node) const
+    {
+      return nodeIds[node];
+    }
+
+    GeoCoord GetNodeCoord(uint32_t node) const
+    {
+      return {nodeLats[node]/latConversionFactor-90.0,
+              nodeLons[node]/lonConversionFactor-180.0};
+    }
+
+    uint32_t GetNodeIndex(Id id) const;
+
+    uint32_t GetEdgesBegin(uint32_t node) const
+    {
+      return firstEdges[node];
+    }
+
+    uint32_t GetEdgesEnd(uint32_t node) const
+    {
+      return firstEdges[node+1];
+    }
+
+    uint32_t GetEdgeTarget(uint32_t edge) const
+    {
+      return edgeTargets[edge];
+    }
+
+    Distance GetEdgeDistance(uint32_t edge) const
+    {
+      return Distance::Of<Kilometer>(edgeDistances[edge]/(1000.0*100.0));
+    }
+
+    uint16_t GetEdgeObjectVariantIndex(uint32_t edge) const
+    {
+      return edgeVariants[edge];
+    }
+
+    uint8_t GetEdgeFlags(uint32_t edge) const
+    {
+      return edgeFlags[edge];
+    }
+
+    ObjectFileRef GetEdgeObject(uint32_t edge) const
+    {
+      return {edgeObjectOffsets[edge],
+              static_cast<RefType>(edgeObjectTypes[edge])};
+    }
+
+    static bool Store(const std::string& filename,
+                      const std::vector<Node>& nodes,
+                      const std::vector<uint32_t>& firstEdges,
+                      const std::vector<Edge>& edges);
+
+    static std::string GetFilename(const std::string& filenamebase);
+  };
+}
+
+#endif
@@ -21,6 +21,7 @@
 */
 
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include <osmscout/Pixel.h>
@@ -29,6 +30,8 @@
 
 #include <osmscout/io/DataFile.h>
 
+#include <osmscout/util/ShardedCache.h>
+
 #include <osmscout/routing/RouteNode.h>
 
 namespace osmscout {
@@ -44,18 +47,34 @@ namespace osmscout {
       uint32_t   count;
     };
 
+    /**
+     * All route nodes of a tile. Pages are completely loaded before they are
+     * added to the cache and not changed afterwards, so they can be read by
+     * multiple threads without locking.
+     */
     struct IndexPage
     {
-      FileOffset                          fileOffset;
-      uint32_t                            remaining;
       std::unordered_map<Id,RouteNodeRef> nodeMap;
 
-      RouteNodeRef find(FileScanner& scanner,
-                        Id id);
+      RouteNodeRef find(Id id) const;
     };
 
-  private:
-    using ValueCache = Cache<Id, IndexPage>;
+    using IndexPageRef = std::shared_ptr<IndexPage>;
+    using ValueCache = ShardedCache<Id, IndexPageRef>;
+
+    /**
+     * Estimates the memory of a completely loaded index page
+     */
+    struct IndexPageMemorySizer : public ValueCache::ValueSizer
+    {
+      size_t GetSize(const IndexPageRef& value) const override
+      {
+        size_t nodeCount=value->nodeMap.size();
+
+        return sizeof(IndexPage)+
+               nodeCount*(sizeof(RouteNode)+sizeof(std::pair<const Id,RouteNodeRef>)+4*sizeof(void*));
+      }
+    };
 
   private:
     std::string                datafile;        //!< Basename part of the data file name
@@ -66,15 +85,15 @@ namespace osmscout {
     std::map<Pixel,IndexEntry> index;
 
     mutable FileScanner        scanner;         //!< File stream to the data file
-    mutable ValueCache         cache;           //!< Cache of loaded route node pages
-    mutable std::mutex         accessMutex;     //!< Mutex to secure multi-thread access
+    mutable ValueCache         cache;           //!< Thread-safe cache of loaded route node pages
+    mutable std::mutex         accessMutex;     //!< Mutex to secure multi-thread access to the scanner
     mutable Magnification      magnification;   //!< Magnification of tiled index
 
   private:
     bool LoadIndexPage(const osmscout::Pixel& tile,
-                       ValueCache::CacheRef& cacheRef) const;
+                       IndexPageRef& page) const;
     bool GetIndexPage(const osmscout::Pixel& tile,
-                      ValueCache::CacheRef& cacheRef) const;
+                      IndexPageRef& page) const;
 
   public:
     explicit RouteNodeDataFile(const std::string& datafile,
@@ -86,6 +105,8 @@ namespace osmscout {
     bool IsOpen() const;
     bool Close();
 
+    void SetMemoryBudget(const MemoryBudgetRef& budget);
+
     Pixel GetTile(const GeoCoord& coord) const;
     bool IsCovered(const Pixel& tile) const;
 
@@ -102,7 +123,7 @@ namespace osmscout {
 
       for (IteratorIn idIter=begin; idIter!=end; ++idIter) {
         Id                   id=*idIter;
-        ValueCache::CacheRef cacheRef;
+        IndexPageRef         page;
 
         GeoCoord coord=Point::GetCoordFromId(id);
         osmscout::Pixel tile=TileId::GetTile(magnification,coord).AsPixel();
@@ -110,12 +131,11 @@ namespace osmscout {
         //std::cout << "Tile " << tile.GetDisplayText() << " " << tile.GetId() << "..." << std::endl;
 
         if (!GetIndexPage(tile,
-                          cacheRef)) {
+                          page)) {
           return false;
         }
 
-        auto node=cacheRef->value.find(scanner,
-                                       id);
+        auto node=page->find(id);
 
         if (node==nullptr) {
           return false;
@@ -133,7 +153,7 @@ namespace osmscout {
     {
       for (IteratorIn idIter=begin; idIter!=end; ++idIter) {
         Id                   id=*idIter;
-        ValueCache::CacheRef cacheRef;
+        IndexPageRef         page;
 
         GeoCoord coord=Point::GetCoordFromId(id);
         osmscout::Pixel tile=TileId::GetTile(magnification,coord).AsPixel();
@@ -141,12 +161,11 @@ namespace osmscout {
         //std::cout << "Tile " << tile.GetDisplayText() << " " << tile.GetId() << "..." << std::endl;
 
         if (!GetIndexPage(tile,
-                          cacheRef)) {
+                          page)) {
           return false;
         }
 
-        auto node=cacheRef->value.find(scanner,
-                                       id);
+        auto node=page->find(id);
 
         if (node==nullptr) {
           return false;
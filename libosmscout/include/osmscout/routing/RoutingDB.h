@@ -21,6 +21,8 @@
 */
 
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <osmscout/Intersection.h>
 
@@ -32,6 +34,8 @@
 #include <osmscout/routing/RouteNode.h>
 #include <osmscout/routing/RouteNodeDataFile.h>
 
+#include <osmscout/util/ShardedCache.h>
+
 namespace osmscout {
 
   /**
@@ -39,14 +43,45 @@ namespace osmscout {
    *
    * Encapsulation of the routing relevant data files, similar to Database.
    */
-  class RoutingDatabase CLASS_FINAL
+  class OSMSCOUT_API RoutingDatabase CLASS_FINAL
   {
+  public:
+    /**
+     * A path of another route node leading to a given route node. Only the id of
+     * the route node is stored, so that cached paths do not keep route nodes
+     * in memory, that were evicted from the route node cache.
+     */
+    struct IncomingPath
+    {
+      Id       node;      //!< Id of the route node the path starts at
+      uint32_t pathIndex; //!< Index of the path in the paths of the node
+    };
+
+  private:
+    using IncomingPathCache = ShardedCache<Id,std::vector<IncomingPath>>;
+
+    /**
+     * Estimates the memory of the incoming paths of a route node
+     */
+    struct IncomingPathMemorySizer : public IncomingPathCache::ValueSizer
+    {
+      size_t GetSize(const std::vector<IncomingPath>& value) const override
+      {
+        return value.capacity()*sizeof(IncomingPath);
+      }
+    };
+
+    //! Number of route nodes the incoming paths are cached for
+    static constexpr size_t incomingPathCacheSize=50000;
+
   private:
     TypeConfigRef                    typeConfig;
     std::string                      path;
     RouteNodeDataFile                routeNodeDataFile;
     IndexedDataFile<Id,Intersection> junctionDataFile;      //!< Cached access to the 'junctions.dat' file
+    std::mutex                       junctionMutex;         //!< Secures opening and closing of the junction data file
     ObjectVariantDataFile            objectVariantDataFile;
+    mutable IncomingPathCache        incomingPathCache;     //!< Thread-safe cache of the incoming paths of route nodes, shared by all routers of the database
 
   public:
     RoutingDatabase();
@@ -81,6 +116,35 @@ namespace osmscout {
                                    routeNodes);
     }
 
+    /**
+     * Return the cached incoming paths of the given route node.
+     *
+     * Method is thread-safe.
+     *
+     * @return
+     *    False, if the incoming paths of the route node are not cached
+     */
+    inline bool GetIncomingPaths(const Id& id,
+                                 std::vector<IncomingPath>& paths) const
+    {
+      return incomingPathCache.GetEntry(id,
+                                        paths);
+    }
+
+    /**
+     * Cache the incoming paths of the given route node.
+     *
+     * Method is thread-safe.
+     */
+    inline void SetIncomingPaths(const Id& id,
+                                 const std::vector<IncomingPath>& paths) const
+    {
+      incomingPathCache.SetEntry(id,
+                                 paths);
+    }
+
+    bool GetJunction(Id id,
+                     JunctionRef& junction);
     bool GetJunctions(const std::set<Id>& ids,
                       std::vector<JunctionRef>& junctions);
 
@@ -20,6 +20,8 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <vector>
@@ -43,6 +45,8 @@
 #include <osmscout/util/String.h>
 #include <osmscout/log/Logger.h>
 
+#include <osmscout/system/Compiler.h>
+
 namespace osmscout {
 #ifdef OSMSCOUT_DEBUG_ROUTING
 constexpr bool debugRouting = true;
@@ -117,6 +121,116 @@ constexpr bool debugRouting = false;
       return SpeedVariant({speed, speed, speed, speed, speed});
     }
   };
+
+  /**
+   * \ingroup Routing
+   * Routing profile precalculated for the object variants of a routing database
+   * (see RoutingProfile::Compile()). Checking and evaluating a path of a route node
+   * is a lookup in a flat table indexed by the object variant index, instead of
+   * virtual calls resolving type, grade and speed of the object variant
+   * again for each path.
+   *
+   * The costs of a path are its distance divided by the speed of its object variant
+   * plus an optional junction penalty, matching ShortestPathRoutingProfile
+   * (speed 1) and FastestPathRoutingProfile.
+   */
+  class OSMSCOUT_API CompiledRoutingProfile CLASS_FINAL
+  {
+  public:
+    /**
+     * Routing relevant properties of an object variant
+     */
+    struct Variant
+    {
+      bool   usable=false;     //!< The profile allows using type and grade of the variant
+      size_t typeIndex=0;      //!< Index of the type of the variant
+      double speed=0.0;        //!< Speed for the costs of a path (distance/speed)
+      double penaltySpeed=0.0; //!< Speed for the junction penalty
+
+      bool operator==(const Variant& other) const = default;
+    };
+
+  private:
+    uint8_t              vehicleRouteNodeBit=0;
+    std::vector<Variant> variants;                  //!< Properties by object variant index
+    bool                 applyJunctionPenalty=false;
+    double               penaltySameType=0.0;       //!< Junction penalty distance for the same types in km
+    double               penaltyDifferentType=0.0;  //!< Junction penalty distance for different types in km
+    double               maxPenalty=0.0;            //!< Maximum junction penalty in hours
+
+  public:
+    void SetVehicleRouteNodeBit(uint8_t vehicleRouteNodeBit)
+    {
+      this->vehicleRouteNodeBit=vehicleRouteNodeBit;
+    }
+
+    void SetVariants(std::vector<Variant>&& variants)
+    {
+      this->variants=std::move(variants);
+    }
+
+    const std::vector<Variant>& GetVariants() const
+    {
+      return variants;
+    }
+
+    void SetJunctionPenalty(const Distance& penaltySameType,
+                            const Distance& penaltyDifferentType,
+                            const HourDuration& maxPenalty)
+    {
+      this->applyJunctionPenalty=true;
+      this->penaltySameType=penaltySameType.As<Kilometer>();
+      this->penaltyDifferentType=penaltyDifferentType.As<Kilometer>();
+      this->maxPenalty=maxPenalty.count();
+    }
+
+    /**
+     * Compiled profiles are equal, if they result in the same usability and costs for all paths
+     */
+    bool operator==(const CompiledRoutingProfile& other) const = default;
+
+    bool CanUse(const RouteNode& currentNode,
+                size_t pathIndex) const
+    {
+      const RouteNode::Path& path=currentNode.paths[pathIndex];
+
+      return (path.flags & vehicleRouteNodeBit)!=0 &&
+             variants[currentNode.objects[path.objectIndex].objectVariantIndex].usable;
+    }
+
+    /**
+     * Costs for outgoing path (outPathIndex) from currentNode
+     * when currentNode is entered from inPathIndex
+     */
+    double GetCosts(const RouteNode& currentNode,
+                    size_t inPathIndex,
+                    size_t outPathIndex) const
+    {
+      const RouteNode::Path& outPath=currentNode.paths[outPathIndex];
+      const Variant&         outVariant=variants[currentNode.objects[outPath.objectIndex].objectVariantIndex];
+      double                 costs=outVariant.speed<=0.0 ?
+                                   std::numeric_limits<double>::infinity() :
+                                   outPath.distance.As<Kilometer>()/outVariant.speed;
+
+      if (applyJunctionPenalty) {
+        size_t inObjectIndex=currentNode.paths[inPathIndex].objectIndex;
+
+        if (inObjectIndex!=outPath.objectIndex) {
+          const Variant& inVariant=variants[currentNode.objects[inObjectIndex].objectVariantIndex];
+          double         penaltyDistance=inVariant.typeIndex!=outVariant.typeIndex ? penaltyDifferentType : penaltySameType;
+          double         minSpeed=std::min(inVariant.penaltySpeed,outVariant.penaltySpeed);
+          double         penalty=minSpeed<=0.0 ?
+                                 std::numeric_limits<double>::infinity() :
+                                 penaltyDistance/minSpeed;
+
+          costs+=std::min(penalty,maxPenalty);
+        }
+      }
+
+      return costs;
+    }
+  };
+
   /**
    * \ingroup Routing
    * Abstract interface for a routing profile. A routing profile decides about the costs
@@ -177,6 +291,30 @@ constexpr bool debugRouting = false;
                              const Distance &distance) const = 0;
     virtual Duration GetTime(const Way& way,
                              const Distance &distance) const = 0;
+
+    /**
+     * Time required for the outgoing path (pathIndex) from currentNode, without
+     * any junction penalties
+     */
+    virtual Duration GetTime(const RouteNode& currentNode,
+                             const std::vector<ObjectVariantData>& objectVariantData,
+                             size_t pathIndex) const = 0;
+
+    /**
+     * Precalculate CanUse() and GetCosts() for the paths of route nodes
+     * for the given object variants. The library profiles only compile themselves
+     * if they are not subclassed, since a subclass may override CanUse() or GetCosts().
+     * Such subclasses can override this method to be compiled, too.
+     *
+     * @return
+     *    True, if the profile could be compiled. The router calls the virtual
+     *    methods of profiles that cannot be compiled.
+     */
+    virtual bool Compile(const std::vector<ObjectVariantData>& /*objectVariantData*/,
+                         CompiledRoutingProfile& /*compiled*/) const
+    {
+      return false;
+    }
   };
 
   using RoutingProfileRef = std::shared_ptr<RoutingProfile>;
@@ -228,6 +366,8 @@ constexpr bool debugRouting = false;
       return DurationOfHours(distance.As<Kilometer>()/speed);
     }
 
+    std::vector<CompiledRoutingProfile::Variant> CompileVariants(const std::vector<ObjectVariantData>& objectVariantData) const;
+
   public:
     explicit AbstractRoutingProfile(const TypeConfigRef& typeConfig);
 
@@ -308,6 +448,10 @@ constexpr bool debugRouting = false;
       return GetTime2(way,distance);
     }
 
+    Duration GetTime(const RouteNode& currentNode,
+                     const std::vector<ObjectVariantData>& objectVariantData,
+                     size_t pathIndex) const override;
+
     double GetUTurnCost() const override;
   };
 
@@ -349,6 +493,9 @@ constexpr bool debugRouting = false;
     {
       return Kilometers(cost).AsString();
     }
+
+    bool Compile(const std::vector<ObjectVariantData>& objectVariantData,
+                 CompiledRoutingProfile& compiled) const override;
   };
 
   using ShortestPathRoutingProfileRef = std::shared_ptr<ShortestPathRoutingProfile>;
@@ -535,6 +682,8 @@ constexpr bool debugRouting = false;
       return DurationString(std::chrono::duration_cast<Duration>(HourDuration(cost)));
     }
 
+    bool Compile(const std::vector<ObjectVariantData>& objectVariantData,
+                 CompiledRoutingProfile& compiled) const override;
   };
 
   using FastestPathRoutingProfileRef = std::shared_ptr<FastestPathRoutingProfile>;
@@ -22,11 +22,11 @@
 
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <set>
 #include <unordered_map>
-#include <unordered_set>
 
 #include <osmscout/lib/CoreFeatures.h>
 
@@ -48,6 +48,10 @@
 #include <osmscout/routing/RouteData.h>
 #include <osmscout/routing/RouteNodeDataFile.h>
 #include <osmscout/routing/RoutingProfile.h>
+
+#include <osmscout/util/FlatHashSet.h>
+#include <osmscout/util/IndexedHeap.h>
+#include <osmscout/util/ObjectArena.h>
 #include <osmscout/routing/DBFileOffset.h>
 
 #include <osmscout/async/Breaker.h>
@@ -188,10 +192,24 @@ namespace osmscout {
   private:
     BreakerRef         breaker;
     RoutingProgressRef progress;
+    bool               bidirectional=false; //!< Search from start and target simultaneously
+    size_t             threadCount=0;       //!< Number of worker threads of many-to-many calculations
+    size_t             alternativeCount=2;  //!< Maximum number of alternative routes
+    double             maxStretch=0.25;     //!< Maximum additional costs of an alternative route relative to the best route
+    double             maxSharing=0.8;      //!< Maximum fraction of an alternative route shared with better routes
+    double             minPlateau=0.1;      //!< Minimum costs of the locally optimal part of an alternative route relative to the best route
+    double             rerouteCorridor=0.2; //!< Additional costs of the routes around the route covered by a reroute tree
 
   public:
     void SetBreaker(const BreakerRef& breaker);
     void SetProgress(const RoutingProgressRef& progress);
+    void SetBidirectional(bool bidirectional);
+    void SetThreadCount(size_t threadCount);
+    void SetAlternativeCount(size_t alternativeCount);
+    void SetMaxStretch(double maxStretch);
+    void SetMaxSharing(double maxSharing);
+    void SetMinPlateau(double minPlateau);
+    void SetRerouteCorridor(double rerouteCorridor);
 
     BreakerRef GetBreaker() const
     {
@@ -202,6 +220,41 @@ namespace osmscout {
     {
       return progress;
     }
+
+    bool IsBidirectional() const
+    {
+      return bidirectional;
+    }
+
+    size_t GetThreadCount() const
+    {
+      return threadCount;
+    }
+
+    size_t GetAlternativeCount() const
+    {
+      return alternativeCount;
+    }
+
+    double GetMaxStretch() const
+    {
+      return maxStretch;
+    }
+
+    double GetMaxSharing() const
+    {
+      return maxSharing;
+    }
+
+    double GetMinPlateau() const
+    {
+      return minPlateau;
+    }
+
+    double GetRerouteCorridor() const
+    {
+      return rerouteCorridor;
+    }
   };
 
   /**
@@ -223,7 +276,7 @@ namespace osmscout {
       DBId          id;                   //!< The file offset of the current route node
       RouteNodeRef  node;                 //!< The current route node
       DBId          prev;                 //!< The file offset of the previous route node
-      Id            exclude;              //!< excluded node to go, similar to route-node excludes,
+      Id            exclude=0;            //!< excluded node to go, similar to route-node excludes,
                                           //!< but used by routing service when initial bearing is restricted
       bool          prevRestricted=false; //!< previous node is restricted
       ObjectFileRef object;               //!< The object (way/area) visited from the current route node
@@ -239,6 +292,8 @@ namespace osmscout {
        */
       bool          leaveRestricted=false;
 
+      size_t        heapIndex=std::numeric_limits<size_t>::max(); //!< Position in the OpenList
+
       RNode() = default;
 
       RNode(const DBId& id,
@@ -276,7 +331,8 @@ namespace osmscout {
       }
     };
 
-    using RNodeRef = std::shared_ptr<RNode>;
+    //! RNodes are allocated by the RNodeArena of the routing service and live until the next route calculation
+    using RNodeRef = RNode*;
 
     struct RNodeCostCompare
     {
@@ -317,6 +373,8 @@ namespace osmscout {
       bool          previousRestricted=false; //!< Previous node was accessed from restricted way
       ObjectFileRef object;                   //!< The object (way/area) visited from the current route node
 
+      VNode() = default;
+
       /**
        * Equality operator
        * @param other
@@ -370,23 +428,21 @@ namespace osmscout {
 
     /**
      * Helper class for calculating hash codes for
-     * VNode instances to make it usable in std::unordered_set.
+     * VNode instances to make it usable in the ClosedSet.
      */
     struct ClosedNodeHasher
     {
       size_t operator()(const VNode& node) const
       {
-        return std::hash<Id>()(node.currentNode.id) ^
-               std::hash<DatabaseId>()(node.currentNode.database) ^
-               std::hash<bool>()(node.currentRestricted);
+        return std::hash<Id>()((node.currentNode.id << 1) | (node.currentRestricted ? 1 : 0)) ^
+               (std::hash<DatabaseId>()(node.currentNode.database) << 24);
       }
     };
 
-    using OpenList    = std::set<RNodeRef, RNodeCostCompare>;
-    using OpenListRef = std::set<RNodeRef, RNodeCostCompare>::iterator;
-
-    using OpenMap     = std::unordered_map<DBId, OpenListRef>;
-    using ClosedSet   = std::unordered_set<VNode, ClosedNodeHasher>;
+    using RNodeArena  = ObjectArena<RNode>;
+    using OpenList    = IndexedHeap<RNode, RNodeCostCompare>;
+    using OpenMap     = std::unordered_map<DBId, RNodeRef>;
+    using ClosedSet   = FlatHashSet<VNode, ClosedNodeHasher>;
 
   public:
     //! Relative filename of the intersection data file
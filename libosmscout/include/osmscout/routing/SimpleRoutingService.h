@@ -22,11 +22,13 @@
 
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <list>
 #include <memory>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <osmscout/lib/CoreFeatures.h>
 
@@ -121,12 +123,95 @@ namespace osmscout {
 
     std::string                          path;                  //!< Path to the directory containing all files
 
-    RoutingDatabase                      routingDatabase;       //!< Access to routing data and index files
+    RoutingDatabaseRef                   routingDatabase;       //!< Access to routing data and index files
+    bool                                 sharedRoutingDatabase; //!< routingDatabase is opened and closed by the owner
 
   private:
     bool HasNodeWithId(const std::vector<Point>& nodes) const;
 
   protected:
+    /**
+     * A route node next to a source or target position of a matrix calculation,
+     * together with the costs of the way segment between position and route node
+     */
+    struct MatrixEndpoint
+    {
+      RouteNodeRef  routeNode;
+      ObjectFileRef object;       //!< The way of the position
+      double        cost=0;
+      double        distance=0;   //!< Distance in km
+      double        duration=0;   //!< Duration in hours
+    };
+
+    /**
+     * A source or target position of a matrix calculation
+     */
+    struct MatrixPosition
+    {
+      RoutePosition               position;
+      WayRef                      way;
+      std::vector<MatrixEndpoint> endpoints;
+    };
+
+    /**
+     * Label of the one-to-many search, additionally tracking distance and duration
+     */
+    struct MatrixNode : public RNode
+    {
+      using RNode::RNode;
+
+      double distance=0;         //!< Distance in km
+      double duration=0;         //!< Duration in hours
+    };
+
+    /**
+     * A path leaving the limits of the one-to-many search
+     */
+    struct MatrixExit
+    {
+      const MatrixNode* from;     //!< The settled node the path starts at
+      Id                to;       //!< The route node the path leads to
+      double            distance; //!< Distance at the end of the path in km
+      double            duration; //!< Duration at the end of the path in hours
+    };
+
+    /**
+     * State of the one-to-many search, reused for all sources of a worker thread
+     */
+    struct MatrixSearch
+    {
+      ObjectArena<MatrixNode>                  arena;
+      IndexedHeap<MatrixNode,RNodeCostCompare> openList;
+      std::unordered_map<Id,MatrixNode*>       openMap;
+      ClosedSet                                closedSet;
+      std::vector<const MatrixNode*>           reached;  //!< Settled node per target route node
+
+      double                                   maxDistance=std::numeric_limits<double>::infinity(); //!< Paths beyond this distance (km) are not followed
+      double                                   maxDuration=std::numeric_limits<double>::infinity(); //!< Paths beyond this duration (hours) are not followed
+      bool                                     collect=false; //!< Collect the settled nodes and the paths leaving the limits
+      std::vector<const MatrixNode*>           settled;  //!< Settled nodes, if collected
+      std::vector<MatrixExit>                  exits;    //!< Paths leaving the limits, if collected
+    };
+
+  protected:
+    MatrixEndpoint GetMatrixEndpoint(const RoutingProfile& profile,
+                                     const WayRef& way,
+                                     size_t fromIndex,
+                                     size_t toIndex,
+                                     const RouteNodeRef& routeNode,
+                                     const ObjectFileRef& object) const;
+
+    bool GetMatrixPosition(const RoutingProfile& profile,
+                           const RoutePosition& position,
+                           bool source,
+                           MatrixPosition& matrixPosition);
+
+    bool SearchOneToMany(const RoutingProfile& profile,
+                         const MatrixPosition& source,
+                         const std::unordered_map<Id,size_t>& targetNodes,
+                         const RoutingParameter& parameter,
+                         MatrixSearch& search);
+
     Vehicle GetVehicle(const RoutingProfile& profile) override;
 
     bool CanUse(const RoutingProfile& profile,
@@ -155,6 +240,10 @@ namespace osmscout {
 
     double GetUTurnCost(const RoutingProfile& profile, const DatabaseId databaseId) override;
 
+    bool CompileProfile(const RoutingProfile& profile,
+                        DatabaseId database,
+                        CompiledRoutingProfile& compiled) override;
+
     double GetEstimateCosts(const RoutingProfile& profile,
                             DatabaseId database,
                             const Distance &targetDistance) override;
@@ -191,10 +280,23 @@ namespace osmscout {
                                    DatabaseId database,
                                    Id id) override;
 
+    bool GetJunctionObjects(const DBId& id,
+                            std::vector<ObjectFileRef>& objects) override;
+
+    bool GetCachedIncomingPaths(const DBId& id,
+                                std::vector<RoutingDatabase::IncomingPath>& paths) override;
+
+    void CacheIncomingPaths(const DBId& id,
+                            const std::vector<RoutingDatabase::IncomingPath>& paths) override;
+
   public:
     SimpleRoutingService(const DatabaseRef& database,
                          const RouterParameter& parameter,
                          const std::string& filenamebase);
+    SimpleRoutingService(const DatabaseRef& database,
+                         const RouterParameter& parameter,
+                         const std::string& filenamebase,
+                         const RoutingDatabaseRef& routingDatabase);
     ~SimpleRoutingService() override;
 
     bool Open();
@@ -208,6 +310,11 @@ namespace osmscout {
                                           const Distance &radius,
                                           const RoutingParameter& parameter);
 
+    RoutingMatrixResult CalculateMatrix(const RoutingProfile& profile,
+                                        const std::vector<RoutePosition>& sources,
+                                        const std::vector<RoutePosition>& targets,
+                                        const RoutingParameter& parameter);
+
     /**
      * Return routable node on specific object, when this object is routable
      * and usable by provided profile.
@@ -0,0 +1,107 @@
+#ifndef OSMSCOUT_SYSTEM_VECTORMATH_H
+#define OSMSCOUT_SYSTEM_VECTORMATH_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+namespace osmscout {
+
+  /**
+   * Vector instruction set extensions used for the batch calculation functions
+   * in this file. The extensions actually used are detected at runtime, so
+   * the library does not need to be compiled for a specific CPU.
+   */
+  enum class VectorInstructionSet
+  {
+    none   = 0, //!< Plain scalar code
+    avx2   = 1, //!< AVX2 and FMA, 4 values per instruction
+    avx512 = 2  //!< AVX-512F, 8 values per instruction
+  };
+
+  /**
+   * Return the best instruction set supported by the CPU and the compiler
+   * the library has been built with.
+   */
+  extern OSMSCOUT_API VectorInstructionSet GetSupportedVectorInstructionSet();
+
+  /**
+   * Return the instruction set currently used by the batch calculation functions.
+   */
+  extern OSMSCOUT_API VectorInstructionSet GetVectorInstructionSet();
+
+  /**
+   * Limit the instruction set used by the batch calculation functions, the
+   * supported instruction set is used if the requested one is not available.
+   * Mainly useful for testing and benchmarking.
+   */
+  extern OSMSCOUT_API void SetVectorInstructionSet(VectorInstructionSet instructionSet);
+
+  /**
+   * Calculate atanh(sin(x)) for count values, as required by the Mercator
+   * projection. Input and output may be the same array.
+   *
+   * Results of the vector code paths differ from std::atanh(std::sin(x)) by
+   * less than 1e-13.
+   */
+  extern OSMSCOUT_API void AtanhSin(const double* x,
+                                    double* result,
+                                    size_t count);
+
+  /**
+   * Return the index of the first of count points, whose x or y coordinate
+   * differs by more than tolerance from the reference point, or count if
+   * there is no such point.
+   */
+  extern OSMSCOUT_API size_t FindDistantPoint(const double* x,
+                                              const double* y,
+                                              size_t count,
+                                              double refX,
+                                              double refY,
+                                              double tolerance);
+
+  /**
+   * Return the index of the first of count points, which is equal to its
+   * predecessor, or count if there is no such point.
+   */
+  extern OSMSCOUT_API size_t FindEqualConsecutivePoint(const double* x,
+                                                       const double* y,
+                                                       size_t count);
+
+  /**
+   * Return the index of the first of count points with the largest distance
+   * to the line segment from a to b, or count if no point has a distance
+   * greater than 0. The squared distance is returned in maxDistanceSquared.
+   *
+   * All code paths return the same result.
+   */
+  extern OSMSCOUT_API size_t FindMaxDistanceToSegment(const double* x,
+                                                      const double* y,
+                                                      size_t count,
+                                                      double ax,
+                                                      double ay,
+                                                      double bx,
+                                                      double by,
+                                                      double& maxDistanceSquared);
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef OSMSCOUT_UTIL_FLATHASHSET_H
+#define OSMSCOUT_UTIL_FLATHASHSET_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * Hash set with open addressing (linear probing) storing its values in one
+   * flat array. In contrast to std::unordered_set there is no allocation
+   * per value and lookups touch adjacent memory only. Values cannot be removed.
+   *
+   * The interface follows std::unordered_set, so it can replace it for
+   * insert-only sets. Iterators and references are invalidated by insert().
+   * T must be default constructible.
+   */
+  template<typename T, typename Hash=std::hash<T>, typename Equal=std::equal_to<T>>
+  class FlatHashSet CLASS_FINAL
+  {
+  public:
+    class const_iterator
+    {
+    private:
+      const FlatHashSet* set;
+      size_t             index;
+
+    private:
+      void SkipUnused()
+      {
+        while (index<set->slots.size() &&
+               !set->used[index]) {
+          index++;
+        }
+      }
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const T*;
+      using reference         = const T&;
+
+      const_iterator()
+      : set(nullptr),
+        index(0)
+      {
+        // no code
+      }
+
+      const_iterator(const FlatHashSet* set,
+                     size_t index)
+      : set(set),
+        index(index)
+      {
+        SkipUnused();
+      }
+
+      reference operator*() const
+      {
+        return set->slots[index];
+      }
+
+      pointer operator->() const
+      {
+        return &set->slots[index];
+      }
+
+      const_iterator& operator++()
+      {
+        index++;
+        SkipUnused();
+
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const_iterator result=*this;
+
+        ++(*this);
+
+        return result;
+      }
+
+      bool operator==(const const_iterator& other) const
+      {
+        return index==other.index;
+      }
+
+      bool operator!=(const const_iterator& other) const
+      {
+        return index!=other.index;
+      }
+    };
+
+    using value_type = T;
+    using iterator   = const_iterator;
+
+  private:
+    std::vector<T>       slots;
+    std::vector<uint8_t> used;
+    size_t               count=0;
+    Hash                 hash;
+    Equal                equal;
+
+  private:
+    /**
+     * Index of the slot holding the value or of the empty slot, where it
+     * would be inserted. There must be at least one slot.
+     */
+    size_t FindSlot(const T& value) const
+    {
+      // Mix the bits (finalizer of MurmurHash3), since hashes of integers
+      // are often the identity and only the lower bits select the slot
+      uint64_t h=hash(value);
+
+      h^=h >> 33;
+      h*=0xff51afd7ed558ccdULL;
+      h^=h >> 33;
+
+      size_t mask=slots.size()-1;
+      size_t index=static_cast<size_t>(h) & mask;
+
+      while (used[index] &&
+             !equal(slots[index],value)) {
+        index=(index+1) & mask;
+      }
+
+      return index;
+    }
+
+    void Rehash(size_t capacity)
+    {
+      std::vector<T>       oldSlots(capacity);
+      std::vector<uint8_t> oldUsed(capacity,0);
+
+      slots.swap(oldSlots);
+      used.swap(oldUsed);
+
+      for (size_t i=0; i<oldSlots.size(); i++) {
+        if (oldUsed[i]) {
+          size_t index=FindSlot(oldSlots[i]);
+
+          slots[index]=std::move(oldSlots[i]);
+          used[index]=1;
+        }
+      }
+    }
+
+  public:
+    bool empty() const
+    {
+      return count==0;
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    /**
+     * Make sure that the given number of values can be stored without rehashing
+     */
+    void reserve(size_t size)
+    {
+      size_t capacity=16;
+
+      // keep the load factor at or below 1/2
+      while (capacity<size*2) {
+        capacity*=2;
+      }
+
+      if (capacity>slots.size()) {
+        Rehash(capacity);
+      }
+    }
+
+    std::pair<const_iterator,bool> insert(const T& value)
+    {
+      if ((count+1)*2>slots.size()) {
+        Rehash(slots.empty() ? 16 : slots.size()*2);
+      }
+
+      size_t index=FindSlot(value);
+
+      if (used[index]) {
+        return std::make_pair(const_iterator(this,index),false);
+      }
+
+      slots[index]=value;
+      used[index]=1;
+      count++;
+
+      return std::make_pair(const_iterator(this,index),true);
+    }
+
+    const_iterator find(const T& value) const
+    {
+      if (slots.empty()) {
+        return end();
+      }
+
+      size_t index=FindSlot(value);
+
+      if (!used[index]) {
+        return end();
+      }
+
+      return const_iterator(this,index);
+    }
+
+    bool contains(const T& value) const
+    {
+      return find(value)!=end();
+    }
+
+    /**
+     * Remove all values, but keep the allocated slots
+     */
+    void clear()
+    {
+      for (size_t i=0; i<slots.size(); i++) {
+        if (used[i]) {
+          slots[i]=T();
+          used[i]=0;
+        }
+      }
+
+      count=0;
+    }
+
+    const_iterator begin() const
+    {
+      return const_iterator(this,0);
+    }
+
+    const_iterator end() const
+    {
+      return const_iterator(this,slots.size());
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef OSMSCOUT_UTIL_INDEXEDHEAP_H
+#define OSMSCOUT_UTIL_INDEXEDHEAP_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * A d-ary min-heap of pointers to objects that store their own position in
+   * the heap (public member heapIndex of type size_t). Knowing the position
+   * allows changing the key of an object while it is in the heap (decrease-key)
+   * in O(log n) without searching for it or removing and reinserting it.
+   *
+   * Compare defines a strict weak ordering on the pointers, the smallest
+   * element is on top. The heap does not own the objects.
+   *
+   * A 4-ary heap is flatter than a binary heap, and the children of a node are
+   * next to each other in memory. This makes it faster than a binary heap for
+   * searches with many key updates, like Dijkstra and A*.
+   */
+  template<typename T, typename Compare, size_t Arity=4>
+  class IndexedHeap CLASS_FINAL
+  {
+    static_assert(Arity>=2,"Heap arity must be at least 2");
+
+  public:
+    //! Value of heapIndex of an object not in the heap
+    static constexpr size_t npos=std::numeric_limits<size_t>::max();
+
+    using const_iterator = typename std::vector<T*>::const_iterator;
+
+  private:
+    std::vector<T*> heap;
+    Compare         compare;
+
+  private:
+    void Place(T* object,
+               size_t index)
+    {
+      heap[index]=object;
+      object->heapIndex=index;
+    }
+
+    void MoveUp(size_t index)
+    {
+      T* object=heap[index];
+
+      while (index>0) {
+        size_t parent=(index-1)/Arity;
+
+        if (!compare(object,heap[parent])) {
+          break;
+        }
+
+        Place(heap[parent],index);
+        index=parent;
+      }
+
+      Place(object,index);
+    }
+
+    void MoveDown(size_t index)
+    {
+      T*     object=heap[index];
+      size_t size=heap.size();
+
+      while (true) {
+        size_t first=index*Arity+1;
+
+        if (first>=size) {
+          break;
+        }
+
+        size_t last=std::min(first+Arity,size);
+        size_t smallest=first;
+
+        for (size_t child=first+1; child<last; child++) {
+          if (compare(heap[child],heap[smallest])) {
+            smallest=child;
+          }
+        }
+
+        if (!compare(heap[smallest],object)) {
+          break;
+        }
+
+        Place(heap[smallest],index);
+        index=smallest;
+      }
+
+      Place(object,index);
+    }
+
+  public:
+    IndexedHeap() = default;
+
+    explicit IndexedHeap(const Compare& compare)
+    : compare(compare)
+    {
+      // no code
+    }
+
+    bool IsEmpty() const
+    {
+      return heap.empty();
+    }
+
+    size_t GetSize() const
+    {
+      return heap.size();
+    }
+
+    void Reserve(size_t size)
+    {
+      heap.reserve(size);
+    }
+
+    /**
+     * Return true, if the given object is currently in the heap
+     */
+    bool Contains(const T* object) const
+    {
+      return object->heapIndex<heap.size() &&
+             heap[object->heapIndex]==object;
+    }
+
+    /**
+     * Return the smallest object. The heap must not be empty.
+     */
+    T* Top() const
+    {
+      assert(!heap.empty());
+
+      return heap.front();
+    }
+
+    void Push(T* object)
+    {
+      heap.push_back(object);
+      MoveUp(heap.size()-1);
+    }
+
+    /**
+     * Remove and return the smallest object. The heap must not be empty.
+     */
+    T* Pop()
+    {
+      T* top=Top();
+
+      Remove(top);
+
+      return top;
+    }
+
+    /**
+     * Restore the heap order after the key of the given object (which must be in
+     * the heap) has changed
+     */
+    void Update(T* object)
+    {
+      assert(Contains(object));
+
+      size_t index=object->heapIndex;
+
+      MoveUp(index);
+
+      if (object->heapIndex==index) {
+        MoveDown(index);
+      }
+    }
+
+    /**
+     * Remove the given object (which must be in the heap) from the heap
+     */
+    void Remove(T* object)
+    {
+      assert(Contains(object));
+
+      size_t index=object->heapIndex;
+      T*     last=heap.back();
+
+      heap.pop_back();
+      object->heapIndex=npos;
+
+      if (index<heap.size()) {
+        Place(last,index);
+        Update(last);
+      }
+    }
+
+    void Clear()
+    {
+      for (T* object : heap) {
+        object->heapIndex=npos;
+      }
+
+      heap.clear();
+    }
+
+    /**
+     * Iteration over all objects in the heap, in heap order (not sorted)
+     */
+    const_iterator begin() const
+    {
+      return heap.begin();
+    }
+
+    const_iterator end() const
+    {
+      return heap.end();
+    }
+  };
+}
+
+#endif
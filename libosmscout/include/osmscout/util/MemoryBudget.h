@@ -0,0 +1,168 @@
+#ifndef OSMSCOUT_MEMORYBUDGET_H
+#define OSMSCOUT_MEMORYBUDGET_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * Byte based memory budget, shared by multiple caches (consumers).
+   *
+   * Consumers charge the (estimated) memory of every cached entry to the budget
+   * and release it again, when the entry is dropped. If the budget is exceeded,
+   * the budget evicts entries from the consumer holding the least recently accessed
+   * entry, until the budget fits again. To compare accesses over all consumers,
+   * consumers tag accesses with ticks of a global access clock (NextAccess()).
+   *
+   * Consumers, that cannot evict entries at arbitrary times (because they are not
+   * thread-safe), may still charge their memory and evict entries themselves at
+   * suitable points in time, as long as the budget is exceeded and they hold the
+   * least recently accessed entry (see GetOldestAccessOfOthers()).
+   *
+   * The class is thread-safe.
+   */
+  class OSMSCOUT_API MemoryBudget CLASS_FINAL
+  {
+  public:
+    //! Access tick of an empty consumer
+    static constexpr uint64_t NoAccess=std::numeric_limits<uint64_t>::max();
+
+    /**
+     * Statistics of an individual consumer
+     */
+    struct Statistics
+    {
+      std::string name;        //!< Name of the consumer
+      size_t      entries=0;   //!< Number of cached entries
+      size_t      memory=0;    //!< Memory charged to the budget in bytes
+      size_t      hits=0;      //!< Number of successful lookups
+      size_t      misses=0;    //!< Number of failed lookups
+      size_t      evictions=0; //!< Number of entries evicted because of size limits
+    };
+
+    /**
+     * Interface to be implemented by consumers of the budget
+     */
+    class OSMSCOUT_API Consumer
+    {
+    public:
+      virtual ~Consumer() = default;
+
+      /**
+       * Return the access tick of the least recently accessed entry,
+       * or NoAccess, if the consumer is empty.
+       */
+      virtual uint64_t GetOldestAccess() const = 0;
+
+      /**
+       * Evict least recently accessed entries, until at least the given
+       * number of bytes is freed or the oldest remaining entry was accessed
+       * after the given access tick. At least one entry should be evicted.
+       * The freed memory has to be released from the budget by the consumer.
+       *
+       * Called without any lock of the consumer held by the budget.
+       *
+       * @return number of bytes freed, 0 if the consumer cannot evict entries
+       */
+      virtual size_t Evict(size_t bytes,
+                           uint64_t newerThan) = 0;
+
+      virtual Statistics GetStatistics() const = 0;
+    };
+
+  private:
+    std::atomic<size_t>    maxSize;        //!< Maximum memory in bytes
+    std::atomic<size_t>    size;           //!< Memory currently charged in bytes
+    std::atomic<uint64_t>  accessClock;    //!< Global access clock
+
+    mutable std::mutex     consumerMutex;  //!< Guards consumers and serializes reclaiming
+    std::vector<Consumer*> consumers;      //!< Registered consumers
+
+  private:
+    void Reclaim();
+
+  public:
+    explicit MemoryBudget(size_t maxSize);
+
+    // disable copy and move
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget(MemoryBudget&&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(MemoryBudget&&) = delete;
+
+    ~MemoryBudget() = default;
+
+    void Register(Consumer& consumer);
+    void Unregister(Consumer& consumer);
+
+    /**
+     * Return a new tick of the global access clock
+     */
+    uint64_t NextAccess()
+    {
+      return accessClock.fetch_add(1,std::memory_order_relaxed)+1;
+    }
+
+    void Charge(size_t bytes);
+    void Release(size_t bytes);
+
+    bool IsExceeded() const
+    {
+      return size.load(std::memory_order_relaxed)>maxSize.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetOldestAccessOfOthers(const Consumer& consumer) const;
+
+    void SetMaxSize(size_t maxSize);
+
+    size_t GetMaxSize() const
+    {
+      return maxSize.load(std::memory_order_relaxed);
+    }
+
+    size_t GetSize() const
+    {
+      return size.load(std::memory_order_relaxed);
+    }
+
+    std::vector<Statistics> GetStatistics() const;
+
+    void DumpStatistics() const;
+  };
+
+  //! Reference counted reference to a MemoryBudget instance
+  using MemoryBudgetRef = std::shared_ptr<MemoryBudget>;
+}
+
+#endif
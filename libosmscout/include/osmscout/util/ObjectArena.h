@@ -0,0 +1,143 @@
+#ifndef OSMSCOUT_UTIL_OBJECTARENA_H
+#define OSMSCOUT_UTIL_OBJECTARENA_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * Allocates objects of type T in chunks and releases all of them at once
+   * by Clear(). The chunks are kept and reused after Clear(), so a repeated
+   * task (like the search of a route calculation) does not allocate any
+   * memory for its objects after the first run.
+   *
+   * Objects are constructed in place by Allocate() and destroyed by Clear(),
+   * the chunks themselves hold uninitialized storage.
+   *
+   * Pointers returned by Allocate() stay valid until Clear() is called or
+   * the arena is destroyed.
+   *
+   * The class is not thread-safe.
+   */
+  template<typename T>
+  class ObjectArena CLASS_FINAL
+  {
+  private:
+    struct ChunkDeleter
+    {
+      void operator()(T* objects) const
+      {
+        ::operator delete(objects,std::align_val_t(alignof(T)));
+      }
+    };
+
+    using Chunk = std::unique_ptr<T,ChunkDeleter>;
+
+  private:
+    size_t             chunkSize; //!< Number of objects per chunk
+    std::vector<Chunk> chunks;
+    size_t             chunk=0;   //!< Index of the current chunk
+    size_t             offset=0;  //!< Index of the next free object in the current chunk
+    size_t             count=0;   //!< Number of allocated objects
+
+  public:
+    explicit ObjectArena(size_t chunkSize=4096)
+    : chunkSize(chunkSize)
+    {
+      // no code
+    }
+
+    ObjectArena(const ObjectArena&) = delete;
+    ObjectArena& operator=(const ObjectArena&) = delete;
+
+    ~ObjectArena()
+    {
+      Clear();
+    }
+
+    /**
+     * Return a new object, constructed from the given arguments
+     */
+    template<typename... Args>
+    T* Allocate(Args&&... args)
+    {
+      if (offset==chunkSize) {
+        chunk++;
+        offset=0;
+      }
+
+      if (chunk==chunks.size()) {
+        chunks.emplace_back(static_cast<T*>(::operator new(sizeof(T)*chunkSize,
+                                                           std::align_val_t(alignof(T)))));
+      }
+
+      T* object=new (chunks[chunk].get()+offset) T(std::forward<Args>(args)...);
+
+      offset++;
+      count++;
+
+      return object;
+    }
+
+    /**
+     * Destroy all objects. The memory of the chunks is kept for reuse.
+     */
+    void Clear()
+    {
+      for (size_t c=0; c<chunks.size() && c<=chunk; c++) {
+        size_t end=c<chunk ? chunkSize : offset;
+
+        std::destroy_n(chunks[c].get(),end);
+      }
+
+      chunk=0;
+      offset=0;
+      count=0;
+    }
+
+    /**
+     * Number of objects allocated since the last Clear()
+     */
+    size_t GetSize() const
+    {
+      return count;
+    }
+
+    /**
+     * Number of objects the arena can hold without allocating memory
+     */
+    size_t GetCapacity() const
+    {
+      return chunks.size()*chunkSize;
+    }
+  };
+}
+
+#endif
@@ -49,6 +49,15 @@ namespace osmscout {
   public:
     using Ptr = std::unique_ptr<T, std::function<void(T*)>>;
 
+  protected:
+    /**
+     * Wrap an object made by a subclass, so that it is returned to the pool
+     */
+    Ptr Wrap(T* o)
+    {
+      return Ptr(o, [this](T* o){ Return(o); });
+    }
+
   public:
     explicit ObjectPool(size_t maxSize):
         maxSize(maxSize)
@@ -88,7 +97,21 @@ namespace osmscout {
           return std::unique_ptr<T>(nullptr);
         }
       }
-      return Ptr(o, [this](T* o){ Return(o); });
+      return Wrap(o);
+    }
+
+    /**
+     * Borrow a pooled object, without making a new one. Returns nullptr, if the pool is empty.
+     */
+    Ptr BorrowPooled()
+    {
+      std::scoped_lock<std::mutex> guard(mutex);
+      if (pool.empty()){
+        return std::unique_ptr<T>(nullptr);
+      }
+      T* o=pool.back();
+      pool.pop_back();
+      return Wrap(o);
     }
 
     size_t Size()
@@ -105,6 +128,24 @@ namespace osmscout {
       }
       pool.clear();
     }
+
+    /**
+     * Destroy all pooled objects, if the pool is not locked by another thread at the moment.
+     * Returns the number of destroyed objects.
+     */
+    size_t TryClear() noexcept
+    {
+      std::unique_lock<std::mutex> guard(mutex,std::try_to_lock);
+      if (!guard.owns_lock()){
+        return 0;
+      }
+      size_t count=pool.size();
+      for (T* o:pool){
+        Destroy(o);
+      }
+      pool.clear();
+      return count;
+    }
   };
 
 }
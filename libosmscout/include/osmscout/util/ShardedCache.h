@@ -0,0 +1,654 @@
+#ifndef OSMSCOUT_SHARDEDCACHE_H
+#define OSMSCOUT_SHARDEDCACHE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/lib/CoreFeatures.h>
+
+#include <osmscout/util/Cache.h>
+#include <osmscout/util/MemoryBudget.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   * Thread-safe cache, split into independent shards.
+   *
+   * Keys are distributed over a power-of-two number of shards by (mixed) hash,
+   * every shard has its own mutex, entry list and lookup map. Threads working
+   * on different keys therefore rarely contend on the same lock, in contrast to
+   * the Cache class, that must be guarded by one external mutex.
+   *
+   * Two eviction policies are supported:
+   * * LRU - entry is moved to the front of its shard list on every hit
+   *   (same semantic as Cache).
+   * * Clock - hit just marks the entry as referenced, the list is not touched.
+   *   On eviction, referenced entries get a second chance and are moved to the
+   *   front, unreferenced ones are dropped. Hits are cheaper than with LRU.
+   *
+   * If a ValueSizer is given, the cache size and max size are measured in bytes
+   * (as reported by the sizer), otherwise in number of entries.
+   *
+   * Additionally the cache can draw from a MemoryBudget shared with other caches
+   * (see SetMemoryBudget()). The memory of the entries (as estimated by a separate
+   * sizer plus the bookkeeping overhead) is then charged to the budget and
+   * entries may get evicted by the budget in favour of more recently accessed
+   * entries of other caches, independent of the max size of this cache.
+   *
+   * As references into the cache cannot be handed out safely, values are returned
+   * by copy. V is expected to be cheap to copy (like std::shared_ptr).
+   */
+  template <class K, class V>
+  class ShardedCache
+  {
+  public:
+    using ValueSizer = typename Cache<K,V>::ValueSizer;
+
+    enum class EvictionPolicy
+    {
+      LRU,
+      Clock
+    };
+
+    /**
+     * Cache statistics, summed over all shards
+     */
+    struct Statistics
+    {
+      size_t entries=0; //!< Number of entries in the cache
+      size_t size=0;    //!< Size of the cache (entries or bytes, see ValueSizer)
+      size_t hits=0;      //!< Number of successful lookups
+      size_t misses=0;    //!< Number of failed lookups
+      size_t memory=0;    //!< Memory charged to the memory budget in bytes
+      size_t evictions=0; //!< Number of entries evicted because of size limits
+    };
+
+    static constexpr size_t DefaultShardCount=16;
+
+  private:
+    struct Entry
+    {
+      K        key;
+      V        value;
+      size_t   size;
+      bool     referenced;
+      size_t   memory;     //!< Memory charged to the budget
+      uint64_t lastAccess; //!< Tick of the budget access clock
+    };
+
+    using OrderList = std::list<Entry>;
+    using Map       = std::unordered_map<K, typename OrderList::iterator>;
+
+    struct Shard
+    {
+      mutable std::mutex mutex;
+      OrderList          order;     //!< Most recently inserted (LRU: used) entries first
+      Map                map;       //!< Key=>Entry map
+      size_t             size=0;    //!< Current size of the shard
+      size_t             maxSize=0; //!< Maximum size of the shard
+      size_t             hits=0;
+      size_t             misses=0;
+      size_t             memory=0;  //!< Memory charged to the budget by the shard
+      size_t             evictions=0;
+    };
+
+    /**
+     * Adapter registered at the memory budget
+     */
+    class BudgetConsumer : public MemoryBudget::Consumer
+    {
+    private:
+      ShardedCache& cache;
+
+    public:
+      explicit BudgetConsumer(ShardedCache& cache)
+      : cache(cache)
+      {
+        // no code
+      }
+
+      uint64_t GetOldestAccess() const override
+      {
+        return cache.GetOldestAccess();
+      }
+
+      size_t Evict(size_t bytes,
+                   uint64_t newerThan) override
+      {
+        return cache.EvictOldest(bytes,
+                                 newerThan);
+      }
+
+      MemoryBudget::Statistics GetStatistics() const override
+      {
+        Statistics               statistics=cache.GetStatistics();
+        MemoryBudget::Statistics budgetStatistics;
+
+        budgetStatistics.name=cache.name;
+        budgetStatistics.entries=statistics.entries;
+        budgetStatistics.memory=statistics.memory;
+        budgetStatistics.hits=statistics.hits;
+        budgetStatistics.misses=statistics.misses;
+        budgetStatistics.evictions=statistics.evictions;
+
+        return budgetStatistics;
+      }
+    };
+
+    //! Estimated memory overhead of an entry (list and map nodes)
+    static constexpr size_t EntryOverhead=sizeof(Entry)+4*sizeof(void*)+sizeof(K);
+
+  private:
+    EvictionPolicy                    policy;
+    std::shared_ptr<const ValueSizer> sizer;
+    size_t                            maxSize;
+    std::vector<Shard>                shards;
+    size_t                            shardMask;
+
+    MemoryBudgetRef                   budget;         //!< Optional shared memory budget
+    std::shared_ptr<const ValueSizer> memorySizer;    //!< Estimates the memory of a value for the budget
+    std::string                       name;           //!< Name of the cache in budget statistics
+    std::unique_ptr<BudgetConsumer>   budgetConsumer;
+
+  private:
+    static size_t ShardCountFor(size_t maxSize,
+                                size_t requestedCount)
+    {
+      size_t count=1;
+
+      // Power of two, not greater than requested and (for small caches) max size
+      while (count*2<=requestedCount &&
+             count*2<=std::max(maxSize,(size_t)1)) {
+        count*=2;
+      }
+
+      return count;
+    }
+
+    Shard& GetShard(const K& key)
+    {
+      // Keys (like file offsets) are often not well distributed in the low bits,
+      // so mix the hash before masking
+      uint64_t hash=std::hash<K>()(key);
+
+      hash*=0x9E3779B97F4A7C15ULL;
+
+      return shards[(hash >> 32) & shardMask];
+    }
+
+    size_t GetValueSize(const V& value) const
+    {
+      return sizer ? sizer->GetSize(value) : 1;
+    }
+
+    size_t GetValueMemory(const V& value) const
+    {
+      return EntryOverhead+(memorySizer ? memorySizer->GetSize(value) : 0);
+    }
+
+    uint64_t NextAccess() const
+    {
+      return budget ? budget->NextAccess() : 0;
+    }
+
+    /**
+     * Give the entry a second chance by moving it to the front.
+     * Shard must be locked by the caller.
+     */
+    void SecondChance(Shard& shard,
+                      typename OrderList::iterator entry) const
+    {
+      entry->referenced=false;
+      entry->lastAccess=NextAccess();
+      shard.order.splice(shard.order.begin(),shard.order,entry);
+    }
+
+    /**
+     * Remove the last entry of the shard.
+     * Shard must be locked by the caller.
+     *
+     * @return memory of the entry
+     */
+    size_t DropLast(Shard& shard)
+    {
+      auto   last=std::prev(shard.order.end());
+      size_t memory=last->memory;
+
+      shard.size-=last->size;
+      shard.memory-=memory;
+      shard.evictions++;
+      shard.map.erase(last->key);
+      shard.order.pop_back();
+
+      return memory;
+    }
+
+    /**
+     * Evict entries from the shard until it fits its max size.
+     * Shard must be locked by the caller.
+     *
+     * @return memory of the evicted entries, to be released from the budget
+     */
+    size_t StripShard(Shard& shard)
+    {
+      size_t freed=0;
+
+      while (shard.size>shard.maxSize && !shard.order.empty()) {
+        auto last=std::prev(shard.order.end());
+
+        if (policy==EvictionPolicy::Clock &&
+            last->referenced) {
+          SecondChance(shard,last);
+          continue;
+        }
+
+        freed+=DropLast(shard);
+      }
+
+      return freed;
+    }
+
+    void DistributeMaxSize()
+    {
+      size_t shardMaxSize=(maxSize+shards.size()-1)/shards.size();
+      size_t freed=0;
+
+      for (auto& shard : shards) {
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        shard.maxSize=shardMaxSize;
+        freed+=StripShard(shard);
+      }
+
+      if (budget) {
+        budget->Release(freed);
+      }
+    }
+
+    /**
+     * Return the budget access tick of the least recently accessed entry
+     */
+    uint64_t GetOldestAccess() const
+    {
+      uint64_t oldestAccess=MemoryBudget::NoAccess;
+
+      for (const auto& shard : shards) {
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        if (!shard.order.empty()) {
+          oldestAccess=std::min(oldestAccess,shard.order.back().lastAccess);
+        }
+      }
+
+      return oldestAccess;
+    }
+
+    /**
+     * Evict least recently accessed entries over all shards, see MemoryBudget::Consumer::Evict()
+     */
+    size_t EvictOldest(size_t bytes,
+                       uint64_t newerThan)
+    {
+      size_t freed=0;
+
+      while (freed<bytes) {
+        Shard*   oldestShard=nullptr;
+        uint64_t oldestAccess=MemoryBudget::NoAccess;
+
+        for (auto& shard : shards) {
+          std::scoped_lock<std::mutex> lock(shard.mutex);
+
+          if (!shard.order.empty() &&
+              shard.order.back().lastAccess<oldestAccess) {
+            oldestShard=&shard;
+            oldestAccess=shard.order.back().lastAccess;
+          }
+        }
+
+        if (oldestShard==nullptr ||
+            (freed>0 && oldestAccess>newerThan)) {
+          break;
+        }
+
+        std::scoped_lock<std::mutex> lock(oldestShard->mutex);
+
+        if (oldestShard->order.empty()) {
+          continue;
+        }
+
+        auto last=std::prev(oldestShard->order.end());
+
+        if (policy==EvictionPolicy::Clock &&
+            last->referenced) {
+          SecondChance(*oldestShard,last);
+          continue;
+        }
+
+        freed+=DropLast(*oldestShard);
+      }
+
+      budget->Release(freed);
+
+      return freed;
+    }
+
+  public:
+    /**
+     * Create a new cache object with the given max size.
+     *
+     * @param maxSize
+     *    Maximum number of entries, or bytes when sizer is given. Zero disables the cache.
+     * @param shardCount
+     *    Requested number of shards, rounded down to power of two. For small max sizes
+     *    the number of shards is reduced.
+     * @param policy
+     *    Eviction policy
+     * @param sizer
+     *    Optional sizer, measuring the value size in bytes.
+     */
+    explicit ShardedCache(size_t maxSize,
+                          size_t shardCount=DefaultShardCount,
+                          EvictionPolicy policy=EvictionPolicy::LRU,
+                          const std::shared_ptr<const ValueSizer>& sizer=nullptr)
+    : policy(policy),
+      sizer(sizer),
+      maxSize(maxSize),
+      shards(ShardCountFor(maxSize,shardCount)),
+      shardMask(shards.size()-1)
+    {
+      DistributeMaxSize();
+    }
+
+    // disable copy and move
+    ShardedCache(const ShardedCache&) = delete;
+    ShardedCache(ShardedCache&&) = delete;
+    ShardedCache& operator=(const ShardedCache&) = delete;
+    ShardedCache& operator=(ShardedCache&&) = delete;
+
+    ~ShardedCache()
+    {
+      SetMemoryBudget(nullptr,"");
+    }
+
+    /**
+     * Let the cache draw from the given memory budget (or detach it from the current
+     * budget, if budget is null). The cache is flushed.
+     *
+     * Method is NOT thread-safe, it should be called before the cache is used.
+     *
+     * @param budget
+     *    Budget to charge the memory of the entries to
+     * @param name
+     *    Name of the cache in the budget statistics
+     * @param memorySizer
+     *    Optional sizer, estimating the memory of a value (beside the entry overhead) in bytes
+     */
+    void SetMemoryBudget(const MemoryBudgetRef& budget,
+                         const std::string& name,
+                         const std::shared_ptr<const ValueSizer>& memorySizer=nullptr)
+    {
+      Flush();
+
+      if (this->budget) {
+        this->budget->Unregister(*budgetConsumer);
+        budgetConsumer.reset();
+      }
+
+      this->budget=budget;
+      this->name=name;
+      this->memorySizer=memorySizer;
+
+      if (this->budget) {
+        budgetConsumer=std::make_unique<BudgetConsumer>(*this);
+        this->budget->Register(*budgetConsumer);
+      }
+    }
+
+    /**
+     * Returns the memory budget, the cache draws from
+     */
+    MemoryBudgetRef GetMemoryBudget() const
+    {
+      return budget;
+    }
+
+    /**
+     * Returns if the cache is active (maxSize > 0)
+     */
+    bool IsActive() const
+    {
+      return maxSize>0;
+    }
+
+    /**
+     * Getting the value with the given key from cache.
+     *
+     * If there is no value stored with the given key, false will be
+     * returned and the value will be untouched.
+     *
+     * Method is thread-safe.
+     */
+    bool GetEntry(const K& key,
+                  V& value)
+    {
+      if (!IsActive()) {
+        return false;
+      }
+
+      Shard& shard=GetShard(key);
+      std::scoped_lock<std::mutex> lock(shard.mutex);
+
+      auto iter=shard.map.find(key);
+
+      if (iter==shard.map.end()) {
+        shard.misses++;
+        return false;
+      }
+
+      if (policy==EvictionPolicy::LRU) {
+        shard.order.splice(shard.order.begin(),shard.order,iter->second);
+        iter->second->lastAccess=NextAccess();
+      }
+      else {
+        iter->second->referenced=true;
+      }
+
+      shard.hits++;
+      value=iter->second->value;
+
+      return true;
+    }
+
+    /**
+     * Set or update the cache with the given value for the given key.
+     *
+     * Method is thread-safe.
+     */
+    void SetEntry(const K& key,
+                  const V& value)
+    {
+      if (!IsActive()) {
+        return;
+      }
+
+      size_t valueSize=GetValueSize(value);
+      size_t valueMemory=budget ? GetValueMemory(value) : 0;
+      size_t freed=0;
+      Shard& shard=GetShard(key);
+
+      // Charge before the entry becomes visible, else a concurrent eviction could
+      // release its memory before it was charged. The budget may evict entries of
+      // this cache, so the shard must not be locked
+      if (budget) {
+        budget->Charge(valueMemory);
+      }
+
+      {
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        auto iter=shard.map.find(key);
+
+        if (iter!=shard.map.end()) {
+          shard.order.splice(shard.order.begin(),shard.order,iter->second);
+
+          shard.size-=iter->second->size;
+          shard.memory-=iter->second->memory;
+          freed+=iter->second->memory;
+          iter->second->value=value;
+          iter->second->size=valueSize;
+          iter->second->memory=valueMemory;
+          iter->second->lastAccess=NextAccess();
+          shard.size+=valueSize;
+          shard.memory+=valueMemory;
+        }
+        else {
+          shard.order.push_front(Entry{key,value,valueSize,false,valueMemory,NextAccess()});
+          shard.map[key]=shard.order.begin();
+          shard.size+=valueSize;
+          shard.memory+=valueMemory;
+        }
+
+        freed+=StripShard(shard);
+      }
+
+      if (budget) {
+        budget->Release(freed);
+      }
+    }
+
+    /**
+     * Set a new cache max size, possible striping entries
+     * from cache if the new size is smaller than the old one.
+     *
+     * Number of shards is not changed. Method is thread-safe,
+     * but should not be called concurrently with itself.
+     */
+    void SetMaxSize(size_t maxSize)
+    {
+      this->maxSize=maxSize;
+
+      DistributeMaxSize();
+    }
+
+    /**
+     * Returns the maximum size of the cache
+     */
+    size_t GetMaxSize() const
+    {
+      return maxSize;
+    }
+
+    /**
+     * Returns number of shards
+     */
+    size_t GetShardCount() const
+    {
+      return shards.size();
+    }
+
+    /**
+     * Completely flush the cache removing all entries from it.
+     *
+     * Method is thread-safe.
+     */
+    void Flush()
+    {
+      size_t freed=0;
+
+      for (auto& shard : shards) {
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        shard.order.clear();
+        shard.map.clear();
+        shard.size=0;
+        freed+=shard.memory;
+        shard.memory=0;
+      }
+
+      if (budget) {
+        budget->Release(freed);
+      }
+    }
+
+    /**
+     * Returns the current size of the cache.
+     *
+     * Method is thread-safe.
+     */
+    size_t GetSize() const
+    {
+      size_t size=0;
+
+      for (const auto& shard : shards) {
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        size+=shard.size;
+      }
+
+      return size;
+    }
+
+    /**
+     * Returns statistics, summed over all shards.
+     *
+     * Method is thread-safe.
+     */
+    Statistics GetStatistics() const
+    {
+      Statistics statistics;
+
+      for (const auto& shard : shards) {
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        statistics.entries+=shard.map.size();
+        statistics.size+=shard.size;
+        statistics.hits+=shard.hits;
+        statistics.misses+=shard.misses;
+        statistics.memory+=shard.memory;
+        statistics.evictions+=shard.evictions;
+      }
+
+      return statistics;
+    }
+
+    /**
+      Dump some cache statistics to the debug log.
+      */
+    void DumpStatistics(const char* cacheName) const
+    {
+      Statistics statistics=GetStatistics();
+
+      log.Debug() << cacheName << " entries: " << statistics.entries << ", size " << statistics.size
+                  << ", hits " << statistics.hits << ", misses " << statistics.misses;
+    }
+  };
+}
+
+#endif
@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <array>
 #include <vector>
 
 #include <osmscout/lib/CoreImportExport.h>
@@ -67,8 +68,41 @@ namespace osmscout {
     TransPoint* points=nullptr;
 
   private:
+    static constexpr size_t transformChunkSize=64;
+
     void Reserve(size_t size);
 
+    static const GeoCoord& GetGeoCoord(const GeoCoord& coord)
+    {
+      return coord;
+    }
+
+    static const GeoCoord& GetGeoCoord(const Point& point)
+    {
+      return point.GetCoord();
+    }
+
+    void TransformChunk(const Projection& projection,
+                        const std::array<double,transformChunkSize>& lat,
+                        const std::array<double,transformChunkSize>& lon,
+                        std::array<double,transformChunkSize>& x,
+                        std::array<double,transformChunkSize>& y,
+                        size_t offset,
+                        size_t count)
+    {
+      projection.GeoToPixel(lat.data(),
+                            lon.data(),
+                            x.data(),
+                            y.data(),
+                            count);
+
+      for (size_t j=0; j<count; j++) {
+        points[offset+j].x=x[j];
+        points[offset+j].y=y[j];
+        points[offset+j].draw=true;
+      }
+    }
+
   public:
     TransBuffer() = default;
     ~TransBuffer();
@@ -124,7 +158,8 @@ namespace osmscout {
      * Transform the given source array of GeoCoords to DisplayPoints in the buffer
      *
      * @tparam C
-     *    a container object like list, vector or array
+     *    a container object like list, vector or array, or a view like CoordArrayView
+     *    (anything providing empty(), size() and forward iteration over GeoCoord or Point)
      * @param projection
      *    The projection to use for transformation from geo coordinates to display coordinates
      * @param nodes
@@ -134,8 +169,6 @@ namespace osmscout {
     void  TransformGeoToPixel(const Projection& projection,
                               const C& nodes)
     {
-      Projection::BatchTransformer batchTransformer(projection);
-
       if (!nodes.empty()) {
         Reserve(nodes.size());
 
@@ -143,11 +176,32 @@ namespace osmscout {
         length=nodes.size();
         end=length-1;
 
-        for (size_t i=start; i<=end; i++) {
-          batchTransformer.GeoToPixel(nodes[i],
-                                      points[i].x,
-                                      points[i].y);
-          points[i].draw=true;
+        // Coordinates are transformed in chunks, so that the projection
+        // can use vector instructions
+        std::array<double,transformChunkSize> lat;
+        std::array<double,transformChunkSize> lon;
+        std::array<double,transformChunkSize> x;
+        std::array<double,transformChunkSize> y;
+
+        size_t i=start;
+        size_t n=0;
+
+        for (const auto& node : nodes) {
+          const GeoCoord& coord=GetGeoCoord(node);
+
+          lat[n]=coord.GetLat();
+          lon[n]=coord.GetLon();
+          n++;
+
+          if (n==transformChunkSize) {
+            TransformChunk(projection,lat,lon,x,y,i,n);
+            i+=n;
+            n=0;
+          }
+        }
+
+        if (n>0) {
+          TransformChunk(projection,lat,lon,x,y,i,n);
         }
       }
     }
@@ -351,6 +405,23 @@ namespace osmscout {
 
     void Reset();
 
+    /**
+     * Return the number of coordinates in the buffer
+     */
+    size_t GetSize() const
+    {
+      return usedPoints;
+    }
+
+    /**
+     * Append all coordinates of the other buffer to this buffer.
+     *
+     * @param other
+     *    the buffer to copy the coordinates from
+     * @return position (index) of the first copied coordinate in this buffer
+     */
+    size_t Append(const CoordBuffer& other);
+
     /**
      * Push coordinate to the buffer.
      *
@@ -170,6 +170,23 @@ namespace osmscout {
    *
    * @throws IOException
    */
+  /**
+   * Return an estimate of the memory used by the area (including all rings) in bytes
+   */
+  size_t Area::GetMemorySize() const
+  {
+    size_t memory=sizeof(Area)+
+                  rings.capacity()*sizeof(Ring);
+
+    for (const auto& ring : rings) {
+      memory+=ring.GetFeatureValueBuffer().GetMemorySize()+
+              ring.nodes.capacity()*sizeof(Point)+
+              ring.segments.capacity()*sizeof(SegmentGeoBox);
+    }
+
+    return memory;
+  }
+
   void Area::Read(const TypeConfig& typeConfig,
                   FileScanner& scanner)
   {
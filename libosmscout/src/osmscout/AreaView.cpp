@@ -0,0 +1,109 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/AreaView.h>
+
+namespace osmscout {
+
+  GeoBox AreaView::GetBoundingBox() const
+  {
+    GeoBox boundingBox;
+
+    for (const auto& ring : rings) {
+      if (ring.IsTopOuter()) {
+        boundingBox.Include(ring.bbox);
+      }
+    }
+
+    return boundingBox;
+  }
+
+  /**
+   * Read the area from the given memory mapped FileScanner (same format as Area::Read).
+   *
+   * @throws IOException
+   */
+  void AreaView::Read(const TypeConfig& typeConfig,
+                      FileScanner& scanner)
+  {
+    TypeId   ringType;
+    bool     multipleRings;
+    bool     hasMaster;
+    bool     hasCenter;
+    uint32_t ringCount=1;
+
+    fileOffset=scanner.GetPos();
+    mapping=scanner.GetMapping();
+
+    ringType=scanner.ReadTypeId(typeConfig.GetAreaTypeIdBytes());
+
+    TypeInfoRef type=typeConfig.GetAreaTypeInfo(ringType);
+
+    rings.clear();
+
+    Ring& master=rings.emplace_back();
+
+    master.featureValueBuffer.SetType(type);
+    master.featureValueBuffer.Read(scanner,
+                                   multipleRings,
+                                   hasMaster,
+                                   hasCenter);
+
+    if (multipleRings) {
+      ringCount=scanner.ReadUInt32Number();
+
+      ringCount++;
+    }
+
+    rings.reserve(ringCount);
+
+    rings[0].ring=hasMaster ? Area::masterRingId : Area::outerRingId;
+
+    if (hasCenter) {
+      rings[0].center=scanner.ReadCoord();
+    }
+
+    rings[0].nodes=scanner.ReadCoordArrayView(rings[0].GetType()->CanRoute());
+    rings[0].bbox=rings[0].nodes.GetBoundingBox();
+
+    for (size_t i=1; i<ringCount; i++) {
+      Ring& ring=rings.emplace_back();
+
+      ringType=scanner.ReadTypeId(typeConfig.GetAreaTypeIdBytes());
+      type=typeConfig.GetAreaTypeInfo(ringType);
+
+      ring.featureValueBuffer.SetType(type);
+
+      if (ring.GetType()->GetAreaId()!=typeIgnore) {
+        ring.featureValueBuffer.Read(scanner,
+                                     hasCenter);
+        if (hasCenter) {
+          ring.center=scanner.ReadCoord();
+        }
+      }
+
+      ring.ring=scanner.ReadUInt8();
+      ring.nodes=scanner.ReadCoordArrayView(ring.GetType()->GetAreaId()!=typeIgnore &&
+                                            ring.GetType()->CanRoute());
+      ring.bbox=ring.nodes.GetBoundingBox();
+    }
+
+    nextFileOffset=scanner.GetPos();
+  }
+}
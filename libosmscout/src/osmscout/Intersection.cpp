@@ -29,6 +29,15 @@ namespace osmscout {
     // no code
   }
 
+  /**
+   * Return an estimate of the memory used by the intersection in bytes
+   */
+  size_t Intersection::GetMemorySize() const
+  {
+    return sizeof(Intersection)+
+           objects.capacity()*sizeof(ObjectFileRef);
+  }
+
   bool Intersection::Read(FileScanner& scanner)
   {
     try {
@@ -31,6 +31,14 @@ namespace osmscout {
     this->coords=coords;
   }
 
+  /**
+   * Return an estimate of the memory used by the node in bytes
+   */
+  size_t Node::GetMemorySize() const
+  {
+    return sizeof(Node)+featureValueBuffer.GetMemorySize();
+  }
+
   void Node::SetFeatures(const FeatureValueBuffer& buffer)
   {
     featureValueBuffer.Set(buffer);
@@ -33,6 +33,23 @@ namespace osmscout {
     return offsets;
   }
 
+  /**
+   * Return an estimate of the memory used by the route in bytes.
+   * Resolved members are not included, they are shared with other users.
+   */
+  size_t Route::GetMemorySize() const
+  {
+    size_t memory=sizeof(Route)+
+                  featureValueBuffer.GetMemorySize()+
+                  segments.capacity()*sizeof(Segment);
+
+    for (const auto& segment : segments) {
+      memory+=segment.members.capacity()*sizeof(SegmentMember);
+    }
+
+    return memory;
+  }
+
   void Route::Read(const TypeConfig& typeConfig,
                    FileScanner& scanner)
   {
@@ -582,6 +582,25 @@
     Write<3>(writer, std::array<bool,3>{specialFlag1, specialFlag2, specialFlag3});
   }
 
+  /**
+   * Return an estimate of the heap memory allocated by the buffer in bytes.
+   * Memory allocated by the individual feature values (like strings) is not included.
+   */
+  size_t FeatureValueBuffer::GetMemorySize() const
+  {
+    size_t memory=0;
+
+    if (featureBits!=nullptr) {
+      memory+=type->GetFeatureMaskBytes();
+    }
+
+    if (featureValueBuffer!=nullptr) {
+      memory+=type->GetFeatureValueBufferSize();
+    }
+
+    return memory;
+  }
+
   bool FeatureValueBuffer::operator==(const FeatureValueBuffer& other) const
   {
     if (this->type!=other.type) {
@@ -1251,8 +1270,9 @@
 
       uint32_t fileFormatVersion=scanner.ReadUInt32();
 
-      if (fileFormatVersion!=FILE_FORMAT_VERSION) {
-        log.Error() << "File '" << scanner.GetFilename() << "' does not have the expected format version! Actual " << fileFormatVersion << ", expected: " << FILE_FORMAT_VERSION;
+      if (fileFormatVersion<MIN_FORMAT_VERSION ||
+          fileFormatVersion>MAX_FORMAT_VERSION) {
+        log.Error() << "File '" << scanner.GetFilename() << "' does not have the expected format version! Actual " << fileFormatVersion << ", expected: " << MIN_FORMAT_VERSION << "-" << MAX_FORMAT_VERSION;
         return false;
       }
 
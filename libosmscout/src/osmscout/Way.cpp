@@ -71,6 +71,17 @@ namespace osmscout {
    *
    * @throws IOException
    */
+  /**
+   * Return an estimate of the memory used by the way in bytes
+   */
+  size_t Way::GetMemorySize() const
+  {
+    return sizeof(Way)+
+           featureValueBuffer.GetMemorySize()+
+           nodes.capacity()*sizeof(Point)+
+           segments.capacity()*sizeof(SegmentGeoBox);
+  }
+
   void Way::Read(const TypeConfig& typeConfig,
                  FileScanner& scanner)
   {
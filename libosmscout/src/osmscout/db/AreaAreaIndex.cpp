@@ -62,25 +62,20 @@ namespace osmscout {
                                    FileOffset &dataOffset) const
   {
     if (level<maxLevel) {
-      std::scoped_lock<std::mutex> guard(lookupMutex);
-      IndexCache::CacheRef        cacheRef;
-
 #if defined(ANALYZE_CACHE)
       if (indexCache.GetSize()==indexCache.GetMaxSize()) {
         log.Warn() << "areaarea.index cache of " << indexCache.GetSize() << "/" << indexCache.GetMaxSize()
                    << " is too small";
-        indexCache.DumpStatistics("areaarea.idx",IndexCacheValueSizer());
+        indexCache.DumpStatistics(AREA_AREA_IDX);
       }
 #endif
 
-      if (!indexCache.GetEntry(offset,cacheRef)) {
-        IndexCache::CacheEntry cacheEntry(offset);
-
-        cacheRef=indexCache.SetEntry(cacheEntry);
+      if (!indexCache.GetEntry(offset,indexCell)) {
+        std::scoped_lock<std::mutex> guard(lookupMutex);
 
         scanner.SetPos(offset);
 
-        for (FileOffset& c : cacheRef->value.children) {
+        for (FileOffset& c : indexCell.children) {
           FileOffset childOffset;
 
           childOffset=scanner.ReadUInt64Number();
@@ -93,12 +88,10 @@ namespace osmscout {
           }
         }
 
-        cacheRef->value.data=scanner.GetPos();
+        indexCell.data=scanner.GetPos();
 
-        indexCell=cacheRef->value;
-      }
-      else {
-        indexCell=cacheRef->value;
+        indexCache.SetEntry(offset,
+                            indexCell);
       }
     }
     else {
@@ -355,15 +348,23 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Let the index cell cache draw from the given memory budget (in addition to the
+   * entry count limit of the cache size). The cache is flushed.
+   */
+  void AreaAreaIndex::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    indexCache.SetMemoryBudget(budget,
+                               AREA_AREA_IDX);
+  }
+
   void AreaAreaIndex::DumpStatistics()
   {
-    std::scoped_lock<std::mutex> guard(lookupMutex);
-    indexCache.DumpStatistics(AREA_AREA_IDX,IndexCacheValueSizer());
+    indexCache.DumpStatistics(AREA_AREA_IDX);
   }
 
   void AreaAreaIndex::FlushCache()
   {
-    std::scoped_lock<std::mutex> guard(lookupMutex);
     indexCache.Flush();
   }
 }
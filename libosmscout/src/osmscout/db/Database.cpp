@@ -20,6 +20,7 @@
 #include <osmscout/db/Database.h>
 
 #include <algorithm>
+#include <future>
 
 #include <osmscout/system/Assert.h>
 #include <osmscout/system/Math.h>
@@ -55,6 +56,25 @@ namespace osmscout {
     this->routeDataCacheSize=size;
   }
 
+  /**
+   * Let all caches of the database (and of services using the database) draw
+   * from the given byte based memory budget. The entry count limits of the
+   * individual caches still apply. The budget may be shared by multiple databases.
+   */
+  void DatabaseParameter::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    this->memoryBudget=budget;
+  }
+
+  /**
+   * Let the database use the resources of the given registry (shared type config,
+   * memory budget and file descriptor pool), shared with other databases.
+   */
+  void DatabaseParameter::SetRegistry(const DatabaseRegistryRef& registry)
+  {
+    this->registry=registry;
+  }
+
   void DatabaseParameter::SetRouterDataMMap(bool mmap)
   {
     routerDataMMap=mmap;
@@ -115,6 +135,16 @@ namespace osmscout {
     return areaDataCacheSize;
   }
 
+  MemoryBudgetRef DatabaseParameter::GetMemoryBudget() const
+  {
+    return memoryBudget;
+  }
+
+  DatabaseRegistryRef DatabaseParameter::GetRegistry() const
+  {
+    return registry;
+  }
+
   bool DatabaseParameter::GetRouterDataMMap() const
   {
     return routerDataMMap;
@@ -150,6 +180,109 @@ namespace osmscout {
     return indexMMap;
   }
 
+  void PreloadOptions::SetNodes(bool nodes)
+  {
+    this->nodes=nodes;
+  }
+
+  void PreloadOptions::SetWays(bool ways)
+  {
+    this->ways=ways;
+  }
+
+  void PreloadOptions::SetAreas(bool areas)
+  {
+    this->areas=areas;
+  }
+
+  void PreloadOptions::SetRoutes(bool routes)
+  {
+    this->routes=routes;
+  }
+
+  void PreloadOptions::SetLock(bool lock)
+  {
+    this->lock=lock;
+  }
+
+  void PreloadOptions::SetParallel(bool parallel)
+  {
+    this->parallel=parallel;
+  }
+
+  bool PreloadOptions::GetNodes() const
+  {
+    return nodes;
+  }
+
+  bool PreloadOptions::GetWays() const
+  {
+    return ways;
+  }
+
+  bool PreloadOptions::GetAreas() const
+  {
+    return areas;
+  }
+
+  bool PreloadOptions::GetRoutes() const
+  {
+    return routes;
+  }
+
+  bool PreloadOptions::GetLock() const
+  {
+    return lock;
+  }
+
+  bool PreloadOptions::GetParallel() const
+  {
+    return parallel;
+  }
+
+  /**
+   * Lock the file ranges of the given objects into memory. Ranges of
+   * adjacent objects are merged to reduce the number of system calls.
+   */
+  template<typename DataFile, typename ValueType>
+  static bool LockObjects(const DataFile& dataFile,
+                          const std::vector<ValueType>& objects)
+  {
+    std::vector<std::pair<FileOffset,FileOffset>> ranges;
+
+    ranges.reserve(objects.size());
+
+    for (const auto& object : objects) {
+      ranges.emplace_back(object->GetFileOffset(),
+                          object->GetNextFileOffset());
+    }
+
+    std::sort(ranges.begin(),ranges.end());
+
+    size_t merged=0;
+
+    for (size_t i=1; i<ranges.size(); i++) {
+      if (ranges[i].first<=ranges[merged].second) {
+        ranges[merged].second=std::max(ranges[merged].second,ranges[i].second);
+      }
+      else {
+        ranges[++merged]=ranges[i];
+      }
+    }
+
+    if (!ranges.empty()) {
+      ranges.resize(merged+1);
+    }
+
+    for (const auto& [start,end] : ranges) {
+      if (!dataFile.Lock(start,end-start)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   NodeRegionSearchResultEntry::NodeRegionSearchResultEntry(const NodeRef &node,
                                                            const Distance &distance)
   : node(node),
@@ -207,9 +340,18 @@ namespace osmscout {
 
     this->path=path;
 
-    typeConfig=std::make_shared<TypeConfig>();
+    if (parameter.GetRegistry()) {
+      typeConfig=parameter.GetRegistry()->LoadTypeConfig(path);
+    }
+    else {
+      typeConfig=std::make_shared<TypeConfig>();
 
-    if (!typeConfig->LoadFromDataFile(path)) {
+      if (!typeConfig->LoadFromDataFile(path)) {
+        typeConfig=nullptr;
+      }
+    }
+
+    if (!typeConfig) {
       log.Error() << "Cannot load 'types.dat'!";
       return false;
     }
@@ -246,6 +388,12 @@ namespace osmscout {
       wayDataFile=nullptr;
     }
 
+    if (routeDataFile &&
+        routeDataFile->IsOpen()) {
+      routeDataFile->Close();
+      routeDataFile=nullptr;
+    }
+
     if (areaNodeIndex) {
       areaNodeIndex->Close();
       areaNodeIndex=nullptr;
@@ -288,6 +436,36 @@ namespace osmscout {
     return path;
   }
 
+  /**
+   * Return the memory budget the caches of the database draw from: the budget of
+   * the database parameter or else the budget of the registry (if any).
+   */
+  MemoryBudgetRef Database::GetMemoryBudget() const
+  {
+    if (parameter.GetMemoryBudget()) {
+      return parameter.GetMemoryBudget();
+    }
+
+    if (parameter.GetRegistry()) {
+      return parameter.GetRegistry()->GetMemoryBudget();
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Return the pool bounding the number of files opened by the data files
+   * of the database (if any).
+   */
+  FileDescriptorPoolRef Database::GetFileDescriptorPool() const
+  {
+    if (parameter.GetRegistry()) {
+      return parameter.GetRegistry()->GetFileDescriptorPool();
+    }
+
+    return nullptr;
+  }
+
   TypeConfigRef Database::GetTypeConfig() const
   {
     return typeConfig;
@@ -331,6 +509,8 @@ namespace osmscout {
 
     if (!nodeDataFile) {
       nodeDataFile=std::make_shared<NodeDataFile>(parameter.GetNodeDataCacheSize());
+      nodeDataFile->SetMemoryBudget(GetMemoryBudget());
+      nodeDataFile->SetFileDescriptorPool(GetFileDescriptorPool());
     }
 
     if (!nodeDataFile->IsOpen()) {
@@ -361,6 +541,8 @@ namespace osmscout {
 
     if (!areaDataFile) {
       areaDataFile=std::make_shared<AreaDataFile>(parameter.GetAreaDataCacheSize());
+      areaDataFile->SetMemoryBudget(GetMemoryBudget());
+      areaDataFile->SetFileDescriptorPool(GetFileDescriptorPool());
     }
 
     if (!areaDataFile->IsOpen()) {
@@ -391,6 +573,8 @@ namespace osmscout {
 
     if (!wayDataFile) {
       wayDataFile=std::make_shared<WayDataFile>(parameter.GetWayDataCacheSize());
+      wayDataFile->SetMemoryBudget(GetMemoryBudget());
+      wayDataFile->SetFileDescriptorPool(GetFileDescriptorPool());
     }
 
     if (!wayDataFile->IsOpen()) {
@@ -421,6 +605,8 @@ namespace osmscout {
 
     if (!routeDataFile) {
       routeDataFile=std::make_shared<RouteDataFile>(parameter.GetRouteDataCacheSize());
+      routeDataFile->SetMemoryBudget(GetMemoryBudget());
+      routeDataFile->SetFileDescriptorPool(GetFileDescriptorPool());
     }
 
     if (!routeDataFile->IsOpen()) {
@@ -479,6 +665,7 @@ namespace osmscout {
 
     if (!areaAreaIndex) {
       areaAreaIndex=std::make_shared<AreaAreaIndex>(parameter.GetAreaAreaIndexCacheSize());
+      areaAreaIndex->SetMemoryBudget(GetMemoryBudget());
 
       StopClock timer;
 
@@ -892,6 +1079,24 @@ namespace osmscout {
                                          areas);
   }
 
+  /**
+   * Load read-only views of the areas in the given spans. Areas
+   * data file has to be memory mapped.
+   */
+  bool Database::GetAreaViewsByBlockSpans(const std::vector<DataBlockSpan>& spans,
+                                          std::vector<AreaView>& areas) const
+  {
+    AreaDataFileRef areaDataFile=GetAreaDataFile();
+
+    if (!areaDataFile) {
+      return false;
+    }
+
+    return areaDataFile->GetViewsByBlockSpans<AreaView>(spans.begin(),
+                                                        spans.end(),
+                                                        areas);
+  }
+
   bool Database::GetWayByOffset(const FileOffset& offset,
                                 WayRef& way) const
   {
@@ -912,8 +1117,291 @@ namespace osmscout {
     return result;
   }
 
+  /**
+   * Load read-only views of the ways in the given spans. Ways
+   * data file has to be memory mapped.
+   */
+  bool Database::GetWayViewsByBlockSpans(const std::vector<DataBlockSpan>& spans,
+                                         std::vector<WayView>& ways) const
+  {
+    WayDataFileRef wayDataFile=GetWayDataFile();
+
+    if (!wayDataFile) {
+      return false;
+    }
+
+    return wayDataFile->GetViewsByBlockSpans<WayView>(spans.begin(),
+                                                      spans.end(),
+                                                      ways);
+  }
+
+  bool Database::PreloadNodes(const GeoBox& boundingBox,
+                              bool lock) const
+  {
+    AreaNodeIndexRef areaNodeIndex=GetAreaNodeIndex();
+    NodeDataFileRef  nodeDataFile=GetNodeDataFile();
+
+    if (!areaNodeIndex ||
+        !nodeDataFile) {
+      return false;
+    }
+
+    std::vector<FileOffset> offsets;
+    TypeInfoSet             loadedTypes;
+    std::vector<NodeRef>    nodes;
+
+    if (!areaNodeIndex->GetOffsets(boundingBox,
+                                   TypeInfoSet(typeConfig->GetNodeTypes()),
+                                   offsets,
+                                   loadedTypes)) {
+      log.Error() << "Error while reading offsets from " << areaNodeIndex->GetFilename();
+      return false;
+    }
+
+    if (!nodeDataFile->GetByOffset(offsets.begin(),
+                                   offsets.end(),
+                                   offsets.size(),
+                                   nodes)) {
+      log.Error() << "Error while reading nodes from " << nodeDataFile->GetFilename();
+      return false;
+    }
+
+    return !lock || LockObjects(*nodeDataFile,nodes);
+  }
+
+  bool Database::PreloadWays(const GeoBox& boundingBox,
+                             bool lock) const
+  {
+    AreaWayIndexRef areaWayIndex=GetAreaWayIndex();
+    WayDataFileRef  wayDataFile=GetWayDataFile();
+
+    if (!areaWayIndex ||
+        !wayDataFile) {
+      return false;
+    }
+
+    std::vector<FileOffset> offsets;
+    TypeInfoSet             loadedTypes;
+    std::vector<WayRef>     ways;
+
+    if (!areaWayIndex->GetOffsets(boundingBox,
+                                  TypeInfoSet(typeConfig->GetWayTypes()),
+                                  offsets,
+                                  loadedTypes)) {
+      log.Error() << "Error while reading offsets from " << areaWayIndex->GetFilename();
+      return false;
+    }
+
+    if (!wayDataFile->GetByOffset(offsets.begin(),
+                                  offsets.end(),
+                                  offsets.size(),
+                                  ways)) {
+      log.Error() << "Error while reading ways from " << wayDataFile->GetFilename();
+      return false;
+    }
+
+    return !lock || LockObjects(*wayDataFile,ways);
+  }
+
+  bool Database::PreloadAreas(const GeoBox& boundingBox,
+                              bool lock) const
+  {
+    AreaAreaIndexRef areaAreaIndex=GetAreaAreaIndex();
+    AreaDataFileRef  areaDataFile=GetAreaDataFile();
+
+    if (!areaAreaIndex ||
+        !areaDataFile) {
+      return false;
+    }
+
+    std::vector<DataBlockSpan> spans;
+    TypeInfoSet                loadedTypes;
+    std::vector<AreaRef>       areas;
+
+    if (!areaAreaIndex->GetAreasInArea(*typeConfig,
+                                       boundingBox,
+                                       std::numeric_limits<size_t>::max(),
+                                       TypeInfoSet(typeConfig->GetAreaTypes()),
+                                       spans,
+                                       loadedTypes)) {
+      log.Error() << "Error while reading offsets from " << areaAreaIndex->GetFilename();
+      return false;
+    }
+
+    if (!areaDataFile->GetByBlockSpans(spans.begin(),
+                                       spans.end(),
+                                       areas)) {
+      log.Error() << "Error while reading areas from " << areaDataFile->GetFilename();
+      return false;
+    }
+
+    return !lock || LockObjects(*areaDataFile,areas);
+  }
+
+  bool Database::PreloadRoutes(const GeoBox& boundingBox,
+                               bool lock) const
+  {
+    AreaRouteIndexRef areaRouteIndex=GetAreaRouteIndex();
+    RouteDataFileRef  routeDataFile=GetRouteDataFile();
+
+    if (!areaRouteIndex ||
+        !routeDataFile) {
+      return false;
+    }
+
+    std::vector<FileOffset> offsets;
+    TypeInfoSet             loadedTypes;
+    std::vector<RouteRef>   routes;
+
+    if (!areaRouteIndex->GetOffsets(boundingBox,
+                                    TypeInfoSet(typeConfig->GetRouteTypes()),
+                                    offsets,
+                                    loadedTypes)) {
+      log.Error() << "Error while reading offsets from " << areaRouteIndex->GetFilename();
+      return false;
+    }
+
+    if (!routeDataFile->GetByOffset(offsets.begin(),
+                                    offsets.end(),
+                                    offsets.size(),
+                                    routes)) {
+      log.Error() << "Error while reading routes from " << routeDataFile->GetFilename();
+      return false;
+    }
+
+    return !lock || LockObjects(*routeDataFile,routes);
+  }
+
+  /**
+   * Preload the index cells and data of the given region, so that following
+   * requests for the region do not suffer from lazily faulting in the files
+   * (and find the objects in the data file caches).
+   *
+   * The objects of the region are resolved through the area indexes and loaded
+   * from the data files, which makes the touched index and data pages resident.
+   * If locking is requested, the file ranges of the loaded objects are additionally
+   * locked into memory (requires memory mapped data files and a sufficient
+   * locked memory limit) until the database is closed.
+   *
+   * The method blocks until preloading is finished. Since the Database is
+   * thread-safe, it can be called from a background thread to not block
+   * the caller.
+   *
+   * @param boundingBox
+   *    Region to preload
+   * @param options
+   *    Which data to preload and how
+   * @return false, if any of the requested data could not be preloaded
+   */
+  bool Database::Preload(const GeoBox& boundingBox,
+                         const PreloadOptions& options) const
+  {
+    if (!IsOpen()) {
+      return false;
+    }
+
+    StopClock                      timer;
+    std::vector<std::future<bool>> jobs;
+    bool                           result=true;
+
+    auto run=[&jobs,&result,&options](auto&& job) {
+      if (options.GetParallel()) {
+        jobs.push_back(std::async(std::launch::async,job));
+      }
+      else {
+        result=job() && result;
+      }
+    };
+
+    bool lock=options.GetLock();
+
+    if (options.GetNodes()) {
+      run([this,&boundingBox,lock]() {return PreloadNodes(boundingBox,lock);});
+    }
+
+    if (options.GetWays()) {
+      run([this,&boundingBox,lock]() {return PreloadWays(boundingBox,lock);});
+    }
+
+    if (options.GetAreas()) {
+      run([this,&boundingBox,lock]() {return PreloadAreas(boundingBox,lock);});
+    }
+
+    if (options.GetRoutes()) {
+      run([this,&boundingBox,lock]() {return PreloadRoutes(boundingBox,lock);});
+    }
+
+    for (auto& job : jobs) {
+      result=job.get() && result;
+    }
+
+    timer.Stop();
+
+    log.Debug() << "Preloading " << boundingBox.GetDisplayText() << ": " << timer.ResultString();
+
+    return result;
+  }
+
+  /**
+   * Return the number of bytes resident in memory (the page cache of the operating system)
+   * for each existing file of the database. Files, that cannot be checked (or all files,
+   * if the platform does not support checking residency), are missing in the report.
+   */
+  DatabaseResidencyReport Database::GetResidencyReport() const
+  {
+    static const std::vector<std::string> filenames={
+      BoundingBoxDataFile::BOUNDINGBOX_DAT,
+      NodeDataFile::NODES_DAT,
+      WayDataFile::WAYS_DAT,
+      AreaDataFile::AREAS_DAT,
+      RouteDataFile::ROUTE_DAT,
+      AreaNodeIndex::AREA_NODE_IDX,
+      AreaWayIndex::AREA_WAY_IDX,
+      AreaAreaIndex::AREA_AREA_IDX,
+      AreaRouteIndex::AREA_ROUTE_IDX,
+      OptimizeAreasLowZoom::FILE_AREASOPT_DAT,
+      OptimizeWaysLowZoom::FILE_WAYSOPT_DAT,
+      LocationIndex::FILENAME_LOCATION_IDX,
+      WaterIndex::WATER_IDX
+    };
+
+    DatabaseResidencyReport report;
+
+    if (!IsOpen()) {
+      return report;
+    }
+
+    for (const auto& filename : filenames) {
+      std::string fullFilename=AppendFileToDir(path,filename);
+
+      if (!ExistsInFilesystem(fullFilename)) {
+        continue;
+      }
+
+      try {
+        FileResidency residency;
+
+        residency.filename=filename;
+        residency.size=GetFileSize(fullFilename);
+        residency.residentSize=GetFileResidentSize(fullFilename);
+
+        report.push_back(residency);
+      }
+      catch (const IOException& e) {
+        log.Warn() << e.GetDescription();
+      }
+    }
+
+    return report;
+  }
+
   void Database::DumpStatistics() const
   {
+    if (MemoryBudgetRef budget=GetMemoryBudget();
+        budget) {
+      budget->DumpStatistics();
+    }
+
     if (areaAreaIndex) {
       areaAreaIndex->DumpStatistics();
     }
@@ -0,0 +1,131 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/db/DatabaseRegistry.h>
+
+#include <algorithm>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+  /**
+   * Return the process-wide registry instance
+   */
+  DatabaseRegistryRef DatabaseRegistry::GetInstance()
+  {
+    static DatabaseRegistryRef instance=std::make_shared<DatabaseRegistry>();
+
+    return instance;
+  }
+
+  /**
+   * Return the type config of the database in the given directory. If a database
+   * with identical type configuration was loaded before (and is still in use),
+   * the existing type config is returned, else the type config is loaded.
+   *
+   * @return the type config or null, if the type config cannot be loaded
+   */
+  TypeConfigRef DatabaseRegistry::LoadTypeConfig(const std::string& directory)
+  {
+    std::vector<char> content;
+
+    if (!ReadFile(AppendFileToDir(directory,TypeConfig::FILE_TYPES_DAT),
+                  content)) {
+      log.Error() << "Cannot read '" << TypeConfig::FILE_TYPES_DAT << "' in '" << directory << "'";
+      return nullptr;
+    }
+
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    typeConfigs.remove_if([](const TypeConfigEntry& entry) {
+      return entry.typeConfig.expired();
+    });
+
+    for (const auto& entry : typeConfigs) {
+      if (entry.content==content) {
+        if (TypeConfigRef typeConfig=entry.typeConfig.lock();
+            typeConfig) {
+          return typeConfig;
+        }
+      }
+    }
+
+    auto typeConfig=std::make_shared<TypeConfig>();
+
+    if (!typeConfig->LoadFromDataFile(directory)) {
+      return nullptr;
+    }
+
+    typeConfigs.push_back(TypeConfigEntry{std::move(content),
+                                          typeConfig});
+
+    return typeConfig;
+  }
+
+  /**
+   * Return the number of distinct type configs currently in use
+   */
+  size_t DatabaseRegistry::GetTypeConfigCount() const
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    return std::count_if(typeConfigs.begin(),typeConfigs.end(),[](const TypeConfigEntry& entry) {
+      return !entry.typeConfig.expired();
+    });
+  }
+
+  /**
+   * Set the memory budget, all caches of databases opened afterwards draw from,
+   * unless their DatabaseParameter defines a budget of its own.
+   */
+  void DatabaseRegistry::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    memoryBudget=budget;
+  }
+
+  MemoryBudgetRef DatabaseRegistry::GetMemoryBudget() const
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    return memoryBudget;
+  }
+
+  /**
+   * Set the pool bounding the number of files opened by the data files
+   * of databases opened afterwards.
+   */
+  void DatabaseRegistry::SetFileDescriptorPool(const FileDescriptorPoolRef& descriptorPool)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    this->descriptorPool=descriptorPool;
+  }
+
+  FileDescriptorPoolRef DatabaseRegistry::GetFileDescriptorPool() const
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    return descriptorPool;
+  }
+}
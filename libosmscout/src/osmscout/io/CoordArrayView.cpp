@@ -0,0 +1,65 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/io/CoordArrayView.h>
+
+#include <algorithm>
+
+namespace osmscout {
+
+  /**
+   * Calculate the bounding box of all coordinates of the view
+   */
+  GeoBox CoordArrayView::GetBoundingBox() const
+  {
+    if (empty()) {
+      return {};
+    }
+
+    GeoCoord first=front();
+    double   minLat=first.GetLat();
+    double   maxLat=first.GetLat();
+    double   minLon=first.GetLon();
+    double   maxLon=first.GetLon();
+
+    for (const auto& coord : *this) {
+      minLat=std::min(minLat,coord.GetLat());
+      maxLat=std::max(maxLat,coord.GetLat());
+      minLon=std::min(minLon,coord.GetLon());
+      maxLon=std::max(maxLon,coord.GetLon());
+    }
+
+    return {GeoCoord(minLat,minLon),
+            GeoCoord(maxLat,maxLon)};
+  }
+
+  /**
+   * Decode all coordinates into the given vector (without node serials)
+   */
+  void CoordArrayView::CopyTo(std::vector<Point>& nodes) const
+  {
+    nodes.resize(count);
+
+    size_t i=0;
+    for (const auto& coord : *this) {
+      nodes[i].SetCoord(coord);
+      i++;
+    }
+  }
+}
@@ -0,0 +1,306 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/io/CoordEncoding.h>
+
+#include <array>
+
+// The SSSE3 decoder is compiled using a function target attribute and selected at runtime,
+// so it does not require any special compiler flags for the rest of the library
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #define OSMSCOUT_STREAMVBYTE_SSSE3 1
+  #include <tmmintrin.h>
+#endif
+
+namespace osmscout {
+
+  namespace {
+
+    /**
+     * Lookup tables indexed by a control byte (the length codes of four values)
+     */
+    struct StreamVByteTables
+    {
+      std::array<uint8_t,256>                 length;  //!< Number of data bytes of the four values
+      std::array<std::array<uint8_t,16>,256>  shuffle; //!< pshufb mask expanding the data bytes to four 32 bit values
+    };
+
+    constexpr StreamVByteTables BuildStreamVByteTables()
+    {
+      StreamVByteTables tables{};
+
+      for (size_t control=0; control<256; control++) {
+        uint8_t pos=0;
+
+        for (size_t value=0; value<4; value++) {
+          uint8_t length=((control >> (2*value)) & 0x03u)+1;
+
+          for (uint8_t byte=0; byte<4; byte++) {
+            tables.shuffle[control][4*value+byte]=byte<length ? uint8_t(pos+byte) : 0xff;
+          }
+
+          pos+=length;
+        }
+
+        tables.length[control]=pos;
+      }
+
+      return tables;
+    }
+
+    constexpr StreamVByteTables streamVByteTables=BuildStreamVByteTables();
+
+    inline uint8_t StreamVByteCode(const uint8_t* control,
+                                   size_t index)
+    {
+      return (control[index/4] >> (2*(index%4))) & 0x03u;
+    }
+
+    inline uint32_t ZigZagEncode(int32_t value)
+    {
+      return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+    }
+
+    inline int32_t ZigZagDecode(uint32_t value)
+    {
+      return int32_t((value >> 1) ^ (~(value & 1)+1));
+    }
+
+    /**
+     * Decodes the values from the given start index on, one by one
+     */
+    void StreamVByteDecodeCoordsScalar(const uint8_t* control,
+                                       const uint8_t* data,
+                                       size_t start,
+                                       size_t count,
+                                       uint32_t lat,
+                                       uint32_t lon,
+                                       uint32_t* coords)
+    {
+      for (size_t i=start; i<count; i+=2) {
+        uint32_t values[2];
+
+        for (size_t v=0; v<2; v++) {
+          size_t   length=StreamVByteCode(control,i+v)+1;
+          uint32_t value=0;
+
+          for (size_t byte=0; byte<length; byte++) {
+            value|=uint32_t(data[byte]) << (8*byte);
+          }
+
+          values[v]=value;
+          data+=length;
+        }
+
+        lat+=ZigZagDecode(values[0]);
+        lon+=ZigZagDecode(values[1]);
+
+        coords[i]=lat;
+        coords[i+1]=lon;
+      }
+    }
+
+#if defined(OSMSCOUT_STREAMVBYTE_SSSE3)
+    /**
+     * Decodes full groups of four values (two coordinates) as long as 16 bytes
+     * can be loaded from the data without reading beyond dataEnd.
+     *
+     * @return number of decoded groups
+     */
+    __attribute__((target("ssse3")))
+    size_t StreamVByteDecodeCoordsSSSE3(const uint8_t* control,
+                                        const uint8_t*& data,
+                                        const uint8_t* dataEnd,
+                                        size_t groups,
+                                        uint32_t lat,
+                                        uint32_t lon,
+                                        uint32_t* coords)
+    {
+      const __m128i one=_mm_set1_epi32(1);
+      __m128i       previous=_mm_setr_epi32(int32_t(lat),int32_t(lon),int32_t(lat),int32_t(lon));
+      size_t        group=0;
+
+      while (group<groups && data+16<=dataEnd) {
+        uint8_t code=control[group];
+        __m128i values=_mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i mask=_mm_loadu_si128(reinterpret_cast<const __m128i*>(streamVByteTables.shuffle[code].data()));
+
+        values=_mm_shuffle_epi8(values,mask);
+
+        // Zigzag decoding: (v >> 1) ^ -(v & 1)
+        __m128i deltas=_mm_xor_si128(_mm_srli_epi32(values,1),
+                                     _mm_sub_epi32(_mm_setzero_si128(),_mm_and_si128(values,one)));
+
+        // Prefix sum with a stride of two (lat, lon interleaved)
+        deltas=_mm_add_epi32(deltas,_mm_slli_si128(deltas,8));
+        previous=_mm_add_epi32(previous,deltas);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(coords+4*group),previous);
+
+        previous=_mm_shuffle_epi32(previous,_MM_SHUFFLE(3,2,3,2));
+        data+=streamVByteTables.length[code];
+        group++;
+      }
+
+      return group;
+    }
+#endif
+  }
+
+  /**
+   * Returns the number of data bytes following the control bytes
+   * of count stream-vbyte encoded values
+   */
+  size_t StreamVByteDataLength(const uint8_t* control,
+                               size_t count)
+  {
+    size_t length=0;
+    size_t fullGroups=count/4;
+
+    for (size_t group=0; group<fullGroups; group++) {
+      length+=streamVByteTables.length[control[group]];
+    }
+
+    for (size_t i=fullGroups*4; i<count; i++) {
+      length+=StreamVByteCode(control,i)+1;
+    }
+
+    return length;
+  }
+
+  /**
+   * Appends the given (delta) values in stream-vbyte encoding to the buffer:
+   * first the control bytes (2 bits per value, the number of bytes minus one),
+   * then the zigzag encoded values in little endian byte order using
+   * as few bytes as possible.
+   */
+  void StreamVByteEncode(const std::vector<int32_t>& values,
+                         std::vector<uint8_t>& buffer)
+  {
+    size_t controlStart=buffer.size();
+
+    buffer.resize(controlStart+StreamVByteControlLength(values.size()),0);
+
+    for (size_t i=0; i<values.size(); i++) {
+      uint32_t value=ZigZagEncode(values[i]);
+      uint8_t  code;
+
+      if (value<0x100u) {
+        code=0;
+      }
+      else if (value<0x10000u) {
+        code=1;
+      }
+      else if (value<0x1000000u) {
+        code=2;
+      }
+      else {
+        code=3;
+      }
+
+      buffer[controlStart+i/4]|=uint8_t(code << (2*(i%4)));
+
+      for (uint8_t byte=0; byte<=code; byte++) {
+        buffer.push_back(uint8_t(value >> (8*byte)));
+      }
+    }
+  }
+
+  /**
+   * Decodes count (lat, lon interleaved, so count is even) stream-vbyte encoded
+   * coordinate deltas and stores the resulting raw coordinate values.
+   *
+   * If available (and useSimd is true) full groups of four values are decoded
+   * using SSSE3, the remaining values (and all values, where 16 bytes cannot be
+   * loaded without crossing dataEnd) are decoded by the scalar decoder.
+   *
+   * @param control
+   *    control bytes
+   * @param data
+   *    data bytes
+   * @param dataEnd
+   *    end of the readable memory of the data bytes
+   * @param count
+   *    number of encoded values (two per coordinate)
+   * @param lat
+   *    raw latitude value of the coordinate preceding the first delta
+   * @param lon
+   *    raw longitude value of the coordinate preceding the first delta
+   * @param coords
+   *    output buffer for count raw values (lat, lon interleaved)
+   * @param useSimd
+   *    if false, the scalar decoder is used
+   */
+  void StreamVByteDecodeCoords(const uint8_t* control,
+                               const uint8_t* data,
+                               const uint8_t* dataEnd,
+                               size_t count,
+                               uint32_t lat,
+                               uint32_t lon,
+                               uint32_t* coords,
+                               bool useSimd)
+  {
+    size_t start=0;
+
+#if defined(OSMSCOUT_STREAMVBYTE_SSSE3)
+    if (useSimd && HasStreamVByteSimdDecoder()) {
+      size_t groups=StreamVByteDecodeCoordsSSSE3(control,
+                                                 data,
+                                                 dataEnd,
+                                                 count/4,
+                                                 lat,
+                                                 lon,
+                                                 coords);
+
+      start=groups*4;
+
+      if (start>0) {
+        lat=coords[start-2];
+        lon=coords[start-1];
+      }
+    }
+#else
+    (void)dataEnd;
+    (void)useSimd;
+#endif
+
+    StreamVByteDecodeCoordsScalar(control,
+                                  data,
+                                  start,
+                                  count,
+                                  lat,
+                                  lon,
+                                  coords);
+  }
+
+  /**
+   * Returns true, if StreamVByteDecodeCoords() can use a SIMD implementation
+   * on the current CPU
+   */
+  bool HasStreamVByteSimdDecoder()
+  {
+#if defined(OSMSCOUT_STREAMVBYTE_SSSE3)
+    static const bool hasSSSE3=__builtin_cpu_supports("ssse3");
+
+    return hasSSSE3;
+#else
+    return false;
+#endif
+  }
+}
@@ -17,9 +17,21 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <osmscout/private/Config.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
 
 #include <filesystem>
+#include <limits>
+
+#if defined(HAVE_MMAP) && defined(HAVE_MINCORE)
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+#endif
 
 #include <osmscout/io/File.h>
 
@@ -149,4 +161,67 @@ namespace osmscout {
     }
     return true;
   }
+
+  FileOffset GetFileResidentSize(const std::string& filename)
+  {
+#if defined(HAVE_MMAP) && defined(HAVE_MINCORE)
+    FileOffset fileSize=GetFileSize(filename);
+
+    if (fileSize==0) {
+      return 0;
+    }
+
+    if (fileSize>std::numeric_limits<size_t>::max()) {
+      throw IOException(filename,"Cannot check residency of file","File too large to be mapped");
+    }
+
+    int fd=open(filename.c_str(),O_RDONLY);
+
+    if (fd<0) {
+      throw IOException(filename,"Cannot open file",strerror(errno));
+    }
+
+    // Mapping the file does not read it, the mapping just gives us access to the page cache state
+    void* mapping=mmap(nullptr,(size_t)fileSize,PROT_READ,MAP_SHARED,fd,0);
+
+    close(fd);
+
+    if (mapping==MAP_FAILED) {
+      throw IOException(filename,"Cannot map file",strerror(errno));
+    }
+
+    size_t pageSize=(size_t)sysconf(_SC_PAGESIZE);
+    size_t pageCount=((size_t)fileSize+pageSize-1)/pageSize;
+
+    // The type of the vector parameter differs between platforms
+#if defined(__linux__)
+    std::vector<unsigned char> residency(pageCount);
+#else
+    std::vector<char> residency(pageCount);
+#endif
+
+    if (mincore(mapping,(size_t)fileSize,residency.data())!=0) {
+      int error=errno;
+
+      munmap(mapping,(size_t)fileSize);
+
+      throw IOException(filename,"Cannot check residency of file",strerror(error));
+    }
+
+    munmap(mapping,(size_t)fileSize);
+
+    FileOffset residentSize=0;
+
+    for (size_t page=0; page<pageCount; page++) {
+      if ((residency[page] & 0x01)!=0) {
+        residentSize+=pageSize;
+      }
+    }
+
+    // The last page is usually only partially used by the file
+    return std::min(residentSize,fileSize);
+#else
+    throw IOException(filename,"Cannot check residency of file","Not implemented for this platform");
+#endif
+  }
 }
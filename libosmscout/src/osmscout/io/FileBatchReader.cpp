@@ -0,0 +1,963 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/private/Config.h>
+
+#include <osmscout/io/FileBatchReader.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#if defined(HAVE_PREAD)
+  #include <unistd.h>
+  #include <fcntl.h>
+  #include <sys/stat.h>
+#endif
+
+#if defined(HAVE_PREAD) && defined(HAVE_LINUX_IO_URING_H)
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <linux/io_uring.h>
+
+  // IORING_OP_READ was introduced together with IORING_FEAT_RW_CUR_POS (Linux 5.6)
+  #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(IORING_FEAT_RW_CUR_POS)
+    #define OSMSCOUT_HAVE_IO_URING 1
+  #endif
+#endif
+
+#include <osmscout/log/Logger.h>
+#include <osmscout/util/Exception.h>
+#include <osmscout/util/ObjectPool.h>
+
+namespace osmscout {
+
+  /**
+   * Minimal blocking queue for the fallback thread pool and its completions.
+   * It is kept local to the io module, so reading does not depend on osmscout/async.
+   */
+  template<typename T>
+  class BlockingQueue
+  {
+  private:
+    std::mutex              mutex;
+    std::condition_variable condition;
+    std::deque<T>           queue;
+    bool                    stopped=false;
+
+  public:
+    /**
+     * Append the value, returns false if the queue is already stopped.
+     */
+    bool Push(T&& value)
+    {
+      {
+        std::scoped_lock<std::mutex> lock(mutex);
+
+        if (stopped) {
+          return false;
+        }
+
+        queue.push_back(std::move(value));
+      }
+
+      condition.notify_one();
+
+      return true;
+    }
+
+    /**
+     * Wait for the next value, returns an empty optional if the queue is stopped
+     * and empty.
+     */
+    std::optional<T> Pop()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      condition.wait(lock,[this]() {
+        return stopped || !queue.empty();
+      });
+
+      if (queue.empty()) {
+        return std::nullopt;
+      }
+
+      T value=std::move(queue.front());
+
+      queue.pop_front();
+
+      return value;
+    }
+
+    void Stop()
+    {
+      {
+        std::scoped_lock<std::mutex> lock(mutex);
+
+        stopped=true;
+      }
+
+      condition.notify_all();
+    }
+  };
+
+#if defined(OSMSCOUT_HAVE_IO_URING)
+  /**
+   * Minimal io_uring submission/completion ring, using the raw system calls
+   * (so there is no dependency on liburing). Only read operations are supported.
+   *
+   * The ring is not thread-safe, it is used by one thread at a time.
+   */
+  class FileBatchReader::IoUring CLASS_FINAL
+  {
+  private:
+    int           ringFd=-1;
+    unsigned      entries=0;
+    unsigned      pending=0;    //!< Number of queued, not yet submitted entries
+    bool          broken=false; //!< Submission failed, ring state is unknown
+
+    void          *sqRing=MAP_FAILED;
+    size_t        sqRingSize=0;
+    void          *cqRing=MAP_FAILED;
+    size_t        cqRingSize=0;
+    io_uring_sqe  *sqes=(io_uring_sqe*)MAP_FAILED;
+    size_t        sqesSize=0;
+
+    unsigned      *sqHead=nullptr;
+    unsigned      *sqTail=nullptr;
+    unsigned      *sqMask=nullptr;
+    unsigned      *sqArray=nullptr;
+    unsigned      *cqHead=nullptr;
+    unsigned      *cqTail=nullptr;
+    unsigned      *cqMask=nullptr;
+    io_uring_cqe  *cqes=nullptr;
+
+  private:
+    int Enter(unsigned toSubmit,
+              unsigned waitFor)
+    {
+      while (true) {
+        int result=(int)syscall(__NR_io_uring_enter,
+                                ringFd,
+                                toSubmit,
+                                waitFor,
+                                waitFor>0 ? IORING_ENTER_GETEVENTS : 0,
+                                nullptr,
+                                0);
+
+        if (result>=0) {
+          pending-=std::min(pending,(unsigned)result);
+          return 0;
+        }
+
+        if (errno!=EINTR) {
+          broken=broken || (errno!=EAGAIN && errno!=EBUSY);
+          return errno;
+        }
+      }
+    }
+
+  public:
+    IoUring() = default;
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring()
+    {
+      if (sqes!=MAP_FAILED) {
+        munmap(sqes,sqesSize);
+      }
+
+      if (cqRing!=MAP_FAILED && cqRing!=sqRing) {
+        munmap(cqRing,cqRingSize);
+      }
+
+      if (sqRing!=MAP_FAILED) {
+        munmap(sqRing,sqRingSize);
+      }
+
+      if (ringFd>=0) {
+        close(ringFd);
+      }
+    }
+
+    bool Init(unsigned requestedEntries)
+    {
+      io_uring_params params;
+
+      memset(&params,0,sizeof(params));
+
+      ringFd=(int)syscall(__NR_io_uring_setup,requestedEntries,&params);
+
+      if (ringFd<0) {
+        return false;
+      }
+
+      entries=params.sq_entries;
+
+      sqRingSize=params.sq_off.array+params.sq_entries*sizeof(unsigned);
+      cqRingSize=params.cq_off.cqes+params.cq_entries*sizeof(io_uring_cqe);
+
+      bool singleMmap=(params.features & IORING_FEAT_SINGLE_MMAP)!=0;
+
+      if (singleMmap) {
+        sqRingSize=std::max(sqRingSize,cqRingSize);
+        cqRingSize=sqRingSize;
+      }
+
+      sqRing=::mmap(nullptr,sqRingSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd,IORING_OFF_SQ_RING);
+
+      if (sqRing==MAP_FAILED) {
+        return false;
+      }
+
+      if (singleMmap) {
+        cqRing=sqRing;
+      }
+      else {
+        cqRing=::mmap(nullptr,cqRingSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd,IORING_OFF_CQ_RING);
+
+        if (cqRing==MAP_FAILED) {
+          return false;
+        }
+      }
+
+      sqesSize=params.sq_entries*sizeof(io_uring_sqe);
+      sqes=(io_uring_sqe*)::mmap(nullptr,sqesSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd,IORING_OFF_SQES);
+
+      if (sqes==MAP_FAILED) {
+        return false;
+      }
+
+      auto *sq=(char*)sqRing;
+      auto *cq=(char*)cqRing;
+
+      sqHead=(unsigned*)(sq+params.sq_off.head);
+      sqTail=(unsigned*)(sq+params.sq_off.tail);
+      sqMask=(unsigned*)(sq+params.sq_off.ring_mask);
+      sqArray=(unsigned*)(sq+params.sq_off.array);
+      cqHead=(unsigned*)(cq+params.cq_off.head);
+      cqTail=(unsigned*)(cq+params.cq_off.tail);
+      cqMask=(unsigned*)(cq+params.cq_off.ring_mask);
+      cqes=(io_uring_cqe*)(cq+params.cq_off.cqes);
+
+      return true;
+    }
+
+    bool IsBroken() const
+    {
+      return broken;
+    }
+
+    /**
+     * Queue a read request. Returns false, if the submission queue is full.
+     */
+    bool PushRead(int fd,
+                  char* buffer,
+                  unsigned length,
+                  FileOffset offset,
+                  uint64_t userData)
+    {
+      unsigned tail=*sqTail;
+      unsigned head=__atomic_load_n(sqHead,__ATOMIC_ACQUIRE);
+
+      if (tail-head>=entries) {
+        return false;
+      }
+
+      unsigned      index=tail & *sqMask;
+      io_uring_sqe *sqe=&sqes[index];
+
+      memset(sqe,0,sizeof(*sqe));
+      sqe->opcode=IORING_OP_READ;
+      sqe->fd=fd;
+      sqe->addr=(uint64_t)(uintptr_t)buffer;
+      sqe->len=length;
+      sqe->off=offset;
+      sqe->user_data=userData;
+
+      sqArray[index]=index;
+
+      __atomic_store_n(sqTail,tail+1,__ATOMIC_RELEASE);
+
+      pending++;
+
+      return true;
+    }
+
+    /**
+     * Number of queued, not yet submitted requests
+     */
+    unsigned GetPending() const
+    {
+      return pending;
+    }
+
+    /**
+     * Submit all queued requests and wait for at least the given number of completions.
+     * Returns 0 or (positive) errno.
+     */
+    int Submit(unsigned waitFor)
+    {
+      return Enter(pending,
+                   waitFor);
+    }
+
+    /**
+     * Wait for at least the given number of completions without submitting queued
+     * requests. Returns 0 or (positive) errno.
+     */
+    int Wait(unsigned waitFor)
+    {
+      return Enter(0,
+                   waitFor);
+    }
+
+    /**
+     * Process all available completions
+     */
+    template<typename F>
+    unsigned Reap(F&& handler)
+    {
+      unsigned head=*cqHead;
+      unsigned tail=__atomic_load_n(cqTail,__ATOMIC_ACQUIRE);
+      unsigned count=0;
+
+      while (head!=tail) {
+        const io_uring_cqe& cqe=cqes[head & *cqMask];
+
+        handler(cqe.user_data,
+                cqe.res);
+
+        head++;
+        count++;
+      }
+
+      __atomic_store_n(cqHead,head,__ATOMIC_RELEASE);
+
+      return count;
+    }
+  };
+
+  class FileBatchReader::IoUringPool CLASS_FINAL: public ObjectPool<FileBatchReader::IoUring>
+  {
+  private:
+    static constexpr unsigned RingEntries=64;
+
+  public:
+    explicit IoUringPool(size_t maxSize)
+    : ObjectPool<IoUring>(maxSize)
+    {
+      // no code
+    }
+
+    ~IoUringPool() override
+    {
+      Clear(); // we have Destroy method override...
+    }
+
+    IoUring* MakeNew() noexcept override
+    {
+      auto *ring=new IoUring();
+
+      if (!ring->Init(RingEntries)) {
+        delete ring;
+        return nullptr;
+      }
+
+      return ring;
+    }
+
+    void Destroy(IoUring* ring) noexcept override
+    {
+      delete ring;
+    }
+
+    bool IsValid(IoUring* ring) noexcept override
+    {
+      return !ring->IsBroken();
+    }
+  };
+#endif
+
+  /**
+   * The io_uring rings and the threads of the fallback pool, shared by all readers
+   * of the process. The context exists as long as there is an open reader.
+   */
+  class FileBatchReader::Context CLASS_FINAL
+  {
+  public:
+    using Task = std::function<void()>;
+
+  private:
+    std::mutex               threadsMutex; //!< Guards lazy start of the threads
+    std::vector<std::thread> threads;      //!< Threads of the fallback pool
+
+  public:
+    BlockingQueue<Task>      tasks;        //!< Tasks for the fallback pool
+#if defined(OSMSCOUT_HAVE_IO_URING)
+    IoUringPool              ringPool;     //!< One ring per concurrently reading thread
+#endif
+
+  public:
+    Context()
+#if defined(OSMSCOUT_HAVE_IO_URING)
+    : ringPool(std::max(4u,2*std::thread::hardware_concurrency()))
+#endif
+    {
+      // no code
+    }
+
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    ~Context()
+    {
+      tasks.Stop();
+
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    /**
+     * Start threads of the fallback pool, until there are at least the given number
+     */
+    void StartThreads(size_t threadCount)
+    {
+      std::scoped_lock<std::mutex> lock(threadsMutex);
+
+      while (threads.size()<threadCount) {
+        threads.emplace_back([this]() {
+          while (std::optional<Task> task=tasks.Pop()) {
+            (*task)();
+          }
+        });
+      }
+    }
+  };
+
+#if defined(HAVE_PREAD)
+  /**
+   * Read the given number of bytes, return 0 or errno.
+   * The buffer is shrunk, if the end of the file is reached.
+   */
+  static int ReadFully(int fd,
+                       FileBatchReader::Range& range)
+  {
+    size_t filled=0;
+
+    range.data.resize(range.length);
+
+    while (filled<range.length) {
+      ssize_t result=pread(fd,
+                           range.data.data()+filled,
+                           range.length-filled,
+                           (off_t)(range.offset+filled));
+
+      if (result<0) {
+        if (errno==EINTR) {
+          continue;
+        }
+
+        return errno;
+      }
+
+      if (result==0) {
+        break;
+      }
+
+      filled+=(size_t)result;
+    }
+
+    range.data.resize(filled);
+
+    return 0;
+  }
+#endif
+
+#if defined(OSMSCOUT_HAVE_IO_URING)
+  /**
+   * Keep the given buffers until the end of the process. Used for the buffers of
+   * requests still in flight in a failed ring, that cannot be waited for anymore,
+   * since the kernel may still write into them.
+   */
+  static void KeepBuffersAlive(std::vector<std::vector<char>>&& buffers)
+  {
+    static std::mutex                      mutex;
+    // Never destructed, so the buffers survive the static destructors, too
+    static auto                            *orphans=new std::vector<std::vector<char>>();
+    std::scoped_lock<std::mutex>           lock(mutex);
+
+    for (auto& buffer : buffers) {
+      orphans->push_back(std::move(buffer));
+    }
+  }
+#endif
+
+  FileBatchReader::FileBatchReader(size_t threadCount)
+  : threadCount(threadCount)
+  {
+    // no code
+  }
+
+  FileBatchReader::~FileBatchReader()
+  {
+    if (IsOpen()) {
+      Close();
+    }
+  }
+
+  /**
+   * Return the context shared by all readers, create it if there is none
+   */
+  FileBatchReader::ContextRef FileBatchReader::GetContext()
+  {
+    static std::mutex             mutex;
+    static std::weak_ptr<Context> current;
+    std::scoped_lock<std::mutex>  lock(mutex);
+
+    ContextRef context=current.lock();
+
+    if (!context) {
+      context=std::make_shared<Context>();
+      current=context;
+    }
+
+    return context;
+  }
+
+  /**
+   * Returns true, if batched reading is supported on the current platform
+   */
+  bool FileBatchReader::IsSupported()
+  {
+#if defined(HAVE_PREAD)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * Bound the file descriptor of the reader by the given (shared) descriptor pool.
+   * Has to be called before Open().
+   *
+   * Method is NOT thread-safe.
+   */
+  void FileBatchReader::SetDescriptorPool(const FileDescriptorPoolRef& descriptorPool)
+  {
+    assert(!IsOpen());
+
+    this->descriptorPool=descriptorPool;
+  }
+
+  /**
+   * Open the file for batched reading.
+   *
+   * If useIoUring is true and io_uring is supported (and allowed) by the system,
+   * it is used, else the thread pool fallback is used.
+   *
+   * Method is NOT thread-safe.
+   *
+   * @throws IOException if the file cannot be opened
+   */
+  void FileBatchReader::Open(const std::string& filename,
+                             [[maybe_unused]] bool useIoUring)
+  {
+    if (IsOpen()) {
+      throw IOException(filename,"Error opening file for reading","File already opened");
+    }
+
+    this->filename=filename;
+
+#if defined(HAVE_PREAD)
+    if (descriptorPool &&
+        !descriptorPool->Acquire(nullptr)) {
+      throw IOException(filename,"Cannot open file for reading","Too many open files");
+    }
+
+  #if defined(O_CLOEXEC)
+    fd=open(filename.c_str(),O_RDONLY|O_CLOEXEC);
+  #else
+    fd=open(filename.c_str(),O_RDONLY);
+  #endif
+
+    if (fd<0) {
+      if (descriptorPool) {
+        descriptorPool->Release();
+      }
+
+      throw IOException(filename,"Cannot open file for reading");
+    }
+
+    struct stat fileStat;
+
+    if (fstat(fd,&fileStat)!=0) {
+      close(fd);
+      fd=-1;
+
+      if (descriptorPool) {
+        descriptorPool->Release();
+      }
+
+      throw IOException(filename,"Cannot get size of file");
+    }
+
+    size=(FileOffset)fileStat.st_size;
+    backend=Backend::ThreadPool;
+    context=GetContext();
+
+  #if defined(OSMSCOUT_HAVE_IO_URING)
+    if (useIoUring) {
+      // io_uring may be disabled by the kernel configuration or by a seccomp filter
+      if (IoUringPool::Ptr ring=context->ringPool.Borrow(); ring) {
+        backend=Backend::IoUring;
+      }
+      else {
+        log.Warn() << "io_uring is not available, using thread pool for reading file '" << filename << "'";
+      }
+    }
+  #endif
+#else
+    throw IOException(filename,"Cannot open file for reading","Batched reading is not supported on this platform");
+#endif
+  }
+
+  /**
+   * Close the file.
+   *
+   * Method is NOT thread-safe.
+   */
+  void FileBatchReader::Close()
+  {
+    backend=Backend::None;
+    context.reset();
+
+#if defined(HAVE_PREAD)
+    if (fd>=0) {
+      int result=close(fd);
+
+      fd=-1;
+
+      if (descriptorPool) {
+        descriptorPool->Release();
+      }
+
+      if (result!=0) {
+        throw IOException(filename,"Cannot close file");
+      }
+    }
+#endif
+
+    fd=-1;
+  }
+
+  /**
+   * Plan continuous read ranges for the given (sorted, unique) file offsets.
+   *
+   * For each offset readAhead bytes are planned (object size is not known in advance).
+   * Offsets closer than readAhead to the end of the current range are merged into it,
+   * so neighbouring objects are read by one request, as long as the range does not
+   * exceed maxRangeSize.
+   */
+  std::vector<FileBatchReader::Range> FileBatchReader::PlanRanges(const std::vector<FileOffset>& sortedOffsets,
+                                                                  FileOffset fileSize,
+                                                                  size_t readAhead,
+                                                                  size_t maxRangeSize)
+  {
+    std::vector<Range> ranges;
+
+    for (size_t i=0; i<sortedOffsets.size(); i++) {
+      FileOffset offset=sortedOffsets[i];
+      FileOffset end=std::min(offset+readAhead,std::max(fileSize,offset));
+
+      if (!ranges.empty()) {
+        Range& range=ranges.back();
+
+        if (offset<=range.offset+range.length+readAhead &&
+            end-range.offset<=maxRangeSize) {
+          range.length=std::max(range.length,(size_t)(end-range.offset));
+          range.count++;
+          continue;
+        }
+      }
+
+      Range& range=ranges.emplace_back();
+
+      range.offset=offset;
+      range.length=(size_t)(end-offset);
+      range.firstIndex=i;
+      range.count=1;
+    }
+
+    return ranges;
+  }
+
+  /**
+   * Read all given ranges. The callback is called for every range, as soon as its data
+   * is available. All calls happen from the calling thread.
+   *
+   * If reading of any range fails, no more callbacks are called and an exception is thrown,
+   * after all already submitted reads are finished. Exceptions thrown by the callback
+   * are passed through the same way.
+   *
+   * Method is thread-safe.
+   *
+   * @throws IOException on error
+   */
+  void FileBatchReader::Read(std::vector<Range>& ranges,
+                             const CompletionCallback& callback)
+  {
+    if (!IsOpen()) {
+      throw IOException(filename,"Cannot read file","File not opened");
+    }
+
+    if (ranges.empty()) {
+      return;
+    }
+
+    if (backend==Backend::IoUring) {
+      ReadUsingIoUring(ranges,
+                       callback);
+    }
+    else {
+      ReadUsingThreads(ranges,
+                       callback);
+    }
+  }
+
+  void FileBatchReader::ReadUsingIoUring([[maybe_unused]] std::vector<Range>& ranges,
+                                         [[maybe_unused]] const CompletionCallback& callback)
+  {
+#if defined(OSMSCOUT_HAVE_IO_URING)
+    IoUringPool::Ptr ring=context->ringPool.Borrow();
+
+    if (!ring) {
+      ReadUsingThreads(ranges,
+                       callback);
+      return;
+    }
+
+    std::vector<size_t> filled(ranges.size(),0);
+    std::vector<bool>   pushed(ranges.size(),false);
+    std::deque<size_t>  queued;
+    std::vector<size_t> completed;
+    size_t              inFlight=0;
+    size_t              finished=0;
+    int                 error=0;
+    bool                ringFailed=false;
+    std::exception_ptr  callbackException;
+
+    for (size_t i=0; i<ranges.size(); i++) {
+      ranges[i].data.resize(ranges[i].length);
+      queued.push_back(i);
+    }
+
+    // We have to wait for all in-flight requests even in case of error,
+    // else the kernel would write into already released buffers
+    while (finished<ranges.size() &&
+           (inFlight>0 || (error==0 && !callbackException))) {
+      while (error==0 &&
+             !callbackException &&
+             !queued.empty()) {
+        size_t index=queued.front();
+        Range& range=ranges[index];
+
+        if (!ring->PushRead(fd,
+                            range.data.data()+filled[index],
+                            (unsigned)(range.length-filled[index]),
+                            range.offset+filled[index],
+                            index)) {
+          break;
+        }
+
+        queued.pop_front();
+        pushed[index]=true;
+        inFlight++;
+      }
+
+      if (int result=ringFailed ? ring->Wait(1) : ring->Submit(1); result!=0) {
+        if (ringFailed) {
+          // Not even waiting is possible anymore, so the kernel may write into the
+          // buffers of the requests in flight at any time
+          std::vector<std::vector<char>> buffers;
+
+          for (size_t i=0; i<ranges.size(); i++) {
+            if (pushed[i]) {
+              buffers.push_back(std::move(ranges[i].data));
+            }
+          }
+
+          log.Error() << "Cannot wait for " << inFlight << " reads of file '" << filename << "': " << strerror(result);
+          KeepBuffersAlive(std::move(buffers));
+          break;
+        }
+
+        if (result!=EAGAIN && result!=EBUSY) {
+          // Stop queuing, but wait for the requests already submitted
+          // (the queued, not submitted ones will never complete)
+          error=result;
+          ringFailed=true;
+          inFlight-=ring->GetPending();
+        }
+      }
+
+      ring->Reap([&](uint64_t index,int result) {
+        Range& range=ranges[index];
+
+        inFlight--;
+        pushed[index]=false;
+
+        if (result==-EINTR || result==-EAGAIN) {
+          queued.push_front(index);
+          return;
+        }
+
+        if (result<0) {
+          error=-result;
+          finished++;
+          return;
+        }
+
+        filled[index]+=(size_t)result;
+
+        if (result>0 && filled[index]<range.length) {
+          // Short read, read the rest
+          queued.push_front(index);
+          return;
+        }
+
+        range.data.resize(filled[index]);
+        completed.push_back(index);
+        finished++;
+      });
+
+      for (size_t index : completed) {
+        if (error!=0 || callbackException) {
+          break;
+        }
+
+        try {
+          callback(ranges[index]);
+        }
+        catch (...) {
+          callbackException=std::current_exception();
+        }
+      }
+
+      completed.clear();
+    }
+
+    if (callbackException) {
+      std::rethrow_exception(callbackException);
+    }
+
+    if (error!=0) {
+      throw IOException(filename,"Cannot read file",strerror(error));
+    }
+#else
+    throw IOException(filename,"Cannot read file","io_uring is not supported");
+#endif
+  }
+
+  void FileBatchReader::ReadUsingThreads([[maybe_unused]] std::vector<Range>& ranges,
+                                         [[maybe_unused]] const CompletionCallback& callback)
+  {
+#if defined(HAVE_PREAD)
+    if (threadCount==0 || ranges.size()==1) {
+      for (auto& range : ranges) {
+        if (int error=ReadFully(fd,range); error!=0) {
+          throw IOException(filename,"Cannot read file",strerror(error));
+        }
+
+        callback(range);
+      }
+
+      return;
+    }
+
+    context->StartThreads(threadCount);
+
+    BlockingQueue<size_t> completed;
+    std::vector<int>      errors(ranges.size(),0);
+
+    for (size_t i=0; i<ranges.size(); i++) {
+      if (!context->tasks.Push([this,&ranges,&errors,&completed,i]() {
+            errors[i]=ReadFully(fd,ranges[i]);
+            completed.Push(size_t(i));
+          })) {
+        // The pool is shutting down, report the range as failed
+        errors[i]=ECANCELED;
+        completed.Push(size_t(i));
+      }
+    }
+
+    int                error=0;
+    std::exception_ptr callbackException;
+
+    // Tasks reference local data, so we have to wait for all of them
+    for (size_t i=0; i<ranges.size(); i++) {
+      std::optional<size_t> index=completed.Pop();
+
+      if (!index) {
+        // The completion queue is never stopped, but handle it as a failed read anyway
+        error=ECANCELED;
+        break;
+      }
+
+      if (error!=0 || callbackException) {
+        continue;
+      }
+
+      if (errors[*index]!=0) {
+        error=errors[*index];
+        continue;
+      }
+
+      try {
+        callback(ranges[*index]);
+      }
+      catch (...) {
+        callbackException=std::current_exception();
+      }
+    }
+
+    if (callbackException) {
+      std::rethrow_exception(callbackException);
+    }
+
+    if (error!=0) {
+      throw IOException(filename,"Cannot read file",strerror(error));
+    }
+#else
+    throw IOException(filename,"Cannot read file","Batched reading is not supported on this platform");
+#endif
+  }
+}
@@ -0,0 +1,148 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/io/FileDescriptorPool.h>
+
+#include <algorithm>
+
+namespace osmscout {
+
+  /**
+   * Create a pool for at most maxOpen files. Requests wait at most timeout for a free slot.
+   */
+  FileDescriptorPool::FileDescriptorPool(size_t maxOpen,
+                                         std::chrono::milliseconds timeout)
+  : maxOpen(maxOpen),
+    timeout(timeout)
+  {
+    // no code
+  }
+
+  /**
+   * Register a client. The client has to be unregistered, before it is destroyed.
+   */
+  void FileDescriptorPool::Register(Client& client)
+  {
+    std::scoped_lock<std::mutex> lock(clientMutex);
+
+    clients.push_back(&client);
+  }
+
+  /**
+   * Unregister a client. Waits for a running request closing idle files,
+   * so the client is not used by the pool after the call returns.
+   */
+  void FileDescriptorPool::Unregister(Client& client)
+  {
+    std::scoped_lock<std::mutex> lock(clientMutex);
+
+    clients.erase(std::remove(clients.begin(),clients.end(),&client),
+                  clients.end());
+  }
+
+  bool FileDescriptorPool::TryAcquire()
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    if (open<maxOpen) {
+      open++;
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * Acquire a slot for a file to open. If there is no free slot, idle files of
+   * the other clients are closed. If this does not free a slot, the call waits
+   * until a slot is released (or the timeout is reached).
+   *
+   * @param requester
+   *    client requesting the slot, its idle files are not closed (may be null)
+   * @return true, if a slot was acquired, false if the timeout was reached
+   */
+  bool FileDescriptorPool::Acquire(const Client* requester)
+  {
+    if (TryAcquire()) {
+      return true;
+    }
+
+    {
+      std::scoped_lock<std::mutex> lock(clientMutex);
+
+      for (Client* client : clients) {
+        if (client!=requester &&
+            client->CloseIdle()>0 &&
+            TryAcquire()) {
+          return true;
+        }
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    waiting++;
+
+    bool acquired=released.wait_for(lock,timeout,[this]() {
+      return open<maxOpen;
+    });
+
+    waiting--;
+
+    if (acquired) {
+      open++;
+    }
+
+    return acquired;
+  }
+
+  /**
+   * Release a slot acquired before
+   */
+  void FileDescriptorPool::Release()
+  {
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      open--;
+    }
+
+    released.notify_one();
+  }
+
+  /**
+   * Return true, if there are requests waiting for a free slot
+   */
+  bool FileDescriptorPool::HasWaiters() const
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    return waiting>0;
+  }
+
+  /**
+   * Return the number of slots in use
+   */
+  size_t FileDescriptorPool::GetOpen() const
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    return open;
+  }
+}
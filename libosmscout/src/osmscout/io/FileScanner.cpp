@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <cstring>
 
+#include <algorithm>
 #include <limits>
 
 #if defined(HAVE_MMAP)
@@ -77,23 +78,18 @@ namespace osmscout {
 
   void FileScanner::FreeBuffer()
   {
-#if defined(HAVE_MMAP)
-    if (mmap!=nullptr) {
-      if (munmap(mmap,size)!=0) {
-        log.Error() << "Error while calling munmap: "<< strerror(errno) << " for file '" << filename << "'";
-      }
-
-      mmap=nullptr;
+    // Memory is unmapped by the deleter of the mapping,
+    // when the last scanner (or view) sharing it releases it
+    mapping.reset();
+    mmap=nullptr;
+    windowAttached=false;
+    windowStart=0;
+
+#if !defined(HAVE_MMAP) && defined(_WIN32)
+    if (mmfHandle!=nullptr) {
+      CloseHandle(mmfHandle);
+      mmfHandle=nullptr;
     }
-#elif  defined(_WIN32)
-      if (mmap!=nullptr) {
-        UnmapViewOfFile(mmap);
-        mmap=nullptr;
-      }
-      if (mmfHandle!=nullptr) {
-        CloseHandle(mmfHandle);
-        mmfHandle=nullptr;
-      }
 #endif
   }
 
@@ -198,6 +194,11 @@ namespace osmscout {
       mmap=(char*)::mmap(nullptr,(size_t)fileSize,PROT_READ,MAP_PRIVATE,fileno(file),0);
       if (mmap!=MAP_FAILED) {
         offset=0;
+        mapping=std::shared_ptr<char>(mmap,[mappedSize=(size_t)fileSize,mappedFilename=filename](char* memory) {
+          if (munmap(memory,mappedSize)!=0) {
+            log.Error() << "Error while calling munmap: "<< strerror(errno) << " for file '" << mappedFilename << "'";
+          }
+        });
 #if defined(HAVE_POSIX_MADVISE)
         if (mode==FastRandom) {
           if (posix_madvise(mmap,(size_t)fileSize,POSIX_MADV_WILLNEED)!=0) {
@@ -240,6 +241,11 @@ namespace osmscout {
 
         if (mmap!=nullptr) {
           offset=0;
+          mapping=std::shared_ptr<char>(mmap,[handle=mmfHandle](char* memory) {
+            UnmapViewOfFile(memory);
+            CloseHandle(handle);
+          });
+          mmfHandle=nullptr;
         }
         else {
           log.Error() << "Cannot map view for file '" << filename << "' of size " << size << " (" << GetLastError() << ")";
@@ -254,6 +260,40 @@ namespace osmscout {
     hasError=false;
   }
 
+  /**
+   * Opens the file of the given (opened) scanner. If the given scanner
+   * has the file memory mapped, the mapping is shared (and not mapped again).
+   * The new scanner has its own file position.
+   */
+  void FileScanner::OpenShared(const FileScanner& scanner)
+  {
+    if (file!=nullptr) {
+      throw IOException(scanner.filename,"Error opening file for reading","File already opened");
+    }
+
+    if (scanner.file==nullptr) {
+      throw IOException(scanner.filename,"Error opening file for reading","Shared file is not opened");
+    }
+
+    hasError=true;
+    filename=scanner.filename;
+
+    file=fopen(filename.c_str(),"rb");
+
+    if (file==nullptr) {
+      throw IOException(filename,"Cannot open file for reading");
+    }
+
+    FreeBuffer();
+
+    size=scanner.size;
+    offset=0;
+    mapping=scanner.mapping;
+    mmap=scanner.mmap;
+
+    hasError=false;
+  }
+
   /**
    * Closes the file.
    *
@@ -297,6 +337,63 @@ namespace osmscout {
     file=nullptr;
   }
 
+  /**
+   * Attach the given memory block (containing file data read by other means,
+   * like FileBatchReader) as window of the file, starting at the given file offset.
+   * While the window is attached, all reads are served from the window memory
+   * (the same way as from a memory mapped file) and positions outside of the window
+   * cannot be read. The memory has to be valid until the window is detached.
+   *
+   * Attaching a window to a memory mapped scanner is not supported.
+   *
+   * throws IOException on error
+   */
+  void FileScanner::AttachWindow(FileOffset start,
+                                 const char* data,
+                                 size_t length)
+  {
+    if (file==nullptr) {
+      throw IOException(filename,"Cannot attach window","File not opened");
+    }
+
+    if (mmap!=nullptr) {
+      throw IOException(filename,"Cannot attach window","File is memory mapped or window is already attached");
+    }
+
+#if !defined(HAVE_MMAP) && !defined(_WIN32)
+    throw IOException(filename,"Cannot attach window","Memory based reading is not supported on this platform");
+#endif
+
+    // The window memory is never written, mmap is just the shared read path
+    mmap=const_cast<char*>(data);
+    fileSize=size;
+    size=length;
+    offset=0;
+    windowStart=start;
+    windowAttached=true;
+  }
+
+  /**
+   * Detach the window attached before by AttachWindow(). As reading
+   * beyond the window is expected to happen (the caller does not know the size of
+   * the data in advance), the error state is cleared, so reading can
+   * continue from the file. The file position is undefined.
+   */
+  void FileScanner::DetachWindow()
+  {
+    if (!windowAttached) {
+      return;
+    }
+
+    mmap=nullptr;
+    size=fileSize;
+    offset=0;
+    windowStart=0;
+    fileSize=0;
+    windowAttached=false;
+    hasError=file==nullptr;
+  }
+
   bool FileScanner::IsEOF() const
   {
     if (HasError()) {
@@ -307,6 +404,10 @@ namespace osmscout {
       return true;
     }
 
+    if (windowAttached) {
+      return windowStart+offset>=fileSize;
+    }
+
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (mmap!=nullptr) {
       return offset>=size;
@@ -346,6 +447,18 @@ namespace osmscout {
       throw IOException(filename,"Cannot set position in file","File already in error state");
     }
 
+    if (windowAttached) {
+      if (pos<windowStart ||
+          pos-windowStart>=size) {
+        hasError=true;
+        throw IOException(filename,"Cannot set position in file to "+std::to_string(pos),"Position outside of attached window");
+      }
+
+      offset=pos-windowStart;
+
+      return;
+    }
+
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (mmap!=nullptr) {
       if (pos>=size) {
@@ -375,6 +488,93 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Hint the operating system, that the given part of the file will be read soon,
+   * so it can start reading it ahead (asynchronously). Does nothing
+   * if the platform does not support it or a window is attached.
+   */
+  void FileScanner::WillNeed([[maybe_unused]] FileOffset pos,
+                             [[maybe_unused]] size_t length)
+  {
+    if (HasError() ||
+        windowAttached ||
+        pos>=size ||
+        length==0) {
+      return;
+    }
+
+    length=(size_t)std::min((FileOffset)length,size-pos);
+
+#if defined(HAVE_MMAP) && defined(HAVE_POSIX_MADVISE)
+    if (mmap!=nullptr) {
+      // Address has to be page aligned
+      static const FileOffset pageSize=(FileOffset)sysconf(_SC_PAGESIZE);
+
+      FileOffset start=pos-pos%pageSize;
+
+      if (posix_madvise(mmap+start,(size_t)(pos+length-start),POSIX_MADV_WILLNEED)!=0) {
+        log.Warn() << "Cannot set mmaped file access advice for file '" << filename << "' (" << strerror(errno) << ")";
+      }
+
+      return;
+    }
+#endif
+
+#if defined(HAVE_POSIX_FADVISE)
+    if (mmap==nullptr) {
+      if (posix_fadvise(fileno(file),(off_t)pos,(off_t)length,POSIX_FADV_WILLNEED)!=0) {
+        log.Warn() << "Cannot set file access advice for file '" << filename << "' (" << strerror(errno) << ")";
+      }
+    }
+#endif
+  }
+
+  /**
+   * Lock the given part of the memory mapped file into memory, so that it is
+   * paged in (if not already resident) and will not be evicted from the page cache
+   * until the file is closed.
+   *
+   * Locking may fail, if the locked memory of the process exceeds the
+   * platform limit (see RLIMIT_MEMLOCK).
+   *
+   * @return false, if the file is not memory mapped, the platform does not support
+   * locking or locking failed
+   */
+  bool FileScanner::Lock([[maybe_unused]] FileOffset pos,
+                         [[maybe_unused]] size_t length)
+  {
+    if (HasError() ||
+        windowAttached ||
+        pos>=size) {
+      return false;
+    }
+
+    if (length==0) {
+      return true;
+    }
+
+    length=(size_t)std::min((FileOffset)length,size-pos);
+
+#if defined(HAVE_MMAP) && defined(HAVE_MLOCK)
+    if (mmap!=nullptr) {
+      // Address has to be page aligned on some platforms
+      static const FileOffset pageSize=(FileOffset)sysconf(_SC_PAGESIZE);
+
+      FileOffset start=pos-pos%pageSize;
+
+      if (mlock(mmap+start,(size_t)(pos+length-start))!=0) {
+        log.Warn() << "Cannot lock mmaped file '" << filename << "' into memory (" << strerror(errno) << ")";
+
+        return false;
+      }
+
+      return true;
+    }
+#endif
+
+    return false;
+  }
+
   /**
    * Returns the current position of the reading cursor in relation to the begining of the file
    *
@@ -386,6 +586,10 @@ namespace osmscout {
       throw IOException(filename,"Cannot read position in file","File already in error state");
     }
 
+    if (windowAttached) {
+      return windowStart+offset;
+    }
+
 #if defined(HAVE_MMAP) || defined(_WIN32)
     if (mmap!=nullptr) {
       return offset;
@@ -2293,24 +2497,28 @@ namespace osmscout {
     return std::make_tuple(coord,isSet);
   }
 
-  void FileScanner::Read(std::vector<Point>& nodes,
-                         std::vector<SegmentGeoBox> &segments,
-                         GeoBox &bbox,
-                         bool readIds)
+  /**
+   * Reads the header of an encoded coordinate array
+   *
+   * coordBitSize is the size of one fixed width delta pair in bits,
+   * or 0 for stream-vbyte encoded deltas.
+   *
+   * @return false, if the array is empty
+   */
+  bool FileScanner::ReadCoordArrayHeader(bool readIds,
+                                         size_t& nodeCount,
+                                         size_t& coordBitSize,
+                                         bool& hasNodes)
   {
-    size_t  coordBitSize;
     uint8_t sizeByte;
 
     sizeByte=ReadUInt8();
 
     // Fast exit for empty arrays
     if (sizeByte==0) {
-      return;
+      return false;
     }
 
-    bool   hasNodes;
-    size_t nodeCount;
-
     if (readIds) {
       hasNodes=(sizeByte & 0x04u)!=0;
 
@@ -2320,9 +2528,12 @@ namespace osmscout {
       else if ((sizeByte & 0x03u) == 1) {
         coordBitSize=32;
       }
-      else {
+      else if ((sizeByte & 0x03u) == 2) {
         coordBitSize=48;
       }
+      else {
+        coordBitSize=0;
+      }
 
       nodeCount=(sizeByte & 0x78u) >> 3;
 
@@ -2353,9 +2564,12 @@ namespace osmscout {
       else if ((sizeByte & 0x03u) == 1) {
         coordBitSize=32;
       }
-      else {
+      else if ((sizeByte & 0x03u) == 2) {
         coordBitSize=48;
       }
+      else {
+        coordBitSize=0;
+      }
 
       nodeCount=(sizeByte & 0x7cu) >> 2;
 
@@ -2378,6 +2592,72 @@ namespace osmscout {
       }
     }
 
+
+    return true;
+  }
+
+  /**
+   * Reads stream-vbyte encoded deltas of all nodes but the first one and
+   * sets their coordinates. lat and lon are the raw values of the first node.
+   */
+  void FileScanner::ReadStreamVByteCoords(std::vector<Point>& nodes,
+                                          uint32_t lat,
+                                          uint32_t lon)
+  {
+    size_t valueCount=(nodes.size()-1)*2;
+
+    if (valueCount==0) {
+      return;
+    }
+
+    size_t         controlLength=StreamVByteControlLength(valueCount);
+    const uint8_t *control=(const uint8_t*)ReadInternal(controlLength);
+
+    // Without memory mapping the next read overwrites the internal buffer
+    if (mmap==nullptr) {
+      controlBuffer.assign(control,control+controlLength);
+      control=controlBuffer.data();
+    }
+
+    size_t         dataLength=StreamVByteDataLength(control,valueCount);
+    const uint8_t *data=(const uint8_t*)ReadInternal(dataLength);
+
+    // The SIMD decoder loads 16 bytes at once, in case of memory mapping
+    // it may read beyond the array up to the end of the file
+    const uint8_t *dataEnd=mmap!=nullptr ? (const uint8_t*)mmap+size : data+dataLength;
+
+    coordBuffer.resize(valueCount);
+
+    StreamVByteDecodeCoords(control,
+                            data,
+                            dataEnd,
+                            valueCount,
+                            lat,
+                            lon,
+                            coordBuffer.data());
+
+    for (size_t i=1; i<nodes.size(); i++) {
+      SetCoord(coordBuffer[2*i-2],coordBuffer[2*i-1],nodes[i]);
+    }
+  }
+
+  void FileScanner::Read(std::vector<Point>& nodes,
+                         std::vector<SegmentGeoBox> &segments,
+                         GeoBox &bbox,
+                         bool readIds)
+  {
+    size_t coordBitSize;
+    size_t nodeCount;
+    bool   hasNodes;
+
+    // Fast exit for empty arrays
+    if (!ReadCoordArrayHeader(readIds,
+                              nodeCount,
+                              coordBitSize,
+                              hasNodes)) {
+      return;
+    }
+
     nodes.resize(nodeCount);
 
     size_t byteBufferSize=(nodeCount-1)*coordBitSize/8;
@@ -2389,10 +2669,14 @@ namespace osmscout {
 
     nodes[0].SetCoord(firstCoord);
 
-    const uint8_t *tmpBuffer = (uint8_t*)ReadInternal(byteBufferSize);
-
-    if (coordBitSize==16) {
-      size_t currentCoordPos=1;
+    if (coordBitSize==0) {
+      ReadStreamVByteCoords(nodes,
+                            latValue,
+                            lonValue);
+    }
+    else if (coordBitSize==16) {
+      const uint8_t *tmpBuffer = (uint8_t*)ReadInternal(byteBufferSize);
+      size_t        currentCoordPos=1;
 
       for (size_t i=0; i<byteBufferSize; i+=2) {
         int32_t latDelta=(int8_t)tmpBuffer[i];
@@ -2407,7 +2691,8 @@ namespace osmscout {
       }
     }
     else if (coordBitSize==32) {
-      size_t currentCoordPos=1;
+      const uint8_t *tmpBuffer = (uint8_t*)ReadInternal(byteBufferSize);
+      size_t        currentCoordPos=1;
 
       for (size_t i=0; i<byteBufferSize; i+=4) {
         uint32_t latUDelta=tmpBuffer[i+0] | (tmpBuffer[i+1]<<8);
@@ -2439,7 +2724,8 @@ namespace osmscout {
       }
     }
     else {
-      size_t currentCoordPos=1;
+      const uint8_t *tmpBuffer = (uint8_t*)ReadInternal(byteBufferSize);
+      size_t        currentCoordPos=1;
 
       for (size_t i=0; i<byteBufferSize; i+=6) {
         uint32_t latUDelta=(tmpBuffer[i+0]) | (tmpBuffer[i+1]<<8) | (tmpBuffer[i+2]<<16);
@@ -2511,6 +2797,126 @@ namespace osmscout {
     }
   }
 
+  CoordArrayView FileScanner::ReadCoordArrayView(bool readIds)
+  {
+    bool isFrontRelevant;
+    bool isBackRelevant;
+
+    return ReadCoordArrayView(readIds,
+                              isFrontRelevant,
+                              isBackRelevant);
+  }
+
+  CoordArrayView FileScanner::ReadCoordArrayView(bool readIds,
+                                                 bool& isFrontRelevant,
+                                                 bool& isBackRelevant)
+  {
+    isFrontRelevant=false;
+    isBackRelevant=false;
+
+    if (HasError()) {
+      throw IOException(filename,"Cannot read coordinate array","File already in error state");
+    }
+
+    if (mapping==nullptr) {
+      throw IOException(filename,"Cannot read coordinate array","File is not memory mapped");
+    }
+
+    size_t coordBitSize;
+    size_t nodeCount;
+    bool   hasNodes;
+
+    if (!ReadCoordArrayHeader(readIds,
+                              nodeCount,
+                              coordBitSize,
+                              hasNodes)) {
+      return {};
+    }
+
+    if (offset+coordByteSize-1>=size) {
+      hasError=true;
+      throw IOException(filename,"Cannot read coordinate array","Cannot read beyond end of file");
+    }
+
+    const auto *dataPtr=(const uint8_t*)&mmap[offset];
+    size_t     deltaBytes=coordBitSize/8;
+    size_t     controlLength=0;
+    size_t     byteBufferSize;
+
+    if (coordBitSize==0) {
+      size_t valueCount=(nodeCount-1)*2;
+
+      controlLength=StreamVByteControlLength(valueCount);
+
+      if (offset+coordByteSize+controlLength-1>=size) {
+        hasError=true;
+        throw IOException(filename,"Cannot read coordinate array","Cannot read beyond end of file");
+      }
+
+      byteBufferSize=controlLength+StreamVByteDataLength(dataPtr+coordByteSize,valueCount);
+    }
+    else {
+      byteBufferSize=(nodeCount-1)*deltaBytes;
+    }
+
+    if (offset+coordByteSize+byteBufferSize-1>=size) {
+      hasError=true;
+      throw IOException(filename,"Cannot read coordinate array","Cannot read beyond end of file");
+    }
+
+    uint32_t latDat=  (dataPtr[0] <<  0)
+                    | (dataPtr[1] <<  8)
+                    | (dataPtr[2] << 16)
+                    | ((dataPtr[6] & 0x0fu) << 24);
+
+    uint32_t lonDat=  (dataPtr[3] <<  0)
+                    | (dataPtr[4] <<  8)
+                    | (dataPtr[5] << 16)
+                    | ((dataPtr[6] & 0xf0u) << 20);
+
+    offset+=coordByteSize+byteBufferSize;
+
+    if (hasNodes) {
+      size_t idCurrent=0;
+
+      while (idCurrent<nodeCount) {
+        uint8_t bitset=ReadUInt8();
+        size_t  bitmask=1;
+
+        for (size_t i=0; i<8 && idCurrent<nodeCount; i++) {
+          if ((bitset & bitmask)!=0) {
+            ReadUInt8();
+
+            if (idCurrent==0) {
+              isFrontRelevant=true;
+            }
+
+            if (idCurrent==nodeCount-1) {
+              isBackRelevant=true;
+            }
+          }
+
+          bitmask*=2;
+          idCurrent++;
+        }
+      }
+    }
+
+    if (coordBitSize==0) {
+      return {dataPtr+coordByteSize,
+              dataPtr+coordByteSize+controlLength,
+              latDat,
+              lonDat,
+              (uint32_t)nodeCount};
+    }
+
+    return {dataPtr+coordByteSize,
+            latDat,
+            lonDat,
+            (uint32_t)nodeCount,
+            (uint8_t)deltaBytes};
+  }
+
   GeoBox FileScanner::ReadBox()
   {
     if (HasError()) {
@@ -0,0 +1,227 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/io/FileScannerPool.h>
+
+#include <cassert>
+
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+  FileScannerPool::FileScannerPool(size_t maxSize)
+  : ObjectPool<FileScanner>(maxSize)
+  {
+    // no code
+  }
+
+  FileScannerPool::~FileScannerPool()
+  {
+    Close(); // we have Destroy method override...
+  }
+
+  /**
+   * Bound the number of open files of the pool by the given (shared) descriptor pool.
+   * Has to be called before Open().
+   *
+   * Method is NOT thread-safe.
+   */
+  void FileScannerPool::SetDescriptorPool(const FileDescriptorPoolRef& descriptorPool)
+  {
+    assert(!IsOpen());
+
+    this->descriptorPool=descriptorPool;
+  }
+
+  /**
+   * Open the pool for the given file. The file is opened (and mapped)
+   * immediately to validate that it is readable.
+   *
+   * Method is NOT thread-safe.
+   *
+   * @throws IOException if the file cannot be opened
+   */
+  void FileScannerPool::Open(const std::string& filename,
+                             FileScanner::Mode mode,
+                             bool memoryMapped)
+  {
+    Close();
+
+    if (descriptorPool) {
+      if (!descriptorPool->Acquire(this)) {
+        throw IOException(filename,"Cannot open file for reading","Too many open files");
+      }
+
+      descriptorPool->Register(*this);
+    }
+
+    auto scanner=std::make_unique<FileScanner>();
+
+    try {
+      scanner->Open(filename,
+                    mode,
+                    memoryMapped);
+    }
+    catch (const IOException&) {
+      scanner->CloseFailsafe();
+
+      if (descriptorPool) {
+        descriptorPool->Unregister(*this);
+        descriptorPool->Release();
+      }
+
+      throw;
+    }
+
+    mappedScanner=std::move(scanner);
+  }
+
+  /**
+   * Close all pooled scanners. Scanners borrowed at the moment
+   * are closed when returned to the pool. The mapping is released,
+   * when the last scanner (or view) using it is closed.
+   *
+   * Method is NOT thread-safe.
+   */
+  void FileScannerPool::Close()
+  {
+    if (mappedScanner &&
+        descriptorPool) {
+      descriptorPool->Unregister(*this);
+    }
+
+    Clear();
+
+    if (mappedScanner) {
+      try {
+        mappedScanner->Close();
+      }
+      catch (const IOException& e) {
+        log.Error() << e.GetDescription();
+        mappedScanner->CloseFailsafe();
+      }
+
+      mappedScanner.reset();
+
+      if (descriptorPool) {
+        descriptorPool->Release();
+      }
+    }
+  }
+
+  FileScanner* FileScannerPool::OpenScanner() noexcept
+  {
+    if (!mappedScanner) {
+      return nullptr;
+    }
+
+    auto *scanner=new FileScanner();
+
+    try {
+      scanner->OpenShared(*mappedScanner);
+      return scanner;
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner->CloseFailsafe();
+      delete scanner;
+      return nullptr;
+    }
+  }
+
+  /**
+   * Borrow a scanner. If there is a descriptor pool, the descriptor for a new
+   * scanner is acquired without holding the lock of the pool, so returning
+   * scanners (and releasing their descriptors) is not blocked while waiting.
+   */
+  FileScannerPool::Ptr FileScannerPool::Borrow()
+  {
+    if (!descriptorPool) {
+      return ObjectPool<FileScanner>::Borrow();
+    }
+
+    if (Ptr scanner=BorrowPooled();
+        scanner) {
+      return scanner;
+    }
+
+    if (!IsOpen()) {
+      return Ptr(nullptr);
+    }
+
+    if (!descriptorPool->Acquire(this)) {
+      log.Error() << "Cannot open file '" << mappedScanner->GetFilename() << "', too many open files";
+      return Ptr(nullptr);
+    }
+
+    FileScanner* scanner=OpenScanner();
+
+    if (scanner==nullptr) {
+      descriptorPool->Release();
+      return Ptr(nullptr);
+    }
+
+    return Wrap(scanner);
+  }
+
+  FileScanner* FileScannerPool::MakeNew() noexcept
+  {
+    return OpenScanner();
+  }
+
+  void FileScannerPool::Destroy(FileScanner* scanner) noexcept
+  {
+    try {
+      if (scanner->IsOpen()) {
+        scanner->Close();
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner->CloseFailsafe();
+    }
+
+    delete scanner;
+
+    if (descriptorPool) {
+      descriptorPool->Release();
+    }
+  }
+
+  /**
+   * Scanners are not kept in the pool, if other pools are waiting
+   * for a file descriptor.
+   */
+  bool FileScannerPool::IsValid(FileScanner* scanner) noexcept
+  {
+    return mappedScanner!=nullptr &&
+           scanner->IsOpen() &&
+           !scanner->HasError() &&
+           !(descriptorPool && descriptorPool->HasWaiters());
+  }
+
+  /**
+   * Close the scanners kept in the pool (not the borrowed ones). Called by the
+   * descriptor pool, if other pools need file descriptors.
+   */
+  size_t FileScannerPool::CloseIdle() noexcept
+  {
+    return TryClear();
+  }
+}
@@ -1107,7 +1107,10 @@ namespace osmscout {
 
     uint8_t coordSizeFlags;
 
-    if (coordBitSize==16) {
+    if (coordEncoding==CoordEncoding::streamVByte) {
+      coordSizeFlags=streamVByteCoordSizeFlags;
+    }
+    else if (coordBitSize==16) {
       coordSizeFlags=0x00;
     }
     else if (coordBitSize==32) {
@@ -1213,9 +1216,14 @@ namespace osmscout {
 
     WriteCoord(nodes[0].GetCoord());
 
-    byteBuffer.resize(bytesNeeded);
+    if (coordEncoding==CoordEncoding::streamVByte) {
+      byteBuffer.clear();
+      StreamVByteEncode(deltaBuffer,
+                        byteBuffer);
+    }
+    else if (coordBitSize==16) {
+      byteBuffer.resize(bytesNeeded);
 
-    if (coordBitSize==16) {
       size_t byteBufferPos=0;
 
       for (int i : deltaBuffer) {
@@ -1224,6 +1232,8 @@ namespace osmscout {
       }
     }
     else if (coordBitSize==32) {
+      byteBuffer.resize(bytesNeeded);
+
       size_t byteBufferPos=0;
 
       for (int i : deltaBuffer) {
@@ -1235,6 +1245,8 @@ namespace osmscout {
       }
     }
     else {
+      byteBuffer.resize(bytesNeeded);
+
       size_t byteBufferPos=0;
       for (size_t i=0; i<deltaBuffer.size(); i+=2) {
         byteBuffer[byteBufferPos]=deltaBuffer[i] & 0xff;
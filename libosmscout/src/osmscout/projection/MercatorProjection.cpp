@@ -25,6 +25,7 @@
 
 #include <osmscout/system/Assert.h>
 #include <osmscout/system/Math.h>
+#include <osmscout/system/VectorMath.h>
 
 #ifdef OSMSCOUT_HAVE_SSE2
 #include <osmscout/system/SSEMath.h>
@@ -216,6 +217,54 @@ namespace osmscout {
     return IsValidFor(coord);
   }
 
+  void MercatorProjection::GeoToPixel(const double* lat,
+                                      const double* lon,
+                                      double* x,
+                                      double* y,
+                                      size_t count) const
+  {
+    assert(valid);
+
+    // Screen coordinate relative to center of image, see single coordinate variant
+    if (useLinearInterpolation) {
+      for (size_t i=0; i<count; i++) {
+        y[i]=(lat[i]-this->center.GetLat())*scaledLatDeriv;
+      }
+    }
+    else {
+      for (size_t i=0; i<count; i++) {
+        y[i]=std::min(std::max(lat[i], MinLat), MaxLat)*gradtorad;
+      }
+
+      // Dominates the calculation, so it is done in one vectorized run
+      AtanhSin(y,y,count);
+
+      for (size_t i=0; i<count; i++) {
+        y[i]=(y[i]-latOffset)*scale;
+      }
+    }
+
+    for (size_t i=0; i<count; i++) {
+      x[i]=(lon[i]-this->center.GetLon())*scaleGradtorad;
+    }
+
+    if (angle!=0.0) {
+      for (size_t i=0; i<count; i++) {
+        double xn=x[i]*angleNegCos-y[i]*angleNegSin;
+        double yn=x[i]*angleNegSin+y[i]*angleNegCos;
+
+        x[i]=xn;
+        y[i]=yn;
+      }
+    }
+
+    // Transform to canvas coordinate
+    for (size_t i=0; i<count; i++) {
+      y[i]=height/2.0-y[i];
+      x[i]+=width/2.0;
+    }
+  }
+
   void MercatorProjection::GeoToPixel(const BatchTransformer& /*transformData*/) const
   {
     assert(false); //should not be called
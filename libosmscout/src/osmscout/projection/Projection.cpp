@@ -25,6 +25,24 @@
 
 namespace osmscout {
 
+  void Projection::GeoToPixel(const double* lat,
+                              const double* lon,
+                              double* x,
+                              double* y,
+                              size_t count) const
+  {
+    Vertex2D pixel;
+
+    for (size_t i=0; i<count; i++) {
+      GeoToPixel(GeoCoord(lat[i],
+                          lon[i]),
+                 pixel);
+
+      x[i]=pixel.GetX();
+      y[i]=pixel.GetY();
+    }
+  }
+
   bool Projection::BoundingBoxToPixel(const GeoBox& boundingBox,
                                       ScreenBox& screenBox) const
   {
@@ -23,6 +23,7 @@
 
 #include <osmscout/system/Assert.h>
 #include <osmscout/system/Math.h>
+#include <osmscout/system/VectorMath.h>
 
 #ifdef OSMSCOUT_HAVE_SSE2
 #include <osmscout/system/SSEMath.h>
@@ -174,4 +175,35 @@ namespace osmscout {
     }
 
   #endif
+
+  void TileProjection::GeoToPixel(const double* lat,
+                                  const double* lon,
+                                  double* x,
+                                  double* y,
+                                  size_t count) const
+  {
+    for (size_t i=0; i<count; i++) {
+      x[i]=lon[i]*scaleGradtorad-lonOffset;
+    }
+
+  #ifndef OSMSCOUT_HAVE_SSE2
+    if (useLinearInterpolation) {
+      for (size_t i=0; i<count; i++) {
+        y[i]=(height/2.0)-((lat[i]-this->center.GetLat())*scaledLatDeriv);
+      }
+
+      return;
+    }
+  #endif
+
+    for (size_t i=0; i<count; i++) {
+      y[i]=lat[i]*gradtorad;
+    }
+
+    AtanhSin(y,y,count);
+
+    for (size_t i=0; i<count; i++) {
+      y[i]=height-(scale*y[i]-latOffset);
+    }
+  }
 }
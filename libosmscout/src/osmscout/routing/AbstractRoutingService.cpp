@@ -19,6 +19,8 @@
 */
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include <osmscout/routing/RoutingService.h>
 #include <osmscout/routing/RoutingProfile.h>
@@ -78,6 +80,37 @@ namespace osmscout {
   {
   }
 
+  RoutingMatrixResult::RoutingMatrixResult(size_t sourceCount,
+                                           size_t targetCount)
+    : sourceCount(sourceCount),
+      targetCount(targetCount),
+      costs(sourceCount*targetCount,std::numeric_limits<double>::infinity()),
+      distances(sourceCount*targetCount),
+      durations(sourceCount*targetCount)
+  {
+  }
+
+  void RoutingMatrixResult::Set(size_t source,
+                                size_t target,
+                                double cost,
+                                const Distance& distance,
+                                const Duration& duration)
+  {
+    assert(source<sourceCount);
+    assert(target<targetCount);
+
+    costs[source*targetCount+target]=cost;
+    distances[source*targetCount+target]=distance;
+    durations[source*targetCount+target]=duration;
+  }
+
+  void AlternativeRoutesResult::AddRoute(RoutingResult&& route,
+                                         double cost)
+  {
+    routes.push_back(std::move(route));
+    costs.push_back(cost);
+  }
+
   template <class RoutingState>
   AbstractRoutingService<RoutingState>::AbstractRoutingService(const RouterParameter& parameter):
     debugPerformance(parameter.IsDebugPerformance())
@@ -89,6 +122,21 @@ namespace osmscout {
   {
   }
 
+  /**
+   * Compile the profile of the given routing state for the given database into
+   * the given CompiledRoutingProfile. If true is returned, the route calculation
+   * uses the compiled profile instead of calling CanUse() and GetCosts() per path.
+   *
+   * The default implementation returns false.
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::CompileProfile(const RoutingState& /*state*/,
+                                                            DatabaseId /*database*/,
+                                                            CompiledRoutingProfile& /*compiled*/)
+  {
+    return false;
+  }
+
   template <class RoutingState>
   void AbstractRoutingService<RoutingState>::ResolveRNodeChainToList(const RNode &finalRouteNode,
                                                                      const ClosedSet& closedSet,
@@ -248,9 +296,9 @@ namespace osmscout {
                                                       const GeoCoord& targetCoord,
                                                       RNodeRef& node)
   {
-    node=std::make_shared<RNode>(DBId(position.GetDatabaseId(),routeNode->GetId()),
-                                 routeNode,
-                                 position.GetObjectFileRef());
+    node=rnodeArena.Allocate(DBId(position.GetDatabaseId(),routeNode->GetId()),
+                             routeNode,
+                             position.GetObjectFileRef());
 
     node->currentCost=GetCosts(state,
                                position.GetDatabaseId(),
@@ -566,7 +614,7 @@ namespace osmscout {
       auto twinIt=openMap.find(twin);
 
       if (twinIt!=openMap.end()){
-        RNodeRef rn=(*twinIt->second);
+        RNodeRef rn=twinIt->second;
         if (rn->currentCost > current->currentCost) {
           // this is cheaper path to twin
 
@@ -579,10 +627,7 @@ namespace osmscout {
           rn->overallCost=current->overallCost;
           rn->restricted=current->restricted;
 
-          openList.erase(twinIt->second);
-
-          std::pair<OpenListRef,bool> insertResult=openList.insert(rn);
-          twinIt->second=insertResult.first;
+          openList.Update(rn);
 
           if constexpr (debugRouting) {
             std::cout << "Better transition from " << rn->prev << " to " << rn->id << std::endl;
@@ -594,20 +639,20 @@ namespace osmscout {
         if (!GetRouteNode(twin,node)){
           return false;
         }
-        RNodeRef rn=std::make_shared<RNode>(twin,
-                                            node,
-                                            //node->objects.begin()->object, /*TODO: how to find correct way from other DB?*/
-                                            ObjectFileRef(), // TODO: have to be valid Object here?
-                                            /*prev*/current->id,
-                                            current->restricted);
+        RNodeRef rn=rnodeArena.Allocate(twin,
+                                        node,
+                                        //node->objects.begin()->object, /*TODO: how to find correct way from other DB?*/
+                                        ObjectFileRef(), // TODO: have to be valid Object here?
+                                        /*prev*/current->id,
+                                        current->restricted);
 
         rn->currentCost=current->currentCost;
         rn->estimateCost=current->estimateCost;
         rn->overallCost=current->overallCost;
         rn->restricted=current->restricted;
 
-        std::pair<OpenListRef,bool> insertResult=openList.insert(rn);
-        openMap[rn->id]=insertResult.first;
+        openList.Push(rn);
+        openMap[rn->id]=rn;
 
         if constexpr (debugRouting) {
           std::cout << "Transition from " << rn->prev << " to " << rn->id << std::endl;
@@ -617,21 +662,28 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Expand the given node of the forward search to all route nodes reachable by its
+   * paths. Usability and costs of the paths are taken from the given EdgeCosts, so
+   * the compiler can inline them for compiled profiles.
+   */
   template <class RoutingState>
-  bool AbstractRoutingService<RoutingState>::WalkPaths(const RoutingState &state,
-                                                       RNodeRef &current,
-                                                       RouteNodeRef &currentRouteNode,
-                                                       OpenList &openList,
-                                                       OpenMap &openMap,
-                                                       ClosedSet &closedSet,
-                                                       RoutingResult &result,
-                                                       const RoutingParameter& parameter,
-                                                       const GeoCoord &targetCoord,
-                                                       const Vehicle &vehicle,
-                                                       size_t &nodesIgnoredCount,
-                                                       Distance &currentMaxDistance,
-                                                       const Distance &overallDistance,
-                                                       const double &costLimit)
+  template <class EdgeCosts>
+  bool AbstractRoutingService<RoutingState>::WalkPathsWithCosts(const RoutingState &state,
+                                                                const EdgeCosts& costs,
+                                                                RNodeRef &current,
+                                                                RouteNodeRef &currentRouteNode,
+                                                                OpenList &openList,
+                                                                OpenMap &openMap,
+                                                                ClosedSet &closedSet,
+                                                                RoutingResult &result,
+                                                                const RoutingParameter& parameter,
+                                                                const GeoCoord &targetCoord,
+                                                                const Vehicle &vehicle,
+                                                                size_t &nodesIgnoredCount,
+                                                                Distance &currentMaxDistance,
+                                                                const Distance &overallDistance,
+                                                                const double &costLimit)
   {
     assert(current);
     assert(currentRouteNode=current->node);
@@ -697,10 +749,9 @@ namespace osmscout {
         continue;
       }
 
-      if (!CanUse(state,
-                  dbId,
-                  *currentRouteNode,
-                  /*pathIndex*/ i)) {
+      if (!costs.CanUse(dbId,
+                        *currentRouteNode,
+                        /*pathIndex*/ i)) {
         if constexpr (debugRouting) {
           std::cout << "  Skipping route";
           std::cout << " to " << path.id;
@@ -752,11 +803,10 @@ namespace osmscout {
         }
       }
 
-      double currentCost=current->currentCost+GetCosts(state,
-                                                       dbId,
-                                                       *currentRouteNode,
-                                                       inPathValid ? inPathIndex : i,
-                                                       i);
+      double currentCost=current->currentCost+costs.GetCosts(dbId,
+                                                             *currentRouteNode,
+                                                             inPathValid ? inPathIndex : i,
+                                                             i);
 
       auto openEntry=openMap.find(DBId(current->id.database,
                                        path.id));
@@ -764,13 +814,13 @@ namespace osmscout {
       // Check, if we already have a cheaper path to the new node. If yes, do not put the new path
       // into the open list
       if (openEntry!=openMap.end() &&
-          (*openEntry->second)->currentCost<=currentCost) {
+          openEntry->second->currentCost<=currentCost) {
         if constexpr (debugRouting) {
           std::cout << "  Skipping route";
           std::cout << " to " << dbId << " / " << path.id;
           std::cout << " (" << currentRouteNode->objects[path.objectIndex].object.GetName() << ")";
-          std::cout << " => cheaper route exists " << currentCost << "<=>" << (*openEntry->second)->object.GetName()
-                    << " " << (*openEntry->second)->node->GetId() << " " << (*openEntry->second)->currentCost
+          std::cout << " => cheaper route exists " << currentCost << "<=>" << openEntry->second->object.GetName()
+                    << " " << openEntry->second->node->GetId() << " " << openEntry->second->currentCost
                     << std::endl;
         }
         i++;
@@ -781,7 +831,7 @@ namespace osmscout {
       RouteNodeRef nextNode;
 
       if (openEntry!=openMap.end()) {
-        nextNode=(*openEntry->second)->node;
+        nextNode=openEntry->second->node;
       }
       else if (!GetRouteNode(DBId(current->id.database,
                                   path.id),
@@ -822,7 +872,7 @@ namespace osmscout {
       // If we already have the node in the open list, but the new path is cheaper (as tested above),
       // update the existing entry
       if (openEntry!=openMap.end()) {
-        RNodeRef node=*openEntry->second;
+        RNodeRef node=openEntry->second;
 
         node->prev=current->id;
         node->prevRestricted=current->restricted;
@@ -844,17 +894,14 @@ namespace osmscout {
                     << " " << currentRouteNode->GetId() << std::endl;
         }
 
-        openList.erase(openEntry->second);
-
-        std::pair<OpenListRef,bool> insertResult=openList.insert(node);
-        openEntry->second=insertResult.first;
+        openList.Update(node);
       }
       else {
-        RNodeRef node=std::make_shared<RNode>(DBId(dbId,path.id),
-                                              nextNode,
-                                              currentRouteNode->objects[path.objectIndex].object,
-                                              current->id,
-                                              current->restricted);
+        RNodeRef node=rnodeArena.Allocate(DBId(dbId,path.id),
+                                          nextNode,
+                                          currentRouteNode->objects[path.objectIndex].object,
+                                          current->id,
+                                          current->restricted);
 
         node->currentCost=currentCost;
         node->estimateCost=estimateCost;
@@ -873,8 +920,8 @@ namespace osmscout {
                     << currentRouteNode->GetId() << std::endl;
         }
 
-        std::pair<OpenListRef,bool> insertResult=openList.insert(node);
-        openMap[node->id]=insertResult.first;
+        openList.Push(node);
+        openMap[node->id]=node;
       }
 
       i++;
@@ -883,6 +930,57 @@ namespace osmscout {
     return true;
   }
 
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::WalkPaths(const RoutingState &state,
+                                                       RNodeRef &current,
+                                                       RouteNodeRef &currentRouteNode,
+                                                       OpenList &openList,
+                                                       OpenMap &openMap,
+                                                       ClosedSet &closedSet,
+                                                       RoutingResult &result,
+                                                       const RoutingParameter& parameter,
+                                                       const GeoCoord &targetCoord,
+                                                       const Vehicle &vehicle,
+                                                       size_t &nodesIgnoredCount,
+                                                       Distance &currentMaxDistance,
+                                                       const Distance &overallDistance,
+                                                       const double &costLimit)
+  {
+    if (hasCompiledProfile) {
+      return WalkPathsWithCosts(state,
+                                CompiledEdgeCosts(compiledProfile),
+                                current,
+                                currentRouteNode,
+                                openList,
+                                openMap,
+                                closedSet,
+                                result,
+                                parameter,
+                                targetCoord,
+                                vehicle,
+                                nodesIgnoredCount,
+                                currentMaxDistance,
+                                overallDistance,
+                                costLimit);
+    }
+
+    return WalkPathsWithCosts(state,
+                              ServiceEdgeCosts(*this,state),
+                              current,
+                              currentRouteNode,
+                              openList,
+                              openMap,
+                              closedSet,
+                              result,
+                              parameter,
+                              targetCoord,
+                              vehicle,
+                              nodesIgnoredCount,
+                              currentMaxDistance,
+                              overallDistance,
+                              costLimit);
+  }
+
   template <class RoutingState>
   bool AbstractRoutingService<RoutingState>::RestrictInitialUTurn(const RoutingState& state,
                                                                   const Bearing& bearing,
@@ -971,117 +1069,1841 @@ namespace osmscout {
   }
 
   /**
-   * Calculate a route
+   * Collect all paths of other route nodes leading to the given route node.
    *
-   * @param state
-   *    State to use
-   * @param start
-   *    Start of the route
-   * @param target
-   *    Target of teh route
-   * @param bearing
-   *    Initial vehicle bearing, route will start by the way in specified direction. When possible.
-   * @param progress
-   *    Optional callback for handling routing progress
-   * @param route
-   *    The route object holding the resulting route on success
-   * @return
-   *    True, if the engine was able to find a route, else false
+   * The route node itself only stores its outgoing paths. The candidates
+   * are the neighbouring route nodes on all objects passing the node (as
+   * stored in the junction data, so that ways only usable towards the node are
+   * included, too), of which the paths leading back to the node are taken.
+   *
+   * Finding the candidates requires reading the junction, the ways and the
+   * neighbouring route nodes, so the result is cached per route node in the
+   * routing database for following backward searches. The cache holds route
+   * node ids only, the route nodes themselves are resolved on every call.
    */
   template <class RoutingState>
-  RoutingResult AbstractRoutingService<RoutingState>::CalculateRoute(RoutingState& state,
-                                                                     const RoutePosition& start,
-                                                                     const RoutePosition& target,
-                                                                     const std::optional<osmscout::Bearing> &bearing,
-                                                                     const RoutingParameter& parameter)
+  bool AbstractRoutingService<RoutingState>::GetIncomingPaths(const DBId& id,
+                                                              const RouteNode& routeNode,
+                                                              std::vector<IncomingPath>& incomingPaths)
   {
-    RoutingResult            result;
-    Vehicle                  vehicle=GetVehicle(state);
-    RouteNodeRef             startForwardRouteNode;
-    RouteNodeRef             startBackwardRouteNode;
-    RNodeRef                 startForwardNode;
-    RNodeRef                 startBackwardNode;
+    std::vector<RoutingDatabase::IncomingPath> cachedPaths;
 
-    GeoCoord                 startCoord;
-    GeoCoord                 targetCoord;
+    incomingPaths.clear();
 
-    RouteNodeRef             targetForwardRouteNode;
-    RouteNodeRef             targetBackwardRouteNode;
+    if (GetCachedIncomingPaths(id,cachedPaths)) {
+      incomingPaths.reserve(cachedPaths.size());
 
-    // Sorted list (smallest cost first) of ways to check (we are using a std::set)
-    OpenList                 openList;
-    // Map routing nodes by id
-    OpenMap                  openMap;
+      for (const auto& cachedPath : cachedPaths) {
+        RouteNodeRef node;
 
-    ClosedSet                closedSet;
+        if (!GetRouteNode(DBId(id.database,cachedPath.node),node) ||
+            !node) {
+          return false;
+        }
 
-    size_t                   nodesLoadedCount=0;
-    size_t                   nodesIgnoredCount=0;
-    size_t                   maxOpenList=0;
-    size_t                   maxClosedSet=0;
+        incomingPaths.push_back(IncomingPath{node,cachedPath.pathIndex});
+      }
 
-    openMap.reserve(10000);
-    closedSet.reserve(300000);
+      return true;
+    }
 
-    if (!GetTargetNodes(state,
-                        target,
-                        targetCoord,
-                        targetForwardRouteNode,
-                        targetBackwardRouteNode)) {
-      return result;
+    std::vector<ObjectFileRef> objects;
+
+    if (!GetJunctionObjects(id,objects)) {
+      return false;
     }
 
-    if (!GetStartNodes(state,
-                       start,
-                       startCoord,
-                       targetCoord,
-                       startForwardRouteNode,
-                       startBackwardRouteNode,
-                       startForwardNode,
-                       startBackwardNode)) {
-      return result;
+    for (const auto& object : routeNode.objects) {
+      objects.push_back(object.object);
     }
 
-    if constexpr (debugRouting) {
-      if (startForwardNode) {
-        std::cout << "StartForwardNode:   " << start.GetObjectFileRef().GetName() << " " << startForwardRouteNode->GetId() << " "
-                  << startForwardNode->currentCost << " " << startForwardNode->estimateCost << " " << startForwardNode->overallCost
-                  << std::endl;
-      }
-      if (startBackwardNode) {
-        std::cout << "StartBackwardNode:  " << start.GetObjectFileRef().GetName() << " " << startBackwardRouteNode->GetId() << " "
-                  << startBackwardNode->currentCost << " " << startBackwardNode->estimateCost << " " << startBackwardNode->overallCost
-                  << std::endl;
+    std::sort(objects.begin(),objects.end());
+    objects.erase(std::unique(objects.begin(),objects.end()),objects.end());
+
+    std::vector<RouteNodeRef> candidates;
+
+    for (const auto& object : objects) {
+      candidates.clear();
+
+      if (object.GetType()==refWay) {
+        WayRef way;
+
+        if (!GetWayByOffset(DBFileOffset(id.database,object.GetFileOffset()),way)) {
+          return false;
+        }
+
+        bool   circular=way->IsCircular();
+        size_t count=circular ? way->nodes.size()-1 : way->nodes.size();
+
+        for (size_t index=0; index<count; index++) {
+          if (way->GetId(index)!=id.id) {
+            continue;
+          }
+
+          // Next route node before and after the node on the way
+          for (bool forward : {false,true}) {
+            size_t current=index;
+
+            while (true) {
+              if (forward) {
+                current++;
+
+                if (current>=count) {
+                  if (!circular) {
+                    break;
+                  }
+
+                  current=0;
+                }
+              }
+              else {
+                if (current==0) {
+                  if (!circular) {
+                    break;
+                  }
+
+                  current=count;
+                }
+
+                current--;
+              }
+
+              if (current==index) {
+                break;
+              }
+
+              RouteNodeRef node;
+
+              if (way->GetId(current)!=0 &&
+                  GetRouteNode(DBId(id.database,way->GetId(current)),node) &&
+                  node) {
+                candidates.push_back(node);
+                break;
+              }
+            }
+          }
+        }
       }
-      if (targetForwardRouteNode) {
-        std::cout << "TargetForwardNode:  " << target.GetObjectFileRef().GetName() << " " << targetForwardRouteNode->GetId() << std::endl;
+      else {
+        for (const auto& path : routeNode.paths) {
+          RouteNodeRef node;
+
+          if (routeNode.objects[path.objectIndex].object==object &&
+              GetRouteNode(DBId(id.database,path.id),node) &&
+              node) {
+            candidates.push_back(node);
+          }
+        }
       }
-      if (targetBackwardRouteNode) {
-        std::cout << "TargetBackwardNode: " << target.GetObjectFileRef().GetName() << " " << targetBackwardRouteNode->GetId() << std::endl;
+
+      for (const auto& node : candidates) {
+        for (size_t pathIndex=0; pathIndex<node->paths.size(); pathIndex++) {
+          const RouteNode::Path& path=node->paths[pathIndex];
+
+          if (path.id!=id.id ||
+              node->objects[path.objectIndex].object!=object) {
+            continue;
+          }
+
+          bool known=std::any_of(incomingPaths.begin(),
+                                 incomingPaths.end(),
+                                 [&node,pathIndex](const IncomingPath& incomingPath) {
+                                   return incomingPath.node->GetId()==node->GetId() &&
+                                          incomingPath.pathIndex==pathIndex;
+                                 });
+
+          if (!known) {
+            incomingPaths.push_back(IncomingPath{node,pathIndex});
+            cachedPaths.push_back(RoutingDatabase::IncomingPath{node->GetId(),
+                                                                static_cast<uint32_t>(pathIndex)});
+          }
+        }
       }
     }
 
-    if (parameter.GetBreaker() &&
-        parameter.GetBreaker()->IsAborted()) {
-      return result;
+    CacheIncomingPaths(id,cachedPaths);
+
+    return true;
+  }
+
+  /**
+   * Return false, if the turn from the in object to the out object at the given
+   * route node is forbidden by a turn restriction
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::IsTurnAllowed(const RouteNode& routeNode,
+                                                           const ObjectFileRef& inObject,
+                                                           const ObjectFileRef& outObject) const
+  {
+    return std::none_of(routeNode.excludes.begin(),
+                        routeNode.excludes.end(),
+                        [&routeNode,&inObject,&outObject](const RouteNode::Exclude& exclude) {
+                          return exclude.source==inObject &&
+                                 routeNode.objects[routeNode.paths[exclude.targetIndex].objectIndex].object==outObject;
+                        });
+  }
+
+  /**
+   * Return the additional costs of passing the given route node from the previous
+   * node to the next node compared to the plain costs of the outgoing path. This is the
+   * part of the path costs the forward search adds for the junction.
+   */
+  template <class RoutingState>
+  template <class EdgeCosts>
+  double AbstractRoutingService<RoutingState>::GetTurnCosts(const EdgeCosts& costs,
+                                                            DatabaseId database,
+                                                            const RouteNode& routeNode,
+                                                            const DBId& prev,
+                                                            const ObjectFileRef& inObject,
+                                                            const DBId& next,
+                                                            const ObjectFileRef& outObject)
+  {
+    if (!prev.IsValid() ||
+        !next.IsValid()) {
+      return 0.0;
     }
 
-    if (bearing) {
-      if (!RestrictInitialUTurn(state, *bearing, start, startForwardNode, startBackwardNode)) {
-        return result;
+    size_t inPathIndex=routeNode.paths.size();
+    size_t outPathIndex=routeNode.paths.size();
+
+    for (size_t i=0; i<routeNode.paths.size(); i++) {
+      const RouteNode::Path&  path=routeNode.paths[i];
+      const ObjectFileRef    &object=routeNode.objects[path.objectIndex].object;
+
+      if (inPathIndex==routeNode.paths.size() &&
+          path.id==prev.id &&
+          object==inObject) {
+        inPathIndex=i;
+      }
+
+      if (outPathIndex==routeNode.paths.size() &&
+          path.id==next.id &&
+          object==outObject) {
+        outPathIndex=i;
       }
     }
 
-    if (startForwardNode) {
-      std::pair<OpenListRef,bool> insertResult=openList.insert(startForwardNode);
+    // in case of roundabout, node don't contain path back
+    if (inPathIndex==routeNode.paths.size() ||
+        outPathIndex==routeNode.paths.size()) {
+      return 0.0;
+    }
+
+    return costs.GetCosts(database,routeNode,inPathIndex,outPathIndex)-
+           costs.GetCosts(database,routeNode,outPathIndex,outPathIndex);
+  }
+
+  /**
+   * Return the estimated costs of a node for the bidirectional search. To
+   * keep the estimates of both directions consistent with each other, the
+   * average of the estimated costs to the goal of the search and from its
+   * origin is used ("balanced potentials").
+   */
+  template <class RoutingState>
+  double AbstractRoutingService<RoutingState>::GetBalancedEstimateCosts(const RoutingState& state,
+                                                                        DatabaseId database,
+                                                                        const GeoCoord& coord,
+                                                                        const GeoCoord& originCoord,
+                                                                        const GeoCoord& goalCoord)
+  {
+    return (GetEstimateCosts(state,database,GetSphericalDistance(coord,goalCoord))-
+            GetEstimateCosts(state,database,GetSphericalDistance(coord,originCoord)))/2.0;
+  }
 
-      openMap[startForwardNode->id]=insertResult.first;
+  /**
+   * Expand the given label of the backward search of the bidirectional search
+   * to all route nodes with a path leading to it.
+   *
+   * The backward label of a node holds the costs from the node to the target
+   * (including the costs of the junctions passed, but excluding the costs of
+   * the junction at the node itself), prev is the next route node towards the
+   * target and object the object used to get there.
+   */
+  template <class RoutingState>
+  template <class EdgeCosts>
+  bool AbstractRoutingService<RoutingState>::WalkPathsBackwardWithCosts(const RoutingState& state,
+                                                                        const EdgeCosts& costs,
+                                                                        const RNodeRef& current,
+                                                                        OpenList& openList,
+                                                                        OpenMap& openMap,
+                                                                        const std::unordered_map<DBId,RNodeRef>& settled,
+                                                                        const GeoCoord& startCoord,
+                                                                        const GeoCoord& targetCoord,
+                                                                        const Vehicle& vehicle,
+                                                                        size_t& nodesIgnoredCount,
+                                                                        double costLimit)
+  {
+    DatabaseId                dbId=current->id.database;
+    const RouteNode&          routeNode=*current->node;
+    std::vector<IncomingPath> incomingPaths;
+
+    if (!GetIncomingPaths(current->id,
+                          routeNode,
+                          incomingPaths)) {
+      return false;
     }
 
-    if (startBackwardNode) {
-      std::pair<OpenListRef,bool> insertResult=openList.insert(startBackwardNode);
+    for (const auto& incomingPath : incomingPaths) {
+      const RouteNode&       prevNode=*incomingPath.node;
+      const RouteNode::Path& path=prevNode.paths[incomingPath.pathIndex];
+      const ObjectFileRef&   object=prevNode.objects[path.objectIndex].object;
+      DBId                   prevId(dbId,prevNode.GetId());
+
+      if (prevId==current->prev) {
+        // back to the last node visited
+        nodesIgnoredCount++;
+        continue;
+      }
+
+      if (!current->restricted &&
+          path.IsRestricted(vehicle)) {
+        // moving from non-accessible way to accessible way
+        nodesIgnoredCount++;
+        continue;
+      }
+
+      if (!costs.CanUse(dbId,
+                        prevNode,
+                        incomingPath.pathIndex)) {
+        nodesIgnoredCount++;
+        continue;
+      }
+
+      if (settled.contains(prevId)) {
+        continue;
+      }
+
+      if (current->prev.IsValid() &&
+          !IsTurnAllowed(routeNode,object,current->object)) {
+        nodesIgnoredCount++;
+        continue;
+      }
+
+      double currentCost=current->currentCost+
+                         costs.GetCosts(dbId,
+                                        prevNode,
+                                        incomingPath.pathIndex,
+                                        incomingPath.pathIndex)+
+                         GetTurnCosts(costs,
+                                      dbId,
+                                      routeNode,
+                                      prevId,
+                                      object,
+                                      current->prev,
+                                      current->object);
+
+      auto openEntry=openMap.find(prevId);
+
+      // Check, if we already have a cheaper path from the node
+      if (openEntry!=openMap.end() &&
+          openEntry->second->currentCost<=currentCost) {
+        continue;
+      }
+
+      if (currentCost+GetEstimateCosts(state,
+                                       dbId,
+                                       GetSphericalDistance(prevNode.GetCoord(),
+                                                            startCoord))>costLimit) {
+        nodesIgnoredCount++;
+        continue;
+      }
+
+      double estimateCost=GetBalancedEstimateCosts(state,
+                                                   dbId,
+                                                   prevNode.GetCoord(),
+                                                   targetCoord,
+                                                   startCoord);
+
+      RNodeRef node;
+
+      if (openEntry!=openMap.end()) {
+        node=openEntry->second;
+
+        node->prev=current->id;
+        node->prevRestricted=current->restricted;
+        node->object=object;
+      }
+      else {
+        node=rnodeArena.Allocate(prevId,
+                                 incomingPath.node,
+                                 object,
+                                 current->id,
+                                 current->restricted);
+      }
+
+      node->currentCost=currentCost;
+      node->estimateCost=estimateCost;
+      node->overallCost=currentCost+estimateCost;
+      // restricted, if the rest of the route up to the target is restricted
+      node->restricted=current->restricted &&
+                       path.IsRestricted(vehicle);
 
-      openMap[startBackwardNode->id]=insertResult.first;
+      if (openList.Contains(node)) {
+        openList.Update(node);
+      }
+      else {
+        openList.Push(node);
+        openMap[prevId]=node;
+      }
+    }
+
+    return true;
+  }
+
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::WalkPathsBackward(const RoutingState& state,
+                                                               const RNodeRef& current,
+                                                               OpenList& openList,
+                                                               OpenMap& openMap,
+                                                               const std::unordered_map<DBId,RNodeRef>& settled,
+                                                               const GeoCoord& startCoord,
+                                                               const GeoCoord& targetCoord,
+                                                               const Vehicle& vehicle,
+                                                               size_t& nodesIgnoredCount,
+                                                               double costLimit)
+  {
+    if (hasCompiledProfile) {
+      return WalkPathsBackwardWithCosts(state,
+                                        CompiledEdgeCosts(compiledProfile),
+                                        current,
+                                        openList,
+                                        openMap,
+                                        settled,
+                                        startCoord,
+                                        targetCoord,
+                                        vehicle,
+                                        nodesIgnoredCount,
+                                        costLimit);
+    }
+
+    return WalkPathsBackwardWithCosts(state,
+                                      ServiceEdgeCosts(*this,state),
+                                      current,
+                                      openList,
+                                      openMap,
+                                      settled,
+                                      startCoord,
+                                      targetCoord,
+                                      vehicle,
+                                      nodesIgnoredCount,
+                                      costLimit);
+  }
+
+  /**
+   * Return the costs of the route via the node where the given forward and backward
+   * label meet or std::numeric_limits<double>::max(), if the labels cannot be joined
+   */
+  template <class RoutingState>
+  double AbstractRoutingService<RoutingState>::GetMeetingCosts(const RoutingState& state,
+                                                               const RNode& forward,
+                                                               const RNode& backward)
+  {
+    double cost=forward.currentCost+backward.currentCost;
+
+    if (backward.prev.IsValid()) {
+      const RouteNode& routeNode=forward.node ? *forward.node : *backward.node;
+
+      if (forward.prev==backward.prev) {
+        // u-turn at the meeting node
+        return std::numeric_limits<double>::max();
+      }
+
+      if (forward.restricted &&
+          !forward.leaveRestricted &&
+          !backward.restricted) {
+        // moving from non-accessible way back to accessible way
+        return std::numeric_limits<double>::max();
+      }
+
+      if (forward.prev.IsValid() &&
+          !IsTurnAllowed(routeNode,forward.object,backward.object)) {
+        return std::numeric_limits<double>::max();
+      }
+
+      cost+=GetTurnCosts(ServiceEdgeCosts(*this,state),
+                         forward.id.database,
+                         routeNode,
+                         forward.prev,
+                         forward.object,
+                         backward.prev,
+                         backward.object);
+    }
+
+    return cost;
+  }
+
+  /**
+   * Check the route via the node where the given forward and backward label meet and
+   * remember it, if it is the cheapest one found so far
+   */
+  template <class RoutingState>
+  void AbstractRoutingService<RoutingState>::UpdateMeeting(const RoutingState& state,
+                                                           const RNode& forward,
+                                                           const RNode& backward,
+                                                           Meeting& meeting)
+  {
+    double cost=GetMeetingCosts(state,
+                                forward,
+                                backward);
+
+    if (cost<meeting.cost) {
+      meeting.cost=cost;
+      meeting.forward=forward;
+      meeting.backward=backward;
+    }
+  }
+
+  /**
+   * Resolve start and target and fill the open lists of both directions of the
+   * bidirectional search
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::InitializeBidirectionalSearch(RoutingState& state,
+                                                                           const RoutePosition& start,
+                                                                           const RoutePosition& target,
+                                                                           BidirectionalSearch& search)
+  {
+    RouteNodeRef startForwardRouteNode;
+    RouteNodeRef startBackwardRouteNode;
+    RNodeRef     startForwardNode=nullptr;
+    RNodeRef     startBackwardNode=nullptr;
+
+    RouteNodeRef targetForwardRouteNode;
+    RouteNodeRef targetBackwardRouteNode;
+
+    search.vehicle=GetVehicle(state);
+
+    // Release the RNodes of the previous route calculation
+    rnodeArena.Clear();
+    hasCompiledProfile=CompileProfile(state,
+                                      start.GetDatabaseId(),
+                                      compiledProfile);
+
+    if (!GetTargetNodes(state,
+                        target,
+                        search.targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return false;
+    }
+
+    if (!GetStartNodes(state,
+                       start,
+                       search.startCoord,
+                       search.targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return false;
+    }
+
+    for (const auto& node : {startForwardNode,startBackwardNode}) {
+      if (node) {
+        node->estimateCost=GetBalancedEstimateCosts(state,
+                                                    node->id.database,
+                                                    node->node->GetCoord(),
+                                                    search.startCoord,
+                                                    search.targetCoord);
+        node->overallCost=node->currentCost+node->estimateCost;
+
+        search.forwardOpenList.Push(node);
+        search.forwardOpenMap[node->id]=node;
+      }
+    }
+
+    for (const auto& routeNode : {targetForwardRouteNode,targetBackwardRouteNode}) {
+      if (!routeNode) {
+        continue;
+      }
+
+      DBId id(target.GetDatabaseId(),routeNode->GetId());
+
+      if (search.backwardOpenMap.contains(id)) {
+        continue;
+      }
+
+      RNodeRef node=rnodeArena.Allocate(id,
+                                        routeNode,
+                                        target.GetObjectFileRef());
+
+      node->estimateCost=GetBalancedEstimateCosts(state,
+                                                  id.database,
+                                                  routeNode->GetCoord(),
+                                                  search.targetCoord,
+                                                  search.startCoord);
+      node->overallCost=node->estimateCost;
+
+      search.backwardOpenList.Push(node);
+      search.backwardOpenMap[id]=node;
+    }
+
+    search.overallDistance=GetSphericalDistance(search.startCoord,
+                                                search.targetCoord);
+    search.costLimit=GetCostLimit(state,start.GetDatabaseId(),search.overallDistance);
+
+    return true;
+  }
+
+  /**
+   * Continue the bidirectional search until the sum of the minimal costs of both
+   * open lists reaches the given factor of the costs of the best route found.
+   * A factor of 1 stops as soon as the best route is known, larger factors
+   * additionally settle the route nodes of all routes up to the given costs.
+   *
+   * Returns false on errors or if the search was aborted.
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::ContinueBidirectionalSearch(const RoutingState& state,
+                                                                         const RoutingParameter& parameter,
+                                                                         double costFactor,
+                                                                         BidirectionalSearch& search,
+                                                                         RoutingResult& result)
+  {
+    while (!search.forwardOpenList.IsEmpty() &&
+           !search.backwardOpenList.IsEmpty()) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return false;
+      }
+
+      if (search.forwardOpenList.Top()->overallCost+
+          search.backwardOpenList.Top()->overallCost>=costFactor*search.meeting.cost) {
+        break;
+      }
+
+      if (search.forwardOpenList.GetSize()<=search.backwardOpenList.GetSize()) {
+        RNodeRef     current=search.forwardOpenList.Pop();
+        RouteNodeRef currentRouteNode=current->node;
+
+        search.forwardOpenMap.erase(current->id);
+
+        search.forwardNodesLoadedCount++;
+
+        if (!WalkPaths(state,
+                       current,
+                       currentRouteNode,
+                       search.forwardOpenList,
+                       search.forwardOpenMap,
+                       search.forwardClosedSet,
+                       result,
+                       parameter,
+                       search.targetCoord,
+                       search.vehicle,
+                       search.nodesIgnoredCount,
+                       search.currentMaxDistance,
+                       search.overallDistance,
+                       search.costLimit)) {
+          log.Error() << "Failed to walk paths from " << current->id.database << " / " << current->id.id;
+          return false;
+        }
+
+        // WalkPaths() estimates the costs to the target only, replace them by the
+        // estimate balanced with the backward search
+        for (const auto& path : currentRouteNode->paths) {
+          auto openEntry=search.forwardOpenMap.find(DBId(current->id.database,path.id));
+
+          if (openEntry==search.forwardOpenMap.end() ||
+              openEntry->second->prev!=current->id) {
+            continue;
+          }
+
+          RNodeRef node=openEntry->second;
+
+          node->estimateCost=GetBalancedEstimateCosts(state,
+                                                      node->id.database,
+                                                      node->node->GetCoord(),
+                                                      search.startCoord,
+                                                      search.targetCoord);
+          node->overallCost=node->currentCost+node->estimateCost;
+
+          search.forwardOpenList.Update(node);
+        }
+
+        search.forwardClosedSet.insert(VNode(current->id,
+                                             current->restricted,
+                                             current->object,
+                                             current->prev,
+                                             current->prevRestricted));
+        search.forwardSettled.try_emplace(current->id,current);
+
+        if (auto openEntry=search.backwardOpenMap.find(current->id);
+            openEntry!=search.backwardOpenMap.end()) {
+          UpdateMeeting(state,*current,*openEntry->second,search.meeting);
+        }
+        else if (auto settledEntry=search.backwardSettled.find(current->id);
+                 settledEntry!=search.backwardSettled.end()) {
+          UpdateMeeting(state,*current,*settledEntry->second,search.meeting);
+        }
+      }
+      else {
+        RNodeRef current=search.backwardOpenList.Pop();
+
+        search.backwardOpenMap.erase(current->id);
+
+        search.backwardNodesLoadedCount++;
+
+        search.backwardSettled[current->id]=current;
+
+        if (!WalkPathsBackward(state,
+                               current,
+                               search.backwardOpenList,
+                               search.backwardOpenMap,
+                               search.backwardSettled,
+                               search.startCoord,
+                               search.targetCoord,
+                               search.vehicle,
+                               search.nodesIgnoredCount,
+                               search.costLimit)) {
+          log.Error() << "Failed to walk paths backward from " << current->id.database << " / " << current->id.id;
+          return false;
+        }
+
+        if (auto openEntry=search.forwardOpenMap.find(current->id);
+            openEntry!=search.forwardOpenMap.end()) {
+          UpdateMeeting(state,*openEntry->second,*current,search.meeting);
+        }
+        else if (auto settledEntry=search.forwardSettled.find(current->id);
+                 settledEntry!=search.forwardSettled.end()) {
+          UpdateMeeting(state,*settledEntry->second,*current,search.meeting);
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Resolve the route from the start via the node, where the given forward and
+   * backward label meet, to the target
+   */
+  template <class RoutingState>
+  void AbstractRoutingService<RoutingState>::ResolveMeetingToList(const ClosedSet& forwardClosedSet,
+                                                                  const std::unordered_map<DBId,RNodeRef>& backwardSettled,
+                                                                  const RNode& forward,
+                                                                  const RNode& backward,
+                                                                  std::list<VNode>& nodes)
+  {
+    //
+    // Forward part of the route up to the meeting node
+    //
+
+    if (forward.prev.IsValid()) {
+      RNode prev;
+
+      prev.id=forward.prev;
+      prev.restricted=forward.prevRestricted;
+
+      ResolveRNodeChainToList(prev,
+                              forwardClosedSet,
+                              nodes);
+    }
+
+    nodes.emplace_back(forward.id,
+                       forward.restricted,
+                       forward.object,
+                       forward.prev,
+                       forward.prevRestricted);
+
+    //
+    // Backward part of the route from the meeting node to the target
+    //
+
+    const RNode* current=&backward;
+
+    while (current->prev.IsValid()) {
+      auto next=backwardSettled.find(current->prev);
+
+      assert(next!=backwardSettled.end());
+
+      nodes.emplace_back(current->prev,
+                         next->second->restricted,
+                         current->object,
+                         current->id,
+                         current->restricted);
+
+      current=next->second;
+    }
+  }
+
+  /**
+   * Calculate a route using a bidirectional A* search, expanding from the
+   * start (following the paths of the route nodes) and from the target (following
+   * the paths in reverse) at the same time.
+   *
+   * Both directions use the balanced estimate of GetBalancedEstimateCosts(),
+   * so the search can stop as soon as the sum of the minimal costs of both open
+   * lists is not smaller than the costs of the best route found via a node settled
+   * by one direction and labeled by the other direction.
+   *
+   * Returns an empty result, if no route was found.
+   */
+  template <class RoutingState>
+  RoutingResult AbstractRoutingService<RoutingState>::CalculateRouteBidirectional(RoutingState& state,
+                                                                                  const RoutePosition& start,
+                                                                                  const RoutePosition& target,
+                                                                                  const RoutingParameter& parameter)
+  {
+    RoutingResult       result;
+    BidirectionalSearch search;
+
+    if (!InitializeBidirectionalSearch(state,
+                                       start,
+                                       target,
+                                       search)) {
+      return result;
+    }
+
+    result.SetOverallDistance(search.overallDistance);
+
+    StopClock clock;
+
+    if (!ContinueBidirectionalSearch(state,
+                                     parameter,
+                                     1.0,
+                                     search,
+                                     result)) {
+      return result;
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      Distance overallDistance=search.overallDistance;
+
+      std::cout << "Bidirectional search" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Air-line distance:   " << std::fixed << std::setprecision(1) << overallDistance.As<Kilometer>() << " km" << std::endl;
+      if (search.meeting.IsValid()) {
+        std::cout << "Actual cost:         " << GetCostString(state, start.GetDatabaseId(), search.meeting.cost) << std::endl;
+      }
+      std::cout << "Cost limit:          " << GetCostString(state, start.GetDatabaseId(), search.costLimit) << std::endl;
+      std::cout << "Route nodes loaded:  " << search.forwardNodesLoadedCount << " forward, " << search.backwardNodesLoadedCount << " backward" << std::endl;
+      std::cout << "Route nodes ignored: " << search.nodesIgnoredCount << std::endl;
+    }
+
+    if (!search.meeting.IsValid()) {
+      return result;
+    }
+
+    std::list<VNode> nodes;
+
+    ResolveMeetingToList(search.forwardClosedSet,
+                         search.backwardSettled,
+                         search.meeting.forward,
+                         search.meeting.backward,
+                         nodes);
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    if (!ResolveRNodesToRouteData(state,
+                                  nodes,
+                                  start,
+                                  target,
+                                  result.GetRoute())) {
+      return result;
+    }
+
+    ResolveRouteDataJunctions(result.GetRoute());
+
+    return result;
+  }
+
+  /**
+   * Return the length of the path of the given route node to the given route node
+   * along the given object
+   */
+  static Distance GetPathDistance(const RouteNode& routeNode,
+                                  Id target,
+                                  const ObjectFileRef& object)
+  {
+    for (const auto& path : routeNode.paths) {
+      if (path.id==target &&
+          routeNode.objects[path.objectIndex].object==object) {
+        return path.distance;
+      }
+    }
+
+    return Distance::Zero();
+  }
+
+  /**
+   * Resolve the route of the given via candidate and check, if it is an
+   * admissible alternative route:
+   * - it does not visit a route node twice
+   * - it does not share more than the allowed fraction of its length with the best route
+   * - its plateau, the part of the route around the via node that is the cheapest
+   *   route from the start (forward search) as well as to the target (backward search),
+   *   has at least the given minimum costs. Routes with a short plateau take a
+   *   needless detour to pass the via node.
+   *
+   * Only reads the state of the finished search, so candidates can be evaluated
+   * concurrently.
+   */
+  template <class RoutingState>
+  void AbstractRoutingService<RoutingState>::EvaluateViaCandidate(const BidirectionalSearch& search,
+                                                                  const std::unordered_map<Id,Id>& bestRoute,
+                                                                  const RoutingParameter& parameter,
+                                                                  ViaCandidate& candidate) const
+  {
+    std::vector<DBId>     nodes;
+    std::vector<Distance> distances; // distance from nodes[i] to nodes[i+1]
+
+    //
+    // Forward part of the route, from the via node back to the start
+    //
+
+    DBId          id=candidate.forward->id;
+    DBId          prev=candidate.forward->prev;
+    bool          prevRestricted=candidate.forward->prevRestricted;
+    ObjectFileRef object=candidate.forward->object;
+
+    nodes.push_back(id);
+
+    while (prev.IsValid()) {
+      auto prevNode=search.forwardSettled.find(prev);
+      auto prevEntry=search.forwardClosedSet.find(VNode(prev,prevRestricted));
+
+      if (prevNode==search.forwardSettled.end() ||
+          prevEntry==search.forwardClosedSet.end()) {
+        return;
+      }
+
+      distances.push_back(GetPathDistance(*prevNode->second->node,
+                                          id.id,
+                                          object));
+      nodes.push_back(prev);
+
+      id=prev;
+      prev=prevEntry->previousNode;
+      prevRestricted=prevEntry->previousRestricted;
+      object=prevEntry->object;
+    }
+
+    std::reverse(nodes.begin(),nodes.end());
+    std::reverse(distances.begin(),distances.end());
+
+    size_t via=nodes.size()-1;
+
+    //
+    // Backward part of the route, from the via node to the target
+    //
+
+    const RNode* current=candidate.backward;
+
+    while (current->prev.IsValid()) {
+      auto next=search.backwardSettled.find(current->prev);
+
+      if (next==search.backwardSettled.end()) {
+        return;
+      }
+
+      distances.push_back(GetPathDistance(*current->node,
+                                          current->prev.id,
+                                          current->object));
+      nodes.push_back(current->prev);
+
+      current=next->second;
+    }
+
+    std::unordered_set<Id> visited;
+
+    for (const auto& node : nodes) {
+      if (!visited.insert(node.id).second) {
+        return;
+      }
+    }
+
+    Distance distance;
+    Distance sharing;
+
+    for (size_t i=0; i<distances.size(); i++) {
+      distance+=distances[i];
+
+      if (auto entry=bestRoute.find(nodes[i].id);
+          entry!=bestRoute.end() &&
+          entry->second==nodes[i+1].id) {
+        sharing+=distances[i];
+      }
+    }
+
+    if (sharing>distance*parameter.GetMaxSharing()) {
+      return;
+    }
+
+    size_t first=via;
+
+    while (first>0) {
+      auto entry=search.backwardSettled.find(nodes[first-1]);
+
+      if (entry==search.backwardSettled.end() ||
+          entry->second->prev!=nodes[first]) {
+        break;
+      }
+
+      first--;
+    }
+
+    size_t last=via;
+
+    while (last+1<nodes.size()) {
+      auto entry=search.forwardSettled.find(nodes[last+1]);
+
+      if (entry==search.forwardSettled.end() ||
+          entry->second->prev!=nodes[last]) {
+        break;
+      }
+
+      last++;
+    }
+
+    double plateau=search.forwardSettled.at(nodes[last])->currentCost-
+                   search.forwardSettled.at(nodes[first])->currentCost;
+
+    if (plateau<search.meeting.cost*parameter.GetMinPlateau()) {
+      return;
+    }
+
+    candidate.admissible=true;
+    candidate.distance=distance;
+    candidate.sharing=sharing;
+    candidate.nodes=std::move(nodes);
+    candidate.distances=std::move(distances);
+  }
+
+  /**
+   * Calculate the best route and up to RoutingParameter::GetAlternativeCount()
+   * alternative routes using the via node ("plateau") method.
+   *
+   * After the bidirectional search found the best route, both directions are
+   * continued until all route nodes of routes within the allowed stretch (see
+   * RoutingParameter::SetMaxStretch()) are settled. Each node settled by both
+   * directions defines a candidate route via that node. The candidates
+   * are evaluated concurrently by a number of worker threads (see
+   * RoutingParameter::SetThreadCount() and EvaluateViaCandidate()), the admissible
+   * ones are taken by increasing costs, skipping candidates sharing more than the
+   * allowed fraction of their length with an alternative route taken before.
+   *
+   * All routes are returned as standard route data, ready for the RoutePostprocessor.
+   * Only routes within a single database are supported.
+   *
+   * @param state
+   *    State to use
+   * @param start
+   *    Start of the routes
+   * @param target
+   *    Target of the routes
+   * @param parameter
+   *    A RoutingParamater object
+   * @return
+   *    The best route followed by the alternative routes found, not successful if
+   *    no route was found
+   */
+  template <class RoutingState>
+  AlternativeRoutesResult AbstractRoutingService<RoutingState>::CalculateAlternativeRoutes(RoutingState& state,
+                                                                                           const RoutePosition& start,
+                                                                                           const RoutePosition& target,
+                                                                                           const RoutingParameter& parameter)
+  {
+    AlternativeRoutesResult result;
+    BidirectionalSearch     search;
+    RoutingResult           searchResult;
+    StopClock               clock;
+
+    if (GetDatabaseMapping().size()!=1) {
+      log.Error() << "Alternative routes are only supported within a single database";
+      return result;
+    }
+
+    if (!InitializeBidirectionalSearch(state,
+                                       start,
+                                       target,
+                                       search) ||
+        !ContinueBidirectionalSearch(state,
+                                     parameter,
+                                     1.0,
+                                     search,
+                                     searchResult) ||
+        !search.meeting.IsValid()) {
+      return result;
+    }
+
+    // Settle the route nodes of all routes within the allowed stretch
+    if (parameter.GetAlternativeCount()>0 &&
+        !ContinueBidirectionalSearch(state,
+                                     parameter,
+                                     1.0+parameter.GetMaxStretch(),
+                                     search,
+                                     searchResult)) {
+      return result;
+    }
+
+    const Meeting             best=search.meeting;
+    std::list<VNode>          bestNodes;
+    std::unordered_map<Id,Id> bestRoute;      // route node => next route node of the best route
+    std::unordered_set<Id>    bestRouteNodes;
+
+    ResolveMeetingToList(search.forwardClosedSet,
+                         search.backwardSettled,
+                         best.forward,
+                         best.backward,
+                         bestNodes);
+
+    for (const auto& node : bestNodes) {
+      bestRouteNodes.insert(node.currentNode.id);
+
+      if (node.previousNode.IsValid()) {
+        bestRoute[node.previousNode.id]=node.currentNode.id;
+      }
+    }
+
+    //
+    // Collect the candidates
+    //
+
+    std::vector<ViaCandidate> candidates;
+    double                    maxCost=best.cost*(1.0+parameter.GetMaxStretch());
+
+    if (parameter.GetAlternativeCount()>0) {
+      for (const auto& [id,forward] : search.forwardSettled) {
+        auto backward=search.backwardSettled.find(id);
+
+        if (backward==search.backwardSettled.end() ||
+            bestRouteNodes.contains(id.id)) {
+          continue;
+        }
+
+        double cost=GetMeetingCosts(state,
+                                    *forward,
+                                    *backward->second);
+
+        if (cost>maxCost) {
+          continue;
+        }
+
+        ViaCandidate candidate;
+
+        candidate.forward=forward;
+        candidate.backward=backward->second;
+        candidate.cost=cost;
+
+        candidates.push_back(std::move(candidate));
+      }
+    }
+
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [](const ViaCandidate& a, const ViaCandidate& b) {
+                if (a.cost!=b.cost) {
+                  return a.cost<b.cost;
+                }
+
+                return a.forward->id<b.forward->id;
+              });
+
+    //
+    // Evaluate the candidates
+    //
+
+    std::atomic<size_t> nextCandidate=0;
+
+    auto worker=[&]() {
+      for (size_t c=nextCandidate++; c<candidates.size(); c=nextCandidate++) {
+        if (parameter.GetBreaker() &&
+            parameter.GetBreaker()->IsAborted()) {
+          return;
+        }
+
+        EvaluateViaCandidate(search,
+                             bestRoute,
+                             parameter,
+                             candidates[c]);
+      }
+    };
+
+    size_t threadCount=parameter.GetThreadCount();
+
+    if (threadCount==0) {
+      threadCount=std::max(1u,std::thread::hardware_concurrency());
+    }
+
+    threadCount=std::min(threadCount,candidates.size());
+
+    if (threadCount<=1) {
+      worker();
+    }
+    else {
+      std::vector<std::thread> threads;
+
+      for (size_t i=0; i<threadCount; i++) {
+        threads.emplace_back(worker);
+      }
+
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    //
+    // Select the alternatives
+    //
+
+    std::vector<const ViaCandidate*>       alternatives;
+    std::vector<std::unordered_map<Id,Id>> alternativeRoutes;
+
+    for (const auto& candidate : candidates) {
+      if (alternatives.size()>=parameter.GetAlternativeCount()) {
+        break;
+      }
+
+      if (!candidate.admissible) {
+        continue;
+      }
+
+      bool distinct=std::all_of(alternativeRoutes.begin(),
+                                alternativeRoutes.end(),
+                                [&candidate,&parameter](const std::unordered_map<Id,Id>& route) {
+                                  Distance sharing;
+
+                                  for (size_t i=0; i<candidate.distances.size(); i++) {
+                                    if (auto entry=route.find(candidate.nodes[i].id);
+                                        entry!=route.end() &&
+                                        entry->second==candidate.nodes[i+1].id) {
+                                      sharing+=candidate.distances[i];
+                                    }
+                                  }
+
+                                  return sharing<=candidate.distance*parameter.GetMaxSharing();
+                                });
+
+      if (!distinct) {
+        continue;
+      }
+
+      std::unordered_map<Id,Id> route;
+
+      for (size_t i=0; i+1<candidate.nodes.size(); i++) {
+        route[candidate.nodes[i].id]=candidate.nodes[i+1].id;
+      }
+
+      alternatives.push_back(&candidate);
+      alternativeRoutes.push_back(std::move(route));
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Alternative routes" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Actual cost:         " << GetCostString(state, start.GetDatabaseId(), best.cost) << std::endl;
+      std::cout << "Route nodes loaded:  " << search.forwardNodesLoadedCount << " forward, " << search.backwardNodesLoadedCount << " backward" << std::endl;
+      std::cout << "Via candidates:      " << candidates.size() << " with " << threadCount << " thread(s)" << std::endl;
+      std::cout << "Alternatives:        " << alternatives.size() << std::endl;
+    }
+
+    //
+    // Resolve the routes
+    //
+
+    auto addRoute=[&](const RNode& forward,
+                      const RNode& backward,
+                      double cost) {
+      RoutingResult    route;
+      std::list<VNode> nodes;
+
+      ResolveMeetingToList(search.forwardClosedSet,
+                           search.backwardSettled,
+                           forward,
+                           backward,
+                           nodes);
+
+      if (!ResolveRNodesToRouteData(state,
+                                    nodes,
+                                    start,
+                                    target,
+                                    route.GetRoute())) {
+        return false;
+      }
+
+      ResolveRouteDataJunctions(route.GetRoute());
+
+      route.SetOverallDistance(search.overallDistance);
+      result.AddRoute(std::move(route),
+                      cost);
+
+      return true;
+    };
+
+    if (!addRoute(best.forward,
+                  best.backward,
+                  best.cost)) {
+      return {};
+    }
+
+    for (const auto& alternative : alternatives) {
+      if (!addRoute(*alternative->forward,
+                    *alternative->backward,
+                    alternative->cost)) {
+        return {};
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Return the estimated costs from the given forward label to the target of the given
+   * reroute tree. For route nodes of the tree these are the known costs of the
+   * cheapest route to the target. For all other route nodes the costs are at least
+   * the boundary costs of the tree minus the balanced estimate the tree was calculated
+   * with, because the backward search did not settle them.
+   */
+  template <class RoutingState>
+  double AbstractRoutingService<RoutingState>::GetRerouteEstimateCosts(const RoutingState& state,
+                                                                       const RerouteTree& tree,
+                                                                       const RNode& node)
+  {
+    if (auto entry=tree.settled.find(node.id);
+        entry!=tree.settled.end()) {
+      return entry->second->currentCost;
+    }
+
+    if (tree.boundaryCost==std::numeric_limits<double>::max()) {
+      // The tree holds all route nodes the target can be reached from
+      return std::numeric_limits<double>::max();
+    }
+
+    double estimateCost=GetEstimateCosts(state,
+                                         node.id.database,
+                                         GetSphericalDistance(node.node->GetCoord(),
+                                                              tree.targetCoord));
+
+    return std::max(estimateCost,
+                    tree.boundaryCost-GetBalancedEstimateCosts(state,
+                                                               node.id.database,
+                                                               node.node->GetCoord(),
+                                                               tree.targetCoord,
+                                                               tree.startCoord));
+  }
+
+  /**
+   * Calculate the tree of the cheapest routes to the target from all route nodes
+   * around the route from the start, for later use by Reroute().
+   *
+   * The tree is calculated by a backward search from the target towards the start.
+   * After reaching the start, the search continues until it has settled all route
+   * nodes of routes with up to RoutingParameter::GetRerouteCorridor() additional costs.
+   *
+   * The route from the start itself can be retrieved by calling Reroute() for the start.
+   *
+   * @param state
+   *    State to use
+   * @param start
+   *    Start of the route
+   * @param target
+   *    Target of the route
+   * @param parameter
+   *    Parameter of the calculation
+   * @param tree
+   *    The tree, cleared in any case
+   * @return
+   *    True, if the start can be reached from the target, else false
+   */
+  template <class RoutingState>
+  bool AbstractRoutingService<RoutingState>::CalculateRerouteTree(RoutingState& state,
+                                                                  const RoutePosition& start,
+                                                                  const RoutePosition& target,
+                                                                  const RoutingParameter& parameter,
+                                                                  RerouteTree& tree)
+  {
+    Vehicle                           vehicle=GetVehicle(state);
+    RouteNodeRef                      startForwardRouteNode;
+    RouteNodeRef                      startBackwardRouteNode;
+    RNodeRef                          startForwardNode=nullptr;
+    RNodeRef                          startBackwardNode=nullptr;
+    RouteNodeRef                      targetForwardRouteNode;
+    RouteNodeRef                      targetBackwardRouteNode;
+    OpenList                          openList;
+    OpenMap                           openMap;
+    std::unordered_map<DBId,RNodeRef> settled;
+    double                            maxCost=std::numeric_limits<double>::max();
+    size_t                            nodesLoadedCount=0;
+    size_t                            nodesIgnoredCount=0;
+
+    tree.Clear();
+
+    if (GetDatabaseMapping().size()!=1) {
+      log.Error() << "Rerouting is only supported within a single database";
+      return false;
+    }
+
+    // Release the RNodes of the previous route calculation
+    rnodeArena.Clear();
+    hasCompiledProfile=CompileProfile(state,
+                                      target.GetDatabaseId(),
+                                      compiledProfile);
+
+    if (!GetTargetNodes(state,
+                        target,
+                        tree.targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return false;
+    }
+
+    if (!GetStartNodes(state,
+                       start,
+                       tree.startCoord,
+                       tree.targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return false;
+    }
+
+    for (const auto& routeNode : {targetForwardRouteNode,targetBackwardRouteNode}) {
+      if (!routeNode) {
+        continue;
+      }
+
+      DBId id(target.GetDatabaseId(),routeNode->GetId());
+
+      if (openMap.contains(id)) {
+        continue;
+      }
+
+      RNodeRef node=rnodeArena.Allocate(id,
+                                        routeNode,
+                                        target.GetObjectFileRef());
+
+      node->estimateCost=GetBalancedEstimateCosts(state,
+                                                  id.database,
+                                                  routeNode->GetCoord(),
+                                                  tree.targetCoord,
+                                                  tree.startCoord);
+      node->overallCost=node->estimateCost;
+
+      openList.Push(node);
+      openMap[id]=node;
+    }
+
+    Distance overallDistance=GetSphericalDistance(tree.startCoord,
+                                                  tree.targetCoord);
+    double   costLimit=GetCostLimit(state,target.GetDatabaseId(),overallDistance);
+
+    StopClock clock;
+
+    while (!openList.IsEmpty() &&
+           openList.Top()->overallCost<=maxCost) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return false;
+      }
+
+      RNodeRef current=openList.Pop();
+
+      openMap.erase(current->id);
+
+      nodesLoadedCount++;
+
+      settled[current->id]=current;
+
+      if (!WalkPathsBackward(state,
+                             current,
+                             openList,
+                             openMap,
+                             settled,
+                             tree.startCoord,
+                             tree.targetCoord,
+                             vehicle,
+                             nodesIgnoredCount,
+                             costLimit)) {
+        log.Error() << "Failed to walk paths backward from " << current->id.database << " / " << current->id.id;
+        return false;
+      }
+
+      if (maxCost==std::numeric_limits<double>::max() &&
+          ((startForwardRouteNode &&
+            current->id==DBId(start.GetDatabaseId(),startForwardRouteNode->GetId())) ||
+           (startBackwardRouteNode &&
+            current->id==DBId(start.GetDatabaseId(),startBackwardRouteNode->GetId())))) {
+        // Reached the start, settle the corridor around the route
+        maxCost=current->overallCost+parameter.GetRerouteCorridor()*current->currentCost;
+      }
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Reroute tree" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Air-line distance:   " << std::fixed << std::setprecision(1) << overallDistance.As<Kilometer>() << " km" << std::endl;
+      std::cout << "Cost limit:          " << GetCostString(state, target.GetDatabaseId(), costLimit) << std::endl;
+      std::cout << "Route nodes loaded:  " << nodesLoadedCount << std::endl;
+      std::cout << "Route nodes ignored: " << nodesIgnoredCount << std::endl;
+    }
+
+    if (maxCost==std::numeric_limits<double>::max()) {
+      log.Warn() << "No route found!";
+      return false;
+    }
+
+    tree.target=target;
+    // Route nodes not settled have at least the minimal costs of the open list
+    tree.boundaryCost=openList.IsEmpty() ? std::numeric_limits<double>::max() : openList.Top()->overallCost;
+    tree.settled.reserve(settled.size());
+
+    for (const auto& [id,node] : settled) {
+      RNodeRef treeNode=tree.rnodeArena.Allocate(*node);
+
+      // Route nodes are loaded again by the searches using the tree
+      treeNode->node=nullptr;
+      tree.settled[id]=treeNode;
+    }
+
+    return true;
+  }
+
+  /**
+   * Calculate the route from the given position to the target of the given reroute
+   * tree, for example after the vehicle left the route.
+   *
+   * Searches from the position only until it is connected to the tree, where the
+   * costs of the cheapest routes to the target are known. The estimated costs
+   * of GetRerouteEstimateCosts() are exact on the tree and let the search stop as
+   * soon as no cheaper route can be found, so the result is the same as calculated by
+   * CalculateRoute(), but the search is limited to the vicinity of the position and
+   * the tree. The further the position is from the tree, the longer the search takes.
+   *
+   * @param state
+   *    State to use, must be the state the tree was calculated for
+   * @param position
+   *    The new start of the route
+   * @param bearing
+   *    Vehicle bearing, the route will start in this direction, if possible
+   * @param parameter
+   *    Parameter of the calculation
+   * @param tree
+   *    The tree as calculated by CalculateRerouteTree()
+   * @return
+   *    The route, empty if no route was found
+   */
+  template <class RoutingState>
+  RoutingResult AbstractRoutingService<RoutingState>::Reroute(RoutingState& state,
+                                                              const RoutePosition& position,
+                                                              const std::optional<osmscout::Bearing> &bearing,
+                                                              const RoutingParameter& parameter,
+                                                              const RerouteTree& tree)
+  {
+    RoutingResult result;
+    Vehicle       vehicle=GetVehicle(state);
+    RouteNodeRef  startForwardRouteNode;
+    RouteNodeRef  startBackwardRouteNode;
+    RNodeRef      startForwardNode=nullptr;
+    RNodeRef      startBackwardNode=nullptr;
+    GeoCoord      startCoord;
+    OpenList      openList;
+    OpenMap       openMap;
+    ClosedSet     closedSet;
+    Meeting       meeting;
+    size_t        nodesLoadedCount=0;
+    size_t        nodesIgnoredCount=0;
+
+    if (!tree.IsValid()) {
+      log.Error() << "Reroute tree is empty";
+      return result;
+    }
+
+    // Release the RNodes of the previous route calculation
+    rnodeArena.Clear();
+    hasCompiledProfile=CompileProfile(state,
+                                      position.GetDatabaseId(),
+                                      compiledProfile);
+
+    if (!GetStartNodes(state,
+                       position,
+                       startCoord,
+                       tree.targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return result;
+    }
+
+    if (bearing) {
+      if (!RestrictInitialUTurn(state, *bearing, position, startForwardNode, startBackwardNode)) {
+        return result;
+      }
+    }
+
+    for (const auto& node : {startForwardNode,startBackwardNode}) {
+      if (node) {
+        node->estimateCost=GetRerouteEstimateCosts(state,tree,*node);
+        node->overallCost=node->currentCost+node->estimateCost;
+
+        openList.Push(node);
+        openMap[node->id]=node;
+      }
+    }
+
+    Distance currentMaxDistance;
+    Distance overallDistance=GetSphericalDistance(startCoord,
+                                                  tree.targetCoord);
+    double   costLimit=GetCostLimit(state,position.GetDatabaseId(),overallDistance);
+
+    result.SetOverallDistance(overallDistance);
+
+    StopClock clock;
+
+    while (!openList.IsEmpty() &&
+           openList.Top()->overallCost<meeting.cost) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return result;
+      }
+
+      RNodeRef     current=openList.Pop();
+      RouteNodeRef currentRouteNode=current->node;
+
+      openMap.erase(current->id);
+
+      nodesLoadedCount++;
+
+      if (!WalkPaths(state,
+                     current,
+                     currentRouteNode,
+                     openList,
+                     openMap,
+                     closedSet,
+                     result,
+                     parameter,
+                     tree.targetCoord,
+                     vehicle,
+                     nodesIgnoredCount,
+                     currentMaxDistance,
+                     overallDistance,
+                     costLimit)) {
+        log.Error() << "Failed to walk paths from " << current->id.database << " / " << current->id.id;
+        return result;
+      }
+
+      // WalkPaths() estimates the costs by the air-line distance only, replace them
+      // by the costs known from the tree
+      for (const auto& path : currentRouteNode->paths) {
+        auto openEntry=openMap.find(DBId(current->id.database,path.id));
+
+        if (openEntry==openMap.end() ||
+            openEntry->second->prev!=current->id) {
+          continue;
+        }
+
+        RNodeRef node=openEntry->second;
+
+        node->estimateCost=GetRerouteEstimateCosts(state,tree,*node);
+        node->overallCost=node->currentCost+node->estimateCost;
+
+        openList.Update(node);
+      }
+
+      closedSet.insert(VNode(current->id,
+                             current->restricted,
+                             current->object,
+                             current->prev,
+                             current->prevRestricted));
+
+      if (auto treeEntry=tree.settled.find(current->id);
+          treeEntry!=tree.settled.end()) {
+        UpdateMeeting(state,*current,*treeEntry->second,meeting);
+      }
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Reroute" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Air-line distance:   " << std::fixed << std::setprecision(1) << overallDistance.As<Kilometer>() << " km" << std::endl;
+      if (meeting.IsValid()) {
+        std::cout << "Actual cost:         " << GetCostString(state, position.GetDatabaseId(), meeting.cost) << std::endl;
+      }
+      std::cout << "Route nodes loaded:  " << nodesLoadedCount << std::endl;
+      std::cout << "Route nodes ignored: " << nodesIgnoredCount << std::endl;
+    }
+
+    if (!meeting.IsValid()) {
+      log.Warn() << "No route found!";
+      return result;
+    }
+
+    std::list<VNode> nodes;
+
+    ResolveMeetingToList(closedSet,
+                         tree.settled,
+                         meeting.forward,
+                         meeting.backward,
+                         nodes);
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    if (!ResolveRNodesToRouteData(state,
+                                  nodes,
+                                  position,
+                                  tree.target,
+                                  result.GetRoute())) {
+      return result;
+    }
+
+    ResolveRouteDataJunctions(result.GetRoute());
+
+    return result;
+  }
+
+  /**
+   * Calculate a route
+   *
+   * @param state
+   *    State to use
+   * @param start
+   *    Start of the route
+   * @param target
+   *    Target of teh route
+   * @param bearing
+   *    Initial vehicle bearing, route will start by the way in specified direction. When possible.
+   * @param progress
+   *    Optional callback for handling routing progress
+   * @param route
+   *    The route object holding the resulting route on success
+   * @return
+   *    True, if the engine was able to find a route, else false
+   */
+  template <class RoutingState>
+  RoutingResult AbstractRoutingService<RoutingState>::CalculateRoute(RoutingState& state,
+                                                                     const RoutePosition& start,
+                                                                     const RoutePosition& target,
+                                                                     const std::optional<osmscout::Bearing> &bearing,
+                                                                     const RoutingParameter& parameter)
+  {
+    if (parameter.IsBidirectional() &&
+        !bearing &&
+        GetDatabaseMapping().size()==1) {
+      RoutingResult bidirectionalResult=CalculateRouteBidirectional(state,
+                                                                    start,
+                                                                    target,
+                                                                    parameter);
+
+      if (bidirectionalResult.Success() ||
+          (parameter.GetBreaker() &&
+           parameter.GetBreaker()->IsAborted())) {
+        return bidirectionalResult;
+      }
+
+      // Fall back to the unidirectional search
+    }
+
+    RoutingResult            result;
+    Vehicle                  vehicle=GetVehicle(state);
+    RouteNodeRef             startForwardRouteNode;
+    RouteNodeRef             startBackwardRouteNode;
+    RNodeRef                 startForwardNode=nullptr;
+    RNodeRef                 startBackwardNode=nullptr;
+
+    GeoCoord                 startCoord;
+    GeoCoord                 targetCoord;
+
+    RouteNodeRef             targetForwardRouteNode;
+    RouteNodeRef             targetBackwardRouteNode;
+
+    // Sorted list (smallest cost first) of ways to check (we are using a std::set)
+    OpenList                 openList;
+    // Map routing nodes by id
+    OpenMap                  openMap;
+
+    ClosedSet                closedSet;
+
+    size_t                   nodesLoadedCount=0;
+    size_t                   nodesIgnoredCount=0;
+    size_t                   maxOpenList=0;
+    size_t                   maxClosedSet=0;
+
+    openMap.reserve(10000);
+    closedSet.reserve(10000);
+
+    // Release the RNodes of the previous route calculation
+    rnodeArena.Clear();
+    hasCompiledProfile=CompileProfile(state,
+                                      start.GetDatabaseId(),
+                                      compiledProfile);
+
+    if (!GetTargetNodes(state,
+                        target,
+                        targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return result;
+    }
+
+    if (!GetStartNodes(state,
+                       start,
+                       startCoord,
+                       targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return result;
+    }
+
+    if constexpr (debugRouting) {
+      if (startForwardNode) {
+        std::cout << "StartForwardNode:   " << start.GetObjectFileRef().GetName() << " " << startForwardRouteNode->GetId() << " "
+                  << startForwardNode->currentCost << " " << startForwardNode->estimateCost << " " << startForwardNode->overallCost
+                  << std::endl;
+      }
+      if (startBackwardNode) {
+        std::cout << "StartBackwardNode:  " << start.GetObjectFileRef().GetName() << " " << startBackwardRouteNode->GetId() << " "
+                  << startBackwardNode->currentCost << " " << startBackwardNode->estimateCost << " " << startBackwardNode->overallCost
+                  << std::endl;
+      }
+      if (targetForwardRouteNode) {
+        std::cout << "TargetForwardNode:  " << target.GetObjectFileRef().GetName() << " " << targetForwardRouteNode->GetId() << std::endl;
+      }
+      if (targetBackwardRouteNode) {
+        std::cout << "TargetBackwardNode: " << target.GetObjectFileRef().GetName() << " " << targetBackwardRouteNode->GetId() << std::endl;
+      }
+    }
+
+    if (parameter.GetBreaker() &&
+        parameter.GetBreaker()->IsAborted()) {
+      return result;
+    }
+
+    if (bearing) {
+      if (!RestrictInitialUTurn(state, *bearing, start, startForwardNode, startBackwardNode)) {
+        return result;
+      }
+    }
+
+    if (startForwardNode) {
+      openList.Push(startForwardNode);
+      openMap[startForwardNode->id]=startForwardNode;
+    }
+
+    if (startBackwardNode) {
+      openList.Push(startBackwardNode);
+      openMap[startBackwardNode->id]=startBackwardNode;
     }
 
 
@@ -1095,13 +2917,13 @@ namespace osmscout {
     result.SetCurrentMaxDistance(currentMaxDistance);
 
     StopClock    clock;
-    RNodeRef     current;
+    RNodeRef     current=nullptr;
     RouteNodeRef currentRouteNode;
     DatabaseId   dbId;
     bool         targetForwardFound=targetForwardRouteNode ? false : true;
     bool         targetBackwardFound=targetBackwardRouteNode ? false : true;
-    RNodeRef     targetForwardFinalNode;
-    RNodeRef     targetBackwardFinalNode;
+    RNodeRef     targetForwardFinalNode=nullptr;
+    RNodeRef     targetBackwardFinalNode=nullptr;
 
     do {
       //
@@ -1113,10 +2935,9 @@ namespace osmscout {
         return result;
       }
 
-      current=*openList.begin();
+      current=openList.Pop();
 
       openMap.erase(current->id);
-      openList.erase(openList.begin());
 
       currentRouteNode=current->node;
       dbId=current->id.database;
@@ -1184,7 +3005,7 @@ namespace osmscout {
       maxClosedSet=std::max(maxClosedSet,closedSet.size());
 
       if constexpr (debugRouting) {
-        if (openList.empty()) {
+        if (openList.IsEmpty()) {
           std::cout << "No more alternatives, stopping" << std::endl;
         }
 
@@ -1217,7 +3038,7 @@ namespace osmscout {
         }
       }
 
-    } while (!openList.empty() && !(targetForwardFound && targetBackwardFound));
+    } while (!openList.IsEmpty() && !(targetForwardFound && targetBackwardFound));
 
     // If we have keep the last node open because of access violations, add it
     // after routing is done
@@ -1228,7 +3049,7 @@ namespace osmscout {
                              current->prev,
                              current->prevRestricted));
     }
-    RNodeRef  targetFinalNode;
+    RNodeRef  targetFinalNode=nullptr;
 
     if (targetBackwardFinalNode && targetForwardFinalNode) {
       if (targetForwardFinalNode->currentCost<=targetBackwardFinalNode->currentCost) {
@@ -1239,10 +3060,10 @@ namespace osmscout {
       }
     }
     else if (targetBackwardFinalNode) {
-      targetFinalNode=std::move(targetBackwardFinalNode);
+      targetFinalNode=targetBackwardFinalNode;
     }
     else if (targetForwardFinalNode) {
-      targetFinalNode=std::move(targetForwardFinalNode);
+      targetFinalNode=targetForwardFinalNode;
     }
 
     clock.Stop();
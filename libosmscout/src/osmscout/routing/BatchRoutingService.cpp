@@ -0,0 +1,230 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/BatchRoutingService.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/StopClock.h>
+
+namespace osmscout {
+
+  /**
+   * Create a new instance of the batch routing service.
+   *
+   * @param database
+   *    A valid reference to a db instance
+   * @param parameter
+   *    Parameter of the routing services of the workers
+   * @param filenamebase
+   *    Common base name for all router files
+   * @param threadCount
+   *    Number of worker threads, 0 (the default) uses one thread per hardware thread
+   */
+  BatchRoutingService::BatchRoutingService(const DatabaseRef& database,
+                                           const RouterParameter& parameter,
+                                           const std::string& filenamebase,
+                                           size_t threadCount)
+  : database(database),
+    parameter(parameter),
+    filenamebase(filenamebase),
+    threadCount(threadCount>0 ? threadCount : std::max(1u,std::thread::hardware_concurrency()))
+  {
+    assert(database);
+  }
+
+  BatchRoutingService::~BatchRoutingService()
+  {
+    Close();
+  }
+
+  /**
+   * Open the shared routing database and the routing services of the workers
+   *
+   * @return
+   *    false on error, else true
+   */
+  bool BatchRoutingService::Open()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!workers.empty()) {
+      return true;
+    }
+
+    routingDatabase=std::make_shared<RoutingDatabase>();
+
+    if (!routingDatabase->Open(database)) {
+      routingDatabase=nullptr;
+      return false;
+    }
+
+    for (size_t i=0; i<threadCount; i++) {
+      SimpleRoutingServiceRef worker=std::make_shared<SimpleRoutingService>(database,
+                                                                            parameter,
+                                                                            filenamebase,
+                                                                            routingDatabase);
+
+      if (!worker->Open()) {
+        log.Error() << "Cannot open routing service of worker " << i;
+
+        for (const auto& openWorker : workers) {
+          openWorker->Close();
+        }
+
+        workers.clear();
+        routingDatabase->Close();
+        routingDatabase=nullptr;
+
+        return false;
+      }
+
+      workers.push_back(worker);
+    }
+
+    return true;
+  }
+
+  bool BatchRoutingService::IsOpen()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return !workers.empty();
+  }
+
+  void BatchRoutingService::Close()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto& worker : workers) {
+      worker->Close();
+    }
+
+    workers.clear();
+
+    if (routingDatabase) {
+      routingDatabase->Close();
+      routingDatabase=nullptr;
+    }
+  }
+
+  /**
+   * Calculate the routes of the given jobs.
+   *
+   * The workers take the next unprocessed job as soon as they are done with their
+   * current one, so long routes do not hold back the other workers. The results
+   * are returned in the order of the jobs, together with the time the calculation
+   * of each route took. Jobs without profile and jobs not processed because
+   * the calculation was aborted have an unsuccessful result. An exception thrown
+   * while calculating a route fails only its job, it is stored in the result of
+   * the job.
+   *
+   * The routing progress of the parameter is not reported, since the
+   * routes are calculated concurrently.
+   *
+   * @param jobs
+   *    The routes to calculate
+   * @param parameter
+   *    A RoutingParamater object, used for all routes
+   * @return
+   *    The result of each job, in the order of the jobs
+   */
+  std::vector<BatchRoutingJobResult> BatchRoutingService::CalculateRoutes(const std::vector<BatchRoutingJob>& jobs,
+                                                                          const RoutingParameter& parameter)
+  {
+    std::lock_guard<std::mutex>        lock(mutex);
+    std::vector<BatchRoutingJobResult> results(jobs.size());
+
+    if (workers.empty()) {
+      log.Error() << "Batch routing service is not open";
+      return results;
+    }
+
+    RoutingParameter    jobParameter(parameter);
+    std::atomic<size_t> nextJob=0;
+
+    jobParameter.SetProgress(nullptr);
+
+    auto work=[&](size_t workerIndex) {
+      SimpleRoutingService& router=*workers[workerIndex];
+
+      for (size_t j=nextJob++; j<jobs.size(); j=nextJob++) {
+        if (parameter.GetBreaker() &&
+            parameter.GetBreaker()->IsAborted()) {
+          return;
+        }
+
+        const BatchRoutingJob& job=jobs[j];
+
+        if (!job.profile) {
+          log.Error() << "Batch routing job " << j << " has no profile";
+          continue;
+        }
+
+        StopClock clock;
+
+        try {
+          results[j].result=router.CalculateRoute(*job.profile,
+                                                  job.start,
+                                                  job.target,
+                                                  std::nullopt,
+                                                  jobParameter);
+        }
+        catch (IOException& e) {
+          log.Error() << e.GetDescription();
+          results[j].exception=std::current_exception();
+        }
+        catch (...) {
+          // Only this job fails, the workers continue with the other jobs
+          log.Error() << "Batch routing job " << j << " failed";
+          results[j].exception=std::current_exception();
+        }
+
+        clock.Stop();
+
+        results[j].duration=clock.GetDuration();
+        results[j].worker=workerIndex;
+      }
+    };
+
+    size_t threads=std::min(workers.size(),jobs.size());
+
+    if (threads<=1) {
+      work(0);
+    }
+    else {
+      std::vector<std::thread> workerThreads;
+
+      for (size_t i=0; i<threads; i++) {
+        workerThreads.emplace_back(work,i);
+      }
+
+      for (auto& thread : workerThreads) {
+        thread.join();
+      }
+    }
+
+    return results;
+  }
+}
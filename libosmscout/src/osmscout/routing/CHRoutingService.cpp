@@ -0,0 +1,532 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/CHRoutingService.h>
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <queue>
+#include <set>
+#include <unordered_map>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/StopClock.h>
+
+namespace osmscout {
+
+  namespace {
+    /**
+     * Best known cost of reaching a node in one search direction
+     */
+    struct Label
+    {
+      double                            cost;
+      uint32_t                          parent; //!< Previous node in search direction
+      const ContractionHierarchy::Edge* edge;   //!< Edge used to reach the node from the parent
+    };
+
+    using LabelMap = std::unordered_map<uint32_t,Label>;
+
+    using QueueEntry = std::pair<double,uint32_t>;
+    using Queue      = std::priority_queue<QueueEntry,std::vector<QueueEntry>,std::greater<>>;
+
+    void AddRoot(LabelMap& labels,
+                 Queue& queue,
+                 uint32_t node,
+                 double cost)
+    {
+      auto [entry,inserted]=labels.try_emplace(node,Label{cost,ContractionHierarchy::noNode,nullptr});
+
+      if (!inserted) {
+        if (entry->second.cost<=cost) {
+          return;
+        }
+
+        entry->second.cost=cost;
+      }
+
+      queue.emplace(cost,node);
+    }
+
+    /**
+     * A node is stalled, if it can be reached cheaper by an edge coming down from
+     * an already labeled higher ranked node. Its edges do not need to be relaxed, since
+     * the node is not part of a shortest path.
+     */
+    bool IsStalled(std::span<const ContractionHierarchy::Edge> downEdges,
+                   const LabelMap& labels,
+                   double cost)
+    {
+      return std::any_of(downEdges.begin(),downEdges.end(),[&labels,cost](const ContractionHierarchy::Edge& edge) {
+        auto entry=labels.find(edge.target);
+
+        return entry!=labels.end() &&
+               entry->second.cost+edge.cost<cost;
+      });
+    }
+  }
+
+  CHRoutingService::CHRoutingService(const DatabaseRef& database,
+                                     const RouterParameter& parameter,
+                                     const std::string& filenamebase)
+  : SimpleRoutingService(database,
+                         parameter,
+                         filenamebase),
+    database(database),
+    filenamebase(filenamebase)
+  {
+    // no code
+  }
+
+  CHRoutingService::~CHRoutingService()
+  {
+    // no code
+  }
+
+  /**
+   * Opens the routing service and loads the contraction hierarchies of all
+   * vehicles available.
+   *
+   * @return
+   *    true on success, else false
+   */
+  bool CHRoutingService::Open()
+  {
+    if (!SimpleRoutingService::Open()) {
+      return false;
+    }
+
+    for (Vehicle vehicle : {vehicleFoot,vehicleBicycle,vehicleCar}) {
+      std::string filename=AppendFileToDir(database->GetPath(),
+                                           ContractionHierarchy::GetFilename(filenamebase,vehicle));
+
+      if (!ExistsInFilesystem(filename)) {
+        continue;
+      }
+
+      auto hierarchy=std::make_shared<ContractionHierarchy>();
+
+      if (!hierarchy->Load(filename)) {
+        log.Error() << "Cannot load contraction hierarchy '" << filename << "'";
+        Close();
+        return false;
+      }
+
+      if (hierarchy->GetVehicle()!=vehicle) {
+        log.Error() << "Contraction hierarchy '" << filename << "' was built for a different vehicle";
+        Close();
+        return false;
+      }
+
+      CompiledRoutingProfile compiled;
+
+      if (!CompileProfile(*ContractionHierarchy::CreateProfile(database->GetTypeConfig(),
+                                                               vehicle),
+                          0,
+                          compiled)) {
+        log.Error() << "Cannot compile the profile of contraction hierarchy '" << filename << "'";
+        Close();
+        return false;
+      }
+
+      hierarchies[vehicle]=hierarchy;
+      profiles[vehicle]=std::move(compiled);
+    }
+
+    return true;
+  }
+
+  /**
+   * Close the routing service
+   */
+  void CHRoutingService::Close()
+  {
+    hierarchies.clear();
+    profiles.clear();
+
+    SimpleRoutingService::Close();
+  }
+
+  /**
+   * Return the contraction hierarchy for the given vehicle or null, if there is none
+   */
+  ContractionHierarchyRef CHRoutingService::GetContractionHierarchy(Vehicle vehicle) const
+  {
+    auto entry=hierarchies.find(vehicle);
+
+    if (entry==hierarchies.end()) {
+      return nullptr;
+    }
+
+    return entry->second;
+  }
+
+  /**
+   * Return true, if routes for the given profile are calculated in the contraction
+   * hierarchy. This is the case, if there is a hierarchy for the vehicle of the
+   * profile and the profile compiles to the same usability and costs of all paths
+   * as the profile the hierarchy was built with. Otherwise the costs of the
+   * hierarchy would not be the costs of the profile.
+   */
+  bool CHRoutingService::UsesContractionHierarchy(const RoutingProfile& profile)
+  {
+    auto entry=profiles.find(profile.GetVehicle());
+
+    if (entry==profiles.end()) {
+      return false;
+    }
+
+    CompiledRoutingProfile compiled;
+
+    return CompileProfile(profile,
+                          0,
+                          compiled) &&
+           compiled==entry->second;
+  }
+
+  bool CHRoutingService::GetTargetCost(RoutingProfile& profile,
+                                       const RoutePosition& target,
+                                       const GeoCoord& targetCoord,
+                                       const RouteNodeRef& routeNode,
+                                       double& cost)
+  {
+    WayRef way;
+
+    if (!GetWayByOffset(DBFileOffset(target.GetDatabaseId(),
+                                     target.GetObjectFileRef().GetFileOffset()),
+                        way)) {
+      log.Error() << "Cannot get target way!";
+      return false;
+    }
+
+    cost=GetCosts(profile,
+                  target.GetDatabaseId(),
+                  way,
+                  GetSphericalDistance(routeNode->GetCoord(),
+                                       targetCoord));
+
+    return true;
+  }
+
+  /**
+   * Return true, if the route turns from one object into another at a
+   * route node, where this is forbidden by a turn restriction
+   */
+  bool CHRoutingService::ViolatesTurnRestriction(const std::vector<ContractionHierarchy::Step>& steps,
+                                                 const ContractionHierarchy& hierarchy,
+                                                 DatabaseId database)
+  {
+    std::set<DBId>                        routeNodeIds;
+    std::unordered_map<DBId,RouteNodeRef> routeNodeMap;
+
+    for (const auto& step : steps) {
+      routeNodeIds.insert(DBId(database,hierarchy.GetNodeId(step.node)));
+    }
+
+    if (!GetRouteNodes(routeNodeIds,
+                       routeNodeMap)) {
+      log.Error() << "Cannot load route nodes";
+      return true;
+    }
+
+    for (size_t i=0; i+1<steps.size(); i++) {
+      const RouteNodeRef& routeNode=routeNodeMap[DBId(database,hierarchy.GetNodeId(steps[i].node))];
+
+      for (const auto& exclude : routeNode->excludes) {
+        if (exclude.source==steps[i].object &&
+            routeNode->objects[routeNode->paths[exclude.targetIndex].objectIndex].object==steps[i+1].object) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Calculate a route using the contraction hierarchy of the vehicle of the profile,
+   * see the class description for cases falling back to the A* search.
+   *
+   * @param profile
+   *    Profile to use
+   * @param start
+   *    Start of the route
+   * @param target
+   *    Target of the route
+   * @param bearing
+   *    Initial vehicle bearing
+   * @param parameter
+   *    Optional breaker and progress callback
+   * @return
+   *    The route, if the engine was able to find one
+   */
+  RoutingResult CHRoutingService::CalculateRoute(RoutingProfile& profile,
+                                                 const RoutePosition& start,
+                                                 const RoutePosition& target,
+                                                 const std::optional<osmscout::Bearing> &bearing,
+                                                 const RoutingParameter& parameter)
+  {
+    ContractionHierarchyRef hierarchy=GetContractionHierarchy(profile.GetVehicle());
+
+    if (!hierarchy ||
+        bearing ||
+        start.GetObjectFileRef()==target.GetObjectFileRef() ||
+        !UsesContractionHierarchy(profile)) {
+      return SimpleRoutingService::CalculateRoute(profile,start,target,bearing,parameter);
+    }
+
+    RoutingResult result;
+    RouteNodeRef  startForwardRouteNode;
+    RouteNodeRef  startBackwardRouteNode;
+    RNodeRef      startForwardNode=nullptr;
+    RNodeRef      startBackwardNode=nullptr;
+    RouteNodeRef  targetForwardRouteNode;
+    RouteNodeRef  targetBackwardRouteNode;
+    GeoCoord      startCoord;
+    GeoCoord      targetCoord;
+
+    rnodeArena.Clear();
+
+    if (!GetTargetNodes(profile,
+                        target,
+                        targetCoord,
+                        targetForwardRouteNode,
+                        targetBackwardRouteNode)) {
+      return result;
+    }
+
+    if (!GetStartNodes(profile,
+                       start,
+                       startCoord,
+                       targetCoord,
+                       startForwardRouteNode,
+                       startBackwardRouteNode,
+                       startForwardNode,
+                       startBackwardNode)) {
+      return result;
+    }
+
+    StopClock clock;
+    LabelMap  forwardLabels;
+    LabelMap  backwardLabels;
+    Queue     forwardQueue;
+    Queue     backwardQueue;
+
+    for (const auto& node : {startForwardNode,startBackwardNode}) {
+      if (!node) {
+        continue;
+      }
+
+      uint32_t index=hierarchy->GetNodeIndex(node->node->GetId());
+
+      if (index!=ContractionHierarchy::noNode) {
+        AddRoot(forwardLabels,forwardQueue,index,node->currentCost);
+      }
+    }
+
+    for (const auto& routeNode : {targetForwardRouteNode,targetBackwardRouteNode}) {
+      if (!routeNode) {
+        continue;
+      }
+
+      uint32_t index=hierarchy->GetNodeIndex(routeNode->GetId());
+      double   cost;
+
+      if (index==ContractionHierarchy::noNode) {
+        continue;
+      }
+
+      if (!GetTargetCost(profile,target,targetCoord,routeNode,cost)) {
+        return result;
+      }
+
+      AddRoot(backwardLabels,backwardQueue,index,cost);
+    }
+
+    double   bestCost=std::numeric_limits<double>::infinity();
+    uint32_t meetingNode=ContractionHierarchy::noNode;
+    size_t   settledCount=0;
+    size_t   stalledCount=0;
+
+    while (!forwardQueue.empty() ||
+           !backwardQueue.empty()) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return result;
+      }
+
+      // Continue the search in the direction with the cheaper node, stop if
+      // no node of both directions can be part of a cheaper route
+      bool forward=!forwardQueue.empty() &&
+                   (backwardQueue.empty() || forwardQueue.top().first<=backwardQueue.top().first);
+
+      Queue&    queue=forward ? forwardQueue : backwardQueue;
+      LabelMap& labels=forward ? forwardLabels : backwardLabels;
+      LabelMap& otherLabels=forward ? backwardLabels : forwardLabels;
+
+      auto [cost,node]=queue.top();
+
+      if (cost>=bestCost) {
+        break;
+      }
+
+      queue.pop();
+
+      if (cost>labels[node].cost) {
+        // Outdated queue entry
+        continue;
+      }
+
+      settledCount++;
+
+      if (auto other=otherLabels.find(node);
+          other!=otherLabels.end() &&
+          cost+other->second.cost<bestCost) {
+        bestCost=cost+other->second.cost;
+        meetingNode=node;
+      }
+
+      std::span<const ContractionHierarchy::Edge> upEdges=forward ? hierarchy->GetForwardEdges(node) : hierarchy->GetBackwardEdges(node);
+      std::span<const ContractionHierarchy::Edge> downEdges=forward ? hierarchy->GetBackwardEdges(node) : hierarchy->GetForwardEdges(node);
+
+      if (IsStalled(downEdges,labels,cost)) {
+        stalledCount++;
+        continue;
+      }
+
+      for (const auto& edge : upEdges) {
+        double edgeCost=cost+edge.cost;
+
+        auto [entry,inserted]=labels.try_emplace(edge.target,Label{edgeCost,node,&edge});
+
+        if (!inserted) {
+          if (entry->second.cost<=edgeCost) {
+            continue;
+          }
+
+          entry->second=Label{edgeCost,node,&edge};
+        }
+
+        queue.emplace(edgeCost,edge.target);
+      }
+    }
+
+    clock.Stop();
+
+    Distance overallDistance=GetSphericalDistance(startCoord,
+                                                  targetCoord);
+
+    result.SetOverallDistance(overallDistance);
+
+    if (debugPerformance) {
+      std::cout << "Time:                " << clock << std::endl;
+      std::cout << "Air-line distance:   " << std::fixed << std::setprecision(1) << overallDistance.As<Kilometer>() << " km" << std::endl;
+      if (meetingNode!=ContractionHierarchy::noNode) {
+        std::cout << "Actual cost:         " << GetCostString(profile, start.GetDatabaseId(), bestCost) << std::endl;
+      }
+      std::cout << "CH nodes settled:    " << settledCount << std::endl;
+      std::cout << "CH nodes stalled:    " << stalledCount << std::endl;
+    }
+
+    if (meetingNode==ContractionHierarchy::noNode) {
+      log.Debug() << "No route found in contraction hierarchy, falling back to A* search";
+      return SimpleRoutingService::CalculateRoute(profile,start,target,bearing,parameter);
+    }
+
+    //
+    // Unpack the route from the start via the meeting node to the target
+    //
+
+    std::vector<uint32_t>                  forwardChain;
+    std::vector<ContractionHierarchy::Step> steps;
+
+    for (uint32_t node=meetingNode; node!=ContractionHierarchy::noNode; node=forwardLabels[node].parent) {
+      forwardChain.push_back(node);
+    }
+
+    std::reverse(forwardChain.begin(),forwardChain.end());
+
+    steps.push_back(ContractionHierarchy::Step{forwardChain.front(),start.GetObjectFileRef()});
+
+    for (size_t i=1; i<forwardChain.size(); i++) {
+      if (!hierarchy->Unpack(forwardChain[i-1],
+                             *forwardLabels[forwardChain[i]].edge,
+                             forwardChain[i],
+                             steps)) {
+        return result;
+      }
+    }
+
+    for (uint32_t node=meetingNode; backwardLabels[node].parent!=ContractionHierarchy::noNode; node=backwardLabels[node].parent) {
+      const Label& label=backwardLabels[node];
+
+      if (!hierarchy->Unpack(node,
+                             *label.edge,
+                             label.parent,
+                             steps)) {
+        return result;
+      }
+    }
+
+    if (ViolatesTurnRestriction(steps,
+                                *hierarchy,
+                                start.GetDatabaseId())) {
+      log.Debug() << "Route of contraction hierarchy violates turn restriction, falling back to A* search";
+      return SimpleRoutingService::CalculateRoute(profile,start,target,bearing,parameter);
+    }
+
+    std::list<VNode> nodes;
+    DBId             previousNode;
+
+    for (const auto& step : steps) {
+      DBId currentNode(start.GetDatabaseId(),
+                       hierarchy->GetNodeId(step.node));
+
+      nodes.emplace_back(currentNode,
+                         false,
+                         step.object,
+                         previousNode,
+                         false);
+
+      previousNode=currentNode;
+    }
+
+    if (!ResolveRNodesToRouteData(profile,
+                                  nodes,
+                                  start,
+                                  target,
+                                  result.GetRoute())) {
+      return result;
+    }
+
+    ResolveRouteDataJunctions(result.GetRoute());
+
+    result.SetCurrentMaxDistance(overallDistance);
+
+    return result;
+  }
+}
@@ -0,0 +1,394 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/ContractionHierarchy.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <map>
+
+#include <osmscout/io/FileScanner.h>
+#include <osmscout/io/FileWriter.h>
+
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+  /**
+   * Create the hierarchy from the upward edges of the nodes
+   *
+   * @param vehicle
+   *    Vehicle the hierarchy was built for
+   * @param nodeIds
+   *    Sorted ids of the route nodes
+   * @param forwardEdges
+   *    Forward edges for each node
+   * @param backwardEdges
+   *    Backward edges for each node
+   */
+  ContractionHierarchy::ContractionHierarchy(Vehicle vehicle,
+                                             const std::vector<Id>& nodeIds,
+                                             const std::vector<std::vector<Edge>>& forwardEdges,
+                                             const std::vector<std::vector<Edge>>& backwardEdges)
+  : vehicle(vehicle),
+    nodeIds(nodeIds)
+  {
+    assert(std::is_sorted(nodeIds.begin(),nodeIds.end()));
+    assert(forwardEdges.size()==nodeIds.size());
+    assert(backwardEdges.size()==nodeIds.size());
+
+    forwardIndex.reserve(nodeIds.size()+1);
+    backwardIndex.reserve(nodeIds.size()+1);
+
+    for (size_t node=0; node<nodeIds.size(); node++) {
+      forwardIndex.push_back(static_cast<uint32_t>(this->forwardEdges.size()));
+      this->forwardEdges.insert(this->forwardEdges.end(),
+                                forwardEdges[node].begin(),
+                                forwardEdges[node].end());
+
+      backwardIndex.push_back(static_cast<uint32_t>(this->backwardEdges.size()));
+      this->backwardEdges.insert(this->backwardEdges.end(),
+                                 backwardEdges[node].begin(),
+                                 backwardEdges[node].end());
+    }
+
+    forwardIndex.push_back(static_cast<uint32_t>(this->forwardEdges.size()));
+    backwardIndex.push_back(static_cast<uint32_t>(this->backwardEdges.size()));
+  }
+
+  static void ReadEdges(FileScanner& scanner,
+                        std::vector<uint32_t>& index,
+                        std::vector<ContractionHierarchy::Edge>& edges,
+                        uint32_t nodeCount)
+  {
+    index.resize(nodeCount+1);
+
+    for (uint32_t node=0; node<nodeCount; node++) {
+      index[node]=static_cast<uint32_t>(edges.size());
+
+      uint32_t edgeCount=scanner.ReadUInt32Number();
+
+      for (uint32_t e=0; e<edgeCount; e++) {
+        ContractionHierarchy::Edge edge;
+
+        edge.target=scanner.ReadUInt32Number();
+        edge.cost=std::bit_cast<double>(scanner.ReadUInt64());
+
+        if (scanner.ReadBool()) {
+          edge.middle=scanner.ReadUInt32Number();
+        }
+        else {
+          edge.object=scanner.ReadObjectFileRef();
+        }
+
+        if (edge.target>=nodeCount ||
+            (edge.IsShortcut() && edge.middle>=nodeCount)) {
+          throw IOException(scanner.GetFilename(),"Cannot read edges","Node index out of range");
+        }
+
+        edges.push_back(edge);
+      }
+    }
+
+    index[nodeCount]=static_cast<uint32_t>(edges.size());
+  }
+
+  static void WriteEdges(FileWriter& writer,
+                         std::span<const ContractionHierarchy::Edge> edges)
+  {
+    writer.WriteNumber(static_cast<uint32_t>(edges.size()));
+
+    for (const auto& edge : edges) {
+      writer.WriteNumber(edge.target);
+      writer.Write(std::bit_cast<uint64_t>(edge.cost));
+      writer.Write(edge.IsShortcut());
+
+      if (edge.IsShortcut()) {
+        writer.WriteNumber(edge.middle);
+      }
+      else {
+        writer.Write(edge.object);
+      }
+    }
+  }
+
+  /**
+   * Load the hierarchy from the given file.
+   *
+   * @param filename
+   *    Name of the file containing the hierarchy
+   * @return
+   *    True on success, else false
+   */
+  bool ContractionHierarchy::Load(const std::string& filename)
+  {
+    FileScanner scanner;
+
+    nodeIds.clear();
+    forwardIndex.clear();
+    forwardEdges.clear();
+    backwardIndex.clear();
+    backwardEdges.clear();
+
+    try {
+      scanner.Open(filename,
+                   FileScanner::Sequential,
+                   true);
+
+      uint32_t version=scanner.ReadUInt32();
+
+      if (version!=FILE_FORMAT_VERSION) {
+        log.Error() << "File '" << filename << "' has format version " << version << ", expected " << FILE_FORMAT_VERSION;
+        scanner.Close();
+        return false;
+      }
+
+      vehicle=static_cast<Vehicle>(scanner.ReadUInt8());
+
+      uint32_t nodeCount=scanner.ReadUInt32();
+      Id       previousId=0;
+
+      nodeIds.reserve(nodeCount);
+
+      for (uint32_t node=0; node<nodeCount; node++) {
+        Id id=previousId+scanner.ReadUInt64Number();
+
+        nodeIds.push_back(id);
+        previousId=id;
+      }
+
+      ReadEdges(scanner,
+                forwardIndex,
+                forwardEdges,
+                nodeCount);
+      ReadEdges(scanner,
+                backwardIndex,
+                backwardEdges,
+                nodeCount);
+
+      scanner.Close();
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Store the hierarchy to the given file.
+   *
+   * @param filename
+   *    Name of the file to write
+   * @return
+   *    True on success, else false
+   */
+  bool ContractionHierarchy::Store(const std::string& filename) const
+  {
+    FileWriter writer;
+
+    try {
+      writer.Open(filename);
+
+      writer.Write(FILE_FORMAT_VERSION);
+      writer.Write(static_cast<uint8_t>(vehicle));
+      writer.Write(static_cast<uint32_t>(nodeIds.size()));
+
+      Id previousId=0;
+
+      for (Id id : nodeIds) {
+        writer.WriteNumber(id-previousId);
+        previousId=id;
+      }
+
+      for (uint32_t node=0; node<nodeIds.size(); node++) {
+        WriteEdges(writer,
+                   GetForwardEdges(node));
+      }
+
+      for (uint32_t node=0; node<nodeIds.size(); node++) {
+        WriteEdges(writer,
+                   GetBackwardEdges(node));
+      }
+
+      writer.Close();
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Return the index of the node with the given route node id or noNode,
+   * if the route node is not part of the hierarchy
+   */
+  uint32_t ContractionHierarchy::GetNodeIndex(Id id) const
+  {
+    auto entry=std::lower_bound(nodeIds.begin(),nodeIds.end(),id);
+
+    if (entry==nodeIds.end() ||
+        *entry!=id) {
+      return noNode;
+    }
+
+    return static_cast<uint32_t>(entry-nodeIds.begin());
+  }
+
+  const ContractionHierarchy::Edge* ContractionHierarchy::FindEdge(const std::vector<uint32_t>& index,
+                                                                   const std::vector<Edge>& edges,
+                                                                   uint32_t node,
+                                                                   uint32_t target) const
+  {
+    const Edge* result=nullptr;
+
+    for (uint32_t e=index[node]; e<index[node+1]; e++) {
+      if (edges[e].target==target &&
+          (result==nullptr || edges[e].cost<result->cost)) {
+        result=&edges[e];
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Unpack the given edge (leading from node 'from' to node 'to') into the
+   * original paths of the routing graph. For every path the node reached and
+   * the object followed is appended to steps, the node 'from' itself is not
+   * appended.
+   *
+   * @return
+   *    False, if the hierarchy is inconsistent
+   */
+  bool ContractionHierarchy::Unpack(uint32_t from,
+                                    const Edge& edge,
+                                    uint32_t to,
+                                    std::vector<Step>& steps) const
+  {
+    if (!edge.IsShortcut()) {
+      steps.push_back(Step{to,edge.object});
+
+      return true;
+    }
+
+    const Edge* first=FindEdge(backwardIndex,backwardEdges,edge.middle,from);
+    const Edge* second=FindEdge(forwardIndex,forwardEdges,edge.middle,to);
+
+    if (first==nullptr ||
+        second==nullptr) {
+      log.Error() << "Cannot unpack shortcut " << nodeIds[from] << " -> " << nodeIds[to] << " via " << nodeIds[edge.middle];
+      return false;
+    }
+
+    return Unpack(from,*first,edge.middle,steps) &&
+           Unpack(edge.middle,*second,to,steps);
+  }
+
+  /**
+   * Return the relative filename of the hierarchy for the given router and vehicle
+   */
+  std::string ContractionHierarchy::GetFilename(const std::string& filenamebase,
+                                                Vehicle vehicle)
+  {
+    switch (vehicle) {
+    case vehicleFoot:
+      return filenamebase+"-ch-foot.dat";
+    case vehicleBicycle:
+      return filenamebase+"-ch-bicycle.dat";
+    case vehicleCar:
+      return filenamebase+"-ch-car.dat";
+    }
+
+    assert(false);
+    return filenamebase+"-ch.dat";
+  }
+
+  static void GetCarSpeedTable(std::map<std::string,double>& map)
+  {
+    map["highway_motorway"]=110.0;
+    map["highway_motorway_trunk"]=100.0;
+    map["highway_motorway_primary"]=70.0;
+    map["highway_motorway_link"]=60.0;
+    map["highway_motorway_junction"]=60.0;
+    map["highway_trunk"]=100.0;
+    map["highway_trunk_link"]=60.0;
+    map["highway_primary"]=70.0;
+    map["highway_primary_link"]=60.0;
+    map["highway_secondary"]=60.0;
+    map["highway_secondary_link"]=50.0;
+    map["highway_tertiary_link"]=55.0;
+    map["highway_tertiary"]=55.0;
+    map["highway_unclassified"]=50.0;
+    map["highway_road"]=50.0;
+    map["highway_residential"]=20.0;
+    map["highway_roundabout"]=40.0;
+    map["highway_living_street"]=10.0;
+    map["highway_service"]=30.0;
+  }
+
+  /**
+   * Return the profile defining the costs of the hierarchy for the given vehicle.
+   * It is a fastest path profile without junction penalty (the hierarchy
+   * does not know about the way a node is entered).
+   *
+   * Queries using a different profile return routes optimal for this
+   * profile, not for the profile passed.
+   */
+  FastestPathRoutingProfileRef ContractionHierarchy::CreateProfile(const TypeConfigRef& typeConfig,
+                                                                   Vehicle vehicle)
+  {
+    auto profile=std::make_shared<FastestPathRoutingProfile>(typeConfig);
+
+    switch (vehicle) {
+    case vehicleFoot:
+      profile->ParametrizeForFoot(*typeConfig,
+                                  5.0);
+      break;
+    case vehicleBicycle:
+      profile->ParametrizeForBicycle(*typeConfig,
+                                     20.0);
+      break;
+    case vehicleCar: {
+      std::map<std::string,double> carSpeedTable;
+
+      GetCarSpeedTable(carSpeedTable);
+
+      if (!profile->ParametrizeForCar(*typeConfig,
+                                      carSpeedTable,
+                                      160.0)) {
+        log.Warn() << "Not all car routable types have a speed, they are not routable";
+      }
+      break;
+    }
+    }
+
+    profile->SetJunctionPenalty(false);
+
+    return profile;
+  }
+}
@@ -0,0 +1,671 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/IsochroneService.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/StopClock.h>
+
+namespace osmscout {
+
+  namespace {
+    constexpr double metersPerDegree=111319.49079327357; // length of a degree at the equator
+    constexpr double maxGridCells=16'000'000;            // upper limit for the cells of a grid (one byte each)
+
+    constexpr std::array<int32_t,4> directionX={1,0,-1,0}; // right, up, left, down
+    constexpr std::array<int32_t,4> directionY={0,1,0,-1};
+
+    /**
+     * A path of the search together with the distance (km) and duration (hours)
+     * from the start at both ends
+     */
+    struct Segment
+    {
+      GeoCoord from;
+      GeoCoord to;
+      double   fromDistance;
+      double   fromDuration;
+      double   toDistance;
+      double   toDuration;
+    };
+
+    /**
+     * Equirectangular projection around the start to grid cell units. Precise enough
+     * for the extent of an isochrone.
+     */
+    class GridProjection
+    {
+    private:
+      GeoCoord origin;
+      double   cellSize;  //!< Cell size in meter
+      double   lonFactor; //!< Length of a degree of longitude in meter
+
+    public:
+      GridProjection(const GeoCoord& origin,
+                     const Distance& cellSize)
+      : origin(origin),
+        cellSize(cellSize.AsMeter()),
+        lonFactor(metersPerDegree*std::cos(DegToRad(origin.GetLat())))
+      {
+        // no code
+      }
+
+      double GetX(const GeoCoord& coord) const
+      {
+        return (coord.GetLon()-origin.GetLon())*lonFactor/cellSize;
+      }
+
+      double GetY(const GeoCoord& coord) const
+      {
+        return (coord.GetLat()-origin.GetLat())*metersPerDegree/cellSize;
+      }
+
+      GeoCoord GetCoord(double x,
+                        double y) const
+      {
+        return GeoCoord(origin.GetLat()+y*cellSize/metersPerDegree,
+                        origin.GetLon()+x*cellSize/lonFactor);
+      }
+    };
+
+    /**
+     * Rectangular grid of cells, cell (0,0) is the cell at (minX,minY) in projected
+     * cell units
+     */
+    struct Grid
+    {
+      int32_t              minX;
+      int32_t              minY;
+      int32_t              width;
+      int32_t              height;
+      std::vector<uint8_t> cells;
+
+      Grid(int32_t minX,
+           int32_t minY,
+           int32_t width,
+           int32_t height)
+      : minX(minX),
+        minY(minY),
+        width(width),
+        height(height),
+        cells(size_t(width)*size_t(height),0)
+      {
+        // no code
+      }
+
+      bool IsFilled(int32_t x,
+                    int32_t y) const
+      {
+        return x>=0 && y>=0 && x<width && y<height &&
+               cells[size_t(y)*size_t(width)+size_t(x)]!=0;
+      }
+
+      void Fill(int32_t x,
+                int32_t y)
+      {
+        if (x>=0 && y>=0 && x<width && y<height) {
+          cells[size_t(y)*size_t(width)+size_t(x)]=1;
+        }
+      }
+    };
+
+    /**
+     * Boundary edge of length 1 between a filled cell (to the left) and an empty cell
+     * (to the right)
+     */
+    struct Edge
+    {
+      int32_t x;         //!< Start vertex
+      int32_t y;
+      size_t  direction; //!< Index into directionX/directionY
+      bool    used=false;
+    };
+
+    /**
+     * Return the fraction of the segment within the given limits or a negative value,
+     * if already its start is beyond the limits
+     */
+    double GetReachableFraction(const Segment& segment,
+                                double maxDistance,
+                                double maxDuration)
+    {
+      if (segment.fromDistance>maxDistance ||
+          segment.fromDuration>maxDuration) {
+        return -1.0;
+      }
+
+      double fraction=1.0;
+
+      if (segment.toDistance>maxDistance) {
+        fraction=std::min(fraction,(maxDistance-segment.fromDistance)/(segment.toDistance-segment.fromDistance));
+      }
+
+      if (segment.toDuration>maxDuration) {
+        fraction=std::min(fraction,(maxDuration-segment.fromDuration)/(segment.toDuration-segment.fromDuration));
+      }
+
+      return fraction;
+    }
+
+    /**
+     * Fill all cells the given fraction of the segment passes. The cells are visited
+     * in order of the segment crossing their borders, so consecutive cells
+     * always share an edge and a path never breaks up into cells only touching
+     * at a corner.
+     */
+    void RasterizeSegment(const GridProjection& projection,
+                          const Segment& segment,
+                          double fraction,
+                          Grid& grid)
+    {
+      double  fromX=projection.GetX(segment.from)-grid.minX;
+      double  fromY=projection.GetY(segment.from)-grid.minY;
+      double  deltaX=(projection.GetX(segment.to)-grid.minX-fromX)*fraction;
+      double  deltaY=(projection.GetY(segment.to)-grid.minY-fromY)*fraction;
+      int32_t x=int32_t(std::floor(fromX));
+      int32_t y=int32_t(std::floor(fromY));
+      int32_t stepX=deltaX>=0.0 ? 1 : -1;
+      int32_t stepY=deltaY>=0.0 ? 1 : -1;
+      size_t  steps=size_t(std::abs(int32_t(std::floor(fromX+deltaX))-x)+
+                           std::abs(int32_t(std::floor(fromY+deltaY))-y));
+      // Fraction of the segment at the next vertical/horizontal cell border and between two of them
+      double  nextX=deltaX!=0.0 ? (stepX>0 ? x+1-fromX : fromX-x)/std::abs(deltaX) : std::numeric_limits<double>::infinity();
+      double  nextY=deltaY!=0.0 ? (stepY>0 ? y+1-fromY : fromY-y)/std::abs(deltaY) : std::numeric_limits<double>::infinity();
+      double  distanceX=deltaX!=0.0 ? 1.0/std::abs(deltaX) : std::numeric_limits<double>::infinity();
+      double  distanceY=deltaY!=0.0 ? 1.0/std::abs(deltaY) : std::numeric_limits<double>::infinity();
+
+      grid.Fill(x,y);
+
+      for (size_t step=0; step<steps; step++) {
+        if (nextX<nextY) {
+          x+=stepX;
+          nextX+=distanceX;
+        }
+        else {
+          y+=stepY;
+          nextY+=distanceY;
+        }
+
+        grid.Fill(x,y);
+      }
+    }
+
+    /**
+     * Morphological closing (dilation followed by erosion) with the 8 neighbours
+     * of a cell. Closes gaps of a single cell between neighbouring paths without
+     * growing the filled area at its border.
+     */
+    void CloseGrid(Grid& grid)
+    {
+      Grid dilated(grid.minX,grid.minY,grid.width,grid.height);
+
+      for (int32_t y=0; y<grid.height; y++) {
+        for (int32_t x=0; x<grid.width; x++) {
+          for (int32_t dy=-1; dy<=1 && !dilated.IsFilled(x,y); dy++) {
+            for (int32_t dx=-1; dx<=1; dx++) {
+              if (grid.IsFilled(x+dx,y+dy)) {
+                dilated.Fill(x,y);
+                break;
+              }
+            }
+          }
+        }
+      }
+
+      for (int32_t y=0; y<grid.height; y++) {
+        for (int32_t x=0; x<grid.width; x++) {
+          bool filled=true;
+
+          for (int32_t dy=-1; dy<=1 && filled; dy++) {
+            for (int32_t dx=-1; dx<=1; dx++) {
+              if (!dilated.IsFilled(x+dx,y+dy)) {
+                filled=false;
+                break;
+              }
+            }
+          }
+
+          if (filled) {
+            grid.Fill(x,y);
+          }
+        }
+      }
+    }
+
+    double GetSignedArea(const std::vector<std::pair<int32_t,int32_t>>& ring)
+    {
+      double area=0.0;
+
+      for (size_t i=0; i<ring.size(); i++) {
+        const auto& a=ring[i];
+        const auto& b=ring[(i+1)%ring.size()];
+
+        area+=double(a.first)*double(b.second)-double(b.first)*double(a.second);
+      }
+
+      return area/2.0;
+    }
+
+    bool IsInRing(double x,
+                  double y,
+                  const std::vector<std::pair<int32_t,int32_t>>& ring)
+    {
+      bool inside=false;
+
+      for (size_t i=0, j=ring.size()-1; i<ring.size(); j=i++) {
+        double xi=ring[i].first;
+        double yi=ring[i].second;
+        double xj=ring[j].first;
+        double yj=ring[j].second;
+
+        if ((yi>y)!=(yj>y) &&
+            x<(xj-xi)*(y-yi)/(yj-yi)+xi) {
+          inside=!inside;
+        }
+      }
+
+      return inside;
+    }
+
+    /**
+     * Trace the boundaries of the filled cells. Outer rings are traced counterclockwise,
+     * holes clockwise. Where two filled cells only touch at a corner, the boundary
+     * turns left, so the cells end up in separate rings. Vertices with collinear
+     * edges are dropped.
+     */
+    std::vector<IsochronePolygon> PolygonizeGrid(const GridProjection& projection,
+                                                 const Grid& grid)
+    {
+      using Ring = std::vector<std::pair<int32_t,int32_t>>;
+
+      std::vector<Edge>                                edges;
+      std::unordered_map<uint64_t,std::vector<size_t>> outgoing; // start vertex => edges
+
+      auto GetVertexKey=[](int32_t x, int32_t y) {
+        return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(y));
+      };
+
+      auto AddEdge=[&](int32_t x, int32_t y, size_t direction) {
+        outgoing[GetVertexKey(x,y)].push_back(edges.size());
+        edges.push_back(Edge{x,y,direction});
+      };
+
+      for (int32_t y=0; y<grid.height; y++) {
+        for (int32_t x=0; x<grid.width; x++) {
+          if (!grid.IsFilled(x,y)) {
+            continue;
+          }
+
+          if (!grid.IsFilled(x,y-1)) {
+            AddEdge(x,y,0);
+          }
+
+          if (!grid.IsFilled(x+1,y)) {
+            AddEdge(x+1,y,1);
+          }
+
+          if (!grid.IsFilled(x,y+1)) {
+            AddEdge(x+1,y+1,2);
+          }
+
+          if (!grid.IsFilled(x-1,y)) {
+            AddEdge(x,y+1,3);
+          }
+        }
+      }
+
+      std::vector<Ring>                   outers;
+      std::vector<std::pair<Ring,size_t>> holes; // ring, index of its first edge
+
+      for (size_t first=0; first<edges.size(); first++) {
+        if (edges[first].used) {
+          continue;
+        }
+
+        Ring   ring;
+        size_t current=first;
+
+        do {
+          Edge&   edge=edges[current];
+          int32_t endX=edge.x+directionX[edge.direction];
+          int32_t endY=edge.y+directionY[edge.direction];
+          size_t  next=edges.size();
+
+          edge.used=true;
+
+          // left turn, straight on, right turn
+          for (size_t turn : {1,0,3}) {
+            size_t direction=(edge.direction+turn)%4;
+
+            for (size_t candidate : outgoing[GetVertexKey(endX,endY)]) {
+              if (edges[candidate].direction==direction) {
+                next=candidate;
+                break;
+              }
+            }
+
+            if (next!=edges.size()) {
+              break;
+            }
+          }
+
+          assert(next!=edges.size());
+
+          if (edges[next].direction!=edge.direction) {
+            ring.emplace_back(endX,endY);
+          }
+
+          current=next;
+        } while (current!=first);
+
+        if (GetSignedArea(ring)>0.0) {
+          outers.push_back(std::move(ring));
+        }
+        else {
+          holes.emplace_back(std::move(ring),first);
+        }
+      }
+
+      auto ToCoords=[&](const Ring& ring) {
+        std::vector<GeoCoord> coords;
+
+        coords.reserve(ring.size());
+
+        for (const auto& [x,y] : ring) {
+          coords.push_back(projection.GetCoord(double(x+grid.minX),
+                                               double(y+grid.minY)));
+        }
+
+        return coords;
+      };
+
+      std::vector<IsochronePolygon> polygons(outers.size());
+
+      for (size_t i=0; i<outers.size(); i++) {
+        polygons[i].outer=ToCoords(outers[i]);
+      }
+
+      for (const auto& [hole,firstEdge] : holes) {
+        // Center of the empty cell right of the first edge, inside the hole
+        const Edge& edge=edges[firstEdge];
+        double      x=edge.x+0.5*directionX[edge.direction]+0.5*directionY[edge.direction];
+        double      y=edge.y+0.5*directionY[edge.direction]-0.5*directionX[edge.direction];
+        size_t      outer=outers.size();
+        double      outerArea=std::numeric_limits<double>::max();
+
+        for (size_t i=0; i<outers.size(); i++) {
+          double area=GetSignedArea(outers[i]);
+
+          if (area<outerArea &&
+              IsInRing(x,y,outers[i])) {
+            outer=i;
+            outerArea=area;
+          }
+        }
+
+        if (outer<outers.size()) {
+          polygons[outer].holes.push_back(ToCoords(hole));
+        }
+      }
+
+      return polygons;
+    }
+  }
+
+  IsochroneService::IsochroneService(const DatabaseRef& database,
+                                     const RouterParameter& parameter,
+                                     const std::string& filenamebase)
+  : SimpleRoutingService(database,
+                         parameter,
+                         filenamebase)
+  {
+    // no code
+  }
+
+  IsochroneService::~IsochroneService()
+  {
+    // no code
+  }
+
+  /**
+   * Calculate the isochrones of the given budgets around the given start position.
+   *
+   * @param profile
+   *    Profile to use
+   * @param start
+   *    Start position as returned by GetClosestRoutableNode()
+   * @param budgets
+   *    Budgets to calculate an isochrone for. Either all budgets limit the duration or
+   *    all limit the distance, additional limits are optional.
+   * @param cellSize
+   *    Size of the grid cells the isochrone polygons are traced from. Paths of the
+   *    routing graph closer to each other than the cell size are merged. Cell sizes
+   *    resulting in more than 16 million cells for the reachable area are rejected.
+   * @param parameter
+   *    A RoutingParamater object
+   * @return
+   *    An IsochroneResult object, not successful on errors or if the calculation was aborted
+   */
+  IsochroneResult IsochroneService::CalculateIsochrones(const RoutingProfile& profile,
+                                                        const RoutePosition& start,
+                                                        const std::vector<IsochroneBudget>& budgets,
+                                                        const Distance& cellSize,
+                                                        const RoutingParameter& parameter)
+  {
+    IsochroneResult                     result;
+    MatrixPosition                      source;
+    MatrixSearch                        search;
+    const std::unordered_map<Id,size_t> noTargets;
+    StopClock                           clock;
+
+    if (budgets.empty()) {
+      log.Error() << "No isochrone budget given";
+      return result;
+    }
+
+    if (cellSize.AsMeter()<=0.0) {
+      log.Error() << "Isochrone cell size must be positive";
+      return result;
+    }
+
+    search.maxDistance=0.0;
+    search.maxDuration=0.0;
+
+    for (const auto& budget : budgets) {
+      search.maxDistance=std::max(search.maxDistance,
+                                  budget.distance ? budget.distance->As<Kilometer>() : std::numeric_limits<double>::infinity());
+      search.maxDuration=std::max(search.maxDuration,
+                                  budget.duration ? DurationAsHours(*budget.duration) : std::numeric_limits<double>::infinity());
+    }
+
+    if (std::isinf(search.maxDistance) &&
+        std::isinf(search.maxDuration)) {
+      log.Error() << "Isochrone budgets must all limit the duration or all limit the distance";
+      return result;
+    }
+
+    search.collect=true;
+
+    try {
+      if (!GetMatrixPosition(profile,
+                             start,
+                             true,
+                             source)) {
+        return result;
+      }
+
+      if (!SearchOneToMany(profile,
+                           source,
+                           noTargets,
+                           parameter,
+                           search)) {
+        return result;
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return result;
+    }
+
+    GeoCoord                                startCoord=source.way->nodes[start.GetNodeIndex()].GetCoord();
+    std::unordered_map<Id,const MatrixNode*> labels; // route node id => label with the shortest duration
+    std::vector<Segment>                     segments;
+
+    for (const auto* node : search.settled) {
+      auto [entry,inserted]=labels.emplace(node->id.id,node);
+
+      if (!inserted &&
+          node->duration<entry->second->duration) {
+        entry->second=node;
+      }
+    }
+
+    for (const auto& endpoint : source.endpoints) {
+      segments.push_back(Segment{startCoord,
+                                 endpoint.routeNode->GetCoord(),
+                                 0.0,
+                                 0.0,
+                                 endpoint.distance,
+                                 endpoint.duration});
+    }
+
+    for (const auto* node : search.settled) {
+      if (!node->prev.IsValid()) {
+        continue;
+      }
+
+      auto prev=labels.find(node->prev.id);
+
+      if (prev==labels.end()) {
+        continue;
+      }
+
+      segments.push_back(Segment{prev->second->node->GetCoord(),
+                                 node->node->GetCoord(),
+                                 prev->second->distance,
+                                 prev->second->duration,
+                                 node->distance,
+                                 node->duration});
+    }
+
+    for (const auto& exit : search.exits) {
+      segments.push_back(Segment{exit.from->node->GetCoord(),
+                                 Point::GetCoordFromId(exit.to),
+                                 exit.from->distance,
+                                 exit.from->duration,
+                                 exit.distance,
+                                 exit.duration});
+    }
+
+    GridProjection projection(startCoord,
+                              cellSize);
+    double         minX=0.0;
+    double         minY=0.0;
+    double         maxX=0.0;
+    double         maxY=0.0;
+
+    for (const auto& segment : segments) {
+      for (const auto& coord : {segment.from,segment.to}) {
+        minX=std::min(minX,projection.GetX(coord));
+        minY=std::min(minY,projection.GetY(coord));
+        maxX=std::max(maxX,projection.GetX(coord));
+        maxY=std::max(maxY,projection.GetY(coord));
+      }
+    }
+
+    // The cells are allocated per budget, so reject cell sizes far too small for the extent
+    // (this also keeps the grid dimensions in the range of int32_t)
+    if ((std::ceil(maxX)-std::floor(minX)+5.0)*(std::ceil(maxY)-std::floor(minY)+5.0)>maxGridCells) {
+      log.Error() << "Isochrone cell size " << cellSize.AsMeter() << "m is too small for the reachable area";
+      return result;
+    }
+
+    // Margin of two cells, so that the closing and the tracing never touch the border
+    int32_t gridMinX=int32_t(std::floor(minX))-2;
+    int32_t gridMinY=int32_t(std::floor(minY))-2;
+    int32_t gridWidth=int32_t(std::ceil(maxX))+2-gridMinX+1;
+    int32_t gridHeight=int32_t(std::ceil(maxY))+2-gridMinY+1;
+
+    for (const auto& budget : budgets) {
+      double    maxDistance=budget.distance ? budget.distance->As<Kilometer>() : std::numeric_limits<double>::infinity();
+      double    maxDuration=budget.duration ? DurationAsHours(*budget.duration) : std::numeric_limits<double>::infinity();
+      Grid      grid(gridMinX,gridMinY,gridWidth,gridHeight);
+      Isochrone isochrone;
+
+      for (const auto& segment : segments) {
+        double fraction=GetReachableFraction(segment,
+                                             maxDistance,
+                                             maxDuration);
+
+        if (fraction>=0.0) {
+          RasterizeSegment(projection,
+                           segment,
+                           fraction,
+                           grid);
+        }
+      }
+
+      CloseGrid(grid);
+
+      isochrone.budget=budget;
+      isochrone.polygons=PolygonizeGrid(projection,
+                                        grid);
+
+      result.GetIsochrones().push_back(std::move(isochrone));
+    }
+
+    result.GetNodes().reserve(labels.size());
+
+    for (const auto& [id,node] : labels) {
+      result.GetNodes().push_back(IsochroneNode{id,
+                                                node->node->GetCoord(),
+                                                Kilometers(node->distance),
+                                                DurationOfHours(node->duration)});
+    }
+
+    std::sort(result.GetNodes().begin(),
+              result.GetNodes().end(),
+              [](const IsochroneNode& a, const IsochroneNode& b) {
+                return a.duration<b.duration || (a.duration==b.duration && a.id<b.id);
+              });
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Isochrones:          " << budgets.size() << " with " << segments.size() << " segments on " << gridWidth << "x" << gridHeight << " cells" << std::endl;
+      std::cout << "Route nodes:         " << result.GetNodes().size() << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+    }
+
+    result.SetSuccess(true);
+
+    return result;
+  }
+}
@@ -384,6 +384,41 @@ namespace osmscout {
     return twins;
   }
 
+  bool MultiDBRoutingService::GetJunctionObjects(const DBId& id,
+                                                 std::vector<ObjectFileRef>& objects)
+  {
+    assert(handles.size()>id.database);
+
+    JunctionRef junction;
+
+    objects.clear();
+
+    // Nodes without junction entry are only passed by the objects of their paths
+    if (handles[id.database].routingDatabase->GetJunction(id.id,junction)) {
+      objects=junction->GetObjects();
+    }
+
+    return true;
+  }
+
+  bool MultiDBRoutingService::GetCachedIncomingPaths(const DBId& id,
+                                                     std::vector<RoutingDatabase::IncomingPath>& paths)
+  {
+    assert(handles.size()>id.database);
+
+    return handles[id.database].routingDatabase->GetIncomingPaths(id.id,
+                                                                  paths);
+  }
+
+  void MultiDBRoutingService::CacheIncomingPaths(const DBId& id,
+                                                 const std::vector<RoutingDatabase::IncomingPath>& paths)
+  {
+    assert(handles.size()>id.database);
+
+    handles[id.database].routingDatabase->SetIncomingPaths(id.id,
+                                                           paths);
+  }
+
   RoutingResult MultiDBRoutingService::CalculateRoute(const RoutePosition &start,
                                                       const RoutePosition &target,
                                                       const std::optional<osmscout::Bearing> &bearing,
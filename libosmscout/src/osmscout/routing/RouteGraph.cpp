@@ -0,0 +1,327 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/RouteGraph.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#include <osmscout/io/FileWriter.h>
+
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+  //! All arrays start at a multiple of this offset, so they can be used in place
+  static const FileOffset arrayAlignment=8;
+
+  static FileOffset AlignOffset(FileOffset offset)
+  {
+    return (offset+arrayAlignment-1)/arrayAlignment*arrayAlignment;
+  }
+
+  /**
+   * Read the array of the given size starting at the next aligned offset
+   * after the given offset. The offset is moved behind the array.
+   *
+   * @throws IOException
+   */
+  template<typename T>
+  void RouteGraph::Array<T>::Read(FileScanner& scanner,
+                                  FileOffset& offset,
+                                  size_t count)
+  {
+    offset=AlignOffset(offset);
+
+    if (offset+count*sizeof(T)>scanner.GetSize()) {
+      throw IOException(scanner.GetFilename(),"Cannot read array","Cannot read beyond end of file");
+    }
+
+    storage.clear();
+
+    // The file stores numbers in little endian byte order
+    if (scanner.IsMemoryMapped() &&
+        std::endian::native==std::endian::little) {
+      data=reinterpret_cast<const T*>(scanner.GetMapping().get()+offset);
+      offset+=count*sizeof(T);
+
+      return;
+    }
+
+    storage.resize(count);
+
+    if (count>0) {
+      scanner.SetPos(offset);
+    }
+
+    for (auto& value : storage) {
+      if constexpr (sizeof(T)==1) {
+        value=scanner.ReadUInt8();
+      }
+      else if constexpr (sizeof(T)==2) {
+        value=scanner.ReadUInt16();
+      }
+      else if constexpr (sizeof(T)==4) {
+        value=scanner.ReadUInt32();
+      }
+      else {
+        value=scanner.ReadUInt64();
+      }
+    }
+
+    data=storage.data();
+    offset+=count*sizeof(T);
+  }
+
+  template<typename T>
+  static void WriteArray(FileWriter& writer,
+                         const std::vector<T>& values)
+  {
+    FileOffset offset=writer.GetPos();
+
+    while (offset<AlignOffset(offset)) {
+      writer.Write(static_cast<uint8_t>(0));
+      offset++;
+    }
+
+    for (T value : values) {
+      writer.Write(value);
+    }
+  }
+
+  /**
+   * Open the graph from the given file. The file is memory mapped, if possible.
+   *
+   * @param filename
+   *    Name of the file containing the graph
+   * @return
+   *    True on success, else false
+   */
+  bool RouteGraph::Open(const std::string& filename)
+  {
+    FileScanner scanner;
+
+    Close();
+
+    try {
+      scanner.Open(filename,
+                   FileScanner::FastRandom,
+                   true);
+
+      uint32_t version=scanner.ReadUInt32();
+
+      if (version!=FILE_FORMAT_VERSION) {
+        log.Error() << "File '" << filename << "' has format version " << version << ", expected " << FILE_FORMAT_VERSION;
+        scanner.Close();
+        return false;
+      }
+
+      nodeCount=scanner.ReadUInt32();
+      edgeCount=scanner.ReadUInt32();
+
+      FileOffset offset=scanner.GetPos();
+
+      nodeIds.Read(scanner,offset,nodeCount);
+      nodeLats.Read(scanner,offset,nodeCount);
+      nodeLons.Read(scanner,offset,nodeCount);
+      nodesById.Read(scanner,offset,nodeCount);
+      firstEdges.Read(scanner,offset,nodeCount+1);
+      edgeTargets.Read(scanner,offset,edgeCount);
+      edgeDistances.Read(scanner,offset,edgeCount);
+      edgeVariants.Read(scanner,offset,edgeCount);
+      edgeFlags.Read(scanner,offset,edgeCount);
+      edgeObjectOffsets.Read(scanner,offset,edgeCount);
+      edgeObjectTypes.Read(scanner,offset,edgeCount);
+
+      if (firstEdges[nodeCount]!=edgeCount) {
+        throw IOException(filename,"Cannot read graph","Edge index does not match edge count");
+      }
+
+      mapping=scanner.IsMemoryMapped() ? scanner.GetMapping() : nullptr;
+
+      // The mapping stays valid after closing the scanner
+      scanner.Close();
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+      Close();
+
+      return false;
+    }
+
+    return true;
+  }
+
+  void RouteGraph::Close()
+  {
+    nodeCount=0;
+    edgeCount=0;
+
+    nodeIds=Array<uint64_t>();
+    nodeLats=Array<uint32_t>();
+    nodeLons=Array<uint32_t>();
+    nodesById=Array<uint32_t>();
+    firstEdges=Array<uint32_t>();
+    edgeTargets=Array<uint32_t>();
+    edgeDistances=Array<uint32_t>();
+    edgeVariants=Array<uint16_t>();
+    edgeFlags=Array<uint8_t>();
+    edgeObjectOffsets=Array<uint64_t>();
+    edgeObjectTypes=Array<uint8_t>();
+
+    mapping=nullptr;
+  }
+
+  /**
+   * Return the index of the node with the given route node id or noNode,
+   * if the route node is not part of the graph
+   */
+  uint32_t RouteGraph::GetNodeIndex(Id id) const
+  {
+    const uint32_t* begin=nodesById.data;
+    const uint32_t* end=nodesById.data+nodeCount;
+    const uint32_t* entry=std::lower_bound(begin,
+                                           end,
+                                           id,
+                                           [this](uint32_t node, Id id) {
+                                             return nodeIds[node]<id;
+                                           });
+
+    if (entry==end ||
+        nodeIds[*entry]!=id) {
+      return noNode;
+    }
+
+    return *entry;
+  }
+
+  /**
+   * Store the graph to the given file.
+   *
+   * @param filename
+   *    Name of the file to write
+   * @param nodes
+   *    The nodes in the order of their index
+   * @param firstEdges
+   *    Index of the first edge of each node in edges, plus the number of edges
+   * @param edges
+   *    The edges of all nodes, ordered by node
+   * @return
+   *    True on success, else false
+   */
+  bool RouteGraph::Store(const std::string& filename,
+                         const std::vector<Node>& nodes,
+                         const std::vector<uint32_t>& firstEdges,
+                         const std::vector<Edge>& edges)
+  {
+    assert(firstEdges.size()==nodes.size()+1);
+    assert(firstEdges.back()==edges.size());
+
+    std::vector<uint64_t> nodeIds;
+    std::vector<uint32_t> nodeLats;
+    std::vector<uint32_t> nodeLons;
+    std::vector<uint32_t> nodesById(nodes.size());
+
+    nodeIds.reserve(nodes.size());
+    nodeLats.reserve(nodes.size());
+    nodeLons.reserve(nodes.size());
+
+    for (const auto& node : nodes) {
+      nodeIds.push_back(node.id);
+      nodeLats.push_back(static_cast<uint32_t>(std::round((node.coord.GetLat()+90.0)*latConversionFactor)));
+      nodeLons.push_back(static_cast<uint32_t>(std::round((node.coord.GetLon()+180.0)*lonConversionFactor)));
+    }
+
+    for (uint32_t node=0; node<nodesById.size(); node++) {
+      nodesById[node]=node;
+    }
+
+    std::sort(nodesById.begin(),
+              nodesById.end(),
+              [&nodes](uint32_t a, uint32_t b) {
+                return nodes[a].id<nodes[b].id;
+              });
+
+    std::vector<uint32_t> edgeTargets;
+    std::vector<uint32_t> edgeDistances;
+    std::vector<uint16_t> edgeVariants;
+    std::vector<uint8_t>  edgeFlags;
+    std::vector<uint64_t> edgeObjectOffsets;
+    std::vector<uint8_t>  edgeObjectTypes;
+
+    edgeTargets.reserve(edges.size());
+    edgeDistances.reserve(edges.size());
+    edgeVariants.reserve(edges.size());
+    edgeFlags.reserve(edges.size());
+    edgeObjectOffsets.reserve(edges.size());
+    edgeObjectTypes.reserve(edges.size());
+
+    for (const auto& edge : edges) {
+      assert(edge.target<nodes.size());
+
+      edgeTargets.push_back(edge.target);
+      // Same rounding as in the route node data file
+      edgeDistances.push_back(static_cast<uint32_t>(std::floor(edge.distance.As<Kilometer>()*(1000.0*100.0)+0.5)));
+      edgeVariants.push_back(edge.objectVariantIndex);
+      edgeFlags.push_back(edge.flags);
+      edgeObjectOffsets.push_back(edge.object.GetFileOffset());
+      edgeObjectTypes.push_back(static_cast<uint8_t>(edge.object.GetType()));
+    }
+
+    FileWriter writer;
+
+    try {
+      writer.Open(filename);
+
+      writer.Write(FILE_FORMAT_VERSION);
+      writer.Write(static_cast<uint32_t>(nodes.size()));
+      writer.Write(static_cast<uint32_t>(edges.size()));
+
+      WriteArray(writer,nodeIds);
+      WriteArray(writer,nodeLats);
+      WriteArray(writer,nodeLons);
+      WriteArray(writer,nodesById);
+      WriteArray(writer,firstEdges);
+      WriteArray(writer,edgeTargets);
+      WriteArray(writer,edgeDistances);
+      WriteArray(writer,edgeVariants);
+      WriteArray(writer,edgeFlags);
+      WriteArray(writer,edgeObjectOffsets);
+      WriteArray(writer,edgeObjectTypes);
+
+      writer.Close();
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+
+      return false;
+    }
+
+    return true;
+  }
+
+  std::string RouteGraph::GetFilename(const std::string& filenamebase)
+  {
+    return filenamebase+"-graph.dat";
+  }
+}
@@ -21,33 +21,12 @@
 
 namespace osmscout {
 
-  RouteNodeRef RouteNodeDataFile::IndexPage::find(FileScanner& scanner,
-                                                  Id id)
+  RouteNodeRef RouteNodeDataFile::IndexPage::find(Id id) const
   {
-    if (!nodeMap.empty()) {
-      auto nodeEntry=nodeMap.find(id);
+    auto nodeEntry=nodeMap.find(id);
 
-      if (nodeEntry!=nodeMap.end()) {
-        return nodeEntry->second;
-      }
-    }
-
-    if (remaining>0) {
-      scanner.SetPos(fileOffset);
-
-      while (remaining>0) {
-        remaining--;
-        RouteNodeRef node=std::make_shared<RouteNode>();
-
-        node->Read(scanner);
-        nodeMap.emplace(node->GetId(),node);
-
-        fileOffset=scanner.GetPos();
-
-        if (node->GetId()==id) {
-          return node;
-        }
-      }
+    if (nodeEntry!=nodeMap.end()) {
+      return nodeEntry->second;
     }
 
     return nullptr;
@@ -136,8 +115,26 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Let the page cache draw from the given memory budget (in addition to the
+   * page count limit of the cache size). The cache is flushed.
+   *
+   * Method is NOT thread-safe.
+   */
+  void RouteNodeDataFile::SetMemoryBudget(const MemoryBudgetRef& budget)
+  {
+    cache.SetMemoryBudget(budget,
+                          datafile,
+                          std::make_shared<IndexPageMemorySizer>());
+  }
+
+  /**
+   * Load all route nodes of the given tile and add the page to the cache.
+   *
+   * The caller must hold the access mutex.
+   */
   bool RouteNodeDataFile::LoadIndexPage(const osmscout::Pixel& tile,
-                                        ValueCache::CacheRef& cacheRef) const
+                                        IndexPageRef& page) const
   {
     assert(IsOpen());
 
@@ -147,49 +144,76 @@ namespace osmscout {
       return false;
     }
 
-    ValueCache::CacheEntry cacheEntry(tile.GetId());
+    page=std::make_shared<IndexPage>();
 
-    cacheEntry.value.fileOffset=entry->second.fileOffset;
-    cacheEntry.value.remaining=entry->second.count;
+    try {
+      scanner.SetPos(entry->second.fileOffset);
 
-    cacheRef=cache.SetEntry(cacheEntry);
+      page->nodeMap.reserve(entry->second.count);
+
+      for (uint32_t i=0; i<entry->second.count; i++) {
+        RouteNodeRef node=std::make_shared<RouteNode>();
+
+        node->Read(scanner);
+        page->nodeMap.emplace(node->GetId(),node);
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      page=nullptr;
+      return false;
+    }
+
+    cache.SetEntry(tile.GetId(),
+                   page);
 
     return true;
   }
 
+  /**
+   * Return the page of the given tile. Pages in the cache are returned without
+   * locking, so multiple threads can read cached route nodes concurrently.
+   * Missing pages are loaded while holding the access mutex.
+   */
   bool RouteNodeDataFile::GetIndexPage(const osmscout::Pixel& tile,
-                                       ValueCache::CacheRef& cacheRef) const
+                                       IndexPageRef& page) const
   {
-    if (!cache.GetEntry(tile.GetId(),
-                        cacheRef)) {
-      //std::cout << "RouteNodeDF::GetIndexPage() Not fond in cache, loading...!" << std::endl;
-      if (!LoadIndexPage(tile,
-                         cacheRef)) {
-        return false;
-      }
+    if (cache.GetEntry(tile.GetId(),
+                       page)) {
+      return true;
     }
 
-    return true;
+    std::lock_guard<std::mutex> lock(accessMutex);
+
+    // The page may have been loaded by another thread in the meantime
+    if (cache.GetEntry(tile.GetId(),
+                       page)) {
+      return true;
+    }
+
+    return LoadIndexPage(tile,
+                         page);
   }
 
+  /**
+   * Return the route node with the given id.
+   *
+   * Method is thread-safe.
+   */
   bool RouteNodeDataFile::Get(Id id,
                               RouteNodeRef& node) const
   {
-    //std::cout << "Loading RouteNode " << id << "..." << std::endl;
-    ValueCache::CacheRef cacheRef;
+    IndexPageRef page;
 
     GeoCoord coord=Point::GetCoordFromId(id);
     TileId   tile=TileId::GetTile(magnification,coord);
 
-    //std::cout << "Tile " << tile.GetDisplayText() << " " << tile.GetId() << "..." << std::endl;
-
     if (!GetIndexPage(tile.AsPixel(),
-                      cacheRef)) {
+                      page)) {
       return false;
     }
 
-    node=cacheRef->value.find(scanner,
-                              id);
+    node=page->find(id);
 
     return node!=nullptr;
   }
@@ -31,7 +31,8 @@ namespace osmscout {
                      /*indexCacheSize*/
                      10000,
                      /*dataCacheSize*/
-                     1000)
+                     1000),
+    incomingPathCache(incomingPathCacheSize)
   {
   }
 
@@ -40,6 +41,13 @@ namespace osmscout {
     typeConfig=database->GetTypeConfig();
     path=database->GetPath();
 
+    routeNodeDataFile.SetMemoryBudget(database->GetMemoryBudget());
+    junctionDataFile.SetMemoryBudget(database->GetMemoryBudget());
+    junctionDataFile.SetFileDescriptorPool(database->GetFileDescriptorPool());
+    incomingPathCache.SetMemoryBudget(database->GetMemoryBudget(),
+                                      "incoming paths",
+                                      std::make_shared<IncomingPathMemorySizer>());
+
     if (!routeNodeDataFile.Open(database->GetTypeConfig(),
                           database->GetPath(),
                           database->GetParameter().GetRouterDataMMap())) {
@@ -56,14 +64,45 @@ namespace osmscout {
   {
     routeNodeDataFile.Close();
     junctionDataFile.Close();
+    incomingPathCache.Flush();
 
     typeConfig.reset();
     path.clear();
   }
 
+  /**
+   * Return the junction with the given route node id. In contrast to GetJunctions()
+   * the junction file is kept open for further calls, since the method is used
+   * during routing.
+   *
+   * Method is thread-safe.
+   *
+   * @return
+   *    False, if there is no junction with the given id or on error
+   */
+  bool RoutingDatabase::GetJunction(Id id,
+                                    JunctionRef& junction)
+  {
+    std::lock_guard<std::mutex> lock(junctionMutex);
+
+    if (!junctionDataFile.IsOpen()) {
+      if (!junctionDataFile.Open(typeConfig,
+                                 path,
+                                 false,
+                                 false)) {
+        return false;
+      }
+    }
+
+    return junctionDataFile.Get(id,
+                                junction);
+  }
+
   bool RoutingDatabase::GetJunctions(const std::set<Id>& ids,
                                      std::vector<JunctionRef>& junctions)
   {
+    std::lock_guard<std::mutex> lock(junctionMutex);
+
     if (!junctionDataFile.IsOpen()) {
       if (!junctionDataFile.Open(typeConfig,
                                  path,
@@ -19,7 +19,9 @@
 
 #include <osmscout/routing/RoutingProfile.h>
 
+#include <algorithm>
 #include <limits>
+#include <typeinfo>
 
 #include <osmscout/log/Logger.h>
 
@@ -210,6 +212,62 @@ namespace osmscout {
     return typeIndex<speeds.size() && speeds[typeIndex][grade]>0.0;
   }
 
+  Duration AbstractRoutingProfile::GetTime(const RouteNode& currentNode,
+                                           const std::vector<ObjectVariantData>& objectVariantData,
+                                           size_t pathIndex) const
+  {
+    const RouteNode::Path&   path=currentNode.paths[pathIndex];
+    const ObjectVariantData& variant=objectVariantData[currentNode.objects[path.objectIndex].objectVariantIndex];
+
+    double speed=std::min(vehicleMaxSpeed,
+                          speeds[variant.type->GetIndex()][static_cast<Grade>(variant.grade)]);
+
+    if (variant.maxSpeed>0 &&
+        speed>variant.maxSpeed) {
+      speed=variant.maxSpeed;
+    }
+
+    if (speed<=0.0) {
+      return Duration::max();
+    }
+
+    return DurationOfHours(path.distance.As<Kilometer>()/speed);
+  }
+
+  /**
+   * Return the properties of the given object variants, using the maximum speed
+   * of vehicle, type, grade and variant as speed of the costs
+   */
+  std::vector<CompiledRoutingProfile::Variant> AbstractRoutingProfile::CompileVariants(const std::vector<ObjectVariantData>& objectVariantData) const
+  {
+    std::vector<CompiledRoutingProfile::Variant> variants(objectVariantData.size());
+
+    for (size_t i=0; i<objectVariantData.size(); i++) {
+      const ObjectVariantData&         variantData=objectVariantData[i];
+      CompiledRoutingProfile::Variant& variant=variants[i];
+
+      variant.typeIndex=variantData.type->GetIndex();
+
+      if (variant.typeIndex>=speeds.size()) {
+        continue;
+      }
+
+      double speed=speeds[variant.typeIndex][static_cast<Grade>(variantData.grade)];
+
+      variant.usable=speed>0.0;
+
+      if (variantData.maxSpeed>0 &&
+          speed>variantData.maxSpeed) {
+        speed=variantData.maxSpeed;
+      }
+
+      variant.penaltySpeed=speed;
+      variant.speed=std::min(vehicleMaxSpeed,speed);
+    }
+
+    return variants;
+  }
+
   bool AbstractRoutingProfile::CanUse(const Area& area) const
   {
     if (area.rings.size()!=1) {
@@ -370,9 +428,52 @@ ShortestPathRoutingProfile::ShortestPathRoutingProfile(const TypeConfigRef& type
     // no code
   }
 
+  bool ShortestPathRoutingProfile::Compile(const std::vector<ObjectVariantData>& objectVariantData,
+                                           CompiledRoutingProfile& compiled) const
+  {
+    // Subclasses may override CanUse() or GetCosts(), the compiled profile would bypass them
+    if (typeid(*this)!=typeid(ShortestPathRoutingProfile)) {
+      return false;
+    }
+
+    std::vector<CompiledRoutingProfile::Variant> variants=CompileVariants(objectVariantData);
+
+    // The costs are the distance
+    for (auto& variant : variants) {
+      variant.speed=1.0;
+    }
+
+    compiled=CompiledRoutingProfile();
+    compiled.SetVehicleRouteNodeBit(vehicleRouteNodeBit);
+    compiled.SetVariants(std::move(variants));
+
+    return true;
+  }
+
   FastestPathRoutingProfile::FastestPathRoutingProfile(const TypeConfigRef& typeConfig)
   : AbstractRoutingProfile(typeConfig)
   {
     // no code
   }
+
+  bool FastestPathRoutingProfile::Compile(const std::vector<ObjectVariantData>& objectVariantData,
+                                          CompiledRoutingProfile& compiled) const
+  {
+    // Subclasses may override CanUse() or GetCosts(), the compiled profile would bypass them
+    if (typeid(*this)!=typeid(FastestPathRoutingProfile)) {
+      return false;
+    }
+
+    compiled=CompiledRoutingProfile();
+    compiled.SetVehicleRouteNodeBit(vehicleRouteNodeBit);
+    compiled.SetVariants(CompileVariants(objectVariantData));
+
+    if (applyJunctionPenalty) {
+      compiled.SetJunctionPenalty(penaltySameType,
+                                  penaltyDifferentType,
+                                  maxPenalty);
+    }
+
+    return true;
+  }
 }
@@ -70,6 +70,77 @@ namespace osmscout {
     this->progress=progress;
   }
 
+  /**
+   * If set to true, the route is searched by two A* searches, one from the start
+   * and one backwards from the target, meeting in the middle. This visits
+   * less route nodes for long routes. If the router does not support the
+   * bidirectional search for a query, it falls back to the unidirectional search.
+   */
+  void RoutingParameter::SetBidirectional(bool bidirectional)
+  {
+    this->bidirectional=bidirectional;
+  }
+
+  /**
+   * Number of worker threads used by many-to-many calculations like
+   * SimpleRoutingService::CalculateMatrix(). 0 (the default) uses one
+   * thread per hardware thread.
+   */
+  void RoutingParameter::SetThreadCount(size_t threadCount)
+  {
+    this->threadCount=threadCount;
+  }
+
+  /**
+   * Maximum number of alternative routes returned by
+   * AbstractRoutingService::CalculateAlternativeRoutes() in addition to the
+   * best route.
+   */
+  void RoutingParameter::SetAlternativeCount(size_t alternativeCount)
+  {
+    this->alternativeCount=alternativeCount;
+  }
+
+  /**
+   * Maximum additional costs of an alternative route relative to the costs
+   * of the best route, 0.25 allows alternatives with up to 125% of the costs.
+   */
+  void RoutingParameter::SetMaxStretch(double maxStretch)
+  {
+    this->maxStretch=maxStretch;
+  }
+
+  /**
+   * Maximum fraction of the distance of an alternative route shared with
+   * the best route or with any better alternative route.
+   */
+  void RoutingParameter::SetMaxSharing(double maxSharing)
+  {
+    this->maxSharing=maxSharing;
+  }
+
+  /**
+   * Minimum costs of the plateau of an alternative route relative to the costs
+   * of the best route. The plateau is the part of the route around its via
+   * node that is the cheapest route both from the start and to the target, so
+   * the route has no needless detours around the via node.
+   */
+  void RoutingParameter::SetMinPlateau(double minPlateau)
+  {
+    this->minPlateau=minPlateau;
+  }
+
+  /**
+   * Additional costs of the routes to the target covered by the tree of
+   * AbstractRoutingService::CalculateRerouteTree() relative to the costs
+   * of the route. Larger values let AbstractRoutingService::Reroute() reconnect
+   * faster after larger deviations, but need more time and memory for the tree.
+   */
+  void RoutingParameter::SetRerouteCorridor(double rerouteCorridor)
+  {
+    this->rerouteCorridor=rerouteCorridor;
+  }
+
   std::string RoutingService::GetDataFilename(const std::string& filenamebase)
   {
     return filenamebase+".dat";
@@ -20,6 +20,9 @@
 #include <iomanip>
 #include <iostream>
 #include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 #include <osmscout/system/Assert.h>
 
@@ -53,11 +56,43 @@ namespace osmscout {
      database(database),
      filenamebase(filenamebase),
      accessReader(*database->GetTypeConfig()),
-     isOpen(false)
+     isOpen(false),
+     routingDatabase(std::make_shared<RoutingDatabase>()),
+     sharedRoutingDatabase(false)
   {
     assert(database);
   }
 
+  /**
+   * Create a new instance of the routing service reading the routing data from the
+   * given routing database. The routing database must already be open and is not
+   * closed by the routing service. Multiple routing services (for example one per
+   * thread) can share the same routing database and with it the cache of loaded
+   * route nodes.
+   *
+   * @param database
+   *    A valid reference to a db instance
+   * @param parameter
+   *    An instance to the parameter object holding further paramterization
+   * @param routingDatabase
+   *    An open routing database of the given db instance
+   */
+  SimpleRoutingService::SimpleRoutingService(const DatabaseRef& database,
+                                             const RouterParameter& parameter,
+                                             const std::string& filenamebase,
+                                             const RoutingDatabaseRef& routingDatabase)
+   : AbstractRoutingService<RoutingProfile>(parameter),
+     database(database),
+     filenamebase(filenamebase),
+     accessReader(*database->GetTypeConfig()),
+     isOpen(false),
+     routingDatabase(routingDatabase),
+     sharedRoutingDatabase(true)
+  {
+    assert(database);
+    assert(routingDatabase);
+  }
+
   SimpleRoutingService::~SimpleRoutingService()
   {
     if (isOpen) {
@@ -86,7 +121,7 @@ namespace osmscout {
                                     const RouteNode& routeNode,
                                     size_t pathIndex)
   {
-    return profile.CanUse(routeNode,routingDatabase.GetObjectVariantData(),pathIndex);
+    return profile.CanUse(routeNode,routingDatabase->GetObjectVariantData(),pathIndex);
   }
 
   bool SimpleRoutingService::CanUseForward(const RoutingProfile& profile,
@@ -109,7 +144,7 @@ namespace osmscout {
                                         size_t inPathIndex,
                                         size_t outPathIndex)
   {
-    return profile.GetCosts(routeNode,routingDatabase.GetObjectVariantData(),inPathIndex,outPathIndex);
+    return profile.GetCosts(routeNode,routingDatabase->GetObjectVariantData(),inPathIndex,outPathIndex);
   }
 
   double SimpleRoutingService::GetCosts(const RoutingProfile& profile,
@@ -125,6 +160,14 @@ namespace osmscout {
     return profile.GetUTurnCost();
   }
 
+  bool SimpleRoutingService::CompileProfile(const RoutingProfile& profile,
+                                            DatabaseId /*database*/,
+                                            CompiledRoutingProfile& compiled)
+  {
+    return profile.Compile(routingDatabase->GetObjectVariantData(),
+                           compiled);
+  }
+
   double SimpleRoutingService::GetEstimateCosts(const RoutingProfile& profile,
                                                 const DatabaseId /*db*/,
                                                 const Distance &targetDistance)
@@ -162,7 +205,7 @@ namespace osmscout {
 
     std::unordered_map<Id,RouteNodeRef> nodeMap;
 
-    if (!routingDatabase.GetRouteNodes(ids.begin(),
+    if (!routingDatabase->GetRouteNodes(ids.begin(),
                                        ids.end(),
                                        ids.size(),
                                        nodeMap)) {
@@ -181,7 +224,7 @@ namespace osmscout {
   bool SimpleRoutingService::GetRouteNode(const DBId &id,
                                           RouteNodeRef& node)
   {
-    return routingDatabase.GetRouteNode(id.id,
+    return routingDatabase->GetRouteNode(id.id,
                                         node);
   }
 
@@ -286,7 +329,7 @@ namespace osmscout {
       }
     }
 
-    if (!routingDatabase.GetJunctions(nodeIds,junctions)) {
+    if (!routingDatabase->GetJunctions(nodeIds,junctions)) {
       return false;
     }
 
@@ -322,6 +365,35 @@ namespace osmscout {
     return result;
   }
 
+  bool SimpleRoutingService::GetJunctionObjects(const DBId& id,
+                                                std::vector<ObjectFileRef>& objects)
+  {
+    JunctionRef junction;
+
+    objects.clear();
+
+    // Nodes without junction entry are only passed by the objects of their paths
+    if (routingDatabase->GetJunction(id.id,junction)) {
+      objects=junction->GetObjects();
+    }
+
+    return true;
+  }
+
+  bool SimpleRoutingService::GetCachedIncomingPaths(const DBId& id,
+                                                    std::vector<RoutingDatabase::IncomingPath>& paths)
+  {
+    return routingDatabase->GetIncomingPaths(id.id,
+                                             paths);
+  }
+
+  void SimpleRoutingService::CacheIncomingPaths(const DBId& id,
+                                                const std::vector<RoutingDatabase::IncomingPath>& paths)
+  {
+    routingDatabase->SetIncomingPaths(id.id,
+                                      paths);
+  }
+
   /**
    * Opens the routing service. This loads the routing graph for the given vehicle
    *
@@ -334,7 +406,8 @@ namespace osmscout {
 
     assert(!path.empty());
 
-    if (!routingDatabase.Open(database)) {
+    if (!sharedRoutingDatabase &&
+        !routingDatabase->Open(database)) {
       return false;
     }
 
@@ -359,7 +432,9 @@ namespace osmscout {
    */
   void SimpleRoutingService::Close()
   {
-    routingDatabase.Close();
+    if (!sharedRoutingDatabase) {
+      routingDatabase->Close();
+    }
 
     isOpen=false;
   }
@@ -449,6 +524,485 @@ namespace osmscout {
     return result;
   }
 
+  /**
+   * Return the endpoint for the way segment between the given node indexes
+   */
+  SimpleRoutingService::MatrixEndpoint SimpleRoutingService::GetMatrixEndpoint(const RoutingProfile& profile,
+                                                                               const WayRef& way,
+                                                                               size_t fromIndex,
+                                                                               size_t toIndex,
+                                                                               const RouteNodeRef& routeNode,
+                                                                               const ObjectFileRef& object) const
+  {
+    MatrixEndpoint endpoint;
+    Distance       distance;
+
+    for (size_t i=std::min(fromIndex,toIndex); i<std::max(fromIndex,toIndex); i++) {
+      distance+=GetEllipsoidalDistance(way->nodes[i].GetCoord(),
+                                       way->nodes[i+1].GetCoord());
+    }
+
+    endpoint.routeNode=routeNode;
+    endpoint.object=object;
+    endpoint.cost=profile.GetCosts(*way,distance);
+    endpoint.distance=distance.As<Kilometer>();
+    endpoint.duration=DurationAsHours(profile.GetTime(*way,distance));
+
+    return endpoint;
+  }
+
+  /**
+   * Resolve the given position to the route nodes next to it. For a source these are
+   * the route nodes reachable from the position, for a target the route nodes
+   * the position is reachable from.
+   *
+   * @return
+   *    False on error, else true. A position without any endpoints is not reachable.
+   */
+  bool SimpleRoutingService::GetMatrixPosition(const RoutingProfile& profile,
+                                               const RoutePosition& position,
+                                               bool source,
+                                               MatrixPosition& matrixPosition)
+  {
+    if (position.GetObjectFileRef().GetType()!=refWay) {
+      log.Error() << "Unsupported object type '" << position.GetObjectFileRef().GetTypeName() << "' for matrix position!";
+      return false;
+    }
+
+    if (!GetWayByOffset(DBFileOffset(position.GetDatabaseId(),
+                                     position.GetObjectFileRef().GetFileOffset()),
+                        matrixPosition.way)) {
+      log.Error() << "Cannot get way of matrix position!";
+      return false;
+    }
+
+    const WayRef& way=matrixPosition.way;
+    size_t        nodeIndex=position.GetNodeIndex();
+    RouteNodeRef  routeNode;
+
+    if (nodeIndex>=way->nodes.size()) {
+      log.Error() << "Given node index " << nodeIndex << " is not within valid range [0," << way->nodes.size()-1;
+      return false;
+    }
+
+    matrixPosition.position=position;
+
+    // Check, if the position is already a route node
+    GetRouteNode(DBId(position.GetDatabaseId(),
+                      way->GetId(nodeIndex)),
+                 routeNode);
+
+    if (routeNode) {
+      matrixPosition.endpoints.push_back(GetMatrixEndpoint(profile,
+                                                           way,
+                                                           nodeIndex,
+                                                           nodeIndex,
+                                                           routeNode,
+                                                           position.GetObjectFileRef()));
+
+      return true;
+    }
+
+    if (source ? profile.CanUseForward(*way) : profile.CanUseBackward(*way)) {
+      for (size_t i=nodeIndex+1; i<way->nodes.size(); i++) {
+        routeNode=nullptr;
+        GetRouteNode(DBId(position.GetDatabaseId(),
+                          way->GetId(i)),
+                     routeNode);
+
+        if (routeNode) {
+          matrixPosition.endpoints.push_back(GetMatrixEndpoint(profile,
+                                                               way,
+                                                               nodeIndex,
+                                                               i,
+                                                               routeNode,
+                                                               position.GetObjectFileRef()));
+          break;
+        }
+      }
+    }
+
+    if (source ? profile.CanUseBackward(*way) : profile.CanUseForward(*way)) {
+      for (size_t i=nodeIndex; i>0; i--) {
+        routeNode=nullptr;
+        GetRouteNode(DBId(position.GetDatabaseId(),
+                          way->GetId(i-1)),
+                     routeNode);
+
+        if (routeNode) {
+          matrixPosition.endpoints.push_back(GetMatrixEndpoint(profile,
+                                                               way,
+                                                               nodeIndex,
+                                                               i-1,
+                                                               routeNode,
+                                                               position.GetObjectFileRef()));
+          break;
+        }
+      }
+    }
+
+    if (matrixPosition.endpoints.empty()) {
+      log.Warn() << "No route node found for matrix position " << position.GetObjectFileRef().GetName();
+    }
+
+    return true;
+  }
+
+  /**
+   * Dijkstra search from the given source until all the given target route nodes
+   * are settled or no further route nodes are reachable within the limits of
+   * the search. Without target route nodes all reachable route nodes are settled.
+   * The path rules match the ones of WalkPaths(). Route nodes beyond the limits
+   * are not loaded.
+   *
+   * The settled target route nodes are returned in search.reached.
+   */
+  bool SimpleRoutingService::SearchOneToMany(const RoutingProfile& profile,
+                                             const MatrixPosition& source,
+                                             const std::unordered_map<Id,size_t>& targetNodes,
+                                             const RoutingParameter& parameter,
+                                             MatrixSearch& search)
+  {
+    const std::vector<ObjectVariantData>& objectVariantData=routingDatabase->GetObjectVariantData();
+    Vehicle                               vehicle=profile.GetVehicle();
+    DatabaseId                            dbId=source.position.GetDatabaseId();
+    size_t                                pending=targetNodes.size();
+
+    search.arena.Clear();
+    search.openList.Clear();
+    search.openMap.clear();
+    search.closedSet.clear();
+    search.reached.assign(targetNodes.size(),nullptr);
+    search.settled.clear();
+    search.exits.clear();
+
+    for (const auto& endpoint : source.endpoints) {
+      Id   id=endpoint.routeNode->GetId();
+      auto openEntry=search.openMap.find(id);
+
+      if (openEntry!=search.openMap.end() ||
+          endpoint.distance>search.maxDistance ||
+          endpoint.duration>search.maxDuration) {
+        continue;
+      }
+
+      MatrixNode* node=search.arena.Allocate(DBId(dbId,id),
+                                             endpoint.routeNode,
+                                             endpoint.object);
+
+      node->currentCost=endpoint.cost;
+      node->overallCost=endpoint.cost;
+      node->distance=endpoint.distance;
+      node->duration=endpoint.duration;
+      node->leaveRestricted=true;
+
+      search.openList.Push(node);
+      search.openMap[id]=node;
+    }
+
+    while (!search.openList.IsEmpty() &&
+           (pending>0 || targetNodes.empty())) {
+      if (parameter.GetBreaker() &&
+          parameter.GetBreaker()->IsAborted()) {
+        return false;
+      }
+
+      MatrixNode* current=search.openList.Pop();
+
+      search.openMap.erase(current->id.id);
+      search.closedSet.insert(VNode(current->id,
+                                    current->restricted));
+
+      if (search.collect) {
+        search.settled.push_back(current);
+      }
+
+      if (auto target=targetNodes.find(current->id.id);
+          target!=targetNodes.end() &&
+          search.reached[target->second]==nullptr) {
+        search.reached[target->second]=current;
+        pending--;
+      }
+
+      const RouteNode& routeNode=*current->node;
+
+      // find incoming path (its index) to current node
+      size_t inPathIndex=routeNode.paths.size();
+
+      if (current->prev.IsValid()) {
+        for (size_t i=0; i<routeNode.paths.size(); i++) {
+          if (routeNode.paths[i].id==current->prev.id &&
+              routeNode.objects[routeNode.paths[i].objectIndex].object==current->object) {
+            inPathIndex=i;
+            break;
+          }
+        }
+      }
+
+      for (size_t i=0; i<routeNode.paths.size(); i++) {
+        const RouteNode::Path& path=routeNode.paths[i];
+        const ObjectFileRef&   object=routeNode.objects[path.objectIndex].object;
+
+        if (path.id==current->prev.id ||
+            (current->restricted && !path.IsRestricted(vehicle) && !current->leaveRestricted) ||
+            !profile.CanUse(routeNode,objectVariantData,i) ||
+            search.closedSet.contains(VNode(DBId(dbId,path.id),path.IsRestricted(vehicle))) ||
+            !IsTurnAllowed(routeNode,current->object,object)) {
+          continue;
+        }
+
+        double distance=current->distance+path.distance.As<Kilometer>();
+        double duration=current->duration+DurationAsHours(profile.GetTime(routeNode,objectVariantData,i));
+
+        if (distance>search.maxDistance ||
+            duration>search.maxDuration) {
+          if (search.collect) {
+            search.exits.push_back(MatrixExit{current,path.id,distance,duration});
+          }
+
+          continue;
+        }
+
+        double currentCost=current->currentCost+profile.GetCosts(routeNode,
+                                                                 objectVariantData,
+                                                                 inPathIndex<routeNode.paths.size() ? inPathIndex : i,
+                                                                 i);
+        auto   openEntry=search.openMap.find(path.id);
+
+        if (openEntry!=search.openMap.end() &&
+            openEntry->second->currentCost<=currentCost) {
+          continue;
+        }
+
+        MatrixNode* node;
+
+        if (openEntry!=search.openMap.end()) {
+          node=openEntry->second;
+        }
+        else {
+          RouteNodeRef nextNode;
+
+          if (!GetRouteNode(DBId(dbId,path.id),
+                            nextNode)) {
+            log.Error() << "Cannot load route node with id " << path.id;
+            return false;
+          }
+
+          node=search.arena.Allocate(DBId(dbId,path.id),
+                                     nextNode,
+                                     object);
+        }
+
+        node->prev=current->id;
+        node->prevRestricted=current->restricted;
+        node->object=object;
+        node->currentCost=currentCost;
+        node->overallCost=currentCost;
+        node->distance=distance;
+        node->duration=duration;
+        node->restricted=path.IsRestricted(vehicle);
+        if (node->restricted &&
+            current->leaveRestricted) {
+          // allow to leave restricted area
+          node->leaveRestricted=true;
+        }
+
+        if (openEntry!=search.openMap.end()) {
+          search.openList.Update(node);
+        }
+        else {
+          search.openList.Push(node);
+          search.openMap[path.id]=node;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Calculate the costs, distances and durations of the cheapest routes from each
+   * of the given sources to each of the given targets.
+   *
+   * Instead of calculating each route on its own, a single one-to-many Dijkstra search
+   * is run per source until the route nodes next to all targets are settled. No
+   * route data or descriptions are generated. The sources are distributed over
+   * a number of worker threads (see RoutingParameter::SetThreadCount()), each
+   * with its own search state. All threads share the loaded route nodes. An
+   * exception thrown in a worker stops the other workers and is rethrown after
+   * all of them have finished.
+   *
+   * @param profile
+   *    Profile to use
+   * @param sources
+   *    Source positions as returned by GetClosestRoutableNode()
+   * @param targets
+   *    Target positions as returned by GetClosestRoutableNode()
+   * @param parameter
+   *    A RoutingParamater object
+   * @return
+   *    A RoutingMatrixResult object, not successful on errors or if the calculation was aborted
+   */
+  RoutingMatrixResult SimpleRoutingService::CalculateMatrix(const RoutingProfile& profile,
+                                                            const std::vector<RoutePosition>& sources,
+                                                            const std::vector<RoutePosition>& targets,
+                                                            const RoutingParameter& parameter)
+  {
+    RoutingMatrixResult           result(sources.size(),
+                                         targets.size());
+    std::vector<MatrixPosition>   sourcePositions(sources.size());
+    std::vector<MatrixPosition>   targetPositions(targets.size());
+    std::unordered_map<Id,size_t> targetNodes; // route node id => index in MatrixSearch::reached
+    StopClock                     clock;
+
+    for (size_t s=0; s<sources.size(); s++) {
+      if (!GetMatrixPosition(profile,
+                             sources[s],
+                             true,
+                             sourcePositions[s])) {
+        return result;
+      }
+    }
+
+    for (size_t t=0; t<targets.size(); t++) {
+      if (!GetMatrixPosition(profile,
+                             targets[t],
+                             false,
+                             targetPositions[t])) {
+        return result;
+      }
+
+      for (const auto& endpoint : targetPositions[t].endpoints) {
+        targetNodes.emplace(endpoint.routeNode->GetId(),
+                            targetNodes.size());
+      }
+    }
+
+    std::atomic<size_t> nextSource=0;
+    std::atomic<bool>   success=true;
+    std::mutex          exceptionMutex;
+    std::exception_ptr  workerException;
+
+    auto worker=[&]() {
+      MatrixSearch search;
+
+      for (size_t s=nextSource++; s<sources.size() && success; s=nextSource++) {
+        const MatrixPosition& source=sourcePositions[s];
+
+        try {
+          // Without target route nodes the search would settle all reachable route nodes
+          if (!targetNodes.empty() &&
+              !SearchOneToMany(profile,
+                               source,
+                               targetNodes,
+                               parameter,
+                               search)) {
+            success=false;
+            return;
+          }
+
+          for (size_t t=0; t<targets.size(); t++) {
+            const MatrixPosition& target=targetPositions[t];
+            double                cost=std::numeric_limits<double>::infinity();
+            double                distance=0.0;
+            double                duration=0.0;
+
+            // Source and target on the same way, a route along the way without passing a route node
+            if (source.position.GetObjectFileRef()==target.position.GetObjectFileRef() &&
+                source.position.GetDatabaseId()==target.position.GetDatabaseId() &&
+                (target.position.GetNodeIndex()>=source.position.GetNodeIndex() ?
+                 profile.CanUseForward(*source.way) :
+                 profile.CanUseBackward(*source.way))) {
+              MatrixEndpoint direct=GetMatrixEndpoint(profile,
+                                                      source.way,
+                                                      source.position.GetNodeIndex(),
+                                                      target.position.GetNodeIndex(),
+                                                      nullptr,
+                                                      source.position.GetObjectFileRef());
+
+              cost=direct.cost;
+              distance=direct.distance;
+              duration=direct.duration;
+            }
+
+            for (const auto& endpoint : target.endpoints) {
+              const MatrixNode* node=search.reached[targetNodes.at(endpoint.routeNode->GetId())];
+
+              if (node!=nullptr &&
+                  node->currentCost+endpoint.cost<cost) {
+                cost=node->currentCost+endpoint.cost;
+                distance=node->distance+endpoint.distance;
+                duration=node->duration+endpoint.duration;
+              }
+            }
+
+            if (cost<std::numeric_limits<double>::infinity()) {
+              result.Set(s,
+                         t,
+                         cost,
+                         Kilometers(distance),
+                         DurationOfHours(duration));
+            }
+          }
+        }
+        catch (IOException& e) {
+          log.Error() << e.GetDescription();
+          success=false;
+          return;
+        }
+        catch (...) {
+          // Stop the other workers, the exception is rethrown after all of them have finished
+          std::scoped_lock lock(exceptionMutex);
+
+          if (!workerException) {
+            workerException=std::current_exception();
+          }
+
+          success=false;
+          return;
+        }
+      }
+    };
+
+    size_t threadCount=parameter.GetThreadCount();
+
+    if (threadCount==0) {
+      threadCount=std::max(1u,std::thread::hardware_concurrency());
+    }
+
+    threadCount=std::min(threadCount,sources.size());
+
+    if (threadCount<=1) {
+      worker();
+    }
+    else {
+      std::vector<std::thread> threads;
+
+      for (size_t i=0; i<threadCount; i++) {
+        threads.emplace_back(worker);
+      }
+
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    if (workerException) {
+      std::rethrow_exception(workerException);
+    }
+
+    clock.Stop();
+
+    if (debugPerformance) {
+      std::cout << "Matrix:              " << sources.size() << "x" << targets.size() << " with " << threadCount << " thread(s)" << std::endl;
+      std::cout << "Time:                " << clock << std::endl;
+    }
+
+    result.SetSuccess(success);
+
+    return result;
+  }
+
   std::map<DatabaseId, std::string> SimpleRoutingService::GetDatabaseMapping() const
   {
     std::map<DatabaseId, std::string> mapping;
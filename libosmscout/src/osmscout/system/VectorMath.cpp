@@ -0,0 +1,712 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/system/VectorMath.h>
+
+#include <osmscout/private/Config.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <osmscout/system/Math.h>
+
+#if defined(HAVE_AVX2_DISPATCH) || defined(HAVE_AVX512_DISPATCH)
+#define OSMSCOUT_VECTOR_DISPATCH
+#endif
+
+namespace osmscout {
+
+  static VectorInstructionSet DetectVectorInstructionSet()
+  {
+#if defined(HAVE_AVX512_DISPATCH)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+      return VectorInstructionSet::avx512;
+    }
+#endif
+
+#if defined(HAVE_AVX2_DISPATCH)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("fma")) {
+      return VectorInstructionSet::avx2;
+    }
+#endif
+
+    return VectorInstructionSet::none;
+  }
+
+  static std::atomic<VectorInstructionSet> vectorInstructionSet=GetSupportedVectorInstructionSet();
+
+  VectorInstructionSet GetSupportedVectorInstructionSet()
+  {
+    static const VectorInstructionSet supportedInstructionSet=DetectVectorInstructionSet();
+
+    return supportedInstructionSet;
+  }
+
+  VectorInstructionSet GetVectorInstructionSet()
+  {
+    return vectorInstructionSet;
+  }
+
+  void SetVectorInstructionSet(VectorInstructionSet instructionSet)
+  {
+    vectorInstructionSet=std::min(instructionSet,
+                                  GetSupportedVectorInstructionSet());
+  }
+
+  static size_t FindDistantPointScalar(const double* x,
+                                       const double* y,
+                                       size_t start,
+                                       size_t count,
+                                       double refX,
+                                       double refY,
+                                       double tolerance)
+  {
+    for (size_t i=start; i<count; i++) {
+      if (!(std::fabs(x[i]-refX)<=tolerance &&
+            std::fabs(y[i]-refY)<=tolerance)) {
+        return i;
+      }
+    }
+
+    return count;
+  }
+
+  static size_t FindEqualConsecutivePointScalar(const double* x,
+                                                const double* y,
+                                                size_t start,
+                                                size_t count)
+  {
+    for (size_t i=std::max(start,(size_t)1); i<count; i++) {
+      if (x[i]==x[i-1] &&
+          y[i]==y[i-1]) {
+        return i;
+      }
+    }
+
+    return count;
+  }
+
+  static size_t FindMaxDistanceToSegmentScalar(const double* x,
+                                               const double* y,
+                                               size_t count,
+                                               double ax,
+                                               double ay,
+                                               double xdelta,
+                                               double ydelta,
+                                               double inverseLength,
+                                               double& maxDistanceSquared)
+  {
+    size_t maxDistanceIndex=count;
+
+    maxDistanceSquared=0.0;
+
+    for (size_t i=0; i<count; i++) {
+      double cx=x[i]-ax;
+      double cy=y[i]-ay;
+      double u=(cx*xdelta+cy*ydelta)*inverseLength;
+
+      u=std::min(1.0,std::max(0.0,u));
+
+      double dx=cx-u*xdelta;
+      double dy=cy-u*ydelta;
+      double distanceSquared=dx*dx+dy*dy;
+
+      if (distanceSquared>maxDistanceSquared) {
+        maxDistanceSquared=distanceSquared;
+        maxDistanceIndex=i;
+      }
+    }
+
+    return maxDistanceIndex;
+  }
+
+#if defined(OSMSCOUT_VECTOR_DISPATCH)
+
+  /*
+   * The calculation is written once using the GCC/clang vector extensions and
+   * is instantiated for 4 and 8 doubles. All helpers are always inlined into the
+   * functions below, which are compiled for the given instruction set. The
+   * psabi warnings about passing vectors without AVX enabled do not apply then.
+   * They are reported at the end of the file, so they are disabled for the
+   * rest of the file.
+   */
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#define OSMSCOUT_VECTOR_INLINE inline __attribute__((always_inline))
+
+  typedef double  v4df __attribute__((vector_size(32)));
+  typedef int64_t v4di __attribute__((vector_size(32)));
+  typedef double  v8df __attribute__((vector_size(64)));
+  typedef int64_t v8di __attribute__((vector_size(64)));
+
+  template<typename V>
+  struct VectorTraits;
+
+  template<>
+  struct VectorTraits<v4df>
+  {
+    using Mask=v4di;
+    static constexpr size_t size=4;
+  };
+
+  template<>
+  struct VectorTraits<v8df>
+  {
+    using Mask=v8di;
+    static constexpr size_t size=8;
+  };
+
+  // Coefficients of the polynomial approximations of sin, cos and log, see the
+  // Cephes math library by Stephen L. Moshier
+  static const double sinCoeffs[]={ 1.58962301576546568060E-10,
+                                   -2.50507477628578072866E-8,
+                                    2.75573136213857245213E-6,
+                                   -1.98412698295895385996E-4,
+                                    8.33333333332211858878E-3,
+                                   -1.66666666666666307295E-1};
+
+  static const double cosCoeffs[]={-1.13585365213876817300E-11,
+                                    2.08757008419747316778E-9,
+                                   -2.75573141792967388112E-7,
+                                    2.48015872888517045348E-5,
+                                   -1.38888888888730564116E-3,
+                                    4.16666666666665929218E-2};
+
+  static const double logNumeratorCoeffs[]={1.01875663804580931796E-4,
+                                            4.97494994976747001425E-1,
+                                            4.70579119878881725854E0,
+                                            1.44989225341610930846E1,
+                                            1.79368678507819816313E1,
+                                            7.70838733755885391666E0};
+
+  static const double logDenominatorCoeffs[]={1.0,
+                                              1.12873587189167450590E1,
+                                              4.52279145837532221105E1,
+                                              8.29875266912776603211E1,
+                                              7.11544750618563894466E1,
+                                              2.31251620126765340583E1};
+
+  // pi/2 split into three parts for exact range reduction
+  static const double pio2Part1=2*7.85398125648498535156E-1;
+  static const double pio2Part2=2*3.77489470793079817668E-8;
+  static const double pio2Part3=2*2.69515142907905952645E-15;
+
+  // ln(2) split into two parts
+  static const double ln2Part1=0.693359375;
+  static const double ln2Part2=-2.121944400546905827679e-4;
+
+  /**
+   * The vector code is only valid for |x| below this limit (slightly above
+   * the latitude limit of the Mercator projection), other values are calculated
+   * by the scalar code
+   */
+  static const double maxVectorAngle=1.5;
+
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE V Select(const typename VectorTraits<V>::Mask& mask,
+                                  const V& a,
+                                  const V& b)
+  {
+    using Mask=typename VectorTraits<V>::Mask;
+
+    return (V)((mask & (Mask)a) | (~mask & (Mask)b));
+  }
+
+  template<typename V, size_t N>
+  OSMSCOUT_VECTOR_INLINE V EvaluatePolynomial(const V& x,
+                                              const double (&coeffs)[N])
+  {
+    V y=V{}+coeffs[0];
+
+    for (size_t i=1; i<N; i++) {
+      y=y*x+coeffs[i];
+    }
+
+    return y;
+  }
+
+  /**
+   * sin(x) for |x|<pi/2
+   */
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE V Sin(const V& x)
+  {
+    using Mask=typename VectorTraits<V>::Mask;
+
+    const Mask signMask=Mask{}+std::numeric_limits<int64_t>::min();
+    Mask       sign=(Mask)x & signMask;
+    V          a=(V)((Mask)x & ~signMask);
+    // for a>=pi/4 use sin(a)=cos(a-pi/2)
+    Mask       upper=a>=M_PI_4;
+    V          z=Select(upper,((a-pio2Part1)-pio2Part2)-pio2Part3,a);
+    V          zz=z*z;
+    V          sin=z+z*(zz*EvaluatePolynomial(zz,sinCoeffs));
+    V          cos=1.0-zz*0.5+zz*zz*EvaluatePolynomial(zz,cosCoeffs);
+
+    return (V)((Mask)Select(upper,cos,sin) | sign);
+  }
+
+  /**
+   * log(x) for normalized positive x
+   */
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE V Log(const V& x)
+  {
+    using Mask=typename VectorTraits<V>::Mask;
+
+    Mask bits=(Mask)x;
+    // x=m*2^e with m in [0.5,1)
+    V    m=(V)((bits & 0x000fffffffffffffLL) | 0x3fe0000000000000LL);
+    // Convert the biased exponent to double by placing it in the mantissa of 2^52
+    V    e=(V)(((bits >> 52) & 0x7ff) | 0x4330000000000000LL)-(4503599627370496.0+1022.0);
+    Mask small=m<M_SQRT1_2;
+
+    e=Select(small,e-1.0,e);
+    m=Select(small,m+m-1.0,m-1.0);
+
+    V z=m*m;
+    V y=m*(z*EvaluatePolynomial(m,logNumeratorCoeffs)/EvaluatePolynomial(m,logDenominatorCoeffs));
+
+    y=y+e*ln2Part2;
+    y=y-z*0.5;
+
+    return m+y+e*ln2Part1;
+  }
+
+  /**
+   * Return true, if the absolute values of all elements are in the range
+   * supported by the vector code. Returns false for NaN.
+   */
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE bool IsInVectorRange(const V& x)
+  {
+    V    absX=(V)((typename VectorTraits<V>::Mask)x & std::numeric_limits<int64_t>::max());
+    auto valid=absX<=maxVectorAngle;
+
+    for (size_t i=0; i<VectorTraits<V>::size; i++) {
+      if (valid[i]==0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE void AtanhSinVector(const double* x,
+                                             double* result,
+                                             size_t count)
+  {
+    constexpr size_t size=VectorTraits<V>::size;
+
+    for (size_t i=0; i<count; i+=size) {
+      size_t n=std::min(size,count-i);
+      V      value{};
+
+      // Constant size copies are compiled to unaligned vector loads and stores
+      if (n==size) {
+        std::memcpy(&value,&x[i],sizeof(V));
+      }
+      else {
+        std::memcpy(&value,&x[i],n*sizeof(double));
+      }
+
+      if (!IsInVectorRange(value)) {
+        for (size_t j=i; j<i+n; j++) {
+          result[j]=std::atanh(std::sin(x[j]));
+        }
+
+        continue;
+      }
+
+      V sin=Sin(value);
+      V atanhSin=0.5*Log((1.0+sin)/(1.0-sin));
+
+      if (n==size) {
+        std::memcpy(&result[i],&atanhSin,sizeof(V));
+      }
+      else {
+        std::memcpy(&result[i],&atanhSin,n*sizeof(double));
+      }
+    }
+  }
+
+  /**
+   * Load count values, the remaining elements are set to padding
+   */
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE V Load(const double* values,
+                                size_t count,
+                                double padding)
+  {
+    V value=V{}+padding;
+
+    if (count==VectorTraits<V>::size) {
+      std::memcpy(&value,values,sizeof(V));
+    }
+    else {
+      std::memcpy(&value,values,count*sizeof(double));
+    }
+
+    return value;
+  }
+
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE V Abs(const V& x)
+  {
+    return (V)((typename VectorTraits<V>::Mask)x & std::numeric_limits<int64_t>::max());
+  }
+
+  /**
+   * Forces the product to be rounded before it is used in an addition. Otherwise
+   * the compiler may fuse both into one FMA instruction, which results in values
+   * differing from the scalar code.
+   */
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE V NoFusion(const V& x)
+  {
+    V result=x;
+
+    __asm__("" : "+v"(result));
+
+    return result;
+  }
+
+  /**
+   * Return the index of the first set element of the mask, or the size of the
+   * mask if no element is set
+   */
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE size_t FindFirst(const typename VectorTraits<V>::Mask& mask)
+  {
+    for (size_t i=0; i<VectorTraits<V>::size; i++) {
+      if (mask[i]!=0) {
+        return i;
+      }
+    }
+
+    return VectorTraits<V>::size;
+  }
+
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE size_t FindDistantPointVector(const double* x,
+                                                       const double* y,
+                                                       size_t count,
+                                                       double refX,
+                                                       double refY,
+                                                       double tolerance)
+  {
+    using Mask=typename VectorTraits<V>::Mask;
+
+    constexpr size_t size=VectorTraits<V>::size;
+
+    size_t i=0;
+
+    for (; i+size<=count; i+=size) {
+      Mask   xNear=Abs(Load<V>(&x[i],size,0.0)-refX)<=tolerance;
+      Mask   yNear=Abs(Load<V>(&y[i],size,0.0)-refY)<=tolerance;
+      size_t first=FindFirst<V>(~(xNear & yNear));
+
+      if (first<size) {
+        return i+first;
+      }
+    }
+
+    return FindDistantPointScalar(x,y,i,count,refX,refY,tolerance);
+  }
+
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE size_t FindEqualConsecutivePointVector(const double* x,
+                                                                const double* y,
+                                                                size_t count)
+  {
+    using Mask=typename VectorTraits<V>::Mask;
+
+    constexpr size_t size=VectorTraits<V>::size;
+
+    size_t i=1;
+
+    for (; i+size<=count; i+=size) {
+      Mask   xEqual=Load<V>(&x[i],size,0.0)==Load<V>(&x[i-1],size,0.0);
+      Mask   yEqual=Load<V>(&y[i],size,0.0)==Load<V>(&y[i-1],size,0.0);
+      size_t first=FindFirst<V>(xEqual & yEqual);
+
+      if (first<size) {
+        return i+first;
+      }
+    }
+
+    return FindEqualConsecutivePointScalar(x,y,i,count);
+  }
+
+  /**
+   * Same calculation as the scalar code, each element tracks its own maximum
+   */
+  template<typename V>
+  OSMSCOUT_VECTOR_INLINE size_t FindMaxDistanceToSegmentVector(const double* x,
+                                                               const double* y,
+                                                               size_t count,
+                                                               double ax,
+                                                               double ay,
+                                                               double xdelta,
+                                                               double ydelta,
+                                                               double inverseLength,
+                                                               double& maxDistanceSquared)
+  {
+    using Mask=typename VectorTraits<V>::Mask;
+
+    constexpr size_t size=VectorTraits<V>::size;
+
+    V    elementMax{};
+    Mask elementMaxIndex=Mask{}+(int64_t)count;
+    Mask index{};
+
+    for (size_t i=0; i<size; i++) {
+      index[i]=(int64_t)i;
+    }
+
+    for (size_t i=0; i<count; i+=size) {
+      size_t n=std::min(size,count-i);
+      // Missing elements are set to a, resulting in a distance of 0
+      V      cx=Load<V>(&x[i],n,ax)-ax;
+      V      cy=Load<V>(&y[i],n,ay)-ay;
+      V      u=(NoFusion(cx*xdelta)+NoFusion(cy*ydelta))*inverseLength;
+
+      // Same as std::min(1.0,std::max(0.0,u))
+      u=Select(u>0.0,u,V{});
+      u=Select(u<1.0,u,V{}+1.0);
+
+      V    dx=cx-NoFusion(u*xdelta);
+      V    dy=cy-NoFusion(u*ydelta);
+      V    distanceSquared=NoFusion(dx*dx)+NoFusion(dy*dy);
+      Mask greater=distanceSquared>elementMax;
+
+      elementMax=Select(greater,distanceSquared,elementMax);
+      elementMaxIndex=(greater & index) | (~greater & elementMaxIndex);
+      index+=(int64_t)size;
+    }
+
+    size_t maxDistanceIndex=count;
+
+    maxDistanceSquared=0.0;
+
+    for (size_t i=0; i<size; i++) {
+      if (elementMax[i]>maxDistanceSquared ||
+          (elementMax[i]==maxDistanceSquared && elementMax[i]>0.0 && (size_t)elementMaxIndex[i]<maxDistanceIndex)) {
+        maxDistanceSquared=elementMax[i];
+        maxDistanceIndex=(size_t)elementMaxIndex[i];
+      }
+    }
+
+    return maxDistanceIndex;
+  }
+
+#if defined(HAVE_AVX2_DISPATCH)
+  __attribute__((target("avx2,fma")))
+  static void AtanhSinAVX2(const double* x,
+                           double* result,
+                           size_t count)
+  {
+    AtanhSinVector<v4df>(x,result,count);
+  }
+
+  __attribute__((target("avx2,fma")))
+  static size_t FindDistantPointAVX2(const double* x,
+                                     const double* y,
+                                     size_t count,
+                                     double refX,
+                                     double refY,
+                                     double tolerance)
+  {
+    return FindDistantPointVector<v4df>(x,y,count,refX,refY,tolerance);
+  }
+
+  __attribute__((target("avx2,fma")))
+  static size_t FindEqualConsecutivePointAVX2(const double* x,
+                                              const double* y,
+                                              size_t count)
+  {
+    return FindEqualConsecutivePointVector<v4df>(x,y,count);
+  }
+
+  __attribute__((target("avx2,fma")))
+  static size_t FindMaxDistanceToSegmentAVX2(const double* x,
+                                             const double* y,
+                                             size_t count,
+                                             double ax,
+                                             double ay,
+                                             double xdelta,
+                                             double ydelta,
+                                             double inverseLength,
+                                             double& maxDistanceSquared)
+  {
+    return FindMaxDistanceToSegmentVector<v4df>(x,y,count,ax,ay,xdelta,ydelta,inverseLength,maxDistanceSquared);
+  }
+#endif
+
+#if defined(HAVE_AVX512_DISPATCH)
+  __attribute__((target("avx512f")))
+  static void AtanhSinAVX512(const double* x,
+                             double* result,
+                             size_t count)
+  {
+    AtanhSinVector<v8df>(x,result,count);
+  }
+
+  __attribute__((target("avx512f")))
+  static size_t FindDistantPointAVX512(const double* x,
+                                       const double* y,
+                                       size_t count,
+                                       double refX,
+                                       double refY,
+                                       double tolerance)
+  {
+    return FindDistantPointVector<v8df>(x,y,count,refX,refY,tolerance);
+  }
+
+  __attribute__((target("avx512f")))
+  static size_t FindEqualConsecutivePointAVX512(const double* x,
+                                                const double* y,
+                                                size_t count)
+  {
+    return FindEqualConsecutivePointVector<v8df>(x,y,count);
+  }
+
+  __attribute__((target("avx512f")))
+  static size_t FindMaxDistanceToSegmentAVX512(const double* x,
+                                               const double* y,
+                                               size_t count,
+                                               double ax,
+                                               double ay,
+                                               double xdelta,
+                                               double ydelta,
+                                               double inverseLength,
+                                               double& maxDistanceSquared)
+  {
+    return FindMaxDistanceToSegmentVector<v8df>(x,y,count,ax,ay,xdelta,ydelta,inverseLength,maxDistanceSquared);
+  }
+#endif
+
+#endif
+
+  void AtanhSin(const double* x,
+                double* result,
+                size_t count)
+  {
+    switch (vectorInstructionSet.load(std::memory_order_relaxed)) {
+#if defined(HAVE_AVX512_DISPATCH)
+    case VectorInstructionSet::avx512:
+      AtanhSinAVX512(x,result,count);
+      return;
+#endif
+#if defined(HAVE_AVX2_DISPATCH)
+    case VectorInstructionSet::avx2:
+      AtanhSinAVX2(x,result,count);
+      return;
+#endif
+    default:
+      break;
+    }
+
+    for (size_t i=0; i<count; i++) {
+      result[i]=std::atanh(std::sin(x[i]));
+    }
+  }
+
+  size_t FindDistantPoint(const double* x,
+                          const double* y,
+                          size_t count,
+                          double refX,
+                          double refY,
+                          double tolerance)
+  {
+    switch (vectorInstructionSet.load(std::memory_order_relaxed)) {
+#if defined(HAVE_AVX512_DISPATCH)
+    case VectorInstructionSet::avx512:
+      return FindDistantPointAVX512(x,y,count,refX,refY,tolerance);
+#endif
+#if defined(HAVE_AVX2_DISPATCH)
+    case VectorInstructionSet::avx2:
+      return FindDistantPointAVX2(x,y,count,refX,refY,tolerance);
+#endif
+    default:
+      return FindDistantPointScalar(x,y,0,count,refX,refY,tolerance);
+    }
+  }
+
+  size_t FindEqualConsecutivePoint(const double* x,
+                                   const double* y,
+                                   size_t count)
+  {
+    switch (vectorInstructionSet.load(std::memory_order_relaxed)) {
+#if defined(HAVE_AVX512_DISPATCH)
+    case VectorInstructionSet::avx512:
+      return FindEqualConsecutivePointAVX512(x,y,count);
+#endif
+#if defined(HAVE_AVX2_DISPATCH)
+    case VectorInstructionSet::avx2:
+      return FindEqualConsecutivePointAVX2(x,y,count);
+#endif
+    default:
+      return FindEqualConsecutivePointScalar(x,y,1,count);
+    }
+  }
+
+  size_t FindMaxDistanceToSegment(const double* x,
+                                  const double* y,
+                                  size_t count,
+                                  double ax,
+                                  double ay,
+                                  double bx,
+                                  double by,
+                                  double& maxDistanceSquared)
+  {
+    // Calculated here, so that all code paths use the same value
+    double xdelta=bx-ax;
+    double ydelta=by-ay;
+    double inverseLength=1/(xdelta*xdelta+ydelta*ydelta);
+
+    // The short segments of the recursion are faster without vector setup
+    if (count<16) {
+      return FindMaxDistanceToSegmentScalar(x,y,count,ax,ay,xdelta,ydelta,inverseLength,maxDistanceSquared);
+    }
+
+    switch (vectorInstructionSet.load(std::memory_order_relaxed)) {
+#if defined(HAVE_AVX512_DISPATCH)
+    case VectorInstructionSet::avx512:
+      return FindMaxDistanceToSegmentAVX512(x,y,count,ax,ay,xdelta,ydelta,inverseLength,maxDistanceSquared);
+#endif
+#if defined(HAVE_AVX2_DISPATCH)
+    case VectorInstructionSet::avx2:
+      return FindMaxDistanceToSegmentAVX2(x,y,count,ax,ay,xdelta,ydelta,inverseLength,maxDistanceSquared);
+#endif
+    default:
+      return FindMaxDistanceToSegmentScalar(x,y,count,ax,ay,xdelta,ydelta,inverseLength,maxDistanceSquared);
+    }
+  }
+}
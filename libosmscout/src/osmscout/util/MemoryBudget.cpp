@@ -0,0 +1,200 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  agent
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/MemoryBudget.h>
+
+#include <algorithm>
+
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+  /**
+   * Create a budget with the given maximum memory in bytes
+   */
+  MemoryBudget::MemoryBudget(size_t maxSize)
+  : maxSize(maxSize),
+    size(0),
+    accessClock(0)
+  {
+    // no code
+  }
+
+  /**
+   * Register a consumer. The consumer has to be unregistered,
+   * before it is destroyed.
+   */
+  void MemoryBudget::Register(Consumer& consumer)
+  {
+    std::scoped_lock<std::mutex> lock(consumerMutex);
+
+    consumers.push_back(&consumer);
+  }
+
+  /**
+   * Unregister a consumer. Waits for a running reclaim to finish, so
+   * the consumer is not used by the budget after the call returns.
+   */
+  void MemoryBudget::Unregister(Consumer& consumer)
+  {
+    std::scoped_lock<std::mutex> lock(consumerMutex);
+
+    consumers.erase(std::remove(consumers.begin(),consumers.end(),&consumer),
+                    consumers.end());
+  }
+
+  /**
+   * Evict entries from the consumers (least recently accessed first)
+   * until the budget fits again or no consumer can evict anymore.
+   */
+  void MemoryBudget::Reclaim()
+  {
+    std::scoped_lock<std::mutex> lock(consumerMutex);
+    std::vector<Consumer*>       candidates(consumers);
+
+    while (IsExceeded() &&
+           !candidates.empty()) {
+      size_t   oldestIndex=0;
+      uint64_t oldestAccess=NoAccess;
+      uint64_t secondOldestAccess=NoAccess;
+
+      for (size_t i=0; i<candidates.size(); i++) {
+        uint64_t access=candidates[i]->GetOldestAccess();
+
+        if (access<oldestAccess) {
+          secondOldestAccess=oldestAccess;
+          oldestAccess=access;
+          oldestIndex=i;
+        }
+        else if (access<secondOldestAccess) {
+          secondOldestAccess=access;
+        }
+      }
+
+      if (oldestAccess==NoAccess) {
+        break;
+      }
+
+      size_t currentSize=size.load(std::memory_order_relaxed);
+      size_t currentMaxSize=maxSize.load(std::memory_order_relaxed);
+
+      if (currentSize<=currentMaxSize) {
+        break;
+      }
+
+      // Evict from the consumer with the oldest entry, until its oldest entry
+      // is newer than the oldest entry of all other consumers
+      size_t freed=candidates[oldestIndex]->Evict(currentSize-currentMaxSize,
+                                                  secondOldestAccess);
+
+      if (freed==0) {
+        candidates.erase(candidates.begin()+oldestIndex);
+      }
+    }
+  }
+
+  /**
+   * Charge the given number of bytes to the budget. If the budget is exceeded
+   * afterwards, entries of the consumers are evicted.
+   *
+   * Must not be called while holding a lock, that is also acquired by
+   * Consumer::Evict() or Consumer::GetOldestAccess().
+   */
+  void MemoryBudget::Charge(size_t bytes)
+  {
+    size.fetch_add(bytes,std::memory_order_relaxed);
+
+    if (IsExceeded()) {
+      Reclaim();
+    }
+  }
+
+  /**
+   * Release the given number of bytes from the budget
+   */
+  void MemoryBudget::Release(size_t bytes)
+  {
+    size.fetch_sub(bytes,std::memory_order_relaxed);
+  }
+
+  /**
+   * Return the access tick of the least recently accessed entry of all
+   * consumers except the given one, or NoAccess if they are all empty.
+   *
+   * Entries of the given consumer accessed not after the returned tick are
+   * the least recently accessed entries of the budget. Accesses only move
+   * forward, so the result may be reused for a complete cleanup pass.
+   */
+  uint64_t MemoryBudget::GetOldestAccessOfOthers(const Consumer& consumer) const
+  {
+    std::scoped_lock<std::mutex> lock(consumerMutex);
+    uint64_t                     oldestAccess=NoAccess;
+
+    for (const Consumer* other : consumers) {
+      if (other!=&consumer) {
+        oldestAccess=std::min(oldestAccess,other->GetOldestAccess());
+      }
+    }
+
+    return oldestAccess;
+  }
+
+  /**
+   * Change the maximum memory of the budget, evicting entries if necessary
+   */
+  void MemoryBudget::SetMaxSize(size_t maxSize)
+  {
+    this->maxSize.store(maxSize,std::memory_order_relaxed);
+
+    if (IsExceeded()) {
+      Reclaim();
+    }
+  }
+
+  /**
+   * Return the statistics of all registered consumers
+   */
+  std::vector<MemoryBudget::Statistics> MemoryBudget::GetStatistics() const
+  {
+    std::scoped_lock<std::mutex> lock(consumerMutex);
+    std::vector<Statistics>      statistics;
+
+    statistics.reserve(consumers.size());
+
+    for (const auto& consumer : consumers) {
+      statistics.push_back(consumer->GetStatistics());
+    }
+
+    return statistics;
+  }
+
+  /**
+   * Dump the statistics of all registered consumers to the debug log
+   */
+  void MemoryBudget::DumpStatistics() const
+  {
+    log.Debug() << "Memory budget: " << GetSize() << "/" << GetMaxSize() << " bytes";
+
+    for (const auto& statistics : GetStatistics()) {
+      log.Debug() << "  " << statistics.name << " entries: " << statistics.entries << ", memory " << statistics.memory
+                  << ", hits " << statistics.hits << ", misses " << statistics.misses
+                  << ", evictions " << statistics.evictions;
+    }
+  }
+}
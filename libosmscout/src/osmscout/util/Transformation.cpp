@@ -19,10 +19,13 @@
 
 #include <osmscout/util/Transformation.h>
 
+#include <cstdint>
 #include <cstring>
 
 #include <limits>
 
+#include <osmscout/system/VectorMath.h>
+
 namespace osmscout {
 
   TransBuffer::~TransBuffer()
@@ -100,42 +103,86 @@ namespace osmscout {
     return true;
   }
 
-  class LineSegment CLASS_FINAL
+  /**
+   * Copy of the to be drawn points of a TransBuffer as separate arrays of x and y
+   * coordinates, as required by the vector functions of VectorMath.h.
+   * The optimization functions below drop points by clearing their keep flag.
+   */
+  class TransPointArrays CLASS_FINAL
   {
-  private:
-    TransPoint ref;
-    double     xdelta;
-    double     ydelta;
-    double     inverseLength;
-
   public:
+    std::vector<double>  x;
+    std::vector<double>  y;
+    std::vector<size_t>  index; //!< Index of the point in the TransBuffer
+    std::vector<uint8_t> keep;
+    size_t               count=0;
 
-    LineSegment(const TransPoint& a,
-                const TransPoint& b)
-    :ref(a)
+  public:
+    void Collect(const TransBuffer& buffer)
     {
-      xdelta=b.x-a.x;
-      ydelta=b.y-a.y;
-      inverseLength=1/(xdelta*xdelta+ydelta*ydelta);
+      if (x.size()<buffer.GetLength()) {
+        x.resize(buffer.GetLength());
+        y.resize(buffer.GetLength());
+        index.resize(buffer.GetLength());
+        keep.resize(buffer.GetLength());
+      }
+
+      count=0;
+
+      for (size_t i=0; i<buffer.GetLength(); i++) {
+        if (buffer.points[i].draw) {
+          x[count]=buffer.points[i].x;
+          y[count]=buffer.points[i].y;
+          index[count]=i;
+          keep[count]=true;
+          count++;
+        }
+      }
     }
 
-    bool IsValid() const
+    /**
+     * Remove all points, that are not to be kept
+     */
+    void Compact()
     {
-      return xdelta!=0 || ydelta!=0;
+      size_t kept=0;
+
+      while (kept<count && keep[kept]) {
+        kept++;
+      }
+
+      for (size_t i=kept; i<count; i++) {
+        if (keep[i]) {
+          x[kept]=x[i];
+          y[kept]=y[i];
+          index[kept]=index[i];
+          keep[kept]=true;
+          kept++;
+        }
+      }
+
+      count=kept;
     }
 
-    double CalculateDistanceSquared(const TransPoint& p) const
+    /**
+     * Only draw the points, that are to be kept
+     */
+    void Apply(TransBuffer& buffer) const
     {
-      double cx=p.x-ref.x;
-      double cy=p.y-ref.y;
-      double u=(cx*xdelta+cy*ydelta)*inverseLength;
+      size_t next=0;
 
-      u=std::min(1.0,std::max(0.0,u));
+      for (size_t i=0; i<count; i++) {
+        for (; next<index[i]; next++) {
+          buffer.points[next].draw=false;
+        }
 
-      double dx=cx-u*xdelta; // *-1 but we square below
-      double dy=cy-u*ydelta; // *-1 but we square below
+        buffer.points[index[i]].draw=keep[i];
+        next=index[i]+1;
+      }
 
-      return dx*dx+dy*dy;
+      for (; next<buffer.GetLength(); next++) {
+        buffer.points[next].draw=false;
+      }
     }
   };
 
@@ -185,47 +232,47 @@ namespace osmscout {
     return sqrt(dx*dx+dy*dy);
   }
 
-  static double CalculateDistancePointToPoint(const TransPoint& a,
-                                              const TransPoint& b)
+  static double CalculateDistancePointToPoint(double ax, double ay,
+                                              double bx, double by)
   {
-    double xdelta=b.x-a.x;
-    double ydelta=b.y-a.y;
+    double xdelta=bx-ax;
+    double ydelta=by-ay;
 
     return sqrt(xdelta*xdelta + ydelta*ydelta);
   }
 
-  static void SimplifyPolyLineDouglasPeucker(TransPoint* points,
+  static void SimplifyPolyLineDouglasPeucker(TransPointArrays& points,
                                              size_t beginIndex,
                                              size_t endIndex,
                                              size_t endValueIndex,
                                              double optimizeErrorToleranceSquared)
   {
-    LineSegment lineSegment(points[beginIndex], points[endValueIndex]);
-
-    double maxDistanceSquared=0;
-    size_t maxDistanceIndex=beginIndex;
-
-    for(size_t i=beginIndex+1; i<endIndex; ++i){
-      if (points[i].draw) {
-        double distanceSquared=lineSegment.CalculateDistanceSquared(points[i]);
-
-        if (distanceSquared>maxDistanceSquared) {
-          maxDistanceSquared=distanceSquared;
-          maxDistanceIndex=i;
-        }
-      }
+    if (endIndex-beginIndex<2) {
+      return; // no points in between
     }
 
+    double maxDistanceSquared;
+    size_t maxDistanceIndex=FindMaxDistanceToSegment(&points.x[beginIndex+1],
+                                                     &points.y[beginIndex+1],
+                                                     endIndex-beginIndex-1,
+                                                     points.x[beginIndex],
+                                                     points.y[beginIndex],
+                                                     points.x[endValueIndex],
+                                                     points.y[endValueIndex],
+                                                     maxDistanceSquared);
+
     if (maxDistanceSquared<=optimizeErrorToleranceSquared) {
 
       //we don't need to draw any extra points
       for(size_t i=beginIndex+1; i<endIndex; ++i){
-        points[i].draw=false;
+        points.keep[i]=false;
       }
 
       return;
     }
 
+    maxDistanceIndex+=beginIndex+1;
+
     //we need to split this line in two pieces
     SimplifyPolyLineDouglasPeucker(points,
                                    beginIndex,
@@ -272,6 +319,30 @@ namespace osmscout {
     return usedPoints++;
   }
 
+  size_t CoordBuffer::Append(const CoordBuffer& other)
+  {
+    size_t offset=usedPoints;
+
+    if (usedPoints+other.usedPoints>bufferSize) {
+      while (usedPoints+other.usedPoints>bufferSize) {
+        bufferSize=bufferSize*2;
+      }
+
+      Vertex2D *newBuffer=new Vertex2D[bufferSize];
+
+      std::memcpy(newBuffer,buffer,sizeof(Vertex2D)*usedPoints);
+
+      delete [] buffer;
+
+      buffer=newBuffer;
+    }
+
+    std::memcpy(buffer+usedPoints,other.buffer,sizeof(Vertex2D)*other.usedPoints);
+    usedPoints+=other.usedPoints;
+
+    return offset;
+  }
+
   CoordBufferRange CoordBuffer::GenerateParallelWay(const CoordBufferRange& org,
                                                     double offset)
   {
@@ -358,6 +429,8 @@ namespace osmscout {
     delete [] buffer;
   }
 
+  // The fast method is a single linear pass, it directly works on the TransBuffer
+
   static void DropSimilarPoints(TransBuffer &buffer,double optimizeErrorTolerance)
   {
     for (size_t i=0; i<buffer.GetLength(); i++) {
@@ -430,19 +503,78 @@ namespace osmscout {
     }
   }
 
-  static void DropRedundantPointsDouglasPeuckerArea(TransBuffer& buffer, double optimizeErrorTolerance)
+  static void DropEqualPoints(TransBuffer& buffer)
+  {
+    size_t current=0;
+    while (current<buffer.GetLength()) {
+      if (!buffer.points[current].draw) {
+        current++;
+        continue;
+      }
+
+      size_t next=current+1;
+      while (next<buffer.GetLength() && !buffer.points[next].draw) {
+        next++;
+      }
+
+      if (next>=buffer.GetLength()) {
+        return;
+      }
+
+      if (buffer.points[current].x==buffer.points[next].x &&
+        buffer.points[current].y==buffer.points[next].y) {
+        buffer.points[next].draw=false;
+      }
+
+      current=next;
+    }
+  }
+
+  // The quality method works on the compacted TransPointArrays, so that the
+  // vector functions of VectorMath.h can scan the points
+
+  static void DropSimilarPoints(TransPointArrays& points,
+                                size_t bufferLength,
+                                double optimizeErrorTolerance)
+  {
+    size_t end=points.count;
+
+    // The last point of the buffer is never dropped
+    if (end>0 && points.index[end-1]==bufferLength-1) {
+      end--;
+    }
+
+    size_t i=0;
+    while (i+1<end) {
+      size_t next=i+1;
+
+      // Most of the time already the next point is not similar
+      if (std::fabs(points.x[next]-points.x[i])<=optimizeErrorTolerance &&
+          std::fabs(points.y[next]-points.y[i])<=optimizeErrorTolerance) {
+        next+=1+FindDistantPoint(&points.x[next+1],
+                                 &points.y[next+1],
+                                 end-next-1,
+                                 points.x[i],
+                                 points.y[i],
+                                 optimizeErrorTolerance);
+
+        for (size_t j=i+1; j<next; j++) {
+          points.keep[j]=false;
+        }
+      }
+
+      i=next;
+    }
+  }
+
+  static void DropRedundantPointsDouglasPeuckerArea(TransPointArrays& points, double optimizeErrorTolerance)
   {
     // An implementation of Douglas-Peuker algorithm http://softsurfer.com/Archive/algorithm_0205/algorithm_0205.htm
 
     double optimizeErrorToleranceSquared=optimizeErrorTolerance*optimizeErrorTolerance;
     size_t begin=0;
 
-    while (begin<buffer.GetLength() &&
-           !buffer.points[begin].draw) {
-      begin++;
-    }
-
-    if (begin>=buffer.GetLength()) {
+    if (begin>=points.count) {
       return; //we found no single point that is drawn.
     }
 
@@ -450,14 +582,13 @@ namespace osmscout {
     double maxDist=0.0;
     size_t maxDistIndex=begin;
 
-    for(size_t i=begin; i<buffer.GetLength(); ++i) {
-      if (buffer.points[i].draw) {
-        double dist=CalculateDistancePointToPoint(buffer.points[begin], buffer.points[i]);
+    for(size_t i=begin; i<points.count; ++i) {
+      double dist=CalculateDistancePointToPoint(points.x[begin], points.y[begin],
+                                                points.x[i], points.y[i]);
 
-        if (dist>maxDist) {
-          maxDist=dist;
-          maxDistIndex=i;
-        }
+      if (dist>maxDist) {
+        maxDist=dist;
+        maxDistIndex=i;
       }
     }
 
@@ -465,75 +596,51 @@ namespace osmscout {
       return; //we only found 1 point to draw
     }
 
-    SimplifyPolyLineDouglasPeucker(buffer.points,
+    SimplifyPolyLineDouglasPeucker(points,
                                    begin,
                                    maxDistIndex,
                                    maxDistIndex,
                                    optimizeErrorToleranceSquared);
-    SimplifyPolyLineDouglasPeucker(buffer.points,
+    SimplifyPolyLineDouglasPeucker(points,
                                    maxDistIndex,
-                                   buffer.GetLength(),
+                                   points.count,
                                    begin,
                                    optimizeErrorToleranceSquared);
   }
 
-  static void DropRedundantPointsDouglasPeuckerWay(TransBuffer& buffer, double optimizeErrorTolerance)
+  static void DropRedundantPointsDouglasPeuckerWay(TransPointArrays& points, double optimizeErrorTolerance)
   {
     // An implementation of Douglas-Peuker algorithm http://softsurfer.com/Archive/algorithm_0205/algorithm_0205.htm
 
     double optimizeErrorToleranceSquared=optimizeErrorTolerance*optimizeErrorTolerance;
-    size_t begin=0;
-
-    while (begin<buffer.GetLength() &&
-           !buffer.points[begin].draw) {
-      begin++;
-    }
-
-    if (begin>=buffer.GetLength()) {
-      return; //we found no single point that is drawn.
-    }
 
-    //find last drawable point;
-    size_t end=buffer.GetLength()-1;
-    while (end>begin &&
-           !buffer.points[end].draw) {
-      end--;
-    }
-
-    if (end<=begin) {
-      return; //we only found 1 drawable point;
+    if (points.count<2) {
+      return; //we found no or only 1 drawable point;
     }
 
-    SimplifyPolyLineDouglasPeucker(buffer.points,
-                                   begin,
-                                   end,
-                                   end,
+    SimplifyPolyLineDouglasPeucker(points,
+                                   0,
+                                   points.count-1,
+                                   points.count-1,
                                    optimizeErrorToleranceSquared);
   }
 
-  static void DropEqualPoints(TransBuffer& buffer)
+  static void DropEqualPoints(TransPointArrays& points)
   {
     size_t current=0;
-    while (current<buffer.GetLength()) {
-      if (!buffer.points[current].draw) {
-        current++;
-        continue;
-      }
-
-      size_t next=current+1;
-      while (next<buffer.GetLength() && !buffer.points[next].draw) {
-        next++;
-      }
+    while (current<points.count) {
+      size_t next=current+FindEqualConsecutivePoint(&points.x[current],
+                                                    &points.y[current],
+                                                    points.count-current);
 
-      if (next>=buffer.GetLength()) {
+      if (next>=points.count) {
         return;
       }
 
-      if (buffer.points[current].x==buffer.points[next].x &&
-        buffer.points[current].y==buffer.points[next].y) {
-        buffer.points[next].draw=false;
-      }
+      points.keep[next]=false;
 
+      // Continue at the dropped point, it is equal to the last kept point, so that
+      // all points of a run of equal points are dropped
       current=next;
     }
   }
@@ -639,6 +746,17 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Return the TransPointArrays instance of the current thread, to avoid
+   * allocations for each optimized polygon
+   */
+  static TransPointArrays& GetTransPointArrays()
+  {
+    thread_local TransPointArrays points;
+
+    return points;
+  }
+
   void OptimizeArea(TransBuffer& buffer,
                     TransPolygon::OptimizeMethod optimize,
                     double optimizeErrorTolerance,
@@ -647,12 +765,17 @@ namespace osmscout {
     if (optimize==TransPolygon::fast) {
       DropSimilarPoints(buffer,optimizeErrorTolerance);
       DropRedundantPointsFast(buffer,optimizeErrorTolerance);
+      DropEqualPoints(buffer);
     }
     else {
-      DropRedundantPointsDouglasPeuckerArea(buffer,optimizeErrorTolerance);
-    }
+      TransPointArrays& points=GetTransPointArrays();
 
-    DropEqualPoints(buffer);
+      points.Collect(buffer);
+      DropRedundantPointsDouglasPeuckerArea(points,optimizeErrorTolerance);
+      points.Compact();
+      DropEqualPoints(points);
+      points.Apply(buffer);
+    }
 
     if (constraint==TransPolygon::simple) {
       EnsureSimple(buffer,true);
@@ -666,16 +789,22 @@ namespace osmscout {
                    double optimizeErrorTolerance,
                    TransPolygon::OutputConstraint constraint)
   {
-    DropSimilarPoints(buffer,optimizeErrorTolerance);
-
     if (optimize==TransPolygon::fast) {
+      DropSimilarPoints(buffer,optimizeErrorTolerance);
       DropRedundantPointsFast(buffer,optimizeErrorTolerance);
+      DropEqualPoints(buffer);
     }
     else {
-      DropRedundantPointsDouglasPeuckerWay(buffer,optimizeErrorTolerance);
-    }
+      TransPointArrays& points=GetTransPointArrays();
 
-    DropEqualPoints(buffer);
+      points.Collect(buffer);
+      DropSimilarPoints(points,buffer.GetLength(),optimizeErrorTolerance);
+      points.Compact();
+      DropRedundantPointsDouglasPeuckerWay(points,optimizeErrorTolerance);
+      points.Compact();
+      DropEqualPoints(points);
+      points.Apply(buffer);
+    }
 
     if (constraint==TransPolygon::simple) {
       EnsureSimple(buffer,false);